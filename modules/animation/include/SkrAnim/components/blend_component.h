@@ -0,0 +1,87 @@
+#pragma once
+#include "SkrAnim/resources/animation_resource.h"
+#include "SkrAnim/resources/skeleton_resource.h"
+#include "SkrAnim/ozz/base/maths/soa_transform.h"
+#include "SkrAnim/ozz/base/maths/simd_math.h"
+#include "utils/types.h"
+#include "ecs/dual_types.h"
+#ifndef __meta__
+    #include "SkrAnim/components/blend_component.generated.h"
+#endif
+
+// one clip of a blend tree, sampled at its own playback time
+sreflect_struct("guid" : "65D53020-BB9C-4037-BD59-8D08EA9591C0")
+skr_anim_layer_t
+{
+    SKR_RESOURCE_FIELD(skr_anim_resource_t, animation);
+    float weight = 1.f;
+    float speed = 1.f;
+    // playback time in seconds, advanced by skr_anim_system_update
+    float time = 0.f;
+    bool loop = true;
+};
+
+// n-way blend of animation layers
+// the anim system samples every layer, blends them and writes model space matrices to skr_render_anim_comp_t::joint_matrices
+sreflect_struct("guid" : "7E740D33-F914-4128-AC2D-A1F06A4D75BF")
+sattr("component" :
+{
+    "custom" : "::dual::managed_component"
+})
+skr_anim_blend_comp_t
+{
+    eastl::vector<skr_anim_layer_t> layers;
+    // below this accumulated weight the skeleton rest pose is blended in
+    float threshold = 0.1f;
+
+    spush_attr("no-rtti": true, "transient": true)
+    eastl::vector<ozz::math::SoaTransform> local_transforms;
+    // local transforms of the two latest sparse updates, interpolated by lod levels with interpolation on
+    eastl::vector<ozz::math::SoaTransform> lod_from;
+    eastl::vector<ozz::math::SoaTransform> lod_to;
+};
+
+// animation level of detail of an instance, picked by the anim system from the distance to the viewer
+// instances without this component are evaluated at full rate
+sreflect_struct("guid" : "55143920-FFB5-48FD-968C-46C129BFF7AE")
+sattr("component" : true)
+skr_anim_lod_comp_t
+{
+    // distance is divided by importance, > 1 keeps an instance detailed further away
+    float importance = 1.f;
+
+    // written by the anim system
+    uint32_t level = 0;
+    uint32_t frames_since_update = 0;
+    float pending_time = 0.f;
+    bool evaluated = false;
+};
+
+typedef struct skr_anim_lod_level_t {
+    // the level is used up to this distance from the viewer
+    float distance;
+    // evaluate every n frames, 0 or 1 for every frame
+    uint32_t update_interval;
+    // joints past this count rigidly follow their parent in rest pose, 0 for all joints
+    uint32_t max_joints;
+    // blend local transforms between the two latest updates instead of holding the pose, costs one update of latency
+    bool interpolate;
+} skr_anim_lod_level_t;
+
+struct skr_render_anim_comp_t;
+typedef struct skr_anim_system_t skr_anim_system_t;
+
+// the anim system evaluates entities with [inout]skr_anim_blend_comp_t, [out]skr_render_anim_comp_t, [in]skr_render_skel_comp_t
+// and optionally [inout]skr_anim_lod_comp_t, [in]skr_transform_comp_t
+// sampled poses are shared between instances playing the same animation at the same time within a frame
+SKR_ANIM_API skr_anim_system_t* skr_anim_system_create(dual_storage_t* world);
+SKR_ANIM_API void skr_anim_system_free(skr_anim_system_t* system);
+// starts a new frame and schedules the evaluation jobs, the previous frame is waited first
+SKR_ANIM_API void skr_anim_system_update(skr_anim_system_t* system, float dt);
+SKR_ANIM_API void skr_anim_system_wait(skr_anim_system_t* system);
+// levels are sorted by ascending distance, instances past the last distance use the last level
+SKR_ANIM_API void skr_anim_system_set_lods(skr_anim_system_t* system, const skr_anim_lod_level_t* levels, uint32_t count);
+SKR_ANIM_API void skr_anim_system_set_viewer(skr_anim_system_t* system, skr_float3_t position);
+// evaluates a single blend tree with the current frame of the system, for entities that live outside of the system query
+// layers are sampled at their current time, playback only advances in skr_anim_system_update
+SKR_ANIM_API void skr_anim_evaluate(skr_anim_system_t* system, skr_anim_blend_comp_t* blend, const skr_skeleton_resource_t* skeleton, struct skr_render_anim_comp_t* output);
@@ -2,6 +2,7 @@
 #include "SkrAnim/resources/skin_resource.h"
 #include "SkrRenderer/primitive_draw.h"
 #include "SkrAnim/ozz/base/maths/simd_math.h"
+#include "SkrAnim/components/skin_vertices.h"
 #ifndef __meta__
     #include "SkrAnim/components/skin_component.generated.h"
 #endif
@@ -30,6 +31,17 @@ skr_skin_primitive_t
     skr::span<skr_vertex_buffer_view_t> views;
 };
 
+// input streams of a skinned primitive, resolved from the mesh once at init instead of every frame
+// a stream with zero stride is absent
+typedef struct skr_skin_stream_t {
+    uint32_t vertex_count;
+    skr_vertex_buffer_entry_t joints;
+    skr_vertex_buffer_entry_t weights;
+    skr_vertex_buffer_entry_t position;
+    skr_vertex_buffer_entry_t normal;
+    skr_vertex_buffer_entry_t tangent;
+} skr_skin_stream_t;
+
 sreflect_struct("guid" : "02753B87-0D94-4C35-B768-DE3BFE3E0DEB")
 sattr("component" :
 {
@@ -43,14 +55,20 @@ skr_render_anim_comp_t
     spush_attr("no-rtti": true, "transient": true)
     eastl::vector<ozz::math::Float4x4> joint_matrices;
     eastl::vector<skr_skin_primitive_t> primitives;
+    eastl::vector<skr_skin_stream_t> streams;
     eastl::vector<skr_blob_t> buffers;
     eastl::vector<CGPUBufferId> vbs;
     eastl::vector<skr_vertex_buffer_view_t> views;
 };
 
 struct skr_render_skel_comp_t;
+struct skr_render_mesh_comp_t;
 SKR_ANIM_API void skr_init_skin_component(skr_render_skin_comp_t* component, const skr_skeleton_resource_t* skeleton);
 SKR_ANIM_API void skr_init_anim_component(skr_render_anim_comp_t* component, const skr_mesh_resource_t* mesh, skr_skeleton_resource_t* skeleton);
 SKR_ANIM_API void skr_init_anim_buffers(CGPUDeviceId device, skr_render_anim_comp_t* anim, const skr_mesh_resource_t* mesh);
 
-SKR_ANIM_API void skr_cpu_skin(skr_render_skin_comp_t* skin, const skr_render_anim_comp_t* anim, const skr_mesh_resource_t* mesh);
\ No newline at end of file
+SKR_ANIM_API void skr_cpu_skin(skr_render_skin_comp_t* skin, const skr_render_anim_comp_t* anim, const skr_mesh_resource_t* mesh);
+// skins a whole chunk of entities, skin matrices are built once per instance and vertex ranges are spread over task workers
+SKR_ANIM_API void skr_cpu_skin_batch(skr_render_skin_comp_t* skins, const skr_render_anim_comp_t* anims, const skr_render_mesh_comp_t* meshes, uint32_t count);
+// skins vertices [begin, end) of the given streams with the given skin matrices
+SKR_ANIM_API void skr_skin_vertices(const skr_skin_vertices_t* vertices, const ozz::math::Float4x4* skin_matrices, uint32_t skin_matrices_count, uint32_t begin, uint32_t end);
\ No newline at end of file
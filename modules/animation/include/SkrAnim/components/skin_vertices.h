@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+
+// raw vertex streams consumed by the skinning kernel, 4 uint16 joints and 4 float weights per vertex
+// the last weight is deduced as 1 - sum(others), null normals/tangents are skipped
+typedef struct skr_skin_vertices_t {
+    const uint16_t* joints;
+    const float* weights;
+    const float* positions;
+    const float* normals;
+    const float* tangents;
+    uint32_t joints_stride;
+    uint32_t weights_stride;
+    uint32_t positions_stride;
+    uint32_t normals_stride;
+    uint32_t tangents_stride;
+    float* out_positions;
+    float* out_normals;
+    float* out_tangents;
+    uint32_t out_positions_stride;
+    uint32_t out_normals_stride;
+    uint32_t out_tangents_stride;
+} skr_skin_vertices_t;
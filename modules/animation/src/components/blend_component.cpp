@@ -0,0 +1,465 @@
+#include "SkrAnim/components/blend_component.h"
+#include "SkrAnim/components/skin_component.h"
+#include "SkrAnim/components/skeleton_component.h"
+#include "SkrScene/scene.h"
+#include "SkrAnim/ozz/sampling_job.h"
+#include "SkrAnim/ozz/blending_job.h"
+#include "SkrAnim/ozz/local_to_model_job.h"
+#include "SkrAnim/ozz/base/maths/soa_transform.h"
+#include "containers/hashmap.hpp"
+#include "containers/vector.hpp"
+#include "platform/thread.h"
+#include "ecs/dual.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace skr::anim
+{
+struct SampleKey {
+    const ozz::animation::Animation* animation;
+    float ratio;
+    bool operator==(const SampleKey& other) const
+    {
+        return animation == other.animation && ratio == other.ratio;
+    }
+};
+
+struct SampleKeyHash {
+    size_t operator()(const SampleKey& key) const
+    {
+        return std::hash<const void*>()(key.animation) ^ (std::hash<float>()(key.ratio) * 0x9e3779b97f4a7c15ull);
+    }
+};
+
+using SampledPose = eastl::vector<ozz::math::SoaTransform>;
+// rest pose of every joint relative to its parent, used to complete joints skipped by a lod
+struct RestPose {
+    const ozz::animation::Skeleton* skeleton;
+    skr::vector<ozz::math::Float4x4> locals;
+};
+using SamplingContext = ozz::animation::SamplingJob::Context;
+} // namespace skr::anim
+
+struct skr_anim_system_t {
+    using PoseCache = skr::parallel_flat_hash_map<skr::anim::SampleKey, const skr::anim::SampledPose*, skr::anim::SampleKeyHash>;
+
+    using RestPoseMap = skr::parallel_flat_hash_map<const ozz::animation::Skeleton*, const skr::anim::RestPose*>;
+
+    dual_query_t* query = nullptr;
+    float dt = 0.f;
+    skr::vector<skr_anim_lod_level_t> lods;
+    skr_float3_t viewer = { 0.f, 0.f, 0.f };
+    RestPoseMap restPoses;
+    skr::task::event_t counter = nullptr;
+    // poses sampled this frame, keyed by (animation, ratio)
+    PoseCache cache;
+    // pooled sampling contexts and pose buffers, so that memory does not scale with the instance count
+    SMutexObject poolMutex;
+    skr::vector<skr::anim::SampledPose*> freePoses;
+    skr::vector<skr::anim::SampledPose*> usedPoses;
+    skr::vector<skr::anim::SamplingContext*> contexts;
+
+    ~skr_anim_system_t()
+    {
+        for (auto pose : freePoses)
+            SkrDelete(pose);
+        for (auto pose : usedPoses)
+            SkrDelete(pose);
+        for (auto context : contexts)
+            SkrDelete(context);
+        for (auto& pair : restPoses)
+            SkrDelete(pair.second);
+    }
+
+    uint32_t SelectLOD(const skr_transform_comp_t* transform, float importance) const
+    {
+        if (!transform)
+            return 0;
+        const auto& position = transform->value.translation;
+        const float dx = position.x - viewer.x, dy = position.y - viewer.y, dz = position.z - viewer.z;
+        const float distance = std::sqrt(dx * dx + dy * dy + dz * dz) / std::max(importance, 1e-3f);
+        for (uint32_t i = 0; i < (uint32_t)lods.size(); ++i)
+        {
+            if (distance <= lods[i].distance)
+                return i;
+        }
+        return (uint32_t)lods.size() - 1;
+    }
+
+    const skr::anim::RestPose& GetRestPose(const ozz::animation::Skeleton* skeleton)
+    {
+        const skr::anim::RestPose* result = nullptr;
+        restPoses.lazy_emplace_l(
+        skeleton,
+        [&](const skr::anim::RestPose* existed) { result = existed; },
+        [&](const RestPoseMap::constructor& ctor) {
+            auto rest = SkrNew<skr::anim::RestPose>();
+            rest->skeleton = skeleton;
+            rest->locals.resize(skeleton->num_joints());
+            ozz::animation::LocalToModelJob job;
+            job.skeleton = skeleton;
+            job.input = skeleton->joint_rest_poses();
+            job.output = { rest->locals.data(), rest->locals.size() };
+            job.Run();
+            // model space to parent space, children come after parents so walk backwards
+            const auto parents = skeleton->joint_parents();
+            for (int j = (int)parents.size() - 1; j >= 0; --j)
+            {
+                if (parents[j] != ozz::animation::Skeleton::kNoParent)
+                    rest->locals[j] = ozz::math::Invert(rest->locals[parents[j]]) * rest->locals[j];
+            }
+            ctor(skeleton, rest);
+            result = rest;
+        });
+        return *result;
+    }
+
+    skr::anim::SamplingContext* AcquireContext()
+    {
+        {
+            SMutexLock lock(poolMutex.mMutex);
+            if (!contexts.empty())
+            {
+                auto context = contexts.back();
+                contexts.pop_back();
+                return context;
+            }
+        }
+        return SkrNew<skr::anim::SamplingContext>();
+    }
+
+    void ReleaseContext(skr::anim::SamplingContext* context)
+    {
+        SMutexLock lock(poolMutex.mMutex);
+        contexts.push_back(context);
+    }
+
+    skr::anim::SampledPose* AcquirePose()
+    {
+        SMutexLock lock(poolMutex.mMutex);
+        skr::anim::SampledPose* pose = nullptr;
+        if (!freePoses.empty())
+        {
+            pose = freePoses.back();
+            freePoses.pop_back();
+        }
+        else
+            pose = SkrNew<skr::anim::SampledPose>();
+        usedPoses.push_back(pose);
+        return pose;
+    }
+
+    // a pose that lost the race for its key goes back to the free list
+    void DiscardPose(skr::anim::SampledPose* pose)
+    {
+        SMutexLock lock(poolMutex.mMutex);
+        auto iter = eastl::find(usedPoses.begin(), usedPoses.end(), pose);
+        SKR_ASSERT(iter != usedPoses.end());
+        *iter = usedPoses.back();
+        usedPoses.pop_back();
+        freePoses.push_back(pose);
+    }
+
+    void BeginFrame(float deltaTime)
+    {
+        dt = deltaTime;
+        cache.clear();
+        freePoses.insert(freePoses.end(), usedPoses.begin(), usedPoses.end());
+        usedPoses.clear();
+    }
+
+    const skr::anim::SampledPose* Sample(skr::anim::SamplingContext* context, const ozz::animation::Animation* animation, float ratio)
+    {
+        const skr::anim::SampleKey key = { animation, ratio };
+        const skr::anim::SampledPose* result = nullptr;
+        if (cache.if_contains(key, [&](const skr::anim::SampledPose* pose) { result = pose; }))
+            return result;
+        auto pose = AcquirePose();
+        pose->resize(animation->num_soa_tracks());
+        if (context->max_tracks() < animation->num_tracks())
+            context->Resize(animation->num_tracks());
+        ozz::animation::SamplingJob job;
+        job.animation = animation;
+        job.context = context;
+        job.ratio = ratio;
+        job.output = { pose->data(), pose->size() };
+        if (!job.Run())
+        {
+            SKR_LOG_ERROR("Failed to sample animation %s.", animation->name());
+            DiscardPose(pose);
+            return nullptr;
+        }
+        bool inserted = false;
+        cache.lazy_emplace_l(
+        key,
+        [&](const skr::anim::SampledPose* existed) { result = existed; },
+        [&](const PoseCache::constructor& ctor) {
+            ctor(key, pose);
+            result = pose;
+            inserted = true;
+        });
+        if (!inserted)
+            DiscardPose(pose);
+        return result;
+    }
+};
+
+// joints past a lod joint budget follow their parent with the rest pose offset
+static void skr_anim_apply_rest_joints(const skr::anim::RestPose& rest, uint32_t first, ozz::math::Float4x4* matrices)
+{
+    const auto parents = rest.skeleton->joint_parents();
+    for (uint32_t j = first; j < (uint32_t)parents.size(); ++j)
+    {
+        const auto parent = parents[j];
+        matrices[j] = parent == ozz::animation::Skeleton::kNoParent ? rest.locals[j] : matrices[parent] * rest.locals[j];
+    }
+}
+
+// translations and scales are lerped and rotations nlerped along the shortest path, so that bones keep their length and stay rigid
+static ozz::math::SoaTransform skr_anim_lerp_local(const ozz::math::SoaTransform& from, const ozz::math::SoaTransform& to, ozz::math::SimdFloat4 alpha)
+{
+    const ozz::math::SimdInt4 sign = ozz::math::Sign(ozz::math::Dot(from.rotation, to.rotation));
+    const ozz::math::SoaQuaternion rotation = { ozz::math::Xor(to.rotation.x, sign), ozz::math::Xor(to.rotation.y, sign),
+        ozz::math::Xor(to.rotation.z, sign), ozz::math::Xor(to.rotation.w, sign) };
+    ozz::math::SoaTransform result;
+    result.translation = ozz::math::Lerp(from.translation, to.translation, alpha);
+    result.rotation = ozz::math::NLerp(from.rotation, rotation, alpha);
+    result.scale = ozz::math::Lerp(from.scale, to.scale, alpha);
+    return result;
+}
+
+// evaluates instances in passes, so that each ozz job runs over the whole batch in turn
+// layers are advanced by dt before sampling, 0 samples them where they are
+// lods and transforms are optional, instances without lod are evaluated every frame
+static void skr_anim_evaluate_batch(skr_anim_system_t* system, float dt, skr_anim_blend_comp_t* blends, const skr_skeleton_resource_t* const* skeletons,
+    skr_render_anim_comp_t* outputs, skr_anim_lod_comp_t* lods, const skr_transform_comp_t* transforms, uint32_t count)
+{
+    struct Instance {
+        uint32_t layerStart;
+        uint32_t layerCount;
+        const ozz::math::SoaTransform* local;
+        const skr_anim_lod_level_t* level;
+        float dt;
+        bool evaluate;
+        bool restart;
+    };
+    skr::vector<ozz::animation::BlendingJob::Layer> layers;
+    skr::vector<Instance> instances(count);
+    {
+        ZoneScopedN("SelectAnimLODs");
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto& instance = instances[i];
+            instance = { 0, 0, nullptr, nullptr, dt, skeletons[i] != nullptr, false };
+            if (!lods || !instance.evaluate || system->lods.empty())
+                continue;
+            auto& lod = lods[i];
+            const auto level = system->SelectLOD(transforms ? &transforms[i] : nullptr, lod.importance);
+            const auto interval = std::max(system->lods[level].update_interval, 1u);
+            instance.level = &system->lods[level];
+            lod.pending_time += dt;
+            lod.frames_since_update++;
+            // a level change restarts the update cycle, so interpolation never spans two levels
+            if (!lod.evaluated || lod.level != level)
+            {
+                lod.level = level;
+                lod.evaluated = true;
+                instance.restart = true;
+                // stagger the first update of each instance so that a crowd does not update on the same frame
+                lod.frames_since_update = i % interval;
+            }
+            else if (lod.frames_since_update >= interval)
+                lod.frames_since_update = 0;
+            else
+            {
+                instance.evaluate = false;
+                continue;
+            }
+            instance.dt = lod.pending_time;
+            lod.pending_time = 0.f;
+        }
+    }
+    auto context = system->AcquireContext();
+    {
+        ZoneScopedN("SampleAnimations");
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto& instance = instances[i];
+            instance.layerStart = (uint32_t)layers.size();
+            if (!instance.evaluate)
+                continue;
+            for (auto& layer : blends[i].layers)
+            {
+                auto animation = layer.animation.get_resolved();
+                if (!animation || layer.weight <= 0.f)
+                    continue;
+                const float duration = animation->animation.duration();
+                layer.time += layer.speed * instance.dt;
+                if (layer.loop && duration > 0.f)
+                {
+                    layer.time = std::fmod(layer.time, duration);
+                    if (layer.time < 0.f)
+                        layer.time += duration;
+                }
+                else
+                    layer.time = std::clamp(layer.time, 0.f, duration);
+                const float ratio = duration > 0.f ? layer.time / duration : 0.f;
+                auto pose = system->Sample(context, &animation->animation, ratio);
+                if (!pose)
+                    continue;
+                auto& blendLayer = layers.emplace_back();
+                blendLayer.weight = layer.weight;
+                blendLayer.transform = { pose->data(), pose->size() };
+                instance.layerCount++;
+            }
+        }
+    }
+    system->ReleaseContext(context);
+    {
+        ZoneScopedN("BlendAnimations");
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto& instance = instances[i];
+            if (!instance.layerCount)
+                continue;
+            const auto& skeleton = skeletons[i]->skeleton;
+            const auto& first = layers[instance.layerStart];
+            // a single full weight layer covering the skeleton needs no blending
+            if (instance.layerCount == 1 && first.weight >= 1.f && first.transform.size() >= (size_t)skeleton.num_soa_joints())
+            {
+                instance.local = first.transform.data();
+                continue;
+            }
+            auto& local = blends[i].local_transforms;
+            local.resize(skeleton.num_soa_joints());
+            ozz::animation::BlendingJob job;
+            job.threshold = blends[i].threshold;
+            job.layers = { layers.data() + instance.layerStart, instance.layerCount };
+            job.rest_pose = skeleton.joint_rest_poses();
+            job.output = { local.data(), local.size() };
+            if (!job.Run())
+            {
+                SKR_LOG_ERROR("Failed to blend animation layers.");
+                continue;
+            }
+            instance.local = local.data();
+        }
+    }
+    {
+        ZoneScopedN("InterpolateAnimLODs");
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto& instance = instances[i];
+            if (!instance.level || !instance.level->interpolate || !skeletons[i])
+                continue;
+            auto& blend = blends[i];
+            const auto soaJoints = (size_t)skeletons[i]->skeleton.num_soa_joints();
+            if (instance.local)
+            {
+                // the latest update becomes the start of the next interpolation
+                eastl::swap(blend.lod_from, blend.lod_to);
+                blend.lod_to.assign(instance.local, instance.local + soaJoints);
+                if (instance.restart || blend.lod_from.size() != soaJoints)
+                    blend.lod_from = blend.lod_to;
+            }
+            if (blend.lod_from.size() != soaJoints || blend.lod_to.size() != soaJoints)
+                continue;
+            const auto interval = std::max(instance.level->update_interval, 1u);
+            const auto alpha = ozz::math::simd_float4::Load1((float)lods[i].frames_since_update / (float)interval);
+            auto& local = blend.local_transforms;
+            local.resize(soaJoints);
+            for (size_t j = 0; j < soaJoints; ++j)
+                local[j] = skr_anim_lerp_local(blend.lod_from[j], blend.lod_to[j], alpha);
+            instance.local = local.data();
+        }
+    }
+    {
+        ZoneScopedN("LocalToModel");
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto& instance = instances[i];
+            if (!instance.local)
+                continue;
+            const auto& skeleton = skeletons[i]->skeleton;
+            const auto jointCount = (uint32_t)skeleton.num_joints();
+            auto& matrices = outputs[i].joint_matrices;
+            matrices.resize(jointCount);
+            const auto maxJoints = instance.level ? instance.level->max_joints : 0;
+            const bool partial = maxJoints && maxJoints < jointCount;
+            ozz::animation::LocalToModelJob job;
+            job.skeleton = &skeleton;
+            job.input = { instance.local, (size_t)skeleton.num_soa_joints() };
+            job.output = { matrices.data(), matrices.size() };
+            if (partial)
+                job.to = (int)maxJoints - 1;
+            if (!job.Run())
+            {
+                SKR_LOG_ERROR("Failed to convert local space to model space.");
+                continue;
+            }
+            if (partial)
+                skr_anim_apply_rest_joints(system->GetRestPose(&skeleton), maxJoints, matrices.data());
+        }
+    }
+}
+
+skr_anim_system_t* skr_anim_system_create(dual_storage_t* world)
+{
+    auto system = SkrNew<skr_anim_system_t>();
+    system->query = dualQ_from_literal(world, "[inout]skr_anim_blend_comp_t,[out]skr_render_anim_comp_t,[in]skr_render_skel_comp_t,[inout]?skr_anim_lod_comp_t,[in]?skr_transform_comp_t");
+    return system;
+}
+
+void skr_anim_system_free(skr_anim_system_t* system)
+{
+    skr_anim_system_wait(system);
+    dualQ_release(system->query);
+    SkrDelete(system);
+}
+
+void skr_anim_system_wait(skr_anim_system_t* system)
+{
+    if (system->counter)
+    {
+        system->counter.wait(true);
+        system->counter = nullptr;
+    }
+}
+
+void skr_anim_system_update(skr_anim_system_t* system, float dt)
+{
+    ZoneScopedN("AnimSystem");
+    skr_anim_system_wait(system);
+    system->BeginFrame(dt);
+    auto evaluate = +[](void* u, dual_query_t* query, dual_chunk_view_t* view, dual_type_index_t* localTypes, EIndex entityIndex) {
+        ZoneScopedN("AnimJob");
+        auto system = (skr_anim_system_t*)u;
+        auto blends = dual::get_owned_rw<skr_anim_blend_comp_t>(view);
+        auto anims = dual::get_owned_rw<skr_render_anim_comp_t>(view);
+        auto skels = dual::get_component_ro<skr_render_skel_comp_t>(view);
+        auto lods = (skr_anim_lod_comp_t*)dualV_get_owned_rw_local(view, localTypes[3]);
+        auto transforms = (const skr_transform_comp_t*)dualV_get_owned_ro_local(view, localTypes[4]);
+        skr::vector<const skr_skeleton_resource_t*> skeletons(view->count);
+        for (uint32_t i = 0; i < view->count; ++i)
+            skeletons[i] = skels[i].skeleton.get_resolved();
+        skr_anim_evaluate_batch(system, system->dt, blends, skeletons.data(), anims, lods, transforms, view->count);
+    };
+    dualJ_schedule_ecs(system->query, 128, evaluate, system, nullptr, nullptr, nullptr, &system->counter);
+}
+
+void skr_anim_system_set_lods(skr_anim_system_t* system, const skr_anim_lod_level_t* levels, uint32_t count)
+{
+    skr_anim_system_wait(system);
+    system->lods.assign(levels, levels + count);
+}
+
+void skr_anim_system_set_viewer(skr_anim_system_t* system, skr_float3_t position)
+{
+    system->viewer = position;
+}
+
+void skr_anim_evaluate(skr_anim_system_t* system, skr_anim_blend_comp_t* blend, const skr_skeleton_resource_t* skeleton, skr_render_anim_comp_t* output)
+{
+    skr_anim_evaluate_batch(system, 0.f, blend, &skeleton, output, nullptr, nullptr, 1);
+}
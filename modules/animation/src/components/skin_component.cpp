@@ -7,6 +7,15 @@
 #include "SkrAnim/components/skeleton_component.h"
 #include "SkrAnim/ozz/geometry/skinning_job.h"
 #include "SkrAnim/ozz/base/span.h"
+#include "containers/vector.hpp"
+#include "utils/parallel_for.hpp"
+#include <algorithm>
+#include <type_traits>
+#if defined(SKR_PLATFORM_X86_64)
+    #include "platform/cpu/isa.h"
+    #include "../simd/skin_avx2.hpp"
+    #define SKR_SKIN_AVX2
+#endif
 
 skr_render_anim_comp_t::~skr_render_anim_comp_t()
 {
@@ -45,6 +54,7 @@ void skr_init_anim_component(skr_render_anim_comp_t* component, const skr_mesh_r
     component->buffers.resize(1);
     component->vbs.resize(1);
     component->primitives.resize(mesh->primitives.size());
+    component->streams.resize(mesh->primitives.size());
     component->joint_matrices.resize(skeleton->skeleton.num_joints());
     for (size_t i = 0; i < skeleton->skeleton.num_joints(); ++i)
         component->joint_matrices[i] = ozz::math::Float4x4::identity();
@@ -76,6 +86,18 @@ void skr_init_anim_component(skr_render_anim_comp_t* component, const skr_mesh_r
         tangent_offset = buffer_size;
         if (tangents_buffer)
             buffer_size += vertex_count * tangents_buffer->stride;
+        auto& stream = component->streams[i];
+        {
+            stream = make_zeroed<skr_skin_stream_t>();
+            stream.vertex_count = vertex_count;
+            stream.joints = *joints_buffer;
+            stream.weights = *weights_buffer;
+            stream.position = *positions_buffer;
+            if (normals_buffer)
+                stream.normal = *normals_buffer;
+            if (tangents_buffer)
+                stream.tangent = *tangents_buffer;
+        }
         auto& primitive = component->primitives[i];
         {
             primitive.position.buffer_index = 0;
@@ -172,67 +194,218 @@ void skr_init_anim_buffers(CGPUDeviceId device, skr_render_anim_comp_t* anim, co
     }
 }
 
+static void skr_update_skin_matrices(skr_render_skin_comp_t* skin, const skr_render_anim_comp_t* anim, const skr_skin_resource_t* skin_resource)
+{
+    skin->skin_matrices.resize(skin->joint_remaps.size());
+    for (size_t i = 0; i < skin->joint_remaps.size(); ++i)
+    {
+        auto inverse = skin_resource->blob.inverse_bind_poses[i];
+        skin->skin_matrices[i] = anim->joint_matrices[skin->joint_remaps[i]] * (ozz::math::Float4x4&)inverse;
+    }
+}
+
+static skr_skin_vertices_t skr_resolve_skin_vertices(const skr_render_anim_comp_t* anim, const skr_mesh_resource_t* mesh, size_t primitive)
+{
+    const auto& stream = anim->streams[primitive];
+    const auto& skprim = anim->primitives[primitive];
+    auto input = [&](const skr_vertex_buffer_entry_t& entry, uint32_t stride) {
+        SKR_ASSERT(!entry.stride || entry.stride == stride);
+        return entry.stride ? mesh->bins[entry.buffer_index].bin.bytes + entry.offset : nullptr;
+    };
+    auto output = [&](const skr_vertex_buffer_entry_t& entry, const skr_vertex_buffer_entry_t& source) {
+        return source.stride ? (float*)(anim->buffers[entry.buffer_index].bytes + entry.offset) : nullptr;
+    };
+    auto vertices = make_zeroed<skr_skin_vertices_t>();
+    vertices.joints = (const uint16_t*)input(stream.joints, sizeof(uint16_t) * 4);
+    vertices.joints_stride = stream.joints.stride;
+    vertices.weights = (const float*)input(stream.weights, sizeof(float) * 4);
+    vertices.weights_stride = stream.weights.stride;
+    vertices.positions = (const float*)input(stream.position, sizeof(float) * 3);
+    vertices.positions_stride = stream.position.stride;
+    vertices.normals = (const float*)input(stream.normal, sizeof(float) * 3);
+    vertices.normals_stride = stream.normal.stride;
+    vertices.tangents = (const float*)input(stream.tangent, sizeof(float) * 4);
+    vertices.tangents_stride = stream.tangent.stride;
+    vertices.out_positions = output(skprim.position, stream.position);
+    vertices.out_positions_stride = skprim.position.stride;
+    vertices.out_normals = output(skprim.normal, stream.normal);
+    vertices.out_normals_stride = skprim.normal.stride;
+    vertices.out_tangents = output(skprim.tangent, stream.tangent);
+    vertices.out_tangents_stride = skprim.tangent.stride;
+    return vertices;
+}
+
+static bool skr_is_skin_ready(const skr_render_skin_comp_t* skin, const skr_render_anim_comp_t* anim, const skr_mesh_resource_t* mesh)
+{
+    return !skin->joint_remaps.empty() && !anim->buffers.empty() && anim->streams.size() == mesh->primitives.size();
+}
+
 void skr_cpu_skin(skr_render_skin_comp_t* skin, const skr_render_anim_comp_t* anim, const skr_mesh_resource_t* mesh)
 {
     auto skin_resource = skin->skin_resource.get_resolved();
+    if (!skin_resource || !skr_is_skin_ready(skin, anim, mesh))
+        return;
+    skr_update_skin_matrices(skin, anim, skin_resource);
     for (size_t i = 0; i < mesh->primitives.size(); ++i)
     {
-        ozz::geometry::SkinningJob job;
-        auto& prim = mesh->primitives[i];
-        auto vertex_count = prim.vertex_count;
-        const skr_vertex_buffer_entry_t *joints_buffer = nullptr, *weights_buffer = nullptr, *positions_buffer = nullptr, *normals_buffer = nullptr, *tangents_buffer = nullptr;
-        for (auto& view : prim.vertex_buffers)
+        const auto vertices = skr_resolve_skin_vertices(anim, mesh, i);
+        skr_skin_vertices(&vertices, skin->skin_matrices.data(), (uint32_t)skin->skin_matrices.size(), 0, anim->streams[i].vertex_count);
+    }
+}
+
+void skr_cpu_skin_batch(skr_render_skin_comp_t* skins, const skr_render_anim_comp_t* anims, const skr_render_mesh_comp_t* meshes, uint32_t count)
+{
+    ZoneScopedN("CPUSkinBatch");
+    // vertex ranges small enough to balance across workers, large enough to amortize scheduling
+    static constexpr uint32_t kSkinBatchVertices = 4096;
+    struct SkinRange {
+        const skr_skin_vertices_t* vertices;
+        const ozz::math::Float4x4* skin_matrices;
+        uint32_t skin_matrices_count;
+        uint32_t begin;
+        uint32_t end;
+    };
+    skr::vector<skr_skin_vertices_t> vertices;
+    skr::vector<SkinRange> ranges;
+    {
+        ZoneScopedN("PrepareSkinRanges");
+        size_t primitive_count = 0;
+        for (uint32_t i = 0; i < count; ++i)
+            primitive_count += anims[i].streams.size();
+        // ranges point into vertices, it must not reallocate
+        vertices.reserve(primitive_count);
+        for (uint32_t i = 0; i < count; ++i)
         {
-            if (view.attribute == SKR_VERT_ATTRIB_JOINTS)
-                joints_buffer = &view;
-            else if (view.attribute == SKR_VERT_ATTRIB_WEIGHTS)
-                weights_buffer = &view;
-            else if (view.attribute == SKR_VERT_ATTRIB_POSITION)
-                positions_buffer = &view;
-            else if (view.attribute == SKR_VERT_ATTRIB_NORMAL)
-                normals_buffer = &view;
-            else if (view.attribute == SKR_VERT_ATTRIB_TANGENT)
-                tangents_buffer = &view;
+            auto mesh = meshes[i].mesh_resource.get_resolved();
+            auto skin_resource = skins[i].skin_resource.get_resolved();
+            if (!mesh || !skin_resource || !skr_is_skin_ready(skins + i, anims + i, mesh))
+                continue;
+            skr_update_skin_matrices(skins + i, anims + i, skin_resource);
+            for (size_t j = 0; j < mesh->primitives.size(); ++j)
+            {
+                const auto vertex_count = anims[i].streams[j].vertex_count;
+                const auto& prim_vertices = vertices.emplace_back(skr_resolve_skin_vertices(anims + i, mesh, j));
+                for (uint32_t begin = 0; begin < vertex_count; begin += kSkinBatchVertices)
+                {
+                    const auto end = std::min(begin + kSkinBatchVertices, vertex_count);
+                    ranges.push_back({ &prim_vertices, skins[i].skin_matrices.data(), (uint32_t)skins[i].skin_matrices.size(), begin, end });
+                }
+            }
         }
-        SKR_ASSERT(joints_buffer && weights_buffer);
+    }
+    // small chunks are skinned inline
+    skr::parallel_for(ranges.begin(), ranges.end(), 1, [](auto begin, auto end) {
+        ZoneScopedN("SkinVertices");
+        for (auto it = begin; it != end; ++it)
+            skr_skin_vertices(it->vertices, it->skin_matrices, it->skin_matrices_count, it->begin, it->end);
+    }, 2u);
+}
+
+#if defined(OZZ_SIMD_SSEx)
+static FORCEINLINE void skr_store_float3(float* out, __m128 v)
+{
+    _mm_storel_pi((__m64*)out, v);
+    _mm_store_ss(out + 2, _mm_movehl_ps(v, v));
+}
+#endif
 
-        auto buffer_span = [&](const skr_vertex_buffer_entry_t* buffer, auto t, uint32_t comps = 1) {
-            using T = typename decltype(t)::type;
-            SKR_ASSERT(buffer->stride == sizeof(T) * comps);
-            auto offset = mesh->bins[buffer->buffer_index].bin.bytes + buffer->offset;
-            return ozz::span<const T>{ (T*)offset, vertex_count * comps };
+void skr_skin_vertices(const skr_skin_vertices_t* vertices, const ozz::math::Float4x4* skin_matrices, uint32_t skin_matrices_count, uint32_t begin, uint32_t end)
+{
+    const auto& v = *vertices;
+    auto at = [](auto* base, uint32_t stride, uint32_t index) {
+        using T = std::remove_pointer_t<decltype(base)>;
+        return (T*)((std::conditional_t<std::is_const_v<T>, const uint8_t*, uint8_t*>)base + (size_t)stride * index);
+    };
+#if defined(SKR_SKIN_AVX2)
+    static const bool avx2 = skr_cpu_has_avx2();
+    if (avx2)
+    {
+        static_assert(sizeof(ozz::math::Float4x4) == 16 * sizeof(float), "skin matrices are read as 16 packed floats");
+        skr_skin_vertices_avx2(vertices, (const float*)skin_matrices, begin, end);
+        return;
+    }
+#endif
+#if defined(OZZ_SIMD_SSEx)
+    (void)skin_matrices_count;
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const auto joints = at(v.joints, v.joints_stride, i);
+        const auto weights = at(v.weights, v.weights_stride, i);
+        // blend the 4 influence matrices, the last weight is deduced like ozz does
+        __m128 cols[4];
+        {
+            const auto& m0 = skin_matrices[joints[0]];
+            const auto& m1 = skin_matrices[joints[1]];
+            const auto& m2 = skin_matrices[joints[2]];
+            const auto& m3 = skin_matrices[joints[3]];
+            const __m128 w0 = _mm_set1_ps(weights[0]);
+            const __m128 w1 = _mm_set1_ps(weights[1]);
+            const __m128 w2 = _mm_set1_ps(weights[2]);
+            const __m128 w3 = _mm_set1_ps(1.f - weights[0] - weights[1] - weights[2]);
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                cols[c] = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(m0.cols[c], w0), _mm_mul_ps(m1.cols[c], w1)),
+                    _mm_add_ps(_mm_mul_ps(m2.cols[c], w2), _mm_mul_ps(m3.cols[c], w3)));
+            }
+        }
+        auto transform_vector = [&](const float* in) {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(cols[0], _mm_set1_ps(in[0])), _mm_mul_ps(cols[1], _mm_set1_ps(in[1]))),
+                _mm_mul_ps(cols[2], _mm_set1_ps(in[2])));
         };
-        skin->skin_matrices.resize(anim->joint_matrices.size());
-        for(size_t i = 0; i < skin->joint_remaps.size(); ++i)
         {
-            auto inverse = skin_resource->blob.inverse_bind_poses[i];
-            skin->skin_matrices[i] = anim->joint_matrices[skin->joint_remaps[i]] * (ozz::math::Float4x4&)inverse;
+            const auto in = at(v.positions, v.positions_stride, i);
+            skr_store_float3(at(v.out_positions, v.out_positions_stride, i), _mm_add_ps(transform_vector(in), cols[3]));
         }
-        job.joint_matrices = { skin->skin_matrices.data(), skin->skin_matrices.size() };
-        job.influences_count = 4;
-        job.vertex_count = vertex_count;
-        job.joint_weights = buffer_span(weights_buffer, skr::type_t<float>(), 4);
-        job.joint_weights_stride = weights_buffer->stride;
-        job.joint_indices = buffer_span(joints_buffer, skr::type_t<uint16_t>(), 4);
-        job.joint_indices_stride = joints_buffer->stride;
-        if (normals_buffer)
-            job.in_normals = buffer_span(normals_buffer, skr::type_t<float>(), 3);
-        job.in_normals_stride = normals_buffer->stride;
-        if (tangents_buffer && tangents_buffer->stride)
-            job.in_tangents = buffer_span(tangents_buffer, skr::type_t<float>(), 4);
-        job.in_tangents_stride = tangents_buffer->stride;
-        job.in_positions = buffer_span(positions_buffer, skr::type_t<float>(), 3);
-        job.in_positions_stride = positions_buffer->stride;
-        auto& skprim = anim->primitives[i];
-        job.out_positions = { (float*)(anim->buffers[skprim.position.buffer_index].bytes + skprim.position.offset), vertex_count * 3 };
-        job.out_positions_stride = skprim.position.stride;
-        if (normals_buffer)
-            job.out_normals = { (float*)(anim->buffers[skprim.normal.buffer_index].bytes + skprim.normal.offset), vertex_count * 3 };
-        job.out_normals_stride = skprim.normal.stride;
-        if (tangents_buffer)
-            job.out_tangents = { (float*)(anim->buffers[skprim.tangent.buffer_index].bytes + skprim.tangent.offset), vertex_count * 4 };
-        job.out_tangents_stride = skprim.tangent.stride;
-        auto result = job.Run();
-        SKR_ASSERT(result);
+        if (v.normals)
+        {
+            const auto in = at(v.normals, v.normals_stride, i);
+            skr_store_float3(at(v.out_normals, v.out_normals_stride, i), transform_vector(in));
+        }
+        if (v.tangents)
+        {
+            const auto in = at(v.tangents, v.tangents_stride, i);
+            const auto out = at(v.out_tangents, v.out_tangents_stride, i);
+            skr_store_float3(out, transform_vector(in));
+            out[3] = in[3];
+        }
+    }
+#else
+    // no simd, fallback to ozz reference skinning
+    const auto vertex_count = end - begin;
+    if (!vertex_count)
+        return;
+    auto span = [&](auto* base, uint32_t stride) {
+        using T = std::remove_pointer_t<decltype(base)>;
+        return ozz::span<T>{ at(base, stride, begin), vertex_count * stride / sizeof(T) };
+    };
+    ozz::geometry::SkinningJob job;
+    job.joint_matrices = { skin_matrices, skin_matrices_count };
+    job.influences_count = 4;
+    job.vertex_count = (int)vertex_count;
+    job.joint_weights = span(v.weights, v.weights_stride);
+    job.joint_weights_stride = v.weights_stride;
+    job.joint_indices = span(v.joints, v.joints_stride);
+    job.joint_indices_stride = v.joints_stride;
+    job.in_positions = span(v.positions, v.positions_stride);
+    job.in_positions_stride = v.positions_stride;
+    job.out_positions = span(v.out_positions, v.out_positions_stride);
+    job.out_positions_stride = v.out_positions_stride;
+    if (v.normals)
+    {
+        job.in_normals = span(v.normals, v.normals_stride);
+        job.in_normals_stride = v.normals_stride;
+        job.out_normals = span(v.out_normals, v.out_normals_stride);
+        job.out_normals_stride = v.out_normals_stride;
+    }
+    if (v.tangents)
+    {
+        job.in_tangents = span(v.tangents, v.tangents_stride);
+        job.in_tangents_stride = v.tangents_stride;
+        job.out_tangents = span(v.out_tangents, v.out_tangents_stride);
+        job.out_tangents_stride = v.out_tangents_stride;
     }
+    auto result = job.Run();
+    SKR_ASSERT(result);
+#endif
 }
\ No newline at end of file
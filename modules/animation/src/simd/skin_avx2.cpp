@@ -0,0 +1,68 @@
+#include "skin_avx2.hpp"
+#include <immintrin.h>
+
+template <typename T>
+static inline T* skr_skin_at(T* base, uint32_t stride, uint32_t index)
+{
+    return (T*)((const char*)base + (size_t)stride * index);
+}
+
+static inline void skr_store_float3(float* out, __m128 v)
+{
+    _mm_storel_pi((__m64*)out, v);
+    _mm_store_ss(out + 2, _mm_movehl_ps(v, v));
+}
+
+void skr_skin_vertices_avx2(const skr_skin_vertices_t* vertices, const float* skin_matrices, uint32_t begin, uint32_t end)
+{
+    const auto& v = *vertices;
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const auto joints = skr_skin_at(v.joints, v.joints_stride, i);
+        const auto weights = skr_skin_at(v.weights, v.weights_stride, i);
+        // blend the 4 influence matrices two columns per register, the last weight is deduced like ozz does
+        const float* m0 = skin_matrices + joints[0] * 16;
+        const float* m1 = skin_matrices + joints[1] * 16;
+        const float* m2 = skin_matrices + joints[2] * 16;
+        const float* m3 = skin_matrices + joints[3] * 16;
+        const __m256 w0 = _mm256_set1_ps(weights[0]);
+        const __m256 w1 = _mm256_set1_ps(weights[1]);
+        const __m256 w2 = _mm256_set1_ps(weights[2]);
+        const __m256 w3 = _mm256_set1_ps(1.f - weights[0] - weights[1] - weights[2]);
+        __m256 lo = _mm256_mul_ps(_mm256_loadu_ps(m0), w0);
+        __m256 hi = _mm256_mul_ps(_mm256_loadu_ps(m0 + 8), w0);
+        lo = _mm256_fmadd_ps(_mm256_loadu_ps(m1), w1, lo);
+        hi = _mm256_fmadd_ps(_mm256_loadu_ps(m1 + 8), w1, hi);
+        lo = _mm256_fmadd_ps(_mm256_loadu_ps(m2), w2, lo);
+        hi = _mm256_fmadd_ps(_mm256_loadu_ps(m2 + 8), w2, hi);
+        lo = _mm256_fmadd_ps(_mm256_loadu_ps(m3), w3, lo);
+        hi = _mm256_fmadd_ps(_mm256_loadu_ps(m3 + 8), w3, hi);
+        const __m128 cols[4] = {
+            _mm256_castps256_ps128(lo),
+            _mm256_extractf128_ps(lo, 1),
+            _mm256_castps256_ps128(hi),
+            _mm256_extractf128_ps(hi, 1)
+        };
+        auto transform_vector = [&](const float* in) {
+            __m128 r = _mm_mul_ps(cols[0], _mm_set1_ps(in[0]));
+            r = _mm_fmadd_ps(cols[1], _mm_set1_ps(in[1]), r);
+            return _mm_fmadd_ps(cols[2], _mm_set1_ps(in[2]), r);
+        };
+        {
+            const auto in = skr_skin_at(v.positions, v.positions_stride, i);
+            skr_store_float3(skr_skin_at(v.out_positions, v.out_positions_stride, i), _mm_add_ps(transform_vector(in), cols[3]));
+        }
+        if (v.normals)
+        {
+            const auto in = skr_skin_at(v.normals, v.normals_stride, i);
+            skr_store_float3(skr_skin_at(v.out_normals, v.out_normals_stride, i), transform_vector(in));
+        }
+        if (v.tangents)
+        {
+            const auto in = skr_skin_at(v.tangents, v.tangents_stride, i);
+            const auto out = skr_skin_at(v.out_tangents, v.out_tangents_stride, i);
+            skr_store_float3(out, transform_vector(in));
+            out[3] = in[3];
+        }
+    }
+}
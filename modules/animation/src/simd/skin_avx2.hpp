@@ -0,0 +1,9 @@
+#pragma once
+#include "SkrAnim/components/skin_vertices.h"
+
+// kernels built with avx2 and fma flags, only called once skr_cpu_has_avx2 passed, which checks fma3 as well
+// they include nothing but intrinsics and plain c headers, so no inline function of a shared header gets an avx2 body
+
+// skr_skin_vertices with the matrix blend done two columns per register
+// skin_matrices are column major 4x4 float matrices, 16 floats each
+void skr_skin_vertices_avx2(const skr_skin_vertices_t* vertices, const float* skin_matrices, uint32_t begin, uint32_t end);
@@ -19,5 +19,9 @@ shared_module("SkrAnim", "SKR_ANIM", engine_version)
     public_dependency("SkrRenderer", engine_version)
     add_includedirs("include", {public=true})
     add_includedirs("ozz", {public=true})
-    add_files("src/**.cpp")
-    add_rules("c++.unity_build", {batchsize = default_unity_batch_size})
\ No newline at end of file
+    add_files("src/**.cpp|simd/*.cpp")
+    add_rules("c++.unity_build", {batchsize = default_unity_batch_size})
+    -- avx2 kernels only run after a cpu check, so only their own files get the flags
+    if is_arch("x86_64", "x64") then
+        add_files("src/simd/*_avx2.cpp", {unity_ignored = true, cxflags = is_plat("windows") and "/arch:AVX2" or {"-mavx2", "-mfma"}})
+    end
\ No newline at end of file
@@ -22,6 +22,7 @@ typedef enum ELightningStorageOpenFlag
 } ELightningStorageOpenFlag;
 typedef uint32_t LightningStorageOpenFlags;
 
+// name is the directory the database files are placed in, it is created if missing
 SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
 SLightningEnvironmentId skr_lightning_storage_create_environment(const char* name);
 SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
@@ -41,6 +42,7 @@ struct SLightningEnvironment
 
 struct SLightningStorage
 {
+    SLightningEnvironmentId environment;
     uint64_t mdbi;
     struct STimer* open_timer;
     uint32_t timeout_ms;
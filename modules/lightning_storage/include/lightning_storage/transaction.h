@@ -0,0 +1,40 @@
+#pragma once
+#include "lightning_storage/storage.h"
+
+DECLARE_LIGHTNING_OBJECT(SLightningTXN)
+
+typedef enum ELightningTransactionFlag
+{
+    LIGHTNING_TRANSACTION_READ_WRITE = 0x00000000,
+    LIGHTNING_TRANSACTION_READ_ONLY = 0x00000001,
+    LIGHTNING_TRANSACTION_MAX_ENUM_BIT = 0x7FFFFFFF
+} ELightningTransactionFlag;
+typedef uint32_t LightningTransactionFlags;
+
+typedef struct SLightningStorageValue {
+    size_t size;
+    const void* data;
+} SLightningStorageValue;
+
+// read only transactions may run in parallel and are not bound to a thread
+// only one read write transaction is alive at a time, it must be committed or aborted on the thread that began it
+SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
+SLightningTXNId skr_lightning_transaction_begin(SLightningEnvironmentId environment, LightningTransactionFlags flags);
+SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
+bool skr_lightning_transaction_commit(SLightningTXNId txn);
+SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
+void skr_lightning_transaction_abort(SLightningTXNId txn);
+
+// the returned value points into the mapped database and is valid until the transaction ends
+SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
+bool skr_lightning_storage_read(SLightningStorageId storage, SLightningTXNId txn, const SLightningStorageValue* key, SLightningStorageValue* value);
+SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
+bool skr_lightning_storage_write(SLightningStorageId storage, SLightningTXNId txn, const SLightningStorageValue* key, const SLightningStorageValue* value);
+SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
+bool skr_lightning_storage_del(SLightningStorageId storage, SLightningTXNId txn, const SLightningStorageValue* key);
+
+struct SLightningTXN
+{
+    SLightningEnvironmentId environment;
+    struct MDB_txn* txn;
+};
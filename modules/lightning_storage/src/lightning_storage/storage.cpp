@@ -1,7 +1,140 @@
 #include "lightning_storage/storage.h"
+#include "lightning_storage/transaction.h"
+#include "platform/memory.h"
+#include "platform/filesystem.hpp"
+#include "utils/log.h"
+#include "lmdb/lmdb.h"
 
-SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
-void nothing()
+// named storages opened per environment
+static constexpr MDB_dbi kMaxStorages = 64;
+// upper bound of the database size
+static constexpr size_t kMapSize = 256ull << 20;
+
+SLightningEnvironmentId skr_lightning_storage_create_environment(const char* name)
+{
+    std::error_code ec = {};
+    skr::filesystem::create_directories(name, ec);
+    MDB_env* env = nullptr;
+    if (int rc = mdb_env_create(&env); rc != 0)
+    {
+        SKR_LOG_ERROR("[LightningStorage] failed to create environment %s: %s", name, mdb_strerror(rc));
+        return nullptr;
+    }
+    mdb_env_set_maxdbs(env, kMaxStorages);
+    mdb_env_set_mapsize(env, kMapSize);
+    // read transactions are handed between fibers, so reader slots must not be bound to threads
+    if (int rc = mdb_env_open(env, name, MDB_NOTLS, 0664); rc != 0)
+    {
+        SKR_LOG_ERROR("[LightningStorage] failed to open environment %s: %s", name, mdb_strerror(rc));
+        mdb_env_close(env);
+        return nullptr;
+    }
+    auto environment = SkrNew<SLightningEnvironment>();
+    environment->env = env;
+    return environment;
+}
+
+void skr_lightning_storage_free_environment(SLightningEnvironmentId environment)
+{
+    if (!environment) return;
+    mdb_env_close(environment->env);
+    SkrDelete(environment);
+}
+
+SLightningStorageId skr_open_lightning_storage(SLightningEnvironmentId environment, const SLightningStorageOpenDescriptor* desc)
+{
+    const bool readOnly = desc->flags & LIGHTNING_STORAGE_OPEN_READ_ONLY;
+    MDB_txn* txn = nullptr;
+    if (int rc = mdb_txn_begin(environment->env, nullptr, readOnly ? MDB_RDONLY : 0, &txn); rc != 0)
+    {
+        SKR_LOG_ERROR("[LightningStorage] failed to begin transaction for storage %s: %s", desc->name, mdb_strerror(rc));
+        return nullptr;
+    }
+    MDB_dbi dbi = 0;
+    const unsigned int dbiFlags = (desc->flags & LIGHTNING_STORAGE_OPEN_CREATE) ? MDB_CREATE : 0;
+    if (int rc = mdb_dbi_open(txn, desc->name, dbiFlags, &dbi); rc != 0)
+    {
+        SKR_LOG_ERROR("[LightningStorage] failed to open storage %s: %s", desc->name, mdb_strerror(rc));
+        mdb_txn_abort(txn);
+        return nullptr;
+    }
+    if (!readOnly && (desc->flags & LIGHTNING_STORAGE_OPEN_TRUNCATE))
+        mdb_drop(txn, dbi, 0);
+    if (int rc = mdb_txn_commit(txn); rc != 0)
+    {
+        SKR_LOG_ERROR("[LightningStorage] failed to commit storage %s: %s", desc->name, mdb_strerror(rc));
+        return nullptr;
+    }
+    auto storage = SkrNew<SLightningStorage>();
+    storage->environment = environment;
+    storage->mdbi = dbi;
+    storage->open_timer = nullptr;
+    storage->timeout_ms = desc->timeout_ms;
+    return storage;
+}
+
+void skr_close_lightning_storage(SLightningStorageId storage)
+{
+    if (!storage) return;
+    // dbi handles are owned by the environment and released with it
+    SkrDelete(storage);
+}
+
+SLightningTXNId skr_lightning_transaction_begin(SLightningEnvironmentId environment, LightningTransactionFlags flags)
+{
+    MDB_txn* txn = nullptr;
+    const unsigned int txnFlags = (flags & LIGHTNING_TRANSACTION_READ_ONLY) ? MDB_RDONLY : 0;
+    if (int rc = mdb_txn_begin(environment->env, nullptr, txnFlags, &txn); rc != 0)
+    {
+        SKR_LOG_ERROR("[LightningStorage] failed to begin transaction: %s", mdb_strerror(rc));
+        return nullptr;
+    }
+    auto transaction = SkrNew<SLightningTXN>();
+    transaction->environment = environment;
+    transaction->txn = txn;
+    return transaction;
+}
+
+bool skr_lightning_transaction_commit(SLightningTXNId txn)
+{
+    const int rc = mdb_txn_commit(txn->txn);
+    if (rc != 0)
+        SKR_LOG_ERROR("[LightningStorage] failed to commit transaction: %s", mdb_strerror(rc));
+    SkrDelete(txn);
+    return rc == 0;
+}
+
+void skr_lightning_transaction_abort(SLightningTXNId txn)
+{
+    mdb_txn_abort(txn->txn);
+    SkrDelete(txn);
+}
+
+bool skr_lightning_storage_read(SLightningStorageId storage, SLightningTXNId txn, const SLightningStorageValue* key, SLightningStorageValue* value)
+{
+    MDB_val k = { key->size, (void*)key->data };
+    MDB_val v = {};
+    if (mdb_get(txn->txn, (MDB_dbi)storage->mdbi, &k, &v) != 0)
+        return false;
+    value->size = v.mv_size;
+    value->data = v.mv_data;
+    return true;
+}
+
+bool skr_lightning_storage_write(SLightningStorageId storage, SLightningTXNId txn, const SLightningStorageValue* key, const SLightningStorageValue* value)
+{
+    MDB_val k = { key->size, (void*)key->data };
+    MDB_val v = { value->size, (void*)value->data };
+    if (int rc = mdb_put(txn->txn, (MDB_dbi)storage->mdbi, &k, &v, 0); rc != 0)
+    {
+        SKR_LOG_ERROR("[LightningStorage] failed to write value: %s", mdb_strerror(rc));
+        return false;
+    }
+    return true;
+}
+
+bool skr_lightning_storage_del(SLightningStorageId storage, SLightningTXNId txn, const SLightningStorageValue* key)
 {
-    
-}
\ No newline at end of file
+    MDB_val k = { key->size, (void*)key->data };
+    return mdb_del(txn->txn, (MDB_dbi)storage->mdbi, &k, nullptr) == 0;
+}
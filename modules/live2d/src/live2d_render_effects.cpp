@@ -151,6 +151,7 @@ struct RenderEffectLive2D : public IRenderEffectProcessor {
     const float kMotionFramesPerSecond = 240.0f;
     eastl::vector_map<skr_live2d_render_model_id, STimer> motion_timers;
     uint32_t last_ms = 0;
+    float motion_delta_sum = 0.f;
     const bool use_high_precision_mask = false;
 
     eastl::vector<skr_primitive_draw_t> model_drawcalls;
@@ -289,9 +290,6 @@ struct RenderEffectLive2D : public IRenderEffectProcessor {
                     auto&& model_resource = models[i].ram_request.model_resource;
                     mask_push_constants[render_model].resize(0);
 
-                    // TODO: move this to (some manager?) other than update morph/phys in a render pass
-                    updateModelMotion(context->render_graph, render_model);
-                    updateTexture(render_model);
                     // record constant parameters
                     if (auto clipping_manager = render_model->clipping_manager)
                     {
@@ -387,6 +385,25 @@ struct RenderEffectLive2D : public IRenderEffectProcessor {
         dualQ_get_views(effect_query, DUAL_LAMBDA(updateMaskF));
     }
 
+    // motion, vertex uploads and bind tables change the models and add passes to the render graph,
+    // so they run here on the render thread before any draw packet is produced
+    void on_update(const skr_primitive_update_context_t* context) override
+    {
+        ZoneScopedN("Live2D::UpdateModels");
+
+        auto updateF = [&](dual_chunk_view_t* r_cv) {
+            auto models = dual::get_owned_rw<skr_live2d_render_model_comp_t>(r_cv);
+            for (uint32_t i = 0; i < r_cv->count; i++)
+            {
+                if (!models[i].vram_request.is_ready()) continue;
+                auto&& render_model = models[i].vram_request.render_model;
+                updateModelMotion(context->render_graph, render_model);
+                updateTexture(render_model);
+            }
+        };
+        dualQ_get_views(effect_query, DUAL_LAMBDA(updateF));
+    }
+
     double sample_count = 1.0;
     uint64_t frame_count = 0;
     uint64_t async_slot_index = 0;
@@ -504,12 +521,11 @@ protected:
 
         const auto model_resource = render_model->model_resource_id;
         last_ms = skr_timer_get_msec(&motion_timers[render_model], true);
-        static float delta_sum = 0.f;
-        delta_sum += ((float)last_ms / 1000.f);
-        if (delta_sum > (1.f / kMotionFramesPerSecond))
+        motion_delta_sum += ((float)last_ms / 1000.f);
+        if (motion_delta_sum > (1.f / kMotionFramesPerSecond))
         {
-            skr_live2d_model_update(model_resource, delta_sum);
-            delta_sum = 0.f;
+            skr_live2d_model_update(model_resource, motion_delta_sum);
+            motion_delta_sum = 0.f;
             const auto vb_c = render_model->vertex_buffer_views.size();
             // update buffer
             if (render_model->use_dynamic_buffer && vb_c) // direct copy vertices to CVV buffer
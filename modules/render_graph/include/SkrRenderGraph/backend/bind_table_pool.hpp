@@ -12,13 +12,31 @@ namespace render_graph
 {
 // thread-unsafe descriptor set heap
 // it's supposed to be resized only once at compile
-// TODO: lifetime management (GC)
-class BindTablePool
+// tables popped by their bindings keep them over frames and are only rewritten when they are evicted
+class SKR_RENDER_GRAPH_API BindTablePool
 {
     friend class RenderGraphBackend;
 public:
+    // upper bound of cached tables per layout, a frame that needs more grows the block past it
+    static constexpr uint32_t kMaxCachedTables = 64;
+
+    // resources written to a table in update order, the names of a block fix how many of each there are
+    struct Bindings
+    {
+        const CGPUBufferId* buffers;
+        uint32_t buffers_count;
+        const CGPUTextureViewId* textures;
+        uint32_t textures_count;
+    };
+
     void expand(const char* keys, const CGPUXName* names, uint32_t names_count, size_t set_count = 1);
     CGPUXBindTableId pop(const char* keys, const CGPUXName* names, uint32_t names_count);
+    // returns the table last written with the same bindings,
+    // or the least recently used one not used this frame with needs_update set, the caller has to write it then
+    CGPUXBindTableId pop_cached(const char* keys, const CGPUXName* names, uint32_t names_count,
+        const Bindings& bindings, uint64_t frame_index, bool& needs_update);
+    // forgets every cached binding, resources they referenced may have been freed
+    void invalidate();
     void reset();
     void destroy();
 
@@ -27,10 +45,24 @@ public:
     {
     }
 protected:
+    struct CachedBindTable
+    {
+        bool matches(const Bindings& bindings) const;
+
+        CGPUXBindTableId bind_table;
+        size_t bindings_hash;
+        uint64_t last_used;
+        bool valid;
+        // a hash hit is only taken with the very same resources
+        skr::vector<CGPUBufferId> buffers;
+        skr::vector<CGPUTextureViewId> textures;
+    };
     struct BindTablesBlock
     {
         skr::vector<CGPUXBindTableId> bind_tables;
         uint32_t cursor = 0;
+        skr::vector<CachedBindTable> cached;
+        skr::flat_hash_map<size_t, uint32_t> cached_lookup;
     };
     const CGPURootSignatureId root_sig;
     skr::flat_hash_map<skr::string, BindTablesBlock, skr::hash<skr::string>> pool;
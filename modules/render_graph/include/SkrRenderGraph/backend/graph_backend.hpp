@@ -17,14 +17,20 @@ public:
     friend class RenderGraphBackend;
 
     RenderGraphFrameExecutor() = default;
-    void initialize(CGPUQueueId gfx_queue, CGPUDeviceId device);
+    // segment executors record a part of the frame of their owner, they have no fence and are submitted with it
+    void initialize(CGPUQueueId gfx_queue, CGPUDeviceId device, bool segment = false);
     void finalize();
+    // index 0 is the executor itself, the others are created the first time a frame is split that far
+    RenderGraphFrameExecutor& get_segment(uint32_t index);
 
     const struct CGPUXMergedBindTable* merge_tables(const struct CGPUXBindTable **tables, uint32_t count);
 
-    void commit(CGPUQueueId gfx_queue, uint64_t frame_index);
+    // submits the command buffers of the first segment_count segments, in order
+    void commit(CGPUQueueId gfx_queue, uint64_t frame_index, uint32_t segment_count = 1);
     void reset_begin(TextureViewPool& texture_view_pool);
 
+    // drops the bindings cached in the bind tables of the executor and its segments
+    void invalidate_bind_tables();
     void write_marker(const char* message);
     void print_error_trace(uint64_t frame_index);
 
@@ -41,6 +47,11 @@ public:
     eastl::vector<graph_big_object_string> marker_messages;
 protected:
     skr::flat_hash_map<CGPURootSignatureId, MergedBindTablePool*> merged_table_pools;
+    CGPUQueueId queue = nullptr;
+    CGPUDeviceId device = nullptr;
+    eastl::vector<RenderGraphFrameExecutor*> segments;
+    eastl::vector<CGPUCommandBufferId> submit_cmds;
+    uint32_t recorded_segments = 1;
 };
 
 // TODO: optimize stack allocation
@@ -56,6 +67,7 @@ public:
     void devirtualize(PassNode* node);
 
     virtual uint64_t execute(RenderGraphProfiler* profiler = nullptr) SKR_NOEXCEPT final;
+    virtual void wait_executor() SKR_NOEXCEPT final;
     virtual CGPUDeviceId get_backend_device() SKR_NOEXCEPT final;
     inline virtual CGPUQueueId get_gfx_queue() SKR_NOEXCEPT final { return gfx_queue; }
     virtual uint32_t collect_garbage(uint64_t critical_frame,
@@ -75,14 +87,21 @@ protected:
     virtual void finalize() SKR_NOEXCEPT final;
 
     CGPUTextureId resolve(RenderGraphFrameExecutor& executor, const TextureNode& node) SKR_NOEXCEPT;
-    CGPUTextureId try_aliasing_allocate(RenderGraphFrameExecutor& executor, const TextureNode& node) SKR_NOEXCEPT;
     CGPUBufferId resolve(RenderGraphFrameExecutor& executor, const BufferNode& node) SKR_NOEXCEPT;
 
     void calculate_barriers(RenderGraphFrameExecutor& executor, PassNode* pass,
         stack_vector<CGPUTextureBarrier>& tex_barriers, stack_vector<eastl::pair<TextureHandle, CGPUTextureId>>& resolved_textures,
         stack_vector<CGPUBufferBarrier>& buf_barriers, stack_vector<eastl::pair<BufferHandle, CGPUBufferId>>& resolved_buffers) SKR_NOEXCEPT;
+    // begins of split barriers and final states of resources whose last user was the pass
+    void record_pass_transitions(RenderGraphFrameExecutor& executor, PassNode* pass) SKR_NOEXCEPT;
     CGPUXBindTableId alloc_update_pass_bind_table(RenderGraphFrameExecutor& executor, PassNode* pass, CGPURootSignatureId root_sig) SKR_NOEXCEPT;
     void deallocate_resources(PassNode* pass) SKR_NOEXCEPT;
+    void invalidate_bind_tables() SKR_NOEXCEPT;
+    // resources are taken from and given back to the pools in pass order before any pass is recorded
+    void resolve_resources(RenderGraphFrameExecutor& executor) SKR_NOEXCEPT;
+    uint32_t plan_segments(bool serial) SKR_NOEXCEPT;
+    void record_passes(RenderGraphFrameExecutor& executor, uint32_t segment, RenderGraphProfiler* profiler) SKR_NOEXCEPT;
+    EBarrierSplit split_of(const ResourceTransition& transition, uint32_t pass_order) const SKR_NOEXCEPT;
 
     void execute_compute_pass(RenderGraphFrameExecutor& executor, ComputePassNode* pass) SKR_NOEXCEPT;
     void execute_render_pass(RenderGraphFrameExecutor& executor, RenderPassNode* pass) SKR_NOEXCEPT;
@@ -91,13 +110,36 @@ protected:
 
     uint64_t get_latest_finished_frame() SKR_NOEXCEPT;
 
+    void place_transients(RenderGraphFrameExecutor& executor) SKR_NOEXCEPT;
+    void build_transients(RenderGraphFrameExecutor& executor) SKR_NOEXCEPT;
+    void retire_transients(RenderGraphFrameExecutor& executor) SKR_NOEXCEPT;
+
     CGPUQueueId gfx_queue;
     CGPUDeviceId device;
     ECGPUBackend backend;
+    // passes of a frame are recorded in up to this many contiguous segments on the task system
+    uint32_t recording_segments = 1;
+    eastl::vector<uint32_t> segment_bounds;
+    // indexed by pass order
+    eastl::vector<uint32_t> pass_segments;
     RenderGraphFrameExecutor executors[RG_MAX_FRAME_IN_FLIGHT];
     TexturePool texture_pool;
     BufferPool buffer_pool;
     TextureViewPool texture_view_pool;
+
+    // textures placed into shared heaps, built for one compiled graph and kept until its hash changes
+    struct TransientTextures {
+        uint64_t hash = 0;
+        bool valid = false;
+        eastl::vector<CGPUTextureId> heaps;
+        // indexed by node handle
+        eastl::vector<CGPUTextureId> textures;
+        eastl::vector<TransientPlacement> placements;
+    };
+    TransientTextures transients;
+    TransientAllocator transient_allocator;
+    eastl::vector<TransientRequest> transient_requests;
+    eastl::vector<handle_t> transient_nodes;
 };
 } // namespace render_graph
 } // namespace skr
\ No newline at end of file
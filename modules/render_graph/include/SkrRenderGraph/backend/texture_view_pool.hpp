@@ -1,6 +1,7 @@
 #pragma once
 #include <EASTL/unordered_map.h>
 #include "cgpu/api.h"
+#include "platform/thread.h"
 
 namespace skr
 {
@@ -53,6 +54,8 @@ public:
     CGPUTextureViewId allocate(const CGPUTextureViewDescriptor& desc, uint64_t frame_index);
 protected:
     CGPUDeviceId device;
+    // passes recorded in parallel allocate views concurrently
+    SMutexObject mutex;
     eastl::unordered_map<Key, PooledTextureView, Key::hasher> views;
 };
 } // namespace render_graph
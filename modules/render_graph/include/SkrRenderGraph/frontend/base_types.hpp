@@ -1,15 +1,13 @@
 #pragma once
 #include "SkrRenderGraph/rg_config.h"
-#include "utils/dependency_graph.hpp"
+#include <EASTL/functional.h>
 #include "containers/span.hpp"
 #include "containers/string.hpp"
 
 #ifdef RG_USE_FIXED_STRING
 #include <EASTL/fixed_string.h>
-using graph_object_string = eastl::fixed_string<char, 32>;
 using graph_big_object_string = eastl::fixed_string<char, 64>;
 #else
-using graph_object_string = skr::string;
 using graph_big_object_string = skr::string;
 #endif
 
@@ -301,20 +299,38 @@ using TextureDSVHandle = TextureHandle::DepthStencilHandle;
 using TextureUAVHandle = TextureHandle::ShaderReadWriteHandle;
 using TextureSubresourceHandle = TextureHandle::SubresourceHandle;
 
-struct RenderGraphNode : public DependencyGraphNode {
+// nodes and edges live in the frame arena of their graph and are dropped without destruction at the end of the frame,
+// so they must not own memory. names and edge lists are allocated from the same arena
+struct RenderGraphNode {
     RenderGraphNode(EObjectType type);
+    virtual ~RenderGraphNode() = default;
+    RenderGraphNode(const RenderGraphNode&) = delete;
+    // the name is referenced, not copied: it has to live until the end of the frame
     SKR_RENDER_GRAPH_API void set_name(const char8_t* n);
     SKR_RENDER_GRAPH_API const char8_t* get_name() const;
+    // index of the node in the frame's graph
+    inline const handle_t get_id() const SKR_NOEXCEPT { return id; }
     const EObjectType type;
-    const uint32_t pooled_size = 0;
 protected:
-    graph_object_string name = "";
+    friend struct GraphTopology;
+    handle_t id = UINT64_MAX;
+    skr::string_view name = "";
 };
 
-struct RenderGraphEdge : public DependencyGraphEdge {
+struct RenderGraphEdge {
     RenderGraphEdge(ERelationshipType type);
+    virtual ~RenderGraphEdge() = default;
+    RenderGraphEdge(const RenderGraphEdge&) = delete;
+    inline RenderGraphNode* from() const SKR_NOEXCEPT { return from_node; }
+    inline RenderGraphNode* to() const SKR_NOEXCEPT { return to_node; }
+    // creation index of the edge in the frame's graph
+    inline uint32_t get_id() const SKR_NOEXCEPT { return id; }
     const ERelationshipType type;
-    const uint32_t pooled_size = 0;
+protected:
+    friend struct GraphTopology;
+    uint32_t id = UINT32_MAX;
+    RenderGraphNode* from_node = nullptr;
+    RenderGraphNode* to_node = nullptr;
 };
 
 struct SKR_RENDER_GRAPH_API PassContext {
@@ -343,8 +359,28 @@ struct SKR_RENDER_GRAPH_API RenderPassContext : public BindablePassContext {
     friend class RenderGraphBackend;
 
     void merge_and_bind_tables(const struct CGPUXBindTable** tables, uint32_t count) SKR_NOEXCEPT;
+    // binds through the context skip state the encoder already has from the previous bind of the same kind,
+    // draws sorted by pipeline and tables then only pay for what changes between them
+    void bind_pipeline(CGPURenderPipelineId pipeline) SKR_NOEXCEPT;
+    void bind_bind_table(const struct CGPUXBindTable* table) SKR_NOEXCEPT;
+    void bind_index_buffer(CGPUBufferId buffer, uint32_t index_stride, uint64_t offset) SKR_NOEXCEPT;
+    void bind_vertex_buffers(uint32_t count, const CGPUBufferId* buffers, const uint32_t* strides, const uint32_t* offsets) SKR_NOEXCEPT;
+    // binds skipped so far in the pass
+    inline uint32_t get_elided_binds() const SKR_NOEXCEPT { return elided_binds; }
 
     CGPURenderPassEncoderId encoder;
+protected:
+    CGPURenderPipelineId bound_pipeline = nullptr;
+    CGPURootSignatureId bound_root_signature = nullptr;
+    const void* bound_table = nullptr;
+    CGPUBufferId bound_index_buffer = nullptr;
+    uint32_t bound_index_stride = 0;
+    uint64_t bound_index_offset = 0;
+    uint32_t bound_vertex_count = 0;
+    CGPUBufferId bound_vertex_buffers[CGPU_MAX_VERTEX_BINDINGS];
+    uint32_t bound_vertex_strides[CGPU_MAX_VERTEX_BINDINGS];
+    uint32_t bound_vertex_offsets[CGPU_MAX_VERTEX_BINDINGS];
+    uint32_t elided_binds = 0;
 };
 
 struct SKR_RENDER_GRAPH_API ComputePassContext : public BindablePassContext {
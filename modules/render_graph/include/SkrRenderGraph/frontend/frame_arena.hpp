@@ -0,0 +1,81 @@
+#pragma once
+#include "SkrRenderGraph/rg_config.h"
+#include "platform/configure.h"
+#include <EASTL/vector.h>
+#include <new>
+
+namespace skr
+{
+namespace render_graph
+{
+// bump allocator backing the nodes, edges and edge lists of one frame
+// blocks are kept across frames, reset() rewinds the cursor and never returns memory in steady state
+class SKR_RENDER_GRAPH_API FrameArena
+{
+public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+    FrameArena(size_t block_size = kDefaultBlockSize) SKR_NOEXCEPT;
+    ~FrameArena() SKR_NOEXCEPT;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment) SKR_NOEXCEPT;
+    // copies a null terminated string into the arena
+    const char8_t* duplicate(const char8_t* str, size_t length) SKR_NOEXCEPT;
+    // objects are never destructed by the arena, only use it for types whose destructors can be skipped
+    template <typename T, typename... Args>
+    T* create(Args&&... args) SKR_NOEXCEPT
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+    // if the last frame spilled into several blocks they are merged into one, so the next frame stays in a single block
+    void reset() SKR_NOEXCEPT;
+
+    inline size_t used_bytes() const SKR_NOEXCEPT { return used + offset; }
+    inline size_t capacity() const SKR_NOEXCEPT { return total_size; }
+
+protected:
+    struct Block {
+        uint8_t* memory;
+        size_t size;
+    };
+    void new_block(size_t min_size) SKR_NOEXCEPT;
+
+    eastl::vector<Block> blocks;
+    size_t block_size = kDefaultBlockSize;
+    size_t total_size = 0;
+    // bytes consumed in the blocks before the current one
+    size_t used = 0;
+    uint32_t current = 0;
+    size_t offset = 0;
+};
+
+// EASTL allocator over a FrameArena, deallocation is a no-op and memory comes back with the arena reset
+struct FrameArenaAllocator {
+    FrameArenaAllocator(const char* = nullptr) SKR_NOEXCEPT {}
+    FrameArenaAllocator(FrameArena* arena) SKR_NOEXCEPT
+        : arena(arena)
+    {
+    }
+
+    inline void* allocate(size_t n, int flags = 0) SKR_NOEXCEPT
+    {
+        return arena->allocate(n, EASTL_ALLOCATOR_MIN_ALIGNMENT);
+    }
+    inline void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0) SKR_NOEXCEPT
+    {
+        return arena->allocate(n, alignment);
+    }
+    inline void deallocate(void* p, size_t n) SKR_NOEXCEPT {}
+
+    inline const char* get_name() const SKR_NOEXCEPT { return "RenderGraphFrameArena"; }
+    inline void set_name(const char*) SKR_NOEXCEPT {}
+
+    FrameArena* arena = nullptr;
+};
+
+inline bool operator==(const FrameArenaAllocator& a, const FrameArenaAllocator& b) { return a.arena == b.arena; }
+inline bool operator!=(const FrameArenaAllocator& a, const FrameArenaAllocator& b) { return a.arena != b.arena; }
+} // namespace render_graph
+} // namespace skr
@@ -0,0 +1,55 @@
+#pragma once
+#include "SkrRenderGraph/frontend/base_types.hpp"
+#include "platform/debug.h"
+#include <EASTL/vector.h>
+
+namespace skr
+{
+namespace render_graph
+{
+// flat adjacency of one frame's graph, nodes are addressed by their handle and edges by their creation index
+// build() lays the edges out per node (CSR) with a counting sort, so traversals after compile run over contiguous arrays
+// the arrays keep their capacity across frames, clear() is O(1)
+struct SKR_RENDER_GRAPH_API GraphTopology {
+    handle_t insert(RenderGraphNode* node) SKR_NOEXCEPT;
+    uint32_t link(RenderGraphNode* from, RenderGraphNode* to, RenderGraphEdge* edge) SKR_NOEXCEPT;
+    void build() SKR_NOEXCEPT;
+    // rebuilds the adjacency without the edges of culled nodes, alive is indexed by node handle
+    void retain(const eastl::vector<uint8_t>& alive) SKR_NOEXCEPT;
+    // clear() keeps the adjacency of the last build, a frame with the same structure can take it over as is
+    bool reuse() SKR_NOEXCEPT;
+    void clear() SKR_NOEXCEPT;
+
+    inline uint32_t node_count() const SKR_NOEXCEPT { return (uint32_t)nodes.size(); }
+    inline uint32_t edge_count() const SKR_NOEXCEPT { return (uint32_t)edges.size(); }
+    inline RenderGraphNode* node_at(handle_t handle) const SKR_NOEXCEPT
+    {
+        return (handle < nodes.size()) ? nodes[(size_t)handle] : nullptr;
+    }
+    // edge indices leaving/entering the node, valid after build()
+    inline skr::span<const uint32_t> out_edges(handle_t node) const SKR_NOEXCEPT
+    {
+        SKR_ASSERT(built);
+        return { out_list.data() + out_offsets[(size_t)node], out_offsets[(size_t)node + 1] - out_offsets[(size_t)node] };
+    }
+    inline skr::span<const uint32_t> in_edges(handle_t node) const SKR_NOEXCEPT
+    {
+        SKR_ASSERT(built);
+        return { in_list.data() + in_offsets[(size_t)node], in_offsets[(size_t)node + 1] - in_offsets[(size_t)node] };
+    }
+    inline uint32_t out_degree(handle_t node) const SKR_NOEXCEPT { return (uint32_t)out_edges(node).size(); }
+    inline uint32_t in_degree(handle_t node) const SKR_NOEXCEPT { return (uint32_t)in_edges(node).size(); }
+
+    eastl::vector<RenderGraphNode*> nodes;
+    eastl::vector<RenderGraphEdge*> edges;
+    eastl::vector<uint32_t> edge_sources;
+    eastl::vector<uint32_t> edge_targets;
+
+    eastl::vector<uint32_t> out_offsets;
+    eastl::vector<uint32_t> out_list;
+    eastl::vector<uint32_t> in_offsets;
+    eastl::vector<uint32_t> in_list;
+    bool built = false;
+};
+} // namespace render_graph
+} // namespace skr
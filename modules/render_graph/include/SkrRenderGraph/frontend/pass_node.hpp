@@ -2,6 +2,7 @@
 #include "SkrRenderGraph/frontend/base_types.hpp"
 #include "SkrRenderGraph/frontend/resource_node.hpp"
 #include "SkrRenderGraph/frontend/resource_edge.hpp"
+#include "SkrRenderGraph/frontend/frame_arena.hpp"
 #include <EASTL/vector.h>
 
 #ifdef RG_USE_FIXED_VECTOR
@@ -11,12 +12,13 @@
 namespace skr {
 namespace render_graph
 {
+// edge lists grow in the frame arena, they are dropped with it at the end of the frame
 #ifdef RG_USE_FIXED_VECTOR
     template<typename T, uint32_t N = 4>
-    using graph_edges_vector = eastl::fixed_vector<T, N>;  
+    using graph_edges_vector = eastl::fixed_vector<T, N, true, FrameArenaAllocator>;  
 #else
     template<typename T, uint32_t N = 4>
-    using graph_edges_vector = eastl::vector<T>;
+    using graph_edges_vector = eastl::vector<T, FrameArenaAllocator>;
 #endif
 }
 }
@@ -57,7 +59,7 @@ public:
     const uint32_t order;
 protected:
     bool can_be_lone = false;
-    PassNode(EPassType pass_type, uint32_t order);
+    PassNode(EPassType pass_type, uint32_t order, FrameArena* arena);
     graph_edges_vector<TextureReadEdge*> in_texture_edges;
     graph_edges_vector<TextureRenderEdge*> out_texture_edges;
     graph_edges_vector<TextureReadWriteEdge*> inout_texture_edges;
@@ -73,7 +75,7 @@ public:
     friend class RenderGraph;
     friend class RenderGraphBackend;
 
-    RenderPassNode(uint32_t order);
+    RenderPassNode(uint32_t order, FrameArena* arena);
 protected:
     RenderPassExecuteFunction executor;
     CGPURenderPipelineId pipeline = nullptr;
@@ -93,7 +95,7 @@ public:
     friend class RenderGraph;
     friend class RenderGraphBackend;
 
-    ComputePassNode(uint32_t order);
+    ComputePassNode(uint32_t order, FrameArena* arena);
 protected:
     ComputePassExecuteFunction executor;
     CGPUComputePipelineId pipeline;
@@ -106,7 +108,7 @@ public:
     friend class RenderGraph;
     friend class RenderGraphBackend;
 
-    CopyPassNode(uint32_t order);
+    CopyPassNode(uint32_t order, FrameArena* arena);
 protected:
     CopyPassExecuteFunction executor;
     graph_edges_vector<eastl::pair<TextureSubresourceHandle, TextureSubresourceHandle>, 2> t2ts;
@@ -130,7 +132,7 @@ public:
         return true;
     }
 
-    PresentPassNode(uint32_t order);
+    PresentPassNode(uint32_t order, FrameArena* arena);
 protected:
     CGPUQueuePresentDescriptor descriptor;
 };
@@ -2,6 +2,10 @@
 #include <EASTL/vector.h>
 #include "SkrRenderGraph/frontend/base_types.hpp"
 #include "SkrRenderGraph/frontend/blackboard.hpp"
+#include "SkrRenderGraph/frontend/resource_node.hpp"
+#include "SkrRenderGraph/frontend/frame_arena.hpp"
+#include "SkrRenderGraph/frontend/graph_topology.hpp"
+#include "SkrRenderGraph/frontend/state_timeline.hpp"
 
 #ifndef RG_MAX_FRAME_IN_FLIGHT
 #define RG_MAX_FRAME_IN_FLIGHT 3
@@ -38,9 +42,16 @@ public:
         RenderGraphBuilder& with_device(CGPUDeviceId device) SKR_NOEXCEPT;
         RenderGraphBuilder& with_gfx_queue(CGPUQueueId queue) SKR_NOEXCEPT;
         RenderGraphBuilder& enable_memory_aliasing() SKR_NOEXCEPT;
+        // begins transitions right after the last user of a resource and ends them before the next one, d3d12 only
+        RenderGraphBuilder& enable_split_barriers() SKR_NOEXCEPT;
+        // records the passes of a frame in up to max_segments command buffers on the task system
+        // pass executors then run on worker threads, a task scheduler has to be bound to the calling thread
+        RenderGraphBuilder& enable_parallel_recording(uint32_t max_segments) SKR_NOEXCEPT;
 
     protected:
         bool memory_aliasing = false;
+        bool split_barriers = false;
+        uint32_t recording_segments = 1;
         bool no_backend;
         ECGPUBackend api;
         CGPUDeviceId device;
@@ -219,6 +230,9 @@ public:
         return *blackboard;
     }
     virtual uint64_t execute(RenderGraphProfiler* profiler = nullptr) SKR_NOEXCEPT;
+    // blocks until the GPU is done with the frame that last ran on the executor the next execute takes,
+    // host memory that frame read can be rewritten for the next one afterwards
+    virtual void wait_executor() SKR_NOEXCEPT {}
     virtual CGPUDeviceId get_backend_device() SKR_NOEXCEPT { return nullptr; }
     virtual CGPUQueueId get_gfx_queue() SKR_NOEXCEPT { return nullptr; }
     virtual uint32_t collect_garbage(uint64_t critical_frame,
@@ -235,6 +249,13 @@ public:
 
 
     inline uint64_t get_frame_index() const SKR_NOEXCEPT { return frame_index; }
+    // resource state transitions of the last compile
+    inline const StateTimeline& get_state_timeline() const SKR_NOEXCEPT { return compiled.timeline; }
+    // nodes the last compile dropped, nothing that leads to an output of the frame uses them
+    inline const eastl::vector<PassNode*>& get_culled_passes() const SKR_NOEXCEPT { return culled_passes; }
+    inline const eastl::vector<ResourceNode*>& get_culled_resources() const SKR_NOEXCEPT { return culled_resources; }
+    // compiles that took over the result of the previous one instead of running
+    inline uint64_t get_compile_cache_hits() const SKR_NOEXCEPT { return compile_cache_hits; }
 
     inline bool enable_memory_aliasing(bool enabled) SKR_NOEXCEPT
     {
@@ -258,17 +279,61 @@ protected:
     virtual void initialize() SKR_NOEXCEPT;
     virtual void finalize() SKR_NOEXCEPT;
 
+    // copies a name into the frame arena
+    const char8_t* frame_string(const char8_t* str) SKR_NOEXCEPT;
+    template <typename T, typename... Args>
+    T* allocate_node(Args&&... args) SKR_NOEXCEPT
+    {
+        auto node = arena.create<T>(std::forward<Args>(args)...);
+        topology.insert(node);
+        return node;
+    }
+    template <typename T, typename... Args>
+    T* link_edge(RenderGraphNode* from, RenderGraphNode* to, Args&&... args) SKR_NOEXCEPT
+    {
+        auto edge = arena.create<T>(std::forward<Args>(args)...);
+        topology.link(from, to, edge);
+        return edge;
+    }
+    // drops every node and edge of the frame, the arena and the flat arrays keep their memory for the next one
+    void reset_frame() SKR_NOEXCEPT;
+
+    uint64_t hash_structure() SKR_NOEXCEPT;
+    void cull_unreachable() SKR_NOEXCEPT;
+    void calculate_lifespans() SKR_NOEXCEPT;
+    ResourceAccess describe_access(uint32_t edge) const SKR_NOEXCEPT;
+    void calculate_transitions() SKR_NOEXCEPT;
+    void cache_compiled(uint64_t hash) SKR_NOEXCEPT;
+    bool restore_compiled(uint64_t hash) SKR_NOEXCEPT;
+
     bool aliasing_enabled;
+    bool split_barriers_enabled;
     uint64_t frame_index = 0;
+    uint64_t compile_cache_hits = 0;
 
-    struct NodeAndEdgeFactory* object_factory = nullptr;
     Blackboard* blackboard = nullptr;
-    DependencyGraph* graph = nullptr;
+    FrameArena arena;
+    GraphTopology topology;
 
     eastl::vector<PassNode*> passes;
     eastl::vector<ResourceNode*> resources;
     eastl::vector<PassNode*> culled_passes;
     eastl::vector<ResourceNode*> culled_resources;
+
+    // result of the last compile, indexed by node handle
+    // frames with the same structure hash take it over instead of compiling again
+    struct CompiledGraph {
+        uint64_t hash = 0;
+        bool valid = false;
+        eastl::vector<uint8_t> alive;
+        eastl::vector<ResourceNode::LifeSpan> lifespans;
+        StateTimeline timeline;
+    };
+    CompiledGraph compiled;
+    eastl::vector<uint64_t> structure;
+    eastl::vector<uint32_t> cull_stack;
+    eastl::vector<ResourceAccess> accesses;
+    eastl::vector<ResourceUsage> usages;
 };
 using RenderGraphSetupFunction = RenderGraph::RenderGraphSetupFunction;
 using RenderGraphBuilder = RenderGraph::RenderGraphBuilder;
@@ -23,7 +23,7 @@ public:
     friend class RenderGraph;
     friend class RenderGraphBackend;
 
-    inline const char* get_name() const { return name.c_str(); }
+    inline const char* get_name() const { return name.data(); }
     const uint64_t name_hash = 0;
 
     TextureNode* get_texture_node() final;
@@ -36,7 +36,8 @@ public:
 
     TextureReadEdge(const skr::string_view name, TextureSRVHandle handle, ECGPUResourceState state = CGPU_RESOURCE_STATE_SHADER_RESOURCE);
 protected:
-    const graph_object_string name = "";
+    // references a string living in the frame arena
+    const skr::string_view name = "";
     const TextureSRVHandle handle;
 };
 
@@ -49,13 +50,13 @@ public:
 
     const uint64_t name_hash = 0;
 
-    inline const char* get_name() const { return name.c_str(); }
+    inline const char* get_name() const { return name.data(); }
     TextureNode* get_texture_node() final;
     PassNode* get_pass_node() final;
 
     TextureReadWriteEdge(const skr::string_view name, TextureUAVHandle handle, ECGPUResourceState state = CGPU_RESOURCE_STATE_UNORDERED_ACCESS);
 protected:
-    const graph_object_string name = "";
+    const skr::string_view name = "";
     const TextureUAVHandle handle;
 };
 
@@ -102,7 +103,7 @@ public:
     friend class RenderGraph;
     friend class RenderGraphBackend;
 
-    inline const char* get_name() const { return name.c_str(); }
+    inline const char* get_name() const { return name.data(); }
     const uint64_t name_hash = 0;
 
     BufferNode* get_buffer_node() final;
@@ -110,7 +111,7 @@ public:
 
     BufferReadEdge(const skr::string_view name, BufferRangeHandle handle, ECGPUResourceState state);
 protected:
-    const graph_object_string name = "";
+    const skr::string_view name = "";
     BufferRangeHandle handle;
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "SkrRenderGraph/frontend/base_types.hpp"
+#include "SkrRenderGraph/frontend/transient_allocator.hpp"
 
 namespace skr
 {
@@ -17,12 +18,13 @@ public:
     };
     inline const bool is_imported() const SKR_NOEXCEPT { return imported; }
     inline const bool allow_lone() const SKR_NOEXCEPT { return canbe_lone; }
+    // orders of the first and the last pass using the resource, computed by RenderGraph::compile()
     SKR_RENDER_GRAPH_API const LifeSpan lifespan() const SKR_NOEXCEPT;
 protected:
     bool imported = false;
     bool canbe_lone = false;
     uint32_t tags = kRenderGraphInvalidResourceTag;
-    mutable LifeSpan frame_lifespan = { UINT32_MAX, UINT32_MAX };
+    LifeSpan frame_lifespan = { UINT32_MAX, UINT32_MAX };
 };
 
 class TextureNode : public ResourceNode
@@ -50,12 +52,13 @@ public:
         return asize * mips * width * height * depth * FormatUtil_BitSizeOfBlock(descriptor.format);
     }
     inline const ECGPUSampleCount get_sample_count() const SKR_NOEXCEPT { return descriptor.sample_count; }
-    inline const TextureNode* get_aliasing_parent() const SKR_NOEXCEPT { return frame_aliasing_source; }
+    // heap and offset the backend placed the texture at, unplaced textures come from the texture pool
+    inline const TransientPlacement& get_placement() const SKR_NOEXCEPT { return frame_placement; }
 
 protected:
     CGPUTextureDescriptor descriptor = {};
     // temporal handle with a lifespan of only one frame
-    TextureNode* frame_aliasing_source = nullptr;
+    mutable TransientPlacement frame_placement = {};
     mutable CGPUTextureId frame_texture = nullptr;
     mutable ECGPUResourceState init_state = CGPU_RESOURCE_STATE_UNDEFINED;
     mutable bool frame_aliasing = false;
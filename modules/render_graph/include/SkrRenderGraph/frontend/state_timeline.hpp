@@ -0,0 +1,104 @@
+#pragma once
+#include "SkrRenderGraph/frontend/base_types.hpp"
+#include <EASTL/vector.h>
+
+namespace skr
+{
+namespace render_graph
+{
+// one edge of a live pass, as seen by the barrier planner
+struct ResourceAccess {
+    uint32_t edge;
+    uint32_t pass_order;
+    ECGPUResourceState state;
+    // state the pass leaves the resource in, copy passes may move their destinations on after the copy
+    ECGPUResourceState exit_state;
+    // subresources touched by the pass, a count of 0 means up to the last one
+    uint32_t mip_base = 0;
+    uint32_t mip_count = 0;
+    uint32_t array_base = 0;
+    uint32_t array_count = 0;
+};
+
+// accesses of one resource are contiguous in the access list, sorted by pass order and then by edge
+struct ResourceUsage {
+    handle_t resource;
+    uint32_t first_access;
+    uint32_t access_count;
+    // buffers are a single subresource
+    uint32_t mip_levels = 1;
+    uint32_t array_size = 1;
+};
+
+enum class EBarrierSplit : uint8_t
+{
+    None,
+    Begin,
+    End
+};
+
+struct ResourceTransition {
+    handle_t resource;
+    // not known before execution when from_initial is set, the backend takes the state the resource was resolved in
+    ECGPUResourceState src_state;
+    ECGPUResourceState dst_state;
+    uint32_t mip_level = 0;
+    uint32_t array_layer = 0;
+    bool whole = true;
+    bool from_initial = false;
+    EBarrierSplit split = EBarrierSplit::None;
+    // order of the pass at the other end of a split barrier
+    uint32_t split_pass = UINT32_MAX;
+};
+
+// state of every subresource of every live resource over the passes of a compiled graph
+// transitions are found once per compile instead of walking the other users of a resource for every edge:
+// - a transition is emitted only for the subresources an edge touches, redundant ones are dropped
+// - edges of the same pass all see the states the resource had before that pass
+// - after the last user the resource is left in one state, the one the pools and the next frame expect
+// - with split barriers, a transition whose source pass ran a while before begins right after that pass
+class SKR_RENDER_GRAPH_API StateTimeline
+{
+public:
+    void build(skr::span<const ResourceAccess> accesses, skr::span<const ResourceUsage> usages,
+        uint32_t node_count, uint32_t edge_count, uint32_t pass_count, bool split_barriers) SKR_NOEXCEPT;
+
+    // transitions to record right before the pass of the edge
+    inline skr::span<const ResourceTransition> get_edge_transitions(uint32_t edge) const SKR_NOEXCEPT
+    {
+        return { edge_transitions.data() + edge_offsets[edge], edge_offsets[edge + 1] - edge_offsets[edge] };
+    }
+    // transitions to record right after the pass: begins of split barriers and the final state of resources
+    inline skr::span<const ResourceTransition> get_pass_transitions(uint32_t pass_order) const SKR_NOEXCEPT
+    {
+        return { pass_transitions.data() + pass_offsets[pass_order], pass_offsets[pass_order + 1] - pass_offsets[pass_order] };
+    }
+    // state of the whole resource after its last user
+    inline ECGPUResourceState get_final_state(handle_t resource) const SKR_NOEXCEPT { return final_states[(size_t)resource]; }
+    // transitions that were not emitted because the subresource was already in the requested state
+    inline uint32_t get_merged_count() const SKR_NOEXCEPT { return merged_count; }
+
+protected:
+    void plan_access(skr::span<const ResourceAccess> accesses, const ResourceUsage& usage, uint32_t access, bool split_barriers) SKR_NOEXCEPT;
+    void emit(skr::span<const ResourceAccess> accesses, const ResourceUsage& usage, uint32_t access, uint32_t source,
+        uint32_t subresource, bool whole, bool split_barriers) SKR_NOEXCEPT;
+    static void bucket(eastl::vector<ResourceTransition>& transitions, const eastl::vector<uint32_t>& keys,
+        uint32_t key_count, eastl::vector<uint32_t>& offsets, eastl::vector<ResourceTransition>& sorted) SKR_NOEXCEPT;
+
+    eastl::vector<uint32_t> edge_offsets;
+    eastl::vector<ResourceTransition> edge_transitions;
+    eastl::vector<uint32_t> pass_offsets;
+    eastl::vector<ResourceTransition> pass_transitions;
+    eastl::vector<ECGPUResourceState> final_states;
+    uint32_t merged_count = 0;
+
+    // scratch: last access of each subresource of the resource being planned, and the pass group that touched it
+    eastl::vector<uint32_t> current;
+    eastl::vector<uint32_t> pending;
+    eastl::vector<ResourceTransition> unsorted;
+    eastl::vector<uint32_t> unsorted_keys;
+    eastl::vector<ResourceTransition> after_pass;
+    eastl::vector<uint32_t> after_pass_keys;
+};
+} // namespace render_graph
+} // namespace skr
@@ -0,0 +1,72 @@
+#pragma once
+#include "SkrRenderGraph/rg_config.h"
+#include "platform/configure.h"
+#include "containers/span.hpp"
+#include <EASTL/vector.h>
+
+namespace skr
+{
+namespace render_graph
+{
+// heaps never mix kinds, tier 1 devices can not place render targets, other textures and buffers in one heap
+enum class ETransientHeapKind : uint32_t
+{
+    RenderTarget,
+    Texture,
+    Buffer,
+    Count
+};
+
+struct TransientRequest {
+    uint64_t size;
+    uint64_t alignment;
+    // orders of the first and the last pass using the resource, both inclusive
+    uint32_t from;
+    uint32_t to;
+    ETransientHeapKind kind;
+};
+
+struct TransientPlacement {
+    uint32_t heap = UINT32_MAX;
+    uint64_t offset = 0;
+
+    inline bool placed() const SKR_NOEXCEPT { return heap != UINT32_MAX; }
+};
+
+struct TransientHeap {
+    ETransientHeapKind kind;
+    uint64_t size;
+};
+
+// places the transient resources of a compiled graph into a few shared heaps
+// resources whose lifespans do not overlap may share memory, the planner is first fit decreasing:
+// requests are taken from the largest down and put at the lowest aligned offset free for their whole lifespan
+// it only does the bookkeeping, the backend turns heaps and offsets into device memory
+class SKR_RENDER_GRAPH_API TransientAllocator
+{
+public:
+    // heaps stay below the block size of the memory allocators, larger allocations become dedicated and can not be aliased
+    static constexpr uint64_t kDefaultMaxHeapSize = 32ull * 1024 * 1024;
+
+    // placements are indexed like the requests, a request larger than max_heap_size gets a heap of its own
+    void plan(skr::span<const TransientRequest> requests, uint64_t max_heap_size = kDefaultMaxHeapSize) SKR_NOEXCEPT;
+
+    inline skr::span<const TransientPlacement> get_placements() const SKR_NOEXCEPT { return { placements.data(), placements.size() }; }
+    inline skr::span<const TransientHeap> get_heaps() const SKR_NOEXCEPT { return { heaps.data(), heaps.size() }; }
+    // bytes of all heaps, and bytes the requests would take without aliasing
+    uint64_t get_heaps_size() const SKR_NOEXCEPT;
+    inline uint64_t get_requested_size() const SKR_NOEXCEPT { return requested_size; }
+
+protected:
+    bool try_place(skr::span<const TransientRequest> requests, uint32_t request, uint32_t heap, uint64_t max_heap_size) SKR_NOEXCEPT;
+
+    eastl::vector<TransientPlacement> placements;
+    eastl::vector<TransientHeap> heaps;
+    // requests in placement order, and the placed requests conflicting with the one being placed
+    eastl::vector<uint32_t> order;
+    eastl::vector<uint32_t> conflicts;
+    uint32_t placed_count = 0;
+    uint64_t requested_size = 0;
+};
+} // namespace render_graph
+} // namespace skr
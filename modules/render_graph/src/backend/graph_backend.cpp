@@ -1,11 +1,12 @@
 ﻿#include "SkrRenderGraph/backend/graph_backend.hpp"
 #include "SkrRenderGraph/frontend/pass_node.hpp"
-#include "SkrRenderGraph/frontend/node_and_edge_factory.hpp"
 #include "platform/debug.h"
 #include "platform/memory.h"
 #include "platform/thread.h"
 #include "utils/hash.h"
 #include "utils/log.h"
+#include "utils/defer.hpp"
+#include "task/task.hpp"
 #include <EASTL/set.h>
 #include <containers/text.hpp>
 
@@ -17,28 +18,51 @@ namespace render_graph
 {
 // Render Graph Executor
 
-void RenderGraphFrameExecutor::initialize(CGPUQueueId gfx_queue, CGPUDeviceId device)
+void RenderGraphFrameExecutor::initialize(CGPUQueueId gfx_queue, CGPUDeviceId device_, bool segment)
 {
+    queue = gfx_queue;
+    device = device_;
     CGPUCommandPoolDescriptor pool_desc = {};
     gfx_cmd_pool = cgpu_create_command_pool(gfx_queue, &pool_desc);
     CGPUCommandBufferDescriptor cmd_desc = {};
     cmd_desc.is_secondary = false;
     gfx_cmd_buf = cgpu_create_command_buffer(gfx_cmd_pool, &cmd_desc);
-    exec_fence = cgpu_create_fence(device);
+    if (!segment) exec_fence = cgpu_create_fence(device);
 
     CGPUMarkerBufferDescriptor marker_desc = {};
     marker_desc.marker_count = 1000;
     marker_buffer = cgpu_create_marker_buffer(device, &marker_desc);
 }
 
-void RenderGraphFrameExecutor::commit(CGPUQueueId gfx_queue, uint64_t frame_index)
+RenderGraphFrameExecutor& RenderGraphFrameExecutor::get_segment(uint32_t index)
 {
+    if (index == 0) return *this;
+    while (segments.size() < index)
+    {
+        auto segment = SkrNew<RenderGraphFrameExecutor>();
+        segment->initialize(queue, device, true);
+        segments.emplace_back(segment);
+    }
+    return *segments[index - 1];
+}
+
+void RenderGraphFrameExecutor::commit(CGPUQueueId gfx_queue, uint64_t frame_index, uint32_t segment_count)
+{
+    SKR_ASSERT(segment_count && segment_count <= segments.size() + 1);
+    submit_cmds.clear();
+    for (uint32_t i = 0; i < segment_count; i++)
+    {
+        auto& segment = get_segment(i);
+        submit_cmds.emplace_back(segment.gfx_cmd_buf);
+        segment.exec_frame = frame_index;
+    }
     CGPUQueueSubmitDescriptor submit_desc = {};
-    submit_desc.cmds = &gfx_cmd_buf;
-    submit_desc.cmds_count = 1;
+    submit_desc.cmds = submit_cmds.data();
+    submit_desc.cmds_count = segment_count;
     submit_desc.signal_fence = exec_fence;
     cgpu_submit_queue(gfx_queue, &submit_desc);
     exec_frame = frame_index;
+    recorded_segments = segment_count;
 }
 
 void RenderGraphFrameExecutor::reset_begin(TextureViewPool& texture_view_pool)
@@ -85,6 +109,18 @@ void RenderGraphFrameExecutor::reset_begin(TextureViewPool& texture_view_pool)
     write_marker("Frame Begin");
 }
 
+void RenderGraphFrameExecutor::invalidate_bind_tables()
+{
+    for (auto segment : segments)
+    {
+        segment->invalidate_bind_tables();
+    }
+    for (auto bind_table_pool : bind_table_pools)
+    {
+        bind_table_pool.second->invalidate();
+    }
+}
+
 void RenderGraphFrameExecutor::write_marker(const char* message)
 {
     cgpu_marker_buffer_write(gfx_cmd_buf, marker_buffer, marker_idx++, valid_marker_val);
@@ -93,6 +129,10 @@ void RenderGraphFrameExecutor::write_marker(const char* message)
 
 void RenderGraphFrameExecutor::print_error_trace(uint64_t frame_index)
 {
+    for (uint32_t i = 1; i < recorded_segments; i++)
+    {
+        get_segment(i).print_error_trace(frame_index);
+    }
     auto fill_data = (const uint32_t*)marker_buffer->cgpu_buffer->cpu_mapped_address;
     if (fill_data[0] == 0) return;// begin cmd is unlikely to fail on gpu
     SKR_LOG_FATAL("Device lost caused by GPU command buffer failure detected %d frames ago, command trace:", frame_index - exec_frame);
@@ -122,6 +162,12 @@ CGPUXMergedBindTableId RenderGraphFrameExecutor::merge_tables(const struct CGPUX
 
 void RenderGraphFrameExecutor::finalize()
 {
+    for (auto segment : segments)
+    {
+        segment->finalize();
+        SkrDelete(segment);
+    }
+    segments.clear();
     if (gfx_cmd_buf) cgpu_free_command_buffer(gfx_cmd_buf);
     if (gfx_cmd_pool) cgpu_free_command_pool(gfx_cmd_pool);
     if (exec_fence) cgpu_free_fence(exec_fence);
@@ -151,6 +197,7 @@ RenderGraphBackend::RenderGraphBackend(const RenderGraphBuilder& builder)
     : RenderGraph(builder)
     , gfx_queue(builder.gfx_queue)
     , device(builder.device)
+    , recording_segments(builder.recording_segments)
 {
 }
 
@@ -180,6 +227,9 @@ void RenderGraphBackend::initialize() SKR_NOEXCEPT
 {
     RenderGraph::initialize();
     backend = device->adapter->instance->backend;
+    // only d3d12 has split barriers, elsewhere the begin would already do the whole transition
+    if (backend != CGPU_BACKEND_D3D12) split_barriers_enabled = false;
+    recording_segments = recording_segments ? recording_segments : 1;
     for (uint32_t i = 0; i < RG_MAX_FRAME_IN_FLIGHT; i++)
     {
         executors[i].initialize(gfx_queue, device);
@@ -192,6 +242,7 @@ void RenderGraphBackend::initialize() SKR_NOEXCEPT
 void RenderGraphBackend::finalize() SKR_NOEXCEPT
 {
     RenderGraph::finalize();
+    retire_transients(executors[0]);
     for (uint32_t i = 0; i < RG_MAX_FRAME_IN_FLIGHT; i++)
     {
         executors[i].finalize();
@@ -202,32 +253,137 @@ void RenderGraphBackend::finalize() SKR_NOEXCEPT
 }
 
 // memory aliasing:
-// - lifespan不重叠的资源对象都可以考虑做aliasing处理
-// - aliasing的memory-type有要求，需要检查两个对象之间的内存堆兼容性
-// - 可以撮合两个对象，将它们提升为可alias的，把他们的size和alignment取最大处理即可。
-//  - 首先寻找可以直接alias处理的, cgpu_try_create_aliasing_resource(ResourceId, ResourceDesc)
-//  - 其次再考虑提升合并的行为（此行为在前端无法模拟）
-CGPUTextureId RenderGraphBackend::try_aliasing_allocate(RenderGraphFrameExecutor& executor, const TextureNode& node) SKR_NOEXCEPT
+// - the transient textures of a compiled graph are planned once by the TransientAllocator, lifespans come from the frontend
+// - every heap is backed by a plain texture, placed textures are created as aliasing textures and bound at their offsets
+// - frames with the same compiled hash take the placed textures over as is, a texture that can not be placed uses the texture pool
+// - MSAA and dedicated textures are never placed, they need their own memory on some backends
+static constexpr uint64_t kTransientTextureAlignment = 64 * 1024;
+static constexpr uint32_t kTransientHeapWidth = 16384;
+static constexpr uint32_t kTransientHeapTexelSize = 4;
+
+void RenderGraphBackend::retire_transients(RenderGraphFrameExecutor& executor) SKR_NOEXCEPT
+{
+    // cached tables may bind their views, the views of the next placed textures can come back at the same addresses
+    if (!transients.heaps.empty()) invalidate_bind_tables();
+    // frames in flight may still use them, the executor frees them once its fence has passed
+    for (auto texture : transients.textures)
+    {
+        if (texture) executor.aliasing_textures.emplace_back(texture);
+    }
+    for (auto heap : transients.heaps)
+    {
+        executor.aliasing_textures.emplace_back(heap);
+    }
+    transients.textures.clear();
+    transients.placements.clear();
+    transients.heaps.clear();
+    transients.valid = false;
+}
+
+void RenderGraphBackend::build_transients(RenderGraphFrameExecutor& executor) SKR_NOEXCEPT
 {
-    if (node.frame_aliasing_source)
+    ZoneScopedN("BuildTransientTextures");
+    retire_transients(executor);
+    const auto node_count = topology.node_count();
+    transients.textures.resize(node_count, nullptr);
+    transients.placements.resize(node_count);
+    transient_requests.clear();
+    transient_nodes.clear();
+    for (auto resource : resources)
+    {
+        if (resource->type != EObjectType::Texture || resource->is_imported()) continue;
+        auto texture = static_cast<TextureNode*>(resource);
+        const auto lifespan = texture->lifespan();
+        const auto& desc = texture->descriptor;
+        if (lifespan.from > lifespan.to || desc.is_dedicated ||
+            (desc.flags & CGPU_TCF_OWN_MEMORY_BIT) || desc.sample_count != CGPU_SAMPLE_COUNT_1)
+            continue;
+        // aliasing textures have no memory until they are bound, but report the size they need
+        auto aliasing_desc = desc;
+        aliasing_desc.is_aliasing = true;
+        auto aliasing = cgpu_create_texture(device, &aliasing_desc);
+        if (!aliasing) continue;
+        if (!aliasing->size_in_bytes)
+        {
+            cgpu_free_texture(aliasing);
+            continue;
+        }
+        TransientRequest request = {};
+        request.size = aliasing->size_in_bytes;
+        request.alignment = kTransientTextureAlignment;
+        request.from = lifespan.from;
+        request.to = lifespan.to;
+        request.kind = (desc.descriptors & (CGPU_RESOURCE_TYPE_RENDER_TARGET | CGPU_RESOURCE_TYPE_DEPTH_STENCIL)) ?
+            ETransientHeapKind::RenderTarget : ETransientHeapKind::Texture;
+        transient_requests.emplace_back(request);
+        transient_nodes.emplace_back(texture->get_id());
+        transients.textures[texture->get_id()] = aliasing;
+    }
+    transient_allocator.plan({ transient_requests.data(), transient_requests.size() });
+    for (const auto& heap : transient_allocator.get_heaps())
     {
-        ZoneScopedN("AllocateAliasingResource");
-        // allocate & try bind
-        auto aliasing_texture = cgpu_create_texture(device, &node.descriptor);
+        CGPUTextureDescriptor heap_desc = {};
+        heap_desc.name = u8"RenderGraphTransientHeap";
+        heap_desc.width = kTransientHeapWidth;
+        heap_desc.height = (uint32_t)((heap.size + kTransientHeapWidth * kTransientHeapTexelSize - 1) / (kTransientHeapWidth * kTransientHeapTexelSize));
+        heap_desc.depth = 1;
+        heap_desc.array_size = 1;
+        heap_desc.mip_levels = 1;
+        heap_desc.format = CGPU_FORMAT_R8G8B8A8_UNORM;
+        heap_desc.sample_count = CGPU_SAMPLE_COUNT_1;
+        heap_desc.descriptors = (heap.kind == ETransientHeapKind::RenderTarget) ?
+            (CGPU_RESOURCE_TYPE_TEXTURE | CGPU_RESOURCE_TYPE_RENDER_TARGET) : CGPU_RESOURCE_TYPE_TEXTURE;
+        transients.heaps.emplace_back(cgpu_create_texture(device, &heap_desc));
+    }
+    const auto placements = transient_allocator.get_placements();
+    for (uint32_t i = 0; i < transient_nodes.size(); i++)
+    {
+        const auto id = transient_nodes[i];
+        const auto& placement = placements[i];
         CGPUTextureAliasingBindDescriptor aliasing_desc = {};
-        aliasing_desc.aliased = resolve(executor, *node.frame_aliasing_source);
-        aliasing_desc.aliasing = aliasing_texture;
-        node.frame_aliasing = cgpu_try_bind_aliasing_texture(device, &aliasing_desc);
-        if (!node.frame_aliasing)
+        aliasing_desc.aliased = transients.heaps[placement.heap];
+        aliasing_desc.aliasing = transients.textures[id];
+        aliasing_desc.offset = placement.offset;
+        if (aliasing_desc.aliased && cgpu_try_bind_aliasing_texture(device, &aliasing_desc))
         {
-            cgpu_free_texture(aliasing_texture);
-            ((TextureNode&)node).descriptor.is_aliasing = false;
-            return nullptr;
+            transients.placements[id] = placement;
+        }
+        else
+        {
+            cgpu_free_texture(transients.textures[id]);
+            transients.textures[id] = nullptr;
+        }
+    }
+    SKR_LOG_TRACE("RenderGraph placed %d transient textures in %d heaps, %llu of %llu bytes",
+        (uint32_t)transient_nodes.size(), (uint32_t)transients.heaps.size(),
+        transient_allocator.get_heaps_size(), transient_allocator.get_requested_size());
+    transients.hash = compiled.hash;
+    transients.valid = true;
+}
+
+void RenderGraphBackend::place_transients(RenderGraphFrameExecutor& executor) SKR_NOEXCEPT
+{
+    // the compiled result is only valid for this frame if compile() ran on it
+    if (!aliasing_enabled || !compiled.valid || !topology.built)
+    {
+        if (transients.valid) retire_transients(executor);
+        return;
+    }
+    ZoneScopedN("PlaceTransientTextures");
+    if (!transients.valid || transients.hash != compiled.hash) build_transients(executor);
+    for (auto resource : resources)
+    {
+        if (resource->type != EObjectType::Texture) continue;
+        const auto id = resource->get_id();
+        if (auto placed = transients.textures[id])
+        {
+            auto texture = static_cast<TextureNode*>(resource);
+            texture->frame_texture = placed;
+            texture->frame_placement = transients.placements[id];
+            texture->frame_aliasing = true;
+            texture->init_state = CGPU_RESOURCE_STATE_UNDEFINED;
         }
-        executor.aliasing_textures.emplace_back(aliasing_texture);
-        return aliasing_texture;
     }
-    return nullptr;
 }
 
 uint64_t RenderGraphBackend::get_latest_finished_frame() SKR_NOEXCEPT
@@ -251,17 +407,10 @@ CGPUTextureId RenderGraphBackend::resolve(RenderGraphFrameExecutor& executor, co
     ZoneScopedN("ResolveTexture");
     if (!node.frame_texture)
     {
-        if (auto aliased = try_aliasing_allocate(executor, node); aliased)
-        {
-            node.frame_texture = aliased;
-            node.init_state = CGPU_RESOURCE_STATE_UNDEFINED;
-        }
-        else
-        {
-            auto allocated = texture_pool.allocate(node.descriptor, { frame_index, node.tags });
-            node.frame_texture = node.imported ? node.frame_texture : allocated.first;
-            node.init_state = allocated.second;
-        }
+        // placed textures were resolved by place_transients() before the passes ran
+        auto allocated = texture_pool.allocate(node.descriptor, { frame_index, node.tags });
+        node.frame_texture = node.imported ? node.frame_texture : allocated.first;
+        node.init_state = allocated.second;
     }
     return node.frame_texture;
 }
@@ -279,11 +428,45 @@ CGPUBufferId RenderGraphBackend::resolve(RenderGraphFrameExecutor& executor, con
     return node.frame_buffer;
 }
 
+// transitions from the initial state are only known once the resource is resolved for the frame
+static void append_barrier(stack_vector<CGPUTextureBarrier>& barriers, const ResourceTransition& transition, EBarrierSplit split,
+    ECGPUResourceState init_state, CGPUTextureId texture) SKR_NOEXCEPT
+{
+    const auto src_state = transition.from_initial ? init_state : transition.src_state;
+    if (src_state == transition.dst_state) return;
+    CGPUTextureBarrier barrier = {};
+    barrier.src_state = src_state;
+    barrier.dst_state = transition.dst_state;
+    barrier.texture = texture;
+    barrier.subresource_barrier = !transition.whole;
+    barrier.mip_level = (uint8_t)transition.mip_level;
+    barrier.array_layer = (uint16_t)transition.array_layer;
+    barrier.d3d12.begin_ony = (split == EBarrierSplit::Begin);
+    barrier.d3d12.end_only = (split == EBarrierSplit::End);
+    barriers.emplace_back(barrier);
+}
+
+static void append_barrier(stack_vector<CGPUBufferBarrier>& barriers, const ResourceTransition& transition, EBarrierSplit split,
+    ECGPUResourceState init_state, CGPUBufferId buffer) SKR_NOEXCEPT
+{
+    const auto src_state = transition.from_initial ? init_state : transition.src_state;
+    if (src_state == transition.dst_state) return;
+    CGPUBufferBarrier barrier = {};
+    barrier.src_state = src_state;
+    barrier.dst_state = transition.dst_state;
+    barrier.buffer = buffer;
+    barrier.d3d12.begin_ony = (split == EBarrierSplit::Begin);
+    barrier.d3d12.end_only = (split == EBarrierSplit::End);
+    barriers.emplace_back(barrier);
+}
+
 void RenderGraphBackend::calculate_barriers(RenderGraphFrameExecutor& executor, PassNode* pass,
     stack_vector<CGPUTextureBarrier>& tex_barriers, stack_vector<eastl::pair<TextureHandle, CGPUTextureId>>& resolved_textures,
     stack_vector<CGPUBufferBarrier>& buf_barriers, stack_vector<eastl::pair<BufferHandle, CGPUBufferId>>& resolved_buffers) SKR_NOEXCEPT
 {
     ZoneScopedN("CalculateBarriers");
+    // the transitions were planned by compile(), only the initial states are left to look at
+    const auto& timeline = compiled.timeline;
     tex_barriers.reserve(pass->textures_count());
     resolved_textures.reserve(pass->textures_count());
     buf_barriers.reserve(pass->buffers_count());
@@ -292,30 +475,56 @@ void RenderGraphBackend::calculate_barriers(RenderGraphFrameExecutor& executor,
         [&](TextureNode* texture, TextureEdge* edge) {
             auto tex_resolved = resolve(executor, *texture);
             resolved_textures.emplace_back(texture->get_handle(), tex_resolved);
-            const auto current_state = get_lastest_state(texture, pass);
-            const auto dst_state = edge->requested_state;
-            if (current_state == dst_state) return;
-            CGPUTextureBarrier barrier = {};
-            barrier.src_state = current_state;
-            barrier.dst_state = dst_state;
-            barrier.texture = tex_resolved;
-            tex_barriers.emplace_back(barrier);
+            for (const auto& transition : timeline.get_edge_transitions(edge->get_id()))
+            {
+                append_barrier(tex_barriers, transition, split_of(transition, pass->order), texture->init_state, tex_resolved);
+            }
         });
     pass->foreach_buffers(
         [&](BufferNode* buffer, BufferEdge* edge) {
             auto buf_resolved = resolve(executor, *buffer);
             resolved_buffers.emplace_back(buffer->get_handle(), buf_resolved);
-            const auto current_state = get_lastest_state(buffer, pass);
-            const auto dst_state = edge->requested_state;
-            if (current_state == dst_state) return;
-            CGPUBufferBarrier barrier = {};
-            barrier.src_state = current_state;
-            barrier.dst_state = dst_state;
-            barrier.buffer = buf_resolved;
-            buf_barriers.emplace_back(barrier);
+            for (const auto& transition : timeline.get_edge_transitions(edge->get_id()))
+            {
+                append_barrier(buf_barriers, transition, split_of(transition, pass->order), buffer->init_state, buf_resolved);
+            }
         });
 }
 
+void RenderGraphBackend::record_pass_transitions(RenderGraphFrameExecutor& executor, PassNode* pass) SKR_NOEXCEPT
+{
+    const auto transitions = compiled.timeline.get_pass_transitions(pass->order);
+    if (transitions.empty()) return;
+
+    ZoneScopedN("PassTransitions");
+    // resources used by the pass were resolved by resolve_resources()
+    stack_vector<CGPUTextureBarrier> tex_barriers = {};
+    stack_vector<CGPUBufferBarrier> buf_barriers = {};
+    for (const auto& transition : transitions)
+    {
+        const auto split = split_of(transition, pass->order);
+        if (transition.split == EBarrierSplit::Begin && split == EBarrierSplit::None) continue;
+        auto node = topology.nodes[(size_t)transition.resource];
+        if (node->type == EObjectType::Texture)
+        {
+            auto texture = static_cast<TextureNode*>(node);
+            append_barrier(tex_barriers, transition, split, texture->init_state, texture->frame_texture);
+        }
+        else
+        {
+            auto buffer = static_cast<BufferNode*>(node);
+            append_barrier(buf_barriers, transition, split, buffer->init_state, buffer->frame_buffer);
+        }
+    }
+    if (tex_barriers.empty() && buf_barriers.empty()) return;
+    CGPUResourceBarrierDescriptor barriers = {};
+    barriers.texture_barriers = tex_barriers.data();
+    barriers.texture_barriers_count = (uint32_t)tex_barriers.size();
+    barriers.buffer_barriers = buf_barriers.data();
+    barriers.buffer_barriers_count = (uint32_t)buf_barriers.size();
+    cgpu_cmd_resource_barrier(executor.gfx_cmd_buf, &barriers);
+}
+
 const CGPUShaderResource* find_shader_resource(uint64_t name_hash, CGPURootSignatureId root_sig, ECGPUResourceType* type = nullptr)
 {
     for (uint32_t i = 0; i < root_sig->table_count; i++)
@@ -355,8 +564,8 @@ CGPUXBindTableId RenderGraphBackend::alloc_update_pass_bind_table(RenderGraphFra
     stack_vector<const char8_t*> bindTableValueNames = {};
     // CBV Buffers
     stack_vector<CGPUBufferId> cbvs(buf_read_edges.size());
-    stack_vector<CGPUTextureViewId> srvs(tex_read_edges.size());
-    stack_vector<CGPUTextureViewId> uavs(tex_rw_edges.size());
+    // SRVs then UAVs
+    stack_vector<CGPUTextureViewId> views(tex_read_edges.size() + tex_rw_edges.size());
     {
         for (uint32_t e_idx = 0; e_idx < buf_read_edges.size(); e_idx++)
         {
@@ -367,7 +576,7 @@ CGPUXBindTableId RenderGraphBackend::alloc_update_pass_bind_table(RenderGraphFra
 
             ECGPUResourceType resource_type = resource.type;
             {
-                bind_table_keys += read_edge->name.empty() ? resource.name : (const char8_t*)read_edge->name.c_str();
+                bind_table_keys += read_edge->name.empty() ? resource.name : (const char8_t*)read_edge->name.data();
                 bind_table_keys += u8";";
                 bindTableValueNames.emplace_back(resource.name);
 
@@ -390,7 +599,7 @@ CGPUXBindTableId RenderGraphBackend::alloc_update_pass_bind_table(RenderGraphFra
             const auto& resource = *find_shader_resource(read_edge->name_hash, root_sig);
 
             {
-                bind_table_keys += read_edge->name.empty() ? resource.name : (const char8_t*)read_edge->name.c_str();
+                bind_table_keys += read_edge->name.empty() ? resource.name : (const char8_t*)read_edge->name.data();
                 bind_table_keys += u8";";
                 bindTableValueNames.emplace_back(resource.name);
 
@@ -415,8 +624,8 @@ CGPUXBindTableId RenderGraphBackend::alloc_update_pass_bind_table(RenderGraphFra
                     CGPU_TVA_COLOR;
                 view_desc.usages = CGPU_TVU_SRV;
                 view_desc.dims = read_edge->get_dimension();
-                srvs[e_idx] = texture_view_pool.allocate(view_desc, frame_index);
-                update.textures = &srvs[e_idx];
+                views[e_idx] = texture_view_pool.allocate(view_desc, frame_index);
+                update.textures = &views[e_idx];
                 desc_set_updates.emplace_back(update);
             }
         }
@@ -428,7 +637,7 @@ CGPUXBindTableId RenderGraphBackend::alloc_update_pass_bind_table(RenderGraphFra
             const auto& resource = *find_shader_resource(rw_edge->name_hash, root_sig);
 
             {
-                bind_table_keys += rw_edge->name.empty() ? resource.name : (const char8_t*)rw_edge->name.c_str();
+                bind_table_keys += rw_edge->name.empty() ? resource.name : (const char8_t*)rw_edge->name.data();
                 bind_table_keys += u8";";
                 bindTableValueNames.emplace_back(resource.name);
 
@@ -448,31 +657,49 @@ CGPUXBindTableId RenderGraphBackend::alloc_update_pass_bind_table(RenderGraphFra
                 view_desc.format = (ECGPUFormat)view_desc.texture->format;
                 view_desc.usages = CGPU_TVU_UAV;
                 view_desc.dims = CGPU_TEX_DIMENSION_2D;
-                uavs[e_idx] = texture_view_pool.allocate(view_desc, frame_index);
-                update.textures = &uavs[e_idx];
+                const auto view_idx = tex_read_edges.size() + e_idx;
+                views[view_idx] = texture_view_pool.allocate(view_desc, frame_index);
+                update.textures = &views[view_idx];
                 desc_set_updates.emplace_back(update);
             }
         }
     }
-    auto bind_table = executor.bind_table_pools[root_sig]->pop(bind_table_keys.c_str(), bindTableValueNames.data(), (uint32_t)bindTableValueNames.size());
-    cgpux_bind_table_update(bind_table, desc_set_updates.data(), (uint32_t)desc_set_updates.size());
+    // imported buffers are freed outside of the graph and may be recreated at the same address,
+    // tables binding them are written every frame, all others are found again by the resources they bind.
+    // transient aliases live as long as the compiled graph, retire_transients drops the tables binding them
+    bool cacheable = true;
+    for (auto read_edge : buf_read_edges) cacheable &= !read_edge->get_buffer_node()->imported;
+    auto& table_pool = *executor.bind_table_pools[root_sig];
+    if (!cacheable)
+    {
+        auto bind_table = table_pool.pop(bind_table_keys.c_str(), bindTableValueNames.data(), (uint32_t)bindTableValueNames.size());
+        cgpux_bind_table_update(bind_table, desc_set_updates.data(), (uint32_t)desc_set_updates.size());
+        return bind_table;
+    }
+    BindTablePool::Bindings bindings = {};
+    bindings.buffers = cbvs.data();
+    bindings.buffers_count = (uint32_t)cbvs.size();
+    bindings.textures = views.data();
+    bindings.textures_count = (uint32_t)views.size();
+    bool needs_update = false;
+    auto bind_table = table_pool.pop_cached(bind_table_keys.c_str(), bindTableValueNames.data(), (uint32_t)bindTableValueNames.size(),
+        bindings, frame_index, needs_update);
+    if (needs_update)
+    {
+        ZoneScopedN("UpdateBindTable");
+        cgpux_bind_table_update(bind_table, desc_set_updates.data(), (uint32_t)desc_set_updates.size());
+    }
     return bind_table;
 }
 
 void RenderGraphBackend::deallocate_resources(PassNode* pass) SKR_NOEXCEPT
 {
     ZoneScopedN("VirtualDeallocate");
-    pass->foreach_textures([this, pass](TextureNode* texture, TextureEdge* edge) {
+    // resources go back to the pools in the state the state timeline leaves them in
+    const auto& timeline = compiled.timeline;
+    pass->foreach_textures([this, pass, &timeline](TextureNode* texture, TextureEdge*) {
         if (texture->imported) return;
-        bool is_last_user = true;
-        texture->foreach_neighbors([&](DependencyGraphNode* neig) {
-            RenderGraphNode* rg_node = (RenderGraphNode*)neig;
-            if (rg_node->type == EObjectType::Pass)
-            {
-                PassNode* other_pass = (PassNode*)rg_node;
-                is_last_user = is_last_user && (pass->order >= other_pass->order);
-            }
-        });
+        const bool is_last_user = pass->order >= texture->lifespan().to;
         if (is_last_user)
         {
             if (!texture->frame_aliasing)
@@ -480,27 +707,19 @@ void RenderGraphBackend::deallocate_resources(PassNode* pass) SKR_NOEXCEPT
                 ZoneScopedN("VirtualDeallocate::TextureFromPool");
 
                 texture_pool.deallocate(texture->descriptor, texture->frame_texture,
-                    edge->requested_state, { frame_index, texture->tags });
+                    timeline.get_final_state(texture->get_id()), { frame_index, texture->tags });
             }
         }
     });
-    pass->foreach_buffers([this, pass](BufferNode* buffer, BufferEdge* edge) {
+    pass->foreach_buffers([this, pass, &timeline](BufferNode* buffer, BufferEdge*) {
         if (buffer->imported) return;
-        bool is_last_user = true;
-        buffer->foreach_neighbors([&](DependencyGraphNode* neig) {
-            RenderGraphNode* rg_node = (RenderGraphNode*)neig;
-            if (rg_node->type == EObjectType::Pass)
-            {
-                PassNode* other_pass = (PassNode*)rg_node;
-                is_last_user = is_last_user && (pass->order >= other_pass->order);
-            }
-        });
+        const bool is_last_user = pass->order >= buffer->lifespan().to;
         if (is_last_user)
         {
             ZoneScopedN("VirtualDeallocate::BufferFromPool");
 
             buffer_pool.deallocate(buffer->descriptor, buffer->frame_buffer,
-                edge->requested_state, { frame_index, buffer->tags });
+                timeline.get_final_state(buffer->get_id()), { frame_index, buffer->tags });
         }
     });
 }
@@ -508,7 +727,7 @@ void RenderGraphBackend::deallocate_resources(PassNode* pass) SKR_NOEXCEPT
 void RenderGraphBackend::execute_compute_pass(RenderGraphFrameExecutor& executor, ComputePassNode* pass) SKR_NOEXCEPT
 {
     ZoneScopedC(tracy::Color::LightBlue);
-    ZoneName(pass->name.c_str(), pass->name.size());
+    ZoneName(pass->name.data(), pass->name.size());
 
     ComputePassContext pass_context = {};
     // resource de-virtualize
@@ -538,7 +757,7 @@ void RenderGraphBackend::execute_compute_pass(RenderGraphFrameExecutor& executor
         barriers.buffer_barriers = buffer_barriers.data();
         barriers.buffer_barriers_count = (uint32_t)buffer_barriers.size();
     }
-    CGPUEventInfo event = { (const char8_t*)pass->name.c_str(), { 1.f, 1.f, 0.f, 1.f } };
+    CGPUEventInfo event = { (const char8_t*)pass->name.data(), { 1.f, 1.f, 0.f, 1.f } };
     cgpu_cmd_begin_event(executor.gfx_cmd_buf, &event);
     cgpu_cmd_resource_barrier(executor.gfx_cmd_buf, &barriers);
     // dispatch
@@ -557,14 +776,12 @@ void RenderGraphBackend::execute_compute_pass(RenderGraphFrameExecutor& executor
     }
     cgpu_cmd_end_compute_pass(executor.gfx_cmd_buf, pass_context.encoder);
     cgpu_cmd_end_event(executor.gfx_cmd_buf);
-    // deallocate
-    deallocate_resources(pass);
 }
 
 void RenderGraphBackend::execute_render_pass(RenderGraphFrameExecutor& executor, RenderPassNode* pass) SKR_NOEXCEPT
 {
     ZoneScopedC(tracy::Color::LightPink);
-    ZoneName(pass->name.c_str(), pass->name.size());
+    ZoneName(pass->name.data(), pass->name.size());
 
     RenderPassContext pass_context = {};
     // resource de-virtualize
@@ -594,7 +811,7 @@ void RenderGraphBackend::execute_render_pass(RenderGraphFrameExecutor& executor,
         barriers.buffer_barriers = buffer_barriers.data();
         barriers.buffer_barriers_count = (uint32_t)buffer_barriers.size();
     }
-    CGPUEventInfo event = { (const char8_t*)pass->name.c_str(), { 1.f, 0.5f, 0.5f, 1.f } };
+    CGPUEventInfo event = { (const char8_t*)pass->name.data(), { 1.f, 0.5f, 0.5f, 1.f } };
     cgpu_cmd_begin_event(executor.gfx_cmd_buf, &event);
     cgpu_cmd_resource_barrier(executor.gfx_cmd_buf, &barriers);
     {
@@ -729,11 +946,11 @@ void RenderGraphBackend::execute_render_pass(RenderGraphFrameExecutor& executor,
     }
     if (pass->pipeline) 
     {
-        cgpu_render_encoder_bind_pipeline(pass_context.encoder, pass->pipeline);
+        pass_context.bind_pipeline(pass->pipeline);
     }
     if(pass_context.bind_table)
     {
-        cgpux_render_encoder_bind_bind_table(pass_context.encoder, pass_context.bind_table);
+        pass_context.bind_bind_table(pass_context.bind_table);
     }
     {
         ZoneScopedN("PassExecutor");
@@ -748,14 +965,12 @@ void RenderGraphBackend::execute_render_pass(RenderGraphFrameExecutor& executor,
         executor.write_marker(message.c_str());
     }
     cgpu_cmd_end_event(executor.gfx_cmd_buf);
-    // deallocate
-    deallocate_resources(pass);
 }
 
 void RenderGraphBackend::execute_copy_pass(RenderGraphFrameExecutor& executor, CopyPassNode* pass) SKR_NOEXCEPT
 {
     ZoneScopedC(tracy::Color::LightYellow);
-    ZoneName(pass->name.c_str(), pass->name.size());
+    ZoneName(pass->name.data(), pass->name.size());
     // resource de-virtualize
     stack_vector<CGPUTextureBarrier> tex_barriers = {};
     stack_vector<eastl::pair<TextureHandle, CGPUTextureId>> resolved_textures = {};
@@ -780,7 +995,7 @@ void RenderGraphBackend::execute_copy_pass(RenderGraphFrameExecutor& executor, C
         barriers.buffer_barriers = buffer_barriers.data();
         barriers.buffer_barriers_count = (uint32_t)buffer_barriers.size();
     }
-    CGPUEventInfo event = { (const char8_t*)pass->name.c_str(), { 0.f, .5f, 1.f, 1.f } };
+    CGPUEventInfo event = { (const char8_t*)pass->name.data(), { 0.f, .5f, 1.f, 1.f } };
     cgpu_cmd_begin_event(executor.gfx_cmd_buf, &event);
     {
         CopyPassContext stack = {};
@@ -860,7 +1075,6 @@ void RenderGraphBackend::execute_copy_pass(RenderGraphFrameExecutor& executor, C
     }
     cgpu_cmd_resource_barrier(executor.gfx_cmd_buf, &late_barriers);
     cgpu_cmd_end_event(executor.gfx_cmd_buf);
-    deallocate_resources(pass);
 }
 
 void RenderGraphBackend::execute_present_pass(RenderGraphFrameExecutor& executor, PresentPassNode* pass) SKR_NOEXCEPT
@@ -869,20 +1083,121 @@ void RenderGraphBackend::execute_present_pass(RenderGraphFrameExecutor& executor
     auto&& read_edge = read_edges[0];
     auto texture_target = read_edge->get_texture_node();
     auto back_buffer = pass->descriptor.swapchain->back_buffers[pass->descriptor.index];
-    CGPUTextureBarrier present_barrier = {};
-    present_barrier.texture = back_buffer;
-    present_barrier.src_state = get_lastest_state(texture_target, pass);
-    present_barrier.dst_state = CGPU_RESOURCE_STATE_PRESENT;
+    stack_vector<CGPUTextureBarrier> present_barriers = {};
+    for (const auto& transition : compiled.timeline.get_edge_transitions(read_edge->get_id()))
+    {
+        append_barrier(present_barriers, transition, split_of(transition, pass->order), texture_target->init_state, back_buffer);
+    }
+    if (present_barriers.empty()) return;
     CGPUResourceBarrierDescriptor barriers = {};
-    barriers.texture_barriers = &present_barrier;
-    barriers.texture_barriers_count = 1;
+    barriers.texture_barriers = present_barriers.data();
+    barriers.texture_barriers_count = (uint32_t)present_barriers.size();
     cgpu_cmd_resource_barrier(executor.gfx_cmd_buf, &barriers);
 }
 
+void RenderGraphBackend::resolve_resources(RenderGraphFrameExecutor& executor) SKR_NOEXCEPT
+{
+    ZoneScopedN("ResolveResources");
+    // the pools hand a resource back out as soon as its last user is done, so this has to follow the pass order
+    for (auto pass : passes)
+    {
+        pass->foreach_textures([&](TextureNode* texture, TextureEdge*) { resolve(executor, *texture); });
+        pass->foreach_buffers([&](BufferNode* buffer, BufferEdge*) { resolve(executor, *buffer); });
+        deallocate_resources(pass);
+    }
+}
+
+uint32_t RenderGraphBackend::plan_segments(bool serial) SKR_NOEXCEPT
+{
+    // contiguous runs of passes with about the same count each, one more segment for every kPassesPerSegment passes begun,
+    // frames that fit in a single segment are not worth a task
+    static constexpr uint32_t kPassesPerSegment = 16;
+    const auto pass_count = (uint32_t)passes.size();
+    uint32_t segment_count = serial ? 1 : (pass_count + kPassesPerSegment - 1) / kPassesPerSegment;
+    segment_count = (segment_count < recording_segments) ? segment_count : recording_segments;
+    segment_count = segment_count ? segment_count : 1;
+    segment_bounds.resize(segment_count + 1);
+    for (uint32_t i = 0; i <= segment_count; i++)
+    {
+        segment_bounds[i] = (uint32_t)((uint64_t)pass_count * i / segment_count);
+    }
+    pass_segments.clear();
+    pass_segments.resize(passes.empty() ? 0 : passes.back()->order + 1, 0);
+    for (uint32_t i = 0; i < segment_count; i++)
+    {
+        for (uint32_t p = segment_bounds[i]; p < segment_bounds[i + 1]; p++)
+            pass_segments[passes[p]->order] = i;
+    }
+    return segment_count;
+}
+
+EBarrierSplit RenderGraphBackend::split_of(const ResourceTransition& transition, uint32_t pass_order) const SKR_NOEXCEPT
+{
+    // both halves of a split barrier have to be in one command buffer, otherwise the transition is done where it ends
+    if (transition.split == EBarrierSplit::None) return EBarrierSplit::None;
+    return (pass_segments[transition.split_pass] == pass_segments[pass_order]) ? transition.split : EBarrierSplit::None;
+}
+
+void RenderGraphBackend::record_passes(RenderGraphFrameExecutor& executor, uint32_t segment, RenderGraphProfiler* profiler) SKR_NOEXCEPT
+{
+    ZoneScopedN("RecordPasses");
+    {
+        ZoneScopedN("GraphExecutorBeginEvent");
+
+        skr::string frameLabel = "Frame";
+        frameLabel.append(skr::to_string(frame_index));
+        if (segment)
+        {
+            frameLabel.append("-Segment");
+            frameLabel.append(skr::to_string(segment));
+        }
+        CGPUEventInfo event = { (const char8_t*)frameLabel.c_str(), { 0.8f, 0.8f, 0.8f, 1.f } };
+        cgpu_cmd_begin_event(executor.gfx_cmd_buf, &event);
+    }
+    for (uint32_t i = segment_bounds[segment]; i < segment_bounds[segment + 1]; i++)
+    {
+        auto pass = passes[i];
+        if (pass->pass_type == EPassType::Render)
+        {
+            if (profiler) profiler->on_pass_begin(*this, executor, *pass);
+            execute_render_pass(executor, static_cast<RenderPassNode*>(pass));
+            if (profiler) profiler->on_pass_end(*this, executor, *pass);
+        }
+        else if (pass->pass_type == EPassType::Present)
+        {
+            if (profiler) profiler->on_pass_begin(*this, executor, *pass);
+            execute_present_pass(executor, static_cast<PresentPassNode*>(pass));
+            if (profiler) profiler->on_pass_end(*this, executor, *pass);
+        }
+        else if (pass->pass_type == EPassType::Compute)
+        {
+            if (profiler) profiler->on_pass_begin(*this, executor, *pass);
+            execute_compute_pass(executor, static_cast<ComputePassNode*>(pass));
+            if (profiler) profiler->on_pass_end(*this, executor, *pass);
+        }
+        else if (pass->pass_type == EPassType::Copy)
+        {
+            if (profiler) profiler->on_pass_begin(*this, executor, *pass);
+            execute_copy_pass(executor, static_cast<CopyPassNode*>(pass));
+            if (profiler) profiler->on_pass_end(*this, executor, *pass);
+        }
+        record_pass_transitions(executor, pass);
+    }
+    cgpu_cmd_end_event(executor.gfx_cmd_buf);
+}
+
+void RenderGraphBackend::wait_executor() SKR_NOEXCEPT
+{
+    ZoneScopedN("WaitExecutor");
+    auto& executor = executors[frame_index % RG_MAX_FRAME_IN_FLIGHT];
+    cgpu_wait_fences(&executor.exec_fence, 1);
+}
+
 uint64_t RenderGraphBackend::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
 {
     const auto executor_index = frame_index % RG_MAX_FRAME_IN_FLIGHT;
     RenderGraphFrameExecutor& executor = executors[executor_index];
+    uint32_t segment_count = 1;
     if (device->is_lost)
     {
         for (uint32_t i = 0; i < RG_MAX_FRAME_IN_FLIGHT; i++)
@@ -899,47 +1214,31 @@ uint64_t RenderGraphBackend::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
     {
         ZoneScopedN("GraphExecutePasses");
         executor.reset_begin(texture_view_pool);
-        if (profiler) profiler->on_cmd_begin(*this, executor);
-        {
-            ZoneScopedN("GraphExecutorBeginEvent");
-
-            skr::string frameLabel = "Frame";
-            frameLabel.append(skr::to_string(frame_index));
-            CGPUEventInfo event = { (const char8_t*)frameLabel.c_str(), { 0.8f, 0.8f, 0.8f, 1.f } };
-            cgpu_cmd_begin_event(executor.gfx_cmd_buf, &event);
-        }
-        for (auto& pass : passes)
+        place_transients(executor);
+        resolve_resources(executor);
+        // profilers see every pass on the command buffer of the executor
+        segment_count = plan_segments(profiler != nullptr);
+        // a single segment is recorded on this thread alone, no task is scheduled or waited for
+        skr::task::counter_t counter;
+        if (segment_count > 1) counter.add(segment_count - 1);
+        for (uint32_t i = 1; i < segment_count; i++)
         {
-            if (pass->pass_type == EPassType::Render)
-            {
-                if (profiler) profiler->on_pass_begin(*this, executor, *pass);
-                execute_render_pass(executor, static_cast<RenderPassNode*>(pass));
-                if (profiler) profiler->on_pass_end(*this, executor, *pass);
-            }
-            else if (pass->pass_type == EPassType::Present)
-            {
-                if (profiler) profiler->on_pass_begin(*this, executor, *pass);
-                execute_present_pass(executor, static_cast<PresentPassNode*>(pass));
-                if (profiler) profiler->on_pass_end(*this, executor, *pass);
-            }
-            else if (pass->pass_type == EPassType::Compute)
-            {
-                if (profiler) profiler->on_pass_begin(*this, executor, *pass);
-                execute_compute_pass(executor, static_cast<ComputePassNode*>(pass));
-                if (profiler) profiler->on_pass_end(*this, executor, *pass);
-            }
-            else if (pass->pass_type == EPassType::Copy)
-            {
-                if (profiler) profiler->on_pass_begin(*this, executor, *pass);
-                execute_copy_pass(executor, static_cast<CopyPassNode*>(pass));
-                if (profiler) profiler->on_pass_end(*this, executor, *pass);
-            }
-        }
-        {
-            cgpu_cmd_end_event(executor.gfx_cmd_buf);
+            auto& segment = executor.get_segment(i);
+            skr::task::schedule([this, &segment, i, counter]() mutable {
+                SKR_DEFER({ counter.decrement(); });
+                segment.reset_begin(texture_view_pool);
+                record_passes(segment, i, nullptr);
+                cgpu_cmd_end(segment.gfx_cmd_buf);
+            }, nullptr);
         }
+        if (profiler) profiler->on_cmd_begin(*this, executor);
+        record_passes(executor, 0, profiler);
         if (profiler) profiler->on_cmd_end(*this, executor);
         cgpu_cmd_end(executor.gfx_cmd_buf);
+        {
+            ZoneScopedN("WaitSegments");
+            if (segment_count > 1) counter.wait(false);
+        }
     }
     {
         // submit
@@ -947,47 +1246,13 @@ uint64_t RenderGraphBackend::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
         if (profiler) profiler->before_commit(*this, executor);
         {
             ZoneScopedN("CGPUGfxQueueSubmit");
-            executor.commit(gfx_queue, frame_index);
+            executor.commit(gfx_queue, frame_index, segment_count);
         }
         if (profiler) profiler->after_commit(*this, executor);
     }
     {
         ZoneScopedN("GraphCleanup");
-        // 1.dealloc culled resources
-        for (auto culled_resource : culled_resources)
-        {
-            object_factory->Dealloc(culled_resource);
-        }
-        culled_resources.clear();
-        // 2.dealloc culled passes 
-        for (auto culled_pass : culled_passes)
-        {
-            object_factory->Dealloc(culled_pass);
-        }
-        culled_passes.clear();
-        // 3.dealloc passes & connected edges 
-        for (auto pass : passes)
-        {
-            pass->foreach_textures(
-            [this](TextureNode* t, TextureEdge* e) {
-                object_factory->Dealloc(e);
-            });
-            pass->foreach_buffers(
-            [this](BufferNode* t, BufferEdge* e) {
-                object_factory->Dealloc(e);
-            });
-            object_factory->Dealloc(pass);
-        }
-        passes.clear();
-        // 4.dealloc resource nodes
-        for (auto resource : resources)
-        {
-            object_factory->Dealloc(resource);
-        }
-        resources.clear();
-
-        graph->clear();
-        blackboard->clear();
+        reset_frame();
     }
     return frame_index++;
 }
@@ -1031,6 +1296,7 @@ uint32_t RenderGraphBackend::collect_texture_garbage(uint64_t critical_frame, ui
             queue.end());
         total_count += prev_count - (uint32_t)queue.size();
     }
+    if (total_count) invalidate_bind_tables();
     return total_count;
 }
 
@@ -1062,7 +1328,17 @@ uint32_t RenderGraphBackend::collect_buffer_garbage(uint64_t critical_frame, uin
                 queue.end());
         total_count += prev_count - (uint32_t)queue.size();
     }
+    if (total_count) invalidate_bind_tables();
     return total_count;
 }
+
+void RenderGraphBackend::invalidate_bind_tables() SKR_NOEXCEPT
+{
+    // cached tables may hold descriptors of the freed resources, whose addresses can come back with new ones
+    for (uint32_t i = 0; i < RG_MAX_FRAME_IN_FLIGHT; i++)
+    {
+        executors[i].invalidate_bind_tables();
+    }
+}
 } // namespace render_graph
 } // namespace skr
\ No newline at end of file
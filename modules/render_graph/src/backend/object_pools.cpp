@@ -2,6 +2,7 @@
 #include "utils/hash.h"
 #include "utils/log.h"
 #include "utils/make_zeroed.hpp"
+#include <EASTL/algorithm.h>
 #include <EASTL/set.h>
 
 #include "SkrRenderGraph/backend/bind_table_pool.hpp"
@@ -133,6 +134,100 @@ CGPUXBindTableId BindTablePool::pop(const char* keys, const CGPUXName* names, ui
     return block.bind_tables[block.cursor++];
 }
 
+bool BindTablePool::CachedBindTable::matches(const Bindings& bindings) const
+{
+    return buffers.size() == bindings.buffers_count && textures.size() == bindings.textures_count &&
+        eastl::equal(buffers.begin(), buffers.end(), bindings.buffers) &&
+        eastl::equal(textures.begin(), textures.end(), bindings.textures);
+}
+
+CGPUXBindTableId BindTablePool::pop_cached(const char* keys, const CGPUXName* names, uint32_t names_count,
+    const Bindings& bindings, uint64_t frame_index, bool& needs_update)
+{
+    auto existed_block = pool.find(keys);
+    if (existed_block == pool.end())
+    {
+        existed_block = pool.emplace(skr::string(keys), BindTablesBlock{}).first;
+    }
+    auto& block = existed_block->second;
+    size_t bindings_hash = skr_hash(bindings.buffers, bindings.buffers_count * sizeof(CGPUBufferId), CGPU_NAME_HASH_SEED);
+    bindings_hash = skr_hash(bindings.textures, bindings.textures_count * sizeof(CGPUTextureViewId), bindings_hash);
+    auto found = block.cached_lookup.find(bindings_hash);
+    if (found != block.cached_lookup.end())
+    {
+        auto& cached = block.cached[found->second];
+        if (cached.matches(bindings))
+        {
+            cached.last_used = frame_index;
+            needs_update = false;
+            return cached.bind_table;
+        }
+        // colliding bindings take over the lookup slot, the table they shadow ages out as usual
+    }
+    // tables used this frame may already be recorded, they are never taken over
+    uint32_t victim = UINT32_MAX;
+    uint64_t oldest = frame_index;
+    for (uint32_t i = 0; i < block.cached.size(); i++)
+    {
+        const auto& cached = block.cached[i];
+        if (cached.last_used >= frame_index) continue;
+        if (!cached.valid)
+        {
+            victim = i;
+            break;
+        }
+        if (block.cached.size() >= kMaxCachedTables && cached.last_used < oldest)
+        {
+            oldest = cached.last_used;
+            victim = i;
+        }
+    }
+    CGPUXBindTableDescriptor table_desc = {};
+    table_desc.root_signature = root_sig;
+    table_desc.names = names;
+    table_desc.names_count = names_count;
+    if (victim == UINT32_MAX)
+    {
+        victim = (uint32_t)block.cached.size();
+        block.cached.emplace_back(CachedBindTable{ cgpux_create_bind_table(root_sig->device, &table_desc), 0, 0, true });
+    }
+    auto& cached = block.cached[victim];
+    if (!cached.valid)
+    {
+        // an invalidated table may still hold handles the new bindings reuse for other resources,
+        // a bind table skips values equal to the ones it has, so it is made again from scratch.
+        // only this executor records with it and its last frame is done
+        cgpux_free_bind_table(cached.bind_table);
+        cached.bind_table = cgpux_create_bind_table(root_sig->device, &table_desc);
+    }
+    else
+    {
+        auto shadowed = block.cached_lookup.find(cached.bindings_hash);
+        if (shadowed != block.cached_lookup.end() && shadowed->second == victim)
+            block.cached_lookup.erase(shadowed);
+    }
+    cached.bindings_hash = bindings_hash;
+    cached.last_used = frame_index;
+    cached.valid = true;
+    cached.buffers.assign(bindings.buffers, bindings.buffers + bindings.buffers_count);
+    cached.textures.assign(bindings.textures, bindings.textures + bindings.textures_count);
+    block.cached_lookup[bindings_hash] = victim;
+    needs_update = true;
+    return cached.bind_table;
+}
+
+void BindTablePool::invalidate()
+{
+    for (auto& [name, block] : pool)
+    {
+        for (auto& cached : block.cached)
+        {
+            cached.valid = false;
+        }
+        block.cached_lookup.clear();
+    }
+}
+
 void BindTablePool::reset() 
 { 
     for (auto& [name, block] : pool)
@@ -150,6 +245,12 @@ void BindTablePool::destroy()
         {
             cgpux_free_bind_table(bind_table);
         }
+        for (auto& cached : block.cached)
+        {
+            cgpux_free_bind_table(cached.bind_table);
+        }
+        block.cached.clear();
+        block.cached_lookup.clear();
     }
 }
 
@@ -244,6 +345,8 @@ TextureViewPool::Key::Key(CGPUDeviceId device, const CGPUTextureViewDescriptor&
 
 uint32_t TextureViewPool::erase(CGPUTextureId texture)
 {
+    // views are allocated from segments recorded in parallel, erase takes the same lock
+    SMutexLock lock(mutex.mMutex);
     auto prev_size = (uint32_t)views.size();
     for (auto it = views.begin(); it != views.end();)
     {
@@ -280,6 +383,7 @@ void TextureViewPool::finalize()
 CGPUTextureViewId TextureViewPool::allocate(const CGPUTextureViewDescriptor& desc, uint64_t frame_index)
 {
     const auto key = make_zeroed<TextureViewPool::Key>(device, desc);
+    SMutexLock lock(mutex.mMutex);
     auto found = views.find(key);
     if (found != views.end())
     {
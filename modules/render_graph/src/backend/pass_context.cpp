@@ -1,6 +1,5 @@
 #include "SkrRenderGraph/backend/graph_backend.hpp"
 #include "SkrRenderGraph/frontend/pass_node.hpp"
-#include "SkrRenderGraph/frontend/node_and_edge_factory.hpp"
 
 namespace skr
 {
@@ -39,8 +38,79 @@ void RenderPassContext::merge_and_bind_tables(const struct CGPUXBindTable **tabl
 {
     // allocate merged table from pool in executor
     const struct CGPUXMergedBindTable* merged_table = executor->merge_tables(tables, count);
+    // the pool hands out the same merged table for the same tables
+    if (bound_table == merged_table)
+    {
+        elided_binds++;
+        return;
+    }
     // bind merged table to cmd buffer
     cgpux_render_encoder_bind_merged_bind_table(encoder, merged_table);
+    bound_table = merged_table;
+}
+
+void RenderPassContext::bind_pipeline(CGPURenderPipelineId pipeline) SKR_NOEXCEPT
+{
+    if (bound_pipeline == pipeline)
+    {
+        elided_binds++;
+        return;
+    }
+    cgpu_render_encoder_bind_pipeline(encoder, pipeline);
+    bound_pipeline = pipeline;
+    // tables bound against another root signature do not survive the switch
+    if (bound_root_signature != pipeline->root_signature)
+    {
+        bound_root_signature = pipeline->root_signature;
+        bound_table = nullptr;
+    }
+}
+
+void RenderPassContext::bind_bind_table(const struct CGPUXBindTable* table) SKR_NOEXCEPT
+{
+    if (bound_table == table)
+    {
+        elided_binds++;
+        return;
+    }
+    cgpux_render_encoder_bind_bind_table(encoder, table);
+    bound_table = table;
+}
+
+void RenderPassContext::bind_index_buffer(CGPUBufferId buffer, uint32_t index_stride, uint64_t offset) SKR_NOEXCEPT
+{
+    if (bound_index_buffer == buffer && bound_index_stride == index_stride && bound_index_offset == offset)
+    {
+        elided_binds++;
+        return;
+    }
+    cgpu_render_encoder_bind_index_buffer(encoder, buffer, index_stride, offset);
+    bound_index_buffer = buffer;
+    bound_index_stride = index_stride;
+    bound_index_offset = offset;
+}
+
+void RenderPassContext::bind_vertex_buffers(uint32_t count, const CGPUBufferId* buffers, const uint32_t* strides, const uint32_t* offsets) SKR_NOEXCEPT
+{
+    SKR_ASSERT(count <= CGPU_MAX_VERTEX_BINDINGS);
+    bool same = (bound_vertex_count == count);
+    for (uint32_t i = 0; same && i < count; i++)
+    {
+        same = (bound_vertex_buffers[i] == buffers[i]) && (bound_vertex_strides[i] == strides[i]) && (bound_vertex_offsets[i] == offsets[i]);
+    }
+    if (same)
+    {
+        elided_binds++;
+        return;
+    }
+    cgpu_render_encoder_bind_vertex_buffers(encoder, count, buffers, strides, offsets);
+    bound_vertex_count = count;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        bound_vertex_buffers[i] = buffers[i];
+        bound_vertex_strides[i] = strides[i];
+        bound_vertex_offsets[i] = offsets[i];
+    }
 }
 
 void ComputePassContext::merge_and_bind_tables(const struct CGPUXBindTable **tables, uint32_t count) SKR_NOEXCEPT
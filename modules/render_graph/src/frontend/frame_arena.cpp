@@ -0,0 +1,86 @@
+#include "SkrRenderGraph/frontend/frame_arena.hpp"
+#include "platform/memory.h"
+#include "platform/debug.h"
+#include <string.h>
+
+#include "tracy/Tracy.hpp"
+
+namespace skr
+{
+namespace render_graph
+{
+static constexpr size_t kFrameArenaBlockAlignment = 64;
+
+FrameArena::FrameArena(size_t block_size) SKR_NOEXCEPT
+    : block_size(block_size)
+{
+}
+
+FrameArena::~FrameArena() SKR_NOEXCEPT
+{
+    for (auto block : blocks)
+    {
+        sakura_free_aligned(block.memory, kFrameArenaBlockAlignment);
+    }
+}
+
+void FrameArena::new_block(size_t min_size) SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraph::FrameArenaBlock");
+
+    const size_t size = (min_size > block_size) ? min_size : block_size;
+    Block block;
+    block.memory = (uint8_t*)sakura_malloc_aligned(size, kFrameArenaBlockAlignment);
+    block.size = size;
+    blocks.emplace_back(block);
+    total_size += size;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) SKR_NOEXCEPT
+{
+    SKR_ASSERT(alignment && (alignment & (alignment - 1)) == 0 && alignment <= kFrameArenaBlockAlignment);
+    if (blocks.empty()) new_block(size);
+    for (;;)
+    {
+        const auto& block = blocks[current];
+        const size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+        if (aligned + size <= block.size)
+        {
+            offset = aligned + size;
+            return block.memory + aligned;
+        }
+        // move to the next block, blocks kept from earlier frames are reused before a new one is allocated
+        used += offset;
+        offset = 0;
+        if (++current == blocks.size()) new_block(size);
+    }
+}
+
+const char8_t* FrameArena::duplicate(const char8_t* str, size_t length) SKR_NOEXCEPT
+{
+    auto copied = (char8_t*)allocate(length + 1, alignof(char8_t));
+    if (length) memcpy(copied, str, length);
+    copied[length] = 0;
+    return copied;
+}
+
+void FrameArena::reset() SKR_NOEXCEPT
+{
+    if (blocks.size() > 1 && current > 0)
+    {
+        ZoneScopedN("RenderGraph::FrameArenaCoalesce");
+        const size_t size = total_size;
+        for (auto block : blocks)
+        {
+            sakura_free_aligned(block.memory, kFrameArenaBlockAlignment);
+        }
+        blocks.clear();
+        total_size = 0;
+        new_block(size);
+    }
+    used = 0;
+    current = 0;
+    offset = 0;
+}
+} // namespace render_graph
+} // namespace skr
@@ -1,7 +1,6 @@
 #include "platform/debug.h"
 #include "SkrRenderGraph/frontend/render_graph.hpp"
 #include "SkrRenderGraph/frontend/pass_node.hpp"
-#include "SkrRenderGraph/frontend/node_and_edge_factory.hpp"
 #include "utils/log.h"
 
 namespace skr
@@ -27,6 +26,18 @@ RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::enable_memory_
     return *this;
 }
 
+RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::enable_split_barriers() SKR_NOEXCEPT
+{
+    split_barriers = true;
+    return *this;
+}
+
+RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::enable_parallel_recording(uint32_t max_segments) SKR_NOEXCEPT
+{
+    recording_segments = max_segments;
+    return *this;
+}
+
 RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::with_gfx_queue(CGPUQueueId queue) SKR_NOEXCEPT
 {
     gfx_queue = queue;
@@ -50,9 +61,8 @@ PassHandle RenderGraph::add_render_pass(const RenderPassSetupFunction& setup, co
     ZoneScopedN("CopyPassBuilder::add_render_pass");
 
     const uint32_t passes_size = static_cast<uint32_t>(passes.size());
-    auto newPass = object_factory->Allocate<RenderPassNode>(passes_size);
+    auto newPass = allocate_node<RenderPassNode>(passes_size, &arena);
     passes.emplace_back(newPass);
-    graph->insert(newPass);
     // build up
     RenderPassBuilder builder(*this, *newPass);
     setup(*this, builder);
@@ -65,7 +75,7 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::set_name(const c
 {
     if (name)
     {
-        node.set_name(name);
+        node.set_name(graph.frame_string(name));
         graph.blackboard->add_pass((const char*)node.get_name(), &node);
     }
     return *this;
@@ -73,9 +83,8 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::set_name(const c
 
 RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::read(const char8_t* name, TextureSRVHandle handle) SKR_NOEXCEPT
 {
-    auto allocated = graph.object_factory->Allocate<TextureReadEdge>((const char*)name, handle);
-    auto&& edge = node.in_texture_edges.emplace_back(allocated);
-    graph.graph->link(graph.graph->access_node(handle._this), &node, edge);
+    auto edge = graph.link_edge<TextureReadEdge>(graph.topology.node_at(handle._this), &node, (const char*)graph.frame_string(name), handle);
+    node.in_texture_edges.emplace_back(edge);
     return *this;
 }
 
@@ -83,9 +92,8 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::write(
     uint32_t mrt_index, TextureRTVHandle handle, ECGPULoadAction load_action, CGPUClearValue clear_color,
     ECGPUStoreAction store_action) SKR_NOEXCEPT
 {
-    auto allocated = graph.object_factory->Allocate<TextureRenderEdge>(mrt_index, handle._this, clear_color);
-    auto&& edge = node.out_texture_edges.emplace_back(allocated);
-    graph.graph->link(&node, graph.graph->access_node(handle._this), edge);
+    auto edge = graph.link_edge<TextureRenderEdge>(&node, graph.topology.node_at(handle._this), mrt_index, handle._this, clear_color);
+    node.out_texture_edges.emplace_back(edge);
     node.load_actions[mrt_index] = load_action;
     node.store_actions[mrt_index] = store_action;
     return *this;
@@ -96,10 +104,9 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::write(
 // CGPU_MAX_MRT_COUNT + 1 .. 2 * CGPU_MAX_MRT_COUNT ResolveTargets
 RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::resolve_msaa(uint32_t mrt_index, TextureSubresourceHandle handle)
 {
-    auto allocated = graph.object_factory->Allocate<TextureRenderEdge>(
+    auto edge = graph.link_edge<TextureRenderEdge>(&node, graph.topology.node_at(handle._this),
         CGPU_MAX_MRT_COUNT + 1 + mrt_index, handle._this, fastclear_0000, CGPU_RESOURCE_STATE_RESOLVE_DEST);
-    auto&& edge = node.out_texture_edges.emplace_back(allocated);
-    graph.graph->link(&node, graph.graph->access_node(handle._this), edge);
+    node.out_texture_edges.emplace_back(edge);
     return *this;
 }
 
@@ -107,10 +114,9 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::set_depth_stenci
     ECGPULoadAction dload_action, ECGPUStoreAction dstore_action,
     ECGPULoadAction sload_action, ECGPUStoreAction sstore_action) SKR_NOEXCEPT
 {
-    auto allocated = graph.object_factory->Allocate<TextureRenderEdge>(
+    auto edge = graph.link_edge<TextureRenderEdge>(&node, graph.topology.node_at(handle._this),
         CGPU_MAX_MRT_COUNT, handle._this, fastclear_0000, CGPU_RESOURCE_STATE_DEPTH_WRITE);
-    auto&& edge = node.out_texture_edges.emplace_back(allocated);
-    graph.graph->link(&node, graph.graph->access_node(handle._this), edge);
+    node.out_texture_edges.emplace_back(edge);
     node.depth_load_action = dload_action;
     node.depth_store_action = dstore_action;
     node.stencil_load_action = sload_action;
@@ -121,9 +127,8 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::set_depth_stenci
 
 RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::read(const char8_t* name, BufferRangeHandle handle) SKR_NOEXCEPT
 {
-    auto allocated = graph.object_factory->Allocate<BufferReadEdge>((const char*)name, handle, CGPU_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
-    auto&& edge = node.in_buffer_edges.emplace_back(allocated);
-    graph.graph->link(graph.graph->access_node(handle._this), &node, edge);
+    auto edge = graph.link_edge<BufferReadEdge>(graph.topology.node_at(handle._this), &node, (const char*)graph.frame_string(name), handle, CGPU_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+    node.in_buffer_edges.emplace_back(edge);
     return *this;
 }
 
@@ -135,9 +140,8 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::write(const char
 
 RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::use_buffer(PipelineBufferHandle buffer, ECGPUResourceState requested_state) SKR_NOEXCEPT
 {
-    auto allocated = graph.object_factory->Allocate<PipelineBufferEdge>(buffer, requested_state);
-    auto&& edge = node.ppl_buffer_edges.emplace_back(allocated);
-    graph.graph->link(graph.graph->access_node(buffer._this), &node, edge);
+    auto edge = graph.link_edge<PipelineBufferEdge>(graph.topology.node_at(buffer._this), &node, buffer, requested_state);
+    node.ppl_buffer_edges.emplace_back(edge);
     return *this;
 }
 
@@ -165,25 +169,23 @@ RenderGraph::ComputePassBuilder& RenderGraph::ComputePassBuilder::set_name(const
 {
     if (name)
     {
-        graph.blackboard->add_pass((const char*)name, &node);
-        node.set_name(name);
+        node.set_name(graph.frame_string(name));
+        graph.blackboard->add_pass((const char*)node.get_name(), &node);
     }
     return *this;
 }
 
 RenderGraph::ComputePassBuilder& RenderGraph::ComputePassBuilder::read(const char8_t* name, TextureSRVHandle handle) SKR_NOEXCEPT
 {
-    auto allocated = graph.object_factory->Allocate<TextureReadEdge>((const char*)name, handle);
-    auto&& edge = node.in_texture_edges.emplace_back(allocated);
-    graph.graph->link(graph.graph->access_node(handle._this), &node, edge);
+    auto edge = graph.link_edge<TextureReadEdge>(graph.topology.node_at(handle._this), &node, (const char*)graph.frame_string(name), handle);
+    node.in_texture_edges.emplace_back(edge);
     return *this;
 }
 
 RenderGraph::ComputePassBuilder& RenderGraph::ComputePassBuilder::readwrite(const char8_t* name, TextureUAVHandle handle) SKR_NOEXCEPT
 {
-    auto allocated = graph.object_factory->Allocate<TextureReadWriteEdge>((const char*)name, handle);
-    auto&& edge = node.inout_texture_edges.emplace_back(allocated);
-    graph.graph->link(&node, graph.graph->access_node(handle._this), edge);
+    auto edge = graph.link_edge<TextureReadWriteEdge>(&node, graph.topology.node_at(handle._this), (const char*)graph.frame_string(name), handle);
+    node.inout_texture_edges.emplace_back(edge);
     return *this;
 }
 
@@ -215,9 +217,8 @@ RenderGraph::ComputePassBuilder& RenderGraph::ComputePassBuilder::set_root_signa
 PassHandle RenderGraph::add_compute_pass(const ComputePassSetupFunction& setup, const ComputePassExecuteFunction& executor) SKR_NOEXCEPT
 {
     const uint32_t passes_size = static_cast<uint32_t>(passes.size());
-    auto newPass = object_factory->Allocate<ComputePassNode>(passes_size);
+    auto newPass = allocate_node<ComputePassNode>(passes_size, &arena);
     passes.emplace_back(newPass);
-    graph->insert(newPass);
     // build up
     ComputePassBuilder builder(*this, *newPass);
     setup(*this, builder);
@@ -236,8 +237,8 @@ RenderGraph::CopyPassBuilder& RenderGraph::CopyPassBuilder::set_name(const char8
 {
     if (name)
     {
-        graph.blackboard->add_pass((const char*)name, &node);
-        node.set_name(name);
+        node.set_name(graph.frame_string(name));
+        graph.blackboard->add_pass((const char*)node.get_name(), &node);
     }
     return *this;
 }
@@ -252,12 +253,10 @@ RenderGraph::CopyPassBuilder& RenderGraph::CopyPassBuilder::buffer_to_buffer(Buf
 {
     ZoneScopedN("CopyPassBuilder::buffer_to_buffer");
 
-    auto allocated_in = graph.object_factory->Allocate<BufferReadEdge>("CopySrc", src, CGPU_RESOURCE_STATE_COPY_SOURCE);
-    auto allocated_out = graph.object_factory->Allocate<BufferReadWriteEdge>(dst, CGPU_RESOURCE_STATE_COPY_DEST);
-    auto&& in_edge = node.in_buffer_edges.emplace_back(allocated_in);
-    auto&& out_edge = node.out_buffer_edges.emplace_back(allocated_out);
-    graph.graph->link(graph.graph->access_node(src._this), &node, in_edge);
-    graph.graph->link(&node, graph.graph->access_node(dst._this), out_edge);
+    auto in_edge = graph.link_edge<BufferReadEdge>(graph.topology.node_at(src._this), &node, "CopySrc", src, CGPU_RESOURCE_STATE_COPY_SOURCE);
+    auto out_edge = graph.link_edge<BufferReadWriteEdge>(&node, graph.topology.node_at(dst._this), dst, CGPU_RESOURCE_STATE_COPY_DEST);
+    node.in_buffer_edges.emplace_back(in_edge);
+    node.out_buffer_edges.emplace_back(out_edge);
     node.b2bs.emplace_back(src, dst);
     if (out_state != CGPU_RESOURCE_STATE_COPY_DEST)
     {
@@ -270,12 +269,10 @@ RenderGraph::CopyPassBuilder& RenderGraph::CopyPassBuilder::buffer_to_texture(Bu
 {
     ZoneScopedN("CopyPassBuilder::buffer_to_texture");
 
-    auto allocated_in = graph.object_factory->Allocate<BufferReadEdge>("CopySrc", src, CGPU_RESOURCE_STATE_COPY_SOURCE);
-    auto allocated_out = graph.object_factory->Allocate<TextureRenderEdge>(0u, dst._this, fastclear_0000, CGPU_RESOURCE_STATE_COPY_DEST);
-    auto&& in_edge = node.in_buffer_edges.emplace_back(allocated_in);
-    auto&& out_edge = node.out_texture_edges.emplace_back(allocated_out);
-    graph.graph->link(graph.graph->access_node(src._this), &node, in_edge);
-    graph.graph->link(&node, graph.graph->access_node(dst._this), out_edge);
+    auto in_edge = graph.link_edge<BufferReadEdge>(graph.topology.node_at(src._this), &node, "CopySrc", src, CGPU_RESOURCE_STATE_COPY_SOURCE);
+    auto out_edge = graph.link_edge<TextureRenderEdge>(&node, graph.topology.node_at(dst._this), 0u, dst._this, fastclear_0000, CGPU_RESOURCE_STATE_COPY_DEST);
+    node.in_buffer_edges.emplace_back(in_edge);
+    node.out_texture_edges.emplace_back(out_edge);
     node.b2ts.emplace_back(src, dst);
     if (out_state != CGPU_RESOURCE_STATE_COPY_DEST)
     {
@@ -288,12 +285,10 @@ RenderGraph::CopyPassBuilder& RenderGraph::CopyPassBuilder::texture_to_texture(T
 {
     ZoneScopedN("CopyPassBuilder::texture_to_texture");
 
-    auto allocated_in = graph.object_factory->Allocate<TextureReadEdge>("CopySrc", src._this, CGPU_RESOURCE_STATE_COPY_SOURCE);
-    auto allocated_out = graph.object_factory->Allocate<TextureRenderEdge>(0u, dst._this, fastclear_0000, CGPU_RESOURCE_STATE_COPY_DEST);
-    auto&& in_edge = node.in_texture_edges.emplace_back(allocated_in);
-    auto&& out_edge = node.out_texture_edges.emplace_back(allocated_out);
-    graph.graph->link(graph.graph->access_node(src._this), &node, in_edge);
-    graph.graph->link(&node, graph.graph->access_node(dst._this), out_edge);
+    auto in_edge = graph.link_edge<TextureReadEdge>(graph.topology.node_at(src._this), &node, "CopySrc", src._this, CGPU_RESOURCE_STATE_COPY_SOURCE);
+    auto out_edge = graph.link_edge<TextureRenderEdge>(&node, graph.topology.node_at(dst._this), 0u, dst._this, fastclear_0000, CGPU_RESOURCE_STATE_COPY_DEST);
+    node.in_texture_edges.emplace_back(in_edge);
+    node.out_texture_edges.emplace_back(out_edge);
     node.t2ts.emplace_back(src, dst);
     if (out_state != CGPU_RESOURCE_STATE_COPY_DEST)
     {
@@ -306,18 +301,16 @@ RenderGraph::CopyPassBuilder& RenderGraph::CopyPassBuilder::from_buffer(BufferRa
 {
     ZoneScopedN("CopyPassBuilder::from_buffer");
 
-    auto allocated_in = graph.object_factory->Allocate<BufferReadEdge>("CopySrc", src, CGPU_RESOURCE_STATE_COPY_SOURCE);
-    auto&& in_edge = node.in_buffer_edges.emplace_back(allocated_in);
-    graph.graph->link(graph.graph->access_node(src._this), &node, in_edge);
+    auto in_edge = graph.link_edge<BufferReadEdge>(graph.topology.node_at(src._this), &node, "CopySrc", src, CGPU_RESOURCE_STATE_COPY_SOURCE);
+    node.in_buffer_edges.emplace_back(in_edge);
     return *this;
 }
 
 PassHandle RenderGraph::add_copy_pass(const CopyPassSetupFunction& setup, const CopyPassExecuteFunction& executor) SKR_NOEXCEPT
 {
     const uint32_t passes_size = static_cast<uint32_t>(passes.size());
-    auto newPass = object_factory->Allocate<CopyPassNode>(passes_size);
+    auto newPass = allocate_node<CopyPassNode>(passes_size, &arena);
     passes.emplace_back(newPass);
-    graph->insert(newPass);
     // build up
     CopyPassBuilder builder(*this, *newPass);
     setup(*this, builder);
@@ -336,8 +329,8 @@ RenderGraph::PresentPassBuilder& RenderGraph::PresentPassBuilder::set_name(const
 {
     if (name)
     {
-        graph.blackboard->add_pass((const char*)name, &node);
-        node.set_name(name);
+        node.set_name(graph.frame_string(name));
+        graph.blackboard->add_pass((const char*)node.get_name(), &node);
     }
     return *this;
 }
@@ -352,18 +345,16 @@ RenderGraph::PresentPassBuilder& RenderGraph::PresentPassBuilder::swapchain(CGPU
 RenderGraph::PresentPassBuilder& RenderGraph::PresentPassBuilder::texture(TextureHandle handle, bool is_backbuffer) SKR_NOEXCEPT
 {
     assert(is_backbuffer && "blit to screen mode not supported!");
-    auto allocated = graph.object_factory->Allocate<TextureReadEdge>("PresentSrc", handle, CGPU_RESOURCE_STATE_PRESENT);
-    auto&& edge = node.in_texture_edges.emplace_back(allocated);
-    graph.graph->link(graph.graph->access_node(handle), &node, edge);
+    auto edge = graph.link_edge<TextureReadEdge>(graph.topology.node_at(handle), &node, "PresentSrc", handle, CGPU_RESOURCE_STATE_PRESENT);
+    node.in_texture_edges.emplace_back(edge);
     return *this;
 }
 
 PassHandle RenderGraph::add_present_pass(const PresentPassSetupFunction& setup) SKR_NOEXCEPT
 {
     const uint32_t passes_size = static_cast<uint32_t>(passes.size());
-    auto newPass = object_factory->Allocate<PresentPassNode>(passes_size);
+    auto newPass = allocate_node<PresentPassNode>(passes_size, &arena);
     passes.emplace_back(newPass);
-    graph->insert(newPass);
     // build up
     PresentPassBuilder builder(*this, *newPass);
     setup(*this, builder);
@@ -383,7 +374,7 @@ RenderGraph::BufferBuilder::BufferBuilder(RenderGraph& graph, BufferNode& node)
 RenderGraph::BufferBuilder& RenderGraph::BufferBuilder::set_name(const char8_t* name) SKR_NOEXCEPT
 {
     // blackboard
-    node.set_name(name);
+    node.set_name(graph.frame_string(name));
     node.descriptor.name = node.get_name();
     graph.blackboard->add_buffer((const char*)node.descriptor.name, &node);
     return *this;
@@ -497,9 +488,8 @@ BufferHandle RenderGraph::create_buffer(const BufferSetupFunction& setup) SKR_NO
 {
     ZoneScopedN("RenderGraph::create_buffer(handle)");
 
-    auto newBuf = object_factory->Allocate<BufferNode>();
+    auto newBuf = allocate_node<BufferNode>();
     resources.emplace_back(newBuf);
-    graph->insert(newBuf);
     BufferBuilder builder(*this, *newBuf);
     setup(*this, builder);
     // set default gc tag
@@ -529,7 +519,7 @@ RenderGraph::TextureBuilder::TextureBuilder(RenderGraph& graph, TextureNode& nod
 RenderGraph::TextureBuilder& RenderGraph::TextureBuilder::set_name(const char8_t* name) SKR_NOEXCEPT
 {
     // blackboard
-    node.set_name(name);
+    node.set_name(graph.frame_string(name));
     node.descriptor.name = node.get_name();
     graph.blackboard->add_texture((const char*)node.descriptor.name, &node);
     return *this;
@@ -624,9 +614,8 @@ TextureHandle RenderGraph::create_texture(const TextureSetupFunction& setup) SKR
 {
     ZoneScopedN("RenderGraph::create_texture(handle)");
 
-    auto newTex = object_factory->Allocate<TextureNode>();
+    auto newTex = allocate_node<TextureNode>();
     resources.emplace_back(newTex);
-    graph->insert(newTex);
     TextureBuilder builder(*this, *newTex);
     setup(*this, builder);
     // set default gc tag
@@ -1,8 +1,8 @@
 ﻿#include "SkrRenderGraph/frontend/render_graph.hpp"
 #include "SkrRenderGraph/frontend/resource_node.hpp"
 #include "SkrRenderGraph/frontend/pass_node.hpp"
-#include "SkrRenderGraph/frontend/node_and_edge_factory.hpp"
 #include "platform/memory.h"
+#include "utils/hash.h"
 
 // use backend pool for aliasing calculation
 #include "SkrRenderGraph/backend/texture_view_pool.hpp"
@@ -11,7 +11,7 @@
 
 #include <containers/string.hpp>
 #include <containers/hashmap.hpp>
-#include <containers/btree.hpp>
+#include <EASTL/sort.h>
 
 namespace skr
 {
@@ -22,9 +22,10 @@ struct BlackboardImpl final : public Blackboard
 public:
     void clear() SKR_NOEXCEPT override
     {
-        named_passes.clear();
-        named_textures.clear();
-        named_buffers.clear();
+        // erase instead of clear(): large tables would free their storage and reallocate it next frame
+        named_passes.erase(named_passes.begin(), named_passes.end());
+        named_textures.erase(named_textures.begin(), named_textures.end());
+        named_buffers.erase(named_buffers.begin(), named_buffers.end());
     }
 
     PassNode* pass(const char* name) SKR_NOEXCEPT final override
@@ -76,35 +77,20 @@ public:
 
     bool add_pass(const char* name, class PassNode* pass) SKR_NOEXCEPT final override
     {
-        auto it = named_passes.find(name);
-        if (it != named_passes.end())
-        {
-            return false;
-        }
-        named_passes.emplace((const char*)pass->get_name(), pass);
-        return true;
+        // single probe, an existing entry is kept
+        return named_passes.try_emplace((const char*)pass->get_name(), pass).second;
     }
 
     bool add_texture(const char* name, class TextureNode* texture) SKR_NOEXCEPT final override
     {
-        auto it = named_textures.find(name);
-        if (it != named_textures.end())
-        {
-            return false;
-        }
-        named_textures.emplace((const char*)texture->get_name(), texture);
-        return true;
+        // single probe, an existing entry is kept
+        return named_textures.try_emplace((const char*)texture->get_name(), texture).second;
     }
 
     bool add_buffer(const char* name, class BufferNode* buffer) SKR_NOEXCEPT final override
     {
-        auto it = named_buffers.find(name);
-        if (it != named_buffers.end())
-        {
-            return false;
-        }
-        named_buffers.emplace((const char*)buffer->get_name(), buffer);
-        return true;
+        // single probe, an existing entry is kept
+        return named_buffers.try_emplace((const char*)buffer->get_name(), buffer).second;
     }
 
     void override_pass(const char* name, class PassNode* pass) SKR_NOEXCEPT final override
@@ -166,41 +152,24 @@ namespace render_graph
 {
 RenderGraph::RenderGraph(const RenderGraphBuilder& builder) SKR_NOEXCEPT
     : aliasing_enabled(builder.memory_aliasing)
+    , split_barriers_enabled(builder.split_barriers)
 {
 }
 
 const ResourceNode::LifeSpan ResourceNode::lifespan() const SKR_NOEXCEPT
 {
-    if (frame_lifespan.from != UINT32_MAX && frame_lifespan.to != UINT32_MAX)
-    {
-        return frame_lifespan;
-    }
-    uint32_t from = UINT32_MAX, to = 0;
-    foreach_neighbors([&](const DependencyGraphNode* node) {
-        auto rg_node = static_cast<const RenderGraphNode*>(node);
-        if (rg_node->type == EObjectType::Pass)
-        {
-            auto pass_node = static_cast<const RenderPassNode*>(node);
-            from = (from <= pass_node->order) ? from : pass_node->order;
-            to = (to >= pass_node->order) ? to : pass_node->order;
-        }
-    });
-    foreach_inv_neighbors([&](const DependencyGraphNode* node) {
-        auto rg_node = static_cast<const RenderGraphNode*>(node);
-        if (rg_node->type == EObjectType::Pass)
-        {
-            auto pass_node = static_cast<const RenderPassNode*>(node);
-            from = (from <= pass_node->order) ? from : pass_node->order;
-            to = (to >= pass_node->order) ? to : pass_node->order;
-        }
-    });
-    frame_lifespan = { from, to };
     return frame_lifespan;
 }
 
-BufferNode* RenderGraph::resolve(BufferHandle hdl) SKR_NOEXCEPT { return static_cast<BufferNode*>(graph->node_at(hdl)); }
-TextureNode* RenderGraph::resolve(TextureHandle hdl) SKR_NOEXCEPT { return static_cast<TextureNode*>(graph->node_at(hdl)); }
-PassNode* RenderGraph::resolve(PassHandle hdl) SKR_NOEXCEPT { return static_cast<PassNode*>(graph->node_at(hdl)); }
+const char8_t* RenderGraph::frame_string(const char8_t* str) SKR_NOEXCEPT
+{
+    if (!str) return u8"";
+    return arena.duplicate(str, strlen((const char*)str));
+}
+
+BufferNode* RenderGraph::resolve(BufferHandle hdl) SKR_NOEXCEPT { return static_cast<BufferNode*>(topology.node_at(hdl)); }
+TextureNode* RenderGraph::resolve(TextureHandle hdl) SKR_NOEXCEPT { return static_cast<TextureNode*>(topology.node_at(hdl)); }
+PassNode* RenderGraph::resolve(PassHandle hdl) SKR_NOEXCEPT { return static_cast<PassNode*>(topology.node_at(hdl)); }
 const CGPUBufferDescriptor* RenderGraph::resolve_descriptor(BufferHandle hdl) SKR_NOEXCEPT 
 {
     if (const auto node = resolve(hdl))
@@ -219,93 +188,283 @@ const CGPUTextureDescriptor* RenderGraph::resolve_descriptor(TextureHandle hdl)
     return nullptr;
 }
 
-inline static bool aliasing_capacity(TextureNode* aliased, TextureNode* aliasing) SKR_NOEXCEPT
+template <typename T>
+static void partition_culled(eastl::vector<T*>& nodes, eastl::vector<T*>& culled, const eastl::vector<uint8_t>& alive) SKR_NOEXCEPT
 {
-    return !aliased->is_imported() &&
-        !aliased->get_desc().is_dedicated &&
-        aliased->get_size() >= aliasing->get_size() &&
-        aliased->get_sample_count() == aliasing->get_sample_count();
+    nodes.erase(
+    eastl::remove_if(nodes.begin(), nodes.end(),
+    [&](T* node) {
+        const bool dead = !alive[node->get_id()];
+        if (dead) culled.emplace_back(node);
+        return dead;
+    }),
+    nodes.end());
 }
 
 bool RenderGraph::compile() SKR_NOEXCEPT
 {
     ZoneScopedN("RenderGraphCompile");
-    {
-        ZoneScopedN("RenderGraphCull");
-        // 1.cull
-        resources.erase(
-        eastl::remove_if(resources.begin(), resources.end(),
-        [this](ResourceNode* resource) {
-            ZoneScopedC(tracy::Color::SteelBlue);
-            ZoneName(resource->name.c_str(), resource->name.size());
+    const auto hash = hash_structure();
+    if (restore_compiled(hash)) return true;
+
+    topology.build();
+    cull_unreachable();
+    topology.retain(compiled.alive);
+    calculate_lifespans();
+    calculate_transitions();
+    cache_compiled(hash);
+    return true;
+}
 
-            const bool lone = !(resource->incoming_edges() + resource->outgoing_edges());
+uint64_t RenderGraph::hash_structure() SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphHashStructure");
+    // everything compile() depends on: node kinds and flags, pass orders and the edges
+    // texture descriptors are part of it too, the backend keeps its transient placements while the hash stays the same
+    // so are the states and subresources of the edges, the state timeline is kept with the rest
+    structure.clear();
+    structure.emplace_back((uint64_t)aliasing_enabled | ((uint64_t)split_barriers_enabled << 1));
+    for (auto node : topology.nodes)
+    {
+        uint64_t word = (uint64_t)node->type;
+        if (node->type == EObjectType::Pass)
+        {
+            auto pass = static_cast<const PassNode*>(node);
+            word |= ((uint64_t)pass->pass_type << 8) | ((uint64_t)pass->can_be_lone << 16) | ((uint64_t)pass->order << 32);
+        }
+        else
+        {
+            auto resource = static_cast<const ResourceNode*>(node);
+            word |= ((uint64_t)resource->imported << 8) | ((uint64_t)resource->canbe_lone << 9);
+            if (node->type == EObjectType::Texture)
             {
-                ZoneScopedN("RecordDealloc");
-                if (lone) culled_resources.emplace_back(resource);
+                auto texture = static_cast<const TextureNode*>(node);
+                const auto& desc = texture->descriptor;
+                word |= ((uint64_t)desc.is_dedicated << 10) |
+                    ((uint64_t)desc.sample_count << 16) | ((uint64_t)desc.mip_levels << 24) |
+                    ((uint64_t)desc.format << 32);
+                structure.emplace_back(word);
+                structure.emplace_back((uint64_t)desc.width | ((uint64_t)desc.height << 16) |
+                    ((uint64_t)desc.depth << 32) | ((uint64_t)desc.array_size << 48));
+                word = (uint64_t)desc.descriptors | ((uint64_t)desc.flags << 32);
             }
-            return lone;
-        }),
-        resources.end());
-        passes.erase(
-        eastl::remove_if(passes.begin(), passes.end(),
-        [this](PassNode* pass) {
-            ZoneScopedC(tracy::Color::SteelBlue);
-            ZoneName(pass->name.c_str(), pass->name.size());
-
-            const bool lone = !(pass->incoming_edges() + pass->outgoing_edges());
-            const bool can_be_lone = pass->can_be_lone;
-            const bool culled = lone && !can_be_lone;
+        }
+        structure.emplace_back(word);
+    }
+    for (uint32_t e = 0; e < topology.edge_count(); e++)
+    {
+        const auto access = describe_access(e);
+        structure.emplace_back((uint64_t)topology.edges[e]->type | ((uint64_t)access.state << 32));
+        structure.emplace_back((uint64_t)access.exit_state | ((uint64_t)access.mip_base << 32) | ((uint64_t)access.mip_count << 48));
+        structure.emplace_back((uint64_t)access.array_base | ((uint64_t)access.array_count << 32));
+    }
+    uint64_t hash = skr_hash64(structure.data(), structure.size() * sizeof(uint64_t), 0);
+    hash = skr_hash64(topology.edge_sources.data(), topology.edge_sources.size() * sizeof(uint32_t), hash);
+    hash = skr_hash64(topology.edge_targets.data(), topology.edge_targets.size() * sizeof(uint32_t), hash);
+    return hash;
+}
+
+void RenderGraph::cull_unreachable() SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphCull");
+    // 1.cull, walk back from the side effects of the frame: presents, nodes allowed to stay alone and imported resources with writers
+    // a live pass keeps every resource it touches, a live resource keeps every pass writing it
+    auto& alive = compiled.alive;
+    alive.clear();
+    alive.resize(topology.node_count(), 0);
+    cull_stack.clear();
+    const auto keep = [&](const RenderGraphNode* node) {
+        const auto id = (uint32_t)node->get_id();
+        if (alive[id]) return;
+        alive[id] = 1;
+        cull_stack.emplace_back(id);
+    };
+    for (auto pass : passes)
+    {
+        if (pass->pass_type == EPassType::Present || pass->can_be_lone) keep(pass);
+    }
+    for (auto resource : resources)
+    {
+        if (resource->canbe_lone || (resource->imported && topology.in_degree(resource->get_id()))) keep(resource);
+    }
+    while (!cull_stack.empty())
+    {
+        const auto id = cull_stack.back();
+        cull_stack.pop_back();
+        for (auto e : topology.in_edges(id))
+        {
+            keep(topology.nodes[topology.edge_sources[e]]);
+        }
+        if (topology.nodes[id]->type == EObjectType::Pass)
+        {
+            for (auto e : topology.out_edges(id))
             {
-                ZoneScopedN("RecordDealloc");
-                if (culled) culled_passes.emplace_back(pass);
+                keep(topology.nodes[topology.edge_targets[e]]);
             }
-            return culled;
-        }),
-        passes.end());
+        }
     }
-    if (aliasing_enabled)
-    {
-        ZoneScopedN("CalculateAliasing");
-        // 2.calc aliasing
-        // - 先在aliasing chain里找一圈，如果有不重合的，直接把它加入到aliasing chain里
-        // - 如果没找到，在所有resource中找一个合适的加入到aliasing chain
-        skr::btree_map<TextureNode*, TextureNode::LifeSpan> alliasing_lifespans;
-        foreach_textures([&](TextureNode* texture) SKR_NOEXCEPT {
-            if (texture->imported) return;
-            for (auto&& [aliased, aliaed_span] : alliasing_lifespans)
+    partition_culled(resources, culled_resources, alive);
+    partition_culled(passes, culled_passes, alive);
+}
+
+void RenderGraph::calculate_lifespans() SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphLifespans");
+    // 2.lifespans, the retained adjacency only links live passes
+    const auto extend = [](ResourceNode::LifeSpan& span, const RenderGraphNode* node) {
+        const auto order = static_cast<const PassNode*>(node)->order;
+        span.from = (span.from <= order) ? span.from : order;
+        span.to = (span.to >= order) ? span.to : order;
+    };
+    for (auto resource : resources)
+    {
+        const auto id = resource->get_id();
+        auto& span = resource->frame_lifespan;
+        span = { UINT32_MAX, 0 };
+        for (auto e : topology.in_edges(id))
+        {
+            extend(span, topology.nodes[topology.edge_sources[e]]);
+        }
+        for (auto e : topology.out_edges(id))
+        {
+            extend(span, topology.nodes[topology.edge_targets[e]]);
+        }
+    }
+}
+
+ResourceAccess RenderGraph::describe_access(uint32_t e) const SKR_NOEXCEPT
+{
+    // views of render and compute passes name their subresources, copies and presents are taken as whole resources
+    // uav handles carry no range, their views always start at the first mip and layer
+    const auto edge = topology.edges[e];
+    ResourceAccess access = {};
+    access.edge = e;
+    PassNode* pass = nullptr;
+    handle_t resource = UINT64_MAX;
+    switch (edge->type)
+    {
+        case ERelationshipType::TextureRead: {
+            auto read = static_cast<TextureReadEdge*>(edge);
+            pass = read->get_pass_node();
+            resource = read->get_texture_node()->get_id();
+            access.state = read->requested_state;
+            if (pass->pass_type == EPassType::Render || pass->pass_type == EPassType::Compute)
+            {
+                access.mip_base = read->get_mip_base();
+                access.mip_count = read->get_mip_count();
+                access.array_base = read->get_array_base();
+                access.array_count = read->get_array_count();
+            }
+        }
+        break;
+        case ERelationshipType::TextureWrite: {
+            auto write = static_cast<TextureRenderEdge*>(edge);
+            pass = write->get_pass_node();
+            resource = write->get_texture_node()->get_id();
+            access.state = write->requested_state;
+            if (pass->pass_type == EPassType::Render)
             {
-                if (aliasing_capacity(aliased, texture) &&
-                    aliaed_span.to < texture->lifespan().from)
-                {
-                    if (!texture->frame_aliasing_source ||
-                        texture->frame_aliasing_source->get_size() > aliased->get_size() // always choose smallest block
-                    )
-                    {
-                        texture->descriptor.is_aliasing = true;
-                        texture->frame_aliasing_source = aliased;
-                        aliaed_span.to = texture->lifespan().to;
-                    }
-                }
+                access.mip_base = write->get_mip_level();
+                access.mip_count = 1;
+                access.array_base = write->get_array_base();
+                access.array_count = write->get_array_count();
             }
-            if (texture->frame_aliasing_source) return;
-            foreach_textures([&](TextureNode* aliased) SKR_NOEXCEPT {
-                if (aliasing_capacity(aliased, texture) &&
-                    aliased->lifespan().to < texture->lifespan().from)
-                {
-                    if (!texture->frame_aliasing_source ||
-                        texture->frame_aliasing_source->get_size() > aliased->get_size() // always choose smallest block
-                    )
-                    {
-                        texture->descriptor.is_aliasing = true;
-                        texture->frame_aliasing_source = aliased;
-                        alliasing_lifespans[aliased].from = aliased->lifespan().from;
-                        alliasing_lifespans[aliased].to = aliased->lifespan().from;
-                    }
-                }
-            });
+        }
+        break;
+        case ERelationshipType::TextureReadWrite: {
+            auto readwrite = static_cast<TextureReadWriteEdge*>(edge);
+            pass = readwrite->get_pass_node();
+            resource = readwrite->get_texture_node()->get_id();
+            access.state = readwrite->requested_state;
+        }
+        break;
+        default: {
+            auto buffer = static_cast<BufferEdge*>(edge);
+            pass = buffer->get_pass_node();
+            resource = buffer->get_buffer_node()->get_id();
+            access.state = buffer->requested_state;
+        }
+        break;
+    }
+    access.pass_order = pass->order;
+    access.exit_state = access.state;
+    // copy destinations are moved on to the requested state right after the copy
+    if (pass->pass_type == EPassType::Copy && access.state == CGPU_RESOURCE_STATE_COPY_DEST)
+    {
+        auto copy = static_cast<const CopyPassNode*>(pass);
+        for (const auto& [texture, state] : copy->tbarriers)
+        {
+            if ((handle_t)texture == resource && edge->type == ERelationshipType::TextureWrite) access.exit_state = state;
+        }
+        for (const auto& [buffer, state] : copy->bbarriers)
+        {
+            if ((handle_t)buffer == resource && edge->type == ERelationshipType::BufferReadWrite) access.exit_state = state;
+        }
+    }
+    return access;
+}
+
+void RenderGraph::calculate_transitions() SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphTransitions");
+    // 3.states, every live edge of a resource in pass order
+    accesses.clear();
+    usages.clear();
+    for (auto resource : resources)
+    {
+        const auto id = resource->get_id();
+        ResourceUsage usage = {};
+        usage.resource = id;
+        usage.first_access = (uint32_t)accesses.size();
+        for (auto e : topology.in_edges(id))
+            accesses.emplace_back(describe_access(e));
+        for (auto e : topology.out_edges(id))
+            accesses.emplace_back(describe_access(e));
+        usage.access_count = (uint32_t)accesses.size() - usage.first_access;
+        eastl::sort(accesses.begin() + usage.first_access, accesses.end(),
+        [](const ResourceAccess& a, const ResourceAccess& b) {
+            return (a.pass_order != b.pass_order) ? a.pass_order < b.pass_order : a.edge < b.edge;
         });
+        if (resource->type == EObjectType::Texture)
+        {
+            const auto& desc = static_cast<const TextureNode*>(resource)->descriptor;
+            usage.mip_levels = desc.mip_levels ? desc.mip_levels : 1;
+            usage.array_size = desc.array_size ? desc.array_size : 1;
+        }
+        usages.emplace_back(usage);
+    }
+    const auto pass_count = passes.empty() ? 0u : passes.back()->order + 1;
+    compiled.timeline.build(accesses, usages, topology.node_count(), topology.edge_count(), pass_count, split_barriers_enabled);
+}
+
+void RenderGraph::cache_compiled(uint64_t hash) SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphCacheCompiled");
+    // 4.keep the result for the next frames, alive was filled by cull_unreachable()
+    const auto node_count = topology.node_count();
+    compiled.lifespans.clear();
+    compiled.lifespans.resize(node_count, { UINT32_MAX, UINT32_MAX });
+    for (auto resource : resources)
+    {
+        compiled.lifespans[resource->get_id()] = resource->frame_lifespan;
+    }
+    compiled.hash = hash;
+    compiled.valid = true;
+}
+
+bool RenderGraph::restore_compiled(uint64_t hash) SKR_NOEXCEPT
+{
+    if (!compiled.valid || compiled.hash != hash) return false;
+    if (!topology.reuse()) return false;
+
+    ZoneScopedN("RenderGraphRestoreCompiled");
+    partition_culled(resources, culled_resources, compiled.alive);
+    partition_culled(passes, culled_passes, compiled.alive);
+    for (auto resource : resources)
+    {
+        resource->frame_lifespan = compiled.lifespans[resource->get_id()];
     }
+    compile_cache_hits++;
     return true;
 }
 
@@ -326,53 +485,53 @@ uint32_t RenderGraph::foreach_textures(eastl::function<void(TextureNode*)> f) SK
 uint32_t RenderGraph::foreach_writer_passes(TextureHandle texture,
     eastl::function<void(PassNode*, TextureNode*, RenderGraphEdge*)> f) const SKR_NOEXCEPT
 {
-    return graph->foreach_incoming_edges(
-    texture,
-    [&](DependencyGraphNode* from, DependencyGraphNode* to, DependencyGraphEdge* e) {
-        PassNode* pass = static_cast<PassNode*>(from);
-        TextureNode* texture = static_cast<TextureNode*>(to);
-        RenderGraphEdge* edge = static_cast<RenderGraphEdge*>(e);
-        f(pass, texture, edge);
-    });
+    const auto in_edges = topology.in_edges(texture);
+    for (auto e : in_edges)
+    {
+        f(static_cast<PassNode*>(topology.nodes[topology.edge_sources[e]]),
+            static_cast<TextureNode*>(topology.nodes[(size_t)(handle_t)texture]),
+            topology.edges[e]);
+    }
+    return (uint32_t)in_edges.size();
 }
 
 uint32_t RenderGraph::foreach_reader_passes(TextureHandle texture,
     eastl::function<void(PassNode*, TextureNode*, RenderGraphEdge*)> f) const SKR_NOEXCEPT
 {
-    return graph->foreach_outgoing_edges(
-    texture,
-    [&](DependencyGraphNode* from, DependencyGraphNode* to, DependencyGraphEdge* e) SKR_NOEXCEPT {
-        PassNode* pass = static_cast<PassNode*>(to);
-        TextureNode* texture = static_cast<TextureNode*>(from);
-        RenderGraphEdge* edge = static_cast<RenderGraphEdge*>(e);
-        f(pass, texture, edge);
-    });
+    const auto out_edges = topology.out_edges(texture);
+    for (auto e : out_edges)
+    {
+        f(static_cast<PassNode*>(topology.nodes[topology.edge_targets[e]]),
+            static_cast<TextureNode*>(topology.nodes[(size_t)(handle_t)texture]),
+            topology.edges[e]);
+    }
+    return (uint32_t)out_edges.size();
 }
 
 uint32_t RenderGraph::foreach_writer_passes(BufferHandle buffer,
     eastl::function<void(PassNode*, BufferNode*, RenderGraphEdge*)> f) const SKR_NOEXCEPT
 {
-    return graph->foreach_incoming_edges(
-    buffer,
-    [&](DependencyGraphNode* from, DependencyGraphNode* to, DependencyGraphEdge* e) SKR_NOEXCEPT {
-        PassNode* pass = static_cast<PassNode*>(from);
-        BufferNode* buffer = static_cast<BufferNode*>(to);
-        RenderGraphEdge* edge = static_cast<RenderGraphEdge*>(e);
-        f(pass, buffer, edge);
-    });
+    const auto in_edges = topology.in_edges(buffer);
+    for (auto e : in_edges)
+    {
+        f(static_cast<PassNode*>(topology.nodes[topology.edge_sources[e]]),
+            static_cast<BufferNode*>(topology.nodes[(size_t)(handle_t)buffer]),
+            topology.edges[e]);
+    }
+    return (uint32_t)in_edges.size();
 }
 
 uint32_t RenderGraph::foreach_reader_passes(BufferHandle buffer,
     eastl::function<void(PassNode*, BufferNode*, RenderGraphEdge*)> f) const SKR_NOEXCEPT
 {
-    return graph->foreach_outgoing_edges(
-    buffer,
-    [&](DependencyGraphNode* from, DependencyGraphNode* to, DependencyGraphEdge* e) {
-        PassNode* pass = static_cast<PassNode*>(to);
-        BufferNode* buffer = static_cast<BufferNode*>(from);
-        RenderGraphEdge* edge = static_cast<RenderGraphEdge*>(e);
-        f(pass, buffer, edge);
-    });
+    const auto out_edges = topology.out_edges(buffer);
+    for (auto e : out_edges)
+    {
+        f(static_cast<PassNode*>(topology.nodes[topology.edge_targets[e]]),
+            static_cast<BufferNode*>(topology.nodes[(size_t)(handle_t)buffer]),
+            topology.edges[e]);
+    }
+    return (uint32_t)out_edges.size();
 }
 
 const ECGPUResourceState RenderGraph::get_lastest_state(const TextureNode* texture, const PassNode* pending_pass) const SKR_NOEXCEPT
@@ -465,22 +624,40 @@ const ECGPUResourceState RenderGraph::get_lastest_state(const BufferNode* buffer
 
 uint64_t RenderGraph::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
 {
-    graph->clear();
+    reset_frame();
     return frame_index++;
 }
 
+void RenderGraph::reset_frame() SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphResetFrame");
+    // pass executors are the only members holding memory outside of the arena
+    for (auto pass : passes)
+    {
+        pass->~PassNode();
+    }
+    for (auto pass : culled_passes)
+    {
+        pass->~PassNode();
+    }
+    passes.clear();
+    culled_passes.clear();
+    resources.clear();
+    culled_resources.clear();
+    topology.clear();
+    blackboard->clear();
+    arena.reset();
+}
+
 void RenderGraph::initialize() SKR_NOEXCEPT
 {
-    graph = DependencyGraph::Create();
-    object_factory = NodeAndEdgeFactory::Create();
     blackboard = Blackboard::Create();
 }
 
 void RenderGraph::finalize() SKR_NOEXCEPT
 {
+    reset_frame();
     Blackboard::Destroy(blackboard);
-    NodeAndEdgeFactory::Destroy(object_factory);
-    DependencyGraph::Destroy(graph);
 }
 } // namespace render_graph
 } // namespace skr
\ No newline at end of file
@@ -1,95 +1,13 @@
 #include "platform/debug.h"
 #include "SkrRenderGraph/frontend/render_graph.hpp"
 #include "SkrRenderGraph/frontend/pass_node.hpp"
-#include "SkrRenderGraph/frontend/node_and_edge_factory.hpp"
-#include <containers/hashmap.hpp>
 #include "utils/log.h"
 #include "utils/hash.h"
-#include "utils/concurrent_queue.h"
 
 namespace skr
 {
 namespace render_graph
 {
-struct SKR_RENDER_GRAPH_API NodeAndEdgeFactoryImpl final : public NodeAndEdgeFactory
-{
-    NodeAndEdgeFactoryImpl() SKR_NOEXCEPT
-    {
-
-    }
-    ~NodeAndEdgeFactoryImpl() SKR_NOEXCEPT
-    {
-        for (auto pool : pools)
-        {
-            SkrDelete(pool.second);
-        }
-    }
-
-    struct factory_pool_t 
-    {
-        size_t blockSize;
-        moodycamel::ConcurrentQueue<void*> blocks;
-
-        factory_pool_t(size_t blockSize, size_t blockCount) SKR_NOEXCEPT
-            : blockSize(blockSize)
-            , blocks(blockCount)
-        {
-            
-        }
-        ~factory_pool_t() SKR_NOEXCEPT
-        {
-            void* block;
-            while (blocks.try_dequeue(block))
-                sakura_free(block);
-        }
-        void* allocate()
-        {
-            void* block;
-            if (blocks.try_dequeue(block))
-                return block;
-            {
-                ZoneScopedN("DualPoolAllocation");
-                return sakura_calloc(1, blockSize);
-            }
-        }
-        void free(void* block)
-        {
-            if (blocks.try_enqueue(block))
-                return;
-            sakura_free(block);
-        }
-    };
-
-    bool internalFreeMemory(void* memory, size_t size) override
-    {
-        auto pool = pools.find(size);
-        SKR_ASSERT(pool != pools.end());
-        pool->second->free(memory);
-        return true;
-    }
-
-    void* internalAllocateMemory(size_t size) override
-    {
-        auto pool = pools.find(size);
-        if (pool == pools.end())
-        {
-            pool = pools.emplace(size, SkrNew<factory_pool_t>(size, 2048u)).first;
-        }
-        return pool->second->allocate();
-    }
-    skr::flat_hash_map<size_t, factory_pool_t*> pools;
-};
-
-NodeAndEdgeFactory* NodeAndEdgeFactory::Create()
-{
-    return SkrNew<NodeAndEdgeFactoryImpl>();
-}
-
-void NodeAndEdgeFactory::Destroy(NodeAndEdgeFactory* factory)
-{
-    SkrDelete(factory);
-}
-
 // 0.node
 RenderGraphNode::RenderGraphNode(EObjectType type)
     : type(type)
@@ -98,12 +16,12 @@ RenderGraphNode::RenderGraphNode(EObjectType type)
 
 void RenderGraphNode::set_name(const char8_t* n)
 {
-    name = (const char*)n;
+    name = n ? skr::string_view((const char*)n) : skr::string_view("");
 }
 
 const char8_t* RenderGraphNode::get_name() const
 {
-    return (const char8_t*)name.c_str();
+    return (const char8_t*)name.data();
 }
 
 RenderGraphEdge::RenderGraphEdge(ERelationshipType type)
@@ -132,10 +50,16 @@ BufferNode::BufferNode() SKR_NOEXCEPT
 
 // 2.pass nodes
 
-PassNode::PassNode(EPassType pass_type, uint32_t order)
+PassNode::PassNode(EPassType pass_type, uint32_t order, FrameArena* arena)
     : RenderGraphNode(EObjectType::Pass)
     , pass_type(pass_type)
     , order(order)
+    , in_texture_edges(FrameArenaAllocator(arena))
+    , out_texture_edges(FrameArenaAllocator(arena))
+    , inout_texture_edges(FrameArenaAllocator(arena))
+    , in_buffer_edges(FrameArenaAllocator(arena))
+    , out_buffer_edges(FrameArenaAllocator(arena))
+    , ppl_buffer_edges(FrameArenaAllocator(arena))
 {
 }
 
@@ -208,23 +132,28 @@ void PassNode::foreach_buffers(eastl::function<void(BufferNode*, BufferEdge*)> f
         f(e->get_buffer_node(), e);
 }
 
-RenderPassNode::RenderPassNode(uint32_t order)
-    : PassNode(EPassType::Render, order)
+RenderPassNode::RenderPassNode(uint32_t order, FrameArena* arena)
+    : PassNode(EPassType::Render, order, arena)
 {
 }
 
-ComputePassNode::ComputePassNode(uint32_t order)
-    : PassNode(EPassType::Compute, order)
+ComputePassNode::ComputePassNode(uint32_t order, FrameArena* arena)
+    : PassNode(EPassType::Compute, order, arena)
 {
 }
 
-CopyPassNode::CopyPassNode(uint32_t order)
-    : PassNode(EPassType::Copy, order)
+CopyPassNode::CopyPassNode(uint32_t order, FrameArena* arena)
+    : PassNode(EPassType::Copy, order, arena)
+    , t2ts(FrameArenaAllocator(arena))
+    , b2bs(FrameArenaAllocator(arena))
+    , b2ts(FrameArenaAllocator(arena))
+    , bbarriers(FrameArenaAllocator(arena))
+    , tbarriers(FrameArenaAllocator(arena))
 {
 }
 
-PresentPassNode::PresentPassNode(uint32_t order)
-    : PassNode(EPassType::Present, order)
+PresentPassNode::PresentPassNode(uint32_t order, FrameArena* arena)
+    : PassNode(EPassType::Present, order, arena)
 {
 }
 
@@ -241,7 +170,7 @@ TextureEdge::TextureEdge(ERelationshipType type, ECGPUResourceState requested_st
 TextureReadEdge::TextureReadEdge(const skr::string_view name, TextureSRVHandle handle, ECGPUResourceState state)
     : TextureEdge(ERelationshipType::TextureRead, state)
     , name_hash(cgpu_name_hash(name.data(), name.size()))
-    , name(name.data(), name.size())
+    , name(name)
     , handle(handle)
 {
 }
@@ -281,7 +210,7 @@ PassNode* TextureRenderEdge::get_pass_node()
 TextureReadWriteEdge::TextureReadWriteEdge(const skr::string_view name, TextureUAVHandle handle, ECGPUResourceState state)
     : TextureEdge(ERelationshipType::TextureReadWrite, state)
     , name_hash(cgpu_name_hash(name.data(), name.size()))
-    , name(name.data(), name.size())
+    , name(name)
     , handle(handle)
 
 {
@@ -321,7 +250,7 @@ PassNode* PipelineBufferEdge::get_pass_node()
 BufferReadEdge::BufferReadEdge(const skr::string_view name, BufferRangeHandle handle, ECGPUResourceState state)
     : BufferEdge(ERelationshipType::BufferRead, state)
     , name_hash(cgpu_name_hash(name.data(), name.size()))
-    , name(name.data(), name.size())
+    , name(name)
     , handle(handle)
 {
 }
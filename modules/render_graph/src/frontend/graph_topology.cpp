@@ -0,0 +1,95 @@
+#include "SkrRenderGraph/frontend/graph_topology.hpp"
+
+#include "tracy/Tracy.hpp"
+
+namespace skr
+{
+namespace render_graph
+{
+handle_t GraphTopology::insert(RenderGraphNode* node) SKR_NOEXCEPT
+{
+    node->id = (handle_t)nodes.size();
+    nodes.emplace_back(node);
+    built = false;
+    return node->id;
+}
+
+uint32_t GraphTopology::link(RenderGraphNode* from, RenderGraphNode* to, RenderGraphEdge* edge) SKR_NOEXCEPT
+{
+    SKR_ASSERT(from && to && edge);
+    edge->from_node = from;
+    edge->to_node = to;
+    edge->id = (uint32_t)edges.size();
+    edges.emplace_back(edge);
+    edge_sources.emplace_back((uint32_t)from->id);
+    edge_targets.emplace_back((uint32_t)to->id);
+    built = false;
+    return (uint32_t)(edges.size() - 1);
+}
+
+// counting sort of the edge indices by source and by target, edges keep their creation order inside a node
+// edges touching a node that is not alive are left out when a mask is given
+static void build_adjacency(const eastl::vector<uint32_t>& keys, const GraphTopology& topology, const uint8_t* alive,
+    eastl::vector<uint32_t>& offsets, eastl::vector<uint32_t>& list) SKR_NOEXCEPT
+{
+    const auto node_count = topology.node_count();
+    const auto edge_count = (uint32_t)keys.size();
+    const auto edge_alive = [&](uint32_t e) {
+        return !alive || (alive[topology.edge_sources[e]] && alive[topology.edge_targets[e]]);
+    };
+    offsets.clear();
+    offsets.resize(node_count + 1, 0);
+    for (uint32_t e = 0; e < edge_count; e++)
+    {
+        if (edge_alive(e)) offsets[keys[e] + 1]++;
+    }
+    for (uint32_t i = 0; i < node_count; i++)
+        offsets[i + 1] += offsets[i];
+    list.resize(offsets[node_count]);
+    // offsets[key] is used as the insertion cursor and ends up at the start of key + 1, shift it back afterwards
+    for (uint32_t e = 0; e < edge_count; e++)
+    {
+        if (edge_alive(e)) list[offsets[keys[e]]++] = e;
+    }
+    for (uint32_t i = node_count; i > 0; i--)
+        offsets[i] = offsets[i - 1];
+    offsets[0] = 0;
+}
+
+void GraphTopology::build() SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphBuildTopology");
+
+    build_adjacency(edge_sources, *this, nullptr, out_offsets, out_list);
+    build_adjacency(edge_targets, *this, nullptr, in_offsets, in_list);
+    built = true;
+}
+
+void GraphTopology::retain(const eastl::vector<uint8_t>& alive) SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphRetainTopology");
+
+    SKR_ASSERT(alive.size() == nodes.size());
+    build_adjacency(edge_sources, *this, alive.data(), out_offsets, out_list);
+    build_adjacency(edge_targets, *this, alive.data(), in_offsets, in_list);
+    built = true;
+}
+
+bool GraphTopology::reuse() SKR_NOEXCEPT
+{
+    if (out_offsets.size() != nodes.size() + 1 || in_offsets.size() != nodes.size() + 1)
+        return false;
+    built = true;
+    return true;
+}
+
+void GraphTopology::clear() SKR_NOEXCEPT
+{
+    nodes.clear();
+    edges.clear();
+    edge_sources.clear();
+    edge_targets.clear();
+    built = false;
+}
+} // namespace render_graph
+} // namespace skr
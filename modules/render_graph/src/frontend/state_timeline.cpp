@@ -0,0 +1,195 @@
+#include "SkrRenderGraph/frontend/state_timeline.hpp"
+#include "platform/debug.h"
+
+#include "tracy/Tracy.hpp"
+
+namespace skr
+{
+namespace render_graph
+{
+static constexpr uint32_t kNoAccess = UINT32_MAX;
+
+struct SubresourceRange {
+    uint32_t mip_begin, mip_end;
+    uint32_t array_begin, array_end;
+
+    inline SubresourceRange(const ResourceAccess& access, const ResourceUsage& usage) SKR_NOEXCEPT
+    {
+        mip_begin = (access.mip_base < usage.mip_levels) ? access.mip_base : usage.mip_levels - 1;
+        mip_end = access.mip_count ? mip_begin + access.mip_count : usage.mip_levels;
+        mip_end = (mip_end < usage.mip_levels) ? mip_end : usage.mip_levels;
+        array_begin = (access.array_base < usage.array_size) ? access.array_base : usage.array_size - 1;
+        array_end = access.array_count ? array_begin + access.array_count : usage.array_size;
+        array_end = (array_end < usage.array_size) ? array_end : usage.array_size;
+    }
+    inline bool whole(const ResourceUsage& usage) const SKR_NOEXCEPT
+    {
+        return mip_begin == 0 && mip_end == usage.mip_levels && array_begin == 0 && array_end == usage.array_size;
+    }
+    template <typename F>
+    inline void foreach(const ResourceUsage& usage, F&& f) const SKR_NOEXCEPT
+    {
+        for (uint32_t layer = array_begin; layer < array_end; layer++)
+            for (uint32_t mip = mip_begin; mip < mip_end; mip++)
+                f(mip + layer * usage.mip_levels);
+    }
+};
+
+void StateTimeline::emit(skr::span<const ResourceAccess> accesses, const ResourceUsage& usage, uint32_t access, uint32_t source,
+    uint32_t subresource, bool whole, bool split_barriers) SKR_NOEXCEPT
+{
+    const auto& dst = accesses[access];
+    ResourceTransition transition = {};
+    transition.resource = usage.resource;
+    transition.dst_state = dst.state;
+    transition.whole = whole || (usage.mip_levels * usage.array_size == 1);
+    transition.mip_level = subresource % usage.mip_levels;
+    transition.array_layer = subresource / usage.mip_levels;
+    if (source == kNoAccess)
+    {
+        transition.from_initial = true;
+        transition.src_state = CGPU_RESOURCE_STATE_UNDEFINED;
+    }
+    else
+    {
+        transition.src_state = accesses[source].exit_state;
+        if (transition.src_state == transition.dst_state)
+        {
+            merged_count++;
+            return;
+        }
+        // nothing touches the subresource between the two passes, the transition can overlap them
+        const auto source_order = accesses[source].pass_order;
+        if (split_barriers && source_order + 1 < dst.pass_order)
+        {
+            auto& begin = after_pass.emplace_back(transition);
+            begin.split = EBarrierSplit::Begin;
+            begin.split_pass = dst.pass_order;
+            after_pass_keys.emplace_back(source_order);
+            transition.split = EBarrierSplit::End;
+            transition.split_pass = source_order;
+        }
+    }
+    unsorted.emplace_back(transition);
+    unsorted_keys.emplace_back(dst.edge);
+}
+
+void StateTimeline::plan_access(skr::span<const ResourceAccess> accesses, const ResourceUsage& usage, uint32_t access, bool split_barriers) SKR_NOEXCEPT
+{
+    const auto& dst = accesses[access];
+    const SubresourceRange range(dst, usage);
+    // common case: every touched subresource comes from the same access and no other edge of the pass got there first
+    const auto source = current[range.mip_begin + range.array_begin * usage.mip_levels];
+    bool uniform = true;
+    range.foreach(usage, [&](uint32_t s) {
+        uniform &= (current[s] == source) && (pending[s] == kNoAccess);
+    });
+    if (uniform && range.whole(usage))
+    {
+        emit(accesses, usage, access, source, 0, true, split_barriers);
+    }
+    else
+    {
+        range.foreach(usage, [&](uint32_t s) {
+            if (pending[s] != kNoAccess && accesses[pending[s]].state == dst.state)
+                merged_count++;
+            else
+                emit(accesses, usage, access, current[s], s, false, split_barriers);
+        });
+    }
+    range.foreach(usage, [&](uint32_t s) { pending[s] = access; });
+}
+
+void StateTimeline::bucket(eastl::vector<ResourceTransition>& transitions, const eastl::vector<uint32_t>& keys,
+    uint32_t key_count, eastl::vector<uint32_t>& offsets, eastl::vector<ResourceTransition>& sorted) SKR_NOEXCEPT
+{
+    // counting sort by key, transitions keep their planning order inside a key
+    offsets.clear();
+    offsets.resize(key_count + 1, 0);
+    for (auto key : keys)
+        offsets[key + 1]++;
+    for (uint32_t i = 0; i < key_count; i++)
+        offsets[i + 1] += offsets[i];
+    sorted.resize(transitions.size());
+    for (uint32_t i = 0; i < transitions.size(); i++)
+        sorted[offsets[keys[i]]++] = transitions[i];
+    for (uint32_t i = key_count; i > 0; i--)
+        offsets[i] = offsets[i - 1];
+    offsets[0] = 0;
+}
+
+void StateTimeline::build(skr::span<const ResourceAccess> accesses, skr::span<const ResourceUsage> usages,
+    uint32_t node_count, uint32_t edge_count, uint32_t pass_count, bool split_barriers) SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphStateTimeline");
+
+    merged_count = 0;
+    unsorted.clear();
+    unsorted_keys.clear();
+    after_pass.clear();
+    after_pass_keys.clear();
+    final_states.clear();
+    final_states.resize(node_count, CGPU_RESOURCE_STATE_UNDEFINED);
+    for (const auto& usage : usages)
+    {
+        if (!usage.access_count) continue;
+        SKR_ASSERT(usage.mip_levels && usage.array_size);
+        const auto subresource_count = usage.mip_levels * usage.array_size;
+        current.clear();
+        current.resize(subresource_count, kNoAccess);
+        pending.clear();
+        pending.resize(subresource_count, kNoAccess);
+        const auto end = usage.first_access + usage.access_count;
+        for (uint32_t group = usage.first_access; group < end;)
+        {
+            // edges of one pass are planned against the states before the pass, then applied together
+            uint32_t group_end = group;
+            while (group_end < end && accesses[group_end].pass_order == accesses[group].pass_order)
+            {
+                plan_access(accesses, usage, group_end, split_barriers);
+                group_end++;
+            }
+            for (uint32_t s = 0; s < subresource_count; s++)
+            {
+                if (pending[s] == kNoAccess) continue;
+                current[s] = pending[s];
+                pending[s] = kNoAccess;
+            }
+            SKR_ASSERT(group_end == end || accesses[group_end].pass_order > accesses[group].pass_order);
+            group = group_end;
+        }
+        // bring the subresources the last pass did not leave in the final state over to it
+        const auto& last = accesses[end - 1];
+        final_states[(size_t)usage.resource] = last.exit_state;
+        uint32_t tails = 0;
+        bool same_source = true;
+        for (uint32_t s = 0; s < subresource_count; s++)
+        {
+            const bool settled = (current[s] != kNoAccess) && (accesses[current[s]].exit_state == last.exit_state);
+            tails += settled ? 0 : 1;
+            same_source &= (current[s] == current[0]);
+        }
+        if (!tails) continue;
+        const bool whole = (tails == subresource_count) && same_source;
+        for (uint32_t s = 0; s < subresource_count; s++)
+        {
+            const auto source = current[s];
+            if (source != kNoAccess && accesses[source].exit_state == last.exit_state) continue;
+            ResourceTransition transition = {};
+            transition.resource = usage.resource;
+            transition.from_initial = (source == kNoAccess);
+            transition.src_state = transition.from_initial ? CGPU_RESOURCE_STATE_UNDEFINED : accesses[source].exit_state;
+            transition.dst_state = last.exit_state;
+            transition.whole = whole || (subresource_count == 1);
+            transition.mip_level = s % usage.mip_levels;
+            transition.array_layer = s / usage.mip_levels;
+            after_pass.emplace_back(transition);
+            after_pass_keys.emplace_back(last.pass_order);
+            if (whole) break;
+        }
+    }
+    bucket(unsorted, unsorted_keys, edge_count, edge_offsets, edge_transitions);
+    bucket(after_pass, after_pass_keys, pass_count, pass_offsets, pass_transitions);
+}
+} // namespace render_graph
+} // namespace skr
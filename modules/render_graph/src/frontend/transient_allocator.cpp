@@ -0,0 +1,102 @@
+#include "SkrRenderGraph/frontend/transient_allocator.hpp"
+#include "platform/debug.h"
+#include <EASTL/sort.h>
+
+#include "tracy/Tracy.hpp"
+
+namespace skr
+{
+namespace render_graph
+{
+static inline uint64_t align_up(uint64_t value, uint64_t alignment) SKR_NOEXCEPT
+{
+    return alignment ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+static inline bool lifespans_overlap(const TransientRequest& a, const TransientRequest& b) SKR_NOEXCEPT
+{
+    return a.from <= b.to && b.from <= a.to;
+}
+
+bool TransientAllocator::try_place(skr::span<const TransientRequest> requests, uint32_t request, uint32_t heap, uint64_t max_heap_size) SKR_NOEXCEPT
+{
+    const auto& req = requests[request];
+    if (heaps[heap].kind != req.kind) return false;
+    // memory taken in this heap during the lifespan of the request, sorted by offset
+    conflicts.clear();
+    for (uint32_t i = 0; i < placed_count; i++)
+    {
+        const auto other = order[i];
+        if (placements[other].heap == heap && lifespans_overlap(req, requests[other]))
+            conflicts.emplace_back(other);
+    }
+    eastl::sort(conflicts.begin(), conflicts.end(), [this](uint32_t a, uint32_t b) {
+        return placements[a].offset < placements[b].offset;
+    });
+    // sweep the gaps between the conflicting ranges, the first one that fits wins
+    uint64_t cursor = 0;
+    for (auto other : conflicts)
+    {
+        const auto offset = align_up(cursor, req.alignment);
+        if (offset + req.size <= placements[other].offset) break;
+        const auto end = placements[other].offset + requests[other].size;
+        cursor = (end > cursor) ? end : cursor;
+    }
+    const auto offset = align_up(cursor, req.alignment);
+    if (offset + req.size > max_heap_size) return false;
+
+    placements[request].heap = heap;
+    placements[request].offset = offset;
+    if (offset + req.size > heaps[heap].size) heaps[heap].size = offset + req.size;
+    return true;
+}
+
+void TransientAllocator::plan(skr::span<const TransientRequest> requests, uint64_t max_heap_size) SKR_NOEXCEPT
+{
+    ZoneScopedN("RenderGraphPlanTransients");
+
+    const auto count = (uint32_t)requests.size();
+    placements.clear();
+    placements.resize(count);
+    heaps.clear();
+    order.resize(count);
+    placed_count = 0;
+    requested_size = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        order[i] = i;
+        requested_size += requests[i].size;
+    }
+    // largest first, ties are broken by the request index so the plan does not depend on the sort
+    eastl::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (requests[a].size != requests[b].size) return requests[a].size > requests[b].size;
+        return a < b;
+    });
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const auto request = order[i];
+        SKR_ASSERT(requests[request].from <= requests[request].to && "transient request with an empty lifespan!");
+        bool placed = false;
+        for (uint32_t heap = 0; heap < heaps.size() && !placed; heap++)
+        {
+            placed = try_place(requests, request, heap, max_heap_size);
+        }
+        if (!placed)
+        {
+            placements[request].heap = (uint32_t)heaps.size();
+            placements[request].offset = 0;
+            heaps.emplace_back(TransientHeap{ requests[request].kind, requests[request].size });
+        }
+        placed_count++;
+    }
+}
+
+uint64_t TransientAllocator::get_heaps_size() const SKR_NOEXCEPT
+{
+    uint64_t size = 0;
+    for (const auto& heap : heaps)
+        size += heap.size;
+    return size;
+}
+} // namespace render_graph
+} // namespace skr
@@ -1,176 +1,154 @@
-#if defined(__clang__)
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wunused-variable"
-    #pragma clang diagnostic ignored "-Wunknown-pragmas"
-    #pragma clang diagnostic ignored "-Wuninitialized-const-reference"
-#endif
-#include "utils/DAG.boost.hpp"
-#include <boost/graph/graphviz.hpp>
 #include "SkrRenderGraph/frontend/render_graph.hpp"
 #include "SkrRenderGraph/frontend/pass_node.hpp"
+#include "containers/string.hpp"
+#include <fstream>
 
 namespace skr
 {
 namespace render_graph
 {
-template <class EdgeProps>
-class EdgeWriter
+static void write_edge(std::ostream& out, const RenderGraphEdge* rg_edge)
 {
-public:
-    EdgeWriter(EdgeProps& edge)
-        : prop(edge)
-    {
-    }
-    template <class Edge>
-    void operator()(std::ostream& out, const Edge& e) const
+    skr::string label;
+    switch (rg_edge->type)
     {
-        RenderGraphEdge* rg_edge = (RenderGraphEdge*)prop[e];
-        skr::string label;
-        switch (rg_edge->type)
-        {
-            case ERelationshipType::TextureRead: {
-                auto SRV = (TextureReadEdge*)rg_edge;
-                if (auto name = SRV->get_name())
-                {
-                    label = "SRV: ";
-                    label.append(name);
-                }
-                else
-                {
-                    label = "SRV";
-                    //label = "SRV:s";
-                    //label.append(skr::to_string(SRV->set))
-                    //.append("b")
-                    //.append(skr::to_string(SRV->binding));
-                }
+        case ERelationshipType::TextureRead: {
+            auto SRV = (TextureReadEdge*)rg_edge;
+            if (auto name = SRV->get_name())
+            {
+                label = "SRV: ";
+                label.append(name);
             }
-            break;
-            case ERelationshipType::TextureReadWrite: {
-                auto UAV = (TextureReadWriteEdge*)rg_edge;
-                if (auto name = UAV->get_name())
-                {
-                    label = "UAV: ";
-                    label.append(name);
-                }
-                else
-                {
-                    label = "UAV";
-                    //label = "UAV:s";
-                    //label.append(skr::to_string(UAV->set))
-                    //.append("b")
-                    //.append(skr::to_string(UAV->binding));
-                }
+            else
+            {
+                label = "SRV";
+                //label = "SRV:s";
+                //label.append(skr::to_string(SRV->set))
+                //.append("b")
+                //.append(skr::to_string(SRV->binding));
             }
-            break;
-            case ERelationshipType::TextureWrite: {
-                auto RTV = (TextureRenderEdge*)rg_edge;
-                label = "RTV:";
-                label.append(skr::to_string(RTV->mrt_index));
+        }
+        break;
+        case ERelationshipType::TextureReadWrite: {
+            auto UAV = (TextureReadWriteEdge*)rg_edge;
+            if (auto name = UAV->get_name())
+            {
+                label = "UAV: ";
+                label.append(name);
             }
-            break;
-            default:
-                break;
+            else
+            {
+                label = "UAV";
+                //label = "UAV:s";
+                //label.append(skr::to_string(UAV->set))
+                //.append("b")
+                //.append(skr::to_string(UAV->binding));
+            }
+        }
+        break;
+        case ERelationshipType::TextureWrite: {
+            auto RTV = (TextureRenderEdge*)rg_edge;
+            label = "RTV:";
+            label.append(skr::to_string(RTV->mrt_index));
         }
-        out << "[label=\"" << label.c_str() << "\"]";
+        break;
+        default:
+            break;
     }
+    out << "[label=\"" << label.c_str() << "\"]";
+}
 
-private:
-    EdgeProps prop;
-};
-
-template <class VertProps>
-class VertWriter
+static void write_vertex(std::ostream& out, const RenderGraphNode* rg_node, uint32_t out_edges)
 {
-public:
-    VertWriter(VertProps& vert)
-        : prop(vert)
+    skr::string label;
+    skr::string color = "lavenderblush";
+    skr::string shape = "none";
+    switch (rg_node->type)
     {
-    }
-    template <class Vertex>
-    void operator()(std::ostream& out, const Vertex& v) const
-    {
-        RenderGraphNode* rg_node = (RenderGraphNode*)prop[v];
-        skr::string label;
-        skr::string color = "lavenderblush";
-        skr::string shape = "none";
-        switch (rg_node->type)
-        {
-            case EObjectType::Texture: {
-                TextureNode* tex_node = (TextureNode*)rg_node;
-                const bool is_imported = tex_node->is_imported();
-                color = is_imported ? "grey35" : "grey70";
-                label = "texture: ";
-                label.append((const char*)rg_node->get_name());
-                label.append("\\nrefs: ")
-                .append(is_imported ? "imported" : skr::to_string(tex_node->outgoing_edges()));
-                if (auto aliasing_parent = tex_node->get_aliasing_parent(); aliasing_parent)
-                {
-                    label.append("\\naliasing: ").append((const char*)aliasing_parent->get_name());
-                }
-                shape = "box";
+        case EObjectType::Texture: {
+            TextureNode* tex_node = (TextureNode*)rg_node;
+            const bool is_imported = tex_node->is_imported();
+            color = is_imported ? "grey35" : "grey70";
+            label = "texture: ";
+            label.append((const char*)rg_node->get_name());
+            label.append("\\nrefs: ")
+            .append(is_imported ? "imported" : skr::to_string(out_edges));
+            if (const auto& placement = tex_node->get_placement(); placement.placed())
+            {
+                label.append("\\nplaced: heap ").append(skr::to_string(placement.heap))
+                .append(" @ ").append(skr::to_string(placement.offset));
             }
-            break;
-            case EObjectType::Buffer: {
-                BufferNode* buf_node = (BufferNode*)rg_node;
-                const bool is_imported = buf_node->is_imported();
-                color = is_imported ? "limegreen" : "lightgreen";
-                label = "buffer: ";
-                label.append((const char*)rg_node->get_name());
-                label.append("\\nrefs: ")
-                .append(is_imported ? "imported" : skr::to_string(buf_node->outgoing_edges()));
-                shape = "box";
-            }
-            break;
-            case EObjectType::Pass: {
-                PassNode* pass_node = (PassNode*)rg_node;
-                shape = "ellipse";
-                switch (pass_node->pass_type)
-                {
-                    case EPassType::Compute: {
-                        label = "compute: ";
-                        color = "lemonchiffon";
-                    }
-                    break;
-                    case EPassType::Copy: {
-                        label = "copy: ";
-                        color = "lightblue1";
-                    }
-                    break;
-                    case EPassType::Render: {
-                        label = "render(geom): ";
-                    }
-                    break;
-                    default:
-                        break;
+            shape = "box";
+        }
+        break;
+        case EObjectType::Buffer: {
+            BufferNode* buf_node = (BufferNode*)rg_node;
+            const bool is_imported = buf_node->is_imported();
+            color = is_imported ? "limegreen" : "lightgreen";
+            label = "buffer: ";
+            label.append((const char*)rg_node->get_name());
+            label.append("\\nrefs: ")
+            .append(is_imported ? "imported" : skr::to_string(out_edges));
+            shape = "box";
+        }
+        break;
+        case EObjectType::Pass: {
+            PassNode* pass_node = (PassNode*)rg_node;
+            shape = "ellipse";
+            switch (pass_node->pass_type)
+            {
+                case EPassType::Compute: {
+                    label = "compute: ";
+                    color = "lemonchiffon";
+                }
+                break;
+                case EPassType::Copy: {
+                    label = "copy: ";
+                    color = "lightblue1";
                 }
-                label.append((const char*)rg_node->get_name());
-            }
-            break;
-            default:
                 break;
+                case EPassType::Render: {
+                    label = "render(geom): ";
+                }
+                break;
+                default:
+                    break;
+            }
+            label.append((const char*)rg_node->get_name());
         }
-        out << "[label=\"" << label.c_str() << "\"]";
-        out << "[shape=\"" << shape.c_str() << "\"]";
-        out << "[fillcolor=\"" << color.c_str() << "\"]";
-        out << "[style=\"filled\"]";
+        break;
+        default:
+            break;
     }
+    out << "[label=\"" << label.c_str() << "\"]";
+    out << "[shape=\"" << shape.c_str() << "\"]";
+    out << "[fillcolor=\"" << color.c_str() << "\"]";
+    out << "[style=\"filled\"]";
+}
 
-private:
-    VertProps prop;
-};
-
-#include <fstream>
 void RenderGraphViz::write_graphviz(RenderGraph& graph, const char* outf) SKR_NOEXCEPT
 {
-    DependencyGraphBase& g = *DependencyGraphBase::as(graph.graph);
-    EdgeWriter<DependencyGraphBase> w(g);
-    VertWriter<DependencyGraphBase> v(g);
-    std::ofstream ofstm(outf);
-    boost::write_graphviz(ofstm, g, v, w);
+    const auto& topology = graph.topology;
+    // the graph may be dumped before compile(), count the out edges from the edge list instead of the built adjacency
+    eastl::vector<uint32_t> out_edges(topology.node_count(), 0);
+    for (auto source : topology.edge_sources)
+        out_edges[source]++;
+
+    std::ofstream out(outf);
+    out << "digraph G {\n";
+    for (uint32_t i = 0; i < topology.node_count(); i++)
+    {
+        out << i;
+        write_vertex(out, topology.nodes[i], out_edges[i]);
+        out << ";\n";
+    }
+    for (uint32_t e = 0; e < topology.edge_count(); e++)
+    {
+        out << topology.edge_sources[e] << "->" << topology.edge_targets[e] << " ";
+        write_edge(out, topology.edges[e]);
+        out << ";\n";
+    }
+    out << "}\n";
 }
 } // namespace render_graph
-} // namespace skr
-
-#if defined(__clang__)
-    #pragma clang diagnostic pop
-#endif
\ No newline at end of file
+} // namespace skr
\ No newline at end of file
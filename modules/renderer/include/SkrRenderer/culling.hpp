@@ -0,0 +1,74 @@
+#pragma once
+#include "SkrRenderer/module.configure.h"
+#include "SkrScene/scene.h"
+#include <EASTL/vector.h>
+
+namespace skr
+{
+namespace renderer
+{
+// planes of a view frustum, a point p is inside when dot(plane.xyz, p) + plane.w >= 0 for all of them
+struct SKR_RENDERER_API Frustum {
+    skr_float4_t planes[6];
+
+    // view projection taking row vectors to a [0, 1] depth range, the way viewports are resolved
+    static Frustum from_view_projection(const skr_float4x4_t& view_projection) SKR_NOEXCEPT;
+};
+
+// words of a visibility mask covering count objects
+inline uint32_t visibility_words(uint32_t count) { return (count + 31) / 32; }
+inline bool is_visible(const uint32_t* visibility, uint32_t index) { return visibility[index / 32] & (1u << (index % 32)); }
+
+// sets bit i of visibility when box i may intersect the frustum and clears it otherwise
+// on x86 boxes go through the kernel 8 at a time when the cpu has AVX2 and 4 at a time with SSE otherwise, one by one on other targets
+// meant to run per ECS chunk over the world bounds column
+SKR_RENDERER_API void cull_world_bounds(const Frustum& frustum, const skr_world_bounds_comp_t* bounds, uint32_t count, uint32_t* visibility) SKR_NOEXCEPT;
+
+// dynamic box tree for objects that rarely move, one leaf per object
+// - leaves are inserted next to the sibling that grows the tree the least
+// - moved leaves only mark themselves, refit walks their ancestors once per frame and stops where boxes settle
+// - culling skips the plane tests of subtrees that are completely inside the frustum
+class SKR_RENDERER_API BoundsBVH
+{
+public:
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    // returns the leaf of the object, user is the bit its visibility lands in
+    uint32_t insert(const skr_world_bounds_comp_t& bounds, uint32_t user) SKR_NOEXCEPT;
+    void remove(uint32_t leaf) SKR_NOEXCEPT;
+    // ancestors follow at the next refit
+    void update(uint32_t leaf, const skr_world_bounds_comp_t& bounds) SKR_NOEXCEPT;
+    void refit() SKR_NOEXCEPT;
+    // sets the user bits of the leaves that may intersect the frustum, others are left alone
+    void cull(const Frustum& frustum, uint32_t* visibility) SKR_NOEXCEPT;
+
+    inline uint32_t get_leaf_count() const SKR_NOEXCEPT { return leaf_count; }
+    inline uint32_t get_root() const SKR_NOEXCEPT { return root; }
+
+protected:
+    struct Node {
+        skr_float3_t lo;
+        skr_float3_t hi;
+        uint32_t parent = kInvalid;
+        uint32_t left = kInvalid;
+        uint32_t right = kInvalid;
+        uint32_t user = kInvalid;
+        bool dirty = false;
+        inline bool is_leaf() const { return left == kInvalid; }
+    };
+    uint32_t allocate_node() SKR_NOEXCEPT;
+    void free_node(uint32_t node) SKR_NOEXCEPT;
+    // recomputes boxes from node up to the root, stops once a box does not change
+    void refit_from(uint32_t node) SKR_NOEXCEPT;
+    void emit_subtree(uint32_t node, uint32_t* visibility) SKR_NOEXCEPT;
+
+    eastl::vector<Node> nodes;
+    eastl::vector<uint32_t> free_nodes;
+    eastl::vector<uint32_t> dirty_leaves;
+    uint32_t root = kInvalid;
+    uint32_t leaf_count = 0;
+    // scratch of cull: nodes with the planes they still straddle
+    eastl::vector<eastl::pair<uint32_t, uint32_t>> stack;
+};
+} // namespace renderer
+} // namespace skr
@@ -0,0 +1,54 @@
+#pragma once
+#include "SkrRenderer/primitive_draw.h"
+#include "containers/hashmap.hpp"
+#include <EASTL/vector.h>
+
+namespace skr
+{
+namespace renderer
+{
+// merges the draws of a list that carry instance data into instanced draws
+// draws merge when they share pipeline, tables, push constants, index and vertex views and the payload size,
+// the merged draw takes the place of the first one and the others are removed from the list
+// payloads are packed into a host visible buffer per frame in flight, the buffer of a frame is picked by its index
+// so it matches the render graph executor that submits the frame
+struct SKR_RENDERER_API DrawInstancer {
+    void initialize(CGPUDeviceId device, uint32_t frame_count) SKR_NOEXCEPT;
+    void finalize() SKR_NOEXCEPT;
+
+    // whether any draw of the lists has a payload to pack, without it coalesce leaves the lists and buffers alone
+    // and the caller has nothing to wait for
+    static bool has_payloads(skr::span<skr_primitive_draw_list_view_t* const> lists) SKR_NOEXCEPT;
+    // moves on to the buffer of frame_index, the caller waits for the GPU to finish the frame that used it before,
+    // RenderGraph::wait_executor does that for the frame the graph executes next
+    void begin_frame(uint64_t frame_index) SKR_NOEXCEPT;
+    // lists must be distinct, returns the number of draws merged away
+    uint32_t coalesce(skr::span<skr_primitive_draw_list_view_t* const> lists) SKR_NOEXCEPT;
+
+    inline CGPUBufferId get_frame_buffer() const SKR_NOEXCEPT { return frames.empty() ? nullptr : frames[frame_index].buffer; }
+
+protected:
+    struct FrameBuffer {
+        CGPUBufferId buffer = nullptr;
+        uint64_t capacity = 0;
+    };
+    struct Group {
+        uint32_t first;
+        uint32_t count;
+        uint32_t written;
+        uint64_t offset;
+    };
+    void reserve(uint64_t size) SKR_NOEXCEPT;
+    uint64_t pack(skr_primitive_draw_list_view_t& list, uint64_t cursor, uint32_t& merged) SKR_NOEXCEPT;
+
+    CGPUDeviceId device = nullptr;
+    eastl::vector<FrameBuffer> frames;
+    uint32_t frame_index = 0;
+
+    // scratch of the list being packed
+    skr::flat_hash_map<uint64_t, uint32_t> group_of;
+    eastl::vector<Group> groups;
+    eastl::vector<uint32_t> draw_groups;
+};
+} // namespace renderer
+} // namespace skr
@@ -0,0 +1,27 @@
+#pragma once
+#include "SkrRenderer/primitive_draw.h"
+#include <EASTL/vector.h>
+
+namespace skr
+{
+namespace renderer
+{
+// stable LSD radix sort of the draws of a list by their sort keys, 8 bits a pass
+// passes over digits every draw shares are skipped, so keys that only differ in a few fields sort in a few passes
+// a list is sorted on the calling thread, the renderer only spreads whole lists over jobs with one sorter each
+// the scratch stays with the sorter, so it stops allocating once lists stop growing
+struct SKR_RENDERER_API DrawListSorter {
+    // reorders the list in place, returns false and leaves it alone when a draw has no key
+    bool sort(skr_primitive_draw_list_view_t& list) SKR_NOEXCEPT;
+
+protected:
+    struct Entry {
+        uint64_t key;
+        uint32_t index;
+    };
+    eastl::vector<Entry> entries;
+    eastl::vector<Entry> swap_entries;
+    eastl::vector<skr_primitive_draw_t> draws;
+};
+} // namespace renderer
+} // namespace skr
@@ -39,6 +39,15 @@ typedef struct skr_primitive_draw_t {
     uint32_t vertex_buffer_count;
     skr_index_buffer_view_t index_buffer;
     bool desperated;
+    // 0 for none, a list whose draws all carry a key is submitted in increasing key order
+    uint64_t sort_key;
+    // per-instance payload, read by the pipeline as its last vertex buffer with a per-instance step rate
+    // draws of a list sharing everything else and the payload size are merged into one instanced draw
+    const uint8_t* instance_data;
+    uint32_t instance_data_size;
+    // set by the renderer on draws with a payload: instances to draw and where their payloads were packed
+    uint32_t instance_count;
+    skr_vertex_buffer_view_t instance_buffer;
 } skr_primitive_draw_t;
 
 typedef struct skr_primitive_draw_list_view_t {
@@ -66,8 +75,41 @@ struct PrimitiveCommand {
     const skr_index_buffer_view_t* ibv;
     uint32_t primitive_index;
     uint32_t material_index;
+    // coarser levels of detail sharing vbvs, ordered by increasing error
+    skr::span<const skr_index_buffer_view_t> lod_ibvs;
+    skr::span<const float> lod_errors;
+
+    // the coarsest level whose simplification error stays under max_error, in object space units
+    inline const skr_index_buffer_view_t* select_lod(float max_error) const
+    {
+        const skr_index_buffer_view_t* selected = ibv;
+        for (size_t i = 0; i < lod_ibvs.size() && lod_errors[i] <= max_error; i++)
+        {
+            selected = &lod_ibvs[i];
+        }
+        return selected;
+    }
 };
 
+// from the top bit down: pipeline 20 | bind table 16 | material 12 | depth 15 | keyed 1
+// so draws group by pipeline first, then by tables, and go front to back inside a group
+// pointers are folded into their fields, two that collide only interleave their draws
+inline uint64_t make_draw_sort_key(const void* pipeline, const void* bind_table, uint32_t material, float depth)
+{
+    const auto fold = [](const void* ptr, uint32_t bits) -> uint64_t {
+        if (!ptr) return 0;
+        uint64_t v = (uint64_t)(uintptr_t)ptr;
+        v ^= v >> 33;
+        v *= 0xff51afd7ed558ccdull;
+        v ^= v >> 33;
+        return v >> (64 - bits);
+    };
+    // depth is the view depth over the far distance, 0 at the eye
+    const float clamped = (depth > 0.f) ? ((depth < 1.f) ? depth : 1.f) : 0.f;
+    const uint64_t depth_bucket = (uint64_t)(clamped * 32767.f);
+    return (fold(pipeline, 20) << 44) | (fold(bind_table, 16) << 28) | ((uint64_t)(material & 0xfff) << 16) | (depth_bucket << 1) | 1ull;
+}
+
 } // namespace renderer
 } // namespace skr
 #endif
\ No newline at end of file
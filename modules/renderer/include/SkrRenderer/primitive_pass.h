@@ -17,6 +17,8 @@ typedef struct skr_primitive_pass_context_t {
     SRendererId renderer;
     skr::render_graph::RenderGraph* render_graph;
     struct dual_storage_t* storage;
+    // index of the viewport the frame is rendered for in the viewport manager
+    uint32_t viewport_id;
 } skr_primitive_pass_context_t;
 
 struct IPrimitiveRenderPass {
@@ -2,6 +2,7 @@
 #include "platform/configure.h"
 #include "SkrRenderer/module.configure.h"
 #include "SkrRenderer/fwd_types.h"
+#include "SkrRenderer/shader_hash.h"
 #include "cgpu/api.h"
 
 typedef enum ESkrPSOMapPSOStatus
@@ -20,6 +21,11 @@ skr_pso_map_id skr_pso_map_create(const struct skr_pso_map_root_t* desc);
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API 
 skr_pso_map_key_id skr_pso_map_create_key(skr_pso_map_id map, const struct CGPURenderPipelineDescriptor* desc);
 
+// (RC) create a pso map key, shaders are the shader map identifiers of the stages of desc
+// psos installed through these keys are recorded in the usage manifest of the map
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API 
+skr_pso_map_key_id skr_pso_map_create_key_with_shaders(skr_pso_map_id map, const struct CGPURenderPipelineDescriptor* desc, const skr_platform_shader_identifier_t* shaders, uint32_t shader_count);
+
 // (RC) free a pso map key
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API
 void skr_pso_map_free_key(skr_pso_map_id map, skr_pso_map_key_id key);
@@ -50,17 +56,99 @@ void skr_pso_map_garbage_collect(skr_pso_map_id psoMap, uint64_t critical_frame)
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API 
 void skr_pso_map_free(skr_pso_map_id pso_map);
 
+// copies the usage manifest of the map in warm up order, returns the entry count
+// entries may be null to query the count
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+uint32_t skr_pso_map_get_manifest(skr_pso_map_id pso_map, struct skr_pso_map_manifest_entry_t* entries, uint32_t capacity);
+
+// forget the recorded usage, e.g. before a level load
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+void skr_pso_map_clear_manifest(skr_pso_map_id pso_map);
+
+// write the usage manifest of the map to a file
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+bool skr_pso_map_save_manifest(skr_pso_map_id pso_map, struct skr_vfs_t* vfs, const char8_t* path);
+
+// read a manifest written by skr_pso_map_save_manifest, returns the entry count
+// entries may be null to query the count, missing files and files of another entry layout read as empty
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+uint32_t skr_pso_map_load_manifest(struct skr_vfs_t* vfs, const char8_t* path, struct skr_pso_map_manifest_entry_t* entries, uint32_t capacity);
+
+// thread-safe against find_pso.
+// start pre-creating the psos of a manifest on the task system, the calling thread must have a task scheduler bound
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+void skr_pso_map_begin_warmup(skr_pso_map_id pso_map, const struct skr_pso_map_warmup_desc_t* desc);
+
+// resolve waiting entries and dispatch their psos, call once a frame until it returns true
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+bool skr_pso_map_update_warmup(skr_pso_map_id pso_map, struct skr_pso_map_warmup_progress_t* progress);
+
+// wait for the psos being compiled and drop the entries still waiting
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+void skr_pso_map_end_warmup(skr_pso_map_id pso_map);
+
 typedef struct skr_pso_map_root_t {
     CGPUDeviceId device = nullptr;
     skr_threaded_service_t* aux_service = nullptr;
 } skr_pso_map_root_t;
 
+// a stage of a manifest entry, kept by its shader map identifier
+typedef struct skr_pso_map_shader_t {
+    skr_platform_shader_identifier_t identifier;
+    char8_t entry[64];
+} skr_pso_map_shader_t;
+
+// a pso as it outlives a run: shader map keys, vertex layout and render states
+// entries are zero filled and compared, hashed and persisted bytewise up to first_use
+typedef struct skr_pso_map_manifest_entry_t {
+    uint32_t shader_count;
+    skr_pso_map_shader_t shaders[CGPU_SHADER_STAGE_COUNT];
+    CGPUVertexLayout vertex_layout;
+    CGPUBlendStateDescriptor blend_state;
+    CGPUDepthStateDescriptor depth_state;
+    CGPURasterizerStateDescriptor rasterizer_state;
+    ECGPUFormat color_formats[CGPU_MAX_MRT_COUNT];
+    uint32_t render_target_count;
+    ECGPUSampleCount sample_count;
+    uint32_t sample_quality;
+    ECGPUSlotMask color_resolve_disable_mask;
+    ECGPUFormat depth_stencil_format;
+    ECGPUPrimitiveTopology prim_topology;
+    bool enable_indirect_command;
+    // order of the first install over the recording, psos needed first are warmed up first
+    uint32_t first_use;
+    // installs over the recording, breaks ties
+    uint32_t use_count;
+} skr_pso_map_manifest_entry_t;
+
+// fills the shader library of each entry->shaders and the root signature the pso is made with
+// called again for an entry while it returns SKR_PSO_MAP_PSO_STATUS_REQUESTED, FAILED drops the entry
+// the libraries and the root signature stay owned by the caller and must outlive the pso map
+typedef ESkrPSOMapPSOStatus (*skr_pso_map_resolve_proc_t)(void* usrdata, const skr_pso_map_manifest_entry_t* entry, CGPUShaderLibraryId* libraries, CGPURootSignatureId* root_signature);
+
+typedef struct skr_pso_map_warmup_desc_t {
+    const skr_pso_map_manifest_entry_t* entries;
+    uint32_t entry_count;
+    skr_pso_map_resolve_proc_t resolve;
+    void* usrdata;
+    // psos compiled at once, 0 for as many as are resolved
+    uint32_t max_jobs;
+} skr_pso_map_warmup_desc_t;
+
+typedef struct skr_pso_map_warmup_progress_t {
+    uint32_t total;
+    // psos created by the warm up, or already installed or requested when it got to them
+    uint32_t compiled;
+    uint32_t failed;
+    uint32_t in_flight;
+} skr_pso_map_warmup_progress_t;
+
 #ifdef __cplusplus
 struct SKR_RENDERER_API skr_pso_map_t
 {    
     virtual ~skr_pso_map_t() = default;
 
-    virtual skr_pso_map_key_id create_key(const struct CGPURenderPipelineDescriptor* desc) SKR_NOEXCEPT = 0;
+    virtual skr_pso_map_key_id create_key(const struct CGPURenderPipelineDescriptor* desc, const skr_platform_shader_identifier_t* shaders = nullptr, uint32_t shader_count = 0) SKR_NOEXCEPT = 0;
     virtual void free_key(skr_pso_map_key_id key) SKR_NOEXCEPT = 0;
     virtual ESkrPSOMapPSOStatus install_pso(skr_pso_map_key_id key) SKR_NOEXCEPT = 0;
     virtual CGPURenderPipelineId find_pso(skr_pso_map_key_id key) SKR_NOEXCEPT = 0;
@@ -69,6 +157,13 @@ struct SKR_RENDERER_API skr_pso_map_t
     virtual void new_frame(uint64_t frame_index) SKR_NOEXCEPT = 0;
     virtual void garbage_collect(uint64_t critical_frame) SKR_NOEXCEPT = 0;
 
+    virtual uint32_t get_manifest(skr_pso_map_manifest_entry_t* entries, uint32_t capacity) SKR_NOEXCEPT = 0;
+    virtual void clear_manifest() SKR_NOEXCEPT = 0;
+
+    virtual void begin_warmup(const skr_pso_map_warmup_desc_t* desc) SKR_NOEXCEPT = 0;
+    virtual bool update_warmup(skr_pso_map_warmup_progress_t* progress) SKR_NOEXCEPT = 0;
+    virtual void end_warmup() SKR_NOEXCEPT = 0;
+
     static skr_pso_map_id Create(const struct skr_pso_map_root_t* desc) SKR_NOEXCEPT;
     static bool Free(skr_pso_map_id pso_map) SKR_NOEXCEPT;
 };
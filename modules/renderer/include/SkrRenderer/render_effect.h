@@ -55,6 +55,8 @@ typedef struct skr_primitive_draw_context_t
     skr::render_graph::RenderGraph* render_graph;
     IPrimitiveRenderPass* pass;
     dual_storage_t* storage;
+    // index of the viewport the frame is rendered for in the viewport manager
+    uint32_t viewport_id;
 } skr_primitive_draw_context_t;
 
 typedef struct skr_primitive_update_context_t 
@@ -62,6 +64,8 @@ typedef struct skr_primitive_update_context_t
     SRendererId renderer;
     skr::render_graph::RenderGraph* render_graph;
     dual_storage_t* storage;
+    // index of the viewport the frame is rendered for in the viewport manager
+    uint32_t viewport_id;
 } skr_primitive_update_context_t;
 
 // Effect interfaces
@@ -96,8 +100,11 @@ typedef struct SKR_RENDERER_API IRenderEffectProcessor {
     virtual dual_type_index_t get_identity_type() = 0;
     virtual void initialize_data(SRendererId renderer, dual_storage_t* storage, dual_chunk_view_t* game_cv, dual_chunk_view_t* render_cv) = 0;
 
+    // with parallel produce this runs on a task next to the other processors, for all passes in turn,
+    // changes to the render graph or to state other processors see belong in on_update
     virtual skr_primitive_draw_packet_t produce_draw_packets(const skr_primitive_draw_context_t* context) = 0;
 
+    // runs on the render thread before any processor produces draw packets
     virtual void on_update(const skr_primitive_update_context_t* context) {};
     virtual void post_update(const skr_primitive_update_context_t* context) {};
 #endif
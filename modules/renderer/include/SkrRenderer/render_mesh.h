@@ -16,6 +16,8 @@ struct RenderMesh
     skr::vector<CGPUBufferId> buffers;
     skr::vector<skr_vertex_buffer_view_t> vertex_buffer_views;
     skr::vector<skr_index_buffer_view_t> index_buffer_views;
+    skr::vector<skr_index_buffer_view_t> lod_index_buffer_views;
+    skr::vector<float> lod_errors;
     skr::vector<PrimitiveCommand> primitive_commands;
 };
 } // namespace renderer
@@ -16,6 +16,10 @@ skr_render_viewport_t
     uint32_t viewport_height;
 
     skr_float4x4_t view_projection;
+    // derived from camera
+    skr_float3_t eye;
+    // derived from camera, vertical field of view in radians
+    float fov_y;
 };
 typedef struct skr_render_viewport_t skr_render_viewport_t;
 
@@ -35,6 +39,10 @@ struct SKR_RENDERER_API SViewportManager {
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API
 void skr_resolve_camera_to_viewport(const skr_camera_comp_t* camera, const skr_translation_comp_t* translation, skr_render_viewport_t* viewport);
 
+// simplification error allowed at distance from the eye so that it stays under pixel_error pixels on the viewport
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+float skr_render_viewport_lod_error(const skr_render_viewport_t* viewport, float distance, float pixel_error);
+
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API
 void skr_resolve_cameras_to_viewport(struct SViewportManager* viewport_manager, dual_storage_t* storage);
 
@@ -8,6 +8,9 @@
 #include "SkrRenderer/resources/material_resource.generated.h"
 #endif
 
+struct skr_pso_map_warmup_progress_t;
+struct skr_texture_resource_t;
+
 namespace skr sreflect
 {
 namespace renderer sreflect
@@ -150,6 +153,11 @@ MaterialResource
         struct skr_pso_map_key_t* key;
         CGPURenderPipelineId pso;
         CGPUXBindTableId bind_table;
+        // textures of the overrides and the views bind_table was written with, streaming replaces the views
+        skr::vector<skr_texture_resource_t*> textures;
+        skr::vector<CGPUTextureViewId> texture_views;
+        // tables replaced after a view changed, recorded frames may still use them so they live as long as the material
+        skr::vector<CGPUXBindTableId> retired_bind_tables;
     } installed_pass;
 
     spush_attr("no-rtti" : true, "transient": true)
@@ -167,6 +175,18 @@ struct SKR_RENDERER_API SMaterialFactory : public resource::SResourceFactory {
     };
     [[nodiscard]] static SMaterialFactory* Create(const Root& root);
     static void Destroy(SMaterialFactory* factory); 
+
+    // psos the materials were installed with so far, for the next run to warm up
+    virtual bool SavePSOManifest(skr_vfs_t* vfs, const char8_t* path) = 0;
+    // pre-create the psos of a saved manifest on the task system while materials load, false when there is none
+    virtual bool BeginPSOWarmup(skr_vfs_t* vfs, const char8_t* path, uint32_t max_jobs) = 0;
+    // call once a frame after BeginPSOWarmup, true once every pso of the manifest is created or dropped
+    virtual bool UpdatePSOWarmup(skr_pso_map_warmup_progress_t* progress) = 0;
+    // waits for the psos in compilation and drops the rest of the manifest
+    virtual void EndPSOWarmup() = 0;
+    // rewrites the bind tables of the installed materials whose textures got new views,
+    // call once a frame after STextureFactory::UpdateStreaming
+    virtual void UpdateTextureViews() = 0;
 };
 } // namespace resource
 } // namespace skr
\ No newline at end of file
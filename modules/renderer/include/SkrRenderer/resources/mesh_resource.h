@@ -49,18 +49,106 @@ skr_index_buffer_entry_t
 };
 typedef struct skr_index_buffer_entry_t skr_index_buffer_entry_t;
 
+sreflect_enum("guid" : "cceb3c67-4546-4c3b-a6f1-ad7c43b9aba7")
+sattr("rtti" : true, "serialize" : ["bin", "json"])
+ESkrMeshStreamCodec SKR_IF_CPP(: uint32_t)
+{
+    SKR_MESH_STREAM_CODEC_NONE,
+    // meshopt index codec, triangle lists with 16 or 32 bit indices
+    SKR_MESH_STREAM_CODEC_INDEX,
+    // meshopt vertex codec, strides of multiples of 4 up to 256 bytes
+    SKR_MESH_STREAM_CODEC_VERTEX,
+    SKR_MESH_STREAM_CODEC_MAX_ENUM_BIT = UINT32_MAX,
+};
+typedef enum ESkrMeshStreamCodec ESkrMeshStreamCodec;
+
+sreflect_enum("guid" : "cb64f1c4-dc11-4c5e-ab75-bee773351a8a")
+sattr("rtti" : true, "serialize" : ["bin", "json"])
+ESkrMeshStreamFilter SKR_IF_CPP(: uint32_t)
+{
+    SKR_MESH_STREAM_FILTER_NONE,
+    // octahedral unit vectors, decoded to 8 or 16 bit snorm xyzw
+    SKR_MESH_STREAM_FILTER_OCTAHEDRAL,
+    SKR_MESH_STREAM_FILTER_MAX_ENUM_BIT = UINT32_MAX,
+};
+typedef enum ESkrMeshStreamFilter ESkrMeshStreamFilter;
+
+// one index, vertex or meshlet stream of a mesh buffer
+sreflect_struct("guid" : "fa85621c-9cc6-4834-91eb-8b447bd88fbd")
+sattr("rtti" : true, "serialize" : "bin")
+skr_mesh_buffer_stream_t
+{
+    ESkrMeshStreamCodec codec;
+    ESkrMeshStreamFilter filter;
+    uint32_t count;
+    uint32_t stride;
+    // byte offset in the decoded buffer
+    uint64_t offset;
+    // byte range in the cooked file, only valid if the buffer is compressed
+    uint64_t compressed_offset;
+    uint64_t compressed_size;
+};
+typedef struct skr_mesh_buffer_stream_t skr_mesh_buffer_stream_t;
+
 sreflect_struct("guid" : "03104e51-c998-410b-9d3c-d76535933440")
 sattr("rtti" : true, "serialize" : "bin")
 skr_mesh_buffer_t
 {
     uint32_t index;
+    // size of the decoded buffer in memory
     uint64_t byte_length;
+    // size of the cooked file, 0 if the buffer is stored uncompressed
+    uint64_t compressed_length;
     bool used_with_index;
     bool used_with_vertex;
+    bool used_with_meshlet;
+    skr::vector<skr_mesh_buffer_stream_t> streams;
     sattr("transient": true, "no-rtti" : true)
     skr_blob_t bin;
 };
 
+sreflect_struct("guid" : "751ac4d2-7b7d-4769-a2c0-40c85fa362c8")
+sattr("rtti" : true, "serialize" : "bin")
+skr_meshlet_t
+{
+    // offset in the meshlet vertices of the primitive
+    uint32_t vertex_offset;
+    // byte offset in the packed meshlet triangles of the primitive
+    uint32_t triangle_offset;
+    uint32_t vertex_count;
+    uint32_t triangle_count;
+    // bounding sphere & normal cone for cluster culling
+    skr_float3_t center;
+    float radius;
+    skr_float3_t cone_axis;
+    float cone_cutoff;
+};
+typedef struct skr_meshlet_t skr_meshlet_t;
+
+// coarser level of detail of a primitive, indices live in the index buffer of the primitive
+sreflect_struct("guid" : "04b52f43-5b8a-4a4a-9b6e-6aa58cc40cf4")
+sattr("rtti" : true, "serialize" : "bin")
+skr_mesh_lod_t
+{
+    uint32_t first_index;
+    uint32_t index_count;
+    // simplification error in object space units
+    float error;
+};
+typedef struct skr_mesh_lod_t skr_mesh_lod_t;
+
+sreflect_struct("guid" : "98088019-4c81-4b44-a377-5fd92ddff6cf")
+sattr("rtti" : true, "serialize" : "bin")
+skr_meshlet_buffer_entry_t
+{
+    uint32_t buffer_index;
+    // byte offset of the uint32 vertex indices of all meshlets
+    uint32_t vertices_offset;
+    // byte offset of the uint8 triangle corners of all meshlets, 3 per triangle
+    uint32_t triangles_offset;
+};
+typedef struct skr_meshlet_buffer_entry_t skr_meshlet_buffer_entry_t;
+
 #ifdef __cplusplus
 #include "resource/resource_factory.h"
 
@@ -72,6 +160,10 @@ using EVertexAttribute = ESkrVertexAttribute;
 using VertexBufferEntry = skr_vertex_buffer_entry_t;
 using IndexBufferEntry = skr_index_buffer_entry_t;
 using MeshBuffer = skr_mesh_buffer_t;
+using MeshBufferStream = skr_mesh_buffer_stream_t;
+using Meshlet = skr_meshlet_t;
+using MeshletBufferEntry = skr_meshlet_buffer_entry_t;
+using MeshLOD = skr_mesh_lod_t;
 
 sreflect_struct("guid" : "b0b69898-166f-49de-a675-7b04405b98b1")
 sattr("rtti" : true, "serialize" : "bin")
@@ -82,6 +174,11 @@ MeshPrimitive
     skr::vector<VertexBufferEntry> vertex_buffers;
     IndexBufferEntry index_buffer;
     uint32_t vertex_count;
+    // ordered by increasing error, sharing the vertex buffers of the primitive
+    skr::vector<MeshLOD> lods;
+    // empty unless meshlets are generated by the cooker
+    skr::vector<Meshlet> meshlets;
+    MeshletBufferEntry meshlet_buffer;
 };
 
 sreflect_struct("guid" : "d3b04ea5-415d-44d5-995a-5c77c64fe1de")
@@ -138,6 +235,10 @@ struct SKR_RENDERER_API SMeshFactory : public resource::SResourceFactory {
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API void 
 skr_mesh_resource_free(skr_mesh_resource_id mesh_resource);
 
+// decodes a compressed mesh buffer into byte_length bytes of destination, streams are decoded in place
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API bool 
+skr_mesh_buffer_decode(const skr_mesh_buffer_t* buffer, const uint8_t* compressed, uint64_t compressed_size, uint8_t* destination);
+
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API void 
 skr_mesh_resource_register_vertex_layout(skr_vertex_layout_id id, const char* name, const struct CGPUVertexLayout* in_vertex_layout);
 
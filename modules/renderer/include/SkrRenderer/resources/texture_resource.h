@@ -1,5 +1,6 @@
 #pragma once
 #include "SkrRenderer/fwd_types.h"
+#include <containers/vector.hpp>
 #include "utils/io.h"
 #include "cgpu/io.h"
 
@@ -7,6 +8,19 @@
 #include "SkrRenderer/resources/texture_resource.generated.h"
 #endif
 
+// one mip level of the cooked texture file, blocks are tightly packed in raster order
+sreflect_struct("guid" : "3e4a7a0c-5b0f-4e53-9d6a-2f1f6b8c1d27")
+sattr("rtti" : true, "serialize" : "bin")
+skr_texture_mip_t
+{
+    uint32_t width;
+    uint32_t height;
+    // byte range in the cooked file
+    uint64_t offset;
+    uint64_t size;
+};
+typedef struct skr_texture_mip_t skr_texture_mip_t;
+
 // (GPU) texture resource
 sreflect_struct("guid" : "f8821efb-f027-4367-a244-9cc3efb3a3bf")
 sattr("rtti" : true)
@@ -19,10 +33,16 @@ skr_texture_resource_t
     uint32_t width;
     uint32_t height;
     uint32_t depth;
+    // mips_count entries indexed by level, the cooked file stores them from the smallest level
+    // so that any mip tail can be loaded with a single read, see STextureFactory::RequestMips
+    skr::vector<skr_texture_mip_t> mips;
 
     spush_attr("no-rtti" : true, "transient": true)
     CGPUTextureId texture;
+    // views the resident levels only, replaced when more levels are streamed in
     CGPUTextureViewId texture_view;
+    // most detailed level on the GPU
+    uint32_t resident_mip;
 };
 typedef struct skr_texture_resource_t skr_texture_resource_t;
 typedef struct skr_texture_resource_t* skr_texture_resource_id;
@@ -95,6 +115,7 @@ namespace renderer {
     using SamplerAddressMode = ESkrTextureSamplerAddressMode;
     using SamplerCompareMode = ESkrTextureSamplerCompareMode;
     using SamplerResource = ::skr_texture_sampler_resource_t;
+    using TextureMip = ::skr_texture_mip_t;
     using TextureResource = ::skr_texture_resource_t;
 } // namespace renderer
 } // namespace skr
@@ -119,11 +140,21 @@ struct SKR_RENDERER_API STextureFactory : public SResourceFactory {
         skr_io_ram_service_t* ram_service = nullptr;
         skr_io_vram_service_t* vram_service = nullptr;
         SRenderDeviceId render_device = nullptr;
+        // levels larger than this extent are not loaded on install but through RequestMips, 0 loads every level
+        uint32_t streaming_max_extent = 0;
     };
 
     float AsyncSerdeLoadFactor() override { return 2.5f; }
     [[nodiscard]] static STextureFactory* Create(const Root& root);
     static void Destroy(STextureFactory* factory); 
+
+    // streams in the levels from resident_mip up to most_detailed_mip with a single ram read
+    // returns false if the texture is not installed yet or another request for it is in flight
+    virtual bool RequestMips(skr_texture_resource_id texture, uint32_t most_detailed_mip) = 0;
+    // finishes the completed mip requests, texture_view of an upgraded texture is replaced
+    virtual void UpdateStreaming() = 0;
+    // most detailed level worth having for a texture drawn over screen_extent pixels, for RequestMips
+    static uint32_t MipForExtent(const skr_texture_resource_t* texture, float screen_extent);
 };
 
 struct SKR_RENDERER_API STextureSamplerFactory : public SResourceFactory {
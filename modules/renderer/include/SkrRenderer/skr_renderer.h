@@ -45,4 +45,13 @@ RUNTIME_EXTERN_C SKR_RENDERER_API
 SRenderDeviceId skr_get_default_render_device();
 
 RUNTIME_EXTERN_C SKR_RENDERER_API 
-void skr_renderer_render_frame(SRendererId renderer, skr::render_graph::RenderGraph* render_graph);
\ No newline at end of file
+void skr_renderer_render_frame(SRendererId renderer, skr::render_graph::RenderGraph* render_graph);
+
+// processors produce their draw packets on the task system, one job per processor
+// state processors share is changed in their on_update then, and a task scheduler has to be bound to the rendering thread
+RUNTIME_EXTERN_C SKR_RENDERER_API 
+void skr_renderer_enable_parallel_produce(SRendererId renderer, bool enable);
+
+// the viewport the contexts of the frames rendered from now on name, 0 until set
+RUNTIME_EXTERN_C SKR_RENDERER_API 
+void skr_renderer_set_viewport(SRendererId renderer, uint32_t viewport_id);
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "SkrRenderer/culling.hpp"
+#include "platform/debug.h"
+#include <math.h>
+
+#include "tracy/Tracy.hpp"
+
+namespace skr
+{
+namespace renderer
+{
+static inline skr_float3_t Min3(const skr_float3_t& a, const skr_float3_t& b)
+{
+    return { a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z };
+}
+static inline skr_float3_t Max3(const skr_float3_t& a, const skr_float3_t& b)
+{
+    return { a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z };
+}
+// half the surface area, what the insertion cost is measured in
+static inline float HalfArea(const skr_float3_t& lo, const skr_float3_t& hi)
+{
+    const float dx = hi.x - lo.x, dy = hi.y - lo.y, dz = hi.z - lo.z;
+    return dx * dy + dy * dz + dz * dx;
+}
+static inline bool Equal3(const skr_float3_t& a, const skr_float3_t& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+uint32_t BoundsBVH::allocate_node() SKR_NOEXCEPT
+{
+    if (!free_nodes.empty())
+    {
+        const auto node = free_nodes.back();
+        free_nodes.pop_back();
+        nodes[node] = Node();
+        return node;
+    }
+    nodes.emplace_back();
+    return (uint32_t)nodes.size() - 1;
+}
+
+void BoundsBVH::free_node(uint32_t node) SKR_NOEXCEPT
+{
+    nodes[node] = Node();
+    free_nodes.emplace_back(node);
+}
+
+uint32_t BoundsBVH::insert(const skr_world_bounds_comp_t& bounds, uint32_t user) SKR_NOEXCEPT
+{
+    const auto leaf = allocate_node();
+    {
+        auto& node = nodes[leaf];
+        node.lo = { bounds.center.x - bounds.extent.x, bounds.center.y - bounds.extent.y, bounds.center.z - bounds.extent.z };
+        node.hi = { bounds.center.x + bounds.extent.x, bounds.center.y + bounds.extent.y, bounds.center.z + bounds.extent.z };
+        node.user = user;
+    }
+    leaf_count++;
+    if (root == kInvalid)
+    {
+        root = leaf;
+        return leaf;
+    }
+
+    // walk down to the sibling whose merge with the leaf adds the least area to the tree
+    const auto lo = nodes[leaf].lo, hi = nodes[leaf].hi;
+    uint32_t sibling = root;
+    while (!nodes[sibling].is_leaf())
+    {
+        const auto& node = nodes[sibling];
+        const float area = HalfArea(node.lo, node.hi);
+        const float merged_area = HalfArea(Min3(node.lo, lo), Max3(node.hi, hi));
+        // pairing with this node makes a new parent, going further down grows this node anyway
+        const float cost = 2.f * merged_area;
+        const float inheritance = 2.f * (merged_area - area);
+        const auto child_cost = [&](uint32_t child) {
+            const auto& c = nodes[child];
+            const float grown = HalfArea(Min3(c.lo, lo), Max3(c.hi, hi));
+            return (c.is_leaf() ? grown : grown - HalfArea(c.lo, c.hi)) + inheritance;
+        };
+        const float left_cost = child_cost(node.left);
+        const float right_cost = child_cost(node.right);
+        if (cost < left_cost && cost < right_cost) break;
+        sibling = (left_cost < right_cost) ? node.left : node.right;
+    }
+
+    const auto old_parent = nodes[sibling].parent;
+    const auto parent = allocate_node();
+    nodes[parent].parent = old_parent;
+    nodes[parent].left = sibling;
+    nodes[parent].right = leaf;
+    nodes[parent].lo = Min3(nodes[sibling].lo, lo);
+    nodes[parent].hi = Max3(nodes[sibling].hi, hi);
+    nodes[sibling].parent = parent;
+    nodes[leaf].parent = parent;
+    if (old_parent == kInvalid)
+        root = parent;
+    else if (nodes[old_parent].left == sibling)
+        nodes[old_parent].left = parent;
+    else
+        nodes[old_parent].right = parent;
+    refit_from(old_parent);
+    return leaf;
+}
+
+void BoundsBVH::remove(uint32_t leaf) SKR_NOEXCEPT
+{
+    SKR_ASSERT(leaf < nodes.size() && nodes[leaf].is_leaf() && nodes[leaf].user != kInvalid);
+    leaf_count--;
+    if (nodes[leaf].dirty)
+    {
+        for (auto& dirty : dirty_leaves)
+        {
+            if (dirty == leaf) dirty = kInvalid;
+        }
+    }
+    if (leaf == root)
+    {
+        root = kInvalid;
+        free_node(leaf);
+        return;
+    }
+    // the sibling takes the place of the parent
+    const auto parent = nodes[leaf].parent;
+    const auto grand_parent = nodes[parent].parent;
+    const auto sibling = (nodes[parent].left == leaf) ? nodes[parent].right : nodes[parent].left;
+    nodes[sibling].parent = grand_parent;
+    if (grand_parent == kInvalid)
+        root = sibling;
+    else if (nodes[grand_parent].left == parent)
+        nodes[grand_parent].left = sibling;
+    else
+        nodes[grand_parent].right = sibling;
+    free_node(parent);
+    free_node(leaf);
+    refit_from(grand_parent);
+}
+
+void BoundsBVH::update(uint32_t leaf, const skr_world_bounds_comp_t& bounds) SKR_NOEXCEPT
+{
+    auto& node = nodes[leaf];
+    SKR_ASSERT(node.is_leaf() && node.user != kInvalid);
+    node.lo = { bounds.center.x - bounds.extent.x, bounds.center.y - bounds.extent.y, bounds.center.z - bounds.extent.z };
+    node.hi = { bounds.center.x + bounds.extent.x, bounds.center.y + bounds.extent.y, bounds.center.z + bounds.extent.z };
+    if (!node.dirty)
+    {
+        node.dirty = true;
+        dirty_leaves.emplace_back(leaf);
+    }
+}
+
+void BoundsBVH::refit_from(uint32_t node) SKR_NOEXCEPT
+{
+    for (; node != kInvalid; node = nodes[node].parent)
+    {
+        auto& n = nodes[node];
+        const auto lo = Min3(nodes[n.left].lo, nodes[n.right].lo);
+        const auto hi = Max3(nodes[n.left].hi, nodes[n.right].hi);
+        // the ancestors already enclose this box, changes of other leaves refit them on their own walks
+        if (Equal3(lo, n.lo) && Equal3(hi, n.hi)) break;
+        n.lo = lo;
+        n.hi = hi;
+    }
+}
+
+void BoundsBVH::refit() SKR_NOEXCEPT
+{
+    ZoneScopedN("RefitBoundsBVH");
+
+    for (auto leaf : dirty_leaves)
+    {
+        if (leaf == kInvalid) continue;
+        nodes[leaf].dirty = false;
+        refit_from(nodes[leaf].parent);
+    }
+    dirty_leaves.clear();
+}
+
+void BoundsBVH::emit_subtree(uint32_t node, uint32_t* visibility) SKR_NOEXCEPT
+{
+    const auto base = stack.size();
+    stack.emplace_back(node, 0u);
+    while (stack.size() > base)
+    {
+        const auto current = stack.back().first;
+        stack.pop_back();
+        const auto& n = nodes[current];
+        if (n.is_leaf())
+        {
+            visibility[n.user / 32] |= 1u << (n.user % 32);
+            continue;
+        }
+        stack.emplace_back(n.left, 0u);
+        stack.emplace_back(n.right, 0u);
+    }
+}
+
+void BoundsBVH::cull(const Frustum& frustum, uint32_t* visibility) SKR_NOEXCEPT
+{
+    ZoneScopedN("CullBoundsBVH");
+
+    if (root == kInvalid) return;
+    static constexpr uint32_t kAllPlanes = (1u << 6) - 1;
+    stack.clear();
+    stack.emplace_back(root, kAllPlanes);
+    while (!stack.empty())
+    {
+        const auto [current, straddled] = stack.back();
+        stack.pop_back();
+        const auto& n = nodes[current];
+        const skr_float3_t center = { (n.lo.x + n.hi.x) * .5f, (n.lo.y + n.hi.y) * .5f, (n.lo.z + n.hi.z) * .5f };
+        const skr_float3_t extent = { (n.hi.x - n.lo.x) * .5f, (n.hi.y - n.lo.y) * .5f, (n.hi.z - n.lo.z) * .5f };
+        // planes the parent was completely inside of are not tested again
+        uint32_t planes = straddled;
+        bool outside = false;
+        for (uint32_t p = 0; p < 6 && !outside; p++)
+        {
+            if (!(planes & (1u << p))) continue;
+            const auto& plane = frustum.planes[p];
+            const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            const float radius = fabsf(plane.x) * extent.x + fabsf(plane.y) * extent.y + fabsf(plane.z) * extent.z;
+            outside = (distance + radius < 0.f);
+            if (distance - radius >= 0.f) planes &= ~(1u << p);
+        }
+        if (outside) continue;
+        if (!planes)
+        {
+            emit_subtree(current, visibility);
+            continue;
+        }
+        if (n.is_leaf())
+        {
+            visibility[n.user / 32] |= 1u << (n.user % 32);
+            continue;
+        }
+        stack.emplace_back(n.left, planes);
+        stack.emplace_back(n.right, planes);
+    }
+}
+} // namespace renderer
+} // namespace skr
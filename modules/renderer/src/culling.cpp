@@ -0,0 +1,110 @@
+#include "SkrRenderer/culling.hpp"
+#include "platform/configure.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(SKR_PLATFORM_X86_64)
+    #include "platform/cpu/isa.h"
+    #include "simd/culling_avx2.hpp"
+    #include <emmintrin.h>
+    #define SKR_CULLING_AVX2
+    #define SKR_CULLING_SSE
+#elif defined(SKR_PLATFORM_X86)
+    #include <emmintrin.h>
+    #define SKR_CULLING_SSE
+#endif
+
+#include "tracy/Tracy.hpp"
+
+namespace skr
+{
+namespace renderer
+{
+Frustum Frustum::from_view_projection(const skr_float4x4_t& view_projection) SKR_NOEXCEPT
+{
+    // with row vectors clip = p * M, so every clip coordinate is a column of M dotted with (p, 1)
+    const auto& M = view_projection.M;
+    const auto column = [&](uint32_t c) { return skr_float4_t{ M[0][c], M[1][c], M[2][c], M[3][c] }; };
+    const auto add = [](const skr_float4_t& a, const skr_float4_t& b) { return skr_float4_t{ a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; };
+    const auto sub = [](const skr_float4_t& a, const skr_float4_t& b) { return skr_float4_t{ a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; };
+    const auto x = column(0), y = column(1), z = column(2), w = column(3);
+
+    Frustum frustum;
+    frustum.planes[0] = add(w, x); // left
+    frustum.planes[1] = sub(w, x); // right
+    frustum.planes[2] = add(w, y); // bottom
+    frustum.planes[3] = sub(w, y); // top
+    frustum.planes[4] = z;         // near, depth starts at 0
+    frustum.planes[5] = sub(w, z); // far
+    for (auto& plane : frustum.planes)
+    {
+        const float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        const float inv = length > 0.f ? 1.f / length : 0.f;
+        plane = { plane.x * inv, plane.y * inv, plane.z * inv, plane.w * inv };
+    }
+    return frustum;
+}
+
+// a box is outside when its corner farthest along a plane normal is still behind the plane
+static inline bool IsBoxVisible(const Frustum& frustum, const skr_world_bounds_comp_t& box)
+{
+    for (const auto& plane : frustum.planes)
+    {
+        // same order of operations as the SIMD kernels, so every path agrees on boxes touching a plane
+        float d = plane.x * box.center.x + plane.w;
+        d += plane.y * box.center.y;
+        d += plane.z * box.center.z;
+        d += fabsf(plane.x) * box.extent.x;
+        d += fabsf(plane.y) * box.extent.y;
+        d += fabsf(plane.z) * box.extent.z;
+        if (d < 0.f) return false;
+    }
+    return true;
+}
+
+void cull_world_bounds(const Frustum& frustum, const skr_world_bounds_comp_t* bounds, uint32_t count, uint32_t* visibility) SKR_NOEXCEPT
+{
+    ZoneScopedN("CullWorldBounds");
+
+    static_assert(sizeof(skr_world_bounds_comp_t) == 6 * sizeof(float), "boxes are read as 6 packed floats");
+    static_assert(sizeof(Frustum) == 24 * sizeof(float), "planes are read as 24 packed floats");
+    memset(visibility, 0, visibility_words(count) * sizeof(uint32_t));
+    uint32_t i = 0;
+#if defined(SKR_CULLING_AVX2)
+    static const bool avx2 = skr_cpu_has_avx2();
+    if (avx2) i = cull_boxes_avx2(&frustum.planes[0].x, &bounds->center.x, count, visibility);
+#endif
+#if defined(SKR_CULLING_SSE)
+    const __m128 sign_mask = _mm_set1_ps(-0.f);
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto* boxes = bounds + i;
+        const __m128 cx = _mm_setr_ps(boxes[0].center.x, boxes[1].center.x, boxes[2].center.x, boxes[3].center.x);
+        const __m128 cy = _mm_setr_ps(boxes[0].center.y, boxes[1].center.y, boxes[2].center.y, boxes[3].center.y);
+        const __m128 cz = _mm_setr_ps(boxes[0].center.z, boxes[1].center.z, boxes[2].center.z, boxes[3].center.z);
+        const __m128 ex = _mm_setr_ps(boxes[0].extent.x, boxes[1].extent.x, boxes[2].extent.x, boxes[3].extent.x);
+        const __m128 ey = _mm_setr_ps(boxes[0].extent.y, boxes[1].extent.y, boxes[2].extent.y, boxes[3].extent.y);
+        const __m128 ez = _mm_setr_ps(boxes[0].extent.z, boxes[1].extent.z, boxes[2].extent.z, boxes[3].extent.z);
+        __m128 outside = _mm_setzero_ps();
+        for (const auto& plane : frustum.planes)
+        {
+            const __m128 nx = _mm_set1_ps(plane.x), ny = _mm_set1_ps(plane.y), nz = _mm_set1_ps(plane.z);
+            __m128 d = _mm_add_ps(_mm_mul_ps(nx, cx), _mm_set1_ps(plane.w));
+            d = _mm_add_ps(d, _mm_mul_ps(ny, cy));
+            d = _mm_add_ps(d, _mm_mul_ps(nz, cz));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_andnot_ps(sign_mask, nx), ex));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_andnot_ps(sign_mask, ny), ey));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_andnot_ps(sign_mask, nz), ez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, _mm_setzero_ps()));
+        }
+        const uint32_t visible = ~(uint32_t)_mm_movemask_ps(outside) & 0xFu;
+        visibility[i / 32] |= visible << (i % 32);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        if (IsBoxVisible(frustum, bounds[i])) visibility[i / 32] |= 1u << (i % 32);
+    }
+}
+} // namespace renderer
+} // namespace skr
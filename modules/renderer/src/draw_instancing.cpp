@@ -0,0 +1,206 @@
+#include "SkrRenderer/draw_instancing.hpp"
+#include "utils/make_zeroed.hpp"
+#include "utils/hash.h"
+#include "platform/debug.h"
+#include <string.h>
+
+#include "tracy/Tracy.hpp"
+
+namespace skr
+{
+namespace renderer
+{
+static constexpr uint32_t kNoGroup = UINT32_MAX;
+// runs of payloads start aligned so any vertex fetch of the payloads is
+static constexpr uint64_t kInstanceRunAlignment = 16;
+static constexpr uint64_t kMinInstanceBufferSize = 64 * 1024;
+
+static inline uint64_t AlignUp(uint64_t value, uint64_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+static uint64_t HashInstancedDraw(const skr_primitive_draw_t& draw)
+{
+    struct {
+        CGPURenderPipelineId pipeline;
+        CGPUXBindTableId bind_table;
+        const char8_t* push_const_name;
+        const uint8_t* push_const;
+        skr_index_buffer_view_t index_buffer;
+        uint32_t vertex_buffer_count;
+        uint32_t instance_data_size;
+    } state = {};
+    state.pipeline = draw.pipeline;
+    state.bind_table = draw.bind_table;
+    state.push_const_name = draw.push_const_name;
+    state.push_const = draw.push_const;
+    state.index_buffer = draw.index_buffer;
+    state.vertex_buffer_count = draw.vertex_buffer_count;
+    state.instance_data_size = draw.instance_data_size;
+    const auto hash = skr_hash64(&state, sizeof(state), CGPU_NAME_HASH_SEED);
+    return skr_hash64(draw.vertex_buffers, draw.vertex_buffer_count * sizeof(skr_vertex_buffer_view_t), hash);
+}
+
+static inline bool HasPayload(const skr_primitive_draw_t& draw)
+{
+    return draw.instance_data && draw.instance_data_size && !draw.desperated;
+}
+
+static bool IsInstanceCompatible(const skr_primitive_draw_t& a, const skr_primitive_draw_t& b)
+{
+    return a.pipeline == b.pipeline && a.bind_table == b.bind_table &&
+           a.push_const_name == b.push_const_name && a.push_const == b.push_const &&
+           a.instance_data_size == b.instance_data_size &&
+           !memcmp(&a.index_buffer, &b.index_buffer, sizeof(skr_index_buffer_view_t)) &&
+           a.vertex_buffer_count == b.vertex_buffer_count &&
+           (a.vertex_buffers == b.vertex_buffers || !memcmp(a.vertex_buffers, b.vertex_buffers, a.vertex_buffer_count * sizeof(skr_vertex_buffer_view_t)));
+}
+
+void DrawInstancer::initialize(CGPUDeviceId device_, uint32_t frame_count) SKR_NOEXCEPT
+{
+    SKR_ASSERT(frame_count && "at least one frame is needed");
+    device = device_;
+    frames.resize(frame_count);
+    frame_index = 0;
+}
+
+void DrawInstancer::finalize() SKR_NOEXCEPT
+{
+    for (auto& frame : frames)
+    {
+        if (frame.buffer) cgpu_free_buffer(frame.buffer);
+    }
+    frames.clear();
+}
+
+bool DrawInstancer::has_payloads(skr::span<skr_primitive_draw_list_view_t* const> lists) SKR_NOEXCEPT
+{
+    for (auto list : lists)
+    {
+        for (uint32_t i = 0; i < list->count; i++)
+        {
+            if (HasPayload(list->drawcalls[i])) return true;
+        }
+    }
+    return false;
+}
+
+void DrawInstancer::begin_frame(uint64_t frame_index_) SKR_NOEXCEPT
+{
+    frame_index = (uint32_t)(frame_index_ % frames.size());
+}
+
+void DrawInstancer::reserve(uint64_t size) SKR_NOEXCEPT
+{
+    auto& frame = frames[frame_index];
+    if (frame.capacity >= size) return;
+    // the frame that used the buffer last is done with it, begin_frame asks for that
+    if (frame.buffer) cgpu_free_buffer(frame.buffer);
+    const auto capacity = eastl::max(eastl::max(size, frame.capacity * 2), kMinInstanceBufferSize);
+    auto buffer_desc = make_zeroed<CGPUBufferDescriptor>();
+    buffer_desc.name = u8"InstanceDataBuffer";
+    buffer_desc.flags = CGPU_BCF_PERSISTENT_MAP_BIT;
+    buffer_desc.descriptors = CGPU_RESOURCE_TYPE_VERTEX_BUFFER;
+    buffer_desc.memory_usage = CGPU_MEM_USAGE_CPU_TO_GPU;
+    buffer_desc.size = capacity;
+    frame.buffer = cgpu_create_buffer(device, &buffer_desc);
+    frame.capacity = capacity;
+    SKR_ASSERT(frame.buffer->cpu_mapped_address && "instance data buffer must be mapped");
+}
+
+uint64_t DrawInstancer::pack(skr_primitive_draw_list_view_t& list, uint64_t cursor, uint32_t& merged) SKR_NOEXCEPT
+{
+    // group the draws, a hash collision between incompatible draws just leaves the later one alone
+    group_of.clear();
+    groups.clear();
+    draw_groups.resize(list.count);
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        const auto& draw = list.drawcalls[i];
+        draw_groups[i] = kNoGroup;
+        if (!HasPayload(draw)) continue;
+        const auto hash = HashInstancedDraw(draw);
+        auto found = group_of.find(hash);
+        if (found != group_of.end() && IsInstanceCompatible(list.drawcalls[groups[found->second].first], draw))
+        {
+            groups[found->second].count++;
+            draw_groups[i] = found->second;
+            continue;
+        }
+        if (found == group_of.end()) group_of.emplace(hash, (uint32_t)groups.size());
+        draw_groups[i] = (uint32_t)groups.size();
+        groups.push_back({ i, 1, 0, 0 });
+    }
+    if (groups.empty()) return cursor;
+
+    // lay the runs out and copy the payloads in draw order
+    const auto buffer = frames[frame_index].buffer;
+    uint8_t* mapped = (uint8_t*)buffer->cpu_mapped_address;
+    for (auto& group : groups)
+    {
+        group.offset = AlignUp(cursor, kInstanceRunAlignment);
+        cursor = group.offset + (uint64_t)group.count * list.drawcalls[group.first].instance_data_size;
+    }
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        if (draw_groups[i] == kNoGroup) continue;
+        const auto& draw = list.drawcalls[i];
+        auto& group = groups[draw_groups[i]];
+        memcpy(mapped + group.offset + (uint64_t)group.written * draw.instance_data_size, draw.instance_data, draw.instance_data_size);
+        group.written++;
+    }
+
+    // the merged draw takes the slot of the first draw of its group
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        const auto group_index = draw_groups[i];
+        if (group_index == kNoGroup)
+        {
+            list.drawcalls[kept++] = list.drawcalls[i];
+            continue;
+        }
+        const auto& group = groups[group_index];
+        if (group.first != i)
+        {
+            merged++;
+            continue;
+        }
+        auto draw = list.drawcalls[i];
+        draw.instance_count = group.count;
+        draw.instance_buffer.buffer = buffer;
+        draw.instance_buffer.offset = (uint32_t)group.offset;
+        draw.instance_buffer.stride = draw.instance_data_size;
+        list.drawcalls[kept++] = draw;
+    }
+    list.count = kept;
+    return cursor;
+}
+
+uint32_t DrawInstancer::coalesce(skr::span<skr_primitive_draw_list_view_t* const> lists) SKR_NOEXCEPT
+{
+    ZoneScopedN("CoalesceInstances");
+
+    // the buffer of a frame only grows between lists, so it is sized for the worst case up front
+    uint64_t bound = 0;
+    for (auto list : lists)
+    {
+        for (uint32_t i = 0; i < list->count; i++)
+        {
+            const auto& draw = list->drawcalls[i];
+            if (HasPayload(draw))
+                bound += AlignUp(draw.instance_data_size, kInstanceRunAlignment);
+        }
+    }
+    if (!bound) return 0;
+    reserve(bound);
+
+    uint32_t merged = 0;
+    uint64_t cursor = 0;
+    for (auto list : lists)
+    {
+        cursor = pack(*list, cursor, merged);
+    }
+    SKR_ASSERT(cursor <= frames[frame_index].capacity);
+    return merged;
+}
+} // namespace renderer
+} // namespace skr
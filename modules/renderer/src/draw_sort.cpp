@@ -0,0 +1,72 @@
+#include "SkrRenderer/draw_sort.hpp"
+#include <string.h>
+
+#include "tracy/Tracy.hpp"
+
+namespace skr
+{
+namespace renderer
+{
+static constexpr uint32_t kRadixBits = 8;
+static constexpr uint32_t kRadixSize = 1u << kRadixBits;
+static constexpr uint32_t kRadixPasses = 64 / kRadixBits;
+
+bool DrawListSorter::sort(skr_primitive_draw_list_view_t& list) SKR_NOEXCEPT
+{
+    if (list.count < 2) return true;
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        if (!list.drawcalls[i].sort_key) return false;
+    }
+
+    ZoneScopedN("SortDrawList");
+
+    // histograms of every digit in one sweep
+    uint32_t histograms[kRadixPasses][kRadixSize] = {};
+    entries.resize(list.count);
+    swap_entries.resize(list.count);
+    bool sorted = true;
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        const auto key = list.drawcalls[i].sort_key;
+        entries[i] = { key, i };
+        sorted &= (i == 0) || (entries[i - 1].key <= key);
+        for (uint32_t pass = 0; pass < kRadixPasses; pass++)
+        {
+            histograms[pass][(key >> (pass * kRadixBits)) & (kRadixSize - 1)]++;
+        }
+    }
+    if (sorted) return true;
+
+    Entry* src = entries.data();
+    Entry* dst = swap_entries.data();
+    for (uint32_t pass = 0; pass < kRadixPasses; pass++)
+    {
+        auto& histogram = histograms[pass];
+        const uint32_t shift = pass * kRadixBits;
+        // all draws fall into one bucket, the pass would not move anything
+        if (histogram[(src[0].key >> shift) & (kRadixSize - 1)] == list.count) continue;
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < kRadixSize; digit++)
+        {
+            const auto count = histogram[digit];
+            histogram[digit] = offset;
+            offset += count;
+        }
+        for (uint32_t i = 0; i < list.count; i++)
+        {
+            dst[histogram[(src[i].key >> shift) & (kRadixSize - 1)]++] = src[i];
+        }
+        eastl::swap(src, dst);
+    }
+
+    // permute the draws through a copy, they are small and copying beats following cycles
+    draws.assign(list.drawcalls, list.drawcalls + list.count);
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        list.drawcalls[i] = draws[src[i].index];
+    }
+    return true;
+}
+} // namespace renderer
+} // namespace skr
@@ -2,6 +2,7 @@
 #include "SkrRenderer/pso_map.h"
 #include "SkrRenderer/render_device.h"
 #include "platform/atomic.h"
+#include "platform/vfs.h"
 #include "containers/hashmap.hpp"
 #include "containers/vector.hpp"
 #include "containers/sptr.hpp"
@@ -9,6 +10,10 @@
 #include "utils/format.hpp"
 #include "utils/make_zeroed.hpp"
 #include "utils/threaded_service.h"
+#include "task/task.hpp"
+#include <EASTL/sort.h>
+#include <stddef.h>
+#include <string.h>
 
 #include "tracy/Tracy.hpp"
 
@@ -42,41 +47,62 @@ struct skr_pso_map_key_t
     SAtomicU32 pso_rc = 0;
     SAtomicU32 pso_status = SKR_PSO_MAP_PSO_STATUS_UNINSTALLED;
     CGPURenderPipelineId pso = nullptr;
+
+    // shader map identity of the stages, only keys that have it are recorded in the manifest
+    skr_pso_map_shader_t shaders[CGPU_SHADER_STAGE_COUNT];
+    uint32_t shader_count = 0;
+    uint32_t manifest_index = UINT32_MAX;
+
+    // entry names of the stages in descriptor order, the key outlives the strings it is created from
+    char8_t entries[CGPU_SHADER_STAGE_COUNT][sizeof(skr_pso_map_shader_t::entry)];
 };
 
+static void PSOMapCopyEntry(CGPUShaderEntryDescriptor& shader, char8_t* storage, size_t size)
+{
+    if (!shader.entry) return;
+    SKR_ASSERT(strlen((const char*)shader.entry) < size && "entry name too long for the pso map!");
+    strncpy((char*)storage, (const char*)shader.entry, size - 1);
+    shader.entry = storage;
+}
+
 skr_pso_map_key_t::skr_pso_map_key_t(const CGPURenderPipelineDescriptor& desc, uint64_t frame) SKR_NOEXCEPT
     : root_signature(desc.root_signature->pool_sig ? desc.root_signature->pool_sig : desc.root_signature), 
-    frame(frame), rc(0), pso_rc(0)
+    frame(frame), rc(1), pso_rc(0) // the creator holds the first reference, free_key releases it
 {
     descriptor.root_signature = root_signature;
     if (desc.vertex_shader)
     {
         vertex_shader = *desc.vertex_shader;
         vertex_specializations = skr::vector<CGPUConstantSpecialization>(desc.vertex_shader->constants, desc.vertex_shader->constants + desc.vertex_shader->num_constants);
+        PSOMapCopyEntry(vertex_shader, entries[0], sizeof(entries[0]));
         descriptor.vertex_shader = &vertex_shader;
     }
     if (desc.tesc_shader)
     {
         tesc_shader = *desc.tesc_shader;
         tesc_specializations = skr::vector<CGPUConstantSpecialization>(desc.tesc_shader->constants, desc.tesc_shader->constants + desc.tesc_shader->num_constants);
+        PSOMapCopyEntry(tesc_shader, entries[1], sizeof(entries[1]));
         descriptor.tesc_shader = &tesc_shader;
     }
     if (desc.tese_shader)
     {
         tese_shader = *desc.tese_shader;
         tese_specializations = skr::vector<CGPUConstantSpecialization>(desc.tese_shader->constants, desc.tese_shader->constants + desc.tese_shader->num_constants);
+        PSOMapCopyEntry(tese_shader, entries[2], sizeof(entries[2]));
         descriptor.tese_shader = &tese_shader;
     }
     if (desc.geom_shader)
     {
         geom_shader = *desc.geom_shader;
         geom_specializations = skr::vector<CGPUConstantSpecialization>(desc.geom_shader->constants, desc.geom_shader->constants + desc.geom_shader->num_constants);
+        PSOMapCopyEntry(geom_shader, entries[3], sizeof(entries[3]));
         descriptor.geom_shader = &geom_shader;
     }
     if (desc.fragment_shader)
     {
         fragment_shader = *desc.fragment_shader;
         fragment_specializations = skr::vector<CGPUConstantSpecialization>(desc.fragment_shader->constants, desc.fragment_shader->constants + desc.fragment_shader->num_constants);
+        PSOMapCopyEntry(fragment_shader, entries[4], sizeof(entries[4]));
         descriptor.fragment_shader = &fragment_shader;
     }
     if (desc.vertex_layout) vertex_layout = *desc.vertex_layout;
@@ -114,6 +140,99 @@ skr_pso_map_key_t::~skr_pso_map_key_t() SKR_NOEXCEPT
     root_signature = nullptr;
 }
 
+// entries are the same pso when they match up to their usage counters
+static constexpr size_t kPSOManifestIdentitySize = offsetof(skr_pso_map_manifest_entry_t, first_use);
+static constexpr uint32_t kPSOManifestMagic = 0x4D4F5350; // "PSOM"
+static constexpr uint32_t kPSOManifestVersion = 1;
+
+struct PSOManifestHeader {
+    uint32_t magic;
+    uint32_t version;
+    // entries change size with the cgpu limits they are made of
+    uint32_t entry_size;
+    uint32_t entry_count;
+};
+
+static const CGPUShaderEntryDescriptor* PSOMapStageEntry(const CGPURenderPipelineDescriptor& desc, ECGPUShaderStage stage)
+{
+    switch (stage)
+    {
+    case CGPU_SHADER_STAGE_VERT: return desc.vertex_shader;
+    case CGPU_SHADER_STAGE_TESC: return desc.tesc_shader;
+    case CGPU_SHADER_STAGE_TESE: return desc.tese_shader;
+    case CGPU_SHADER_STAGE_GEOM: return desc.geom_shader;
+    case CGPU_SHADER_STAGE_FRAG: return desc.fragment_shader;
+    default: return nullptr;
+    }
+}
+
+static bool PSOManifestWarmupOrder(const skr_pso_map_manifest_entry_t& a, const skr_pso_map_manifest_entry_t& b)
+{
+    if (a.first_use != b.first_use) return a.first_use < b.first_use;
+    return a.use_count > b.use_count;
+}
+
+static void PSOManifestFillEntry(const skr_pso_map_key_t& key, skr_pso_map_manifest_entry_t& entry)
+{
+    entry = make_zeroed<skr_pso_map_manifest_entry_t>();
+    entry.shader_count = key.shader_count;
+    memcpy(entry.shaders, key.shaders, sizeof(key.shaders));
+    entry.vertex_layout = key.vertex_layout;
+    entry.blend_state = key.blend_state;
+    entry.depth_state = key.depth_state;
+    entry.rasterizer_state = key.rasterizer_state;
+    memcpy(entry.color_formats, key.color_formats, sizeof(key.color_formats));
+    entry.render_target_count = key.descriptor.render_target_count;
+    entry.sample_count = key.descriptor.sample_count;
+    entry.sample_quality = key.descriptor.sample_quality;
+    entry.color_resolve_disable_mask = key.descriptor.color_resolve_disable_mask;
+    entry.depth_stencil_format = key.descriptor.depth_stencil_format;
+    entry.prim_topology = key.descriptor.prim_topology;
+    entry.enable_indirect_command = key.descriptor.enable_indirect_command;
+}
+
+// pipeline descriptor of a manifest entry once its shaders and root signature are resolved
+struct PSOManifestDescriptor {
+    PSOManifestDescriptor(const skr_pso_map_manifest_entry_t& entry, const CGPUShaderLibraryId* libraries, CGPURootSignatureId root_signature)
+    {
+        desc = make_zeroed<CGPURenderPipelineDescriptor>();
+        desc.root_signature = root_signature;
+        for (uint32_t i = 0; i < entry.shader_count; i++)
+        {
+            const auto stage = (ECGPUShaderStage)entry.shaders[i].identifier.shader_stage;
+            auto& shader = shaders[i];
+            shader = make_zeroed<CGPUShaderEntryDescriptor>();
+            shader.library = libraries[i];
+            shader.entry = entry.shaders[i].entry;
+            shader.stage = stage;
+            switch (stage)
+            {
+            case CGPU_SHADER_STAGE_VERT: desc.vertex_shader = &shader; break;
+            case CGPU_SHADER_STAGE_TESC: desc.tesc_shader = &shader; break;
+            case CGPU_SHADER_STAGE_TESE: desc.tese_shader = &shader; break;
+            case CGPU_SHADER_STAGE_GEOM: desc.geom_shader = &shader; break;
+            case CGPU_SHADER_STAGE_FRAG: desc.fragment_shader = &shader; break;
+            default: SKR_ASSERT(false && "wrong shader stage"); break;
+            }
+        }
+        desc.vertex_layout = &entry.vertex_layout;
+        desc.blend_state = &entry.blend_state;
+        desc.depth_state = &entry.depth_state;
+        desc.rasterizer_state = &entry.rasterizer_state;
+        desc.color_formats = entry.color_formats;
+        desc.render_target_count = entry.render_target_count;
+        desc.sample_count = entry.sample_count;
+        desc.sample_quality = entry.sample_quality;
+        desc.color_resolve_disable_mask = entry.color_resolve_disable_mask;
+        desc.depth_stencil_format = entry.depth_stencil_format;
+        desc.prim_topology = entry.prim_topology;
+        desc.enable_indirect_command = entry.enable_indirect_command;
+    }
+
+    CGPUShaderEntryDescriptor shaders[CGPU_SHADER_STAGE_COUNT];
+    CGPURenderPipelineDescriptor desc;
+};
+
 namespace skr
 {
 struct PSOMapImpl : public skr_pso_map_t
@@ -126,6 +245,7 @@ struct PSOMapImpl : public skr_pso_map_t
 
     ~PSOMapImpl()
     {
+        end_warmup();
         for (auto& it : sets)
         {
             cgpu_free_render_pipeline(it->pso);
@@ -162,16 +282,16 @@ struct PSOMapImpl : public skr_pso_map_t
         }
     };
 
-    virtual skr_pso_map_key_id create_key(const struct CGPURenderPipelineDescriptor* desc) SKR_NOEXCEPT override
+    virtual skr_pso_map_key_id create_key(const struct CGPURenderPipelineDescriptor* desc, const skr_platform_shader_identifier_t* shaders, uint32_t shader_count) SKR_NOEXCEPT override
     {
         SKR_ASSERT(desc && "NULL descriptor not allowed!");
+        skr_pso_map_key_id result = nullptr;
         auto found = sets.find(*desc);
         if (found != sets.end())
         {
-            skr_pso_map_key_id result = found->get();
+            result = found->get();
             skr_atomicu32_add_relaxed(&result->rc, 1);
             result->frame = frame_index;
-            return result;
         }
         else
         {
@@ -184,8 +304,34 @@ struct PSOMapImpl : public skr_pso_map_t
                 SKR_ASSERT(0 && "Failed to insert key!");
                 return nullptr;
             }
-            return key.get();
+            result = key.get();
+        }
+        if (shaders && !result->shader_count)
+        {
+            set_key_shaders(result, *desc, shaders, shader_count);
+        }
+        return result;
+    }
+
+    void set_key_shaders(skr_pso_map_key_id key, const CGPURenderPipelineDescriptor& desc, const skr_platform_shader_identifier_t* shaders, uint32_t shader_count) SKR_NOEXCEPT
+    {
+        SKR_ASSERT(shader_count <= CGPU_SHADER_STAGE_COUNT);
+        memset((void*)key->shaders, 0, sizeof(key->shaders));
+        for (uint32_t i = 0; i < shader_count; i++)
+        {
+            // fields one by one, manifest entries are compared bytewise
+            auto& shader = key->shaders[i];
+            shader.identifier.bytecode_type = shaders[i].bytecode_type;
+            shader.identifier.shader_stage = shaders[i].shader_stage;
+            shader.identifier.hash = shaders[i].hash;
+            const auto stage = PSOMapStageEntry(desc, shaders[i].shader_stage);
+            if (stage && stage->entry)
+            {
+                SKR_ASSERT(strlen((const char*)stage->entry) < sizeof(shader.entry) && "entry name too long for the manifest!");
+                strncpy((char*)shader.entry, (const char*)stage->entry, sizeof(shader.entry) - 1);
+            }
         }
+        key->shader_count = shader_count;
     }
 
     virtual void free_key(skr_pso_map_key_id key) SKR_NOEXCEPT override
@@ -256,10 +402,12 @@ struct PSOMapImpl : public skr_pso_map_t
             key->pso = cgpu_create_render_pipeline(root.device, &key->descriptor);
             if (key->pso)
             {
+                skr_atomicu32_store_relaxed(&key->pso_status, SKR_PSO_MAP_PSO_STATUS_INSTALLED);
                 skr_atomicu64_store_relaxed(&key->pso_frame, frame_index); // store frame index to indicate pso is created
             }
             else
             {
+                skr_atomicu32_store_relaxed(&key->pso_status, SKR_PSO_MAP_PSO_STATUS_FAILED);
                 skr_atomicu64_store_relaxed(&key->pso_frame, UINT64_MAX); // store frame index to indicate pso is failed
             }
             return key->pso ? SKR_PSO_MAP_PSO_STATUS_INSTALLED : SKR_PSO_MAP_PSO_STATUS_FAILED;
@@ -269,6 +417,7 @@ struct PSOMapImpl : public skr_pso_map_t
     virtual ESkrPSOMapPSOStatus install_pso(skr_pso_map_key_id key) SKR_NOEXCEPT override
     {
         if (!key) return SKR_PSO_MAP_PSO_STATUS_FAILED;
+        record_usage(key);
         
         auto found = sets.find(key->descriptor);
         const auto pso_rc = skr_atomicu32_load_relaxed(&key->pso_rc);
@@ -322,7 +471,8 @@ struct PSOMapImpl : public skr_pso_map_t
     {
         if (!key) return nullptr;
 
-        const auto pso_status = skr_atomicu32_load_relaxed(&key->pso_status);
+        // pairs with the release store of the warm up job that publishes key->pso
+        const auto pso_status = skr_atomicu32_load_acquire(&key->pso_status);
         if (pso_status == SKR_PSO_MAP_PSO_STATUS_INSTALLED)
         {
             // clearFinishedRequests();
@@ -370,7 +520,8 @@ struct PSOMapImpl : public skr_pso_map_t
             auto key = it->get();
             if (skr_atomicu32_load_relaxed(&key->rc) == 0 && skr_atomicu64_load_relaxed(&key->frame) < critical_frame)
             {
-                if (mRequests.find(key) != mRequests.end())
+                const auto pso_status = skr_atomicu32_load_relaxed(&key->pso_status);
+                if (mRequests.find(key) != mRequests.end() || pso_status == SKR_PSO_MAP_PSO_STATUS_REQUESTED)
                 {
                     // pso is still creating, skip & wait for it to finish
                     // TODO: cancel pso creation
@@ -378,6 +529,7 @@ struct PSOMapImpl : public skr_pso_map_t
                 }
                 else
                 {
+                    if (key->pso) cgpu_free_render_pipeline(key->pso);
                     it = sets.erase(it); // free key
                 }
             }
@@ -391,11 +543,211 @@ struct PSOMapImpl : public skr_pso_map_t
         clearFinishedRequests();
     }
 
+    void record_usage(skr_pso_map_key_id key) SKR_NOEXCEPT
+    {
+        if (!key->shader_count) return;
+        if (key->manifest_index == UINT32_MAX)
+        {
+            key->manifest_index = (uint32_t)manifest.size();
+            auto& entry = manifest.emplace_back();
+            PSOManifestFillEntry(*key, entry);
+            entry.first_use = key->manifest_index;
+            entry.use_count = 1;
+        }
+        else
+        {
+            manifest[key->manifest_index].use_count++;
+        }
+    }
+
+    virtual uint32_t get_manifest(skr_pso_map_manifest_entry_t* entries, uint32_t capacity) SKR_NOEXCEPT override
+    {
+        // the same pso may be recorded by several keys, e.g. after its shaders were reloaded
+        skr::vector<skr_pso_map_manifest_entry_t> sorted = manifest;
+        eastl::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+            const auto order = memcmp(&a, &b, kPSOManifestIdentitySize);
+            return order ? order < 0 : a.first_use < b.first_use;
+        });
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < sorted.size(); i++)
+        {
+            if (count && !memcmp(&sorted[count - 1], &sorted[i], kPSOManifestIdentitySize))
+                sorted[count - 1].use_count += sorted[i].use_count;
+            else
+                sorted[count++] = sorted[i];
+        }
+        sorted.resize(count);
+        eastl::stable_sort(sorted.begin(), sorted.end(), &PSOManifestWarmupOrder);
+        if (entries)
+        {
+            count = (capacity < count) ? capacity : count;
+            memcpy(entries, sorted.data(), count * sizeof(skr_pso_map_manifest_entry_t));
+        }
+        return count;
+    }
+
+    virtual void clear_manifest() SKR_NOEXCEPT override
+    {
+        manifest.clear();
+        for (auto& key : sets)
+        {
+            key->manifest_index = UINT32_MAX;
+        }
+    }
+
+    virtual void begin_warmup(const skr_pso_map_warmup_desc_t* desc) SKR_NOEXCEPT override
+    {
+        SKR_ASSERT(desc && desc->resolve && "warm up needs a resolver!");
+        end_warmup();
+        ZoneScopedN("BeginPSOWarmup");
+        warmup.entries.assign(desc->entries, desc->entries + desc->entry_count);
+        eastl::stable_sort(warmup.entries.begin(), warmup.entries.end(), &PSOManifestWarmupOrder);
+        warmup.waiting.resize(desc->entry_count);
+        for (uint32_t i = 0; i < desc->entry_count; i++)
+        {
+            warmup.waiting[i] = i;
+        }
+        warmup.resolve = desc->resolve;
+        warmup.usrdata = desc->usrdata;
+        warmup.max_jobs = desc->max_jobs;
+        skr_atomicu32_store_relaxed(&warmup.compiled, 0);
+        skr_atomicu32_store_relaxed(&warmup.failed, 0);
+        skr_atomicu32_store_relaxed(&warmup.in_flight, 0);
+        warming_up = true;
+    }
+
+    virtual bool update_warmup(skr_pso_map_warmup_progress_t* progress) SKR_NOEXCEPT override
+    {
+        ZoneScopedN("UpdatePSOWarmup");
+        // entries are resolved in warm up order, the ones whose shaders are still loading keep their place
+        uint32_t waiting = 0;
+        for (uint32_t i = 0; i < warmup.waiting.size(); i++)
+        {
+            const auto index = warmup.waiting[i];
+            const auto in_flight = skr_atomicu32_load_relaxed(&warmup.in_flight);
+            if (warmup.max_jobs && in_flight >= warmup.max_jobs)
+            {
+                warmup.waiting[waiting++] = index;
+                continue;
+            }
+            const auto& entry = warmup.entries[index];
+            CGPUShaderLibraryId libraries[CGPU_SHADER_STAGE_COUNT] = {};
+            CGPURootSignatureId root_signature = nullptr;
+            const auto status = warmup.resolve(warmup.usrdata, &entry, libraries, &root_signature);
+            if (status == SKR_PSO_MAP_PSO_STATUS_REQUESTED)
+            {
+                warmup.waiting[waiting++] = index;
+                continue;
+            }
+            const PSOManifestDescriptor manifest_desc(entry, libraries, root_signature);
+            const auto key = (status == SKR_PSO_MAP_PSO_STATUS_INSTALLED && root_signature) ? create_key(&manifest_desc.desc, nullptr, 0) : nullptr;
+            if (!key)
+            {
+                skr_atomicu32_add_relaxed(&warmup.failed, 1);
+                continue;
+            }
+            // a material may have asked for the pso already
+            if (skr_atomicu32_load_relaxed(&key->pso_status) != SKR_PSO_MAP_PSO_STATUS_UNINSTALLED)
+            {
+                skr_atomicu32_add_relaxed(&warmup.compiled, 1);
+                free_key(key);
+                continue;
+            }
+            dispatch_warmup(key);
+            warmup.keys.emplace_back(key);
+        }
+        warmup.waiting.resize(waiting);
+        release_warmup_keys(false);
+
+        const auto in_flight = skr_atomicu32_load_relaxed(&warmup.in_flight);
+        if (progress)
+        {
+            progress->total = (uint32_t)warmup.entries.size();
+            progress->compiled = skr_atomicu32_load_relaxed(&warmup.compiled);
+            progress->failed = skr_atomicu32_load_relaxed(&warmup.failed);
+            progress->in_flight = in_flight;
+        }
+        return warmup.waiting.empty() && !in_flight;
+    }
+
+    void dispatch_warmup(skr_pso_map_key_id key) SKR_NOEXCEPT
+    {
+        // runtime installs of the key wait for the job instead of creating the pso again
+        skr_atomicu32_store_relaxed(&key->pso_status, SKR_PSO_MAP_PSO_STATUS_REQUESTED);
+        skr_atomicu32_add_relaxed(&warmup.in_flight, 1);
+        warmup.counter.add(1);
+        const auto frame = frame_index;
+        skr::task::schedule([this, key, frame, counter = warmup.counter]() mutable {
+            SKR_DEFER({ counter.decrement(); });
+            ZoneScopedN("CreatePSO(Warmup)");
+            key->pso = cgpu_create_render_pipeline(root.device, &key->descriptor);
+            if (key->pso)
+            {
+                skr_atomicu64_store_relaxed(&key->pso_frame, frame);
+                skr_atomicu32_add_relaxed(&warmup.compiled, 1);
+                skr_atomicu32_store_release(&key->pso_status, SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+            }
+            else
+            {
+                skr_atomicu64_store_relaxed(&key->pso_frame, UINT64_MAX);
+                skr_atomicu32_add_relaxed(&warmup.failed, 1);
+                skr_atomicu32_store_release(&key->pso_status, SKR_PSO_MAP_PSO_STATUS_FAILED);
+            }
+            skr_atomicu32_add_relaxed(&warmup.in_flight, -1);
+        }, nullptr);
+    }
+
+    // the warm up holds its keys until their jobs are done, the psos then belong to the materials that use them
+    // or to the garbage collector
+    void release_warmup_keys(bool all) SKR_NOEXCEPT
+    {
+        uint32_t kept = 0;
+        for (auto key : warmup.keys)
+        {
+            if (!all && skr_atomicu32_load_acquire(&key->pso_status) == SKR_PSO_MAP_PSO_STATUS_REQUESTED)
+                warmup.keys[kept++] = key;
+            else
+                free_key(key);
+        }
+        warmup.keys.resize(kept);
+    }
+
+    virtual void end_warmup() SKR_NOEXCEPT override
+    {
+        if (!warming_up) return;
+        ZoneScopedN("EndPSOWarmup");
+        warmup.counter.wait(false);
+        release_warmup_keys(true);
+        warmup.entries.clear();
+        warmup.waiting.clear();
+        warming_up = false;
+    }
+
     skr_pso_map_root_t root;
     skr::parallel_flat_hash_set<SPtr<skr_pso_map_key_t>, key_ptr_hasher, key_ptr_equal> sets;
     skr::parallel_flat_hash_map<skr_pso_map_key_id, SPtr<PSORequest>> mRequests;
     SAtomicU64 keys_counter = 0;
     uint64_t frame_index;
+
+    // psos installed through keys with shaders, in the order of their first install
+    skr::vector<skr_pso_map_manifest_entry_t> manifest;
+
+    struct Warmup {
+        // sorted in warm up order
+        skr::vector<skr_pso_map_manifest_entry_t> entries;
+        // entries not resolved yet
+        skr::vector<uint32_t> waiting;
+        // keys of the jobs in flight, each holds a reference
+        skr::vector<skr_pso_map_key_id> keys;
+        skr_pso_map_resolve_proc_t resolve = nullptr;
+        void* usrdata = nullptr;
+        uint32_t max_jobs = 0;
+        SAtomicU32 compiled = 0;
+        SAtomicU32 failed = 0;
+        SAtomicU32 in_flight = 0;
+        skr::task::counter_t counter;
+    } warmup;
+    bool warming_up = false;
 };
 } // namespace skr
 
@@ -420,6 +772,11 @@ skr_pso_map_key_id skr_pso_map_create_key(skr_pso_map_id map, const struct CGPUR
     return map->create_key(desc);
 }
 
+skr_pso_map_key_id skr_pso_map_create_key_with_shaders(skr_pso_map_id map, const struct CGPURenderPipelineDescriptor* desc, const skr_platform_shader_identifier_t* shaders, uint32_t shader_count)
+{
+    return map->create_key(desc, shaders, shader_count);
+}
+
 void skr_pso_map_free_key(skr_pso_map_id map, skr_pso_map_key_id key)
 {
     map->free_key(key);
@@ -453,4 +810,68 @@ void skr_pso_map_garbage_collect(skr_pso_map_id psoMap, uint64_t critical_frame)
 void skr_pso_map_free(skr_pso_map_id pso_map)
 {
     skr_pso_map_t::Free(pso_map);
-}
\ No newline at end of file
+}
+
+uint32_t skr_pso_map_get_manifest(skr_pso_map_id pso_map, skr_pso_map_manifest_entry_t* entries, uint32_t capacity)
+{
+    return pso_map->get_manifest(entries, capacity);
+}
+
+void skr_pso_map_clear_manifest(skr_pso_map_id pso_map)
+{
+    pso_map->clear_manifest();
+}
+
+bool skr_pso_map_save_manifest(skr_pso_map_id pso_map, skr_vfs_t* vfs, const char8_t* path)
+{
+    ZoneScopedN("SavePSOManifest");
+    skr::vector<skr_pso_map_manifest_entry_t> entries;
+    entries.resize(pso_map->get_manifest(nullptr, 0));
+    pso_map->get_manifest(entries.data(), (uint32_t)entries.size());
+    auto file = skr_vfs_fopen(vfs, path, SKR_FM_WRITE_BINARY, SKR_FILE_CREATION_ALWAYS_NEW);
+    if (!file) return false;
+    SKR_DEFER({ skr_vfs_fclose(file); });
+    PSOManifestHeader header = {};
+    header.magic = kPSOManifestMagic;
+    header.version = kPSOManifestVersion;
+    header.entry_size = sizeof(skr_pso_map_manifest_entry_t);
+    header.entry_count = (uint32_t)entries.size();
+    const auto entries_size = entries.size() * sizeof(skr_pso_map_manifest_entry_t);
+    if (skr_vfs_fwrite(file, &header, 0, sizeof(header)) != sizeof(header)) return false;
+    if (entries_size && skr_vfs_fwrite(file, entries.data(), sizeof(header), entries_size) != entries_size) return false;
+    return true;
+}
+
+uint32_t skr_pso_map_load_manifest(skr_vfs_t* vfs, const char8_t* path, skr_pso_map_manifest_entry_t* entries, uint32_t capacity)
+{
+    ZoneScopedN("LoadPSOManifest");
+    auto file = skr_vfs_fopen(vfs, path, SKR_FM_READ_BINARY, SKR_FILE_CREATION_OPEN_EXISTING);
+    if (!file) return 0;
+    SKR_DEFER({ skr_vfs_fclose(file); });
+    PSOManifestHeader header = {};
+    if (skr_vfs_fread(file, &header, 0, sizeof(header)) != sizeof(header)) return 0;
+    if (header.magic != kPSOManifestMagic || header.version != kPSOManifestVersion) return 0;
+    if (header.entry_size != sizeof(skr_pso_map_manifest_entry_t)) return 0;
+    const auto file_size = skr_vfs_fsize(file);
+    if (file_size < 0 || (uint64_t)file_size < sizeof(header) + (uint64_t)header.entry_count * header.entry_size) return 0;
+    if (!entries) return header.entry_count;
+    const auto count = (capacity < header.entry_count) ? capacity : header.entry_count;
+    const auto entries_size = count * sizeof(skr_pso_map_manifest_entry_t);
+    if (entries_size && skr_vfs_fread(file, entries, sizeof(header), entries_size) != entries_size) return 0;
+    return count;
+}
+
+void skr_pso_map_begin_warmup(skr_pso_map_id pso_map, const skr_pso_map_warmup_desc_t* desc)
+{
+    pso_map->begin_warmup(desc);
+}
+
+bool skr_pso_map_update_warmup(skr_pso_map_id pso_map, skr_pso_map_warmup_progress_t* progress)
+{
+    return pso_map->update_warmup(progress);
+}
+
+void skr_pso_map_end_warmup(skr_pso_map_id pso_map)
+{
+    pso_map->end_warmup();
+}
@@ -16,6 +16,7 @@ void skr_render_mesh_initialize(skr_render_mesh_id render_mesh, skr_mesh_resourc
 {
     uint32_t ibv_c = 0;
     uint32_t vbv_c = 0;
+    uint32_t lod_c = 0;
     // 1. calculate the number of index buffer views and vertex buffer views
     for (uint32_t i = 0; i < mesh_resource->sections.size(); i++)
     {
@@ -24,6 +25,7 @@ void skr_render_mesh_initialize(skr_render_mesh_id render_mesh, skr_mesh_resourc
         {
             auto& prim = mesh_resource->primitives[prim_idx];
             vbv_c += (uint32_t)prim.vertex_buffers.size();
+            lod_c += (uint32_t)prim.lods.size();
             ibv_c++;
         }
     }
@@ -31,6 +33,8 @@ void skr_render_mesh_initialize(skr_render_mesh_id render_mesh, skr_mesh_resourc
     render_mesh->mesh_resource_id = mesh_resource;
     render_mesh->index_buffer_views.reserve(ibv_c);
     render_mesh->vertex_buffer_views.reserve(vbv_c);
+    render_mesh->lod_index_buffer_views.reserve(lod_c);
+    render_mesh->lod_errors.reserve(lod_c);
     // 3. fill sections
     for (uint32_t i = 0; i < mesh_resource->sections.size(); i++)
     {
@@ -60,7 +64,19 @@ void skr_render_mesh_initialize(skr_render_mesh_id render_mesh, skr_mesh_resourc
             mesh_ibv.index_count = prim.index_buffer.index_count;
             mesh_ibv.first_index = prim.index_buffer.first_index;
 
+            // 3.3 fill lod ibvs, same buffer with narrower index ranges
+            const auto lod_start = render_mesh->lod_index_buffer_views.size();
+            for (const auto& lod : prim.lods)
+            {
+                auto& lod_ibv = render_mesh->lod_index_buffer_views.emplace_back(mesh_ibv);
+                lod_ibv.first_index = lod.first_index;
+                lod_ibv.index_count = lod.index_count;
+                render_mesh->lod_errors.emplace_back(lod.error);
+            }
+
             draw_cmd.ibv = &mesh_ibv;
+            draw_cmd.lod_ibvs = skr::span(render_mesh->lod_index_buffer_views.data() + lod_start, prim.lods.size());
+            draw_cmd.lod_errors = skr::span(render_mesh->lod_errors.data() + lod_start, prim.lods.size());
             draw_cmd.vbvs = skr::span(render_mesh->vertex_buffer_views.data() + vbv_start, prim.vertex_buffers.size());
             draw_cmd.primitive_index = prim_idx;
             draw_cmd.material_index = prim.material_index;
@@ -5,6 +5,7 @@
 #include "SkrRenderer/skr_renderer.h"
 #include "rtm/vector4f.h"
 #include "rtm/rtmx.h"
+#include <math.h>
 
 struct SViewportManagerImpl : public SViewportManager
 {
@@ -99,8 +100,9 @@ void skr_resolve_camera_to_viewport(const skr_camera_comp_t* camera, const skr_t
         focus_pos /*at*/,
         { 0.f, 0.f, 1.f } /*up*/
     );
+    const float fov_y = 3.1415926f / 2.f;
     auto proj = rtm::perspective_fov(                    
-        3.1415926f / 2.f, 
+        fov_y, 
         (float)camera->viewport_width / (float)camera->viewport_height, 
         1.f, 1000.f);
     auto view_projection = rtm::matrix_mul(view, proj);
@@ -108,6 +110,16 @@ void skr_resolve_camera_to_viewport(const skr_camera_comp_t* camera, const skr_t
     viewport->view_projection = *(skr_float4x4_t*)&view_projection;
     viewport->viewport_width = camera->viewport_width;
     viewport->viewport_height = camera->viewport_height;
+    viewport->eye = translation->value;
+    viewport->fov_y = fov_y;
+}
+
+float skr_render_viewport_lod_error(const skr_render_viewport_t* viewport, float distance, float pixel_error)
+{
+    if (!viewport->viewport_height) return 0.f;
+    // world units covered by one pixel at distance
+    const float pixel_size = 2.f * distance * tanf(viewport->fov_y * 0.5f) / (float)viewport->viewport_height;
+    return pixel_error * pixel_size;
 }
 
 void skr_resolve_cameras_to_viewport(struct SViewportManager* viewport_manager, dual_storage_t* storage)
@@ -1,5 +1,7 @@
 #include "utils/log.h"
 #include "utils/make_zeroed.hpp"
+#include "utils/defer.hpp"
+#include "task/task.hpp"
 #include "ecs/dual.h"
 #include "ecs/array.hpp"
 
@@ -8,10 +10,13 @@
 #include "SkrRenderer/render_viewport.h"
 #include "SkrRenderer/render_effect.h"
 #include "SkrRenderer/skr_renderer.h"
+#include "SkrRenderer/draw_sort.hpp"
+#include "SkrRenderer/draw_instancing.hpp"
 
 #include <containers/hashmap.hpp>
 #include <EASTL/vector.h>
 #include <EASTL/fixed_vector.h>
+#include <EASTL/sort.h>
 
 #include "tracy/Tracy.hpp"
 
@@ -71,6 +76,7 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
         : render_device(render_device), storage(storage)
     {
         viewport_manager = SViewportManager::Create(storage);
+        instancer.initialize(render_device->get_cgpu_device(), RG_MAX_FRAME_IN_FLIGHT);
     }
 
     ~SkrRendererImpl() override
@@ -79,6 +85,7 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
         {
             if (proxy) SkrDelete(proxy);
         }
+        instancer.finalize();
         SViewportManager::Free(viewport_manager);
     }
 
@@ -103,38 +110,78 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
                 update_context.renderer = this;
                 update_context.render_graph = render_graph;
                 update_context.storage = storage;
+                update_context.viewport_id = viewport_id;
 
                 processor->on_update(&update_context);
             }
 
-            for (auto& pass : passes)
-            {
-                draw_packets[pass->identity()].clear();
-                // used out
-                for (auto& processor : processors)
+            // one row per pass with a slot per processor, jobs write their own slots only
+            const auto processor_count = processors.size();
+            draw_packets.clear();
+            draw_packets.resize(passes.size() * processor_count, skr_primitive_draw_packet_t{});
+            // a processor may keep scratch data between calls, so it produces the packets of all passes on one thread
+            auto produce = [&](size_t processor_index) {
+                auto processor = processors[processor_index];
+                if (!processor) return;
+                for (size_t pass_index = 0; pass_index < passes.size(); pass_index++)
                 {
-                    if (pass && processor)
-                    {
-                        ZoneScopedN("ProduceDrawPacket");
+                    auto pass = passes[pass_index];
+                    if (!pass) continue;
 
-                        skr_primitive_draw_context_t draw_context = {};
-                        draw_context.renderer = this;
-                        draw_context.render_graph = render_graph;
-                        draw_context.pass = pass;
-                        draw_context.storage = storage;
+                    ZoneScopedN("ProduceDrawPacket");
 
-                        auto packet = processor->produce_draw_packets(&draw_context);
-                        draw_packets[pass->identity()].emplace_back(packet);
-                    }
+                    skr_primitive_draw_context_t draw_context = {};
+                    draw_context.renderer = this;
+                    draw_context.render_graph = render_graph;
+                    draw_context.pass = pass;
+                    draw_context.storage = storage;
+                    draw_context.viewport_id = viewport_id;
+
+                    draw_packets[pass_index * processor_count + processor_index] = processor->produce_draw_packets(&draw_context);
+                }
+            };
+            if (parallel_produce && processor_count > 1)
+            {
+                skr::task::counter_t counter;
+                counter.add((uint32_t)processor_count - 1);
+                for (size_t i = 1; i < processor_count; i++)
+                {
+                    skr::task::schedule([&produce, i, counter]() mutable {
+                        SKR_DEFER({ counter.decrement(); });
+                        produce(i);
+                    }, nullptr);
+                }
+                produce(0);
+                counter.wait(false);
+            }
+            else
+            {
+                for (size_t i = 0; i < processor_count; i++)
+                {
+                    produce(i);
                 }
             }
 
+            collect_draw_lists();
+            sort_draw_lists();
+            if (skr::renderer::DrawInstancer::has_payloads(draw_lists))
+            {
+                ZoneScopedN("InstanceDrawLists");
+                // payloads of this frame go to the buffer keyed to the executor that submits it,
+                // once the GPU is done with the frame that executor ran last
+                // frames without payloads skip the wait and keep the CPU running ahead of the GPU
+                render_graph->wait_executor();
+                instancer.begin_frame(render_graph->get_frame_index());
+                if (instancer.coalesce(draw_lists)) sync_draw_list_counts();
+            }
+
             for (auto& processor : processors)
             {
                 skr_primitive_update_context_t update_context = {};
                 update_context.renderer = this;
                 update_context.render_graph = render_graph;
                 update_context.storage = storage;
+                update_context.viewport_id = viewport_id;
 
                 processor->post_update(&update_context);
             }
@@ -143,18 +190,23 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
         // execute draw calls
         {
             ZoneScopedN("ForeachPasses(Sync)");
-            for (auto& pass : passes)
+            const auto processor_count = processors.size();
+            for (size_t pass_index = 0; pass_index < passes.size(); pass_index++)
             {
+                auto pass = passes[pass_index];
                 if (pass)
                 {
                     skr_primitive_pass_context_t pass_context = {};
                     pass_context.renderer = this;
                     pass_context.render_graph = render_graph;
                     pass_context.storage = storage;
+                    pass_context.viewport_id = viewport_id;
 
                     pass->on_update(&pass_context);
 
-                    auto& pass_draw_packets = draw_packets[pass->identity()];
+                    skr::span<const skr_primitive_draw_packet_t> pass_draw_packets = {
+                        draw_packets.data() + pass_index * processor_count, processor_count
+                    };
                     {
                         ZoneScopedN("PassExecute");
 
@@ -170,6 +222,73 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
         passes_map.clear();
     }
 
+    // a list handed to several passes is processed once
+    void collect_draw_lists()
+    {
+        draw_lists.clear();
+        for (const auto& packet : draw_packets)
+        {
+            for (uint32_t i = 0; i < packet.count; i++)
+            {
+                if (packet.lists[i].count > 0) draw_lists.emplace_back(&packet.lists[i]);
+            }
+        }
+        eastl::sort(draw_lists.begin(), draw_lists.end(), [](const auto* a, const auto* b) { return a->drawcalls < b->drawcalls; });
+        draw_lists.erase(eastl::unique(draw_lists.begin(), draw_lists.end(), [](const auto* a, const auto* b) { return a->drawcalls == b->drawcalls; }), draw_lists.end());
+    }
+
+    // instancing shrinks the processed lists, other views of the same draws follow them
+    void sync_draw_list_counts()
+    {
+        for (const auto& packet : draw_packets)
+        {
+            for (uint32_t i = 0; i < packet.count; i++)
+            {
+                auto& list = packet.lists[i];
+                if (!list.count) continue;
+                auto found = eastl::lower_bound(draw_lists.begin(), draw_lists.end(), list.drawcalls,
+                    [](const auto* a, const skr_primitive_draw_t* drawcalls) { return a->drawcalls < drawcalls; });
+                list.count = (*found)->count;
+            }
+        }
+    }
+
+    // keyed lists are reordered in place before any pass records them
+    void sort_draw_lists()
+    {
+        ZoneScopedN("SortDrawLists");
+
+        if (draw_lists.empty()) return;
+        // job i sorts lists i, i + jobs, ... with its own sorter
+        const uint32_t list_count = (uint32_t)draw_lists.size();
+        const uint32_t job_count = parallel_produce ? eastl::min(list_count, kMaxSortJobs) : 1u;
+        if (sorters.size() < job_count) sorters.resize(job_count);
+        auto sort_job = [&](uint32_t job) {
+            for (uint32_t i = job; i < list_count; i += job_count)
+            {
+                sorters[job].sort(*draw_lists[i]);
+            }
+        };
+        if (job_count > 1)
+        {
+            skr::task::counter_t counter;
+            counter.add(job_count - 1);
+            for (uint32_t i = 1; i < job_count; i++)
+            {
+                skr::task::schedule([&sort_job, i, counter]() mutable {
+                    SKR_DEFER({ counter.decrement(); });
+                    sort_job(i);
+                }, nullptr);
+            }
+            sort_job(0);
+            counter.wait(false);
+        }
+        else
+        {
+            sort_job(0);
+        }
+    }
+
     SViewportManager* get_viewport_manager() const override
     {
         return viewport_manager;
@@ -187,8 +306,15 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
     FlatStringMap<IRenderEffectProcessor*> processors_map;
 
     eastl::vector<RenderEffectProcessorVtblProxy*> processor_vtbl_proxies;
+    bool parallel_produce = false;
+    uint32_t viewport_id = 0;
 protected:
-    FlatStringMap<eastl::vector<skr_primitive_draw_packet_t>> draw_packets;
+    // indexed by pass index * processor count + processor index
+    eastl::vector<skr_primitive_draw_packet_t> draw_packets;
+    static constexpr uint32_t kMaxSortJobs = 8;
+    eastl::vector<skr_primitive_draw_list_view_t*> draw_lists;
+    eastl::vector<skr::renderer::DrawListSorter> sorters;
+    skr::renderer::DrawInstancer instancer;
 
     SRenderDevice* render_device = nullptr;
     dual_storage_t* storage = nullptr;
@@ -209,6 +335,18 @@ void skr_renderer_render_frame(SRendererId renderer, skr::render_graph::RenderGr
     renderer->render(render_graph);
 }
 
+void skr_renderer_enable_parallel_produce(SRendererId r, bool enable)
+{
+    auto renderer = (SkrRendererImpl*)r;
+    renderer->parallel_produce = enable;
+}
+
+void skr_renderer_set_viewport(SRendererId r, uint32_t viewport_id)
+{
+    auto renderer = (SkrRendererImpl*)r;
+    renderer->viewport_id = viewport_id;
+}
+
 void skr_renderer_register_render_pass(SRendererId r, skr_render_effect_name_t name, IPrimitiveRenderPass* pass)
 {
     auto renderer = (SkrRendererImpl*)r;
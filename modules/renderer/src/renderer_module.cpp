@@ -19,6 +19,7 @@ using namespace skr::guid::literals;
 const auto kGLTFVertexLayoutWithoutTangentId = "1b357a40-83ff-471c-8903-23e99d95b273"_guid;
 const auto kGLTFVertexLayoutWithTangentId = "1b11e007-7cc2-4941-bc91-82d992c4b489"_guid;
 const auto kGLTFVertexLayoutWithJointId = "C35BD99A-B0A8-4602-AFCC-6BBEACC90321"_guid;
+const auto kGLTFVertexLayoutQuantizedId = "73139b45-5ee7-4dd8-ad34-40bda23f4a19"_guid;
 }
 
 void SkrRendererModule::on_load(int argc, char** argv)
@@ -75,6 +76,17 @@ void SkrRendererModule::on_load(int argc, char** argv)
         vertex_layout.attribute_count = 5;
         skr_mesh_resource_register_vertex_layout(::kGLTFVertexLayoutWithTangentId, "StaticMeshWithTangent", &vertex_layout);
     }
+    // quantized static mesh layout, the mesh cooker converts float attributes to these formats
+    {
+        CGPUVertexLayout vertex_layout = {};
+        vertex_layout.attributes[0] = { u8"POSITION", 1, CGPU_FORMAT_R32G32B32_SFLOAT, 0, 0, sizeof(skr_float3_t), CGPU_INPUT_RATE_VERTEX };
+        vertex_layout.attributes[1] = { u8"TEXCOORD", 1, CGPU_FORMAT_R16G16_SFLOAT, 1, 0, sizeof(uint16_t) * 2, CGPU_INPUT_RATE_VERTEX };
+        vertex_layout.attributes[2] = { u8"TEXCOORD", 1, CGPU_FORMAT_R16G16_SFLOAT, 2, 0, sizeof(uint16_t) * 2, CGPU_INPUT_RATE_VERTEX };
+        vertex_layout.attributes[3] = { u8"NORMAL", 1, CGPU_FORMAT_R8G8B8A8_SNORM, 3, 0, sizeof(int8_t) * 4, CGPU_INPUT_RATE_VERTEX };
+        vertex_layout.attributes[4] = { u8"TANGENT", 1, CGPU_FORMAT_R8G8B8A8_SNORM, 4, 0, sizeof(int8_t) * 4, CGPU_INPUT_RATE_VERTEX };
+        vertex_layout.attribute_count = 5;
+        skr_mesh_resource_register_vertex_layout(::kGLTFVertexLayoutQuantizedId, "StaticMeshQuantized", &vertex_layout);
+    }
 }
 
 void SkrRendererModule::on_unload()
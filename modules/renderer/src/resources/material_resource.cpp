@@ -1,8 +1,10 @@
 #include <EASTL/fixed_vector.h>
 #include "platform/guid.hpp"
 #include "containers/sptr.hpp"
+#include "containers/hashmap.hpp"
 #include "utils/make_zeroed.hpp"
 #include "utils/threaded_service.h"
+#include "utils/log.h"
 #include "SkrRenderer/render_device.h"
 
 #include "SkrRenderer/resources/mesh_resource.h"
@@ -48,6 +50,10 @@ struct SMaterialFactoryImpl : public SMaterialFactory
     ~SMaterialFactoryImpl()
     {
         skr_pso_map_free(pso_map);
+        for (auto [pool_sig, warmup_rs] : mWarmupRootSignatures)
+        {
+            cgpu_free_root_signature(warmup_rs);
+        }
         if (rs_pool) cgpu_free_root_signature_pool(rs_pool);
         skr_shader_map_free(shader_map);
     }
@@ -70,6 +76,10 @@ struct SMaterialFactoryImpl : public SMaterialFactory
 
         // 2.free RS
         if (pass.bind_table) cgpux_free_bind_table(pass.bind_table);
+        for (auto retired : pass.retired_bind_tables)
+        {
+            cgpux_free_bind_table(retired);
+        }
         if (pass.root_signature) cgpu_free_root_signature(pass.root_signature);
 
         // 3.RC free installed shaders
@@ -84,6 +94,7 @@ struct SMaterialFactoryImpl : public SMaterialFactory
     bool Unload(skr_resource_record_t* record) override
     {
         auto material = static_cast<skr_material_resource_t*>(record->resource);
+        mMaterials.erase(material);
         bool unloaded = true;
         for (auto& pass : material->installed_passes)
         {
@@ -98,6 +109,7 @@ struct SMaterialFactoryImpl : public SMaterialFactory
         if (!material->material_type.is_resolved()) 
             material->material_type.resolve(true, nullptr);
         auto matType = material->material_type.get_resolved();
+        mMaterials.insert(material);
         // TODO: early reserve
         // install shaders
         for (auto& pass_template : matType->passes)
@@ -165,9 +177,15 @@ struct SMaterialFactoryImpl : public SMaterialFactory
             ppl_shaders[i].entry = (const char8_t*)installed_pass.shaders[i].entry.data();
             ppl_shaders[i].stage = installed_pass.shaders[i].stage;
         }
+        return createRS(ppl_shaders, static_cast<uint32_t>(shaders.size()));
+    }
+
+    // pooled, materials and pso warm up with the same shaders end up with the same root signature
+    CGPURootSignatureId createRS(const CGPUShaderEntryDescriptor* ppl_shaders, uint32_t shader_count) const
+    {
         CGPURootSignatureDescriptor rs_desc = {};
         rs_desc.pool = rs_pool;
-        rs_desc.shader_count = static_cast<uint32_t>(shaders.size());
+        rs_desc.shader_count = shader_count;
         rs_desc.shaders = ppl_shaders; 
         // TODO: static samplers & push constants
         rs_desc.push_constant_count = 1;
@@ -181,7 +199,9 @@ struct SMaterialFactoryImpl : public SMaterialFactory
     }
 
     const char* sampler_name = "color_sampler";
-    CGPUXBindTableId createMaterialBindTable(const skr_material_resource_t* material, CGPURootSignatureId root_signature) const
+    // textures and texture_views receive the bound texture of every texture override and the view it is bound with
+    CGPUXBindTableId createMaterialBindTable(const skr_material_resource_t* material, CGPURootSignatureId root_signature,
+        skr::vector<skr_texture_resource_t*>& textures, skr::vector<CGPUTextureViewId>& texture_views) const
     {
         // 1.make bind table
         // TODO: multi bind table
@@ -228,6 +248,11 @@ struct SMaterialFactoryImpl : public SMaterialFactory
 
         // 2.update values
         eastl::fixed_vector<CGPUDescriptorData, 16> updates;
+        textures.clear();
+        texture_views.clear();
+        // the updates point into texture_views
+        textures.reserve(material->overrides.textures.size());
+        texture_views.reserve(material->overrides.textures.size());
         for (const auto& override : material->overrides.samplers)
         {
             skr::resource::TResourceHandle<skr_texture_sampler_resource_t> hdl = override.value;
@@ -244,10 +269,14 @@ struct SMaterialFactoryImpl : public SMaterialFactory
             skr::resource::TResourceHandle<skr_texture_resource_t> hdl = override.value;
             hdl.resolve(true, nullptr);
 
+            const auto texture = hdl.get_resolved();
+            textures.emplace_back(texture);
+            texture_views.emplace_back(texture->texture_view);
+
             auto& update = updates.emplace_back();
             update.name = (const char8_t*)override.slot_name.data();
             update.count = 1; // TODO: Tex array parameter
-            update.textures = &hdl.get_resolved()->texture_view;
+            update.textures = &texture_views.back();
             update.binding_type = CGPU_RESOURCE_TYPE_TEXTURE;
         }
         cgpux_bind_table_update(bind_table, updates.data(), (uint32_t)updates.size());
@@ -264,7 +293,7 @@ struct SMaterialFactoryImpl : public SMaterialFactory
         if (root.aux_service == nullptr)
         {
             installed_pass.root_signature = createMaterialRS(installed_pass, shaders);
-            installed_pass.bind_table = createMaterialBindTable(material, installed_pass.root_signature);
+            installed_pass.bind_table = createMaterialBindTable(material, installed_pass.root_signature, installed_pass.textures, installed_pass.texture_views);
             return installed_pass.root_signature;
         }
 
@@ -279,6 +308,8 @@ struct SMaterialFactoryImpl : public SMaterialFactory
             {
                 installed_pass.root_signature = rsRequest->root_signature;
                 installed_pass.bind_table = rsRequest->bind_table;
+                installed_pass.textures = std::move(rsRequest->textures);
+                installed_pass.texture_views = std::move(rsRequest->texture_views);
                 mRootSignatureRequests.erase(materialGUID);
             }
             return installed_pass.root_signature;
@@ -295,7 +326,7 @@ struct SMaterialFactoryImpl : public SMaterialFactory
                 const auto factory = rsRequest->factory;
 
                 rsRequest->root_signature = factory->createMaterialRS(rsRequest->installed_pass, rsRequest->shaders);
-                rsRequest->bind_table = factory->createMaterialBindTable(rsRequest->material, rsRequest->root_signature);
+                rsRequest->bind_table = factory->createMaterialBindTable(rsRequest->material, rsRequest->root_signature, rsRequest->textures, rsRequest->texture_views);
             };
             aux_task.callback_datas[SKR_ASYNC_IO_STATUS_OK] = rsRequest.get();
             aux_service->request(&aux_task, &rsRequest->request);
@@ -426,7 +457,13 @@ struct SMaterialFactoryImpl : public SMaterialFactory
         desc.depth_stencil_format = CGPU_FORMAT_D32_SFLOAT_S8_UINT; // TODO: depth stencil format
         desc.prim_topology = CGPU_PRIM_TOPO_TRI_LIST; // TODO: non-triangle list topology support
         desc.enable_indirect_command = false; // TODO: indirect command support
-        return skr_pso_map_create_key(pso_map, &desc);
+        // shader identities let the pso go to the usage manifest
+        eastl::fixed_vector<skr_platform_shader_identifier_t, CGPU_SHADER_STAGE_COUNT> identifiers;
+        for (const auto& installed_shader : installed_pass.shaders)
+        {
+            identifiers.emplace_back(installed_shader.identifier);
+        }
+        return skr_pso_map_create_key_with_shaders(pso_map, &desc, identifiers.data(), (uint32_t)identifiers.size());
     }
 
     CGPURenderPipelineId requestPSO(skr_resource_record_t* record, skr_material_resource_t::installed_pass& installed_pass, skr::span<CGPUShaderLibraryId> shaders, bool& fail)
@@ -482,6 +519,106 @@ struct SMaterialFactoryImpl : public SMaterialFactory
         return all_okay ? SKR_INSTALL_STATUS_SUCCEED : SKR_INSTALL_STATUS_INPROGRESS;
     }
 
+    bool SavePSOManifest(skr_vfs_t* vfs, const char8_t* path) override
+    {
+        return skr_pso_map_save_manifest(pso_map, vfs, path);
+    }
+
+    bool BeginPSOWarmup(skr_vfs_t* vfs, const char8_t* path, uint32_t max_jobs) override
+    {
+        skr::vector<skr_pso_map_manifest_entry_t> entries;
+        entries.resize(skr_pso_map_load_manifest(vfs, path, nullptr, 0));
+        if (entries.empty()) return false;
+        entries.resize(skr_pso_map_load_manifest(vfs, path, entries.data(), (uint32_t)entries.size()));
+        auto warmup = make_zeroed<skr_pso_map_warmup_desc_t>();
+        warmup.entries = entries.data();
+        warmup.entry_count = (uint32_t)entries.size();
+        warmup.resolve = &SMaterialFactoryImpl::resolveWarmupEntry;
+        warmup.usrdata = this;
+        warmup.max_jobs = max_jobs;
+        skr_pso_map_begin_warmup(pso_map, &warmup);
+        return true;
+    }
+
+    bool UpdatePSOWarmup(skr_pso_map_warmup_progress_t* progress) override
+    {
+        const auto done = skr_pso_map_update_warmup(pso_map, progress);
+        if (done) skr_pso_map_end_warmup(pso_map);
+        return done;
+    }
+
+    void EndPSOWarmup() override
+    {
+        skr_pso_map_end_warmup(pso_map);
+    }
+
+    void UpdateTextureViews() override
+    {
+        for (auto material : mMaterials)
+        {
+            for (auto& pass : material->installed_passes)
+            {
+                if (!pass.bind_table) continue;
+                bool stale = false;
+                for (size_t i = 0; i < pass.textures.size(); i++)
+                {
+                    stale |= pass.textures[i]->texture_view != pass.texture_views[i];
+                }
+                if (!stale) continue;
+                pass.retired_bind_tables.emplace_back(pass.bind_table);
+                pass.bind_table = createMaterialBindTable(material, pass.root_signature, pass.textures, pass.texture_views);
+            }
+        }
+    }
+
+    static ESkrPSOMapPSOStatus resolveWarmupEntry(void* usrdata, const skr_pso_map_manifest_entry_t* entry, CGPUShaderLibraryId* libraries, CGPURootSignatureId* root_signature)
+    {
+        auto factory = static_cast<SMaterialFactoryImpl*>(usrdata);
+        const auto bytecode_type = SShaderResourceFactory::GetRuntimeBytecodeType(factory->root.device->adapter->instance->backend);
+        bool loading = false;
+        CGPUShaderEntryDescriptor ppl_shaders[CGPU_SHADER_STAGE_COUNT];
+        for (uint32_t i = 0; i < entry->shader_count; i++)
+        {
+            const auto& identifier = entry->shaders[i].identifier;
+            // manifests of another backend are of no use here
+            if (identifier.bytecode_type != bytecode_type) return SKR_PSO_MAP_PSO_STATUS_FAILED;
+            // (RC) the warm up holds each of its shaders once, so that materials find the same libraries later
+            if (!factory->mWarmupShaders.contains(identifier))
+            {
+                const auto status = factory->shader_map->install_shader(identifier);
+                if (status == SKR_SHADER_MAP_SHADER_STATUS_FAILED) return SKR_PSO_MAP_PSO_STATUS_FAILED;
+                if (status != SKR_SHADER_MAP_SHADER_STATUS_INSTALLED)
+                {
+                    loading = true;
+                    continue;
+                }
+                factory->mWarmupShaders.insert(identifier);
+            }
+            libraries[i] = factory->shader_map->find_shader(identifier);
+            ppl_shaders[i].library = libraries[i];
+            ppl_shaders[i].entry = entry->shaders[i].entry;
+            ppl_shaders[i].stage = identifier.shader_stage;
+        }
+        if (loading) return SKR_PSO_MAP_PSO_STATUS_REQUESTED;
+
+        const auto warmup_rs = factory->createRS(ppl_shaders, entry->shader_count);
+        if (!warmup_rs) return SKR_PSO_MAP_PSO_STATUS_FAILED;
+        // one reference per pooled signature is enough to keep it, later warm ups resolve to the same one
+        const auto pool_sig = warmup_rs->pool_sig ? warmup_rs->pool_sig : warmup_rs;
+        const auto found = factory->mWarmupRootSignatures.find(pool_sig);
+        if (found != factory->mWarmupRootSignatures.end())
+        {
+            cgpu_free_root_signature(warmup_rs);
+            *root_signature = found->second;
+        }
+        else
+        {
+            factory->mWarmupRootSignatures.emplace(pool_sig, warmup_rs);
+            *root_signature = warmup_rs;
+        }
+        return SKR_PSO_MAP_PSO_STATUS_INSTALLED;
+    }
+
     struct RootSignatureRequest
     {
         RootSignatureRequest(const skr_material_resource_t* material, SMaterialFactoryImpl* factory, skr_material_resource_t::installed_pass& installed_pass, skr::span<CGPUShaderLibraryId> shaders)
@@ -495,9 +632,19 @@ struct SMaterialFactoryImpl : public SMaterialFactory
         SMaterialFactoryImpl* factory = nullptr;
         CGPURootSignatureId root_signature = nullptr;
         CGPUXBindTableId bind_table = nullptr;
+        skr::vector<skr_texture_resource_t*> textures;
+        skr::vector<CGPUTextureViewId> texture_views;
         eastl::fixed_vector<CGPUShaderLibraryId, CGPU_SHADER_STAGE_COUNT> shaders;
     };
     skr::flat_hash_map<skr_guid_t, SPtr<RootSignatureRequest>, skr::guid::hash> mRootSignatureRequests;
+    // installed or installing, their bind tables follow the streamed texture views
+    skr::flat_hash_set<skr_material_resource_t*> mMaterials;
+
+    // shaders and root signatures of the pso warm ups, held for the whole session: the keys and psos they create
+    // stay in the pso map after EndPSOWarmup, so they are only released with the factory
+    skr::flat_hash_set<skr_platform_shader_identifier_t, skr_platform_shader_identifier_t::hasher> mWarmupShaders;
+    // by pooled signature
+    skr::flat_hash_map<CGPURootSignatureId, CGPURootSignatureId> mWarmupRootSignatures;
 
     skr_shader_map_id shader_map = nullptr;
     skr_pso_map_id pso_map = nullptr;
@@ -19,6 +19,8 @@
 
 #include "containers/text.hpp"
 
+#include "MeshOpt/meshoptimizer.h"
+
 #include "tracy/Tracy.hpp"
 
 static struct SkrMeshResourceUtil
@@ -129,6 +131,37 @@ void skr_mesh_resource_free(skr_mesh_resource_id mesh_resource)
     SkrDelete(mesh_resource);
 }
 
+bool skr_mesh_buffer_decode(const skr_mesh_buffer_t* buffer, const uint8_t* compressed, uint64_t compressed_size, uint8_t* destination)
+{
+    ZoneScopedN("DecodeMeshBuffer");
+    for (const auto& stream : buffer->streams)
+    {
+        const uint64_t decoded_size = (uint64_t)stream.count * stream.stride;
+        if (stream.offset + decoded_size > buffer->byte_length || stream.compressed_offset + stream.compressed_size > compressed_size)
+            return false;
+        uint8_t* dst = destination + stream.offset;
+        const uint8_t* src = compressed + stream.compressed_offset;
+        int result = 0;
+        switch (stream.codec)
+        {
+            case SKR_MESH_STREAM_CODEC_INDEX:
+                result = meshopt_decodeIndexBuffer(dst, stream.count, stream.stride, src, stream.compressed_size);
+                break;
+            case SKR_MESH_STREAM_CODEC_VERTEX:
+                result = meshopt_decodeVertexBuffer(dst, stream.count, stream.stride, src, stream.compressed_size);
+                break;
+            default:
+                if (stream.compressed_size != decoded_size) return false;
+                memcpy(dst, src, decoded_size);
+                break;
+        }
+        if (result != 0) return false;
+        if (stream.filter == SKR_MESH_STREAM_FILTER_OCTAHEDRAL)
+            meshopt_decodeFilterOct(dst, stream.count, stream.stride);
+    }
+    return true;
+}
+
 void skr_mesh_resource_register_vertex_layout(skr_vertex_layout_id id, const char* name, const struct CGPUVertexLayout* in_vertex_layout)
 {
     if (auto layout = mesh_resource_util.GetVertexLayout(id))
@@ -272,8 +305,14 @@ ESkrInstallStatus SMeshFactoryImpl::Install(skr_resource_record_t* record)
     {
         if (mesh_resource->install_to_vram)
         {
+            // compressed buffers are decoded on the cpu before upload
+            bool compressed = false;
+            for (const auto& bin : mesh_resource->bins)
+            {
+                compressed |= bin.compressed_length != 0;
+            }
             // direct storage
-            if (auto file_dstorage_queue = render_device->get_file_dstorage_queue() && !mesh_resource->install_to_ram)
+            if (auto file_dstorage_queue = render_device->get_file_dstorage_queue() && !mesh_resource->install_to_ram && !compressed)
             {
                 return InstallWithDStorage(record);
             }
@@ -335,9 +374,10 @@ ESkrInstallStatus SMeshFactoryImpl::InstallWithDStorage(skr_resource_record_t* r
                     CGPUResourceTypes flags = CGPU_RESOURCE_TYPE_NONE;
                     flags |= thisBin.used_with_index ? CGPU_RESOURCE_TYPE_INDEX_BUFFER : 0;
                     flags |= thisBin.used_with_vertex ? CGPU_RESOURCE_TYPE_VERTEX_BUFFER : 0;
+                    flags |= thisBin.used_with_meshlet ? CGPU_RESOURCE_TYPE_BUFFER_RAW : 0;
                     vram_buffer_io.vbuffer.resource_types = flags;
                     vram_buffer_io.vbuffer.memory_usage = CGPU_MEM_USAGE_GPU_ONLY;
-                    vram_buffer_io.vbuffer.flags = CGPU_BCF_NO_DESCRIPTOR_VIEW_CREATION;
+                    vram_buffer_io.vbuffer.flags = thisBin.used_with_meshlet ? CGPU_BCF_NONE : CGPU_BCF_NO_DESCRIPTOR_VIEW_CREATION;
                     vram_buffer_io.vbuffer.buffer_size = thisBin.byte_length;
                     vram_buffer_io.vbuffer.buffer_name = nullptr; // TODO: set name
 
@@ -404,13 +444,25 @@ ESkrInstallStatus SMeshFactoryImpl::InstallWithUpload(skr_resource_record_t* rec
                     CGPUResourceTypes flags = CGPU_RESOURCE_TYPE_NONE;
                     flags |= thisBin.used_with_index ? CGPU_RESOURCE_TYPE_INDEX_BUFFER : 0;
                     flags |= thisBin.used_with_vertex ? CGPU_RESOURCE_TYPE_VERTEX_BUFFER : 0;
+                    flags |= thisBin.used_with_meshlet ? CGPU_RESOURCE_TYPE_BUFFER_RAW : 0;
                     vram_buffer_io.vbuffer.resource_types = flags;
                     vram_buffer_io.vbuffer.memory_usage = CGPU_MEM_USAGE_GPU_ONLY;
-                    vram_buffer_io.vbuffer.flags = CGPU_BCF_NO_DESCRIPTOR_VIEW_CREATION;
+                    vram_buffer_io.vbuffer.flags = thisBin.used_with_meshlet ? CGPU_BCF_NONE : CGPU_BCF_NO_DESCRIPTOR_VIEW_CREATION;
                     vram_buffer_io.vbuffer.buffer_size = thisBin.byte_length;
                     vram_buffer_io.vbuffer.buffer_name = nullptr; // TODO: set name
                     thisBin.bin.bytes = uRequest->ram_destinations[i].bytes;
                     thisBin.bin.size = uRequest->ram_destinations[i].size;
+                    if (thisBin.compressed_length)
+                    {
+                        auto decoded = (uint8_t*)sakura_calloc(1, thisBin.byte_length);
+                        if (!skr_mesh_buffer_decode(&thisBin, thisBin.bin.bytes, thisBin.bin.size, decoded))
+                        {
+                            SKR_LOG_ERROR("failed to decode mesh buffer %d of %s!", (int)i, mesh_resource->name.c_str());
+                        }
+                        sakura_free(thisBin.bin.bytes);
+                        thisBin.bin.bytes = decoded;
+                        thisBin.bin.size = thisBin.byte_length;
+                    }
 
                     vram_buffer_io.src_memory.size = thisBin.byte_length;
                     vram_buffer_io.src_memory.bytes = thisBin.bin.bytes;
@@ -145,6 +145,7 @@ ECGPUShaderBytecodeType SShaderResourceFactory::GetRuntimeBytecodeType(ECGPUBack
     case CGPU_BACKEND_D3D12: return CGPU_SHADER_BYTECODE_TYPE_DXIL;
     case CGPU_BACKEND_VULKAN: return CGPU_SHADER_BYTECODE_TYPE_SPIRV;
     case CGPU_BACKEND_METAL: return CGPU_SHADER_BYTECODE_TYPE_MTL;
+    case CGPU_BACKEND_NULL: return CGPU_SHADER_BYTECODE_TYPE_SPIRV;
     default: return CGPU_SHADER_BYTECODE_TYPE_COUNT;
     }
 }
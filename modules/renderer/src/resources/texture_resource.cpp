@@ -4,6 +4,7 @@
 #include "containers/text.hpp"
 #include "containers/sptr.hpp"
 #include "containers/hashmap.hpp"
+#include "containers/vector.hpp"
 #include "platform/configure.h"
 #include "resource/resource_factory.h"
 #include "resource/resource_system.h"
@@ -14,6 +15,9 @@
 #include "cgpu/io.h"
 #include "utils/log.h"
 #include "utils/make_zeroed.hpp"
+#include "platform/memory.h"
+#include <EASTL/algorithm.h>
+#include <math.h>
 #include "platform/debug.h"
 
 #ifdef _WIN32
@@ -48,6 +52,9 @@ struct SKR_RENDERER_API STextureFactoryImpl : public STextureFactory
     bool Uninstall(skr_resource_record_t* record) override;
     ESkrInstallStatus UpdateInstall(skr_resource_record_t* record) override;
     
+    bool RequestMips(skr_texture_resource_id texture_resource, uint32_t most_detailed_mip) override;
+    void UpdateStreaming() override;
+    
     ESkrInstallStatus InstallWithDStorage(skr_resource_record_t* record);
     ESkrInstallStatus InstallWithUpload(skr_resource_record_t* record);
 
@@ -83,10 +90,13 @@ struct SKR_RENDERER_API STextureFactoryImpl : public STextureFactory
             SKR_LOG_TRACE("DStorage for texture resource %s finished!", absPath.c_str());
         }
         std::string absPath;
+        skr::vector<uint64_t> mip_offsets;
         skr_async_request_t vtexture_request;
         skr_async_vtexture_destination_t texture_destination = {};
     };
 
+    // reads a range of levels of the cooked file and uploads them, to a new texture on install
+    // or to the texture of the resource when more levels are streamed in
     struct UploadRequest
     {
         UploadRequest() = default;
@@ -98,16 +108,53 @@ struct SKR_RENDERER_API STextureFactoryImpl : public STextureFactory
         ~UploadRequest()
         {
             SKR_LOG_TRACE("Upload for texture resource %s finished!", resource_uri.c_str());
+            if (ram_destination.bytes) sakura_free(ram_destination.bytes);
         }
         STextureFactoryImpl* factory = nullptr;
         std::string resource_uri;
         skr_texture_resource_id texture_resource = nullptr;
+        // prepared on request, the ram callback must not touch the resource which may be unloaded meanwhile
+        skr_vram_texture_io_t texture_io = {};
+        skr::vector<uint64_t> mip_offsets;
+        // the resource was unloaded while streaming, the texture is freed once the upload is done
+        bool orphaned = false;
+        CGPUTextureViewId orphaned_view = nullptr;
         skr_async_request_t ram_request;
         skr_async_ram_destination_t ram_destination;
         skr_async_request_t vram_request;
         skr_async_vtexture_destination_t texture_destination = {};
     };
 
+    // levels [first_mip, first_mip + mip_count) are one range of the cooked file as they are stored from the smallest one
+    void MipRange(const skr_texture_resource_t* texture_resource, uint32_t first_mip, uint32_t mip_count, uint64_t& offset, uint64_t& size, skr::vector<uint64_t>& mip_offsets) const
+    {
+        offset = 0;
+        size = 0;
+        mip_offsets.clear();
+        if (texture_resource->mips.empty()) return;
+        const auto& smallest = texture_resource->mips[first_mip + mip_count - 1];
+        const auto& largest = texture_resource->mips[first_mip];
+        offset = eastl::min(smallest.offset, largest.offset);
+        size = eastl::max(smallest.offset + smallest.size, largest.offset + largest.size) - offset;
+        mip_offsets.resize(mip_count);
+        for (uint32_t i = 0; i < mip_count; ++i)
+            mip_offsets[i] = texture_resource->mips[first_mip + i].offset - offset;
+    }
+
+    // first level of the initial load, the more detailed ones are left for RequestMips
+    uint32_t InitialMip(const skr_texture_resource_t* texture_resource) const
+    {
+        if (!root.streaming_max_extent) return 0;
+        uint32_t mip = 0;
+        const auto& mips = texture_resource->mips;
+        while (mip + 1 < mips.size() && eastl::max(mips[mip].width, mips[mip].height) > root.streaming_max_extent)
+            mip++;
+        return mip;
+    }
+
+    void CreateTextureView(skr_texture_resource_t* texture_resource);
+    void RequestUpload(SPtr<UploadRequest> uRequest);
+
     // TODO: refactor this
     const char* GetSuffixWithCompressionFormat(ECGPUFormat format)
     {
@@ -136,6 +183,15 @@ struct SKR_RENDERER_API STextureFactoryImpl : public STextureFactory
             case CGPU_FORMAT_DXBC7_UNORM:
             case CGPU_FORMAT_DXBC7_SRGB:
                 return ".bc7";
+            case CGPU_FORMAT_ASTC_4x4_UNORM:
+            case CGPU_FORMAT_ASTC_4x4_SRGB:
+            case CGPU_FORMAT_ASTC_5x5_UNORM:
+            case CGPU_FORMAT_ASTC_5x5_SRGB:
+            case CGPU_FORMAT_ASTC_6x6_UNORM:
+            case CGPU_FORMAT_ASTC_6x6_SRGB:
+            case CGPU_FORMAT_ASTC_8x8_UNORM:
+            case CGPU_FORMAT_ASTC_8x8_SRGB:
+                return ".astc";
             default:
                 return ".raw";
         }
@@ -147,8 +203,18 @@ struct SKR_RENDERER_API STextureFactoryImpl : public STextureFactory
     skr::flat_hash_map<skr_texture_resource_id, InstallType> mInstallTypes;
     skr::flat_hash_map<skr_texture_resource_id, SPtr<UploadRequest>> mUploadRequests;
     skr::flat_hash_map<skr_texture_resource_id, SPtr<DStorageRequest>> mDStorageRequests;
+    skr::flat_hash_map<skr_texture_resource_id, SPtr<UploadRequest>> mStreamRequests;
+    skr::flat_hash_map<skr_texture_resource_id, std::string> mResourceUris;
+    // views replaced by an upgrade may still be referenced by recorded frames, they live as long as the texture
+    skr::flat_hash_map<skr_texture_resource_id, skr::vector<CGPUTextureViewId>> mRetiredViews;
 };
 
+static uint32_t GetMipLevels(const skr_texture_resource_t* texture_resource)
+{
+    // resources cooked before mips were recorded hold the most detailed level only
+    return texture_resource->mips.empty() ? 1 : (uint32_t)texture_resource->mips.size();
+}
+
 STextureFactory* STextureFactory::Create(const Root& root)
 {
     return SkrNew<STextureFactoryImpl>(root);
@@ -159,6 +225,17 @@ void STextureFactory::Destroy(STextureFactory* factory)
     SkrDelete(factory);
 }
 
+uint32_t STextureFactory::MipForExtent(const skr_texture_resource_t* texture_resource, float screen_extent)
+{
+    const auto levels = GetMipLevels(texture_resource);
+    const float extent = (float)eastl::max(texture_resource->width, texture_resource->height);
+    if (screen_extent <= 0.f) return levels - 1;
+    if (screen_extent >= extent) return 0;
+    // a level per halving, the one at least as large as the screen is kept
+    const auto mip = (uint32_t)floorf(log2f(extent / screen_extent));
+    return eastl::min(mip, levels - 1);
+}
+
 skr_type_id_t STextureFactoryImpl::GetResourceType()
 {
     const auto resource_type = skr::type::type_id<skr_texture_resource_t>::get();
@@ -168,8 +245,27 @@ skr_type_id_t STextureFactoryImpl::GetResourceType()
 bool STextureFactoryImpl::Unload(skr_resource_record_t* record)
 { 
     auto texture_resource = (skr_texture_resource_t*)record->resource;
-    if (texture_resource->texture_view) cgpu_free_texture_view(texture_resource->texture_view);
-    if (texture_resource->texture) cgpu_free_texture(texture_resource->texture);
+    auto retired = mRetiredViews.find(texture_resource);
+    if (retired != mRetiredViews.end())
+    {
+        for (auto view : retired->second)
+            cgpu_free_texture_view(view);
+        mRetiredViews.erase(retired);
+    }
+    mResourceUris.erase(texture_resource);
+    auto streaming = mStreamRequests.find(texture_resource);
+    if (streaming != mStreamRequests.end())
+    {
+        // the upload still writes to the texture, UpdateStreaming frees it after completion
+        streaming->second->orphaned = true;
+        streaming->second->orphaned_view = texture_resource->texture_view;
+        streaming->second->texture_resource = nullptr;
+    }
+    else
+    {
+        if (texture_resource->texture_view) cgpu_free_texture_view(texture_resource->texture_view);
+        if (texture_resource->texture) cgpu_free_texture(texture_resource->texture);
+    }
     SkrDelete(texture_resource);
     return true; 
 }
@@ -217,6 +313,14 @@ ESkrInstallStatus STextureFactoryImpl::InstallWithDStorage(skr_resource_record_t
                 mDStorageRequests.emplace(texture_resource, dRequest);
                 mInstallTypes.emplace(texture_resource, installType);
                 dRequest->absPath = compressedPath.string();
+                mResourceUris.emplace(texture_resource, compressedBin.c_str());
+                // dstorage reads the levels straight from the file
+                const auto levels = GetMipLevels(texture_resource);
+                const auto first_mip = InitialMip(texture_resource);
+                uint64_t range_offset = 0, range_size = 0;
+                MipRange(texture_resource, first_mip, levels - first_mip, range_offset, range_size, dRequest->mip_offsets);
+                for (auto& offset : dRequest->mip_offsets)
+                    offset += range_offset;
 
                 auto vram_texture_io = make_zeroed<skr_vram_texture_io_t>();
                 vram_texture_io.device = render_device->get_cgpu_device();
@@ -232,6 +336,10 @@ ESkrInstallStatus STextureFactoryImpl::InstallWithDStorage(skr_resource_record_t
                 vram_texture_io.vtexture.height = texture_resource->height;
                 vram_texture_io.vtexture.depth = texture_resource->depth;
                 vram_texture_io.vtexture.format = (ECGPUFormat)texture_resource->format;
+                vram_texture_io.vtexture.mip_levels = levels;
+                vram_texture_io.first_mip = first_mip;
+                vram_texture_io.mip_count = levels - first_mip;
+                vram_texture_io.mip_offsets = dRequest->mip_offsets.empty() ? nullptr : dRequest->mip_offsets.data();
 
                 vram_texture_io.callbacks[SKR_ASYNC_IO_STATUS_OK] = +[](skr_async_request_t* request, void* data){
 
@@ -266,40 +374,21 @@ ESkrInstallStatus STextureFactoryImpl::InstallWithUpload(skr_resource_record_t*
             SKR_ASSERT(found == mUploadRequests.end());
             mUploadRequests.emplace(texture_resource, uRequest);
             mInstallTypes.emplace(texture_resource, installType);
+            mResourceUris.emplace(texture_resource, uRequest->resource_uri);
 
-            // emit ram request
-            auto ram_texture_io = make_zeroed<skr_ram_io_t>();
-            ram_texture_io.path = (const char8_t*)uRequest->resource_uri.c_str();
-            ram_texture_io.callbacks[SKR_ASYNC_IO_STATUS_OK] = +[](skr_async_request_t* request, void* data) noexcept {
-                ZoneScopedN("Upload Image");
-                // upload
-                auto uRequest = (UploadRequest*)data;
-                auto factory = uRequest->factory;
-                auto render_device = factory->root.render_device;
-                auto texture_resource = uRequest->texture_resource;
-
-                auto& texture_io_request = uRequest->vram_request;
-                auto& texture_destination = uRequest->texture_destination;
-                auto vram_texture_io = make_zeroed<skr_vram_texture_io_t>();
-                vram_texture_io.device = render_device->get_cgpu_device();
-                vram_texture_io.transfer_queue = render_device->get_cpy_queue();
-
-                SKR_ASSERT(texture_resource->data_size == uRequest->ram_destination.size);
-
-                vram_texture_io.vtexture.texture_name = nullptr; // TODO: debug name
-                vram_texture_io.vtexture.resource_types = CGPU_RESOURCE_TYPE_TEXTURE;
-                vram_texture_io.vtexture.width = texture_resource->width;
-                vram_texture_io.vtexture.height = texture_resource->height;
-                vram_texture_io.vtexture.depth = texture_resource->depth;
-                vram_texture_io.vtexture.format = (ECGPUFormat)texture_resource->format;
-                vram_texture_io.src_memory.size = texture_resource->data_size;
-                vram_texture_io.src_memory.bytes = uRequest->ram_destination.bytes;
-                vram_texture_io.callbacks[SKR_ASYNC_IO_STATUS_OK] = +[](skr_async_request_t* request, void* data){};
-                vram_texture_io.callback_datas[SKR_ASYNC_IO_STATUS_OK] = nullptr;
-                factory->root.vram_service->request(&vram_texture_io, &texture_io_request, &texture_destination);
-            };
-            ram_texture_io.callback_datas[SKR_ASYNC_IO_STATUS_OK] = (void*)uRequest.get();
-            root.ram_service->request(root.vfs, &ram_texture_io, &uRequest->ram_request, &uRequest->ram_destination);
+            const auto levels = GetMipLevels(texture_resource);
+            const auto first_mip = InitialMip(texture_resource);
+            auto& texture_io = uRequest->texture_io;
+            texture_io.vtexture.texture_name = nullptr; // TODO: debug name
+            texture_io.vtexture.resource_types = CGPU_RESOURCE_TYPE_TEXTURE;
+            texture_io.vtexture.width = texture_resource->width;
+            texture_io.vtexture.height = texture_resource->height;
+            texture_io.vtexture.depth = texture_resource->depth;
+            texture_io.vtexture.format = (ECGPUFormat)texture_resource->format;
+            texture_io.vtexture.mip_levels = levels;
+            texture_io.first_mip = first_mip;
+            texture_io.mip_count = levels - first_mip;
+            RequestUpload(uRequest);
         }
         else
         {
@@ -309,6 +398,100 @@ ESkrInstallStatus STextureFactoryImpl::InstallWithUpload(skr_resource_record_t*
     return ESkrInstallStatus::SKR_INSTALL_STATUS_INPROGRESS;
 }
 
+void STextureFactoryImpl::RequestUpload(SPtr<UploadRequest> uRequest)
+{
+    // emit ram request, only the range of the requested levels is read
+    uint64_t range_offset = 0, range_size = 0;
+    MipRange(uRequest->texture_resource, uRequest->texture_io.first_mip, uRequest->texture_io.mip_count, range_offset, range_size, uRequest->mip_offsets);
+    auto ram_texture_io = make_zeroed<skr_ram_io_t>();
+    ram_texture_io.path = (const char8_t*)uRequest->resource_uri.c_str();
+    ram_texture_io.offset = range_offset;
+    ram_texture_io.size = range_size;
+    ram_texture_io.callbacks[SKR_ASYNC_IO_STATUS_OK] = +[](skr_async_request_t* request, void* data) noexcept {
+        ZoneScopedN("Upload Image");
+        // upload
+        auto uRequest = (UploadRequest*)data;
+        auto factory = uRequest->factory;
+        auto render_device = factory->root.render_device;
+
+        auto vram_texture_io = uRequest->texture_io;
+        vram_texture_io.device = render_device->get_cgpu_device();
+        vram_texture_io.transfer_queue = render_device->get_cpy_queue();
+        vram_texture_io.src_memory.size = uRequest->ram_destination.size;
+        vram_texture_io.src_memory.bytes = uRequest->ram_destination.bytes;
+        vram_texture_io.mip_offsets = uRequest->mip_offsets.empty() ? nullptr : uRequest->mip_offsets.data();
+        vram_texture_io.callbacks[SKR_ASYNC_IO_STATUS_OK] = +[](skr_async_request_t* request, void* data){};
+        vram_texture_io.callback_datas[SKR_ASYNC_IO_STATUS_OK] = nullptr;
+        factory->root.vram_service->request(&vram_texture_io, &uRequest->vram_request, &uRequest->texture_destination);
+    };
+    ram_texture_io.callback_datas[SKR_ASYNC_IO_STATUS_OK] = (void*)uRequest.get();
+    root.ram_service->request(root.vfs, &ram_texture_io, &uRequest->ram_request, &uRequest->ram_destination);
+}
+
+void STextureFactoryImpl::CreateTextureView(skr_texture_resource_t* texture_resource)
+{
+    CGPUTextureViewDescriptor view_desc = {};
+    view_desc.texture = texture_resource->texture;
+    view_desc.array_layer_count = 1;
+    view_desc.base_array_layer = 0;
+    view_desc.mip_level_count = GetMipLevels(texture_resource) - texture_resource->resident_mip;
+    view_desc.base_mip_level = texture_resource->resident_mip;
+    view_desc.aspects = CGPU_TVA_COLOR;
+    view_desc.dims = CGPU_TEX_DIMENSION_2D;
+    view_desc.format = (ECGPUFormat)texture_resource->format;
+    view_desc.usages = CGPU_TVU_SRV;
+    texture_resource->texture_view = cgpu_create_texture_view(root.render_device->get_cgpu_device(), &view_desc);
+}
+
+bool STextureFactoryImpl::RequestMips(skr_texture_resource_id texture_resource, uint32_t most_detailed_mip)
+{
+    if (!texture_resource->texture || texture_resource->mips.empty()) return false;
+    if (mStreamRequests.find(texture_resource) != mStreamRequests.end()) return false;
+    const auto levels = GetMipLevels(texture_resource);
+    most_detailed_mip = eastl::min(most_detailed_mip, levels - 1);
+    if (most_detailed_mip >= texture_resource->resident_mip) return true;
+
+    auto uri = mResourceUris.find(texture_resource);
+    if (uri == mResourceUris.end()) return false;
+    auto uRequest = SPtr<UploadRequest>::Create(this, uri->second.c_str(), texture_resource);
+    auto& texture_io = uRequest->texture_io;
+    texture_io.vtexture.texture_name = nullptr; // TODO: debug name
+    texture_io.vtexture.resource_types = CGPU_RESOURCE_TYPE_TEXTURE;
+    texture_io.vtexture.width = texture_resource->width;
+    texture_io.vtexture.height = texture_resource->height;
+    texture_io.vtexture.depth = texture_resource->depth;
+    texture_io.vtexture.format = (ECGPUFormat)texture_resource->format;
+    texture_io.vtexture.mip_levels = levels;
+    texture_io.first_mip = most_detailed_mip;
+    texture_io.mip_count = texture_resource->resident_mip - most_detailed_mip;
+    // the vram service copies into the existing texture, the levels it holds stay in place
+    uRequest->texture_destination.texture = texture_resource->texture;
+    mStreamRequests.emplace(texture_resource, uRequest);
+    RequestUpload(uRequest);
+    return true;
+}
+
+void STextureFactoryImpl::UpdateStreaming()
+{
+    skr::vector<skr_texture_resource_id> finished;
+    for (auto& [texture_resource, uRequest] : mStreamRequests)
+    {
+        if (!uRequest->vram_request.is_ready()) continue;
+        finished.emplace_back(texture_resource);
+        if (uRequest->orphaned)
+        {
+            if (uRequest->orphaned_view) cgpu_free_texture_view(uRequest->orphaned_view);
+            cgpu_free_texture(uRequest->texture_destination.texture);
+            continue;
+        }
+        mRetiredViews[texture_resource].emplace_back(texture_resource->texture_view);
+        texture_resource->resident_mip = uRequest->texture_io.first_mip;
+        CreateTextureView(texture_resource);
+    }
+    for (auto texture_resource : finished)
+        mStreamRequests.erase(texture_resource);
+}
+
 bool STextureFactoryImpl::Uninstall(skr_resource_record_t* record)
 {
     return true; 
@@ -328,18 +511,8 @@ ESkrInstallStatus STextureFactoryImpl::UpdateInstall(skr_resource_record_t* reco
             if (okay)
             {
                 texture_resource->texture = dRequest->second->texture_destination.texture;
-                // TODO: mipmap view
-                CGPUTextureViewDescriptor view_desc = {};
-                view_desc.texture = texture_resource->texture;
-                view_desc.array_layer_count = 1;
-                view_desc.base_array_layer = 0;
-                view_desc.mip_level_count = 1;
-                view_desc.base_mip_level = 0;
-                view_desc.aspects = CGPU_TVA_COLOR;
-                view_desc.dims = CGPU_TEX_DIMENSION_2D;
-                view_desc.format = (ECGPUFormat)texture_resource->format;
-                view_desc.usages = CGPU_TVU_SRV;
-                texture_resource->texture_view = cgpu_create_texture_view(root.render_device->get_cgpu_device(), &view_desc);
+                texture_resource->resident_mip = InitialMip(texture_resource);
+                CreateTextureView(texture_resource);
 
                 mDStorageRequests.erase(texture_resource);
                 mInstallTypes.erase(texture_resource);
@@ -361,18 +534,8 @@ ESkrInstallStatus STextureFactoryImpl::UpdateInstall(skr_resource_record_t* reco
             if (okay)
             {
                 texture_resource->texture = uRequest->second->texture_destination.texture;
-                // TODO: mipmap view
-                CGPUTextureViewDescriptor view_desc = {};
-                view_desc.texture = texture_resource->texture;
-                view_desc.array_layer_count = 1;
-                view_desc.base_array_layer = 0;
-                view_desc.mip_level_count = 1;
-                view_desc.base_mip_level = 0;
-                view_desc.aspects = CGPU_TVA_COLOR;
-                view_desc.dims = CGPU_TEX_DIMENSION_2D;
-                view_desc.format = (ECGPUFormat)texture_resource->format;
-                view_desc.usages = CGPU_TVU_SRV;
-                texture_resource->texture_view = cgpu_create_texture_view(root.render_device->get_cgpu_device(), &view_desc);
+                texture_resource->resident_mip = uRequest->second->texture_io.first_mip;
+                CreateTextureView(texture_resource);
 
                 mUploadRequests.erase(texture_resource);
                 mInstallTypes.erase(texture_resource);
@@ -0,0 +1,43 @@
+#include "culling_avx2.hpp"
+#include <immintrin.h>
+
+namespace skr
+{
+namespace renderer
+{
+uint32_t cull_boxes_avx2(const float* planes, const float* boxes, uint32_t count, uint32_t* visibility)
+{
+    // gather 8 boxes into one register per component, then test them against each plane at once
+    const __m256i offsets = _mm256_setr_epi32(0, 6, 12, 18, 24, 30, 36, 42);
+    const __m256 sign_mask = _mm256_set1_ps(-0.f);
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const float* box = boxes + i * 6;
+        const __m256 cx = _mm256_i32gather_ps(box + 0, offsets, 4);
+        const __m256 cy = _mm256_i32gather_ps(box + 1, offsets, 4);
+        const __m256 cz = _mm256_i32gather_ps(box + 2, offsets, 4);
+        const __m256 ex = _mm256_i32gather_ps(box + 3, offsets, 4);
+        const __m256 ey = _mm256_i32gather_ps(box + 4, offsets, 4);
+        const __m256 ez = _mm256_i32gather_ps(box + 5, offsets, 4);
+        __m256 outside = _mm256_setzero_ps();
+        for (uint32_t p = 0; p < 6; p++)
+        {
+            const float* plane = planes + p * 4;
+            const __m256 nx = _mm256_set1_ps(plane[0]), ny = _mm256_set1_ps(plane[1]), nz = _mm256_set1_ps(plane[2]);
+            // separate multiplies and adds in the order of the scalar test, fused ones would round differently
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_set1_ps(plane[3]));
+            d = _mm256_add_ps(d, _mm256_mul_ps(ny, cy));
+            d = _mm256_add_ps(d, _mm256_mul_ps(nz, cz));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_andnot_ps(sign_mask, nx), ex));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_andnot_ps(sign_mask, ny), ey));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_andnot_ps(sign_mask, nz), ez));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        const uint32_t visible = ~(uint32_t)_mm256_movemask_ps(outside) & 0xFFu;
+        visibility[i / 32] |= visible << (i % 32);
+    }
+    return i;
+}
+} // namespace renderer
+} // namespace skr
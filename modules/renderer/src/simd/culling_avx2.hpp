@@ -0,0 +1,15 @@
+#pragma once
+#include <stdint.h>
+
+namespace skr
+{
+namespace renderer
+{
+// kernels built with avx2 flags, only called once skr_cpu_has_avx2 passed
+// they include nothing but intrinsics, so no inline function of a shared header gets an avx2 body
+
+// tests boxes of 6 packed floats against 6 planes of 4 floats, 8 at a time
+// sets the bits of the boxes it tested in visibility, which must start zeroed, and returns how many it tested
+uint32_t cull_boxes_avx2(const float* planes, const float* boxes, uint32_t count, uint32_t* visibility);
+} // namespace renderer
+} // namespace skr
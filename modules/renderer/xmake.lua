@@ -1,3 +1,5 @@
+add_requires("meshoptimizer >=0.1.0-skr")
+
 shared_module("SkrRenderer", "SKR_RENDERER", engine_version)
     set_group("01.modules")
     add_rules("c++.codegen", {
@@ -9,6 +11,12 @@ shared_module("SkrRenderer", "SKR_RENDERER", engine_version)
     public_dependency("SkrRenderGraph", engine_version)
     public_dependency("SkrImGui", engine_version)
     add_includedirs("include", {public=true})
+    -- meshoptimizer decodes compressed mesh buffers
+    add_packages("meshoptimizer")
     add_rules("c++.unity_build", {batchsize = default_unity_batch_size})
     add_files("src/*.cpp", {unity_group = "renderer"})
-    add_files("src/resources/*.cpp", {unity_ignored = true})
\ No newline at end of file
+    add_files("src/resources/*.cpp", {unity_ignored = true})
+    -- avx2 kernels only run after a cpu check, so only their own files get the flags
+    if is_arch("x86_64", "x64") then
+        add_files("src/simd/*_avx2.cpp", {unity_ignored = true, cxflags = is_plat("windows") and "/arch:AVX2" or "-mavx2"})
+    end
\ No newline at end of file
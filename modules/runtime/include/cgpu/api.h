@@ -96,6 +96,7 @@ typedef enum ECGPUBackend
     CGPU_BACKEND_XBOX_D3D12 = 2,
     CGPU_BACKEND_AGC = 3,
     CGPU_BACKEND_METAL = 4,
+    CGPU_BACKEND_NULL = 5,
     CGPU_BACKEND_COUNT,
     CGPU_BACKEND_MAX_ENUM_BIT = 0x7FFFFFFF
 } ECGPUBackend;
@@ -105,7 +106,8 @@ static const char8_t* gCGPUBackendNames[CGPU_BACKEND_COUNT] = {
     SKR_UTF8("d3d12"),
     SKR_UTF8("d3d12(xbox)"),
     SKR_UTF8("agc"),
-    SKR_UTF8("metal")
+    SKR_UTF8("metal"),
+    SKR_UTF8("null")
 };
 
 typedef enum ECGPUQueueType
@@ -417,6 +419,8 @@ typedef struct CGPUDStorageTextureIODescriptor {
         uint64_t size;
     } source_file;
     CGPUTextureId texture;
+    uint32_t mip_level;
+    // extent of the mip level
     uint32_t width;
     uint32_t height;
     uint32_t depth;
@@ -1574,6 +1578,9 @@ typedef struct CGPUTextureViewDescriptor {
 typedef struct CGPUTextureAliasingBindDescriptor {
     CGPUTextureId aliased;
     CGPUTextureId aliasing;
+    /// Byte offset of the aliasing texture inside the memory of the aliased one,
+    /// must be a multiple of the aliasing texture's alignment
+    uint64_t offset;
 } CGPUTextureAliasingBindDescriptor;
 
 typedef struct CGPUTexture {
@@ -0,0 +1,420 @@
+#pragma once
+#include "cgpu/api.h"
+#include "platform/atomic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The null backend talks to no GPU at all: every command is recorded into a byte stream owned by the command buffer,
+// resources report the memory a desktop driver would ask for, and queue submission executes the CPU visible effects
+// of the stream (buffer copies, marker writes, query resolves) at once. It is meant for headless CI, tests & benchmarks
+// of the CPU side of a frame, the recorded streams can be inspected & replayed.
+
+RUNTIME_API const CGPUProcTable* CGPU_NullProcTable();
+RUNTIME_API const CGPUSurfacesProcTable* CGPU_NullSurfacesProcTable();
+
+// Recorded Commands
+typedef enum ECGPUNullCommandType
+{
+    CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_BUFFER = 0,
+    CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_TEXTURE,
+    CGPU_NULL_COMMAND_TRANSFER_TEXTURE_TO_TEXTURE,
+    CGPU_NULL_COMMAND_RESOURCE_BARRIER,
+    CGPU_NULL_COMMAND_BEGIN_QUERY,
+    CGPU_NULL_COMMAND_END_QUERY,
+    CGPU_NULL_COMMAND_RESET_QUERY_POOL,
+    CGPU_NULL_COMMAND_RESOLVE_QUERY,
+    CGPU_NULL_COMMAND_BEGIN_EVENT,
+    CGPU_NULL_COMMAND_SET_MARKER,
+    CGPU_NULL_COMMAND_END_EVENT,
+    CGPU_NULL_COMMAND_WRITE_BUFFER_MARKER,
+    CGPU_NULL_COMMAND_BEGIN_COMPUTE_PASS,
+    CGPU_NULL_COMMAND_BIND_COMPUTE_PIPELINE,
+    CGPU_NULL_COMMAND_DISPATCH,
+    CGPU_NULL_COMMAND_END_COMPUTE_PASS,
+    CGPU_NULL_COMMAND_BEGIN_RENDER_PASS,
+    CGPU_NULL_COMMAND_BIND_RENDER_PIPELINE,
+    CGPU_NULL_COMMAND_BIND_VERTEX_BUFFERS,
+    CGPU_NULL_COMMAND_BIND_INDEX_BUFFER,
+    CGPU_NULL_COMMAND_SET_VIEWPORT,
+    CGPU_NULL_COMMAND_SET_SCISSOR,
+    CGPU_NULL_COMMAND_SET_SHADING_RATE,
+    CGPU_NULL_COMMAND_DRAW,
+    CGPU_NULL_COMMAND_END_RENDER_PASS,
+    CGPU_NULL_COMMAND_BIND_DESCRIPTOR_SET,
+    CGPU_NULL_COMMAND_PUSH_CONSTANTS,
+    CGPU_NULL_COMMAND_COUNT,
+    CGPU_NULL_COMMAND_MAX_ENUM_BIT = 0x7FFFFFFF
+} ECGPUNullCommandType;
+
+// every record starts with this header, the next record starts size bytes later
+typedef struct CGPUNullCommand {
+    ECGPUNullCommandType type;
+    uint32_t size;
+} CGPUNullCommand;
+
+typedef struct CGPUNullCmdTransferBufferToBuffer {
+    CGPUNullCommand header;
+    CGPUBufferToBufferTransfer transfer;
+} CGPUNullCmdTransferBufferToBuffer;
+
+typedef struct CGPUNullCmdTransferBufferToTexture {
+    CGPUNullCommand header;
+    CGPUBufferToTextureTransfer transfer;
+} CGPUNullCmdTransferBufferToTexture;
+
+typedef struct CGPUNullCmdTransferTextureToTexture {
+    CGPUNullCommand header;
+    CGPUTextureToTextureTransfer transfer;
+} CGPUNullCmdTransferTextureToTexture;
+
+// followed by buffer_barriers_count CGPUBufferBarrier and texture_barriers_count CGPUTextureBarrier
+typedef struct CGPUNullCmdResourceBarrier {
+    CGPUNullCommand header;
+    uint32_t buffer_barriers_count;
+    uint32_t texture_barriers_count;
+} CGPUNullCmdResourceBarrier;
+
+// begin/end query, reset query pool & resolve query
+typedef struct CGPUNullCmdQuery {
+    CGPUNullCommand header;
+    CGPUQueryPoolId pool;
+    CGPUBufferId readback;
+    uint32_t start_query;
+    uint32_t query_count;
+    ECGPUShaderStage stage;
+} CGPUNullCmdQuery;
+
+// begin event & set marker, followed by the zero terminated name
+typedef struct CGPUNullCmdEvent {
+    CGPUNullCommand header;
+    float color[4];
+} CGPUNullCmdEvent;
+
+typedef struct CGPUNullCmdWriteBufferMarker {
+    CGPUNullCommand header;
+    CGPUBufferId buffer;
+    uint64_t offset;
+    uint32_t value;
+} CGPUNullCmdWriteBufferMarker;
+
+// begin compute pass & begin render pass, followed by the zero terminated name
+// render passes put render_target_count CGPUColorAttachment and the depth stencil attachment (if any) before the name
+typedef struct CGPUNullCmdBeginPass {
+    CGPUNullCommand header;
+    ECGPUSampleCount sample_count;
+    uint32_t render_target_count;
+    bool has_depth_stencil;
+} CGPUNullCmdBeginPass;
+
+// bind compute & render pipeline
+typedef struct CGPUNullCmdBindPipeline {
+    CGPUNullCommand header;
+    const void* pipeline;
+} CGPUNullCmdBindPipeline;
+
+typedef struct CGPUNullCmdDispatch {
+    CGPUNullCommand header;
+    uint32_t x;
+    uint32_t y;
+    uint32_t z;
+} CGPUNullCmdDispatch;
+
+// followed by buffer_count CGPUBufferId, then buffer_count strides & buffer_count offsets (uint32_t)
+typedef struct CGPUNullCmdBindVertexBuffers {
+    CGPUNullCommand header;
+    uint32_t buffer_count;
+} CGPUNullCmdBindVertexBuffers;
+
+typedef struct CGPUNullCmdBindIndexBuffer {
+    CGPUNullCommand header;
+    CGPUBufferId buffer;
+    uint64_t offset;
+    uint32_t index_stride;
+} CGPUNullCmdBindIndexBuffer;
+
+typedef struct CGPUNullCmdSetViewport {
+    CGPUNullCommand header;
+    float x;
+    float y;
+    float width;
+    float height;
+    float min_depth;
+    float max_depth;
+} CGPUNullCmdSetViewport;
+
+typedef struct CGPUNullCmdSetScissor {
+    CGPUNullCommand header;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+} CGPUNullCmdSetScissor;
+
+typedef struct CGPUNullCmdSetShadingRate {
+    CGPUNullCommand header;
+    ECGPUShadingRate shading_rate;
+    ECGPUShadingRateCombiner post_rasterizer_rate;
+    ECGPUShadingRateCombiner final_rate;
+} CGPUNullCmdSetShadingRate;
+
+// all four draw calls, non-instanced draws record an instance count of 1
+typedef struct CGPUNullCmdDraw {
+    CGPUNullCommand header;
+    uint32_t element_count;
+    uint32_t first_element;
+    uint32_t instance_count;
+    uint32_t first_instance;
+    uint32_t first_vertex;
+    bool indexed;
+} CGPUNullCmdDraw;
+
+typedef struct CGPUNullCmdBindDescriptorSet {
+    CGPUNullCommand header;
+    CGPUDescriptorSetId set;
+    ECGPUPipelineType pipeline_type;
+} CGPUNullCmdBindDescriptorSet;
+
+// followed by size bytes of constants
+typedef struct CGPUNullCmdPushConstants {
+    CGPUNullCommand header;
+    CGPURootSignatureId root_signature;
+    ECGPUPipelineType pipeline_type;
+    uint32_t size;
+} CGPUNullCmdPushConstants;
+
+// Counters of a null device, resources are counted on creation and commands when they are submitted
+typedef struct CGPUNullDeviceStatistics {
+    uint64_t buffers_created;
+    uint64_t textures_created;
+    uint64_t render_pipelines_created;
+    uint64_t descriptor_sets_updated;
+    uint64_t descriptors_written;
+    uint64_t allocated_bytes;
+    uint64_t peak_allocated_bytes;
+    uint64_t submits;
+    uint64_t command_buffers_submitted;
+    uint64_t commands_submitted;
+    uint64_t buffer_barriers;
+    uint64_t texture_barriers;
+    uint64_t render_passes;
+    uint64_t compute_passes;
+    uint64_t draws;
+    uint64_t dispatches;
+    uint64_t copies;
+    uint64_t presents;
+} CGPUNullDeviceStatistics;
+
+// Inspection APIs
+// records of a command buffer, valid until it begins again, next returns NULL past the last record
+RUNTIME_API const CGPUNullCommand* cgpu_null_command_buffer_first(CGPUCommandBufferId cmd);
+RUNTIME_API const CGPUNullCommand* cgpu_null_command_buffer_next(CGPUCommandBufferId cmd, const CGPUNullCommand* command);
+RUNTIME_API uint32_t cgpu_null_command_buffer_count(CGPUCommandBufferId cmd);
+RUNTIME_API uint64_t cgpu_null_command_buffer_size(CGPUCommandBufferId cmd);
+// encodes the records of src into dst through the cgpu_cmd_* entries, dst must be recording and able to use the resources of src
+RUNTIME_API void cgpu_null_replay_command_buffer(CGPUCommandBufferId src, CGPUCommandBufferId dst);
+RUNTIME_API void cgpu_null_query_device_statistics(CGPUDeviceId device, CGPUNullDeviceStatistics* statistics);
+RUNTIME_API void cgpu_null_reset_device_statistics(CGPUDeviceId device);
+// marker buffers are filled like vkCmdFillBuffer would, offset in bytes
+RUNTIME_API void cgpu_null_cmd_write_buffer_marker(CGPUCommandBufferId cmd, CGPUBufferId buffer, uint64_t offset, uint32_t value);
+
+// Instance APIs
+RUNTIME_API CGPUInstanceId cgpu_create_instance_null(CGPUInstanceDescriptor const* descriptor);
+RUNTIME_API void cgpu_query_instance_features_null(CGPUInstanceId instance, struct CGPUInstanceFeatures* features);
+RUNTIME_API void cgpu_free_instance_null(CGPUInstanceId instance);
+
+// Adapter APIs
+RUNTIME_API void cgpu_enum_adapters_null(CGPUInstanceId instance, CGPUAdapterId* const adapters, uint32_t* adapters_num);
+RUNTIME_API const CGPUAdapterDetail* cgpu_query_adapter_detail_null(const CGPUAdapterId adapter);
+RUNTIME_API uint32_t cgpu_query_queue_count_null(const CGPUAdapterId adapter, const ECGPUQueueType type);
+
+// Device APIs
+RUNTIME_API CGPUDeviceId cgpu_create_device_null(CGPUAdapterId adapter, const CGPUDeviceDescriptor* desc);
+RUNTIME_API void cgpu_query_video_memory_info_null(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
+RUNTIME_API void cgpu_query_shared_memory_info_null(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
+RUNTIME_API void cgpu_free_device_null(CGPUDeviceId device);
+
+// API Object APIs
+RUNTIME_API CGPUFenceId cgpu_create_fence_null(CGPUDeviceId device);
+RUNTIME_API void cgpu_wait_fences_null(const CGPUFenceId* fences, uint32_t fence_count);
+RUNTIME_API ECGPUFenceStatus cgpu_query_fence_status_null(CGPUFenceId fence);
+RUNTIME_API void cgpu_free_fence_null(CGPUFenceId fence);
+RUNTIME_API CGPUSemaphoreId cgpu_create_semaphore_null(CGPUDeviceId device);
+RUNTIME_API void cgpu_free_semaphore_null(CGPUSemaphoreId semaphore);
+RUNTIME_API CGPURootSignaturePoolId cgpu_create_root_signature_pool_null(CGPUDeviceId device, const struct CGPURootSignaturePoolDescriptor* desc);
+RUNTIME_API void cgpu_free_root_signature_pool_null(CGPURootSignaturePoolId pool);
+RUNTIME_API CGPURootSignatureId cgpu_create_root_signature_null(CGPUDeviceId device, const struct CGPURootSignatureDescriptor* desc);
+RUNTIME_API void cgpu_free_root_signature_null(CGPURootSignatureId signature);
+RUNTIME_API CGPUDescriptorSetId cgpu_create_descriptor_set_null(CGPUDeviceId device, const struct CGPUDescriptorSetDescriptor* desc);
+RUNTIME_API void cgpu_update_descriptor_set_null(CGPUDescriptorSetId set, const struct CGPUDescriptorData* datas, uint32_t count);
+RUNTIME_API void cgpu_free_descriptor_set_null(CGPUDescriptorSetId set);
+RUNTIME_API CGPUComputePipelineId cgpu_create_compute_pipeline_null(CGPUDeviceId device, const struct CGPUComputePipelineDescriptor* desc);
+RUNTIME_API void cgpu_free_compute_pipeline_null(CGPUComputePipelineId pipeline);
+RUNTIME_API CGPURenderPipelineId cgpu_create_render_pipeline_null(CGPUDeviceId device, const struct CGPURenderPipelineDescriptor* desc);
+RUNTIME_API void cgpu_free_render_pipeline_null(CGPURenderPipelineId pipeline);
+RUNTIME_API CGPUQueryPoolId cgpu_create_query_pool_null(CGPUDeviceId device, const struct CGPUQueryPoolDescriptor* desc);
+RUNTIME_API void cgpu_free_query_pool_null(CGPUQueryPoolId pool);
+
+// Queue APIs
+RUNTIME_API CGPUQueueId cgpu_get_queue_null(CGPUDeviceId device, ECGPUQueueType type, uint32_t index);
+RUNTIME_API void cgpu_submit_queue_null(CGPUQueueId queue, const struct CGPUQueueSubmitDescriptor* desc);
+RUNTIME_API void cgpu_wait_queue_idle_null(CGPUQueueId queue);
+RUNTIME_API void cgpu_queue_present_null(CGPUQueueId queue, const struct CGPUQueuePresentDescriptor* desc);
+RUNTIME_API float cgpu_queue_get_timestamp_period_ns_null(CGPUQueueId queue);
+RUNTIME_API void cgpu_free_queue_null(CGPUQueueId queue);
+
+// Command APIs
+RUNTIME_API CGPUCommandPoolId cgpu_create_command_pool_null(CGPUQueueId queue, const CGPUCommandPoolDescriptor* desc);
+RUNTIME_API CGPUCommandBufferId cgpu_create_command_buffer_null(CGPUCommandPoolId pool, const struct CGPUCommandBufferDescriptor* desc);
+RUNTIME_API void cgpu_reset_command_pool_null(CGPUCommandPoolId pool);
+RUNTIME_API void cgpu_free_command_buffer_null(CGPUCommandBufferId cmd);
+RUNTIME_API void cgpu_free_command_pool_null(CGPUCommandPoolId pool);
+
+// Shader APIs
+RUNTIME_API CGPUShaderLibraryId cgpu_create_shader_library_null(CGPUDeviceId device, const struct CGPUShaderLibraryDescriptor* desc);
+RUNTIME_API void cgpu_free_shader_library_null(CGPUShaderLibraryId shader_module);
+
+// Buffer APIs
+RUNTIME_API CGPUBufferId cgpu_create_buffer_null(CGPUDeviceId device, const struct CGPUBufferDescriptor* desc);
+RUNTIME_API void cgpu_map_buffer_null(CGPUBufferId buffer, const struct CGPUBufferRange* range);
+RUNTIME_API void cgpu_unmap_buffer_null(CGPUBufferId buffer);
+RUNTIME_API void cgpu_free_buffer_null(CGPUBufferId buffer);
+
+// Sampler APIs
+RUNTIME_API CGPUSamplerId cgpu_create_sampler_null(CGPUDeviceId device, const struct CGPUSamplerDescriptor* desc);
+RUNTIME_API void cgpu_free_sampler_null(CGPUSamplerId sampler);
+
+// Texture/TextureView APIs
+RUNTIME_API CGPUTextureId cgpu_create_texture_null(CGPUDeviceId device, const struct CGPUTextureDescriptor* desc);
+RUNTIME_API void cgpu_free_texture_null(CGPUTextureId texture);
+RUNTIME_API CGPUTextureViewId cgpu_create_texture_view_null(CGPUDeviceId device, const struct CGPUTextureViewDescriptor* desc);
+RUNTIME_API void cgpu_free_texture_view_null(CGPUTextureViewId render_target);
+RUNTIME_API bool cgpu_try_bind_aliasing_texture_null(CGPUDeviceId device, const struct CGPUTextureAliasingBindDescriptor* desc);
+
+// Swapchain APIs
+RUNTIME_API CGPUSwapChainId cgpu_create_swapchain_null(CGPUDeviceId device, const CGPUSwapChainDescriptor* desc);
+RUNTIME_API uint32_t cgpu_acquire_next_image_null(CGPUSwapChainId swapchain, const struct CGPUAcquireNextDescriptor* desc);
+RUNTIME_API void cgpu_free_swapchain_null(CGPUSwapChainId swapchain);
+RUNTIME_API void cgpu_free_surface_null(CGPUDeviceId device, CGPUSurfaceId surface);
+
+// CMDs
+RUNTIME_API void cgpu_cmd_begin_null(CGPUCommandBufferId cmd);
+RUNTIME_API void cgpu_cmd_transfer_buffer_to_buffer_null(CGPUCommandBufferId cmd, const struct CGPUBufferToBufferTransfer* desc);
+RUNTIME_API void cgpu_cmd_transfer_buffer_to_texture_null(CGPUCommandBufferId cmd, const struct CGPUBufferToTextureTransfer* desc);
+RUNTIME_API void cgpu_cmd_transfer_texture_to_texture_null(CGPUCommandBufferId cmd, const struct CGPUTextureToTextureTransfer* desc);
+RUNTIME_API void cgpu_cmd_resource_barrier_null(CGPUCommandBufferId cmd, const struct CGPUResourceBarrierDescriptor* desc);
+RUNTIME_API void cgpu_cmd_begin_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, const struct CGPUQueryDescriptor* desc);
+RUNTIME_API void cgpu_cmd_end_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, const struct CGPUQueryDescriptor* desc);
+RUNTIME_API void cgpu_cmd_reset_query_pool_null(CGPUCommandBufferId cmd, CGPUQueryPoolId, uint32_t start_query, uint32_t query_count);
+RUNTIME_API void cgpu_cmd_resolve_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, CGPUBufferId readback, uint32_t start_query, uint32_t query_count);
+RUNTIME_API void cgpu_cmd_end_null(CGPUCommandBufferId cmd);
+
+// Events
+RUNTIME_API void cgpu_cmd_begin_event_null(CGPUCommandBufferId cmd, const CGPUEventInfo* event);
+RUNTIME_API void cgpu_cmd_set_marker_null(CGPUCommandBufferId cmd, const CGPUMarkerInfo* marker);
+RUNTIME_API void cgpu_cmd_end_event_null(CGPUCommandBufferId cmd);
+
+// Compute CMDs
+RUNTIME_API CGPUComputePassEncoderId cgpu_cmd_begin_compute_pass_null(CGPUCommandBufferId cmd, const struct CGPUComputePassDescriptor* desc);
+RUNTIME_API void cgpu_compute_encoder_bind_descriptor_set_null(CGPUComputePassEncoderId encoder, CGPUDescriptorSetId descriptor);
+RUNTIME_API void cgpu_compute_encoder_push_constants_null(CGPUComputePassEncoderId encoder, CGPURootSignatureId rs, const char8_t* name, const void* data);
+RUNTIME_API void cgpu_compute_encoder_bind_pipeline_null(CGPUComputePassEncoderId encoder, CGPUComputePipelineId pipeline);
+RUNTIME_API void cgpu_compute_encoder_dispatch_null(CGPUComputePassEncoderId encoder, uint32_t X, uint32_t Y, uint32_t Z);
+RUNTIME_API void cgpu_cmd_end_compute_pass_null(CGPUCommandBufferId cmd, CGPUComputePassEncoderId encoder);
+
+// Render CMDs
+RUNTIME_API CGPURenderPassEncoderId cgpu_cmd_begin_render_pass_null(CGPUCommandBufferId cmd, const struct CGPURenderPassDescriptor* desc);
+RUNTIME_API void cgpu_render_encoder_set_shading_rate_null(CGPURenderPassEncoderId encoder, ECGPUShadingRate shading_rate, ECGPUShadingRateCombiner post_rasterizer_rate, ECGPUShadingRateCombiner final_rate);
+RUNTIME_API void cgpu_render_encoder_bind_descriptor_set_null(CGPURenderPassEncoderId encoder, CGPUDescriptorSetId descriptor);
+RUNTIME_API void cgpu_render_encoder_set_viewport_null(CGPURenderPassEncoderId encoder, float x, float y, float width, float height, float min_depth, float max_depth);
+RUNTIME_API void cgpu_render_encoder_set_scissor_null(CGPURenderPassEncoderId encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+RUNTIME_API void cgpu_render_encoder_bind_pipeline_null(CGPURenderPassEncoderId encoder, CGPURenderPipelineId pipeline);
+RUNTIME_API void cgpu_render_encoder_bind_vertex_buffers_null(CGPURenderPassEncoderId encoder, uint32_t buffer_count, const CGPUBufferId* buffers, const uint32_t* strides, const uint32_t* offsets);
+RUNTIME_API void cgpu_render_encoder_bind_index_buffer_null(CGPURenderPassEncoderId encoder, CGPUBufferId buffer, uint32_t index_stride, uint64_t offset);
+RUNTIME_API void cgpu_render_encoder_push_constants_null(CGPURenderPassEncoderId encoder, CGPURootSignatureId rs, const char8_t* name, const void* data);
+RUNTIME_API void cgpu_render_encoder_draw_null(CGPURenderPassEncoderId encoder, uint32_t vertex_count, uint32_t first_vertex);
+RUNTIME_API void cgpu_render_encoder_draw_instanced_null(CGPURenderPassEncoderId encoder, uint32_t vertex_count, uint32_t first_vertex, uint32_t instance_count, uint32_t first_instance);
+RUNTIME_API void cgpu_render_encoder_draw_indexed_null(CGPURenderPassEncoderId encoder, uint32_t index_count, uint32_t first_index, uint32_t first_vertex);
+RUNTIME_API void cgpu_render_encoder_draw_indexed_instanced_null(CGPURenderPassEncoderId encoder, uint32_t index_count, uint32_t first_index, uint32_t instance_count, uint32_t first_instance, uint32_t first_vertex);
+RUNTIME_API void cgpu_cmd_end_render_pass_null(CGPUCommandBufferId cmd, CGPURenderPassEncoderId encoder);
+
+typedef struct CGPUInstance_Null {
+    CGPUInstance super;
+    struct CGPUAdapter_Null* adapter;
+} CGPUInstance_Null;
+
+typedef struct CGPUAdapter_Null {
+    CGPUAdapter super;
+    CGPUAdapterDetail adapter_detail;
+} CGPUAdapter_Null;
+
+typedef struct CGPUDevice_Null {
+    CGPUDevice super;
+    SAtomicU64 buffers_created;
+    SAtomicU64 textures_created;
+    SAtomicU64 render_pipelines_created;
+    SAtomicU64 descriptor_sets_updated;
+    SAtomicU64 descriptors_written;
+    SAtomicU64 allocated_bytes;
+    SAtomicU64 peak_allocated_bytes;
+    SAtomicU64 submits;
+    SAtomicU64 command_buffers_submitted;
+    SAtomicU64 commands_submitted;
+    SAtomicU64 buffer_barriers;
+    SAtomicU64 texture_barriers;
+    SAtomicU64 render_passes;
+    SAtomicU64 compute_passes;
+    SAtomicU64 draws;
+    SAtomicU64 dispatches;
+    SAtomicU64 copies;
+    SAtomicU64 presents;
+} CGPUDevice_Null;
+
+typedef struct CGPUFence_Null {
+    CGPUFence super;
+    bool submitted;
+} CGPUFence_Null;
+
+typedef struct CGPUQueue_Null {
+    CGPUQueue super;
+} CGPUQueue_Null;
+
+typedef struct CGPUCommandBuffer_Null {
+    CGPUCommandBuffer super;
+    uint8_t* stream;
+    uint64_t stream_size;
+    uint64_t stream_capacity;
+    uint32_t command_count;
+} CGPUCommandBuffer_Null;
+
+typedef struct CGPUDescriptorSet_Null {
+    CGPUDescriptorSet super;
+    // first resource written to each parameter of the set's table, indexed like CGPUParameterTable::resources
+    const void** bindings;
+    uint32_t bindings_count;
+} CGPUDescriptorSet_Null;
+
+typedef struct CGPUBuffer_Null {
+    CGPUBuffer super;
+    // host memory of CPU visible buffers, GPU only buffers are only accounted for
+    uint8_t* host_memory;
+    uint64_t allocated_size;
+} CGPUBuffer_Null;
+
+typedef struct CGPUTexture_Null {
+    CGPUTexture super;
+    uint64_t alignment;
+    // the texture owning the memory and the offset inside it once an aliasing texture is bound
+    CGPUTextureId aliased;
+    uint64_t aliased_offset;
+} CGPUTexture_Null;
+
+typedef struct CGPUSwapChain_Null {
+    CGPUSwapChain super;
+    uint32_t current_index;
+} CGPUSwapChain_Null;
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
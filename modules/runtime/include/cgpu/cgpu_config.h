@@ -2,6 +2,8 @@
 #include "platform/configure.h"
 
 #define CGPU_USE_VULKAN
+// headless backend, records commands and never touches a device
+#define CGPU_USE_NULL
 
 #ifdef _WIN32
     #define CGPU_USE_D3D12
@@ -1112,6 +1112,17 @@ static FORCEINLINE uint32_t FormatUtil_HeightOfBlock(ECGPUFormat const fmt) {
 }
 /* clang-format on */
 
+// bytes between two block rows of a buffer copied to a texture, rows are padded to row_alignment
+// only if the padded pitch still holds whole blocks, so that every backend can express it in texels
+static FORCEINLINE uint32_t FormatUtil_RowPitch(ECGPUFormat const fmt, uint32_t width, uint32_t row_alignment) {
+    const uint32_t block_bytes = FormatUtil_BitSizeOfBlock(fmt) / 8;
+    const uint32_t block_width = FormatUtil_WidthOfBlock(fmt);
+    const uint32_t row_bytes = ((width + block_width - 1) / block_width) * block_bytes;
+    if (row_alignment <= 1 || block_bytes == 0) return row_bytes;
+    const uint32_t pitch = ((row_bytes + row_alignment - 1) / row_alignment) * row_alignment;
+    return (pitch % block_bytes == 0) ? pitch : row_bytes;
+}
+
 #ifdef __cplusplus
 } // end extern "C"
 #endif
@@ -63,6 +63,8 @@ typedef struct skr_vram_texture_io_t {
         uint32_t height;
         uint32_t depth;
         ECGPUFormat format;
+        // 0 is treated as 1
+        uint32_t mip_levels;
     } vtexture;
     // Direct Storage
     struct
@@ -79,6 +81,13 @@ typedef struct skr_vram_texture_io_t {
         const uint8_t* bytes;
         uint64_t size;
     } src_memory;
+    // levels [first_mip, first_mip + mip_count) are copied from the source, 0 copies every level from first_mip
+    // the texture of the destination is reused if set, the levels it already holds are left untouched
+    uint32_t first_mip;
+    uint32_t mip_count;
+    // byte offsets of the copied levels in the source data (memory or dstorage file) indexed from first_mip,
+    // blocks of a level are tightly packed, the levels follow each other from first_mip if null
+    const uint64_t* mip_offsets;
     SkrAsyncServicePriority priority;
     float sub_priority; /*0.f ~ 1.f*/
     skr_async_callback_t callbacks[SKR_ASYNC_IO_STATUS_COUNT];
@@ -95,6 +104,10 @@ typedef struct skr_vram_io_service_desc_t {
     bool lockless;
     SkrAsyncServiceSortMethod sort_method;
     SkrAsyncServiceSleepMode sleep_mode;
+    // size of the persistent upload buffer each device stages uploads in, 0 for the default
+    uint64_t staging_ring_size;
+    // bytes of memory uploads gathered into one batch per service tick, 0 for no limit
+    uint64_t upload_budget;
 } skr_vram_io_service_desc_t;
 
 
@@ -39,6 +39,7 @@ public:
 
     skr_json_writer_t(size_t levelDepth, skr_json_format_t format = skr_json_format_t());
     inline bool IsComplete() { return _hasRoot && _levelStack.empty(); }
+    void Reset();
     skr::string Str() const;
     bool Bool(bool b);
     bool Int(int32_t i);
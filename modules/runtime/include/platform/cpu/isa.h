@@ -0,0 +1,6 @@
+#pragma once
+#include "platform/configure.h"
+
+// true when the cpu has avx2 and fma3 and the os saves the ymm registers,
+// kernels built with avx2 flags beyond the target baseline may only run after this passes
+RUNTIME_EXTERN_C RUNTIME_API bool skr_cpu_has_avx2(void);
@@ -4,6 +4,7 @@
 #include <containers/span.hpp>
 #include "containers/string.hpp"
 #include "type/type_helper.hpp"
+#include <atomic>
 
 #if defined(__cplusplus)
 namespace skr
@@ -36,6 +37,8 @@ RUNTIME_API size_t Hash(const skr_resource_handle_t& value, size_t base);
 RUNTIME_API size_t Hash(const skr::string& value, size_t base);
 RUNTIME_API size_t Hash(const skr::string_view& value, size_t base);
 
+struct TypePlan;
+
 template <class T>
 auto GetCopyCtor();
 template <class T>
@@ -334,6 +337,7 @@ struct RUNTIME_API ArrayType : skr_type_t {
     size_t num;
     size_t size;
     skr::string name;
+    mutable std::atomic<const TypePlan*> plan = { nullptr };
     ArrayType(const struct skr_type_t* elementType, size_t num, size_t size)
         : skr_type_t{ SKR_TYPE_CATEGORY_ARR }
         , elementType(elementType)
@@ -365,6 +369,18 @@ struct RUNTIME_API ArrayViewType : skr_type_t {
     {
     }
 };
+// traits of a record collected by codegen, used to compile TypePlan
+enum ERecordFlags : uint32_t
+{
+    // copy ctor is implicit and copies member by member (aggregate with all fields reflected)
+    RECORD_FLAG_MEMBERWISE_COPY = 1 << 0,
+    RECORD_FLAG_TRIVIAL_COPY = 1 << 1,
+    RECORD_FLAG_TRIVIAL_CTOR = 1 << 2,
+    // binary serializer writes the reflected fields in order without configs
+    RECORD_FLAG_MEMBERWISE_BINARY = 1 << 3,
+    // json serializer writes the reflected fields in order as object keys
+    RECORD_FLAG_MEMBERWISE_JSON = 1 << 4,
+};
 // struct/class T
 struct RUNTIME_API RecordType : skr_type_t {
     size_t size = 0;
@@ -376,12 +392,14 @@ struct RUNTIME_API RecordType : skr_type_t {
     ObjectMethodTable nativeMethods = {};
     const skr::span<struct skr_field_t> fields = {};
     const skr::span<struct skr_method_t> methods = {};
+    uint32_t flags = 0;
+    mutable std::atomic<const TypePlan*> plan = { nullptr };
     bool IsBaseOf(const RecordType& other) const;
     static const RecordType* FromName(skr::string_view name);
     static void Register(const RecordType* type);
     RecordType() = default;
     RecordType(size_t size, size_t align, skr::string_view name, skr_guid_t guid, bool object, const RecordType* base, ObjectMethodTable nativeMethods,
-    const skr::span<struct skr_field_t> fields, const skr::span<struct skr_method_t> methods)
+    const skr::span<struct skr_field_t> fields, const skr::span<struct skr_method_t> methods, uint32_t flags = 0)
         : skr_type_t{ SKR_TYPE_CATEGORY_OBJ }
         , size(size)
         , align(align)
@@ -392,6 +410,7 @@ struct RUNTIME_API RecordType : skr_type_t {
         , nativeMethods(nativeMethods)
         , fields(fields)
         , methods(methods)
+        , flags(flags)
     {
     }
 };
@@ -0,0 +1,52 @@
+#pragma once
+#include "type/type.hpp"
+#include "containers/vector.hpp"
+
+#if defined(__cplusplus)
+namespace skr
+{
+namespace type
+{
+// a flattened operation of a compiled type plan
+// adjacent trivial fields are merged into a single Bytes op, non-trivial fields are kept as Call ops
+struct TypePlanOp {
+    enum EKind : uint8_t
+    {
+        // memcpy / raw write of [offset, offset + size)
+        Bytes,
+        // dispatch to type->Copy/Serialize/SerializeText at offset
+        Call,
+        // json only: write field name as key
+        Key,
+    };
+    EKind kind = Bytes;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    const skr_type_t* type = nullptr;
+    skr::string_view name = "";
+};
+
+// per-type compiled plan, built on first use and cached on the type
+// an empty op list means the operation is not compilable and the native method should be used
+struct RUNTIME_API TypePlan {
+    const skr_type_t* type = nullptr;
+    // value-initialize the whole object with memset
+    bool zeroConstruct = false;
+    bool compiledCopy = false;
+    bool compiledSerialize = false;
+    bool compiledSerializeText = false;
+    skr::vector<TypePlanOp> copyOps;
+    skr::vector<TypePlanOp> serializeOps;
+    skr::vector<TypePlanOp> serializeTextOps;
+
+    void Construct(void* dst) const;
+    void Copy(void* dst, const void* src) const;
+    int Serialize(const void* dst, skr_binary_writer_t* writer) const;
+    void SerializeText(const void* dst, skr_json_writer_t* writer) const;
+};
+
+// returns nullptr for types that have no plan (only records and fixed arrays are compiled)
+RUNTIME_API const TypePlan* GetTypePlan(const skr_type_t* type);
+} // namespace type
+} // namespace skr
+#endif
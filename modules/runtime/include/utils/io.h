@@ -93,6 +93,8 @@ typedef void (*skr_async_callback_t)(skr_async_request_t* request, void* data);
 typedef struct skr_ram_io_t {
     const char8_t* path SKR_IF_CPP(= nullptr);
     uint64_t offset SKR_IF_CPP(= 0);
+    // bytes to read from offset, 0 reads to the end of the file
+    uint64_t size SKR_IF_CPP(= 0);
     SkrAsyncServicePriority priority SKR_IF_CPP(= SKR_ASYNC_SERVICE_PRIORITY_NORMAL);
     float sub_priority SKR_IF_CPP(= 0.f); /*0.f ~ 1.f*/
     skr_async_callback_t callbacks[SKR_ASYNC_IO_STATUS_COUNT];
@@ -11,4 +11,8 @@
 #ifdef CGPU_USE_D3D12
     #include "d3d12/proc_table.c"
 #endif
+#ifdef CGPU_USE_NULL
+    #include "null/proc_table.c"
+    #include "null/cgpu_null.c"
+#endif
 #include "common/cgpu.c"
\ No newline at end of file
@@ -11,6 +11,9 @@
 #ifdef CGPU_USE_METAL
     #include "cgpu/backend/metal/cgpu_metal.h"
 #endif
+#ifdef CGPU_USE_NULL
+    #include "cgpu/backend/null/cgpu_null.h"
+#endif
 #ifdef __APPLE__
     #include "TargetConditionals.h"
     #if TARGET_OS_MAC
@@ -30,7 +33,7 @@
 
 RUNTIME_API CGPUInstanceId cgpu_create_instance(const CGPUInstanceDescriptor* desc)
 {
-    cgpu_assert((desc->backend == CGPU_BACKEND_VULKAN || desc->backend == CGPU_BACKEND_D3D12 || desc->backend == CGPU_BACKEND_METAL) && "CGPU support only vulkan & d3d12 & metal currently!");
+    cgpu_assert((desc->backend == CGPU_BACKEND_VULKAN || desc->backend == CGPU_BACKEND_D3D12 || desc->backend == CGPU_BACKEND_METAL || desc->backend == CGPU_BACKEND_NULL) && "CGPU support only vulkan & d3d12 & metal & null currently!");
     const CGPUProcTable* tbl = CGPU_NULLPTR;
     const CGPUSurfacesProcTable* s_tbl = CGPU_NULLPTR;
 
@@ -57,6 +60,13 @@ RUNTIME_API CGPUInstanceId cgpu_create_instance(const CGPUInstanceDescriptor* de
         tbl = CGPU_D3D12ProcTable();
         s_tbl = CGPU_D3D12SurfacesProcTable();
     }
+#endif
+#ifdef CGPU_USE_NULL
+    else if (desc->backend == CGPU_BACKEND_NULL)
+    {
+        tbl = CGPU_NullProcTable();
+        s_tbl = CGPU_NullSurfacesProcTable();
+    }
 #endif
     CGPUInstance* instance = (CGPUInstance*)tbl->create_instance(desc);
     *(bool*)&instance->enable_set_name = desc->enable_set_name;
@@ -59,6 +59,7 @@ FORCEINLINE static void* _aligned_calloc(size_t nelem, size_t elsize, size_t ali
     #define cgpu_calloc calloc
     #define cgpu_callocN(count, size, ...) calloc((count), (size))
     #define cgpu_calloc_aligned _aligned_calloc
+    #define cgpu_realloc realloc
     #define cgpu_memalign _aligned_malloc
     #define cgpu_free free
     #define cgpu_freeN(ptr, ...) free(ptr)
@@ -70,6 +71,7 @@ FORCEINLINE static void* _aligned_calloc(size_t nelem, size_t elsize, size_t ali
     #define cgpu_calloc sakura_calloc
     #define cgpu_callocN sakura_callocN
     #define cgpu_calloc_aligned sakura_calloc_aligned
+    #define cgpu_realloc sakura_realloc
     #define cgpu_memalign sakura_malloc_aligned
     #define cgpu_free sakura_free
     #define cgpu_freeN sakura_freeN
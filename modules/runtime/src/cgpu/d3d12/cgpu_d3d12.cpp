@@ -1451,6 +1451,7 @@ void cgpu_cmd_resource_barrier_d3d12(CGPUCommandBufferId cmd, const struct CGPUR
                 cgpu_assert((pTransBarrier->src_state != pTransBarrier->dst_state) && "D3D12 ERROR: Buffer Barrier with same src and dst state!");
 
                 pBarrier->Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                pBarrier->Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
                 if (pTransBarrier->d3d12.begin_ony)
                 {
                     pBarrier->Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
@@ -1459,7 +1460,6 @@ void cgpu_cmd_resource_barrier_d3d12(CGPUCommandBufferId cmd, const struct CGPUR
                 {
                     pBarrier->Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
                 }
-                pBarrier->Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
                 pBarrier->Transition.pResource = pBuffer->pDxResource;
                 pBarrier->Transition.Subresource =
                 D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
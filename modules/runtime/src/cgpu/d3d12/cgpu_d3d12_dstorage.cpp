@@ -257,8 +257,8 @@ void cgpu_dstorage_enqueue_texture_request_d3d12(CGPUDStorageQueueId queue, cons
         request.Source.Memory.Size = (uint32_t)desc->source_memory.bytes_size;
     }
     request.Destination.Texture.Resource = pTexture->pDxResource;
-    // TODO: Support mip & array
-    request.Destination.Texture.SubresourceIndex = 0; // mipIndex + (arrayIndex * textureMetaData.mipLevels);
+    // TODO: Support array
+    request.Destination.Texture.SubresourceIndex = desc->mip_level; // mipIndex + (arrayIndex * textureMetaData.mipLevels);
     request.Destination.Texture.Region = { 0, 0, 0, 0, 0, 0 };
     request.Destination.Texture.Region.right = desc->width;
     request.Destination.Texture.Region.bottom = desc->height;
@@ -672,6 +672,13 @@ CGPUTextureId cgpu_create_texture_d3d12(CGPUDeviceId device, const struct CGPUTe
             CGPU_SINGLE_GPU_NODE_MASK, 1, &ResDesc);
         T->super.size_in_bytes = allocDesc.SizeInBytes;
     }
+    else if (desc->is_aliasing)
+    {
+        // the resource is only created on bind, report the memory it needs so callers can place it
+        auto allocDesc = D->pDxDevice->GetResourceAllocationInfo(
+            CGPU_SINGLE_GPU_NODE_MASK, 1, &resDesc);
+        T->super.size_in_bytes = allocDesc.SizeInBytes;
+    }
     T->super.is_imported = false;
     // Set debug name
     if (device->adapter->instance->enable_set_name && desc->name && T->pDxResource)
@@ -696,17 +703,17 @@ bool cgpu_try_bind_aliasing_texture_d3d12(CGPUDeviceId device, const struct CGPU
         if (Aliased->pDxResource != nullptr &&
             Aliased->pDxAllocation != nullptr &&
             !Aliased->super.is_dedicated &&
-            Aliasing->super.is_aliasing)
+            Aliasing->super.is_aliasing &&
+            Aliased->super.size_in_bytes >= desc->offset + Aliasing->super.size_in_bytes)
         {
             result = D->pResourceAllocator->CreateAliasingResource(Aliased->pDxAllocation,
-            0, &Aliasing->mDxDesc,
+            desc->offset, &Aliasing->mDxDesc,
             D3D12_RESOURCE_STATE_COMMON,
             nullptr,
             IID_PPV_ARGS(&Aliasing->pDxResource));
             if (result == S_OK)
             {
                 Aliasing->pDxAllocation = Aliased->pDxAllocation;
-                Aliasing->super.size_in_bytes = Aliased->super.size_in_bytes;
                 Aliasing->super.native_handle = Aliased->super.native_handle;
                 // Set debug name
                 if (device->adapter->instance->enable_set_name)
@@ -7,6 +7,9 @@ extern void cgpu_marker_buffer_write_d3d12(CGPUCommandBufferId cmd, CGPUMarkerBu
 #ifdef CGPU_USE_VULKAN
 extern void cgpu_marker_buffer_write_vulkan(CGPUCommandBufferId cmd, CGPUMarkerBufferId buffer, uint32_t index, uint32_t value);
 #endif
+#ifdef CGPU_USE_NULL
+    #include "cgpu/backend/null/cgpu_null.h"
+#endif
 
 bool cgpu_device_support_marker_buffer(CGPUDeviceId device)
 {
@@ -15,7 +18,7 @@ bool cgpu_device_support_marker_buffer(CGPUDeviceId device)
     // Intel  ID3D12GraphicsCommandList2 & vkCmdFillBuffer
     const auto amd = cgpux_adapter_is_amd(device->adapter);(void)amd;
     const auto backend = device->adapter->instance->backend;
-    return (backend == CGPU_BACKEND_D3D12) || (backend == CGPU_BACKEND_VULKAN);
+    return (backend == CGPU_BACKEND_D3D12) || (backend == CGPU_BACKEND_VULKAN) || (backend == CGPU_BACKEND_NULL);
 }
 
 CGPUMarkerBufferId cgpu_create_marker_buffer(CGPUDeviceId device, CGPUMarkerBufferDescriptor const* descriptor)
@@ -48,6 +51,12 @@ void cgpu_marker_buffer_write(CGPUCommandBufferId cmd, CGPUMarkerBufferId buffer
         cgpu_marker_buffer_write_vulkan(cmd, buffer, index, value);
     }
 #endif    
+#ifdef CGPU_USE_NULL
+    if (backend == CGPU_BACKEND_NULL)
+    {
+        cgpu_null_cmd_write_buffer_marker(cmd, buffer->cgpu_buffer, index * sizeof(uint32_t), value);
+    }
+#endif
 }
 
 void cgpu_free_marker_buffer(CGPUMarkerBufferId buffer)
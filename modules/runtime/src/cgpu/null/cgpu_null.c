@@ -0,0 +1,1244 @@
+#include "cgpu/backend/null/cgpu_null.h"
+#include "cgpu/flags.h"
+#include "../common/common_utils.h"
+#ifdef CGPU_USE_VULKAN
+    // SPIR-V reflection is shared with the vulkan backend
+    #include "../vulkan/vulkan_utils.h"
+#endif
+#include <string.h>
+
+// placement rules of desktop drivers, resources report the sizes they would be given there
+#define CGPU_NULL_DEFAULT_RESOURCE_ALIGNMENT (64ull * 1024)
+#define CGPU_NULL_SMALL_RESOURCE_ALIGNMENT (4ull * 1024)
+#define CGPU_NULL_MSAA_RESOURCE_ALIGNMENT (4ull * 1024 * 1024)
+#define CGPU_NULL_BUFFER_ALIGNMENT 256ull
+#define CGPU_NULL_ROW_PITCH_ALIGNMENT 256
+#define CGPU_NULL_VIDEO_MEMORY_BUDGET (8ull * 1024 * 1024 * 1024)
+#define CGPU_NULL_SHARED_MEMORY_BUDGET (16ull * 1024 * 1024 * 1024)
+
+#define CGPU_NULL_RECORD_ALIGNMENT 8
+#define CGPU_NULL_STREAM_INITIAL_CAPACITY (4 * 1024)
+#define CGPU_NULL_SPIRV_MAGIC 0x07230203
+
+// Helpers
+static void NullUtil_Allocate(CGPUDevice_Null* D, uint64_t size)
+{
+    const uint64_t allocated = skr_atomicu64_add_relaxed(&D->allocated_bytes, size) + size;
+    uint64_t peak = skr_atomicu64_load_relaxed(&D->peak_allocated_bytes);
+    while (allocated > peak)
+    {
+        const uint64_t prev = skr_atomicu64_cas_relaxed(&D->peak_allocated_bytes, peak, allocated);
+        if (prev == peak) break;
+        peak = prev;
+    }
+}
+
+static void NullUtil_Free(CGPUDevice_Null* D, uint64_t size)
+{
+    skr_atomicu64_add_relaxed(&D->allocated_bytes, 0 - size);
+}
+
+// 256 byte aligned rows per mip like D3D12 subresource footprints,
+// small textures go to 4KB placements, MSAA ones to 4MB and everything else to 64KB
+static uint64_t NullUtil_TextureSize(const CGPUTextureDescriptor* desc, uint64_t* alignment)
+{
+    const ECGPUFormat format = desc->format;
+    const uint32_t block_height = FormatUtil_HeightOfBlock(format);
+    const bool is_3d = (desc->depth > 1) && !(desc->flags & CGPU_TCF_FORCE_2D);
+    uint64_t size = 0;
+    for (uint32_t mip = 0; mip < desc->mip_levels; mip++)
+    {
+        const uint32_t width = cgpu_max(1u, desc->width >> mip);
+        const uint32_t height = cgpu_max(1u, desc->height >> mip);
+        const uint32_t depth = is_3d ? cgpu_max(1u, desc->depth >> mip) : 1u;
+        const uint64_t rows = (height + block_height - 1) / block_height;
+        size += (uint64_t)FormatUtil_RowPitch(format, width, CGPU_NULL_ROW_PITCH_ALIGNMENT) * rows * depth;
+    }
+    size *= (uint64_t)desc->array_size * (uint64_t)desc->sample_count;
+    const bool attachment = desc->descriptors & (CGPU_RESOURCE_TYPE_RENDER_TARGET | CGPU_RESOURCE_TYPE_DEPTH_STENCIL);
+    if (desc->sample_count > CGPU_SAMPLE_COUNT_1)
+        *alignment = CGPU_NULL_MSAA_RESOURCE_ALIGNMENT;
+    else if (!attachment && size <= CGPU_NULL_DEFAULT_RESOURCE_ALIGNMENT)
+        *alignment = CGPU_NULL_SMALL_RESOURCE_ALIGNMENT;
+    else
+        *alignment = CGPU_NULL_DEFAULT_RESOURCE_ALIGNMENT;
+    return cgpu_round_up(cgpu_max(size, 1ull), *alignment);
+}
+
+static bool NullUtil_IsHostVisible(const CGPUBufferDescriptor* desc)
+{
+    return (desc->memory_usage != CGPU_MEM_USAGE_GPU_ONLY) || (desc->flags & CGPU_BCF_HOST_VISIBLE);
+}
+
+static void* NullUtil_Record(CGPUCommandBufferId cmd, ECGPUNullCommandType type, uint64_t size)
+{
+    CGPUCommandBuffer_Null* Cmd = (CGPUCommandBuffer_Null*)cmd;
+    const uint64_t record_size = cgpu_round_up(size, CGPU_NULL_RECORD_ALIGNMENT);
+    if (Cmd->stream_size + record_size > Cmd->stream_capacity)
+    {
+        uint64_t capacity = Cmd->stream_capacity ? Cmd->stream_capacity * 2 : CGPU_NULL_STREAM_INITIAL_CAPACITY;
+        while (capacity < Cmd->stream_size + record_size) capacity *= 2;
+        Cmd->stream = (uint8_t*)cgpu_realloc(Cmd->stream, capacity);
+        Cmd->stream_capacity = capacity;
+    }
+    CGPUNullCommand* command = (CGPUNullCommand*)(Cmd->stream + Cmd->stream_size);
+    memset(command, 0, record_size);
+    command->type = type;
+    command->size = (uint32_t)record_size;
+    Cmd->stream_size += record_size;
+    Cmd->command_count++;
+    return command;
+}
+
+static void NullUtil_RecordName(CGPUCommandBufferId cmd, ECGPUNullCommandType type, const char8_t* name, const float color[4])
+{
+    const size_t name_size = name ? strlen(name) + 1 : 1;
+    CGPUNullCmdEvent* E = (CGPUNullCmdEvent*)NullUtil_Record(cmd, type, sizeof(CGPUNullCmdEvent) + name_size);
+    if (color) memcpy(E->color, color, sizeof(E->color));
+    if (name) memcpy(E + 1, name, name_size);
+}
+
+static uint32_t NullUtil_PushConstantSize(CGPURootSignatureId rs, const char8_t* name)
+{
+    if (rs->push_constant_count == 0) return 0;
+    if (name != CGPU_NULLPTR)
+    {
+        const size_t name_hash = cgpu_name_hash(name, strlen(name));
+        for (uint32_t i = 0; i < rs->push_constant_count; i++)
+        {
+            if (rs->push_constants[i].name_hash == name_hash)
+                return rs->push_constants[i].size;
+        }
+    }
+    return rs->push_constants[0].size;
+}
+
+// executes what the CPU can observe of a recorded stream and counts the work
+static void NullUtil_ExecuteCommandBuffer(CGPUDevice_Null* D, CGPUCommandBufferId cmd)
+{
+    DECLARE_ZERO(CGPUNullDeviceStatistics, stats)
+    for (const CGPUNullCommand* command = cgpu_null_command_buffer_first(cmd); command;
+         command = cgpu_null_command_buffer_next(cmd, command))
+    {
+        stats.commands_submitted++;
+        switch (command->type)
+        {
+            case CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_BUFFER: {
+                const CGPUBufferToBufferTransfer* T = &((const CGPUNullCmdTransferBufferToBuffer*)command)->transfer;
+                const CGPUBuffer_Null* Src = (const CGPUBuffer_Null*)T->src;
+                const CGPUBuffer_Null* Dst = (const CGPUBuffer_Null*)T->dst;
+                if (Src->host_memory && Dst->host_memory)
+                {
+                    cgpu_assert(T->src_offset + T->size <= T->src->size && T->dst_offset + T->size <= T->dst->size);
+                    memmove(Dst->host_memory + T->dst_offset, Src->host_memory + T->src_offset, T->size);
+                }
+                stats.copies++;
+            }
+            break;
+            case CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_TEXTURE:
+            case CGPU_NULL_COMMAND_TRANSFER_TEXTURE_TO_TEXTURE:
+                stats.copies++;
+                break;
+            case CGPU_NULL_COMMAND_RESOURCE_BARRIER: {
+                const CGPUNullCmdResourceBarrier* B = (const CGPUNullCmdResourceBarrier*)command;
+                stats.buffer_barriers += B->buffer_barriers_count;
+                stats.texture_barriers += B->texture_barriers_count;
+            }
+            break;
+            case CGPU_NULL_COMMAND_RESOLVE_QUERY: {
+                // every query resolves to zero, like a GPU that takes no time
+                const CGPUNullCmdQuery* Q = (const CGPUNullCmdQuery*)command;
+                const CGPUBuffer_Null* Readback = (const CGPUBuffer_Null*)Q->readback;
+                if (Readback->host_memory)
+                {
+                    const uint64_t size = cgpu_min((uint64_t)Q->query_count * sizeof(uint64_t), (uint64_t)Q->readback->size);
+                    memset(Readback->host_memory, 0, size);
+                }
+            }
+            break;
+            case CGPU_NULL_COMMAND_WRITE_BUFFER_MARKER: {
+                const CGPUNullCmdWriteBufferMarker* M = (const CGPUNullCmdWriteBufferMarker*)command;
+                const CGPUBuffer_Null* Buffer = (const CGPUBuffer_Null*)M->buffer;
+                if (Buffer->host_memory && M->offset + sizeof(uint32_t) <= M->buffer->size)
+                    memcpy(Buffer->host_memory + M->offset, &M->value, sizeof(uint32_t));
+            }
+            break;
+            case CGPU_NULL_COMMAND_BEGIN_COMPUTE_PASS:
+                stats.compute_passes++;
+                break;
+            case CGPU_NULL_COMMAND_DISPATCH:
+                stats.dispatches++;
+                break;
+            case CGPU_NULL_COMMAND_BEGIN_RENDER_PASS:
+                stats.render_passes++;
+                break;
+            case CGPU_NULL_COMMAND_DRAW:
+                stats.draws++;
+                break;
+            default:
+                break;
+        }
+    }
+    skr_atomicu64_add_relaxed(&D->commands_submitted, stats.commands_submitted);
+    skr_atomicu64_add_relaxed(&D->buffer_barriers, stats.buffer_barriers);
+    skr_atomicu64_add_relaxed(&D->texture_barriers, stats.texture_barriers);
+    skr_atomicu64_add_relaxed(&D->render_passes, stats.render_passes);
+    skr_atomicu64_add_relaxed(&D->compute_passes, stats.compute_passes);
+    skr_atomicu64_add_relaxed(&D->draws, stats.draws);
+    skr_atomicu64_add_relaxed(&D->dispatches, stats.dispatches);
+    skr_atomicu64_add_relaxed(&D->copies, stats.copies);
+}
+
+// Inspection APIs
+const CGPUNullCommand* cgpu_null_command_buffer_first(CGPUCommandBufferId cmd)
+{
+    const CGPUCommandBuffer_Null* Cmd = (const CGPUCommandBuffer_Null*)cmd;
+    return Cmd->stream_size ? (const CGPUNullCommand*)Cmd->stream : CGPU_NULLPTR;
+}
+
+const CGPUNullCommand* cgpu_null_command_buffer_next(CGPUCommandBufferId cmd, const CGPUNullCommand* command)
+{
+    const CGPUCommandBuffer_Null* Cmd = (const CGPUCommandBuffer_Null*)cmd;
+    const uint8_t* next = (const uint8_t*)command + command->size;
+    return (next < Cmd->stream + Cmd->stream_size) ? (const CGPUNullCommand*)next : CGPU_NULLPTR;
+}
+
+uint32_t cgpu_null_command_buffer_count(CGPUCommandBufferId cmd)
+{
+    return ((const CGPUCommandBuffer_Null*)cmd)->command_count;
+}
+
+uint64_t cgpu_null_command_buffer_size(CGPUCommandBufferId cmd)
+{
+    return ((const CGPUCommandBuffer_Null*)cmd)->stream_size;
+}
+
+void cgpu_null_replay_command_buffer(CGPUCommandBufferId src, CGPUCommandBufferId dst)
+{
+    // passes are replayed on the encoder opened by the last begin
+    CGPUComputePassEncoderId compute_encoder = CGPU_NULLPTR;
+    CGPURenderPassEncoderId render_encoder = CGPU_NULLPTR;
+    for (const CGPUNullCommand* command = cgpu_null_command_buffer_first(src); command;
+         command = cgpu_null_command_buffer_next(src, command))
+    {
+        switch (command->type)
+        {
+            case CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_BUFFER:
+                cgpu_cmd_transfer_buffer_to_buffer(dst, &((const CGPUNullCmdTransferBufferToBuffer*)command)->transfer);
+                break;
+            case CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_TEXTURE:
+                cgpu_cmd_transfer_buffer_to_texture(dst, &((const CGPUNullCmdTransferBufferToTexture*)command)->transfer);
+                break;
+            case CGPU_NULL_COMMAND_TRANSFER_TEXTURE_TO_TEXTURE:
+                cgpu_cmd_transfer_texture_to_texture(dst, &((const CGPUNullCmdTransferTextureToTexture*)command)->transfer);
+                break;
+            case CGPU_NULL_COMMAND_RESOURCE_BARRIER: {
+                const CGPUNullCmdResourceBarrier* B = (const CGPUNullCmdResourceBarrier*)command;
+                const CGPUBufferBarrier* buffer_barriers = (const CGPUBufferBarrier*)(B + 1);
+                DECLARE_ZERO(CGPUResourceBarrierDescriptor, barriers)
+                barriers.buffer_barriers = buffer_barriers;
+                barriers.buffer_barriers_count = B->buffer_barriers_count;
+                barriers.texture_barriers = (const CGPUTextureBarrier*)(buffer_barriers + B->buffer_barriers_count);
+                barriers.texture_barriers_count = B->texture_barriers_count;
+                cgpu_cmd_resource_barrier(dst, &barriers);
+            }
+            break;
+            case CGPU_NULL_COMMAND_BEGIN_QUERY:
+            case CGPU_NULL_COMMAND_END_QUERY: {
+                const CGPUNullCmdQuery* Q = (const CGPUNullCmdQuery*)command;
+                DECLARE_ZERO(CGPUQueryDescriptor, query)
+                query.index = Q->start_query;
+                query.stage = Q->stage;
+                if (command->type == CGPU_NULL_COMMAND_BEGIN_QUERY)
+                    cgpu_cmd_begin_query(dst, Q->pool, &query);
+                else
+                    cgpu_cmd_end_query(dst, Q->pool, &query);
+            }
+            break;
+            case CGPU_NULL_COMMAND_RESET_QUERY_POOL: {
+                const CGPUNullCmdQuery* Q = (const CGPUNullCmdQuery*)command;
+                cgpu_cmd_reset_query_pool(dst, Q->pool, Q->start_query, Q->query_count);
+            }
+            break;
+            case CGPU_NULL_COMMAND_RESOLVE_QUERY: {
+                const CGPUNullCmdQuery* Q = (const CGPUNullCmdQuery*)command;
+                cgpu_cmd_resolve_query(dst, Q->pool, Q->readback, Q->start_query, Q->query_count);
+            }
+            break;
+            case CGPU_NULL_COMMAND_BEGIN_EVENT:
+            case CGPU_NULL_COMMAND_SET_MARKER: {
+                const CGPUNullCmdEvent* E = (const CGPUNullCmdEvent*)command;
+                DECLARE_ZERO(CGPUEventInfo, event)
+                event.name = (const char8_t*)(E + 1);
+                memcpy(event.color, E->color, sizeof(event.color));
+                if (command->type == CGPU_NULL_COMMAND_BEGIN_EVENT)
+                    cgpu_cmd_begin_event(dst, &event);
+                else
+                    cgpu_cmd_set_marker(dst, (const CGPUMarkerInfo*)&event);
+            }
+            break;
+            case CGPU_NULL_COMMAND_END_EVENT:
+                cgpu_cmd_end_event(dst);
+                break;
+            case CGPU_NULL_COMMAND_WRITE_BUFFER_MARKER: {
+                const CGPUNullCmdWriteBufferMarker* M = (const CGPUNullCmdWriteBufferMarker*)command;
+                cgpu_null_cmd_write_buffer_marker(dst, M->buffer, M->offset, M->value);
+            }
+            break;
+            case CGPU_NULL_COMMAND_BEGIN_COMPUTE_PASS: {
+                DECLARE_ZERO(CGPUComputePassDescriptor, pass)
+                pass.name = (const char8_t*)((const CGPUNullCmdBeginPass*)command + 1);
+                compute_encoder = cgpu_cmd_begin_compute_pass(dst, &pass);
+            }
+            break;
+            case CGPU_NULL_COMMAND_BIND_COMPUTE_PIPELINE:
+                cgpu_compute_encoder_bind_pipeline(compute_encoder, (CGPUComputePipelineId)((const CGPUNullCmdBindPipeline*)command)->pipeline);
+                break;
+            case CGPU_NULL_COMMAND_DISPATCH: {
+                const CGPUNullCmdDispatch* Dispatch = (const CGPUNullCmdDispatch*)command;
+                cgpu_compute_encoder_dispatch(compute_encoder, Dispatch->x, Dispatch->y, Dispatch->z);
+            }
+            break;
+            case CGPU_NULL_COMMAND_END_COMPUTE_PASS:
+                cgpu_cmd_end_compute_pass(dst, compute_encoder);
+                compute_encoder = CGPU_NULLPTR;
+                break;
+            case CGPU_NULL_COMMAND_BEGIN_RENDER_PASS: {
+                const CGPUNullCmdBeginPass* P = (const CGPUNullCmdBeginPass*)command;
+                const CGPUColorAttachment* color_attachments = (const CGPUColorAttachment*)(P + 1);
+                const CGPUDepthStencilAttachment* depth_stencil = (const CGPUDepthStencilAttachment*)(color_attachments + P->render_target_count);
+                DECLARE_ZERO(CGPURenderPassDescriptor, pass)
+                pass.sample_count = P->sample_count;
+                pass.color_attachments = color_attachments;
+                pass.render_target_count = P->render_target_count;
+                pass.depth_stencil = P->has_depth_stencil ? depth_stencil : CGPU_NULLPTR;
+                pass.name = (const char8_t*)(depth_stencil + (P->has_depth_stencil ? 1 : 0));
+                render_encoder = cgpu_cmd_begin_render_pass(dst, &pass);
+            }
+            break;
+            case CGPU_NULL_COMMAND_BIND_RENDER_PIPELINE:
+                cgpu_render_encoder_bind_pipeline(render_encoder, (CGPURenderPipelineId)((const CGPUNullCmdBindPipeline*)command)->pipeline);
+                break;
+            case CGPU_NULL_COMMAND_BIND_VERTEX_BUFFERS: {
+                const CGPUNullCmdBindVertexBuffers* V = (const CGPUNullCmdBindVertexBuffers*)command;
+                const CGPUBufferId* buffers = (const CGPUBufferId*)(V + 1);
+                const uint32_t* strides = (const uint32_t*)(buffers + V->buffer_count);
+                cgpu_render_encoder_bind_vertex_buffers(render_encoder, V->buffer_count, buffers, strides, strides + V->buffer_count);
+            }
+            break;
+            case CGPU_NULL_COMMAND_BIND_INDEX_BUFFER: {
+                const CGPUNullCmdBindIndexBuffer* I = (const CGPUNullCmdBindIndexBuffer*)command;
+                cgpu_render_encoder_bind_index_buffer(render_encoder, I->buffer, I->index_stride, I->offset);
+            }
+            break;
+            case CGPU_NULL_COMMAND_SET_VIEWPORT: {
+                const CGPUNullCmdSetViewport* V = (const CGPUNullCmdSetViewport*)command;
+                cgpu_render_encoder_set_viewport(render_encoder, V->x, V->y, V->width, V->height, V->min_depth, V->max_depth);
+            }
+            break;
+            case CGPU_NULL_COMMAND_SET_SCISSOR: {
+                const CGPUNullCmdSetScissor* S = (const CGPUNullCmdSetScissor*)command;
+                cgpu_render_encoder_set_scissor(render_encoder, S->x, S->y, S->width, S->height);
+            }
+            break;
+            case CGPU_NULL_COMMAND_SET_SHADING_RATE: {
+                const CGPUNullCmdSetShadingRate* S = (const CGPUNullCmdSetShadingRate*)command;
+                cgpu_render_encoder_set_shading_rate(render_encoder, S->shading_rate, S->post_rasterizer_rate, S->final_rate);
+            }
+            break;
+            case CGPU_NULL_COMMAND_DRAW: {
+                const CGPUNullCmdDraw* Draw = (const CGPUNullCmdDraw*)command;
+                if (Draw->indexed)
+                    cgpu_render_encoder_draw_indexed_instanced(render_encoder, Draw->element_count, Draw->first_element, Draw->instance_count, Draw->first_instance, Draw->first_vertex);
+                else
+                    cgpu_render_encoder_draw_instanced(render_encoder, Draw->element_count, Draw->first_element, Draw->instance_count, Draw->first_instance);
+            }
+            break;
+            case CGPU_NULL_COMMAND_END_RENDER_PASS:
+                cgpu_cmd_end_render_pass(dst, render_encoder);
+                render_encoder = CGPU_NULLPTR;
+                break;
+            case CGPU_NULL_COMMAND_BIND_DESCRIPTOR_SET: {
+                const CGPUNullCmdBindDescriptorSet* S = (const CGPUNullCmdBindDescriptorSet*)command;
+                if (S->pipeline_type == CGPU_PIPELINE_TYPE_COMPUTE)
+                    cgpu_compute_encoder_bind_descriptor_set(compute_encoder, S->set);
+                else
+                    cgpu_render_encoder_bind_descriptor_set(render_encoder, S->set);
+            }
+            break;
+            case CGPU_NULL_COMMAND_PUSH_CONSTANTS: {
+                // the constants are matched by name on record, replay them through the first range
+                const CGPUNullCmdPushConstants* P = (const CGPUNullCmdPushConstants*)command;
+                if (P->pipeline_type == CGPU_PIPELINE_TYPE_COMPUTE)
+                    cgpu_compute_encoder_push_constants(compute_encoder, P->root_signature, CGPU_NULLPTR, P + 1);
+                else
+                    cgpu_render_encoder_push_constants(render_encoder, P->root_signature, CGPU_NULLPTR, P + 1);
+            }
+            break;
+            default:
+                cgpu_assert(0 && "unknown null command!");
+                break;
+        }
+    }
+}
+
+void cgpu_null_query_device_statistics(CGPUDeviceId device, CGPUNullDeviceStatistics* statistics)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    statistics->buffers_created = skr_atomicu64_load_relaxed(&D->buffers_created);
+    statistics->textures_created = skr_atomicu64_load_relaxed(&D->textures_created);
+    statistics->render_pipelines_created = skr_atomicu64_load_relaxed(&D->render_pipelines_created);
+    statistics->descriptor_sets_updated = skr_atomicu64_load_relaxed(&D->descriptor_sets_updated);
+    statistics->descriptors_written = skr_atomicu64_load_relaxed(&D->descriptors_written);
+    statistics->allocated_bytes = skr_atomicu64_load_relaxed(&D->allocated_bytes);
+    statistics->peak_allocated_bytes = skr_atomicu64_load_relaxed(&D->peak_allocated_bytes);
+    statistics->submits = skr_atomicu64_load_relaxed(&D->submits);
+    statistics->command_buffers_submitted = skr_atomicu64_load_relaxed(&D->command_buffers_submitted);
+    statistics->commands_submitted = skr_atomicu64_load_relaxed(&D->commands_submitted);
+    statistics->buffer_barriers = skr_atomicu64_load_relaxed(&D->buffer_barriers);
+    statistics->texture_barriers = skr_atomicu64_load_relaxed(&D->texture_barriers);
+    statistics->render_passes = skr_atomicu64_load_relaxed(&D->render_passes);
+    statistics->compute_passes = skr_atomicu64_load_relaxed(&D->compute_passes);
+    statistics->draws = skr_atomicu64_load_relaxed(&D->draws);
+    statistics->dispatches = skr_atomicu64_load_relaxed(&D->dispatches);
+    statistics->copies = skr_atomicu64_load_relaxed(&D->copies);
+    statistics->presents = skr_atomicu64_load_relaxed(&D->presents);
+}
+
+void cgpu_null_reset_device_statistics(CGPUDeviceId device)
+{
+    // live allocations stay accounted, the peak restarts from them
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    skr_atomicu64_store_relaxed(&D->buffers_created, 0);
+    skr_atomicu64_store_relaxed(&D->textures_created, 0);
+    skr_atomicu64_store_relaxed(&D->render_pipelines_created, 0);
+    skr_atomicu64_store_relaxed(&D->descriptor_sets_updated, 0);
+    skr_atomicu64_store_relaxed(&D->descriptors_written, 0);
+    skr_atomicu64_store_relaxed(&D->peak_allocated_bytes, skr_atomicu64_load_relaxed(&D->allocated_bytes));
+    skr_atomicu64_store_relaxed(&D->submits, 0);
+    skr_atomicu64_store_relaxed(&D->command_buffers_submitted, 0);
+    skr_atomicu64_store_relaxed(&D->commands_submitted, 0);
+    skr_atomicu64_store_relaxed(&D->buffer_barriers, 0);
+    skr_atomicu64_store_relaxed(&D->texture_barriers, 0);
+    skr_atomicu64_store_relaxed(&D->render_passes, 0);
+    skr_atomicu64_store_relaxed(&D->compute_passes, 0);
+    skr_atomicu64_store_relaxed(&D->draws, 0);
+    skr_atomicu64_store_relaxed(&D->dispatches, 0);
+    skr_atomicu64_store_relaxed(&D->copies, 0);
+    skr_atomicu64_store_relaxed(&D->presents, 0);
+}
+
+void cgpu_null_cmd_write_buffer_marker(CGPUCommandBufferId cmd, CGPUBufferId buffer, uint64_t offset, uint32_t value)
+{
+    CGPUNullCmdWriteBufferMarker* M = (CGPUNullCmdWriteBufferMarker*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_WRITE_BUFFER_MARKER, sizeof(CGPUNullCmdWriteBufferMarker));
+    M->buffer = buffer;
+    M->offset = offset;
+    M->value = value;
+}
+
+// Instance APIs
+CGPUInstanceId cgpu_create_instance_null(CGPUInstanceDescriptor const* descriptor)
+{
+    CGPUInstance_Null* I = (CGPUInstance_Null*)cgpu_calloc(1, sizeof(CGPUInstance_Null));
+    CGPUAdapter_Null* A = (CGPUAdapter_Null*)cgpu_calloc(1, sizeof(CGPUAdapter_Null));
+    CGPUAdapterDetail* detail = &A->adapter_detail;
+    detail->uniform_buffer_alignment = 256;
+    detail->upload_buffer_texture_alignment = 512;
+    detail->upload_buffer_texture_row_alignment = CGPU_NULL_ROW_PITCH_ALIGNMENT;
+    detail->max_vertex_input_bindings = 32;
+    detail->wave_lane_count = 32;
+    detail->host_visible_vram_budget = 256 * 1024 * 1024;
+    detail->support_host_visible_vram = true;
+    detail->multidraw_indirect = true;
+    detail->support_geom_shader = true;
+    detail->support_tessellation = true;
+    detail->is_virtual = true;
+    detail->dynamic_state_features = CGPU_DYNAMIC_STATE_Tier1;
+    for (uint32_t i = 0; i < CGPU_FORMAT_COUNT; i++)
+    {
+        detail->format_supports[i].shader_read = 1;
+        detail->format_supports[i].shader_write = 1;
+        detail->format_supports[i].render_target_write = 1;
+    }
+    strncpy(detail->vendor_preset.gpu_name, "CGPU Null Device", MAX_GPU_VENDOR_STRING_LENGTH - 1);
+    I->adapter = A;
+    A->super.instance = &I->super;
+    return &I->super;
+}
+
+void cgpu_query_instance_features_null(CGPUInstanceId instance, struct CGPUInstanceFeatures* features)
+{
+    features->specialization_constant = true;
+}
+
+void cgpu_free_instance_null(CGPUInstanceId instance)
+{
+    CGPUInstance_Null* I = (CGPUInstance_Null*)instance;
+    cgpu_free(I->adapter);
+    cgpu_free(I);
+}
+
+// Adapter APIs
+void cgpu_enum_adapters_null(CGPUInstanceId instance, CGPUAdapterId* const adapters, uint32_t* adapters_num)
+{
+    const CGPUInstance_Null* I = (const CGPUInstance_Null*)instance;
+    *adapters_num = 1;
+    if (adapters != CGPU_NULLPTR)
+    {
+        adapters[0] = &I->adapter->super;
+    }
+}
+
+const CGPUAdapterDetail* cgpu_query_adapter_detail_null(const CGPUAdapterId adapter)
+{
+    const CGPUAdapter_Null* A = (const CGPUAdapter_Null*)adapter;
+    return &A->adapter_detail;
+}
+
+uint32_t cgpu_query_queue_count_null(const CGPUAdapterId adapter, const ECGPUQueueType type)
+{
+    switch (type)
+    {
+        case CGPU_QUEUE_TYPE_GRAPHICS:
+            return 1;
+        case CGPU_QUEUE_TYPE_COMPUTE:
+        case CGPU_QUEUE_TYPE_TRANSFER:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+// Device APIs
+CGPUDeviceId cgpu_create_device_null(CGPUAdapterId adapter, const CGPUDeviceDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)cgpu_calloc(1, sizeof(CGPUDevice_Null));
+    *(CGPUAdapterId*)&D->super.adapter = adapter;
+    return &D->super;
+}
+
+void cgpu_query_video_memory_info_null(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    *total = CGPU_NULL_VIDEO_MEMORY_BUDGET;
+    *used_bytes = skr_atomicu64_load_relaxed(&D->allocated_bytes);
+}
+
+void cgpu_query_shared_memory_info_null(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes)
+{
+    *total = CGPU_NULL_SHARED_MEMORY_BUDGET;
+    *used_bytes = 0;
+}
+
+void cgpu_free_device_null(CGPUDeviceId device)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    if (D->allocated_bytes)
+    {
+        cgpu_warn("null device %p freed with %llu bytes of resources alive!", device, (unsigned long long)D->allocated_bytes);
+    }
+    cgpu_free(D);
+}
+
+// API Object APIs
+CGPUFenceId cgpu_create_fence_null(CGPUDeviceId device)
+{
+    CGPUFence_Null* F = (CGPUFence_Null*)cgpu_calloc(1, sizeof(CGPUFence_Null));
+    return &F->super;
+}
+
+void cgpu_wait_fences_null(const CGPUFenceId* fences, uint32_t fence_count)
+{
+    // submissions complete on submit
+}
+
+ECGPUFenceStatus cgpu_query_fence_status_null(CGPUFenceId fence)
+{
+    const CGPUFence_Null* F = (const CGPUFence_Null*)fence;
+    return F->submitted ? CGPU_FENCE_STATUS_COMPLETE : CGPU_FENCE_STATUS_NOTSUBMITTED;
+}
+
+void cgpu_free_fence_null(CGPUFenceId fence)
+{
+    cgpu_free((void*)fence);
+}
+
+CGPUSemaphoreId cgpu_create_semaphore_null(CGPUDeviceId device)
+{
+    CGPUSemaphore* S = (CGPUSemaphore*)cgpu_calloc(1, sizeof(CGPUSemaphore));
+    S->device = device;
+    return S;
+}
+
+void cgpu_free_semaphore_null(CGPUSemaphoreId semaphore)
+{
+    cgpu_free((void*)semaphore);
+}
+
+CGPURootSignaturePoolId cgpu_create_root_signature_pool_null(CGPUDeviceId device, const struct CGPURootSignaturePoolDescriptor* desc)
+{
+    return CGPUUtil_CreateRootSignaturePool(desc);
+}
+
+void cgpu_free_root_signature_pool_null(CGPURootSignaturePoolId pool)
+{
+    CGPUUtil_FreeRootSignaturePool(pool);
+}
+
+CGPURootSignatureId cgpu_create_root_signature_null(CGPUDeviceId device, const struct CGPURootSignatureDescriptor* desc)
+{
+    CGPURootSignature* RS = (CGPURootSignature*)cgpu_calloc(1, sizeof(CGPURootSignature));
+    CGPUUtil_InitRSParamTables(RS, desc);
+    // [RS POOL] ALLOCATION
+    if (desc->pool)
+    {
+        CGPURootSignatureId poolSig = CGPUUtil_TryAllocateSignature(desc->pool, RS, desc);
+        if (poolSig != CGPU_NULLPTR)
+        {
+            RS->pool = desc->pool;
+            RS->pool_sig = poolSig;
+            return RS;
+        }
+        const bool result = CGPUUtil_AddSignature(desc->pool, RS, desc);
+        cgpu_assert(result && "Root signature pool insertion failed!");
+    }
+    // [RS POOL] END ALLOCATION
+    return RS;
+}
+
+void cgpu_free_root_signature_null(CGPURootSignatureId signature)
+{
+    // [RS POOL] FREE
+    if (signature->pool)
+    {
+        CGPUUtil_PoolFreeSignature(signature->pool, signature);
+        return;
+    }
+    // [RS POOL] END FREE
+    CGPUUtil_FreeRSParamTables((CGPURootSignature*)signature);
+    cgpu_free((void*)signature);
+}
+
+CGPUDescriptorSetId cgpu_create_descriptor_set_null(CGPUDeviceId device, const struct CGPUDescriptorSetDescriptor* desc)
+{
+    const CGPURootSignature* RS = desc->root_signature;
+    uint32_t bindings_count = 0;
+    for (uint32_t i = 0; i < RS->table_count; i++)
+    {
+        if (RS->tables[i].set_index == desc->set_index)
+            bindings_count = RS->tables[i].resources_count;
+    }
+    const size_t totalSize = sizeof(CGPUDescriptorSet_Null) + bindings_count * sizeof(const void*);
+    CGPUDescriptorSet_Null* Set = (CGPUDescriptorSet_Null*)cgpu_calloc(1, totalSize);
+    Set->bindings = (const void**)(Set + 1);
+    Set->bindings_count = bindings_count;
+    return &Set->super;
+}
+
+void cgpu_update_descriptor_set_null(CGPUDescriptorSetId set, const struct CGPUDescriptorData* datas, uint32_t count)
+{
+    CGPUDescriptorSet_Null* Set = (CGPUDescriptorSet_Null*)set;
+    const CGPURootSignature* RS = set->root_signature;
+    CGPUDevice_Null* D = (CGPUDevice_Null*)RS->device;
+    const CGPUParameterTable* ParamTable = CGPU_NULLPTR;
+    for (uint32_t i = 0; i < RS->table_count; i++)
+    {
+        if (RS->tables[i].set_index == set->index)
+            ParamTable = &RS->tables[i];
+    }
+    uint64_t written = 0;
+    for (uint32_t i = 0; i < count && ParamTable; i++)
+    {
+        const CGPUDescriptorData* pParam = datas + i;
+        const size_t argNameHash = pParam->name ? cgpu_name_hash(pParam->name, strlen(pParam->name)) : 0;
+        for (uint32_t p = 0; p < ParamTable->resources_count; p++)
+        {
+            const CGPUShaderResource* ResData = ParamTable->resources + p;
+            const bool match = pParam->name ? (ResData->name_hash == argNameHash) : (ResData->binding == pParam->binding);
+            if (match)
+            {
+                Set->bindings[p] = pParam->count ? pParam->ptrs[0] : CGPU_NULLPTR;
+                written += pParam->count;
+                break;
+            }
+        }
+    }
+    skr_atomicu64_add_relaxed(&D->descriptor_sets_updated, 1);
+    skr_atomicu64_add_relaxed(&D->descriptors_written, written);
+}
+
+void cgpu_free_descriptor_set_null(CGPUDescriptorSetId set)
+{
+    cgpu_free((void*)set);
+}
+
+CGPUComputePipelineId cgpu_create_compute_pipeline_null(CGPUDeviceId device, const struct CGPUComputePipelineDescriptor* desc)
+{
+    return (CGPUComputePipelineId)cgpu_calloc(1, sizeof(CGPUComputePipeline));
+}
+
+void cgpu_free_compute_pipeline_null(CGPUComputePipelineId pipeline)
+{
+    cgpu_free((void*)pipeline);
+}
+
+CGPURenderPipelineId cgpu_create_render_pipeline_null(CGPUDeviceId device, const struct CGPURenderPipelineDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    skr_atomicu64_add_relaxed(&D->render_pipelines_created, 1);
+    return (CGPURenderPipelineId)cgpu_calloc(1, sizeof(CGPURenderPipeline));
+}
+
+void cgpu_free_render_pipeline_null(CGPURenderPipelineId pipeline)
+{
+    cgpu_free((void*)pipeline);
+}
+
+CGPUQueryPoolId cgpu_create_query_pool_null(CGPUDeviceId device, const struct CGPUQueryPoolDescriptor* desc)
+{
+    CGPUQueryPool* P = (CGPUQueryPool*)cgpu_calloc(1, sizeof(CGPUQueryPool));
+    P->device = device;
+    P->count = desc->query_count;
+    return P;
+}
+
+void cgpu_free_query_pool_null(CGPUQueryPoolId pool)
+{
+    cgpu_free((void*)pool);
+}
+
+// Queue APIs
+CGPUQueueId cgpu_get_queue_null(CGPUDeviceId device, ECGPUQueueType type, uint32_t index)
+{
+    CGPUQueue_Null* Q = (CGPUQueue_Null*)cgpu_calloc(1, sizeof(CGPUQueue_Null));
+    return &Q->super;
+}
+
+void cgpu_submit_queue_null(CGPUQueueId queue, const struct CGPUQueueSubmitDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)queue->device;
+    for (uint32_t i = 0; i < desc->cmds_count; i++)
+    {
+        NullUtil_ExecuteCommandBuffer(D, desc->cmds[i]);
+    }
+    if (desc->signal_fence)
+    {
+        ((CGPUFence_Null*)desc->signal_fence)->submitted = true;
+    }
+    skr_atomicu64_add_relaxed(&D->submits, 1);
+    skr_atomicu64_add_relaxed(&D->command_buffers_submitted, desc->cmds_count);
+}
+
+void cgpu_wait_queue_idle_null(CGPUQueueId queue)
+{
+    // submissions complete on submit
+}
+
+void cgpu_queue_present_null(CGPUQueueId queue, const struct CGPUQueuePresentDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)queue->device;
+    skr_atomicu64_add_relaxed(&D->presents, 1);
+}
+
+float cgpu_queue_get_timestamp_period_ns_null(CGPUQueueId queue)
+{
+    return 1.f;
+}
+
+void cgpu_free_queue_null(CGPUQueueId queue)
+{
+    cgpu_free((void*)queue);
+}
+
+// Command APIs
+CGPUCommandPoolId cgpu_create_command_pool_null(CGPUQueueId queue, const CGPUCommandPoolDescriptor* desc)
+{
+    return (CGPUCommandPoolId)cgpu_calloc(1, sizeof(CGPUCommandPool));
+}
+
+CGPUCommandBufferId cgpu_create_command_buffer_null(CGPUCommandPoolId pool, const struct CGPUCommandBufferDescriptor* desc)
+{
+    CGPUCommandBuffer_Null* Cmd = (CGPUCommandBuffer_Null*)cgpu_calloc(1, sizeof(CGPUCommandBuffer_Null));
+    return &Cmd->super;
+}
+
+void cgpu_reset_command_pool_null(CGPUCommandPoolId pool)
+{
+    // streams are rewound by cgpu_cmd_begin
+}
+
+void cgpu_free_command_buffer_null(CGPUCommandBufferId cmd)
+{
+    CGPUCommandBuffer_Null* Cmd = (CGPUCommandBuffer_Null*)cmd;
+    if (Cmd->stream) cgpu_free(Cmd->stream);
+    cgpu_free(Cmd);
+}
+
+void cgpu_free_command_pool_null(CGPUCommandPoolId pool)
+{
+    cgpu_free((void*)pool);
+}
+
+// Shader APIs
+CGPUShaderLibraryId cgpu_create_shader_library_null(CGPUDeviceId device, const struct CGPUShaderLibraryDescriptor* desc)
+{
+#ifdef CGPU_USE_VULKAN
+    CGPUShaderLibrary_Vulkan* S = (CGPUShaderLibrary_Vulkan*)cgpu_calloc(1, sizeof(CGPUShaderLibrary_Vulkan));
+    if (desc->code_size >= sizeof(uint32_t) && desc->code[0] == CGPU_NULL_SPIRV_MAGIC)
+    {
+        VkUtil_InitializeShaderReflection(device, S, desc);
+    }
+    return &S->super;
+#else
+    // no reflection, root signatures made from these libraries have no parameters
+    return (CGPUShaderLibraryId)cgpu_calloc(1, sizeof(CGPUShaderLibrary));
+#endif
+}
+
+void cgpu_free_shader_library_null(CGPUShaderLibraryId library)
+{
+#ifdef CGPU_USE_VULKAN
+    CGPUShaderLibrary_Vulkan* S = (CGPUShaderLibrary_Vulkan*)library;
+    if (S->pReflect) VkUtil_FreeShaderReflection(S);
+#endif
+    cgpu_free((void*)library);
+}
+
+// Buffer APIs
+CGPUBufferId cgpu_create_buffer_null(CGPUDeviceId device, const struct CGPUBufferDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    CGPUBuffer_Null* B = (CGPUBuffer_Null*)cgpu_calloc(1, sizeof(CGPUBuffer_Null));
+    B->allocated_size = cgpu_round_up(cgpu_max(desc->size, 1ull), CGPU_NULL_BUFFER_ALIGNMENT);
+    if (NullUtil_IsHostVisible(desc))
+    {
+        B->host_memory = (uint8_t*)cgpu_calloc(1, B->allocated_size);
+        if (desc->flags & CGPU_BCF_PERSISTENT_MAP_BIT)
+            B->super.cpu_mapped_address = B->host_memory;
+    }
+    B->super.size = desc->size;
+    B->super.descriptors = desc->descriptors;
+    B->super.memory_usage = desc->memory_usage;
+    NullUtil_Allocate(D, B->allocated_size);
+    skr_atomicu64_add_relaxed(&D->buffers_created, 1);
+    return &B->super;
+}
+
+void cgpu_map_buffer_null(CGPUBufferId buffer, const struct CGPUBufferRange* range)
+{
+    CGPUBuffer_Null* B = (CGPUBuffer_Null*)buffer;
+    cgpu_assert(B->host_memory && "Trying to map non-cpu accessible resource");
+    B->super.cpu_mapped_address = B->host_memory + (range ? range->offset : 0);
+}
+
+void cgpu_unmap_buffer_null(CGPUBufferId buffer)
+{
+    CGPUBuffer_Null* B = (CGPUBuffer_Null*)buffer;
+    B->super.cpu_mapped_address = CGPU_NULLPTR;
+}
+
+void cgpu_free_buffer_null(CGPUBufferId buffer)
+{
+    CGPUBuffer_Null* B = (CGPUBuffer_Null*)buffer;
+    NullUtil_Free((CGPUDevice_Null*)buffer->device, B->allocated_size);
+    if (B->host_memory) cgpu_free(B->host_memory);
+    cgpu_free(B);
+}
+
+// Sampler APIs
+CGPUSamplerId cgpu_create_sampler_null(CGPUDeviceId device, const struct CGPUSamplerDescriptor* desc)
+{
+    CGPUSampler* S = (CGPUSampler*)cgpu_calloc(1, sizeof(CGPUSampler));
+    S->device = device;
+    return S;
+}
+
+void cgpu_free_sampler_null(CGPUSamplerId sampler)
+{
+    cgpu_free((void*)sampler);
+}
+
+// Texture/TextureView APIs
+CGPUTextureId cgpu_create_texture_null(CGPUDeviceId device, const struct CGPUTextureDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    CGPUTexture_Null* T = (CGPUTexture_Null*)cgpu_calloc(1, sizeof(CGPUTexture_Null));
+    uint32_t aspect_mask = CGPU_TVA_COLOR;
+    if (FormatUtil_IsDepthStencilFormat(desc->format))
+        aspect_mask = CGPU_TVA_DEPTH | CGPU_TVA_STENCIL;
+    else if (FormatUtil_IsDepthOnlyFormat(desc->format))
+        aspect_mask = CGPU_TVA_DEPTH;
+    T->super.device = device;
+    T->super.size_in_bytes = NullUtil_TextureSize(desc, &T->alignment);
+    T->super.sample_count = desc->sample_count;
+    T->super.width = desc->width;
+    T->super.height = desc->height;
+    T->super.depth = desc->depth;
+    T->super.mip_levels = desc->mip_levels;
+    T->super.array_size_minus_one = desc->array_size - 1;
+    T->super.format = desc->format;
+    T->super.aspect_mask = aspect_mask;
+    T->super.is_cube = (CGPU_RESOURCE_TYPE_TEXTURE_CUBE == (desc->descriptors & CGPU_RESOURCE_TYPE_TEXTURE_CUBE));
+    T->super.is_dedicated = desc->is_dedicated;
+    T->super.owns_image = !desc->is_aliasing;
+    T->super.is_aliasing = desc->is_aliasing;
+    T->super.can_alias = true;
+    T->super.unique_id = D->super.next_texture_id++;
+    // aliasing textures own no memory
+    if (!desc->is_aliasing) NullUtil_Allocate(D, T->super.size_in_bytes);
+    skr_atomicu64_add_relaxed(&D->textures_created, 1);
+    return &T->super;
+}
+
+void cgpu_free_texture_null(CGPUTextureId texture)
+{
+    CGPUTexture_Null* T = (CGPUTexture_Null*)texture;
+    if (!T->super.is_aliasing) NullUtil_Free((CGPUDevice_Null*)texture->device, T->super.size_in_bytes);
+    cgpu_free(T);
+}
+
+CGPUTextureViewId cgpu_create_texture_view_null(CGPUDeviceId device, const struct CGPUTextureViewDescriptor* desc)
+{
+    return (CGPUTextureViewId)cgpu_calloc(1, sizeof(CGPUTextureView));
+}
+
+void cgpu_free_texture_view_null(CGPUTextureViewId render_target)
+{
+    cgpu_free((void*)render_target);
+}
+
+bool cgpu_try_bind_aliasing_texture_null(CGPUDeviceId device, const struct CGPUTextureAliasingBindDescriptor* desc)
+{
+    if (desc->aliased == CGPU_NULLPTR || desc->aliasing == CGPU_NULLPTR) return false;
+    CGPUTexture_Null* Aliasing = (CGPUTexture_Null*)desc->aliasing;
+    const CGPUTexture* Aliased = desc->aliased;
+    cgpu_assert(Aliasing->super.is_aliasing && "aliasing texture need to be created as aliasing!");
+    if (!Aliasing->super.is_aliasing || Aliased->is_aliasing) return false;
+    if (desc->offset % Aliasing->alignment != 0) return false;
+    if (desc->offset + Aliasing->super.size_in_bytes > Aliased->size_in_bytes) return false;
+    Aliasing->aliased = Aliased;
+    Aliasing->aliased_offset = desc->offset;
+    return true;
+}
+
+// Swapchain APIs
+CGPUSwapChainId cgpu_create_swapchain_null(CGPUDeviceId device, const CGPUSwapChainDescriptor* desc)
+{
+    const uint32_t buffer_count = desc->imageCount ? desc->imageCount : 2;
+    const size_t totalSize = sizeof(CGPUSwapChain_Null) + buffer_count * sizeof(CGPUTextureId);
+    CGPUSwapChain_Null* S = (CGPUSwapChain_Null*)cgpu_calloc(1, totalSize);
+    CGPUTextureId* back_buffers = (CGPUTextureId*)(S + 1);
+    for (uint32_t i = 0; i < buffer_count; i++)
+    {
+        DECLARE_ZERO(CGPUTextureDescriptor, texture_desc)
+        texture_desc.name = SKR_UTF8("NullSwapChainBuffer");
+        texture_desc.width = desc->width;
+        texture_desc.height = desc->height;
+        texture_desc.depth = 1;
+        texture_desc.array_size = 1;
+        texture_desc.mip_levels = 1;
+        texture_desc.sample_count = CGPU_SAMPLE_COUNT_1;
+        texture_desc.format = desc->format;
+        texture_desc.descriptors = CGPU_RESOURCE_TYPE_TEXTURE | CGPU_RESOURCE_TYPE_RENDER_TARGET;
+        texture_desc.start_state = CGPU_RESOURCE_STATE_PRESENT;
+        back_buffers[i] = cgpu_create_texture_null(device, &texture_desc);
+    }
+    S->super.back_buffers = back_buffers;
+    S->super.buffer_count = buffer_count;
+    S->current_index = buffer_count - 1;
+    return &S->super;
+}
+
+uint32_t cgpu_acquire_next_image_null(CGPUSwapChainId swapchain, const struct CGPUAcquireNextDescriptor* desc)
+{
+    CGPUSwapChain_Null* S = (CGPUSwapChain_Null*)swapchain;
+    S->current_index = (S->current_index + 1) % S->super.buffer_count;
+    if (desc->fence)
+    {
+        ((CGPUFence_Null*)desc->fence)->submitted = true;
+    }
+    return S->current_index;
+}
+
+void cgpu_free_swapchain_null(CGPUSwapChainId swapchain)
+{
+    for (uint32_t i = 0; i < swapchain->buffer_count; i++)
+    {
+        cgpu_free_texture_null(swapchain->back_buffers[i]);
+    }
+    cgpu_free((void*)swapchain);
+}
+
+// CMDs
+void cgpu_cmd_begin_null(CGPUCommandBufferId cmd)
+{
+    CGPUCommandBuffer_Null* Cmd = (CGPUCommandBuffer_Null*)cmd;
+    Cmd->stream_size = 0;
+    Cmd->command_count = 0;
+}
+
+void cgpu_cmd_transfer_buffer_to_buffer_null(CGPUCommandBufferId cmd, const struct CGPUBufferToBufferTransfer* desc)
+{
+    CGPUNullCmdTransferBufferToBuffer* T = (CGPUNullCmdTransferBufferToBuffer*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_BUFFER, sizeof(CGPUNullCmdTransferBufferToBuffer));
+    T->transfer = *desc;
+}
+
+void cgpu_cmd_transfer_buffer_to_texture_null(CGPUCommandBufferId cmd, const struct CGPUBufferToTextureTransfer* desc)
+{
+    CGPUNullCmdTransferBufferToTexture* T = (CGPUNullCmdTransferBufferToTexture*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_TEXTURE, sizeof(CGPUNullCmdTransferBufferToTexture));
+    T->transfer = *desc;
+}
+
+void cgpu_cmd_transfer_texture_to_texture_null(CGPUCommandBufferId cmd, const struct CGPUTextureToTextureTransfer* desc)
+{
+    CGPUNullCmdTransferTextureToTexture* T = (CGPUNullCmdTransferTextureToTexture*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_TRANSFER_TEXTURE_TO_TEXTURE, sizeof(CGPUNullCmdTransferTextureToTexture));
+    T->transfer = *desc;
+}
+
+void cgpu_cmd_resource_barrier_null(CGPUCommandBufferId cmd, const struct CGPUResourceBarrierDescriptor* desc)
+{
+    const uint64_t buffer_barriers_size = desc->buffer_barriers_count * sizeof(CGPUBufferBarrier);
+    const uint64_t texture_barriers_size = desc->texture_barriers_count * sizeof(CGPUTextureBarrier);
+    CGPUNullCmdResourceBarrier* B = (CGPUNullCmdResourceBarrier*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_RESOURCE_BARRIER,
+        sizeof(CGPUNullCmdResourceBarrier) + buffer_barriers_size + texture_barriers_size);
+    B->buffer_barriers_count = desc->buffer_barriers_count;
+    B->texture_barriers_count = desc->texture_barriers_count;
+    uint8_t* payload = (uint8_t*)(B + 1);
+    if (buffer_barriers_size) memcpy(payload, desc->buffer_barriers, buffer_barriers_size);
+    if (texture_barriers_size) memcpy(payload + buffer_barriers_size, desc->texture_barriers, texture_barriers_size);
+}
+
+void cgpu_cmd_begin_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, const struct CGPUQueryDescriptor* desc)
+{
+    CGPUNullCmdQuery* Q = (CGPUNullCmdQuery*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_BEGIN_QUERY, sizeof(CGPUNullCmdQuery));
+    Q->pool = pool;
+    Q->start_query = desc->index;
+    Q->query_count = 1;
+    Q->stage = desc->stage;
+}
+
+void cgpu_cmd_end_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, const struct CGPUQueryDescriptor* desc)
+{
+    CGPUNullCmdQuery* Q = (CGPUNullCmdQuery*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_END_QUERY, sizeof(CGPUNullCmdQuery));
+    Q->pool = pool;
+    Q->start_query = desc->index;
+    Q->query_count = 1;
+    Q->stage = desc->stage;
+}
+
+void cgpu_cmd_reset_query_pool_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, uint32_t start_query, uint32_t query_count)
+{
+    CGPUNullCmdQuery* Q = (CGPUNullCmdQuery*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_RESET_QUERY_POOL, sizeof(CGPUNullCmdQuery));
+    Q->pool = pool;
+    Q->start_query = start_query;
+    Q->query_count = query_count;
+}
+
+void cgpu_cmd_resolve_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, CGPUBufferId readback, uint32_t start_query, uint32_t query_count)
+{
+    CGPUNullCmdQuery* Q = (CGPUNullCmdQuery*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_RESOLVE_QUERY, sizeof(CGPUNullCmdQuery));
+    Q->pool = pool;
+    Q->readback = readback;
+    Q->start_query = start_query;
+    Q->query_count = query_count;
+}
+
+void cgpu_cmd_end_null(CGPUCommandBufferId cmd)
+{
+}
+
+// Events
+void cgpu_cmd_begin_event_null(CGPUCommandBufferId cmd, const CGPUEventInfo* event)
+{
+    NullUtil_RecordName(cmd, CGPU_NULL_COMMAND_BEGIN_EVENT, event->name, event->color);
+}
+
+void cgpu_cmd_set_marker_null(CGPUCommandBufferId cmd, const CGPUMarkerInfo* marker)
+{
+    NullUtil_RecordName(cmd, CGPU_NULL_COMMAND_SET_MARKER, marker->name, marker->color);
+}
+
+void cgpu_cmd_end_event_null(CGPUCommandBufferId cmd)
+{
+    NullUtil_Record(cmd, CGPU_NULL_COMMAND_END_EVENT, sizeof(CGPUNullCommand));
+}
+
+// Compute CMDs
+CGPUComputePassEncoderId cgpu_cmd_begin_compute_pass_null(CGPUCommandBufferId cmd, const struct CGPUComputePassDescriptor* desc)
+{
+    const char8_t* name = desc ? desc->name : CGPU_NULLPTR;
+    const size_t name_size = name ? strlen(name) + 1 : 1;
+    CGPUNullCmdBeginPass* P = (CGPUNullCmdBeginPass*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_BEGIN_COMPUTE_PASS, sizeof(CGPUNullCmdBeginPass) + name_size);
+    if (name) memcpy(P + 1, name, name_size);
+    // null backend simply returns the handle of the command buffer as the encoder
+    return (CGPUComputePassEncoderId)cmd;
+}
+
+void cgpu_compute_encoder_bind_descriptor_set_null(CGPUComputePassEncoderId encoder, CGPUDescriptorSetId descriptor)
+{
+    CGPUNullCmdBindDescriptorSet* S = (CGPUNullCmdBindDescriptorSet*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_BIND_DESCRIPTOR_SET, sizeof(CGPUNullCmdBindDescriptorSet));
+    S->set = descriptor;
+    S->pipeline_type = CGPU_PIPELINE_TYPE_COMPUTE;
+}
+
+void cgpu_compute_encoder_push_constants_null(CGPUComputePassEncoderId encoder, CGPURootSignatureId rs, const char8_t* name, const void* data)
+{
+    const uint32_t size = NullUtil_PushConstantSize(rs, name);
+    CGPUNullCmdPushConstants* P = (CGPUNullCmdPushConstants*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_PUSH_CONSTANTS, sizeof(CGPUNullCmdPushConstants) + size);
+    P->root_signature = rs;
+    P->pipeline_type = CGPU_PIPELINE_TYPE_COMPUTE;
+    P->size = size;
+    if (size) memcpy(P + 1, data, size);
+}
+
+void cgpu_compute_encoder_bind_pipeline_null(CGPUComputePassEncoderId encoder, CGPUComputePipelineId pipeline)
+{
+    CGPUNullCmdBindPipeline* P = (CGPUNullCmdBindPipeline*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_BIND_COMPUTE_PIPELINE, sizeof(CGPUNullCmdBindPipeline));
+    P->pipeline = pipeline;
+}
+
+void cgpu_compute_encoder_dispatch_null(CGPUComputePassEncoderId encoder, uint32_t X, uint32_t Y, uint32_t Z)
+{
+    CGPUNullCmdDispatch* Dispatch = (CGPUNullCmdDispatch*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_DISPATCH, sizeof(CGPUNullCmdDispatch));
+    Dispatch->x = X;
+    Dispatch->y = Y;
+    Dispatch->z = Z;
+}
+
+void cgpu_cmd_end_compute_pass_null(CGPUCommandBufferId cmd, CGPUComputePassEncoderId encoder)
+{
+    NullUtil_Record(cmd, CGPU_NULL_COMMAND_END_COMPUTE_PASS, sizeof(CGPUNullCommand));
+}
+
+// Render CMDs
+CGPURenderPassEncoderId cgpu_cmd_begin_render_pass_null(CGPUCommandBufferId cmd, const struct CGPURenderPassDescriptor* desc)
+{
+    const uint64_t color_size = desc->render_target_count * sizeof(CGPUColorAttachment);
+    const uint64_t depth_size = desc->depth_stencil ? sizeof(CGPUDepthStencilAttachment) : 0;
+    const size_t name_size = desc->name ? strlen(desc->name) + 1 : 1;
+    CGPUNullCmdBeginPass* P = (CGPUNullCmdBeginPass*)NullUtil_Record(cmd, CGPU_NULL_COMMAND_BEGIN_RENDER_PASS,
+        sizeof(CGPUNullCmdBeginPass) + color_size + depth_size + name_size);
+    P->sample_count = desc->sample_count;
+    P->render_target_count = desc->render_target_count;
+    P->has_depth_stencil = desc->depth_stencil != CGPU_NULLPTR;
+    uint8_t* payload = (uint8_t*)(P + 1);
+    if (color_size) memcpy(payload, desc->color_attachments, color_size);
+    if (depth_size) memcpy(payload + color_size, desc->depth_stencil, depth_size);
+    if (desc->name) memcpy(payload + color_size + depth_size, desc->name, name_size);
+    // null backend simply returns the handle of the command buffer as the encoder
+    return (CGPURenderPassEncoderId)cmd;
+}
+
+void cgpu_render_encoder_set_shading_rate_null(CGPURenderPassEncoderId encoder, ECGPUShadingRate shading_rate, ECGPUShadingRateCombiner post_rasterizer_rate, ECGPUShadingRateCombiner final_rate)
+{
+    CGPUNullCmdSetShadingRate* S = (CGPUNullCmdSetShadingRate*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_SET_SHADING_RATE, sizeof(CGPUNullCmdSetShadingRate));
+    S->shading_rate = shading_rate;
+    S->post_rasterizer_rate = post_rasterizer_rate;
+    S->final_rate = final_rate;
+}
+
+void cgpu_render_encoder_bind_descriptor_set_null(CGPURenderPassEncoderId encoder, CGPUDescriptorSetId descriptor)
+{
+    CGPUNullCmdBindDescriptorSet* S = (CGPUNullCmdBindDescriptorSet*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_BIND_DESCRIPTOR_SET, sizeof(CGPUNullCmdBindDescriptorSet));
+    S->set = descriptor;
+    S->pipeline_type = CGPU_PIPELINE_TYPE_GRAPHICS;
+}
+
+void cgpu_render_encoder_set_viewport_null(CGPURenderPassEncoderId encoder, float x, float y, float width, float height, float min_depth, float max_depth)
+{
+    CGPUNullCmdSetViewport* V = (CGPUNullCmdSetViewport*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_SET_VIEWPORT, sizeof(CGPUNullCmdSetViewport));
+    V->x = x;
+    V->y = y;
+    V->width = width;
+    V->height = height;
+    V->min_depth = min_depth;
+    V->max_depth = max_depth;
+}
+
+void cgpu_render_encoder_set_scissor_null(CGPURenderPassEncoderId encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    CGPUNullCmdSetScissor* S = (CGPUNullCmdSetScissor*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_SET_SCISSOR, sizeof(CGPUNullCmdSetScissor));
+    S->x = x;
+    S->y = y;
+    S->width = width;
+    S->height = height;
+}
+
+void cgpu_render_encoder_bind_pipeline_null(CGPURenderPassEncoderId encoder, CGPURenderPipelineId pipeline)
+{
+    CGPUNullCmdBindPipeline* P = (CGPUNullCmdBindPipeline*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_BIND_RENDER_PIPELINE, sizeof(CGPUNullCmdBindPipeline));
+    P->pipeline = pipeline;
+}
+
+void cgpu_render_encoder_bind_vertex_buffers_null(CGPURenderPassEncoderId encoder, uint32_t buffer_count, const CGPUBufferId* buffers, const uint32_t* strides, const uint32_t* offsets)
+{
+    const uint64_t buffers_size = buffer_count * sizeof(CGPUBufferId);
+    const uint64_t strides_size = buffer_count * sizeof(uint32_t);
+    CGPUNullCmdBindVertexBuffers* V = (CGPUNullCmdBindVertexBuffers*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_BIND_VERTEX_BUFFERS,
+        sizeof(CGPUNullCmdBindVertexBuffers) + buffers_size + 2 * strides_size);
+    V->buffer_count = buffer_count;
+    uint8_t* payload = (uint8_t*)(V + 1);
+    memcpy(payload, buffers, buffers_size);
+    if (strides) memcpy(payload + buffers_size, strides, strides_size);
+    if (offsets) memcpy(payload + buffers_size + strides_size, offsets, strides_size);
+}
+
+void cgpu_render_encoder_bind_index_buffer_null(CGPURenderPassEncoderId encoder, CGPUBufferId buffer, uint32_t index_stride, uint64_t offset)
+{
+    CGPUNullCmdBindIndexBuffer* I = (CGPUNullCmdBindIndexBuffer*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_BIND_INDEX_BUFFER, sizeof(CGPUNullCmdBindIndexBuffer));
+    I->buffer = buffer;
+    I->index_stride = index_stride;
+    I->offset = offset;
+}
+
+void cgpu_render_encoder_push_constants_null(CGPURenderPassEncoderId encoder, CGPURootSignatureId rs, const char8_t* name, const void* data)
+{
+    const uint32_t size = NullUtil_PushConstantSize(rs, name);
+    CGPUNullCmdPushConstants* P = (CGPUNullCmdPushConstants*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_PUSH_CONSTANTS, sizeof(CGPUNullCmdPushConstants) + size);
+    P->root_signature = rs;
+    P->pipeline_type = CGPU_PIPELINE_TYPE_GRAPHICS;
+    P->size = size;
+    if (size) memcpy(P + 1, data, size);
+}
+
+static void NullUtil_RecordDraw(CGPURenderPassEncoderId encoder, uint32_t element_count, uint32_t first_element, uint32_t instance_count, uint32_t first_instance, uint32_t first_vertex, bool indexed)
+{
+    CGPUNullCmdDraw* Draw = (CGPUNullCmdDraw*)NullUtil_Record((CGPUCommandBufferId)encoder, CGPU_NULL_COMMAND_DRAW, sizeof(CGPUNullCmdDraw));
+    Draw->element_count = element_count;
+    Draw->first_element = first_element;
+    Draw->instance_count = instance_count;
+    Draw->first_instance = first_instance;
+    Draw->first_vertex = first_vertex;
+    Draw->indexed = indexed;
+}
+
+void cgpu_render_encoder_draw_null(CGPURenderPassEncoderId encoder, uint32_t vertex_count, uint32_t first_vertex)
+{
+    NullUtil_RecordDraw(encoder, vertex_count, first_vertex, 1, 0, 0, false);
+}
+
+void cgpu_render_encoder_draw_instanced_null(CGPURenderPassEncoderId encoder, uint32_t vertex_count, uint32_t first_vertex, uint32_t instance_count, uint32_t first_instance)
+{
+    NullUtil_RecordDraw(encoder, vertex_count, first_vertex, instance_count, first_instance, 0, false);
+}
+
+void cgpu_render_encoder_draw_indexed_null(CGPURenderPassEncoderId encoder, uint32_t index_count, uint32_t first_index, uint32_t first_vertex)
+{
+    NullUtil_RecordDraw(encoder, index_count, first_index, 1, 0, first_vertex, true);
+}
+
+void cgpu_render_encoder_draw_indexed_instanced_null(CGPURenderPassEncoderId encoder, uint32_t index_count, uint32_t first_index, uint32_t instance_count, uint32_t first_instance, uint32_t first_vertex)
+{
+    NullUtil_RecordDraw(encoder, index_count, first_index, instance_count, first_instance, first_vertex, true);
+}
+
+void cgpu_cmd_end_render_pass_null(CGPUCommandBufferId cmd, CGPURenderPassEncoderId encoder)
+{
+    NullUtil_Record(cmd, CGPU_NULL_COMMAND_END_RENDER_PASS, sizeof(CGPUNullCommand));
+}
+
+// Surfaces
+void cgpu_free_surface_null(CGPUDeviceId device, CGPUSurfaceId surface)
+{
+    // no window system behind the null backend, surfaces are only passed through
+}
@@ -0,0 +1,127 @@
+#include "cgpu/backend/null/cgpu_null.h"
+
+const CGPUProcTable tbl_null = {
+    // Instance APIs
+    .create_instance = &cgpu_create_instance_null,
+    .query_instance_features = &cgpu_query_instance_features_null,
+    .free_instance = &cgpu_free_instance_null,
+
+    // Adapter APIs
+    .enum_adapters = &cgpu_enum_adapters_null,
+    .query_adapter_detail = &cgpu_query_adapter_detail_null,
+    .query_queue_count = &cgpu_query_queue_count_null,
+
+    // Device APIs
+    .create_device = &cgpu_create_device_null,
+    .query_video_memory_info = &cgpu_query_video_memory_info_null,
+    .query_shared_memory_info = &cgpu_query_shared_memory_info_null,
+    .free_device = &cgpu_free_device_null,
+
+    // API Object APIs
+    .create_fence = &cgpu_create_fence_null,
+    .wait_fences = &cgpu_wait_fences_null,
+    .query_fence_status = &cgpu_query_fence_status_null,
+    .free_fence = &cgpu_free_fence_null,
+    .create_semaphore = &cgpu_create_semaphore_null,
+    .free_semaphore = &cgpu_free_semaphore_null,
+    .create_root_signature = &cgpu_create_root_signature_null,
+    .free_root_signature = &cgpu_free_root_signature_null,
+    .create_root_signature_pool = &cgpu_create_root_signature_pool_null,
+    .free_root_signature_pool = &cgpu_free_root_signature_pool_null,
+    .create_descriptor_set = &cgpu_create_descriptor_set_null,
+    .update_descriptor_set = &cgpu_update_descriptor_set_null,
+    .free_descriptor_set = &cgpu_free_descriptor_set_null,
+    .create_compute_pipeline = &cgpu_create_compute_pipeline_null,
+    .free_compute_pipeline = &cgpu_free_compute_pipeline_null,
+    .create_render_pipeline = &cgpu_create_render_pipeline_null,
+    .free_render_pipeline = &cgpu_free_render_pipeline_null,
+    .create_query_pool = &cgpu_create_query_pool_null,
+    .free_query_pool = &cgpu_free_query_pool_null,
+
+    // Queue APIs
+    .get_queue = &cgpu_get_queue_null,
+    .submit_queue = &cgpu_submit_queue_null,
+    .wait_queue_idle = &cgpu_wait_queue_idle_null,
+    .queue_present = &cgpu_queue_present_null,
+    .queue_get_timestamp_period = &cgpu_queue_get_timestamp_period_ns_null,
+    .free_queue = &cgpu_free_queue_null,
+
+    // Command APIs
+    .create_command_pool = &cgpu_create_command_pool_null,
+    .create_command_buffer = &cgpu_create_command_buffer_null,
+    .reset_command_pool = &cgpu_reset_command_pool_null,
+    .free_command_buffer = &cgpu_free_command_buffer_null,
+    .free_command_pool = &cgpu_free_command_pool_null,
+
+    // Shader APIs
+    .create_shader_library = &cgpu_create_shader_library_null,
+    .free_shader_library = &cgpu_free_shader_library_null,
+
+    // Buffer APIs
+    .create_buffer = &cgpu_create_buffer_null,
+    .map_buffer = &cgpu_map_buffer_null,
+    .unmap_buffer = &cgpu_unmap_buffer_null,
+    .free_buffer = &cgpu_free_buffer_null,
+
+    // Texture/TextureView APIs
+    .create_texture = &cgpu_create_texture_null,
+    .free_texture = &cgpu_free_texture_null,
+    .create_texture_view = &cgpu_create_texture_view_null,
+    .free_texture_view = &cgpu_free_texture_view_null,
+    .try_bind_aliasing_texture = &cgpu_try_bind_aliasing_texture_null,
+
+    // Sampler APIs
+    .create_sampler = &cgpu_create_sampler_null,
+    .free_sampler = &cgpu_free_sampler_null,
+
+    // Swapchain APIs
+    .create_swapchain = &cgpu_create_swapchain_null,
+    .acquire_next_image = &cgpu_acquire_next_image_null,
+    .free_swapchain = &cgpu_free_swapchain_null,
+
+    // CMDs
+    .cmd_begin = &cgpu_cmd_begin_null,
+    .cmd_transfer_buffer_to_buffer = &cgpu_cmd_transfer_buffer_to_buffer_null,
+    .cmd_transfer_buffer_to_texture = &cgpu_cmd_transfer_buffer_to_texture_null,
+    .cmd_transfer_texture_to_texture = &cgpu_cmd_transfer_texture_to_texture_null,
+    .cmd_resource_barrier = &cgpu_cmd_resource_barrier_null,
+    .cmd_begin_query = &cgpu_cmd_begin_query_null,
+    .cmd_end_query = &cgpu_cmd_end_query_null,
+    .cmd_reset_query_pool = &cgpu_cmd_reset_query_pool_null,
+    .cmd_resolve_query = &cgpu_cmd_resolve_query_null,
+    .cmd_end = &cgpu_cmd_end_null,
+
+    // Events
+    .cmd_begin_event = &cgpu_cmd_begin_event_null,
+    .cmd_set_marker = &cgpu_cmd_set_marker_null,
+    .cmd_end_event = &cgpu_cmd_end_event_null,
+
+    // Compute CMDs
+    .cmd_begin_compute_pass = &cgpu_cmd_begin_compute_pass_null,
+    .compute_encoder_bind_descriptor_set = &cgpu_compute_encoder_bind_descriptor_set_null,
+    .compute_encoder_push_constants = &cgpu_compute_encoder_push_constants_null,
+    .compute_encoder_bind_pipeline = &cgpu_compute_encoder_bind_pipeline_null,
+    .compute_encoder_dispatch = &cgpu_compute_encoder_dispatch_null,
+    .cmd_end_compute_pass = &cgpu_cmd_end_compute_pass_null,
+
+    // Render CMDs
+    .cmd_begin_render_pass = &cgpu_cmd_begin_render_pass_null,
+    .render_encoder_set_shading_rate = &cgpu_render_encoder_set_shading_rate_null,
+    .render_encoder_bind_descriptor_set = &cgpu_render_encoder_bind_descriptor_set_null,
+    .render_encoder_set_viewport = &cgpu_render_encoder_set_viewport_null,
+    .render_encoder_set_scissor = &cgpu_render_encoder_set_scissor_null,
+    .render_encoder_bind_pipeline = &cgpu_render_encoder_bind_pipeline_null,
+    .render_encoder_bind_vertex_buffers = &cgpu_render_encoder_bind_vertex_buffers_null,
+    .render_encoder_bind_index_buffer = &cgpu_render_encoder_bind_index_buffer_null,
+    .render_encoder_push_constants = &cgpu_render_encoder_push_constants_null,
+    .render_encoder_draw = &cgpu_render_encoder_draw_null,
+    .render_encoder_draw_instanced = &cgpu_render_encoder_draw_instanced_null,
+    .render_encoder_draw_indexed = &cgpu_render_encoder_draw_indexed_null,
+    .render_encoder_draw_indexed_instanced = &cgpu_render_encoder_draw_indexed_instanced_null,
+    .cmd_end_render_pass = &cgpu_cmd_end_render_pass_null,
+};const CGPUProcTable* CGPU_NullProcTable() { return &tbl_null; }
+
+const CGPUSurfacesProcTable s_tbl_null = {
+    .free_surface = &cgpu_free_surface_null
+};
+const CGPUSurfacesProcTable* CGPU_NullSurfacesProcTable() { return &s_tbl_null; }
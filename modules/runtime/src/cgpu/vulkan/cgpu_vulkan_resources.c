@@ -290,6 +290,7 @@ void cgpu_cmd_transfer_buffer_to_texture_vulkan(CGPUCommandBufferId cmd, const s
     CGPUDevice_Vulkan* D = (CGPUDevice_Vulkan*)cmd->device;
     CGPUTexture_Vulkan* Dst = (CGPUTexture_Vulkan*)desc->dst;
     CGPUBuffer_Vulkan* Src = (CGPUBuffer_Vulkan*)desc->src;
+    CGPUAdapter_Vulkan* A = (CGPUAdapter_Vulkan*)cmd->device->adapter;
     const bool isSinglePlane = true;
     const ECGPUFormat fmt = desc->dst->format;
     if (isSinglePlane)
@@ -298,8 +299,11 @@ void cgpu_cmd_transfer_buffer_to_texture_vulkan(CGPUCommandBufferId cmd, const s
         const uint32_t height = cgpu_max(1, desc->dst->height >> desc->dst_subresource.mip_level);
         const uint32_t depth = cgpu_max(1, desc->dst->depth >> desc->dst_subresource.mip_level);
 
-		const uint32_t xBlocksCount = width / FormatUtil_WidthOfBlock(fmt);
-		const uint32_t yBlocksCount = height / FormatUtil_HeightOfBlock(fmt);
+        // rows are laid out with the pitch of FormatUtil_RowPitch, tail mips smaller than a block still take a whole one
+        const uint32_t blockBytes = cgpu_max(1, FormatUtil_BitSizeOfBlock(fmt) / 8);
+        const uint32_t rowPitch = FormatUtil_RowPitch(fmt, width, A->adapter_detail.upload_buffer_texture_row_alignment);
+		const uint32_t xBlocksCount = rowPitch / blockBytes;
+		const uint32_t yBlocksCount = (height + FormatUtil_HeightOfBlock(fmt) - 1) / FormatUtil_HeightOfBlock(fmt);
 
         VkBufferImageCopy copy = {
             .bufferOffset = desc->src_offset,
@@ -408,6 +412,7 @@ CGPUTextureId cgpu_create_texture_vulkan(CGPUDeviceId device, const struct CGPUT
     VkDeviceMemory pVkDeviceMemory = VK_NULL_HANDLE;
     uint32_t aspect_mask = 0;
     VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+    uint64_t size_in_bytes = 0;
     const bool is_depth_stencil = FormatUtil_IsDepthStencilFormat(desc->format);
     const CGPUFormatSupport* format_support = &A->adapter_detail.format_supports[desc->format];
     if (desc->native_handle && !(desc->flags & CGPU_INNER_TCF_IMPORT_SHARED_HANDLE))
@@ -509,6 +514,10 @@ CGPUTextureId cgpu_create_texture_vulkan(CGPUDeviceId device, const struct CGPUT
             // Aliasing VkImage
             VkResult res = D->mVkDeviceTable.vkCreateImage(D->pVkDevice, &imageCreateInfo, GLOBAL_VkAllocationCallbacks, &pVkImage);
             CHECK_VKRESULT(res);
+            // report the memory the image needs so callers can place it before binding
+            VkMemoryRequirements aliasingMemReq;
+            D->mVkDeviceTable.vkGetImageMemoryRequirements(D->pVkDevice, pVkImage, &aliasingMemReq);
+            size_in_bytes = aliasingMemReq.size;
         }
         else
         {
@@ -674,6 +683,7 @@ CGPUTextureId cgpu_create_texture_vulkan(CGPUDeviceId device, const struct CGPUT
     T->super.is_dedicated = is_dedicated;
     T->super.is_aliasing = desc->is_aliasing;
     T->super.can_alias = can_alias_alloc || desc->is_aliasing;
+    T->super.size_in_bytes = size_in_bytes;
     T->pVkImage = pVkImage;
     if (pVkDeviceMemory) T->pVkDeviceMemory = pVkDeviceMemory;
     if (vmaAllocation) T->pVkAllocation = vmaAllocation;
@@ -900,15 +910,16 @@ bool cgpu_try_bind_aliasing_texture_vulkan(CGPUDeviceId device, const struct CGP
             Aliasing->pVkImage, &aliasingMemReq);
             D->mVkDeviceTable.vkGetImageMemoryRequirements(D->pVkDevice,
             Aliased->pVkImage, &aliasedMemReq);
-            if (aliasedMemReq.size >= aliasingMemReq.size &&
+            if (aliasedMemReq.size >= desc->offset + aliasingMemReq.size &&
                 aliasedMemReq.alignment >= aliasingMemReq.alignment &&
+                desc->offset % aliasingMemReq.alignment == 0 &&
                 aliasedMemReq.memoryTypeBits & aliasingMemReq.memoryTypeBits)
             {
                 const bool isSinglePlane = true;
                 if (isSinglePlane)
                 {
-                    VkResult res = vmaBindImageMemory(D->pVmaAllocator,
-                    Aliased->pVkAllocation, Aliasing->pVkImage);
+                    VkResult res = vmaBindImageMemory2(D->pVmaAllocator,
+                    Aliased->pVkAllocation, desc->offset, Aliasing->pVkImage, CGPU_NULLPTR);
                     if (res == VK_SUCCESS)
                     {
                         Aliasing->pVkAllocation = Aliased->pVkAllocation;
@@ -657,8 +657,10 @@ void VkUtil_RecordAdapterDetail(CGPUAdapter_Vulkan* VkAdapter)
     (uint32_t)prop->limits.minUniformBufferOffsetAlignment;
     adapter_detail->upload_buffer_texture_alignment =
     (uint32_t)prop->limits.optimalBufferCopyOffsetAlignment;
-    adapter_detail->upload_buffer_texture_row_alignment =
-    (uint32_t)prop->limits.optimalBufferCopyRowPitchAlignment;
+    // always safe: vkCmdCopyBufferToImage puts no alignment on bufferRowLength, it only has to be 0 or at least the
+    // copy extent. optimalBufferCopyRowPitchAlignment is a performance hint only, padding rows to it would break the
+    // uploads that stage tightly packed rows and copy with the pitch derived from this value
+    adapter_detail->upload_buffer_texture_row_alignment = 1;
     adapter_detail->max_vertex_input_bindings = prop->limits.maxVertexInputBindings;
     adapter_detail->multidraw_indirect = prop->limits.maxDrawIndirectCount > 1;
     adapter_detail->wave_lane_count = VkAdapter->mSubgroupProperties.subgroupSize;
@@ -2,6 +2,11 @@
 #include "json/writer.h"
 #include "utils/format.hpp"
 #include "platform/debug.h"
+#include "utils/bits.hpp"
+#include "fmt/compile.h"
+#if __SSE2__
+    #include <emmintrin.h>
+#endif
 
 skr_json_writer_t::skr_json_writer_t(size_t levelDepth, skr_json_format_t format)
     : _format(format)
@@ -9,6 +14,14 @@ skr_json_writer_t::skr_json_writer_t(size_t levelDepth, skr_json_format_t format
     _levelStack.reserve(levelDepth);
 }
 
+void skr_json_writer_t::Reset()
+{
+    // keep the capacity of buffer & level stack, so a writer can be reused across documents
+    buffer.clear();
+    _levelStack.clear();
+    _hasRoot = false;
+}
+
 skr::string skr_json_writer_t::Str() const
 {
     SKR_ASSERT(_levelStack.size() == 0);
@@ -126,37 +139,42 @@ bool skr_json_writer_t::_WriteBool(bool b)
 
 bool skr_json_writer_t::_WriteInt(int32_t i)
 {
-    fmt::format_to(std::back_inserter(buffer), "{}", i);
+    const fmt::format_int str(i);
+    buffer.append(str.data(), str.data() + str.size());
     return true;
 }
 
 bool skr_json_writer_t::_WriteUInt(uint32_t i)
 {
-    fmt::format_to(std::back_inserter(buffer), "{}", i);
+    const fmt::format_int str(i);
+    buffer.append(str.data(), str.data() + str.size());
     return true;
 }
 
 bool skr_json_writer_t::_WriteInt64(int64_t i)
 {
-    fmt::format_to(std::back_inserter(buffer), "{}", i);
+    const fmt::format_int str(i);
+    buffer.append(str.data(), str.data() + str.size());
     return true;
 }
 
 bool skr_json_writer_t::_WriteUInt64(uint64_t i)
 {
-    fmt::format_to(std::back_inserter(buffer), "{}", i);
+    const fmt::format_int str(i);
+    buffer.append(str.data(), str.data() + str.size());
     return true;
 }
 
 bool skr_json_writer_t::_WriteFloat(float f)
 {
-    fmt::format_to(std::back_inserter(buffer), "{}", static_cast<double>(f));
+    // shortest round-trip representation, format string is compiled ahead of time
+    fmt::format_to(fmt::appender(buffer), FMT_COMPILE("{}"), static_cast<double>(f));
     return true;
 }
 
 bool skr_json_writer_t::_WriteDouble(double d)
 {
-    fmt::format_to(std::back_inserter(buffer), "{}", d);
+    fmt::format_to(fmt::appender(buffer), FMT_COMPILE("{}"), d);
     return true;
 }
 
@@ -176,23 +194,49 @@ bool skr_json_writer_t::_WriteString(const TChar* str, TSize length)
     };
     buffer.reserve(buffer.size() + 2 + length * 6);
     buffer.push_back('\"');
-    for (TSize i = 0; i < length; ++i)
+    TSize i = 0;
+    while (i < length)
     {
-        const char c = str[i];
-        if (escape[static_cast<unsigned char>(c)])
+        // copy the longest run that needs no escaping in bulk
+        TSize run = i;
+        bool found = false;
+#if __SSE2__
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1F);
+        for (; run + 16 <= length; run += 16)
         {
-            buffer.push_back('\\');
-            buffer.push_back(escape[static_cast<unsigned char>(c)]);
-            if (escape[static_cast<unsigned char>(c)] == 'u')
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + run));
+            // unsigned c <= 0x1F <=> min(c, 0x1F) == c
+            const __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(chars, control), chars);
+            const __m128i needEscape = _mm_or_si128(isControl, _mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)));
+            if (const int mask = _mm_movemask_epi8(needEscape))
             {
-                buffer.push_back('0');
-                buffer.push_back('0');
-                buffer.push_back(hexDigits[static_cast<unsigned char>(c) >> 4]);
-                buffer.push_back(hexDigits[static_cast<unsigned char>(c) & 0xF]);
+                run += (TSize)skr::CountTrailingZeros64((uint64_t)mask);
+                found = true;
+                break;
             }
         }
-        else
-            buffer.push_back(c);
+#endif
+        if (!found)
+        {
+            while (run < length && !escape[static_cast<unsigned char>(str[run])])
+                ++run;
+        }
+        buffer.append(str + i, str + run);
+        if (run == length)
+            break;
+        const char c = str[run];
+        buffer.push_back('\\');
+        buffer.push_back(escape[static_cast<unsigned char>(c)]);
+        if (escape[static_cast<unsigned char>(c)] == 'u')
+        {
+            buffer.push_back('0');
+            buffer.push_back('0');
+            buffer.push_back(hexDigits[static_cast<unsigned char>(c) >> 4]);
+            buffer.push_back(hexDigits[static_cast<unsigned char>(c) & 0xF]);
+        }
+        i = run + 1;
     }
     buffer.push_back('\"');
     return true;
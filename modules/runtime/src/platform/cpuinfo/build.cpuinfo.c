@@ -1,4 +1,5 @@
 #include "platform/configure.h"
+#include "platform/cpu/cpu_features_macros.h"
 
 // utils
 #include "filesystem.c"
@@ -9,7 +10,8 @@
 #include "hwcaps.c"
 #endif
 
-#if defined(__x86_64__) || defined(__i386__)
+// msvc defines _M_X64/_M_IX86 instead of __x86_64__/__i386__
+#if defined(CPU_FEATURES_ARCH_X86)
 
     #if defined(_WIN32) || defined(_WIN64)
     #include "impl_x86_windows.c"
@@ -42,3 +44,15 @@
 
 #endif
 
+
+#include "platform/cpu/isa.h"
+
+bool skr_cpu_has_avx2(void)
+{
+#if defined(CPU_FEATURES_ARCH_X86)
+    const X86Features features = GetX86Info().features;
+    return features.avx2 && features.fma3;
+#else
+    return false;
+#endif
+}
@@ -1,4 +1,5 @@
 #include "value.cpp"
 #include "type_registry.cpp"
+#include "type_plan.cpp"
 #include "dynamic_record_type.cpp"
 #include "base_types.cpp"
\ No newline at end of file
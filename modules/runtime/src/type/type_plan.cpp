@@ -0,0 +1,323 @@
+#include "type/type_plan.hpp"
+#include "platform/debug.h"
+#include "platform/thread.h"
+#include "binary/writer.h"
+#include "json/writer.h"
+#include <string.h>
+
+namespace skr::type
+{
+// types whose copy constructor is a plain memcpy
+static bool IsTrivialCopy(const skr_type_t* type)
+{
+    switch (type->type)
+    {
+        case SKR_TYPE_CATEGORY_BOOL:
+        case SKR_TYPE_CATEGORY_I32:
+        case SKR_TYPE_CATEGORY_I64:
+        case SKR_TYPE_CATEGORY_U32:
+        case SKR_TYPE_CATEGORY_U64:
+        case SKR_TYPE_CATEGORY_F32:
+        case SKR_TYPE_CATEGORY_F64:
+        case SKR_TYPE_CATEGORY_F32_2:
+        case SKR_TYPE_CATEGORY_F32_3:
+        case SKR_TYPE_CATEGORY_F32_4:
+        case SKR_TYPE_CATEGORY_F32_4x4:
+        case SKR_TYPE_CATEGORY_ROT:
+        case SKR_TYPE_CATEGORY_QUAT:
+        case SKR_TYPE_CATEGORY_GUID:
+        case SKR_TYPE_CATEGORY_MD5:
+        case SKR_TYPE_CATEGORY_STRV:
+        case SKR_TYPE_CATEGORY_ARRV:
+        case SKR_TYPE_CATEGORY_ENUM:
+            return true;
+        case SKR_TYPE_CATEGORY_REF:
+            return ((const ReferenceType*)type)->ownership == ReferenceType::Observed;
+        case SKR_TYPE_CATEGORY_ARR:
+            return IsTrivialCopy(((const ArrayType*)type)->elementType);
+        case SKR_TYPE_CATEGORY_OBJ:
+        {
+            auto record = (const RecordType*)type;
+            return (record->flags & RECORD_FLAG_TRIVIAL_COPY) && record->nativeMethods.copy;
+        }
+        default:
+            return false;
+    }
+}
+
+// types whose binary serializer writes exactly their memory bytes
+static bool IsRawBinary(const skr_type_t* type)
+{
+    switch (type->type)
+    {
+        case SKR_TYPE_CATEGORY_I32:
+        case SKR_TYPE_CATEGORY_I64:
+        case SKR_TYPE_CATEGORY_U32:
+        case SKR_TYPE_CATEGORY_U64:
+        case SKR_TYPE_CATEGORY_F32:
+        case SKR_TYPE_CATEGORY_F64:
+        case SKR_TYPE_CATEGORY_F32_2:
+        case SKR_TYPE_CATEGORY_F32_3:
+        case SKR_TYPE_CATEGORY_F32_4:
+        case SKR_TYPE_CATEGORY_F32_4x4:
+        case SKR_TYPE_CATEGORY_ROT:
+        case SKR_TYPE_CATEGORY_QUAT:
+        case SKR_TYPE_CATEGORY_GUID:
+        case SKR_TYPE_CATEGORY_MD5:
+            return true;
+        case SKR_TYPE_CATEGORY_ENUM:
+            return IsRawBinary(((const EnumType*)type)->underlyingType);
+        case SKR_TYPE_CATEGORY_ARR:
+            return IsRawBinary(((const ArrayType*)type)->elementType);
+        default:
+            return false;
+    }
+}
+
+static void PushBytes(skr::vector<TypePlanOp>& ops, size_t offset, size_t size, bool allowGap)
+{
+    if (!ops.empty())
+    {
+        auto& last = ops.back();
+        const auto end = last.offset + last.size;
+        // padding between trivial fields can be copied along, but must never be written out
+        if (last.kind == TypePlanOp::Bytes && (end == offset || (allowGap && end < offset)))
+        {
+            last.size = (uint32_t)(offset + size - last.offset);
+            return;
+        }
+    }
+    TypePlanOp op;
+    op.kind = TypePlanOp::Bytes;
+    op.offset = (uint32_t)offset;
+    op.size = (uint32_t)size;
+    ops.push_back(op);
+}
+
+static void PushCall(skr::vector<TypePlanOp>& ops, size_t offset, const skr_type_t* type)
+{
+    TypePlanOp op;
+    op.kind = TypePlanOp::Call;
+    op.offset = (uint32_t)offset;
+    op.type = type;
+    ops.push_back(op);
+}
+
+static bool CompileCopy(skr::vector<TypePlanOp>& ops, const skr_type_t* type, size_t offset)
+{
+    if (IsTrivialCopy(type))
+    {
+        PushBytes(ops, offset, type->Size(), true);
+        return true;
+    }
+    if (type->type != SKR_TYPE_CATEGORY_OBJ)
+    {
+        PushCall(ops, offset, type);
+        return true;
+    }
+    auto record = (const RecordType*)type;
+    if (!(record->flags & RECORD_FLAG_MEMBERWISE_COPY))
+    {
+        if (!record->nativeMethods.copy)
+            return false;
+        PushCall(ops, offset, type);
+        return true;
+    }
+    if (record->base && !CompileCopy(ops, record->base, offset))
+        return false;
+    for (const auto& field : record->fields)
+    {
+        if (!CompileCopy(ops, field.type, offset + field.offset))
+            return false;
+    }
+    return true;
+}
+
+static bool CompileSerialize(skr::vector<TypePlanOp>& ops, const skr_type_t* type, size_t offset)
+{
+    if (IsRawBinary(type))
+    {
+        PushBytes(ops, offset, type->Size(), false);
+        return true;
+    }
+    if (type->type != SKR_TYPE_CATEGORY_OBJ)
+    {
+        PushCall(ops, offset, type);
+        return true;
+    }
+    auto record = (const RecordType*)type;
+    if (!(record->flags & RECORD_FLAG_MEMBERWISE_BINARY))
+    {
+        if (!record->nativeMethods.Serialize)
+            return false;
+        PushCall(ops, offset, type);
+        return true;
+    }
+    if (record->base && !CompileSerialize(ops, record->base, offset))
+        return false;
+    for (const auto& field : record->fields)
+    {
+        if (!CompileSerialize(ops, field.type, offset + field.offset))
+            return false;
+    }
+    return true;
+}
+
+// emits the key/value pairs of a record, the caller wraps them with StartObject/EndObject
+static bool CompileSerializeTextFields(skr::vector<TypePlanOp>& ops, const RecordType* record, size_t offset)
+{
+    if (!(record->flags & RECORD_FLAG_MEMBERWISE_JSON))
+        return false;
+    if (record->base && !CompileSerializeTextFields(ops, record->base, offset))
+        return false;
+    for (const auto& field : record->fields)
+    {
+        TypePlanOp key;
+        key.kind = TypePlanOp::Key;
+        key.name = field.name;
+        ops.push_back(key);
+        PushCall(ops, offset + field.offset, field.type);
+    }
+    return true;
+}
+
+static TypePlan* CompileTypePlan(const skr_type_t* type)
+{
+    auto plan = SkrNew<TypePlan>();
+    plan->type = type;
+    if (type->type == SKR_TYPE_CATEGORY_OBJ)
+    {
+        auto record = (const RecordType*)type;
+        plan->zeroConstruct = record->flags & RECORD_FLAG_TRIVIAL_CTOR;
+        plan->compiledSerializeText = CompileSerializeTextFields(plan->serializeTextOps, record, 0);
+        if (!plan->compiledSerializeText)
+            plan->serializeTextOps.clear();
+    }
+    else if (type->type == SKR_TYPE_CATEGORY_ARR)
+    {
+        // fixed arrays are unrolled, so that an array of trivial elements collapses into one op
+        auto& arr = *(const ArrayType*)type;
+        auto element = arr.elementType;
+        auto size = element->Size();
+        plan->compiledCopy = true;
+        plan->compiledSerialize = true;
+        for (size_t i = 0; i < arr.num; ++i)
+        {
+            plan->compiledCopy &= CompileCopy(plan->copyOps, element, i * size);
+            plan->compiledSerialize &= CompileSerialize(plan->serializeOps, element, i * size);
+        }
+        if (!plan->compiledCopy)
+            plan->copyOps.clear();
+        if (!plan->compiledSerialize)
+            plan->serializeOps.clear();
+        return plan;
+    }
+    // a record compiled to a single call to itself gains nothing, keep the native method
+    auto isSelfCall = [&](const skr::vector<TypePlanOp>& ops) {
+        return ops.size() == 1 && ops[0].kind == TypePlanOp::Call && ops[0].type == type;
+    };
+    plan->compiledCopy = CompileCopy(plan->copyOps, type, 0) && !isSelfCall(plan->copyOps);
+    if (!plan->compiledCopy)
+        plan->copyOps.clear();
+    plan->compiledSerialize = CompileSerialize(plan->serializeOps, type, 0) && !isSelfCall(plan->serializeOps);
+    if (!plan->compiledSerialize)
+        plan->serializeOps.clear();
+    return plan;
+}
+
+struct TypePlanCache {
+    SMutexObject mutex;
+    skr::vector<TypePlan*> plans;
+    ~TypePlanCache()
+    {
+        for (auto plan : plans)
+            SkrDelete(plan);
+    }
+};
+
+static TypePlanCache& GetTypePlanCache()
+{
+    static TypePlanCache cache;
+    return cache;
+}
+
+template <class T>
+static const TypePlan* GetOrCompileTypePlan(const T* type)
+{
+    if (auto plan = type->plan.load(std::memory_order_acquire))
+        return plan;
+    auto& cache = GetTypePlanCache();
+    SMutexLock lock(cache.mutex.mMutex);
+    if (auto plan = type->plan.load(std::memory_order_relaxed))
+        return plan;
+    auto plan = CompileTypePlan(type);
+    cache.plans.push_back(plan);
+    type->plan.store(plan, std::memory_order_release);
+    return plan;
+}
+
+const TypePlan* GetTypePlan(const skr_type_t* type)
+{
+    switch (type->type)
+    {
+        case SKR_TYPE_CATEGORY_OBJ:
+            return GetOrCompileTypePlan((const RecordType*)type);
+        case SKR_TYPE_CATEGORY_ARR:
+            return GetOrCompileTypePlan((const ArrayType*)type);
+        default:
+            return nullptr;
+    }
+}
+
+void TypePlan::Construct(void* dst) const
+{
+    SKR_ASSERT(zeroConstruct);
+    memset(dst, 0, type->Size());
+}
+
+void TypePlan::Copy(void* dst, const void* src) const
+{
+    SKR_ASSERT(compiledCopy);
+    auto d = (char*)dst;
+    auto s = (const char*)src;
+    for (const auto& op : copyOps)
+    {
+        if (op.kind == TypePlanOp::Bytes)
+            memcpy(d + op.offset, s + op.offset, op.size);
+        else
+            op.type->Copy(d + op.offset, s + op.offset);
+    }
+}
+
+int TypePlan::Serialize(const void* dst, skr_binary_writer_t* writer) const
+{
+    SKR_ASSERT(compiledSerialize);
+    auto d = (const char*)dst;
+    for (const auto& op : serializeOps)
+    {
+        int ret = 0;
+        if (op.kind == TypePlanOp::Bytes)
+            ret = skr::binary::WriteBytes(writer, d + op.offset, op.size);
+        else
+            ret = op.type->Serialize(d + op.offset, writer);
+        if (ret != 0)
+            return ret;
+    }
+    return 0;
+}
+
+void TypePlan::SerializeText(const void* dst, skr_json_writer_t* writer) const
+{
+    SKR_ASSERT(compiledSerializeText);
+    auto d = (const char*)dst;
+    writer->StartObject();
+    for (const auto& op : serializeTextOps)
+    {
+        if (op.kind == TypePlanOp::Key)
+            writer->Key(op.name.data(), (skr_json_writer_size_t)op.name.size());
+        else
+            op.type->SerializeText(d + op.offset, writer);
+    }
+    writer->EndObject();
+}
+} // namespace skr::type
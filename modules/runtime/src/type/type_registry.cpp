@@ -12,6 +12,7 @@
 #include "json/writer.h"
 #include "type/type.hpp"
 #include "type/type_serde.h"
+#include "type/type_plan.hpp"
 
 static auto& skr_get_type_name_map()
 {
@@ -1045,7 +1046,10 @@ void skr_type_t::Construct(void* dst, skr::type::Value* args, size_t nargs) cons
         break;
         case SKR_TYPE_CATEGORY_OBJ: {
             auto& obj = (const RecordType&)(*this);
-            obj.nativeMethods.ctor(dst, args, nargs);
+            if (auto plan = GetTypePlan(this); plan->zeroConstruct)
+                plan->Construct(dst);
+            else
+                obj.nativeMethods.ctor(dst, args, nargs);
         }
         break;
         case SKR_TYPE_CATEGORY_VARIANT: {
@@ -1220,6 +1224,8 @@ void skr_type_t::Copy(void* dst, const void* src) const
         SKR_TYPE_TRIVAL(TRIVAL_TYPE_IMPL)
 #undef TRIVAL_TYPE_IMPL
         case SKR_TYPE_CATEGORY_ARR: {
+            if (auto plan = GetTypePlan(this); plan->compiledCopy)
+                return plan->Copy(dst, src);
             auto& arr = (const ArrayType&)(*this);
             auto element = arr.elementType;
             auto data = (char*)dst;
@@ -1237,6 +1243,8 @@ void skr_type_t::Copy(void* dst, const void* src) const
             CopyImpl<skr::span<char>>(dst, src);
             break;
         case SKR_TYPE_CATEGORY_OBJ: {
+            if (auto plan = GetTypePlan(this); plan->compiledCopy)
+                return plan->Copy(dst, src);
             auto& obj = (const RecordType&)(*this);
             obj.nativeMethods.copy(dst, src);
             break;
@@ -1425,6 +1433,8 @@ int skr_type_t::Serialize(const void* dst, skr_binary_writer_t* writer) const
         SKR_TYPE_TRIVAL(TRIVAL_TYPE_IMPL)
 #undef TRIVAL_TYPE_IMPL
         case SKR_TYPE_CATEGORY_ARR: {
+            if (auto plan = GetTypePlan(this); plan->compiledSerialize)
+                return plan->Serialize(dst, writer);
             auto& arr = (const ArrayType&)(*this);
             auto element = arr.elementType;
             auto data = (char*)dst;
@@ -1440,6 +1450,8 @@ int skr_type_t::Serialize(const void* dst, skr_binary_writer_t* writer) const
             break;
         }
         case SKR_TYPE_CATEGORY_OBJ: {
+            if (auto plan = GetTypePlan(this); plan->compiledSerialize)
+                return plan->Serialize(dst, writer);
             auto& obj = (const RecordType&)(*this);
             return obj.nativeMethods.Serialize(dst, writer);
             break;
@@ -1517,6 +1529,8 @@ void skr_type_t::SerializeText(const void* dst, skr_json_writer_t* writer) const
             break;
         }
         case SKR_TYPE_CATEGORY_OBJ: {
+            if (auto plan = GetTypePlan(this); plan->compiledSerializeText)
+                return plan->SerializeText(dst, writer);
             auto& obj = (const RecordType&)(*this);
             obj.nativeMethods.SerializeText(dst, writer);
             break;
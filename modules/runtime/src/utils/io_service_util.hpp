@@ -242,6 +242,21 @@ struct TaskContainer
         return eastl::nullopt;
     }
 
+    // pops the front task only if filter accepts it
+    template <typename F>
+    eastl::optional<Task> peek_(F&& filter) SKR_NOEXCEPT
+    {
+        optionalLockTasks();
+        SKR_DEFER({ optionalUnlockTasks(); });
+        if (tasks.size() != 0 && filter(tasks.front()))
+        {
+            auto res = tasks.front();
+            tasks.pop_front();
+            return res;
+        }
+        return eastl::nullopt;
+    }
+
     void visit_(eastl::function<void(Task&)> kernel) SKR_NOEXCEPT
     {
         optionalLockTasks();
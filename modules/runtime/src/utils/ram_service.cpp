@@ -15,6 +15,7 @@ public:
         skr_vfs_t* vfs;
         skr::string path;
         uint64_t offset;
+        uint64_t size;
         skr_async_ram_destination_t* destination;
     };
     ~RAMServiceImpl() SKR_NOEXCEPT = default;
@@ -66,8 +67,9 @@ void __ioThreadTask_RAM_execute(skr::io::RAMServiceImpl* service)
                 TracyMessage(task->path.c_str(), task->path.size());
                 // allocate
                 auto fsize = skr_vfs_fsize(vf);
-                task->destination->size = fsize;
-                task->destination->bytes = (uint8_t*)sakura_malloc(fsize);
+                const auto rsize = task->size ? task->size : (fsize > task->offset ? fsize - task->offset : 0);
+                task->destination->size = rsize;
+                task->destination->bytes = (uint8_t*)sakura_malloc(rsize);
             }
             {
                 ZoneScopedN("BeforeLoadingCallback");
@@ -123,6 +125,7 @@ void skr::io::RAMServiceImpl::request(skr_vfs_t* vfs, const skr_ram_io_t* info,
     back.vfs = vfs;
     back.path = skr::string((const char*)info->path);
     back.offset = info->offset;
+    back.size = info->size;
     back.request = async_request;
     back.destination = dst;
     back.priority = info->priority;
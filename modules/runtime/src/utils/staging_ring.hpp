@@ -0,0 +1,83 @@
+#pragma once
+#include "cgpu/api.h"
+#include <EASTL/deque.h>
+
+namespace skr
+{
+namespace io
+{
+// persistent mapped upload buffer of a device, handed out front to back and given back batch by batch
+struct StagingRing
+{
+    // uploads larger than this share of the ring get a buffer of their own
+    static constexpr uint64_t kOverflowDivisor = 4;
+
+    struct Retirement
+    {
+        uint64_t batch_id;
+        uint64_t end;
+        bool done;
+    };
+    CGPUBufferId buffer = nullptr;
+    uint64_t capacity = 0;
+    // monotonic positions, the bytes between tail and head are still read by the gpu
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    // allocation ends in allocation order, one per batch
+    eastl::deque<Retirement> retirements;
+
+    // a single large resource would hold most of the ring until its batch is done
+    bool stages(uint64_t size) const SKR_NOEXCEPT
+    {
+        return size <= capacity / kOverflowDivisor;
+    }
+
+    bool allocate(uint64_t size, uint64_t alignment, uint64_t batch_id, uint64_t& offset) SKR_NOEXCEPT
+    {
+        if (!buffer || size > capacity) return false;
+        // nothing in flight, start over from the front
+        if (retirements.empty()) head = tail = 0;
+        const uint64_t wrapped = head % capacity;
+        uint64_t start = (wrapped + alignment - 1) / alignment * alignment;
+        // the rest of the buffer is skipped if the allocation does not fit in it, offset 0 suits any alignment
+        if (start + size > capacity) start = capacity;
+        const uint64_t new_head = head - wrapped + start + size;
+        if (new_head - tail > capacity) return false;
+        offset = start % capacity;
+        head = new_head;
+        if (retirements.empty() || retirements.back().batch_id != batch_id)
+            retirements.push_back({ batch_id, head, false });
+        else
+            retirements.back().end = head;
+        return true;
+    }
+
+    void retire(uint64_t batch_id) SKR_NOEXCEPT
+    {
+        // batches may finish out of order, memory is only given back up to the oldest one still in flight
+        for (auto& retirement : retirements)
+        {
+            if (retirement.batch_id == batch_id) retirement.done = true;
+        }
+        while (!retirements.empty() && retirements.front().done)
+        {
+            tail = retirements.front().end;
+            retirements.pop_front();
+        }
+    }
+};
+
+// memory uploads stop joining a batch once it holds limit bytes, the first one always gets in
+struct UploadBudget
+{
+    uint64_t limit = UINT64_MAX;
+    uint64_t bytes = 0;
+
+    bool admits(uint64_t size) const SKR_NOEXCEPT
+    {
+        if (!bytes) return true;
+        return bytes < limit && size <= limit - bytes;
+    }
+};
+} // namespace io
+} // namespace skr
@@ -1,4 +1,12 @@
 #include "vram_service_impl.hpp"
+#include <containers/vector.hpp>
+#include <EASTL/algorithm.h>
+
+namespace
+{
+static constexpr uint64_t kDefaultStagingRingSize = 32ull * 1024 * 1024;
+static constexpr uint64_t kBufferUploadAlignment = 16;
+} // namespace
 
 // create resource
 void skr::io::VRAMServiceImpl::createResource(skr::io::VRAMServiceImpl::Task &task) SKR_NOEXCEPT
@@ -35,6 +43,8 @@ CGPUTextureId skr::io::VRAMServiceImpl::createCGPUTexture(const skr_vram_texture
     texture_desc.descriptors = texture_io.vtexture.resource_types;
     texture_desc.flags = texture_io.vtexture.flags;
     texture_desc.format = texture_io.vtexture.format;
+    texture_desc.mip_levels = texture_io.vtexture.mip_levels ? texture_io.vtexture.mip_levels : 1;
+    texture_desc.array_size = 1;
 
     texture_desc.owner_queue = texture_io.transfer_queue;
     texture_desc.start_state = CGPU_RESOURCE_STATE_COPY_DEST;
@@ -194,18 +204,13 @@ void skr::io::VRAMServiceImpl::tryUploadBufferResource(skr::io::VRAMServiceImpl:
         const auto& buffer_io = buffer_task->buffer_io;
         const auto& destination = buffer_task->destination;
         CGPUUploadTask* upload = allocateCGPUUploadTask(buffer_io.device, buffer_io.transfer_queue, buffer_io.opt_semaphore);
-        {
-            ZoneScopedN("PrepareUploadBuffer");
-            skr::string name = buffer_io.vbuffer.buffer_name ? (const char*)buffer_io.vbuffer.buffer_name : "";
-            name += "-upload";
-            upload->upload_buffer = cgpux_create_mapped_upload_buffer(buffer_io.device, buffer_io.src_memory.size, (const char8_t*)name.c_str());
-        }
+        prepareUploadBuffer(task, upload, buffer_io.device, buffer_io.src_memory.size, kBufferUploadAlignment, buffer_io.vbuffer.buffer_name);
 
         if (buffer_io.src_memory.bytes)
         {
             ZoneScopedN("MemcpyToUploadBuffer");
 
-            memcpy((uint8_t*)upload->upload_buffer->cpu_mapped_address, 
+            memcpy((uint8_t*)upload->upload_buffer->cpu_mapped_address + upload->upload_offset, 
                 buffer_io.src_memory.bytes, buffer_io.src_memory.size);
         }
         
@@ -219,7 +224,7 @@ void skr::io::VRAMServiceImpl::tryUploadBufferResource(skr::io::VRAMServiceImpl:
             vb_cpy.dst = destination->buffer;
             vb_cpy.dst_offset = buffer_io.vbuffer.offset;
             vb_cpy.src = upload->upload_buffer;
-            vb_cpy.src_offset = 0;
+            vb_cpy.src_offset = upload->upload_offset;
             vb_cpy.size = buffer_io.src_memory.size;
             cgpu_cmd_transfer_buffer_to_buffer(cmd, &vb_cpy);
         }
@@ -243,6 +248,57 @@ void skr::io::VRAMServiceImpl::tryUploadBufferResource(skr::io::VRAMServiceImpl:
     }
 }
 
+namespace
+{
+struct TextureMipCopy
+{
+    uint32_t mip;
+    uint32_t width;
+    uint32_t height;
+    uint32_t block_rows;
+    uint64_t src_offset;
+    uint32_t src_pitch;
+    uint64_t dst_offset;
+    uint32_t dst_pitch;
+};
+
+// offsets of texture data in an upload buffer have to be multiples of this
+uint64_t TextureUploadPlacement(ECGPUFormat format, const CGPUAdapterDetail* detail)
+{
+    const uint32_t block_bytes = FormatUtil_BitSizeOfBlock(format) / 8;
+    return eastl::max<uint64_t>({ 1u, detail->upload_buffer_texture_alignment, block_bytes });
+}
+
+// source mips are tightly packed, the upload buffer places them with the alignments required by the backend
+uint64_t LayoutTextureMips(const skr_vram_texture_io_t& texture_io, const CGPUAdapterDetail* detail, skr::vector<TextureMipCopy>& copies)
+{
+    const auto format = texture_io.vtexture.format;
+    const uint32_t mip_levels = texture_io.vtexture.mip_levels ? texture_io.vtexture.mip_levels : 1;
+    const uint32_t first_mip = eastl::min(texture_io.first_mip, mip_levels - 1);
+    const uint32_t mip_count = texture_io.mip_count ? eastl::min(texture_io.mip_count, mip_levels - first_mip) : mip_levels - first_mip;
+    const uint32_t block_height = FormatUtil_HeightOfBlock(format);
+    const uint64_t placement = TextureUploadPlacement(format, detail);
+    uint64_t src_offset = 0, dst_offset = 0;
+    copies.resize(mip_count);
+    for (uint32_t i = 0; i < mip_count; ++i)
+    {
+        const uint32_t mip = first_mip + i;
+        auto& copy = copies[i];
+        copy.mip = mip;
+        copy.width = eastl::max(1u, texture_io.vtexture.width >> mip);
+        copy.height = eastl::max(1u, texture_io.vtexture.height >> mip);
+        copy.block_rows = (copy.height + block_height - 1) / block_height;
+        copy.src_pitch = FormatUtil_RowPitch(format, copy.width, 1);
+        copy.src_offset = texture_io.mip_offsets ? texture_io.mip_offsets[i] : src_offset;
+        copy.dst_pitch = FormatUtil_RowPitch(format, copy.width, detail->upload_buffer_texture_row_alignment);
+        copy.dst_offset = (dst_offset + placement - 1) / placement * placement;
+        src_offset = copy.src_offset + (uint64_t)copy.src_pitch * copy.block_rows;
+        dst_offset = copy.dst_offset + (uint64_t)copy.dst_pitch * copy.block_rows;
+    }
+    return dst_offset;
+}
+} // namespace
+
 void skr::io::VRAMServiceImpl::tryUploadTextureResource(skr::io::VRAMServiceImpl::Task& task) SKR_NOEXCEPT
 {
     if (auto texture_task = skr::get_if<skr::io::VRAMServiceImpl::TextureTask>(&task.resource_task))
@@ -255,19 +311,32 @@ void skr::io::VRAMServiceImpl::tryUploadTextureResource(skr::io::VRAMServiceImpl
 
         const auto& texture_io = texture_task->texture_io;
         const auto& destination = texture_task->destination;
+        skr::vector<TextureMipCopy> copies;
+        const auto detail = cgpu_query_adapter_detail(texture_io.device->adapter);
+        const auto upload_size = LayoutTextureMips(texture_io, detail, copies);
         CGPUUploadTask* upload = allocateCGPUUploadTask(texture_io.device, texture_io.transfer_queue, texture_io.opt_semaphore);
-        {
-            ZoneScopedN("PrepareUploadBuffer");
-            skr::string name = texture_io.vtexture.texture_name ? (const char*)texture_io.vtexture.texture_name : "";
-            name += "-upload";
-            upload->upload_buffer = cgpux_create_mapped_upload_buffer(texture_io.device, texture_io.src_memory.size, (const char8_t*)name.c_str());
-        }
+        prepareUploadBuffer(task, upload, texture_io.device, upload_size,
+            TextureUploadPlacement(texture_io.vtexture.format, detail), texture_io.vtexture.texture_name);
 
         if (texture_io.src_memory.bytes)
         {
             ZoneScopedN("MemcpyToUploadBuffer");
 
-            memcpy((uint8_t*)upload->upload_buffer->cpu_mapped_address, texture_io.src_memory.bytes, texture_io.src_memory.size);
+            auto dst = (uint8_t*)upload->upload_buffer->cpu_mapped_address + upload->upload_offset;
+            for (const auto& copy : copies)
+            {
+                SKR_ASSERT(copy.src_offset + (uint64_t)copy.src_pitch * copy.block_rows <= texture_io.src_memory.size);
+                if (copy.src_pitch == copy.dst_pitch)
+                {
+                    memcpy(dst + copy.dst_offset, texture_io.src_memory.bytes + copy.src_offset, (uint64_t)copy.src_pitch * copy.block_rows);
+                    continue;
+                }
+                for (uint32_t row = 0; row < copy.block_rows; ++row)
+                {
+                    memcpy(dst + copy.dst_offset + (uint64_t)row * copy.dst_pitch,
+                        texture_io.src_memory.bytes + copy.src_offset + (uint64_t)row * copy.src_pitch, copy.src_pitch);
+                }
+            }
         }
         
         auto cmd = task.task_batch->get_cmd(texture_io.transfer_queue);
@@ -276,31 +345,45 @@ void skr::io::VRAMServiceImpl::tryUploadTextureResource(skr::io::VRAMServiceImpl
         {
             ZoneScopedN("MakeBarrier");
 
-            CGPUBufferToTextureTransfer tex_cpy = {};
-            tex_cpy.dst = destination->texture;
-            tex_cpy.dst_subresource.aspects = CGPU_TVA_COLOR;
-            // TODO: texture array & mips
-            tex_cpy.dst_subresource.base_array_layer = 0;
-            tex_cpy.dst_subresource.layer_count = 1;
-            tex_cpy.dst_subresource.mip_level = 0;
-            tex_cpy.src = upload->upload_buffer;
-            tex_cpy.src_offset = 0;
-            cgpu_cmd_transfer_buffer_to_texture(cmd, &tex_cpy);
-        }
-        auto texture_barrier = make_zeroed<CGPUTextureBarrier>();
-        texture_barrier.texture = destination->texture;
-        texture_barrier.src_state = CGPU_RESOURCE_STATE_COPY_DEST;
-        texture_barrier.dst_state = CGPU_RESOURCE_STATE_SHADER_RESOURCE;
-        // release
-        if (texture_io.transfer_queue->type == CGPU_QUEUE_TYPE_TRANSFER)
-        {
-            texture_barrier.queue_release = true;
-            texture_barrier.queue_type = texture_io.transfer_queue->type;
+            for (const auto& copy : copies)
+            {
+                CGPUBufferToTextureTransfer tex_cpy = {};
+                tex_cpy.dst = destination->texture;
+                tex_cpy.dst_subresource.aspects = CGPU_TVA_COLOR;
+                // TODO: texture array
+                tex_cpy.dst_subresource.base_array_layer = 0;
+                tex_cpy.dst_subresource.layer_count = 1;
+                tex_cpy.dst_subresource.mip_level = copy.mip;
+                tex_cpy.src = upload->upload_buffer;
+                tex_cpy.src_offset = upload->upload_offset + copy.dst_offset;
+                cgpu_cmd_transfer_buffer_to_texture(cmd, &tex_cpy);
+            }
         }
-        
+        // levels which are not copied stay in COPY_DEST for a later request
+        const uint32_t mip_levels = texture_io.vtexture.mip_levels ? texture_io.vtexture.mip_levels : 1;
+        const bool whole_texture = copies.size() == mip_levels;
+        for (uint32_t i = 0; i < (whole_texture ? 1u : (uint32_t)copies.size()); ++i)
         {
-            ZoneScopedN("Emplace");
-            task.task_batch->texture_barriers.emplace_back(texture_barrier);
+            auto texture_barrier = make_zeroed<CGPUTextureBarrier>();
+            texture_barrier.texture = destination->texture;
+            texture_barrier.src_state = CGPU_RESOURCE_STATE_COPY_DEST;
+            texture_barrier.dst_state = CGPU_RESOURCE_STATE_SHADER_RESOURCE;
+            if (!whole_texture)
+            {
+                texture_barrier.subresource_barrier = true;
+                texture_barrier.mip_level = copies[i].mip;
+            }
+            // release
+            if (texture_io.transfer_queue->type == CGPU_QUEUE_TYPE_TRANSFER)
+            {
+                texture_barrier.queue_release = true;
+                texture_barrier.queue_type = texture_io.transfer_queue->type;
+            }
+            
+            {
+                ZoneScopedN("Emplace");
+                task.task_batch->texture_barriers.emplace_back(texture_barrier);
+            }
         }
 
         texture_task->upload_task = upload;
@@ -369,32 +452,37 @@ void skr::io::VRAMServiceImpl::tryDStorageTextureResource(skr::io::VRAMServiceIm
         const auto& texture_io = ds_texture_task->texture_io;
         const auto& destination = ds_texture_task->destination;
 
-        CGPUDStorageTextureIODescriptor io_desc = {};
-        io_desc.source_type = texture_io.dstorage.source_type;
-        if (io_desc.source_type == CGPU_DSTORAGE_SOURCE_FILE)
+        // dstorage lays out the rows itself, mips are read from the tightly packed source one request each
+        skr::vector<TextureMipCopy> copies;
+        LayoutTextureMips(texture_io, cgpu_query_adapter_detail(texture_io.device->adapter), copies);
+        for (const auto& copy : copies)
         {
-            io_desc.source_file.file = ds_texture_task->dstorage_task->ds_file;
-            io_desc.source_file.offset = 0u;
-            io_desc.source_file.size = ds_texture_task->dstorage_task->file_size;
-            io_desc.width = texture_io.vtexture.width;
-            io_desc.height = texture_io.vtexture.height;
-            io_desc.depth = texture_io.vtexture.depth;
-        }
-        else
-        {
-            io_desc.source_memory.bytes = texture_io.src_memory.bytes;
-            io_desc.source_memory.bytes_size = texture_io.src_memory.size;
-            io_desc.width = texture_io.vtexture.width;
-            io_desc.height = texture_io.vtexture.height;
+            const uint64_t mip_size = (uint64_t)copy.src_pitch * copy.block_rows;
+            CGPUDStorageTextureIODescriptor io_desc = {};
+            io_desc.source_type = texture_io.dstorage.source_type;
+            if (io_desc.source_type == CGPU_DSTORAGE_SOURCE_FILE)
+            {
+                io_desc.source_file.file = ds_texture_task->dstorage_task->ds_file;
+                io_desc.source_file.offset = copy.src_offset;
+                io_desc.source_file.size = (copies.size() == 1) ? ds_texture_task->dstorage_task->file_size : mip_size;
+            }
+            else
+            {
+                io_desc.source_memory.bytes = texture_io.src_memory.bytes + copy.src_offset;
+                io_desc.source_memory.bytes_size = (copies.size() == 1) ? texture_io.src_memory.size : mip_size;
+            }
+            io_desc.mip_level = copy.mip;
+            io_desc.width = copy.width;
+            io_desc.height = copy.height;
             io_desc.depth = texture_io.vtexture.depth;
-        }
-        io_desc.name = texture_io.vtexture.texture_name;
-        io_desc.texture = destination->texture;
+            io_desc.name = texture_io.vtexture.texture_name;
+            io_desc.texture = destination->texture;
 
-        io_desc.compression = texture_io.dstorage.compression;
-        io_desc.uncompressed_size = texture_io.dstorage.uncompressed_size;
+            io_desc.compression = texture_io.dstorage.compression;
+            io_desc.uncompressed_size = (copies.size() == 1) ? texture_io.dstorage.uncompressed_size : mip_size;
 
-        cgpu_dstorage_enqueue_texture_request(ds_texture_task->dstorage_task->storage_queue, &io_desc);
+            cgpu_dstorage_enqueue_texture_request(ds_texture_task->dstorage_task->storage_queue, &io_desc);
+        }
 
         if (auto fence = task.task_batch->get_fence(ds_texture_task->dstorage_task->storage_queue));
         else SKR_UNREACHABLE_CODE();
@@ -461,10 +549,43 @@ skr::io::VRAMServiceImpl::CGPUUploadTask* skr::io::VRAMServiceImpl::allocateCGPU
 
 void skr::io::VRAMServiceImpl::freeCGPUUploadTask(skr::io::VRAMServiceImpl::CGPUUploadTask* upload) SKR_NOEXCEPT
 {
-    if (upload->upload_buffer) cgpu_free_buffer(upload->upload_buffer);
+    if (upload->upload_buffer && !upload->staged) cgpu_free_buffer(upload->upload_buffer);
     SkrDelete(upload);
 }
 
+skr::io::VRAMServiceImpl::StagingRing* skr::io::VRAMServiceImpl::getStagingRing(CGPUDeviceId device) SKR_NOEXCEPT
+{
+    auto it = staging_rings.find(device);
+    if (it != staging_rings.end()) return it->second;
+
+    ZoneScopedN("CreateStagingRing");
+    auto ring = SkrNew<StagingRing>();
+    ring->capacity = staging_ring_size ? staging_ring_size : kDefaultStagingRingSize;
+    ring->buffer = cgpux_create_mapped_upload_buffer(device, ring->capacity, u8"VRAMServiceStagingRing");
+    staging_rings[device] = ring;
+    return ring;
+}
+
+void skr::io::VRAMServiceImpl::prepareUploadBuffer(Task& task, CGPUUploadTask* upload, CGPUDeviceId device,
+    uint64_t size, uint64_t alignment, const char8_t* name) SKR_NOEXCEPT
+{
+    ZoneScopedN("PrepareUploadBuffer");
+
+    auto ring = getStagingRing(device);
+    if (ring->stages(size) && ring->allocate(size, alignment, task.task_batch->id, upload->upload_offset))
+    {
+        upload->upload_buffer = ring->buffer;
+        upload->staged = true;
+        auto& rings = task.task_batch->staging_rings;
+        if (eastl::find(rings.begin(), rings.end(), ring) == rings.end()) rings.emplace_back(ring);
+        return;
+    }
+    skr::string upload_name = name ? (const char*)name : "";
+    upload_name += "-upload";
+    upload->upload_buffer = cgpux_create_mapped_upload_buffer(device, size, (const char8_t*)upload_name.c_str());
+    upload->upload_offset = 0;
+}
+
 skr::io::VRAMServiceImpl::CGPUDStorageTask* skr::io::VRAMServiceImpl::allocateCGPUDStorageTask(CGPUDeviceId device, CGPUDStorageQueueId storage_queue, CGPUDStorageFileHandle file) SKR_NOEXCEPT
 {
     ZoneScopedN("AllocateCGPUDStorageTask");
@@ -489,6 +610,18 @@ void skr::io::VRAMServiceImpl::freeCGPUDStorageTask(CGPUDStorageTask* task) SKR_
 }
 // cgpu helpers
 
+namespace
+{
+uint64_t UploadSizeOf(const skr::io::VRAMServiceImpl::Task& task)
+{
+    if (auto buffer_task = skr::get_if<skr::io::VRAMServiceImpl::BufferTask>(&task.resource_task))
+        return buffer_task->buffer_io.src_memory.size;
+    if (auto texture_task = skr::get_if<skr::io::VRAMServiceImpl::TextureTask>(&task.resource_task))
+        return texture_task->texture_io.src_memory.size;
+    return 0;
+}
+} // namespace
+
 void __ioThreadTask_VRAM_execute(skr::io::VRAMServiceImpl* service)
 {
     using namespace skr::io;
@@ -564,13 +697,21 @@ void __ioThreadTask_VRAM_execute(skr::io::VRAMServiceImpl* service)
             upload_batch->id = upload_batch_id;
             dstorage_batch->id = dstorage_batch_id;
 
-            while (auto iter = service->tasks.peek_())
+            skr::io::UploadBudget budget;
+            if (service->upload_budget) budget.limit = service->upload_budget;
+            auto within_budget = [&](const skr::io::VRAMServiceImpl::Task& task) {
+                return task.isDStorage() || budget.admits(UploadSizeOf(task));
+            };
+            while (auto iter = service->tasks.peek_(within_budget))
             {
                 if (!iter.has_value()) break;
                 if (iter.value().isDStorage())
                     dstorage_batch->tasks.emplace_back(iter.value()).task_batch = dstorage_batch;
                 else
+                {
+                    budget.bytes += UploadSizeOf(iter.value());
                     upload_batch->tasks.emplace_back(iter.value()).task_batch = upload_batch;
+                }
             }
             
             if (!upload_batch->tasks.empty())
@@ -697,6 +838,10 @@ void __ioThreadTask_VRAM_execute(skr::io::VRAMServiceImpl* service)
                     foreach_task(task);
                     SKR_ASSERT(task.step == kStepFinished);
                 }
+                for (auto ring : batch.second->staging_rings)
+                {
+                    ring->retire(batch.second->id);
+                }
                 SKR_LOG_TRACE("Delete Upload/DirectStorage Batch %d with %d Tasks", batch.second->id, batch.second->tasks.size());
                 SkrDelete(batch.second);
                 batch.second = nullptr;
@@ -832,9 +977,20 @@ void skr::io::VRAMServiceImpl::request(const skr_vram_texture_io_t* texture_info
     threaded_service.request_();
 }
 
+skr::io::VRAMServiceImpl::~VRAMServiceImpl() SKR_NOEXCEPT
+{
+    for (auto [device, ring] : staging_rings)
+    {
+        if (ring->buffer) cgpu_free_buffer(ring->buffer);
+        SkrDelete(ring);
+    }
+}
+
 skr_io_vram_service_t* skr_io_vram_service_t::create(const skr_vram_io_service_desc_t* desc) SKR_NOEXCEPT
 {
     auto service = SkrNew<skr::io::VRAMServiceImpl>(desc->sleep_time, desc->lockless);
+    service->staging_ring_size = desc->staging_ring_size;
+    service->upload_budget = desc->upload_budget;
     service->threaded_service.create_(desc->sleep_mode);
     service->threaded_service.sortMethod = desc->sort_method;
     service->threaded_service.sleepMode = desc->sleep_mode;
@@ -2,9 +2,11 @@
 #include "cgpu/io.h"
 #include "utils/make_zeroed.hpp"
 #include "io_service_util.hpp"
+#include "staging_ring.hpp"
 #include <containers/string.hpp>
 #include <containers/variant.hpp>
 #include <EASTL/vector_map.h>
+#include <EASTL/deque.h>
 
 namespace skr
 {
@@ -29,9 +31,13 @@ public:
         CGPUQueueId queue = nullptr;
         CGPUSemaphoreId semaphore = nullptr;
         CGPUBufferId upload_buffer = nullptr;
+        uint64_t upload_offset = 0;
+        // upload_buffer is the staging ring of the device, which owns it
+        bool staged = false;
         CGPUTextureId dst_texture = nullptr;
         bool finished = false;
     };
+    using StagingRing = skr::io::StagingRing;
     struct BufferTask {
         skr_vram_buffer_io_t buffer_io;
         skr_async_vbuffer_destination_t* destination;
@@ -72,7 +78,7 @@ public:
             return skr::get_if<DStorageBufferTask>(&resource_task) || skr::get_if<DStorageTextureTask>(&resource_task);
         }
     };
-    ~VRAMServiceImpl() SKR_NOEXCEPT = default;
+    ~VRAMServiceImpl() SKR_NOEXCEPT;
     VRAMServiceImpl(uint32_t sleep_time, bool lockless) SKR_NOEXCEPT
         : tasks(lockless), threaded_service(sleep_time, lockless)
 
@@ -122,6 +128,9 @@ public:
     void freeCGPUUploadTask(CGPUUploadTask* task) SKR_NOEXCEPT; 
     CGPUDStorageTask* allocateCGPUDStorageTask(CGPUDeviceId, CGPUDStorageQueueId, CGPUDStorageFileHandle) SKR_NOEXCEPT; 
     void freeCGPUDStorageTask(CGPUDStorageTask* task) SKR_NOEXCEPT; 
+    // places size bytes in the staging ring of the device, or in a buffer of their own if they are too large or the ring is full
+    void prepareUploadBuffer(Task& task, CGPUUploadTask* upload, CGPUDeviceId device, uint64_t size, uint64_t alignment, const char8_t* name) SKR_NOEXCEPT;
+    StagingRing* getStagingRing(CGPUDeviceId device) SKR_NOEXCEPT;
     // cgpu helpers
 
     const skr::string name;
@@ -137,6 +146,8 @@ public:
         eastl::vector_map<CGPUQueueId, CGPUFenceId> fences;
         eastl::vector_map<CGPUQueueId, CGPUCommandPoolId> cmd_pools;
         eastl::vector_map<CGPUQueueId, CGPUCommandBufferId> cmds;
+        // staging rings the batch took memory from
+        eastl::vector<StagingRing*> staging_rings;
         // DStorage Resources
         eastl::vector_map<CGPUDStorageQueueId, CGPUFenceId> ds_fences;
         bool submitted = false;
@@ -242,6 +253,9 @@ public:
     // CGPU Objects
     eastl::vector<CGPUUploadTask*> resource_uploads;
     eastl::vector<CGPUDStorageTask*> dstorage_uploads;
+    eastl::vector_map<CGPUDeviceId, StagingRing*> staging_rings;
+    uint64_t staging_ring_size = 0;
+    uint64_t upload_budget = 0;
 };
 
 }
@@ -99,6 +99,26 @@ skr_scale_comp_t
     skr_float3_t value;
 };
 
+// bounds
+
+// object space box of the entity, the transform system keeps the world bounds of entities with both up to date
+sreflect_struct("guid" : "6d6b8a51-8a4e-4d56-9d0c-0f3a8b8f6c21", "component" : true)
+skr_bounds_comp_t
+{
+    skr_float3_t center;
+    skr_float3_t extent;
+};
+typedef struct skr_bounds_comp_t skr_bounds_comp_t;
+
+// world space axis aligned box enclosing the transformed object space box
+sreflect_struct("guid" : "2f1f3c6e-5b7a-4c0e-a8a5-7d1e9b3c4f60", "component" : true)
+skr_world_bounds_comp_t
+{
+    skr_float3_t center;
+    skr_float3_t extent;
+};
+typedef struct skr_world_bounds_comp_t skr_world_bounds_comp_t;
+
 sreflect_struct("guid" : "4fa24729-2c66-45a2-9417-3497ebc18771", "component" : true)
 skr_movement_comp_t
 {
@@ -116,10 +136,12 @@ skr_camera_comp_t
 
 struct skr_transform_system_t {
     dual_query_t* relativeToWorld;
+    dual_query_t* worldBounds;
 };
 
 SKR_SCENE_EXTERN_C SKR_SCENE_API void skr_transform_setup(dual_storage_t* world, skr_transform_system_t* system);
 SKR_SCENE_EXTERN_C SKR_SCENE_API void skr_transform_update(skr_transform_system_t* query);
+SKR_SCENE_EXTERN_C SKR_SCENE_API void skr_transform_bounds(const skr_transform_t* transform, const skr_bounds_comp_t* bounds, skr_world_bounds_comp_t* world_bounds);
 SKR_SCENE_EXTERN_C SKR_SCENE_API void skr_propagate_transform(dual_storage_t* world, dual_entity_t* entities, uint32_t count);
 SKR_SCENE_EXTERN_C SKR_SCENE_API void skr_save_scene(dual_storage_t* world, struct skr_json_writer_t* writer);
 SKR_SCENE_EXTERN_C SKR_SCENE_API void skr_load_scene(dual_storage_t* world, struct skr_json_reader_t* reader);
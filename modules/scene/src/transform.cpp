@@ -7,6 +7,7 @@
 #include "math/matrix4x4f.h"
 #include "math/vector.h"
 #include "math/quat.h"
+#include "math/transform.h"
 #include "rtm/qvvf.h"
 
 rtm::qvvf make_qvv(skr_rotator_t* r, skr_float3_t* t, skr_float3_t* s)
@@ -90,13 +91,52 @@ static void skr_relative_to_world_root(void* u, dual_query_t* query, dual_chunk_
     }
 }
 
+static void skr_world_bounds(const rtm::qvvf& transform, const skr_bounds_comp_t& bounds, skr_world_bounds_comp_t& world_bounds)
+{
+    // the box of the transformed box: the center moves with the transform, the extent takes the absolute axes
+    const auto matrix = rtm::matrix_from_qvv(transform);
+    const auto center = rtm::matrix_mul_point3(skr::math::load(bounds.center), matrix);
+    auto extent = rtm::vector_mul(rtm::vector_abs(matrix.x_axis), bounds.extent.x);
+    extent = rtm::vector_mul_add(rtm::vector_abs(matrix.y_axis), bounds.extent.y, extent);
+    extent = rtm::vector_mul_add(rtm::vector_abs(matrix.z_axis), bounds.extent.z, extent);
+    skr::math::store(center, world_bounds.center);
+    skr::math::store(extent, world_bounds.extent);
+}
+
+static void skr_world_bounds_update(void* u, dual_query_t* query, dual_chunk_view_t* view, dual_type_index_t* localTypes, EIndex entityIndex)
+{
+    auto world_bounds = (skr_world_bounds_comp_t*)dualV_get_owned_rw_local(view, localTypes[0]);
+    auto bounds = (skr_bounds_comp_t*)dualV_get_owned_ro_local(view, localTypes[1]);
+    auto transforms = (skr_transform_t*)dualV_get_owned_ro_local(view, localTypes[2]);
+    auto translations = (skr_float3_t*)dualV_get_owned_ro_local(view, localTypes[3]);
+    auto rotations = (skr_rotator_t*)dualV_get_owned_ro_local(view, localTypes[4]);
+    auto scales = (skr_float3_t*)dualV_get_owned_ro_local(view, localTypes[5]);
+    // only entities in a hierarchy get their world transform computed, the others are placed by their own components
+    const bool in_hierarchy = dualV_get_owned_ro(view, dual_id_of<skr_parent_comp_t>::get()) || dualV_get_owned_ro(view, dual_id_of<skr_child_comp_t>::get());
+    for (EIndex i = 0; i < view->count; ++i)
+    {
+        const auto transform = (transforms && in_hierarchy) ?
+            skr::math::load(transforms[i]) :
+            make_qvv(rotations ? &rotations[i] : nullptr, translations ? &translations[i] : nullptr, scales ? &scales[i] : nullptr);
+        skr_world_bounds(transform, bounds[i], world_bounds[i]);
+    }
+}
+
+void skr_transform_bounds(const skr_transform_t* transform, const skr_bounds_comp_t* bounds, skr_world_bounds_comp_t* world_bounds)
+{
+    skr_world_bounds(skr::math::load(*transform), *bounds, *world_bounds);
+}
+
 void skr_transform_setup(dual_storage_t* world, skr_transform_system_t* system)
 {
     // then recursively calculate local to world for node entities
     system->relativeToWorld = dualQ_from_literal(world, "[inout]<seq>skr_transform_comp_t,[in]<seq>skr_child_comp_t,!skr_parent_comp_t,[in]<seq>?skr_translation_comp_t,[in]<seq>?skr_rotation_comp_t,[in]<seq>?skr_scale_comp_t");
+    // world bounds follow the transforms
+    system->worldBounds = dualQ_from_literal(world, "[inout]<seq>skr_world_bounds_comp_t,[in]<seq>skr_bounds_comp_t,[in]<seq>?skr_transform_comp_t,[in]<seq>?skr_translation_comp_t,[in]<seq>?skr_rotation_comp_t,[in]<seq>?skr_scale_comp_t");
 }
 
 void skr_transform_update(skr_transform_system_t* query)
 {
     dualJ_schedule_ecs(query->relativeToWorld, 128, &skr_relative_to_world_root, nullptr, nullptr, nullptr, nullptr, nullptr);
+    dualJ_schedule_ecs(query->worldBounds, 256, &skr_world_bounds_update, nullptr, nullptr, nullptr, nullptr, nullptr);
 }
@@ -3,13 +3,11 @@
 #include "SkrAnim/resources/animation_resource.h"
 #include "SkrAnim/resources/skeleton_resource.h"
 #include "SkrAnim/resources/skin_resource.h"
-#include "SkrAnim/ozz/base/maths/soa_transform.h"
-#include "SkrAnim/ozz/sampling_job.h"
 #ifndef __meta__
 #include "GameRuntime/game_animation.generated.h"
 #endif
 
-struct skr_render_anim_comp_t;
+struct skr_anim_blend_comp_t;
 
 namespace game sreflect
 {  
@@ -22,13 +20,10 @@ namespace game sreflect
     anim_state_t
     {
         SKR_RESOURCE_FIELD(skr_anim_resource_t, animation_resource);
-        sattr("native" : true)
-        eastl::vector<ozz::math::SoaTransform> local_transforms;
-        sattr("native" : true)
-        ozz::animation::SamplingJob::Context sampling_context;
         float currtime = 0.f;
     };
 
-    GAME_RUNTIME_API void InitializeAnimState(anim_state_t* state, skr_skeleton_resource_t* skeleton);
-    GAME_RUNTIME_API void UpdateAnimState(anim_state_t* state, skr_skeleton_resource_t* skeleton, float dt, skr_render_anim_comp_t* output);
-}
\ No newline at end of file
+    // plays the animation of the state on the first layer of a blend tree evaluated by the anim system
+    // and mirrors the playback time back to the state, where scripts and the inspector see it
+    GAME_RUNTIME_API void SyncAnimState(anim_state_t* state, skr_anim_blend_comp_t* blend, struct dual_storage_t* storage);
+}
@@ -33,6 +33,7 @@
 
 #include "resource/local_resource_registry.hpp"
 #include "SkrRenderer/shader_map.h"
+#include "SkrRenderer/pso_map.h"
 #include "SkrRenderer/render_viewport.h"
 #include "SkrRenderer/resources/texture_resource.h"
 #include "SkrRenderer/resources/mesh_resource.h"
@@ -44,6 +45,7 @@
 #include "SkrAnim/resources/skin_resource.h"
 #include "SkrAnim/components/skin_component.h"
 #include "SkrAnim/components/skeleton_component.h"
+#include "SkrAnim/components/blend_component.h"
 #include "GameRuntime/game_animation.h"
 
 #include "tracy/Tracy.hpp"
@@ -56,7 +58,7 @@
 
 uint32_t backbuffer_index;
 extern void create_imgui_resources(skr_vfs_t* resource_vfs, SRenderDeviceId render_device, skr::render_graph::RenderGraph* renderGraph);
-extern void game_initialize_render_effects(SRendererId renderer, skr::render_graph::RenderGraph* renderGraph, skr_vfs_t* resource_vfs);
+extern void game_initialize_render_effects(SRendererId renderer, skr::render_graph::RenderGraph* renderGraph, skr_vfs_t* resource_vfs, skr::resource::STextureFactory* texture_factory);
 extern void game_register_render_effects(SRendererId renderer, skr::render_graph::RenderGraph* renderGraph);
 extern void game_finalize_render_effects(SRendererId renderer, skr::render_graph::RenderGraph* renderGraph);
 #define lerp(a, b, t) (a) + (t) * ((b) - (a))
@@ -153,6 +155,8 @@ void SGameModule::installResourceFactories()
         factoryRoot.ram_service = ram_service;
         factoryRoot.vram_service = game_render_device->get_vram_service();
         factoryRoot.render_device = game_render_device;
+        // larger levels are streamed in by the forward effects once their meshes get close enough
+        factoryRoot.streaming_max_extent = 256;
         textureFactory = skr::resource::STextureFactory::Create(factoryRoot);
         resource_system->RegisterFactory(textureFactory);
     }
@@ -307,6 +311,8 @@ void SGameModule::on_load(int argc, char** argv)
         scheduler.initialize(skr::task::scheudler_config_t{});
         scheduler.bind();
         dualJ_bind_storage(game_world);
+        // the effects resolve their shared state in on_update and produce their draw packets on tasks
+        skr_renderer_enable_parallel_produce(game_renderer, true);
     }
     installResourceFactories();
     g_game_module = this;
@@ -319,6 +325,7 @@ void create_test_scene(SRendererId renderer)
     renderableT_builder
     .with<skr_translation_comp_t, skr_rotation_comp_t, skr_scale_comp_t>()
     .with<skr_index_comp_t, skr_movement_comp_t>()
+    .with<skr_bounds_comp_t, skr_world_bounds_comp_t>()
     .with<skr_render_effect_t>()
     .with(DUAL_COMPONENT_GUID);
     // allocate renderable
@@ -331,6 +338,7 @@ void create_test_scene(SRendererId renderer)
         auto scales = dual::get_owned_rw<skr_scale_comp_t>(view);
         auto indices = dual::get_owned_rw<skr_index_comp_t>(view);
         auto movements = dual::get_owned_rw<skr_movement_comp_t>(view);
+        auto bounds = dual::get_owned_rw<skr_bounds_comp_t>(view);
         auto states = dual::get_owned_rw<game::anim_state_t>(view);
         auto guids = (skr_guid_t*)dualV_get_owned_ro(view, DUAL_COMPONENT_GUID);
         for (uint32_t i = 0; i < view->count; i++)
@@ -343,6 +351,8 @@ void create_test_scene(SRendererId renderer)
                 rotations[i].euler = { 0.f, 0.f, 0.f };
                 scales[i].value = { 8.f, 8.f, 8.f };
                 if (indices) indices[i].value = init_idx++;
+                // the cubes draw the unit cube geometry
+                if (bounds) bounds[i] = { { 0.f, 0.f, 0.f }, { .5f, .5f, .5f } };
             }
             else
             {
@@ -413,6 +423,7 @@ void async_attach_skin_mesh(SRendererId renderer)
             auto mesh_comps = dual::get_owned_rw<skr_render_mesh_comp_t>(view);
             auto skin_comps = dual::get_owned_rw<skr_render_skin_comp_t>(view);
             auto skel_comps = dual::get_owned_rw<skr_render_skel_comp_t>(view);
+            auto lod_comps = dual::get_owned_rw<skr_anim_lod_comp_t>(view);
             // auto anim_comps = dual::get_owned_rw<skr_render_anim_comp_t>(view);
 
             for (uint32_t i = 0; i < view->count; i++)
@@ -427,6 +438,7 @@ void async_attach_skin_mesh(SRendererId renderer)
                 skin_comp.skin_resource.resolve(true, renderer->get_dual_storage());
                 skel_comp.skeleton = "d1acf969-91d6-4233-8d2b-33fca7c98a1c"_guid;
                 skel_comp.skeleton.resolve(true, renderer->get_dual_storage());
+                lod_comps[i] = skr_anim_lod_comp_t();
             }
         };
         skr_render_effect_access(renderer, view, "ForwardEffectSkin", DUAL_LAMBDA(requestSetup));
@@ -517,9 +529,10 @@ int SGameModule::main_module_exec(int argc, char** argv)
     [=](skr::render_graph::RenderGraphBuilder& builder) {
         builder.with_device(cgpu_device)
         .with_gfx_queue(gfx_queue)
-        .enable_memory_aliasing();
+        .enable_memory_aliasing()
+        .enable_parallel_recording(4);
     });
-    game_initialize_render_effects(game_renderer, renderGraph, resource_vfs);
+    game_initialize_render_effects(game_renderer, renderGraph, resource_vfs, textureFactory);
     create_test_scene(game_renderer);
     create_imgui_resources(resource_vfs, render_device, renderGraph);
     // Lua
@@ -545,9 +558,11 @@ int SGameModule::main_module_exec(int argc, char** argv)
     scene_handle.resolve(true, 0, SKR_REQUESTER_SYSTEM);
 
     // Viewport
+    uint32_t main_viewport_id = 0;
     {
         auto viewport_manager = game_renderer->get_viewport_manager();
-        viewport_manager->register_viewport("main_viewport");
+        main_viewport_id = viewport_manager->register_viewport("main_viewport");
+        skr_renderer_set_viewport(game_renderer, main_viewport_id);
     }
     
     // Time
@@ -565,12 +580,26 @@ int SGameModule::main_module_exec(int argc, char** argv)
     dual_query_t* moveQuery;
     dual_query_t* cameraQuery;
     dual_query_t* animQuery;
+    skr_anim_system_t* animSystem;
+    skr_transform_system_t transformSystem;
+    skr_transform_setup(game_world, &transformSystem);
     moveQuery = dualQ_from_literal(game_world,
         "[has]skr_movement_comp_t, [inout]skr_translation_comp_t, [in]skr_scale_comp_t, [in]skr_index_comp_t, !skr_camera_comp_t");
     cameraQuery = dualQ_from_literal(game_world,
         "[has]skr_movement_comp_t, [inout]skr_translation_comp_t, [inout]skr_camera_comp_t");
     animQuery = dualQ_from_literal(game_world,
-        "[in]skr_render_effect_t, [in]game::anim_state_t, [out]<unseq>skr_render_anim_comp_t, [in]<unseq>skr_render_skel_comp_t");
+        "[in]skr_render_effect_t, [inout]game::anim_state_t, [in]skr_translation_comp_t");
+    animSystem = skr_anim_system_create(game_world);
+    {
+        // characters far from the camera update less often, the farthest ones also skip their finer joints
+        const skr_anim_lod_level_t animLods[] = {
+            { 30.f, 1, 0, false },
+            { 80.f, 2, 0, true },
+            { 200.f, 4, 0, true },
+            { 400.f, 8, 32, true },
+        };
+        skr_anim_system_set_lods(animSystem, animLods, sizeof(animLods) / sizeof(animLods[0]));
+    }
     initAnimSkinQuery = dualQ_from_literal(game_world, 
         "[inout]skr_render_anim_comp_t, [inout]skr_render_skin_comp_t, [in]skr_render_mesh_comp_t, [in]skr_render_skel_comp_t");
     skinQuery = dualQ_from_literal(game_world, 
@@ -593,6 +622,9 @@ int SGameModule::main_module_exec(int argc, char** argv)
         }, this);
     skr_imgui_initialize(handler);
 
+    // PSOs the last run used are created on the task system while the first frames load
+    bool pso_warming_up = bUseJob && matFactory->BeginPSOWarmup(resource_vfs, u8"pso_manifest.bin", 0);
+
     while (!quit)
     {
         FrameMark;
@@ -626,6 +658,18 @@ int SGameModule::main_module_exec(int argc, char** argv)
         // Update resources
         auto resource_system = skr::resource::GetResourceSystem();
         resource_system->Update();
+        textureFactory->UpdateStreaming();
+        matFactory->UpdateTextureViews();
+        if (pso_warming_up)
+        {
+            ZoneScopedN("PSOWarmup");
+            skr_pso_map_warmup_progress_t progress = {};
+            pso_warming_up = !matFactory->UpdatePSOWarmup(&progress);
+            if (!pso_warming_up)
+            {
+                SKR_LOG_INFO("pso warm up finished: %u compiled, %u failed of %u", progress.compiled, progress.failed, progress.total);
+            }
+        }
 
         // Update camera
         auto cameraUpdate = [=](dual_chunk_view_t* view) {
@@ -633,7 +677,7 @@ int SGameModule::main_module_exec(int argc, char** argv)
             for (uint32_t i = 0; i < view->count; i++)
             {
                 cameras[i].renderer = game_renderer;
-                cameras[i].viewport_id = 0u; // TODO: viewport id
+                cameras[i].viewport_id = main_viewport_id;
                 cameras[i].viewport_width = swapchain->back_buffers[0]->width;
                 cameras[i].viewport_height = swapchain->back_buffers[0]->height;
             }
@@ -732,46 +776,49 @@ int SGameModule::main_module_exec(int argc, char** argv)
             dualJ_schedule_ecs(moveQuery, 1024, DUAL_LAMBDA_POINTER(moveJob), nullptr, nullptr);
         }
 
+        // world transforms and bounds of the moved entities
+        {
+            ZoneScopedN("TransformSystem");
+            skr_transform_update(&transformSystem);
+        }
+
         // sync all jobs here ?
         {
             // ZoneScopedN("DualJSync");
             // dualJ_wait_all();
         }
 
-        // [inout]skr_render_anim_comp_t, [in]game::anim_state_t, [in]skr_render_skel_comp_t
+        // [in]skr_render_effect_t, [inout]game::anim_state_t, [in]skr_translation_comp_t
         {
             ZoneScopedN("AnimSystem");
-            auto animJob = SkrNewLambda([=](dual_query_t* query, dual_chunk_view_t* view, dual_type_index_t* localTypes, EIndex entityIndex) {
-                ZoneScopedN("AnimJob");
-                auto states = (game::anim_state_t*)dualV_get_owned_ro_local(view, localTypes[1]);
+            // the blend trees live on the skin effects and are only touched here while the anim jobs are done
+            auto syncAnimStates = [&](dual_chunk_view_t* view) {
+                auto states = dual::get_owned_rw<game::anim_state_t>(view);
+                auto translations = dual::get_owned_ro<skr_translation_comp_t>(view);
                 uint32_t g_id = 0;
                 auto syncEffect = [&](dual_chunk_view_t* view) {
-                    auto anims = dual::get_owned_rw<skr_render_anim_comp_t>(view);
-                    auto skels = dual::get_component_ro<skr_render_skel_comp_t>(view);
+                    auto blends = dual::get_owned_rw<skr_anim_blend_comp_t>(view);
+                    auto transforms = dual::get_owned_rw<skr_transform_comp_t>(view);
                     for (uint32_t i = 0; i < view->count; ++i, ++g_id)
                     {
-                        auto& anim = anims[i];
-                        auto& skel = skels[i];
-                        auto& state = states[g_id];
-                        auto skeleton_resource = skel.skeleton.get_resolved();
-                        if (!skeleton_resource)
-                            continue;
-                        if (anim.buffers.empty())
-                            continue;
-                        if (state.sampling_context.max_tracks() == 0)
-                        {
-                            ZoneScopedN("InitializeAnimState");
-                            game::InitializeAnimState(&state, skeleton_resource);
-                        }
-                        {
-                            ZoneScopedN("UpdateAnimState");
-                            game::UpdateAnimState(&state, skeleton_resource, (float)deltaTime, &anim);
-                        }
+                        game::SyncAnimState(&states[g_id], &blends[i], game_world);
+                        // the lod of a character follows the distance of its game entity
+                        transforms[i].value.translation = translations[g_id].value;
                     }
                 };
                 skr_render_effect_access(game_renderer, view, "ForwardEffectSkin", DUAL_LAMBDA(syncEffect));
-            });
-            dualJ_schedule_ecs(animQuery, 128, DUAL_LAMBDA_POINTER(animJob), nullptr, nullptr);
+            };
+            auto syncViewer = [&](dual_chunk_view_t* view) {
+                auto translations = dual::get_owned_ro<skr_translation_comp_t>(view);
+                if (view->count)
+                    skr_anim_system_set_viewer(animSystem, translations[0].value);
+            };
+            skr_anim_system_wait(animSystem);
+            dualQ_sync(cameraQuery);
+            dualQ_get_views(cameraQuery, DUAL_LAMBDA(syncViewer));
+            dualQ_sync(animQuery);
+            dualQ_get_views(animQuery, DUAL_LAMBDA(syncAnimStates));
+            skr_anim_system_update(animSystem, (float)deltaTime);
         }
         {
             ZoneScopedN("SkinSystem");
@@ -817,18 +864,10 @@ int SGameModule::main_module_exec(int argc, char** argv)
                 const auto meshes = dual::get_component_ro<skr_render_mesh_comp_t>(view);
                 const auto anims = dual::get_component_ro<skr_render_anim_comp_t>(view);
                 auto skins = dual::get_owned_rw<skr_render_skin_comp_t>(view);
-                
-                for (uint32_t i = 0; i < view->count; i++)
                 {
-                    auto mesh_resource = meshes[i].mesh_resource.get_resolved();
-                    if(!mesh_resource)
-                        continue;
-                    if (!skins[i].joint_remaps.empty() && !anims[i].buffers.empty())
-                    {
-                        ZoneScopedN("CPU Skin");
+                    ZoneScopedN("CPU Skin");
 
-                        skr_cpu_skin(skins + i, anims + i, mesh_resource);
-                    }
+                    skr_cpu_skin_batch(skins, anims, meshes, view->count);
                 }
             });
             dualJ_schedule_ecs(skinQuery, 4, DUAL_LAMBDA_POINTER(cpuSkinJob), nullptr, &pSkinCounter);
@@ -955,6 +994,9 @@ int SGameModule::main_module_exec(int argc, char** argv)
         }
     }
     // clean up
+    skr_anim_system_free(animSystem);
+    if (pso_warming_up) matFactory->EndPSOWarmup();
+    matFactory->SavePSOManifest(resource_vfs, u8"pso_manifest.bin");
     cgpu_wait_queue_idle(gfx_queue);
     cgpu_wait_fences(&present_fence, 1);
     cgpu_free_fence(present_fence);
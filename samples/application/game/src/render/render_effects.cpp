@@ -23,14 +23,18 @@
 #include "SkrRenderer/resources/texture_resource.h"
 #include "SkrRenderer/render_mesh.h"
 #include "SkrRenderer/render_group.h"
+#include "SkrRenderer/render_viewport.h"
+#include "SkrRenderer/culling.hpp"
 #include "SkrAnim/components/skin_component.h"
 #include "SkrAnim/components/skeleton_component.h"
+#include "SkrAnim/components/blend_component.h"
 
 #include "cube.hpp"
 #include "platform/vfs.h"
 #include <platform/filesystem.hpp>
 
 #include "utils/parallel_for.hpp"
+#include <float.h>
 
 #include "resource/resource_system.h"
 
@@ -125,6 +129,96 @@ void RenderEffectForward::initialize_data(SRendererId renderer, dual_storage_t*
     }
 }
 
+void RenderEffectForward::on_update(const skr_primitive_update_context_t* context)
+{
+    // materials are shared with the other effects, so they are resolved here on the render thread,
+    // draw packets may be produced on the task system afterwards
+    auto resolveF = [&](dual_chunk_view_t* r_cv) {
+        ZoneScopedN("ResolveMaterials");
+        const auto meshes = dual::get_component_ro<skr_render_mesh_comp_t>(r_cv);
+        for (uint32_t i = 0; i < r_cv->count; i++)
+        {
+            if (meshes[i].mesh_resource.get_status() != SKR_LOADING_STATUS_INSTALLED) continue;
+            auto resourcePtr = (skr_mesh_resource_t*)meshes[i].mesh_resource.get_ptr();
+            for (auto& material : resourcePtr->materials)
+            {
+                material.resolve(true, nullptr);
+            }
+        }
+    };
+    dualQ_get_views(mesh_query, DUAL_LAMBDA(resolveF));
+    request_texture_mips(context);
+}
+
+void RenderEffectForward::request_texture_mips(const skr_primitive_update_context_t* context)
+{
+    if (!texture_factory) return;
+    const auto viewport = context->renderer->get_viewport_manager()->find_viewport(context->viewport_id);
+    if (!viewport) return;
+
+    texture_mips.clear();
+    auto r_effect_callback = [&](dual_chunk_view_t* r_cv) {
+        ZoneScopedN("RequestTextureMips");
+        uint32_t r_idx = 0;
+        auto identities = (forward_effect_identity_t*)dualV_get_owned_ro(r_cv, identity_type);
+        auto unbatched_g_ents = (dual_entity_t*)identities;
+        const auto meshes = dual::get_component_ro<skr_render_mesh_comp_t>(r_cv);
+        if (!unbatched_g_ents) return;
+
+        auto gBatchCallback = [&](dual_chunk_view_t* g_cv) {
+            const auto l2ws = dual::get_component_ro<skr_transform_comp_t>(g_cv);
+            const auto translations = dual::get_component_ro<skr_translation_comp_t>(g_cv);
+            const auto scales = dual::get_component_ro<skr_scale_comp_t>(g_cv);
+            const auto world_bounds = dual::get_component_ro<skr_world_bounds_comp_t>(g_cv);
+            for (uint32_t g_idx = 0; g_idx < g_cv->count; g_idx++, r_idx++)
+            {
+                if (meshes[r_idx].mesh_resource.get_status() != SKR_LOADING_STATUS_INSTALLED) continue;
+                // objects without bounds are taken as unit sized
+                skr_float3_t center = l2ws ? l2ws[g_idx].value.translation : translations[g_idx].value;
+                skr_float3_t size = l2ws ? l2ws[g_idx].value.scale : scales[g_idx].value;
+                if (world_bounds)
+                {
+                    center = world_bounds[g_idx].center;
+                    size = { 2.f * world_bounds[g_idx].extent.x, 2.f * world_bounds[g_idx].extent.y, 2.f * world_bounds[g_idx].extent.z };
+                }
+                const float dx = center.x - viewport->eye.x, dy = center.y - viewport->eye.y, dz = center.z - viewport->eye.z;
+                const float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+                const float pixel_size = skr_render_viewport_lod_error(viewport, distance, 1.f);
+                const float extent = sqrtf(size.x * size.x + size.y * size.y + size.z * size.z);
+                // nothing to measure against, stream everything in
+                const float screen_extent = pixel_size > 0.f ? extent / pixel_size : FLT_MAX;
+
+                auto resourcePtr = (skr_mesh_resource_t*)meshes[r_idx].mesh_resource.get_ptr();
+                for (const auto& material : resourcePtr->materials)
+                {
+                    const auto materialPtr = material.get_resolved();
+                    if (!materialPtr) continue;
+                    for (const auto& pass : materialPtr->installed_passes)
+                    {
+                        for (auto texture : pass.textures)
+                        {
+                            const auto mip = skr::resource::STextureFactory::MipForExtent(texture, screen_extent);
+                            auto found = texture_mips.find(texture);
+                            if (found == texture_mips.end())
+                                texture_mips.emplace(texture, mip);
+                            else
+                                found->second = eastl::min(found->second, mip);
+                        }
+                    }
+                }
+            }
+        };
+        dualS_batch(context->storage, unbatched_g_ents, r_cv->count, DUAL_LAMBDA(gBatchCallback));
+    };
+    dualQ_get_views(mesh_query, DUAL_LAMBDA(r_effect_callback));
+
+    // the factory keeps one request per texture in flight, the ones it turns down are asked again next frame
+    for (const auto& [texture, mip] : texture_mips)
+    {
+        texture_factory->RequestMips(texture, mip);
+    }
+}
+
 skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_primitive_draw_context_t* context)
 {
     auto pass = context->pass;
@@ -168,6 +262,16 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
     push_constants.reserve(primitiveCount);
     mesh_drawcalls.reserve(primitiveCount);
 
+    // levels of detail are picked against the viewport the frame is rendered for
+    const auto viewport = context->renderer->get_viewport_manager()->find_viewport(context->viewport_id);
+    // simplification error tolerated on screen, in pixels
+    const float kLODPixelError = 1.f;
+    // far plane the viewports are resolved with, draws are keyed front to back within it
+    const float kSortFarDistance = 1000.f;
+    // entities with world bounds are culled against it too
+    skr::renderer::Frustum frustum = {};
+    if (viewport) frustum = skr::renderer::Frustum::from_view_projection(viewport->view_projection);
+
     // 3. fill draw packets
     auto r_effect_callback = [&](dual_chunk_view_t* r_cv) {
         uint32_t r_idx = 0;
@@ -195,6 +299,14 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
             const auto translations = dual::get_component_ro<skr_translation_comp_t>(g_cv);
             const auto rotations = dual::get_component_ro<skr_rotation_comp_t>(g_cv);(void)rotations;
             const auto scales = dual::get_component_ro<skr_scale_comp_t>(g_cv);
+            const auto world_bounds = dual::get_component_ro<skr_world_bounds_comp_t>(g_cv);
+            const bool cull = viewport && world_bounds;
+            if (cull)
+            {
+                ZoneScopedN("FrustumCulling");
+                visibility.resize(skr::renderer::visibility_words(g_cv->count));
+                skr::renderer::cull_world_bounds(frustum, world_bounds, g_cv->count, visibility.data());
+            }
             // 3.1 calculate model matrices
             {
                 ZoneScopedN("ComputeModelMatrices");
@@ -238,7 +350,25 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
             ZoneScopedN("RecordDrawList");
             for (uint32_t g_idx = 0; g_idx < g_cv->count; g_idx++, r_idx++)
             {
+                if (cull && !skr::renderer::is_visible(visibility.data(), g_idx)) continue;
                 const auto& model_matrix = model_matrices[g_idx];
+                // lod errors are cooked in object space
+                float lod_error = 0.f;
+                float sort_depth = 0.f;
+                if (viewport)
+                {
+                    const auto& m = model_matrix.M;
+                    const float dx = m[3][0] - viewport->eye.x, dy = m[3][1] - viewport->eye.y, dz = m[3][2] - viewport->eye.z;
+                    const float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+                    sort_depth = distance / kSortFarDistance;
+                    float scale = 0.f;
+                    for (uint32_t axis = 0; axis < 3; axis++)
+                    {
+                        const float axis_scale = sqrtf(m[axis][0] * m[axis][0] + m[axis][1] * m[axis][1] + m[axis][2] * m[axis][2]);
+                        scale = axis_scale > scale ? axis_scale : scale;
+                    }
+                    lod_error = scale > 0.f ? skr_render_viewport_lod_error(viewport, distance, kLODPixelError) / scale : 0.f;
+                }
                 // drawcall
                 auto status = meshes[r_idx].mesh_resource.get_status();
                 if (status == SKR_LOADING_STATUS_INSTALLED)
@@ -246,11 +376,7 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
                     auto resourcePtr = (skr_mesh_resource_t*)meshes[r_idx].mesh_resource.get_ptr();
                     auto renderMesh = resourcePtr->render_mesh;
 
-                    // early resolve all materials
-                    for (auto& material : resourcePtr->materials)
-                    {
-                        material.resolve(true, nullptr);
-                    }
+                    // materials are resolved in on_update
                     bool materials_ready = true;
                     for (const auto& material : resourcePtr->materials)
                     {
@@ -288,9 +414,10 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
                             drawcall.bind_table = proper_bind_table;
                             drawcall.push_const_name = push_constants_name;
                             drawcall.push_const = (const uint8_t*)(&push_const);
-                            drawcall.index_buffer = *cmd.ibv;
+                            drawcall.index_buffer = *cmd.select_lod(lod_error);
                             drawcall.vertex_buffers = anims[r_idx].primitives[i].views.data();
                             drawcall.vertex_buffer_count = (uint32_t)anims[r_idx].primitives[i].views.size();
+                            drawcall.sort_key = skr::renderer::make_draw_sort_key(proper_pipeline, proper_bind_table, cmd.material_index, sort_depth);
                             dc_idx++;
                         }
                     }
@@ -316,9 +443,10 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
                             drawcall.bind_table = proper_bind_table;
                             drawcall.push_const_name = push_constants_name;
                             drawcall.push_const = (const uint8_t*)(&push_const);
-                            drawcall.index_buffer = *cmd.ibv;
+                            drawcall.index_buffer = *cmd.select_lod(lod_error);
                             drawcall.vertex_buffers = cmd.vbvs.data();
                             drawcall.vertex_buffer_count = (uint32_t)cmd.vbvs.size();
+                            drawcall.sort_key = skr::renderer::make_draw_sort_key(proper_pipeline, proper_bind_table, cmd.material_index, sort_depth);
                             dc_idx++;
                         }
                     }
@@ -334,6 +462,7 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
                     drawcall.index_buffer = ibv;
                     drawcall.vertex_buffers = vbvs;
                     drawcall.vertex_buffer_count = 5;
+                    drawcall.sort_key = skr::renderer::make_draw_sort_key(pipeline, nullptr, 0, sort_depth);
                     dc_idx++;
                 }
             }
@@ -579,7 +708,10 @@ void RenderEffectForwardSkin::on_register(SRendererId renderer, dual_storage_t*
             .with<skr_render_group_t>()
             .with<skr_render_anim_comp_t>()
             .with<skr_render_skel_comp_t>()
-            .with<skr_render_skin_comp_t>();
+            .with<skr_render_skin_comp_t>()
+            .with<skr_anim_blend_comp_t>()
+            .with<skr_anim_lod_comp_t>()
+            .with<skr_transform_comp_t>();
         typeset = type_builder.build();
     }
     initialize_queries(storage);
@@ -613,10 +745,10 @@ RenderEffectForwardSkin* forward_effect_skin = nullptr;
 RenderPassForward* forward_pass = nullptr;
 RenderEffectForward* forward_effect = nullptr;
 
-void game_initialize_render_effects(SRendererId renderer, skr::render_graph::RenderGraph* renderGraph, skr_vfs_t* resource_vfs)
+void game_initialize_render_effects(SRendererId renderer, skr::render_graph::RenderGraph* renderGraph, skr_vfs_t* resource_vfs, skr::resource::STextureFactory* texture_factory)
 {
-    forward_effect = new RenderEffectForward(resource_vfs);
-    forward_effect_skin = new RenderEffectForwardSkin(resource_vfs);
+    forward_effect = new RenderEffectForward(resource_vfs, texture_factory);
+    forward_effect_skin = new RenderEffectForwardSkin(resource_vfs, texture_factory);
     forward_pass = new RenderPassForward();
     skr_renderer_register_render_effect(renderer, forward_effect_name, forward_effect);
     skr_renderer_register_render_effect(renderer, forward_effect_skin_name, forward_effect_skin);
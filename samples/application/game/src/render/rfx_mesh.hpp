@@ -4,6 +4,7 @@
 #include "SkrRenderer/skr_renderer.h"
 #include "SkrRenderer/render_effect.h"
 #include "ecs/type_builder.hpp"
+#include "containers/hashmap.hpp"
 
 typedef struct forward_effect_identity_t {
     dual_entity_t game_entity;
@@ -11,10 +12,15 @@ typedef struct forward_effect_identity_t {
 
 static const skr_render_effect_name_t forward_effect_name = "ForwardEffect";
 
+namespace skr::resource
+{
+struct STextureFactory;
+}
+
 struct RenderEffectForward : public IRenderEffectProcessor 
 {
-    RenderEffectForward(skr_vfs_t* resource_vfs)
-        :resource_vfs(resource_vfs) {}
+    RenderEffectForward(skr_vfs_t* resource_vfs, skr::resource::STextureFactory* texture_factory)
+        :resource_vfs(resource_vfs), texture_factory(texture_factory) {}
     ~RenderEffectForward() = default;
 
     void on_register(SRendererId renderer, dual_storage_t* storage) override;
@@ -22,11 +28,14 @@ struct RenderEffectForward : public IRenderEffectProcessor
     void get_type_set(const dual_chunk_view_t* cv, dual_type_set_t* set) override;
     dual_type_index_t get_identity_type() override;
     void initialize_data(SRendererId renderer, dual_storage_t* storage, dual_chunk_view_t* game_cv, dual_chunk_view_t* render_cv) override;
+    void on_update(const skr_primitive_update_context_t* context) override;
     skr_primitive_draw_packet_t produce_draw_packets(const skr_primitive_draw_context_t* context) override;
 
 protected:
     void initialize_queries(dual_storage_t* storage);
     void release_queries();
+    // requests the levels the material textures need at the size the meshes cover on the viewport
+    void request_texture_mips(const skr_primitive_update_context_t* context);
 
     // TODO: move these anywhere else
     void prepare_geometry_resources(SRendererId renderer);
@@ -38,6 +47,7 @@ protected:
     dual::type_builder_t type_builder;
     dual_type_set_t typeset;
     skr_vfs_t* resource_vfs;
+    skr::resource::STextureFactory* texture_factory;
 
     eastl::vector<skr_primitive_draw_t> mesh_drawcalls;
     skr_primitive_draw_list_view_t mesh_draw_list;
@@ -59,6 +69,11 @@ protected:
     struct PushConstants {
         skr_float4x4_t model;
     };
+    // scratch of produce_draw_packets, owned by this effect alone so it may produce next to the other effects
     eastl::vector<PushConstants> push_constants;
     eastl::vector<skr_float4x4_t> model_matrices;
+    // frustum visibility of the entities of the chunk being recorded
+    eastl::vector<uint32_t> visibility;
+    // most detailed level asked for each texture this frame
+    skr::flat_hash_map<struct skr_texture_resource_t*, uint32_t> texture_mips;
 };
\ No newline at end of file
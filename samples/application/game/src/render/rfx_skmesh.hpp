@@ -4,8 +4,8 @@
 static const skr_render_effect_name_t forward_effect_skin_name = "ForwardEffectSkin";
 struct RenderEffectForwardSkin : public RenderEffectForward
 {
-    RenderEffectForwardSkin(skr_vfs_t* resource_vfs)
-        : RenderEffectForward(resource_vfs) {}
+    RenderEffectForwardSkin(skr_vfs_t* resource_vfs, skr::resource::STextureFactory* texture_factory)
+        : RenderEffectForward(resource_vfs, texture_factory) {}
 
     void on_register(SRendererId renderer, dual_storage_t* storage) override;
     void on_unregister(SRendererId renderer, dual_storage_t* storage) override;
@@ -280,7 +280,6 @@ void RenderPassForward::execute(const skr_primitive_pass_context_t* context, skr
             
             {
             ZoneScopedN("DrawCalls");
-            CGPURenderPipelineId old_pipeline = nullptr;
             eastl::vector_map<CGPURootSignatureId, CGPUXBindTableId> bind_tables;
             for (uint32_t i = 0; i < drawcalls.size(); i++)
             for (uint32_t j = 0; j < drawcalls[i].count; j++)
@@ -289,11 +288,7 @@ void RenderPassForward::execute(const skr_primitive_pass_context_t* context, skr
                 auto&& dc = drawcalls[i].lists[j].drawcalls[k];
                 if (dc.desperated || (dc.index_buffer.buffer == nullptr) || (dc.vertex_buffer_count == 0)) continue;
                 
-                if (old_pipeline != dc.pipeline)
-                {
-                    cgpu_render_encoder_bind_pipeline(pass_context.encoder, dc.pipeline);
-                    old_pipeline = dc.pipeline;
-                }
+                pass_context.bind_pipeline(dc.pipeline);
 
                 CGPURootSignatureId dcRS = dc.pipeline->root_signature;
                 if (bind_tables.find(dcRS) == bind_tables.end())
@@ -308,12 +303,11 @@ void RenderPassForward::execute(const skr_primitive_pass_context_t* context, skr
                 }
                 else
                 {
-                    cgpux_render_encoder_bind_bind_table(pass_context.encoder, pass_table);
+                    pass_context.bind_bind_table(pass_table);
                 }
 
                 {
-                    cgpu_render_encoder_bind_index_buffer(pass_context.encoder, 
-                        dc.index_buffer.buffer, dc.index_buffer.stride, dc.index_buffer.offset);
+                    pass_context.bind_index_buffer(dc.index_buffer.buffer, dc.index_buffer.stride, dc.index_buffer.offset);
                     CGPUBufferId vertex_buffers[16] = { 0 };
                     uint32_t strides[16] = { 0 };
                     uint32_t offsets[16] = { 0 };
@@ -327,11 +321,19 @@ void RenderPassForward::execute(const skr_primitive_pass_context_t* context, skr
                     {
                         if (strides[i] == 0) offsets[i] = 0;
                     }
-                    cgpu_render_encoder_bind_vertex_buffers(pass_context.encoder, dc.vertex_buffer_count, vertex_buffers, strides, offsets);
+                    uint32_t vertex_buffer_count = dc.vertex_buffer_count;
+                    if (dc.instance_buffer.buffer)
+                    {
+                        vertex_buffers[vertex_buffer_count] = dc.instance_buffer.buffer;
+                        strides[vertex_buffer_count] = dc.instance_buffer.stride;
+                        offsets[vertex_buffer_count] = dc.instance_buffer.offset;
+                        vertex_buffer_count++;
+                    }
+                    pass_context.bind_vertex_buffers(vertex_buffer_count, vertex_buffers, strides, offsets);
                 }
                 cgpu_render_encoder_push_constants(pass_context.encoder, dc.pipeline->root_signature, dc.push_const_name, dc.push_const);
                 cgpu_render_encoder_set_shading_rate(pass_context.encoder, shading_rate, CGPU_SHADING_RATE_COMBINER_PASSTHROUGH, CGPU_SHADING_RATE_COMBINER_PASSTHROUGH);
-                cgpu_render_encoder_draw_indexed_instanced(pass_context.encoder, dc.index_buffer.index_count, dc.index_buffer.first_index, 1, 0, 0);
+                cgpu_render_encoder_draw_indexed_instanced(pass_context.encoder, dc.index_buffer.index_count, dc.index_buffer.first_index, dc.instance_count ? dc.instance_count : 1, 0, 0);
             }
             }
     });
@@ -0,0 +1,316 @@
+#include "SkrAnim/components/blend_component.h"
+#include "SkrAnim/components/skin_component.h"
+#include "SkrAnim/components/skeleton_component.h"
+#include "SkrAnim/ozz/sampling_job.h"
+#include "SkrAnim/ozz/blending_job.h"
+#include "SkrAnim/ozz/local_to_model_job.h"
+#include "SkrAnimTool/ozz/raw_skeleton.h"
+#include "SkrAnimTool/ozz/skeleton_builder.h"
+#include "SkrAnimTool/ozz/raw_animation.h"
+#include "SkrAnimTool/ozz/animation_builder.h"
+#include "SkrScene/scene.h"
+#include "resource/resource_header.hpp"
+#include "ecs/dual.h"
+#include "ecs/type_builder.hpp"
+#include "utils/make_zeroed.hpp"
+#include "task/task.hpp"
+#include "gtest/gtest.h"
+#include <cmath>
+
+// a chain of joints driven by two clips spinning every joint around a different axis, held in records owned by the fixture
+class AnimSystem : public ::testing::Test
+{
+protected:
+    static constexpr uint32_t kJointCount = 6;
+    static constexpr uint32_t kClipCount = 2;
+
+    skr::task::scheduler_t scheduler;
+    dual_storage_t* world = nullptr;
+    skr_anim_system_t* system = nullptr;
+    skr_skeleton_resource_t skeleton;
+    skr_anim_resource_t clips[kClipCount];
+    skr_resource_record_t skeleton_record;
+    skr_resource_record_t clip_records[kClipCount];
+    uint32_t spawned = 0;
+
+    void SetUp() override
+    {
+        scheduler.initialize(skr::task::scheudler_config_t{});
+        scheduler.bind();
+        world = dualS_create();
+        dualJ_bind_storage(world);
+        BuildSkeleton();
+        BuildClip(0, ozz::math::Float3::z_axis());
+        BuildClip(1, ozz::math::Float3::x_axis());
+        system = skr_anim_system_create(world);
+    }
+
+    void TearDown() override
+    {
+        skr_anim_system_free(system);
+        // the records are not known to the resource system, handles must not unload them
+        auto release = [&](dual_chunk_view_t* view) {
+            auto blends = dual::get_owned_rw<skr_anim_blend_comp_t>(view);
+            auto skels = dual::get_owned_rw<skr_render_skel_comp_t>(view);
+            for (uint32_t i = 0; i < view->count; ++i)
+            {
+                for (auto& layer : blends[i].layers)
+                    layer.animation.set_record(nullptr);
+                skels[i].skeleton.set_record(nullptr);
+            }
+        };
+        auto query = dualQ_from_literal(world, "[inout]skr_anim_blend_comp_t,[inout]skr_render_skel_comp_t");
+        dualQ_get_views(query, DUAL_LAMBDA(release));
+        dualQ_release(query);
+        dualJ_unbind_storage(world);
+        dualS_release(world);
+        scheduler.unbind();
+    }
+
+    void BuildSkeleton()
+    {
+        ozz::animation::offline::RawSkeleton raw;
+        auto* joints = &raw.roots;
+        for (uint32_t i = 0; i < kJointCount; ++i)
+        {
+            auto& joint = joints->emplace_back();
+            joint.name = ozz::string("joint") + std::to_string(i).c_str();
+            joint.transform = ozz::math::Transform::identity();
+            joint.transform.translation = ozz::math::Float3(0.f, i ? 1.f : 0.f, 0.f);
+            joints = &joint.children;
+        }
+        auto built = ozz::animation::offline::SkeletonBuilder()(raw);
+        ASSERT_TRUE(built);
+        skeleton.skeleton = std::move(*built);
+        skeleton_record.resource = &skeleton;
+        skeleton_record.loadingStatus = SKR_LOADING_STATUS_INSTALLED;
+    }
+
+    // two turns per second, fast enough that poses a few frames apart are far from each other
+    void BuildClip(uint32_t index, const ozz::math::Float3& axis)
+    {
+        ozz::animation::offline::RawAnimation raw;
+        raw.duration = 1.f;
+        raw.tracks.resize(kJointCount);
+        for (uint32_t j = 0; j < kJointCount; ++j)
+        {
+            auto& track = raw.tracks[j];
+            track.translations.push_back({ 0.f, ozz::math::Float3(0.f, j ? 1.f : 0.f, 0.f) });
+            for (uint32_t k = 0; k <= 8; ++k)
+            {
+                const float time = k / 8.f;
+                track.rotations.push_back({ time, ozz::math::Quaternion::FromAxisAngle(axis, time * 4.f * ozz::math::kPi) });
+            }
+        }
+        auto built = ozz::animation::offline::AnimationBuilder()(raw);
+        ASSERT_TRUE(built);
+        clips[index].animation = std::move(*built);
+        clip_records[index].resource = &clips[index];
+        clip_records[index].loadingStatus = SKR_LOADING_STATUS_INSTALLED;
+    }
+
+    // character i plays one clip from its own start time, every third one blends in the other clip
+    static uint32_t ClipOf(uint32_t index) { return index % kClipCount; }
+    static float StartOf(uint32_t index) { return .1f * (index % 5); }
+    static bool Blends(uint32_t index) { return index % 3 == 0; }
+
+    void SetupBlend(uint32_t index, skr_anim_blend_comp_t& blend)
+    {
+        auto& layer = blend.layers.emplace_back();
+        layer.animation.set_resolved(&clip_records[ClipOf(index)], 0, SKR_REQUESTER_SYSTEM);
+        layer.time = StartOf(index);
+        if (Blends(index))
+        {
+            auto& other = blend.layers.emplace_back();
+            other.animation.set_resolved(&clip_records[(ClipOf(index) + 1) % kClipCount], 0, SKR_REQUESTER_SYSTEM);
+            other.weight = .5f;
+            other.time = StartOf(index);
+        }
+    }
+
+    // characters with a lod are placed distance away from the origin
+    void SpawnCharacters(uint32_t count, float distance = -1.f)
+    {
+        auto builder = make_zeroed<dual::type_builder_t>();
+        builder.with<skr_anim_blend_comp_t, skr_render_anim_comp_t, skr_render_skel_comp_t, skr_index_comp_t>();
+        if (distance >= 0.f)
+            builder.with<skr_anim_lod_comp_t, skr_transform_comp_t>();
+        auto type = make_zeroed<dual_entity_type_t>();
+        type.type = builder.build();
+        auto setup = [&](dual_chunk_view_t* view) {
+            auto blends = dual::get_owned_rw<skr_anim_blend_comp_t>(view);
+            auto skels = dual::get_owned_rw<skr_render_skel_comp_t>(view);
+            auto indices = dual::get_owned_rw<skr_index_comp_t>(view);
+            auto lods = dual::get_owned_rw<skr_anim_lod_comp_t>(view);
+            auto transforms = dual::get_owned_rw<skr_transform_comp_t>(view);
+            for (uint32_t i = 0; i < view->count; ++i)
+            {
+                const auto index = spawned++;
+                indices[i].value = index;
+                skels[i].skeleton.set_resolved(&skeleton_record, 0, SKR_REQUESTER_SYSTEM);
+                SetupBlend(index, blends[i]);
+                if (lods)
+                {
+                    lods[i] = skr_anim_lod_comp_t();
+                    transforms[i].value = skr_transform_t();
+                    transforms[i].value.translation = { distance, 0.f, 0.f };
+                }
+            }
+        };
+        dualS_allocate_type(world, &type, count, DUAL_LAMBDA(setup));
+    }
+
+    template <class F>
+    void ForEachCharacter(F&& f)
+    {
+        skr_anim_system_wait(system);
+        auto visit = [&](dual_chunk_view_t* view) {
+            auto indices = dual::get_owned_ro<skr_index_comp_t>(view);
+            auto blends = dual::get_owned_ro<skr_anim_blend_comp_t>(view);
+            auto anims = dual::get_owned_ro<skr_render_anim_comp_t>(view);
+            for (uint32_t i = 0; i < view->count; ++i)
+                f(indices[i].value, blends[i], anims[i]);
+        };
+        auto query = dualQ_from_literal(world, "[in]skr_index_comp_t,[in]skr_anim_blend_comp_t,[in]skr_render_anim_comp_t");
+        dualQ_get_views(query, DUAL_LAMBDA(visit));
+        dualQ_release(query);
+    }
+
+    // samples, blends and converts the blend tree with plain ozz jobs
+    skr::vector<ozz::math::Float4x4> ReferencePose(const skr_anim_blend_comp_t& blend)
+    {
+        const auto& ozz_skeleton = skeleton.skeleton;
+        skr::vector<skr::vector<ozz::math::SoaTransform>> sampled(blend.layers.size());
+        skr::vector<ozz::animation::BlendingJob::Layer> layers;
+        ozz::animation::SamplingJob::Context context(ozz_skeleton.num_joints());
+        for (size_t l = 0; l < blend.layers.size(); ++l)
+        {
+            const auto& layer = blend.layers[l];
+            const auto& animation = layer.animation.get_resolved()->animation;
+            sampled[l].resize(animation.num_soa_tracks());
+            ozz::animation::SamplingJob sampling;
+            sampling.animation = &animation;
+            sampling.context = &context;
+            sampling.ratio = layer.time / animation.duration();
+            sampling.output = { sampled[l].data(), sampled[l].size() };
+            EXPECT_TRUE(sampling.Run());
+            auto& blend_layer = layers.emplace_back();
+            blend_layer.weight = layer.weight;
+            blend_layer.transform = { sampled[l].data(), sampled[l].size() };
+        }
+        skr::vector<ozz::math::SoaTransform> locals(ozz_skeleton.num_soa_joints());
+        ozz::animation::BlendingJob blending;
+        blending.threshold = blend.threshold;
+        blending.layers = { layers.data(), layers.size() };
+        blending.rest_pose = ozz_skeleton.joint_rest_poses();
+        blending.output = { locals.data(), locals.size() };
+        EXPECT_TRUE(blending.Run());
+        skr::vector<ozz::math::Float4x4> matrices(ozz_skeleton.num_joints());
+        ozz::animation::LocalToModelJob ltm;
+        ltm.skeleton = &ozz_skeleton;
+        ltm.input = { locals.data(), locals.size() };
+        ltm.output = { matrices.data(), matrices.size() };
+        EXPECT_TRUE(ltm.Run());
+        return matrices;
+    }
+
+    static void ExpectNearPose(const eastl::vector<ozz::math::Float4x4>& pose, const skr::vector<ozz::math::Float4x4>& expected, uint32_t index)
+    {
+        ASSERT_EQ(pose.size(), expected.size()) << "character " << index;
+        for (size_t j = 0; j < pose.size(); ++j)
+        {
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                float actual_col[4], expected_col[4];
+                ozz::math::StorePtrU(pose[j].cols[c], actual_col);
+                ozz::math::StorePtrU(expected[j].cols[c], expected_col);
+                for (uint32_t r = 0; r < 4; ++r)
+                    EXPECT_NEAR(actual_col[r], expected_col[r], 1e-4f) << "character " << index << " joint " << j;
+            }
+        }
+    }
+};
+
+TEST_F(AnimSystem, PosesOfManyCharacters)
+{
+    // several jobs, and characters sharing (clip, time) keys
+    SpawnCharacters(300);
+    skr_anim_system_update(system, .25f);
+    uint32_t visited = 0;
+    ForEachCharacter([&](uint32_t index, const skr_anim_blend_comp_t& blend, const skr_render_anim_comp_t& anim) {
+        ASSERT_EQ(blend.layers.size(), Blends(index) ? 2u : 1u);
+        for (const auto& layer : blend.layers)
+            EXPECT_FLOAT_EQ(layer.time, StartOf(index) + .25f) << "character " << index;
+        ExpectNearPose(anim.joint_matrices, ReferencePose(blend), index);
+        visited++;
+    });
+    EXPECT_EQ(visited, 300u);
+}
+
+TEST_F(AnimSystem, PlaybackAdvancesOncePerUpdate)
+{
+    SpawnCharacters(10);
+    skr_anim_blend_comp_t blend;
+    skr_render_anim_comp_t anim;
+    SetupBlend(1, blend);
+
+    skr_anim_system_update(system, .1f);
+    skr_anim_system_wait(system);
+    // evaluating outside of the query samples without moving the clips, however often it is done
+    skr_anim_evaluate(system, &blend, &skeleton, &anim);
+    skr_anim_evaluate(system, &blend, &skeleton, &anim);
+    EXPECT_FLOAT_EQ(blend.layers[0].time, StartOf(1));
+    ExpectNearPose(anim.joint_matrices, ReferencePose(blend), 1);
+    skr_anim_system_update(system, .1f);
+
+    ForEachCharacter([&](uint32_t index, const skr_anim_blend_comp_t& blend, const skr_render_anim_comp_t& anim) {
+        for (const auto& layer : blend.layers)
+            EXPECT_FLOAT_EQ(layer.time, StartOf(index) + .2f) << "character " << index;
+        ExpectNearPose(anim.joint_matrices, ReferencePose(blend), index);
+    });
+    blend.layers[0].animation.set_record(nullptr);
+}
+
+TEST_F(AnimSystem, InterpolatedLODPosesStayRigid)
+{
+    // far characters update every fourth frame, the clips turn 48 degrees in between
+    const skr_anim_lod_level_t levels[] = {
+        { 10.f, 1, 0, false },
+        { 1000.f, 4, 0, true },
+    };
+    skr_anim_system_set_lods(system, levels, 2);
+    skr_anim_system_set_viewer(system, { 0.f, 0.f, 0.f });
+    SpawnCharacters(20, 100.f);
+    skr::vector<eastl::vector<ozz::math::Float4x4>> previous(20);
+    for (uint32_t frame = 0; frame < 16; ++frame)
+    {
+        skr_anim_system_update(system, 1.f / 30.f);
+        ForEachCharacter([&](uint32_t index, const skr_anim_blend_comp_t& blend, const skr_render_anim_comp_t& anim) {
+            ASSERT_EQ(anim.joint_matrices.size(), kJointCount);
+            for (uint32_t j = 0; j < kJointCount; ++j)
+            {
+                float axes[3][4];
+                for (uint32_t c = 0; c < 3; ++c)
+                    ozz::math::StorePtrU(anim.joint_matrices[j].cols[c], axes[c]);
+                for (uint32_t a = 0; a < 3; ++a)
+                {
+                    for (uint32_t b = a; b < 3; ++b)
+                    {
+                        const float dot = axes[a][0] * axes[b][0] + axes[a][1] * axes[b][1] + axes[a][2] * axes[b][2];
+                        EXPECT_NEAR(dot, a == b ? 1.f : 0.f, 1e-3f) << "character " << index << " joint " << j << " frame " << frame;
+                    }
+                }
+            }
+            // interpolated poses move on every frame instead of holding until the next update
+            if (frame > 4)
+            {
+                float current[4], last[4];
+                ozz::math::StorePtrU(anim.joint_matrices[kJointCount - 1].cols[3], current);
+                ozz::math::StorePtrU(previous[index][kJointCount - 1].cols[3], last);
+                EXPECT_GT(std::abs(current[0] - last[0]) + std::abs(current[1] - last[1]) + std::abs(current[2] - last[2]), 1e-3f)
+                    << "character " << index << " frame " << frame;
+            }
+            previous[index] = anim.joint_matrices;
+        });
+    }
+}
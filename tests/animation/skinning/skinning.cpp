@@ -0,0 +1,354 @@
+#include "SkrAnim/components/skin_component.h"
+#include "SkrAnim/ozz/geometry/skinning_job.h"
+#include "SkrRenderer/render_mesh.h"
+#include "platform/cpu/isa.h"
+#include "resource/resource_header.hpp"
+#include "task/task.hpp"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <random>
+
+// interleaved mesh vertex, matches the layout produced by the mesh cooker
+struct SkinTestVertex {
+    float position[3];
+    float normal[3];
+    float tangent[4];
+    uint16_t joints[4];
+    float weights[4];
+};
+
+struct SkinTestCharacter {
+    skr::vector<ozz::math::Float4x4> skin_matrices;
+    skr::vector<SkinTestVertex> vertices;
+    skr::vector<float> positions;
+    skr::vector<float> normals;
+    skr::vector<float> tangents;
+    skr_skin_vertices_t streams;
+};
+
+class Skinning : public ::testing::Test
+{
+protected:
+    skr::task::scheduler_t scheduler;
+    std::mt19937 random = std::mt19937(0x5eed);
+
+    void SetUp() override
+    {
+        scheduler.initialize(skr::task::scheudler_config_t{});
+        scheduler.bind();
+    }
+
+    void TearDown() override
+    {
+        scheduler.unbind();
+    }
+
+    float RandomFloat(float min, float max)
+    {
+        return std::uniform_real_distribution<float>(min, max)(random);
+    }
+
+    void InitCharacter(SkinTestCharacter& character, uint32_t joint_count, uint32_t vertex_count)
+    {
+        character.skin_matrices.resize(joint_count);
+        for (auto& matrix : character.skin_matrices)
+        {
+            for (auto& col : matrix.cols)
+                col = ozz::math::simd_float4::Load(RandomFloat(-1.f, 1.f), RandomFloat(-1.f, 1.f), RandomFloat(-1.f, 1.f), RandomFloat(-1.f, 1.f));
+        }
+        character.vertices.resize(vertex_count);
+        for (auto& vertex : character.vertices)
+        {
+            for (auto& v : vertex.position) v = RandomFloat(-10.f, 10.f);
+            for (auto& v : vertex.normal) v = RandomFloat(-1.f, 1.f);
+            for (auto& v : vertex.tangent) v = RandomFloat(-1.f, 1.f);
+            for (auto& v : vertex.joints) v = (uint16_t)(random() % joint_count);
+            for (auto& v : vertex.weights) v = RandomFloat(0.f, 0.33f);
+        }
+        character.positions.resize(vertex_count * 3);
+        character.normals.resize(vertex_count * 3);
+        character.tangents.resize(vertex_count * 4);
+        auto& streams = character.streams;
+        streams = {};
+        streams.joints = character.vertices[0].joints;
+        streams.weights = character.vertices[0].weights;
+        streams.positions = character.vertices[0].position;
+        streams.normals = character.vertices[0].normal;
+        streams.tangents = character.vertices[0].tangent;
+        streams.joints_stride = streams.weights_stride = sizeof(SkinTestVertex);
+        streams.positions_stride = streams.normals_stride = streams.tangents_stride = sizeof(SkinTestVertex);
+        streams.out_positions = character.positions.data();
+        streams.out_positions_stride = sizeof(float) * 3;
+        streams.out_normals = character.normals.data();
+        streams.out_normals_stride = sizeof(float) * 3;
+        streams.out_tangents = character.tangents.data();
+        streams.out_tangents_stride = sizeof(float) * 4;
+    }
+
+    void RunOzzSkinning(const skr::vector<ozz::math::Float4x4>& skin_matrices, const skr::vector<SkinTestVertex>& vertices,
+        skr::vector<float>& positions, skr::vector<float>& normals, skr::vector<float>& tangents)
+    {
+        const auto vertex_count = vertices.size();
+        const auto in_size = vertex_count * sizeof(SkinTestVertex) / sizeof(float);
+        positions.resize(vertex_count * 3);
+        normals.resize(vertex_count * 3);
+        tangents.resize(vertex_count * 4);
+        ozz::geometry::SkinningJob job;
+        job.joint_matrices = { skin_matrices.data(), skin_matrices.size() };
+        job.influences_count = 4;
+        job.vertex_count = (int)vertex_count;
+        job.joint_weights = { vertices[0].weights, in_size };
+        job.joint_weights_stride = sizeof(SkinTestVertex);
+        job.joint_indices = { vertices[0].joints, in_size * 2 };
+        job.joint_indices_stride = sizeof(SkinTestVertex);
+        job.in_positions = { vertices[0].position, in_size };
+        job.in_positions_stride = sizeof(SkinTestVertex);
+        job.in_normals = { vertices[0].normal, in_size };
+        job.in_normals_stride = sizeof(SkinTestVertex);
+        job.in_tangents = { vertices[0].tangent, in_size };
+        job.in_tangents_stride = sizeof(SkinTestVertex);
+        job.out_positions = { positions.data(), positions.size() };
+        job.out_positions_stride = sizeof(float) * 3;
+        job.out_normals = { normals.data(), normals.size() };
+        job.out_normals_stride = sizeof(float) * 3;
+        job.out_tangents = { tangents.data(), tangents.size() };
+        job.out_tangents_stride = sizeof(float) * 4;
+        EXPECT_TRUE(job.Run());
+    }
+
+    void RunOzzSkinning(const SkinTestCharacter& character, skr::vector<float>& positions, skr::vector<float>& normals, skr::vector<float>& tangents)
+    {
+        RunOzzSkinning(character.skin_matrices, character.vertices, positions, normals, tangents);
+    }
+};
+
+TEST_F(Skinning, MatchesOzz)
+{
+    SkinTestCharacter character;
+    InitCharacter(character, 64, 1027);
+    skr_skin_vertices(&character.streams, character.skin_matrices.data(), (uint32_t)character.skin_matrices.size(), 0, 1027);
+
+    skr::vector<float> positions, normals, tangents;
+    RunOzzSkinning(character, positions, normals, tangents);
+    for (uint32_t i = 0; i < 1027; ++i)
+    {
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            EXPECT_NEAR(character.positions[i * 3 + c], positions[i * 3 + c], 1e-3f);
+            EXPECT_NEAR(character.normals[i * 3 + c], normals[i * 3 + c], 1e-4f);
+            EXPECT_NEAR(character.tangents[i * 4 + c], tangents[i * 4 + c], 1e-4f);
+        }
+        // handedness is carried over untouched
+        EXPECT_EQ(character.tangents[i * 4 + 3], character.vertices[i].tangent[3]);
+    }
+}
+
+TEST_F(Skinning, PartialRange)
+{
+    SkinTestCharacter character;
+    InitCharacter(character, 16, 100);
+    skr_skin_vertices(&character.streams, character.skin_matrices.data(), (uint32_t)character.skin_matrices.size(), 10, 20);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        const bool skinned = i >= 10 && i < 20;
+        EXPECT_EQ(character.positions[i * 3] != 0.f, skinned);
+    }
+}
+
+// components of characters sharing one mesh and one skin, set up the way skr_init_anim_component and
+// skr_init_skin_component leave them, with handles resolved to records owned by the fixture
+class SkinningBatch : public Skinning
+{
+protected:
+    static constexpr uint32_t kJointCount = 64;
+
+    skr::vector<SkinTestVertex> vertices;
+    skr::vector<uint8_t> mesh_bytes;
+    skr::vector<skr_float4x4_t> inverse_bind_poses;
+    skr::vector<eastl::string_view> joint_names;
+    skr_mesh_resource_t mesh;
+    skr_skin_resource_t skin;
+    skr_resource_record_t mesh_record;
+    skr_resource_record_t skin_record;
+    skr::vector<skr_render_skin_comp_t> skins;
+    skr::vector<skr_render_anim_comp_t> anims;
+    skr::vector<skr_render_mesh_comp_t> meshes;
+
+    void TearDown() override
+    {
+        // the records are not known to the resource system, handles must not unload them
+        for (auto& skin : skins) skin.skin_resource.set_record(nullptr);
+        for (auto& mesh : meshes) mesh.mesh_resource.set_record(nullptr);
+        Skinning::TearDown();
+    }
+
+    void InitCharacters(uint32_t character_count, uint32_t vertex_count)
+    {
+        SkinTestCharacter shared;
+        InitCharacter(shared, kJointCount, vertex_count);
+        vertices = shared.vertices;
+        inverse_bind_poses.resize(kJointCount);
+        for (uint32_t i = 0; i < kJointCount; ++i)
+            inverse_bind_poses[i] = (const skr_float4x4_t&)shared.skin_matrices[i];
+        joint_names.resize(kJointCount);
+
+        skin.blob.joint_remaps = { joint_names.data(), joint_names.size() };
+        skin.blob.inverse_bind_poses = { inverse_bind_poses.data(), inverse_bind_poses.size() };
+        // the cooker writes one tightly packed stream per attribute
+        const uint32_t strides[] = { 3 * sizeof(float), 3 * sizeof(float), 4 * sizeof(float), 4 * sizeof(uint16_t), 4 * sizeof(float) };
+        const size_t sources[] = { offsetof(SkinTestVertex, position), offsetof(SkinTestVertex, normal), offsetof(SkinTestVertex, tangent),
+            offsetof(SkinTestVertex, joints), offsetof(SkinTestVertex, weights) };
+        const ESkrVertexAttribute attributes[] = { SKR_VERT_ATTRIB_POSITION, SKR_VERT_ATTRIB_NORMAL, SKR_VERT_ATTRIB_TANGENT,
+            SKR_VERT_ATTRIB_JOINTS, SKR_VERT_ATTRIB_WEIGHTS };
+        auto& primitive = mesh.primitives.emplace_back();
+        primitive.vertex_count = vertex_count;
+        for (uint32_t a = 0; a < 5; ++a)
+        {
+            const auto offset = (uint32_t)mesh_bytes.size();
+            primitive.vertex_buffers.push_back({ attributes[a], 0, 0, strides[a], offset });
+            for (const auto& vertex : vertices)
+            {
+                const auto bytes = (const uint8_t*)&vertex + sources[a];
+                mesh_bytes.insert(mesh_bytes.end(), bytes, bytes + strides[a]);
+            }
+        }
+        auto& bin = mesh.bins.emplace_back();
+        bin.bin.bytes = mesh_bytes.data();
+        bin.bin.size = mesh_bytes.size();
+        mesh_record.resource = &mesh;
+        mesh_record.loadingStatus = SKR_LOADING_STATUS_INSTALLED;
+        skin_record.resource = &skin;
+        skin_record.loadingStatus = SKR_LOADING_STATUS_INSTALLED;
+
+        skins.resize(character_count);
+        anims.resize(character_count);
+        meshes.resize(character_count);
+        for (uint32_t c = 0; c < character_count; ++c)
+        {
+            skins[c].skin_resource.set_resolved(&skin_record, 0, SKR_REQUESTER_SYSTEM);
+            meshes[c].mesh_resource.set_resolved(&mesh_record, 0, SKR_REQUESTER_SYSTEM);
+            // skin joints map to the skeleton backwards, so a wrong remap shows
+            skins[c].joint_remaps.resize(kJointCount);
+            for (uint32_t i = 0; i < kJointCount; ++i)
+                skins[c].joint_remaps[i] = (uint16_t)(kJointCount - 1 - i);
+
+            auto& anim = anims[c];
+            anim.joint_matrices.resize(kJointCount);
+            for (auto& matrix : anim.joint_matrices)
+            {
+                for (auto& col : matrix.cols)
+                    col = ozz::math::simd_float4::Load(RandomFloat(-1.f, 1.f), RandomFloat(-1.f, 1.f), RandomFloat(-1.f, 1.f), RandomFloat(-1.f, 1.f));
+            }
+            auto& stream = anim.streams.emplace_back();
+            stream = {};
+            stream.vertex_count = vertex_count;
+            stream.position = primitive.vertex_buffers[0];
+            stream.normal = primitive.vertex_buffers[1];
+            stream.tangent = primitive.vertex_buffers[2];
+            stream.joints = primitive.vertex_buffers[3];
+            stream.weights = primitive.vertex_buffers[4];
+            // outputs keep the input strides, one region per stream
+            auto& skin_primitive = anim.primitives.emplace_back();
+            skin_primitive.position = { SKR_VERT_ATTRIB_POSITION, 0, 0, strides[0], 0 };
+            skin_primitive.normal = { SKR_VERT_ATTRIB_NORMAL, 0, 0, strides[1], strides[0] * vertex_count };
+            skin_primitive.tangent = { SKR_VERT_ATTRIB_TANGENT, 0, 0, strides[2], (strides[0] + strides[1]) * vertex_count };
+            auto& buffer = anim.buffers.emplace_back();
+            buffer.size = (strides[0] + strides[1] + strides[2]) * vertex_count;
+            buffer.bytes = (uint8_t*)sakura_malloc_aligned(buffer.size, 16);
+            memset(buffer.bytes, 0, buffer.size);
+            anim.vbs.push_back(nullptr);
+        }
+    }
+
+    // skins character c with the ozz reference job and compares with what the batch wrote
+    void ExpectMatchesOzz(uint32_t c)
+    {
+        skr::vector<ozz::math::Float4x4> skin_matrices(kJointCount);
+        for (uint32_t i = 0; i < kJointCount; ++i)
+            skin_matrices[i] = anims[c].joint_matrices[skins[c].joint_remaps[i]] * (const ozz::math::Float4x4&)inverse_bind_poses[i];
+        skr::vector<float> positions, normals, tangents;
+        RunOzzSkinning(skin_matrices, vertices, positions, normals, tangents);
+
+        const auto& prim = anims[c].primitives[0];
+        const uint8_t* bytes = anims[c].buffers[0].bytes;
+        for (uint32_t i = 0; i < vertices.size(); ++i)
+        {
+            const auto position = (const float*)(bytes + prim.position.offset + prim.position.stride * i);
+            const auto normal = (const float*)(bytes + prim.normal.offset + prim.normal.stride * i);
+            const auto tangent = (const float*)(bytes + prim.tangent.offset + prim.tangent.stride * i);
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                ASSERT_NEAR(position[k], positions[i * 3 + k], 1e-3f) << "character " << c << " vertex " << i;
+                ASSERT_NEAR(normal[k], normals[i * 3 + k], 1e-4f) << "character " << c << " vertex " << i;
+                ASSERT_NEAR(tangent[k], tangents[i * 4 + k], 1e-4f) << "character " << c << " vertex " << i;
+            }
+            ASSERT_EQ(tangent[3], vertices[i].tangent[3]);
+        }
+    }
+};
+
+TEST_F(SkinningBatch, MatchesOzz)
+{
+    // 3 vertex ranges per primitive, the last one partial
+    InitCharacters(8, 9000);
+    skr_cpu_skin_batch(skins.data(), anims.data(), meshes.data(), (uint32_t)skins.size());
+    for (uint32_t c = 0; c < skins.size(); ++c)
+        ExpectMatchesOzz(c);
+}
+
+TEST_F(SkinningBatch, SkipsUnresolvedCharacters)
+{
+    InitCharacters(2, 100);
+    meshes[1].mesh_resource.set_record(nullptr);
+    skr_cpu_skin_batch(skins.data(), anims.data(), meshes.data(), (uint32_t)skins.size());
+    ExpectMatchesOzz(0);
+    const auto& buffer = anims[1].buffers[0];
+    for (uint64_t i = 0; i < buffer.size; ++i)
+        ASSERT_EQ(buffer.bytes[i], 0u);
+}
+
+// 1000 characters through skr_cpu_skin_batch against the reference ozz job, one character after another
+// the timings are recorded as test properties, the outputs must match ozz
+TEST_F(SkinningBatch, Benchmark)
+{
+    static constexpr uint32_t kCharacterCount = 1000;
+    static constexpr uint32_t kVertexCount = 2048;
+    InitCharacters(kCharacterCount, kVertexCount);
+
+    using clock = std::chrono::high_resolution_clock;
+    auto elapsed = [](clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    };
+    skr::vector<ozz::math::Float4x4> skin_matrices(kJointCount);
+    skr::vector<float> positions, normals, tangents;
+    auto start = clock::now();
+    for (uint32_t c = 0; c < kCharacterCount; ++c)
+    {
+        for (uint32_t i = 0; i < kJointCount; ++i)
+            skin_matrices[i] = anims[c].joint_matrices[skins[c].joint_remaps[i]] * (const ozz::math::Float4x4&)inverse_bind_poses[i];
+        RunOzzSkinning(skin_matrices, vertices, positions, normals, tangents);
+    }
+    const auto ozz_ms = elapsed(start);
+
+    start = clock::now();
+    skr_cpu_skin_batch(skins.data(), anims.data(), meshes.data(), kCharacterCount);
+    const auto batch_ms = elapsed(start);
+
+    RecordProperty("characters", (int)kCharacterCount);
+    RecordProperty("vertices_per_character", (int)kVertexCount);
+    RecordProperty("ozz_us", (int)(ozz_ms * 1000.0));
+    RecordProperty("batch_us", (int)(batch_ms * 1000.0));
+    // the batch timing is the avx2 kernel's on hosts that pass the check, the sse loop's otherwise
+    RecordProperty("avx2", (int)skr_cpu_has_avx2());
+    for (uint32_t c = 0; c < kCharacterCount; c += 97)
+        ExpectMatchesOzz(c);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    auto result = RUN_ALL_TESTS();
+    return result;
+}
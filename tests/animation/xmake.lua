@@ -0,0 +1,16 @@
+target("SkinningTest")
+    set_group("05.tests/animation")
+    set_kind("binary")
+    public_dependency("SkrAnim", engine_version)
+    add_packages("gtest")
+    add_files("skinning/skinning.cpp")
+
+-- clips are built with the offline builders of the animation tool
+if(has_config("build_tools")) then
+    target("AnimSystemTest")
+        set_group("05.tests/animation")
+        set_kind("binary")
+        public_dependency("SkrAnimTool", engine_version)
+        add_packages("gtest")
+        add_files("anim_system/anim_system.cpp")
+end
@@ -0,0 +1,309 @@
+#include "gtest/gtest.h"
+#include "cgpu/api.h"
+#include "cgpu/backend/null/cgpu_null.h"
+#include <cstring>
+#include <vector>
+
+class NullBackend : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        desc.enable_set_name = true;
+        instance = cgpu_create_instance(&desc);
+        EXPECT_NE(instance, CGPU_NULLPTR);
+
+        uint32_t adapters_count = 0;
+        cgpu_enum_adapters(instance, nullptr, &adapters_count);
+        EXPECT_EQ(adapters_count, 1u);
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+
+        CGPUQueueGroupDescriptor G = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        DECLARE_ZERO(CGPUDeviceDescriptor, descriptor)
+        descriptor.queue_groups = &G;
+        descriptor.queue_group_count = 1;
+        device = cgpu_create_device(adapter, &descriptor);
+        EXPECT_NE(device, CGPU_NULLPTR);
+
+        queue = cgpu_get_queue(device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
+        DECLARE_ZERO(CGPUCommandPoolDescriptor, pool_desc)
+        pool = cgpu_create_command_pool(queue, &pool_desc);
+        DECLARE_ZERO(CGPUCommandBufferDescriptor, cmd_desc)
+        cmd_desc.is_secondary = false;
+        cmd = cgpu_create_command_buffer(pool, &cmd_desc);
+    }
+
+    void TearDown() override
+    {
+        cgpu_free_command_buffer(cmd);
+        cgpu_free_command_pool(pool);
+        cgpu_free_queue(queue);
+        cgpu_free_device(device);
+        cgpu_free_instance(instance);
+    }
+
+    CGPUBufferId CreateBuffer(ECGPUMemoryUsage usage, uint64_t size, CGPUBufferCreationFlags flags = CGPU_BCF_NONE)
+    {
+        DECLARE_ZERO(CGPUBufferDescriptor, desc)
+        desc.name = u8"NullBuffer";
+        desc.flags = flags;
+        desc.descriptors = CGPU_RESOURCE_TYPE_BUFFER;
+        desc.memory_usage = usage;
+        desc.size = size;
+        return cgpu_create_buffer(device, &desc);
+    }
+
+    CGPUTextureId CreateTexture(uint32_t width, uint32_t height, CGPUResourceTypes descriptors, bool aliasing = false)
+    {
+        DECLARE_ZERO(CGPUTextureDescriptor, desc)
+        desc.name = u8"NullTexture";
+        desc.format = CGPU_FORMAT_R8G8B8A8_UNORM;
+        desc.start_state = CGPU_RESOURCE_STATE_COMMON;
+        desc.descriptors = descriptors;
+        desc.width = width;
+        desc.height = height;
+        desc.is_aliasing = aliasing;
+        return cgpu_create_texture(device, &desc);
+    }
+
+    void RecordFrame(CGPUCommandBufferId target, CGPUBufferId buffer)
+    {
+        cgpu_cmd_begin(target);
+        CGPUEventInfo event = { u8"NullFrame", { 1.f, 0.f, 0.f, 1.f } };
+        cgpu_cmd_begin_event(target, &event);
+        DECLARE_ZERO(CGPUBufferBarrier, buffer_barrier)
+        buffer_barrier.buffer = buffer;
+        buffer_barrier.src_state = CGPU_RESOURCE_STATE_COPY_DEST;
+        buffer_barrier.dst_state = CGPU_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+        DECLARE_ZERO(CGPUResourceBarrierDescriptor, barriers)
+        barriers.buffer_barriers = &buffer_barrier;
+        barriers.buffer_barriers_count = 1;
+        cgpu_cmd_resource_barrier(target, &barriers);
+        DECLARE_ZERO(CGPURenderPassDescriptor, pass_desc)
+        pass_desc.name = u8"NullPass";
+        pass_desc.sample_count = CGPU_SAMPLE_COUNT_1;
+        auto encoder = cgpu_cmd_begin_render_pass(target, &pass_desc);
+        const uint32_t stride = sizeof(float) * 4;
+        cgpu_render_encoder_bind_vertex_buffers(encoder, 1, &buffer, &stride, nullptr);
+        cgpu_render_encoder_set_viewport(encoder, 0.f, 0.f, 64.f, 64.f, 0.f, 1.f);
+        cgpu_render_encoder_draw_instanced(encoder, 3, 0, 16, 0);
+        cgpu_render_encoder_draw(encoder, 6, 3);
+        cgpu_cmd_end_render_pass(target, encoder);
+        auto compute_encoder = cgpu_cmd_begin_compute_pass(target, nullptr);
+        cgpu_compute_encoder_dispatch(compute_encoder, 8, 8, 1);
+        cgpu_cmd_end_compute_pass(target, compute_encoder);
+        cgpu_cmd_end_event(target);
+        cgpu_cmd_end(target);
+    }
+
+    CGPUInstanceId instance;
+    CGPUAdapterId adapter;
+    CGPUDeviceId device;
+    CGPUQueueId queue;
+    CGPUCommandPoolId pool;
+    CGPUCommandBufferId cmd;
+};
+
+TEST_F(NullBackend, RecordCommandStream)
+{
+    auto buffer = CreateBuffer(CGPU_MEM_USAGE_GPU_ONLY, 1024);
+    RecordFrame(cmd, buffer);
+
+    const ECGPUNullCommandType expected[] = {
+        CGPU_NULL_COMMAND_BEGIN_EVENT,
+        CGPU_NULL_COMMAND_RESOURCE_BARRIER,
+        CGPU_NULL_COMMAND_BEGIN_RENDER_PASS,
+        CGPU_NULL_COMMAND_BIND_VERTEX_BUFFERS,
+        CGPU_NULL_COMMAND_SET_VIEWPORT,
+        CGPU_NULL_COMMAND_DRAW,
+        CGPU_NULL_COMMAND_DRAW,
+        CGPU_NULL_COMMAND_END_RENDER_PASS,
+        CGPU_NULL_COMMAND_BEGIN_COMPUTE_PASS,
+        CGPU_NULL_COMMAND_DISPATCH,
+        CGPU_NULL_COMMAND_END_COMPUTE_PASS,
+        CGPU_NULL_COMMAND_END_EVENT
+    };
+    EXPECT_EQ(cgpu_null_command_buffer_count(cmd), sizeof(expected) / sizeof(expected[0]));
+    uint32_t i = 0;
+    for (auto command = cgpu_null_command_buffer_first(cmd); command; command = cgpu_null_command_buffer_next(cmd, command), i++)
+    {
+        ASSERT_LT(i, sizeof(expected) / sizeof(expected[0]));
+        EXPECT_EQ(command->type, expected[i]);
+        EXPECT_EQ(command->size % 8, 0u);
+        if (command->type == CGPU_NULL_COMMAND_RESOURCE_BARRIER)
+        {
+            auto barrier = (const CGPUNullCmdResourceBarrier*)command;
+            EXPECT_EQ(barrier->buffer_barriers_count, 1u);
+            EXPECT_EQ(((const CGPUBufferBarrier*)(barrier + 1))->buffer, buffer);
+        }
+        if (i == 5)
+        {
+            auto draw = (const CGPUNullCmdDraw*)command;
+            EXPECT_EQ(draw->element_count, 3u);
+            EXPECT_EQ(draw->instance_count, 16u);
+            EXPECT_FALSE(draw->indexed);
+        }
+    }
+    EXPECT_EQ(i, sizeof(expected) / sizeof(expected[0]));
+
+    // begin rewinds the stream
+    cgpu_cmd_begin(cmd);
+    EXPECT_EQ(cgpu_null_command_buffer_count(cmd), 0u);
+    EXPECT_EQ(cgpu_null_command_buffer_first(cmd), nullptr);
+    cgpu_cmd_end(cmd);
+    cgpu_free_buffer(buffer);
+}
+
+TEST_F(NullBackend, ReplayCommandBuffer)
+{
+    auto buffer = CreateBuffer(CGPU_MEM_USAGE_GPU_ONLY, 1024);
+    RecordFrame(cmd, buffer);
+
+    DECLARE_ZERO(CGPUCommandBufferDescriptor, cmd_desc)
+    auto replayed = cgpu_create_command_buffer(pool, &cmd_desc);
+    cgpu_cmd_begin(replayed);
+    cgpu_null_replay_command_buffer(cmd, replayed);
+    cgpu_cmd_end(replayed);
+
+    EXPECT_EQ(cgpu_null_command_buffer_count(replayed), cgpu_null_command_buffer_count(cmd));
+    ASSERT_EQ(cgpu_null_command_buffer_size(replayed), cgpu_null_command_buffer_size(cmd));
+    const auto size = cgpu_null_command_buffer_size(cmd);
+    EXPECT_EQ(memcmp(cgpu_null_command_buffer_first(replayed), cgpu_null_command_buffer_first(cmd), size), 0);
+
+    cgpu_free_command_buffer(replayed);
+    cgpu_free_buffer(buffer);
+}
+
+TEST_F(NullBackend, SubmitExecutesTransfers)
+{
+    const uint32_t count = 64;
+    auto upload = CreateBuffer(CGPU_MEM_USAGE_CPU_ONLY, count * sizeof(uint32_t), CGPU_BCF_PERSISTENT_MAP_BIT);
+    auto readback = CreateBuffer(CGPU_MEM_USAGE_GPU_TO_CPU, count * sizeof(uint32_t));
+    ASSERT_NE(upload->cpu_mapped_address, nullptr);
+    EXPECT_EQ(readback->cpu_mapped_address, nullptr);
+    for (uint32_t i = 0; i < count; i++)
+        ((uint32_t*)upload->cpu_mapped_address)[i] = i * 3;
+
+    cgpu_cmd_begin(cmd);
+    DECLARE_ZERO(CGPUBufferToBufferTransfer, transfer)
+    transfer.src = upload;
+    transfer.dst = readback;
+    transfer.size = count * sizeof(uint32_t);
+    cgpu_cmd_transfer_buffer_to_buffer(cmd, &transfer);
+    cgpu_null_cmd_write_buffer_marker(cmd, readback, 0, 0xFFFFu);
+    cgpu_cmd_end(cmd);
+
+    auto fence = cgpu_create_fence(device);
+    EXPECT_EQ(cgpu_query_fence_status(fence), CGPU_FENCE_STATUS_NOTSUBMITTED);
+    DECLARE_ZERO(CGPUQueueSubmitDescriptor, submit)
+    submit.cmds = &cmd;
+    submit.cmds_count = 1;
+    submit.signal_fence = fence;
+    cgpu_submit_queue(queue, &submit);
+    EXPECT_EQ(cgpu_query_fence_status(fence), CGPU_FENCE_STATUS_COMPLETE);
+
+    DECLARE_ZERO(CGPUBufferRange, range)
+    range.size = count * sizeof(uint32_t);
+    cgpu_map_buffer(readback, &range);
+    const uint32_t* values = (const uint32_t*)readback->cpu_mapped_address;
+    EXPECT_EQ(values[0], 0xFFFFu);
+    for (uint32_t i = 1; i < count; i++)
+        EXPECT_EQ(values[i], i * 3);
+    cgpu_unmap_buffer(readback);
+
+    DECLARE_ZERO(CGPUNullDeviceStatistics, stats)
+    cgpu_null_query_device_statistics(device, &stats);
+    EXPECT_EQ(stats.submits, 1u);
+    EXPECT_EQ(stats.command_buffers_submitted, 1u);
+    EXPECT_EQ(stats.commands_submitted, 2u);
+    EXPECT_EQ(stats.copies, 1u);
+
+    cgpu_free_fence(fence);
+    cgpu_free_buffer(upload);
+    cgpu_free_buffer(readback);
+}
+
+TEST_F(NullBackend, TextureSizesAndAliasing)
+{
+    // 2048 byte rows, 64KB placement
+    auto texture = CreateTexture(512, 512, CGPU_RESOURCE_TYPE_TEXTURE);
+    EXPECT_EQ(texture->size_in_bytes, 512ull * 2048);
+    // a 16x16 texture is a single 4KB page with 256 byte aligned rows
+    auto small = CreateTexture(16, 16, CGPU_RESOURCE_TYPE_TEXTURE);
+    EXPECT_EQ(small->size_in_bytes, 4096ull);
+    // render targets never take the small placement
+    auto small_rt = CreateTexture(16, 16, CGPU_RESOURCE_TYPE_TEXTURE | CGPU_RESOURCE_TYPE_RENDER_TARGET);
+    EXPECT_EQ(small_rt->size_in_bytes, 64ull * 1024);
+
+    auto aliased = CreateTexture(1024, 1024, CGPU_RESOURCE_TYPE_TEXTURE | CGPU_RESOURCE_TYPE_RENDER_TARGET);
+    auto aliasing = CreateTexture(512, 512, CGPU_RESOURCE_TYPE_TEXTURE | CGPU_RESOURCE_TYPE_RENDER_TARGET, true);
+    EXPECT_TRUE(aliasing->is_aliasing);
+    EXPECT_EQ(aliasing->size_in_bytes, 1024ull * 1024);
+
+    CGPUTextureAliasingBindDescriptor bind = { aliased, aliasing, 1024ull * 1024 };
+    EXPECT_TRUE(cgpu_try_bind_aliasing_texture(device, &bind));
+    bind.offset = 256;
+    EXPECT_FALSE(cgpu_try_bind_aliasing_texture(device, &bind));
+    bind.offset = 3584ull * 1024;
+    EXPECT_FALSE(cgpu_try_bind_aliasing_texture(device, &bind));
+    bind.aliased = small;
+    bind.offset = 0;
+    EXPECT_FALSE(cgpu_try_bind_aliasing_texture(device, &bind));
+
+    EXPECT_NE(texture->unique_id, small->unique_id);
+    cgpu_free_texture(aliasing);
+    cgpu_free_texture(aliased);
+    cgpu_free_texture(small_rt);
+    cgpu_free_texture(small);
+    cgpu_free_texture(texture);
+}
+
+TEST_F(NullBackend, DeviceStatistics)
+{
+    uint64_t total = 0, used = 0;
+    cgpu_query_video_memory_info(device, &total, &used);
+    EXPECT_EQ(used, 0u);
+
+    auto buffer = CreateBuffer(CGPU_MEM_USAGE_GPU_ONLY, 1000);
+    auto texture = CreateTexture(512, 512, CGPU_RESOURCE_TYPE_TEXTURE);
+    cgpu_query_video_memory_info(device, &total, &used);
+    EXPECT_EQ(used, 1024u + 512u * 2048u);
+    cgpu_free_texture(texture);
+
+    RecordFrame(cmd, buffer);
+    DECLARE_ZERO(CGPUQueueSubmitDescriptor, submit)
+    submit.cmds = &cmd;
+    submit.cmds_count = 1;
+    cgpu_submit_queue(queue, &submit);
+    cgpu_submit_queue(queue, &submit);
+
+    DECLARE_ZERO(CGPUNullDeviceStatistics, stats)
+    cgpu_null_query_device_statistics(device, &stats);
+    EXPECT_EQ(stats.buffers_created, 1u);
+    EXPECT_EQ(stats.textures_created, 1u);
+    EXPECT_EQ(stats.allocated_bytes, 1024u);
+    EXPECT_EQ(stats.peak_allocated_bytes, 1024u + 512u * 2048u);
+    EXPECT_EQ(stats.submits, 2u);
+    EXPECT_EQ(stats.render_passes, 2u);
+    EXPECT_EQ(stats.compute_passes, 2u);
+    EXPECT_EQ(stats.draws, 4u);
+    EXPECT_EQ(stats.dispatches, 2u);
+    EXPECT_EQ(stats.buffer_barriers, 2u);
+
+    cgpu_null_reset_device_statistics(device);
+    cgpu_null_query_device_statistics(device, &stats);
+    EXPECT_EQ(stats.submits, 0u);
+    EXPECT_EQ(stats.draws, 0u);
+    EXPECT_EQ(stats.allocated_bytes, 1024u);
+    EXPECT_EQ(stats.peak_allocated_bytes, 1024u);
+    cgpu_free_buffer(buffer);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    auto result = RUN_ALL_TESTS();
+    return result;
+}
@@ -52,6 +52,14 @@ protected:
         frag_shader_sizes[CGPU_BACKEND_D3D12] = sizeof(triangle_frag_dxil);
         compute_shaders[CGPU_BACKEND_D3D12] = (const uint32_t*)simple_compute_dxil;
         compute_shader_sizes[CGPU_BACKEND_D3D12] = sizeof(simple_compute_dxil);
+
+        // null backend reflects spirv
+        vertex_shaders[CGPU_BACKEND_NULL] = vertex_shaders[CGPU_BACKEND_VULKAN];
+        vertex_shader_sizes[CGPU_BACKEND_NULL] = vertex_shader_sizes[CGPU_BACKEND_VULKAN];
+        frag_shaders[CGPU_BACKEND_NULL] = frag_shaders[CGPU_BACKEND_VULKAN];
+        frag_shader_sizes[CGPU_BACKEND_NULL] = frag_shader_sizes[CGPU_BACKEND_VULKAN];
+        compute_shaders[CGPU_BACKEND_NULL] = compute_shaders[CGPU_BACKEND_VULKAN];
+        compute_shader_sizes[CGPU_BACKEND_NULL] = compute_shader_sizes[CGPU_BACKEND_VULKAN];
     }
 
     void TearDown() override
@@ -312,6 +320,10 @@ CGPU_BACKEND_VULKAN
 ,
 CGPU_BACKEND_D3D12
 #endif
+#ifdef CGPU_USE_NULL
+,
+CGPU_BACKEND_NULL
+#endif
 );
 
 INSTANTIATE_TEST_SUITE_P(ResourceCreation, ResourceCreation, allPlatforms);
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include "staging_ring.hpp"
+
+class StagingRing : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // the ring only hands out offsets, it never touches the buffer
+        ring.buffer = &buffer;
+        ring.capacity = 1024;
+    }
+
+    uint64_t allocate(uint64_t size, uint64_t alignment, uint64_t batch_id)
+    {
+        uint64_t offset = UINT64_MAX;
+        EXPECT_TRUE(ring.allocate(size, alignment, batch_id, offset));
+        return offset;
+    }
+
+    CGPUBuffer buffer = {};
+    skr::io::StagingRing ring;
+};
+
+TEST_F(StagingRing, AllocatesFrontToBack)
+{
+    EXPECT_EQ(allocate(100, 16, 0), 0u);
+    EXPECT_EQ(allocate(100, 16, 0), 112u);
+    EXPECT_EQ(allocate(10, 256, 1), 256u);
+    // one retirement per batch, ending where the batch's last allocation ends
+    ASSERT_EQ(ring.retirements.size(), 2u);
+    EXPECT_EQ(ring.retirements[0].end, 212u);
+    EXPECT_EQ(ring.retirements[1].end, 266u);
+}
+
+TEST_F(StagingRing, WrapsAroundOnceTheFrontIsRetired)
+{
+    EXPECT_EQ(allocate(400, 16, 0), 0u);
+    EXPECT_EQ(allocate(400, 16, 1), 400u);
+    ring.retire(0);
+    // 224 bytes are left at the back, the allocation skips them and starts over at 0
+    EXPECT_EQ(allocate(300, 16, 2), 0u);
+    EXPECT_EQ(ring.head, 1024u + 300u);
+    EXPECT_EQ(ring.head - ring.tail, 924u);
+    // the skipped bytes stay reserved until batch 1 retires
+    uint64_t offset = 0;
+    EXPECT_FALSE(ring.allocate(128, 16, 3, offset));
+    ring.retire(1);
+    EXPECT_EQ(allocate(128, 16, 3), 304u);
+}
+
+TEST_F(StagingRing, OutOfOrderRetireWaitsForTheOldestBatch)
+{
+    allocate(512, 16, 0);
+    allocate(256, 16, 1);
+    allocate(256, 16, 2);
+    EXPECT_EQ(ring.head, 1024u);
+
+    ring.retire(2);
+    ring.retire(1);
+    EXPECT_EQ(ring.tail, 0u);
+    EXPECT_EQ(ring.retirements.size(), 3u);
+    uint64_t offset = 0;
+    EXPECT_FALSE(ring.allocate(16, 16, 3, offset));
+
+    ring.retire(0);
+    EXPECT_TRUE(ring.retirements.empty());
+    EXPECT_EQ(ring.tail, ring.head);
+    // an idle ring starts over from the front
+    EXPECT_EQ(allocate(1024, 16, 3), 0u);
+}
+
+TEST_F(StagingRing, RefusesWhatDoesNotFit)
+{
+    uint64_t offset = 7;
+    EXPECT_FALSE(ring.allocate(1025, 16, 0, offset));
+    EXPECT_EQ(offset, 7u);
+    EXPECT_TRUE(ring.retirements.empty());
+
+    allocate(1000, 16, 0);
+    EXPECT_FALSE(ring.allocate(32, 16, 1, offset));
+    // a refused allocation leaves the ring untouched
+    EXPECT_EQ(ring.head, 1000u);
+    EXPECT_EQ(ring.retirements.size(), 1u);
+
+    skr::io::StagingRing empty;
+    EXPECT_FALSE(empty.allocate(16, 16, 0, offset));
+}
+
+TEST_F(StagingRing, LargeUploadsGetABufferOfTheirOwn)
+{
+    EXPECT_TRUE(ring.stages(256));
+    EXPECT_FALSE(ring.stages(257));
+}
+
+TEST(UploadBudget, AdmitsUploadsUpToTheLimit)
+{
+    skr::io::UploadBudget budget;
+    budget.limit = 1000;
+    // the first upload of a batch always gets in
+    EXPECT_TRUE(budget.admits(4000));
+    budget.bytes += 600;
+    EXPECT_TRUE(budget.admits(400));
+    EXPECT_FALSE(budget.admits(401));
+    budget.bytes += 400;
+    EXPECT_FALSE(budget.admits(0));
+
+    skr::io::UploadBudget unlimited;
+    unlimited.bytes = UINT64_MAX - 1;
+    EXPECT_TRUE(unlimited.admits(1));
+    EXPECT_FALSE(unlimited.admits(2));
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    auto result = RUN_ALL_TESTS();
+    return result;
+}
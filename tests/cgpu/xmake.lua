@@ -21,4 +21,18 @@ target("CGPURSPoolTest")
     public_dependency("SkrRT", engine_version)
     add_packages("gtest")
     add_files("RootSignaturePool/RootSignaturePool.cpp")
-    add_files("RootSignaturePool/shaders/**.hlsl")
\ No newline at end of file
+    add_files("RootSignaturePool/shaders/**.hlsl")
+target("CGPUNullBackendTest")
+    set_kind("binary")
+    set_group("05.tests/cgpu")
+    public_dependency("SkrRT", engine_version)
+    add_packages("gtest")
+    add_files("NullBackend/NullBackend.cpp")
+
+target("CGPUStagingRingTest")
+    set_kind("binary")
+    set_group("05.tests/cgpu")
+    public_dependency("SkrRT", engine_version)
+    add_packages("gtest")
+    add_includedirs(path.join(os.projectdir(), "modules/runtime/src/utils"))
+    add_files("StagingRing/StagingRing.cpp")
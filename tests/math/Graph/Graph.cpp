@@ -241,6 +241,304 @@ TEST(GraphTest, RenderGraphFrontEnd)
     render_graph::RenderGraph::destroy(graph);
 }
 
+#include "SkrRenderGraph/frontend/transient_allocator.hpp"
+
+TEST(GraphTest, TransientAllocatorDisjointLifespansShareMemory)
+{
+    namespace render_graph = skr::render_graph;
+    using render_graph::ETransientHeapKind;
+    const render_graph::TransientRequest requests[] = {
+        { 4096, 256, 0, 1, ETransientHeapKind::RenderTarget },
+        { 4096, 256, 2, 3, ETransientHeapKind::RenderTarget },
+        { 1024, 256, 1, 2, ETransientHeapKind::RenderTarget },
+    };
+    render_graph::TransientAllocator allocator;
+    allocator.plan(requests);
+    const auto placements = allocator.get_placements();
+    EXPECT_EQ(allocator.get_heaps().size(), 1u);
+    // the two large ones never live together and take the same range, the small one goes behind them
+    EXPECT_EQ(placements[0].offset, 0u);
+    EXPECT_EQ(placements[1].offset, 0u);
+    EXPECT_EQ(placements[2].offset, 4096u);
+    EXPECT_EQ(allocator.get_heaps_size(), 5120u);
+    EXPECT_EQ(allocator.get_requested_size(), 9216u);
+}
+
+TEST(GraphTest, TransientAllocatorFillsGaps)
+{
+    namespace render_graph = skr::render_graph;
+    using render_graph::ETransientHeapKind;
+    const render_graph::TransientRequest requests[] = {
+        { 1000, 512, 0, 4, ETransientHeapKind::Texture },
+        { 2048, 512, 0, 1, ETransientHeapKind::Texture },
+        { 3000, 512, 0, 4, ETransientHeapKind::Texture },
+        // lives after the 2048 one and fits in the range it leaves
+        { 1500, 512, 2, 3, ETransientHeapKind::Texture },
+    };
+    render_graph::TransientAllocator allocator;
+    allocator.plan(requests);
+    const auto placements = allocator.get_placements();
+    ASSERT_EQ(allocator.get_heaps().size(), 1u);
+    EXPECT_EQ(placements[2].offset, 0u);
+    EXPECT_EQ(placements[1].offset, 3072u);
+    EXPECT_EQ(placements[3].offset, 3072u);
+    EXPECT_EQ(placements[0].offset, 5120u);
+    // overlapping lifespans never overlap in memory
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(placements[i].offset % requests[i].alignment, 0u);
+        for (uint32_t j = i + 1; j < 4; j++)
+        {
+            const bool live_together = requests[i].from <= requests[j].to && requests[j].from <= requests[i].to;
+            const bool share_memory = placements[i].offset < placements[j].offset + requests[j].size &&
+                placements[j].offset < placements[i].offset + requests[i].size;
+            EXPECT_FALSE(live_together && share_memory);
+        }
+    }
+}
+
+TEST(GraphTest, TransientAllocatorSeparatesKindsAndLimitsHeaps)
+{
+    namespace render_graph = skr::render_graph;
+    using render_graph::ETransientHeapKind;
+    const render_graph::TransientRequest requests[] = {
+        { 600, 64, 0, 0, ETransientHeapKind::RenderTarget },
+        { 600, 64, 1, 1, ETransientHeapKind::Buffer },
+        { 600, 64, 0, 1, ETransientHeapKind::RenderTarget },
+        { 2000, 64, 0, 1, ETransientHeapKind::Texture },
+    };
+    render_graph::TransientAllocator allocator;
+    allocator.plan(requests, 1024);
+    const auto placements = allocator.get_placements();
+    const auto heaps = allocator.get_heaps();
+    ASSERT_EQ(heaps.size(), 4u);
+    // an oversized request gets a heap of its own
+    EXPECT_EQ(heaps[placements[3].heap].size, 2000u);
+    EXPECT_NE(placements[0].heap, placements[2].heap);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(heaps[placements[i].heap].kind, requests[i].kind);
+        EXPECT_EQ(placements[i].offset, 0u);
+    }
+}
+
+#include "SkrRenderGraph/frontend/state_timeline.hpp"
+
+TEST(GraphTest, StateTimelineTracksSubresources)
+{
+    namespace render_graph = skr::render_graph;
+    // a mip chain: every pass reads the mip written by the previous one and renders the next
+    const render_graph::ResourceAccess accesses[] = {
+        { 0, 0, CGPU_RESOURCE_STATE_RENDER_TARGET, CGPU_RESOURCE_STATE_RENDER_TARGET, 0, 1, 0, 1 },
+        { 1, 1, CGPU_RESOURCE_STATE_SHADER_RESOURCE, CGPU_RESOURCE_STATE_SHADER_RESOURCE, 0, 1, 0, 1 },
+        { 2, 1, CGPU_RESOURCE_STATE_RENDER_TARGET, CGPU_RESOURCE_STATE_RENDER_TARGET, 1, 1, 0, 1 },
+        { 3, 2, CGPU_RESOURCE_STATE_SHADER_RESOURCE, CGPU_RESOURCE_STATE_SHADER_RESOURCE, 1, 1, 0, 1 },
+        { 4, 2, CGPU_RESOURCE_STATE_RENDER_TARGET, CGPU_RESOURCE_STATE_RENDER_TARGET, 2, 1, 0, 1 },
+    };
+    const render_graph::ResourceUsage usages[] = { { 1, 0, 5, 3, 1 } };
+    render_graph::StateTimeline timeline;
+    timeline.build(accesses, usages, 2, 5, 3, false);
+
+    const auto first = timeline.get_edge_transitions(0);
+    ASSERT_EQ(first.size(), 1u);
+    EXPECT_TRUE(first[0].from_initial);
+    EXPECT_FALSE(first[0].whole);
+    EXPECT_EQ(first[0].mip_level, 0u);
+    // the read of mip 0 and the write of mip 1 share a pass without touching each other
+    const auto read = timeline.get_edge_transitions(1);
+    ASSERT_EQ(read.size(), 1u);
+    EXPECT_EQ(read[0].src_state, CGPU_RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_EQ(read[0].dst_state, CGPU_RESOURCE_STATE_SHADER_RESOURCE);
+    EXPECT_EQ(read[0].mip_level, 0u);
+    const auto write = timeline.get_edge_transitions(2);
+    ASSERT_EQ(write.size(), 1u);
+    EXPECT_TRUE(write[0].from_initial);
+    EXPECT_EQ(write[0].mip_level, 1u);
+    // the chain ends with a render target, the mips read on the way are brought back to it after the last pass
+    EXPECT_EQ(timeline.get_final_state(1), CGPU_RESOURCE_STATE_RENDER_TARGET);
+    const auto tails = timeline.get_pass_transitions(2);
+    ASSERT_EQ(tails.size(), 2u);
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(tails[i].mip_level, i);
+        EXPECT_EQ(tails[i].src_state, CGPU_RESOURCE_STATE_SHADER_RESOURCE);
+        EXPECT_EQ(tails[i].dst_state, CGPU_RESOURCE_STATE_RENDER_TARGET);
+    }
+    EXPECT_TRUE(timeline.get_pass_transitions(0).empty());
+    EXPECT_TRUE(timeline.get_pass_transitions(1).empty());
+}
+
+TEST(GraphTest, StateTimelineMergesAndSplits)
+{
+    namespace render_graph = skr::render_graph;
+    // a copy leaves the buffer readable, two passes read it and a later one writes it
+    const render_graph::ResourceAccess accesses[] = {
+        { 0, 0, CGPU_RESOURCE_STATE_COPY_DEST, CGPU_RESOURCE_STATE_SHADER_RESOURCE },
+        { 1, 1, CGPU_RESOURCE_STATE_SHADER_RESOURCE, CGPU_RESOURCE_STATE_SHADER_RESOURCE },
+        { 2, 2, CGPU_RESOURCE_STATE_SHADER_RESOURCE, CGPU_RESOURCE_STATE_SHADER_RESOURCE },
+        { 3, 4, CGPU_RESOURCE_STATE_UNORDERED_ACCESS, CGPU_RESOURCE_STATE_UNORDERED_ACCESS },
+    };
+    const render_graph::ResourceUsage usages[] = { { 0, 0, 4 } };
+    render_graph::StateTimeline timeline;
+    timeline.build(accesses, usages, 1, 4, 5, true);
+
+    EXPECT_EQ(timeline.get_merged_count(), 2u);
+    EXPECT_EQ(timeline.get_edge_transitions(0).size(), 1u);
+    EXPECT_TRUE(timeline.get_edge_transitions(1).empty());
+    EXPECT_TRUE(timeline.get_edge_transitions(2).empty());
+    // pass 3 does not touch the buffer, the write transition begins right after the last read
+    const auto end = timeline.get_edge_transitions(3);
+    ASSERT_EQ(end.size(), 1u);
+    EXPECT_EQ(end[0].split, render_graph::EBarrierSplit::End);
+    EXPECT_TRUE(end[0].whole);
+    const auto begin = timeline.get_pass_transitions(2);
+    ASSERT_EQ(begin.size(), 1u);
+    EXPECT_EQ(begin[0].split, render_graph::EBarrierSplit::Begin);
+    EXPECT_EQ(begin[0].src_state, CGPU_RESOURCE_STATE_SHADER_RESOURCE);
+    EXPECT_EQ(begin[0].dst_state, CGPU_RESOURCE_STATE_UNORDERED_ACCESS);
+    EXPECT_EQ(timeline.get_final_state(0), CGPU_RESOURCE_STATE_UNORDERED_ACCESS);
+
+    // without split barriers the whole transition waits for the writer
+    timeline.build(accesses, usages, 1, 4, 5, false);
+    EXPECT_EQ(timeline.get_edge_transitions(3)[0].split, render_graph::EBarrierSplit::None);
+    EXPECT_TRUE(timeline.get_pass_transitions(2).empty());
+}
+
+#include "SkrRenderGraph/frontend/pass_node.hpp"
+
+// lighting reads the gbuffer and writes the imported back buffer, debug writes a texture nobody reads
+// with stale_consumer, a last pass reads the debug texture but writes nothing that leaves the frame
+static void build_culling_frame(skr::render_graph::RenderGraph* graph, bool stale_consumer, uint32_t width = 1920)
+{
+    namespace render_graph = skr::render_graph;
+    static CGPUTexture imported = {};
+    imported.width = width;
+    imported.height = 1080;
+    imported.depth = 1;
+    imported.sample_count = CGPU_SAMPLE_COUNT_1;
+    imported.format = CGPU_FORMAT_B8G8R8A8_UNORM;
+    auto back_buffer = graph->create_texture(
+    [](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+        builder.set_name(u8"backbuffer")
+        .import(&imported, CGPU_RESOURCE_STATE_UNDEFINED);
+    });
+    const auto create_target = [&](const char8_t* name) {
+        return graph->create_texture(
+        [=](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.set_name(name)
+            .extent(width, 1080)
+            .allow_render_target()
+            .format(CGPU_FORMAT_B8G8R8A8_UNORM);
+        });
+    };
+    auto gbuffer = create_target(u8"gbuffer");
+    auto debug = create_target(u8"debug");
+    graph->add_render_pass(
+    [=](render_graph::RenderGraph&, render_graph::RenderPassBuilder& builder) {
+        builder.set_name(u8"gbuffer_pass")
+        .write(0, gbuffer);
+    },
+    render_graph::RenderPassExecuteFunction());
+    graph->add_render_pass(
+    [=](render_graph::RenderGraph&, render_graph::RenderPassBuilder& builder) {
+        builder.set_name(u8"debug_pass")
+        .read(u8"GBuffer", gbuffer)
+        .write(0, debug);
+    },
+    render_graph::RenderPassExecuteFunction());
+    graph->add_render_pass(
+    [=](render_graph::RenderGraph&, render_graph::RenderPassBuilder& builder) {
+        builder.set_name(u8"lighting_pass")
+        .read(u8"GBuffer", gbuffer)
+        .write(0, back_buffer);
+    },
+    render_graph::RenderPassExecuteFunction());
+    if (stale_consumer)
+    {
+        auto scratch = create_target(u8"scratch");
+        graph->add_render_pass(
+        [=](render_graph::RenderGraph&, render_graph::RenderPassBuilder& builder) {
+            builder.set_name(u8"stale_pass")
+            .read(u8"Debug", debug)
+            .write(0, scratch);
+        },
+        render_graph::RenderPassExecuteFunction());
+    }
+}
+
+static bool culled_pass(const skr::render_graph::RenderGraph* graph, const char* name)
+{
+    for (auto pass : graph->get_culled_passes())
+    {
+        if (strcmp((const char*)pass->get_name(), name) == 0) return true;
+    }
+    return false;
+}
+
+TEST(GraphTest, RenderGraphCullsUnreachablePasses)
+{
+    namespace render_graph = skr::render_graph;
+    auto graph = render_graph::RenderGraph::create(
+    [](render_graph::RenderGraphBuilder& builder) {
+        builder.frontend_only();
+    });
+    // a pass without consumers goes, the passes leading to the imported output stay
+    build_culling_frame(graph, false);
+    graph->compile();
+    EXPECT_EQ(graph->get_culled_passes().size(), 1u);
+    EXPECT_TRUE(culled_pass(graph, "debug_pass"));
+    EXPECT_FALSE(culled_pass(graph, "gbuffer_pass"));
+    EXPECT_FALSE(culled_pass(graph, "lighting_pass"));
+    EXPECT_EQ(graph->get_culled_resources().size(), 1u);
+    graph->execute();
+
+    // consumers that lead nowhere do not keep a pass alive, the whole dead branch goes
+    build_culling_frame(graph, true);
+    graph->compile();
+    EXPECT_EQ(graph->get_culled_passes().size(), 2u);
+    EXPECT_TRUE(culled_pass(graph, "debug_pass"));
+    EXPECT_TRUE(culled_pass(graph, "stale_pass"));
+    EXPECT_EQ(graph->get_culled_resources().size(), 2u);
+    graph->execute();
+    render_graph::RenderGraph::destroy(graph);
+}
+
+TEST(GraphTest, RenderGraphReusesCompileResults)
+{
+    namespace render_graph = skr::render_graph;
+    auto graph = render_graph::RenderGraph::create(
+    [](render_graph::RenderGraphBuilder& builder) {
+        builder.frontend_only();
+    });
+    // miss on the first frame, hits while the structure stays the same
+    for (uint32_t frame = 0; frame < 3; frame++)
+    {
+        build_culling_frame(graph, false);
+        graph->compile();
+        EXPECT_EQ(graph->get_compile_cache_hits(), frame);
+        // the restored result culls the same passes
+        EXPECT_EQ(graph->get_culled_passes().size(), 1u);
+        EXPECT_TRUE(culled_pass(graph, "debug_pass"));
+        graph->execute();
+    }
+    // another pass and another texture extent both change the structure
+    build_culling_frame(graph, true);
+    graph->compile();
+    EXPECT_EQ(graph->get_compile_cache_hits(), 2u);
+    EXPECT_EQ(graph->get_culled_passes().size(), 2u);
+    graph->execute();
+    build_culling_frame(graph, true, 1280);
+    graph->compile();
+    EXPECT_EQ(graph->get_compile_cache_hits(), 2u);
+    graph->execute();
+    build_culling_frame(graph, true, 1280);
+    graph->compile();
+    EXPECT_EQ(graph->get_compile_cache_hits(), 3u);
+    EXPECT_EQ(graph->get_culled_passes().size(), 2u);
+    graph->execute();
+    render_graph::RenderGraph::destroy(graph);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,438 @@
+#include "gtest/gtest.h"
+#include "cgpu/api.h"
+#include "cgpu/backend/null/cgpu_null.h"
+#include "SkrRenderGraph/frontend/render_graph.hpp"
+#include "SkrRenderGraph/backend/bind_table_pool.hpp"
+#include "task/task.hpp"
+#include <EASTL/vector_map.h>
+#include <cstring>
+
+namespace render_graph = skr::render_graph;
+
+// the null backend has no shader reflection, the root signature of the test passes is laid out by hand
+class RenderGraphBackend : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        instance = cgpu_create_instance(&desc);
+        uint32_t adapters_count = 1;
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+
+        CGPUQueueGroupDescriptor G = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        DECLARE_ZERO(CGPUDeviceDescriptor, descriptor)
+        descriptor.queue_groups = &G;
+        descriptor.queue_group_count = 1;
+        device = cgpu_create_device(adapter, &descriptor);
+        queue = cgpu_get_queue(device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
+
+        const char8_t* names[] = { u8"source", u8"target" };
+        const ECGPUResourceType types[] = { CGPU_RESOURCE_TYPE_TEXTURE, CGPU_RESOURCE_TYPE_RW_TEXTURE };
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            resources[i].name = names[i];
+            resources[i].name_hash = cgpu_name_hash(names[i], strlen((const char*)names[i]));
+            resources[i].type = types[i];
+            resources[i].dim = CGPU_TEX_DIMENSION_2D;
+            resources[i].binding = i;
+            resources[i].stages = CGPU_SHADER_STAGE_COMPUTE;
+        }
+        table.resources = resources;
+        table.resources_count = 2;
+        root_signature.device = device;
+        root_signature.tables = &table;
+        root_signature.table_count = 1;
+        root_signature.pipeline_type = CGPU_PIPELINE_TYPE_COMPUTE;
+        pipeline.device = device;
+        pipeline.root_signature = &root_signature;
+    }
+
+    void TearDown() override
+    {
+        cgpu_free_queue(queue);
+        cgpu_free_device(device);
+        cgpu_free_instance(instance);
+    }
+
+    CGPUTextureId CreateTexture(const char8_t* name)
+    {
+        DECLARE_ZERO(CGPUTextureDescriptor, desc)
+        desc.name = name;
+        desc.format = CGPU_FORMAT_R8G8B8A8_UNORM;
+        desc.start_state = CGPU_RESOURCE_STATE_UNORDERED_ACCESS;
+        desc.descriptors = CGPU_RESOURCE_TYPE_TEXTURE | CGPU_RESOURCE_TYPE_RW_TEXTURE;
+        desc.width = 64;
+        desc.height = 64;
+        desc.depth = 1;
+        desc.array_size = 1;
+        desc.mip_levels = 1;
+        desc.sample_count = CGPU_SAMPLE_COUNT_1;
+        return cgpu_create_texture(device, &desc);
+    }
+
+    render_graph::RenderGraph* CreateGraph(bool memory_aliasing = false)
+    {
+        return render_graph::RenderGraph::create(
+        [this, memory_aliasing](render_graph::RenderGraphBuilder& builder) {
+            builder.with_device(device)
+                .with_gfx_queue(queue)
+                .backend_api(CGPU_BACKEND_NULL);
+            if (memory_aliasing) builder.enable_memory_aliasing();
+        });
+    }
+
+    // a transient source texture is read by a pass writing the imported target
+    void BuildFrame(render_graph::RenderGraph* graph, CGPUTextureId output, uint32_t extent = 64)
+    {
+        auto source = graph->create_texture(
+        [extent](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.set_name(u8"source")
+                .extent(extent, extent)
+                .format(CGPU_FORMAT_R8G8B8A8_UNORM);
+        });
+        auto target = graph->create_texture(
+        [output](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.set_name(u8"target")
+                .import(output, CGPU_RESOURCE_STATE_UNORDERED_ACCESS)
+                .allow_readwrite();
+        });
+        graph->add_compute_pass(
+        [this, source, target](render_graph::RenderGraph&, render_graph::ComputePassBuilder& builder) {
+            builder.set_name(u8"resolve_pass")
+                .set_pipeline(&pipeline)
+                .read(u8"source", source)
+                .readwrite(u8"target", target);
+        },
+        [](render_graph::RenderGraph&, render_graph::ComputePassContext&) {});
+    }
+
+    CGPUBufferId CreateBuffer(ECGPUMemoryUsage usage, uint64_t size, CGPUBufferCreationFlags flags = CGPU_BCF_NONE)
+    {
+        DECLARE_ZERO(CGPUBufferDescriptor, desc)
+        desc.name = u8"NullBuffer";
+        desc.flags = flags;
+        desc.descriptors = CGPU_RESOURCE_TYPE_BUFFER;
+        desc.memory_usage = usage;
+        desc.size = size;
+        return cgpu_create_buffer(device, &desc);
+    }
+
+    // copies the source through a chain of pooled buffers into the destination, one copy pass per link,
+    // the command buffer every pass was recorded to is kept in pass order
+    void BuildCopyChain(render_graph::RenderGraph* graph, uint32_t pass_count, CGPUBufferId source, CGPUBufferId destination,
+        eastl::vector<CGPUCommandBufferId>& pass_cmds)
+    {
+        pass_cmds.clear();
+        pass_cmds.resize(pass_count, nullptr);
+        const uint64_t size = source->size;
+        auto previous = graph->create_buffer(
+        [source](render_graph::RenderGraph&, render_graph::BufferBuilder& builder) {
+            builder.set_name(u8"chain_source")
+                .import(source, CGPU_RESOURCE_STATE_COPY_SOURCE);
+        });
+        for (uint32_t i = 0; i < pass_count; i++)
+        {
+            const bool last = (i == pass_count - 1);
+            auto next = graph->create_buffer(
+            [last, destination, size](render_graph::RenderGraph&, render_graph::BufferBuilder& builder) {
+                builder.set_name(last ? u8"chain_destination" : u8"chain_link");
+                if (last)
+                    builder.import(destination, CGPU_RESOURCE_STATE_COPY_DEST);
+                else // host visible so the null device carries the data through every link
+                    builder.size(size).memory_usage(CGPU_MEM_USAGE_GPU_ONLY).with_flags(CGPU_BCF_HOST_VISIBLE);
+            });
+            auto cmd = &pass_cmds[i];
+            graph->add_copy_pass(
+            [previous, next, size](render_graph::RenderGraph&, render_graph::CopyPassBuilder& builder) {
+                builder.set_name(u8"chain_pass")
+                    .buffer_to_buffer(previous.range(0, size), next.range(0, size));
+            },
+            [cmd](render_graph::RenderGraph&, render_graph::CopyPassContext& context) {
+                *cmd = context.cmd;
+            });
+            previous = next;
+        }
+    }
+
+    CGPUNullDeviceStatistics Statistics()
+    {
+        CGPUNullDeviceStatistics statistics = {};
+        cgpu_null_query_device_statistics(device, &statistics);
+        return statistics;
+    }
+
+    uint64_t DescriptorSetsUpdated()
+    {
+        return Statistics().descriptor_sets_updated;
+    }
+
+    CGPUInstanceId instance = nullptr;
+    CGPUAdapterId adapter = nullptr;
+    CGPUDeviceId device = nullptr;
+    CGPUQueueId queue = nullptr;
+    CGPUShaderResource resources[2] = {};
+    CGPUParameterTable table = {};
+    CGPURootSignature root_signature = {};
+    CGPUComputePipeline pipeline = {};
+};
+
+// the pool only compares handles, they never have to be valid views
+static CGPUTextureViewId FakeView(uint32_t i)
+{
+    return (CGPUTextureViewId)(uintptr_t)(0x1000 + i * 0x100);
+}
+
+static render_graph::BindTablePool::Bindings MakeBindings(const CGPUTextureViewId* views)
+{
+    render_graph::BindTablePool::Bindings bindings = {};
+    bindings.textures = views;
+    bindings.textures_count = 2;
+    return bindings;
+}
+
+static const char* kBindTableKeys = "source;target;";
+
+TEST_F(RenderGraphBackend, BindTablePoolHitsSameBindings)
+{
+    render_graph::BindTablePool pool(&root_signature);
+    const CGPUXName names[] = { u8"source", u8"target" };
+    const CGPUTextureViewId views[] = { FakeView(0), FakeView(1) };
+    bool needs_update = false;
+    auto first = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(views), 1, needs_update);
+    EXPECT_TRUE(needs_update);
+    auto second = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(views), 2, needs_update);
+    EXPECT_FALSE(needs_update);
+    EXPECT_EQ(first, second);
+    pool.destroy();
+}
+
+TEST_F(RenderGraphBackend, BindTablePoolMissesOtherBindings)
+{
+    render_graph::BindTablePool pool(&root_signature);
+    const CGPUXName names[] = { u8"source", u8"target" };
+    const CGPUTextureViewId views[] = { FakeView(0), FakeView(1) };
+    const CGPUTextureViewId swapped[] = { FakeView(1), FakeView(0) };
+    bool needs_update = false;
+    auto first = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(views), 1, needs_update);
+    auto other = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(swapped), 1, needs_update);
+    EXPECT_TRUE(needs_update);
+    EXPECT_NE(first, other);
+    // both stay cached
+    EXPECT_EQ(pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(views), 2, needs_update), first);
+    EXPECT_FALSE(needs_update);
+    EXPECT_EQ(pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(swapped), 2, needs_update), other);
+    EXPECT_FALSE(needs_update);
+    pool.destroy();
+}
+
+TEST_F(RenderGraphBackend, BindTablePoolEvictsLeastRecentlyUsed)
+{
+    const auto max_tables = render_graph::BindTablePool::kMaxCachedTables;
+    render_graph::BindTablePool pool(&root_signature);
+    const CGPUXName names[] = { u8"source", u8"target" };
+    eastl::vector<CGPUTextureViewId> views(2 * max_tables + 4);
+    for (uint32_t i = 0; i < views.size(); i++) views[i] = FakeView(i);
+    eastl::vector<CGPUXBindTableId> tables(max_tables);
+    bool needs_update = false;
+    // binding i is last used in frame i + 1
+    for (uint32_t i = 0; i < max_tables; i++)
+    {
+        tables[i] = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(&views[2 * i]), i + 1, needs_update);
+        EXPECT_TRUE(needs_update);
+    }
+    // a new binding takes the table of the oldest one over
+    const auto frame = max_tables + 1;
+    auto evicting = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(&views[2 * max_tables]), frame, needs_update);
+    EXPECT_TRUE(needs_update);
+    EXPECT_EQ(evicting, tables[0]);
+    // the evicted binding is written again, in the table of the next oldest
+    auto rewritten = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(&views[0]), frame, needs_update);
+    EXPECT_TRUE(needs_update);
+    EXPECT_EQ(rewritten, tables[1]);
+    // the most recent one is still there
+    auto kept = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(&views[2 * (max_tables - 1)]), frame, needs_update);
+    EXPECT_FALSE(needs_update);
+    EXPECT_EQ(kept, tables[max_tables - 1]);
+    // tables used this frame are never taken over, the block grows past the cap instead
+    for (uint32_t i = 2; i < max_tables - 1; i++)
+    {
+        pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(&views[2 * i]), frame, needs_update);
+        EXPECT_FALSE(needs_update);
+    }
+    auto grown = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(&views[2 * max_tables + 2]), frame, needs_update);
+    EXPECT_TRUE(needs_update);
+    for (auto table : tables) EXPECT_NE(grown, table);
+    pool.destroy();
+}
+
+TEST_F(RenderGraphBackend, BindTablePoolInvalidate)
+{
+    render_graph::BindTablePool pool(&root_signature);
+    const CGPUXName names[] = { u8"source", u8"target" };
+    const CGPUTextureViewId views[] = { FakeView(0), FakeView(1) };
+    bool needs_update = false;
+    pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(views), 1, needs_update);
+    pool.invalidate();
+    // the handles may belong to new views now, the table is written again
+    auto again = pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(views), 2, needs_update);
+    EXPECT_TRUE(needs_update);
+    EXPECT_EQ(pool.pop_cached(kBindTableKeys, names, 2, MakeBindings(views), 3, needs_update), again);
+    EXPECT_FALSE(needs_update);
+    pool.destroy();
+}
+
+TEST_F(RenderGraphBackend, BindTablesRewrittenAfterGarbageCollection)
+{
+    auto output = CreateTexture(u8"output");
+    auto graph = CreateGraph();
+    // the first frame of every executor writes its table, the frames after find it again
+    const auto frames_writing_tables = [&]() {
+        uint32_t writing = 0;
+        for (uint32_t i = 0; i < 2 * RG_MAX_FRAME_IN_FLIGHT; i++)
+        {
+            const auto updated = DescriptorSetsUpdated();
+            BuildFrame(graph, output);
+            graph->compile();
+            graph->execute();
+            if (DescriptorSetsUpdated() != updated)
+            {
+                EXPECT_LT(i, RG_MAX_FRAME_IN_FLIGHT);
+                writing++;
+            }
+        }
+        return writing;
+    };
+    EXPECT_EQ(frames_writing_tables(), RG_MAX_FRAME_IN_FLIGHT);
+    // the pooled source texture goes, its view may come back at the same address
+    EXPECT_GT(graph->collect_garbage(graph->get_frame_index() - 1), 0u);
+    EXPECT_EQ(frames_writing_tables(), RG_MAX_FRAME_IN_FLIGHT);
+
+    render_graph::RenderGraph::destroy(graph);
+    cgpu_free_texture(output);
+}
+
+TEST_F(RenderGraphBackend, TransientBindTablesLiveWithTheCompiledGraph)
+{
+    auto output = CreateTexture(u8"output");
+    auto graph = CreateGraph(true);
+    const auto frames_writing_tables = [&](uint32_t extent) {
+        uint32_t writing = 0;
+        for (uint32_t i = 0; i < 2 * RG_MAX_FRAME_IN_FLIGHT; i++)
+        {
+            const auto updated = DescriptorSetsUpdated();
+            BuildFrame(graph, output, extent);
+            graph->compile();
+            graph->execute();
+            if (DescriptorSetsUpdated() != updated) writing++;
+        }
+        return writing;
+    };
+    // placed textures are kept while the compiled graph stays the same
+    EXPECT_EQ(frames_writing_tables(64), RG_MAX_FRAME_IN_FLIGHT);
+    EXPECT_EQ(frames_writing_tables(64), 0u);
+    // another extent places new textures, the tables binding the old ones are written again
+    EXPECT_EQ(frames_writing_tables(128), RG_MAX_FRAME_IN_FLIGHT);
+
+    render_graph::RenderGraph::destroy(graph);
+    cgpu_free_texture(output);
+}
+
+// walks the command buffers in submit order, every barrier has to start from the state the last one left
+// and every copy has to find its buffers in the copy states
+static void ExpectConsistentBufferStates(const eastl::vector<CGPUCommandBufferId>& cmds)
+{
+    eastl::vector_map<CGPUBufferId, ECGPUResourceState> states;
+    uint32_t copies = 0;
+    for (auto cmd : cmds)
+    {
+        for (auto command = cgpu_null_command_buffer_first(cmd); command; command = cgpu_null_command_buffer_next(cmd, command))
+        {
+            if (command->type == CGPU_NULL_COMMAND_RESOURCE_BARRIER)
+            {
+                const auto B = (const CGPUNullCmdResourceBarrier*)command;
+                const auto barriers = (const CGPUBufferBarrier*)(B + 1);
+                for (uint32_t i = 0; i < B->buffer_barriers_count; i++)
+                {
+                    auto found = states.find(barriers[i].buffer);
+                    if (found != states.end()) EXPECT_EQ(found->second, barriers[i].src_state);
+                    states[barriers[i].buffer] = barriers[i].dst_state;
+                }
+            }
+            else if (command->type == CGPU_NULL_COMMAND_TRANSFER_BUFFER_TO_BUFFER)
+            {
+                const auto& transfer = ((const CGPUNullCmdTransferBufferToBuffer*)command)->transfer;
+                auto src = states.find(transfer.src);
+                auto dst = states.find(transfer.dst);
+                if (src != states.end()) EXPECT_EQ(src->second, CGPU_RESOURCE_STATE_COPY_SOURCE);
+                if (dst != states.end()) EXPECT_EQ(dst->second, CGPU_RESOURCE_STATE_COPY_DEST);
+                copies++;
+            }
+        }
+    }
+    EXPECT_GT(copies, 0u);
+}
+
+TEST_F(RenderGraphBackend, ParallelRecordingSplitsLongFrames)
+{
+    skr::task::scheduler_t scheduler;
+    scheduler.initialize(skr::task::scheudler_config_t{});
+    scheduler.bind();
+    const uint32_t pass_count = 20;
+    const uint32_t count = 64;
+    auto source = CreateBuffer(CGPU_MEM_USAGE_CPU_ONLY, count * sizeof(uint32_t), CGPU_BCF_PERSISTENT_MAP_BIT);
+    auto destination = CreateBuffer(CGPU_MEM_USAGE_GPU_TO_CPU, count * sizeof(uint32_t), CGPU_BCF_PERSISTENT_MAP_BIT);
+    auto serial = CreateGraph();
+    auto parallel = render_graph::RenderGraph::create(
+    [this](render_graph::RenderGraphBuilder& builder) {
+        builder.with_device(device)
+            .with_gfx_queue(queue)
+            .backend_api(CGPU_BACKEND_NULL)
+            .enable_parallel_recording(4);
+    });
+    eastl::vector<CGPUCommandBufferId> pass_cmds;
+    for (uint32_t frame = 0; frame < 2; frame++)
+    {
+        for (uint32_t i = 0; i < count; i++)
+            ((uint32_t*)source->cpu_mapped_address)[i] = i + frame * 1000;
+
+        // the same chain recorded on this thread alone is the reference
+        auto before = Statistics();
+        BuildCopyChain(serial, pass_count, source, destination, pass_cmds);
+        serial->compile();
+        serial->execute();
+        auto serial_stats = Statistics();
+        EXPECT_EQ(serial_stats.command_buffers_submitted - before.command_buffers_submitted, 1u);
+        for (auto cmd : pass_cmds) EXPECT_EQ(cmd, pass_cmds.front());
+        memset(destination->cpu_mapped_address, 0, count * sizeof(uint32_t));
+
+        BuildCopyChain(parallel, pass_count, source, destination, pass_cmds);
+        parallel->compile();
+        parallel->execute();
+        auto parallel_stats = Statistics();
+        // 20 passes are more than one segment holds, they go to two contiguous runs submitted at once
+        EXPECT_EQ(parallel_stats.submits - serial_stats.submits, 1u);
+        EXPECT_EQ(parallel_stats.command_buffers_submitted - serial_stats.command_buffers_submitted, 2u);
+        eastl::vector<CGPUCommandBufferId> segment_cmds;
+        for (auto cmd : pass_cmds)
+        {
+            if (segment_cmds.empty() || segment_cmds.back() != cmd) segment_cmds.emplace_back(cmd);
+        }
+        ASSERT_EQ(segment_cmds.size(), 2u);
+        EXPECT_EQ(pass_cmds[pass_count / 2 - 1], segment_cmds[0]);
+        EXPECT_EQ(pass_cmds[pass_count / 2], segment_cmds[1]);
+        // no barrier is lost or doubled at the segment edge
+        EXPECT_EQ(parallel_stats.buffer_barriers - serial_stats.buffer_barriers, serial_stats.buffer_barriers - before.buffer_barriers);
+        ExpectConsistentBufferStates(segment_cmds);
+        // the copies ran in pass order, the links still hold the last frame otherwise
+        const auto values = (const uint32_t*)destination->cpu_mapped_address;
+        for (uint32_t i = 0; i < count; i++)
+            EXPECT_EQ(values[i], i + frame * 1000);
+    }
+    render_graph::RenderGraph::destroy(parallel);
+    render_graph::RenderGraph::destroy(serial);
+    cgpu_free_buffer(destination);
+    cgpu_free_buffer(source);
+    scheduler.unbind();
+}
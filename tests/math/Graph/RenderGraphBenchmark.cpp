@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "SkrRenderGraph/frontend/render_graph.hpp"
+#include <chrono>
+#include <iostream>
+
+namespace render_graph = skr::render_graph;
+
+// records a chain of render passes, each one reads the target written by the previous pass
+static void build_chain(render_graph::RenderGraph* graph, uint32_t pass_count)
+{
+    auto last = graph->create_texture(
+    [](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+        builder.set_name(u8"chain_source")
+        .allow_render_target()
+        .format(CGPU_FORMAT_B8G8R8A8_UNORM);
+    });
+    for (uint32_t i = 0; i < pass_count; i++)
+    {
+        auto target = graph->create_texture(
+        [](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.set_name(u8"chain_target")
+            .allow_render_target()
+            .format(CGPU_FORMAT_B8G8R8A8_UNORM);
+        });
+        graph->add_render_pass(
+        [=](render_graph::RenderGraph&, render_graph::RenderPassBuilder& builder) {
+            builder.set_name(u8"chain_pass")
+            .read(u8"Source", last)
+            .write(0, target);
+        },
+        render_graph::RenderPassExecuteFunction());
+        last = target;
+    }
+    // the chain ends in an imported target, otherwise compile() culls all of it
+    static CGPUTexture imported = {};
+    imported.width = 1920;
+    imported.height = 1080;
+    imported.depth = 1;
+    imported.sample_count = CGPU_SAMPLE_COUNT_1;
+    imported.format = CGPU_FORMAT_B8G8R8A8_UNORM;
+    auto back_buffer = graph->create_texture(
+    [](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+        builder.set_name(u8"backbuffer")
+        .import(&imported, CGPU_RESOURCE_STATE_UNDEFINED);
+    });
+    graph->add_render_pass(
+    [=](render_graph::RenderGraph&, render_graph::RenderPassBuilder& builder) {
+        builder.set_name(u8"chain_resolve")
+        .read(u8"Source", last)
+        .write(0, back_buffer);
+    },
+    render_graph::RenderPassExecuteFunction());
+}
+
+TEST(RenderGraphBenchmark, FrontEndFrame)
+{
+    static constexpr uint32_t kPassCount = 500;
+    static constexpr uint32_t kWarmupFrames = 8;
+    static constexpr uint32_t kMeasuredFrames = 64;
+
+    auto graph = render_graph::RenderGraph::create(
+    [](render_graph::RenderGraphBuilder& builder) {
+        builder.frontend_only();
+    });
+    // the first frames grow the arena and the topology arrays and compile the structure once, later frames reuse both
+    for (uint32_t i = 0; i < kWarmupFrames; i++)
+    {
+        build_chain(graph, kPassCount);
+        graph->compile();
+        graph->execute();
+    }
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < kMeasuredFrames; i++)
+    {
+        build_chain(graph, kPassCount);
+        graph->compile();
+        graph->execute();
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double avg_us = std::chrono::duration<double, std::micro>(end - start).count() / kMeasuredFrames;
+    std::cout << "render graph frontend, " << kPassCount << " passes: " << avg_us << "us/frame" << std::endl;
+    render_graph::RenderGraph::destroy(graph);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -29,3 +29,19 @@ target("GraphTest")
     public_dependency("SkrRenderGraph", engine_version)
     add_packages("gtest")
     add_files("Graph/Graph.cpp")
+
+target("RenderGraphBenchmark")
+    set_group("05.tests/base")
+    set_kind("binary")
+    public_dependency("SkrRT", engine_version)
+    public_dependency("SkrRenderGraph", engine_version)
+    add_packages("gtest")
+    add_files("Graph/RenderGraphBenchmark.cpp")
+
+target("RenderGraphBackendTest")
+    set_group("05.tests/base")
+    set_kind("binary")
+    public_dependency("SkrRT", engine_version)
+    public_dependency("SkrRenderGraph", engine_version)
+    add_packages("gtest")
+    add_files("Graph/RenderGraphBackend.cpp")
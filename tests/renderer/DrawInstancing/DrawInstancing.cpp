@@ -0,0 +1,247 @@
+#include "gtest/gtest.h"
+#include "cgpu/api.h"
+#include "cgpu/backend/null/cgpu_null.h"
+#include "SkrRenderer/draw_instancing.hpp"
+#include <vector>
+
+class DrawInstancing : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        instance = cgpu_create_instance(&desc);
+        uint32_t adapters_count = 1;
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+
+        CGPUQueueGroupDescriptor G = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        DECLARE_ZERO(CGPUDeviceDescriptor, descriptor)
+        descriptor.queue_groups = &G;
+        descriptor.queue_group_count = 1;
+        device = cgpu_create_device(adapter, &descriptor);
+        queue = cgpu_get_queue(device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
+        DECLARE_ZERO(CGPUCommandPoolDescriptor, pool_desc)
+        pool = cgpu_create_command_pool(queue, &pool_desc);
+        DECLARE_ZERO(CGPUCommandBufferDescriptor, cmd_desc)
+        cmd = cgpu_create_command_buffer(pool, &cmd_desc);
+
+        // two meshes sharing one vertex buffer, with one index range each
+        DECLARE_ZERO(CGPUBufferDescriptor, buffer_desc)
+        buffer_desc.name = u8"MeshBuffer";
+        buffer_desc.descriptors = CGPU_RESOURCE_TYPE_VERTEX_BUFFER | CGPU_RESOURCE_TYPE_INDEX_BUFFER;
+        buffer_desc.memory_usage = CGPU_MEM_USAGE_GPU_ONLY;
+        buffer_desc.size = 4096;
+        mesh_buffer = cgpu_create_buffer(device, &buffer_desc);
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            vbvs[i] = { mesh_buffer, 0, 12 };
+            ibvs[i] = { mesh_buffer, 2048, 4, 36, i * 36 };
+        }
+        instancer.initialize(device, 3);
+    }
+
+    void TearDown() override
+    {
+        instancer.finalize();
+        cgpu_free_buffer(mesh_buffer);
+        cgpu_free_command_buffer(cmd);
+        cgpu_free_command_pool(pool);
+        cgpu_free_queue(queue);
+        cgpu_free_device(device);
+        cgpu_free_instance(instance);
+    }
+
+    // per-instance payload of the draw is its index in the scene
+    skr_primitive_draw_t MakeDraw(uint32_t mesh, CGPURenderPipelineId pipeline)
+    {
+        skr_primitive_draw_t draw = {};
+        draw.pipeline = pipeline;
+        draw.vertex_buffers = &vbvs[mesh];
+        draw.vertex_buffer_count = 1;
+        draw.index_buffer = ibvs[mesh];
+        draw.instance_data = (const uint8_t*)&payloads[payload_count];
+        draw.instance_data_size = sizeof(uint32_t);
+        payloads[payload_count] = payload_count;
+        payload_count++;
+        return draw;
+    }
+
+    void Record(const skr_primitive_draw_list_view_t& list)
+    {
+        cgpu_cmd_begin(cmd);
+        DECLARE_ZERO(CGPURenderPassDescriptor, pass_desc)
+        pass_desc.name = u8"InstancedPass";
+        pass_desc.sample_count = CGPU_SAMPLE_COUNT_1;
+        auto encoder = cgpu_cmd_begin_render_pass(cmd, &pass_desc);
+        for (uint32_t i = 0; i < list.count; i++)
+        {
+            const auto& dc = list.drawcalls[i];
+            CGPUBufferId buffers[2] = { dc.vertex_buffers[0].buffer, dc.instance_buffer.buffer };
+            uint32_t strides[2] = { dc.vertex_buffers[0].stride, dc.instance_buffer.stride };
+            uint32_t offsets[2] = { dc.vertex_buffers[0].offset, dc.instance_buffer.offset };
+            cgpu_render_encoder_bind_vertex_buffers(encoder, dc.instance_buffer.buffer ? 2 : 1, buffers, strides, offsets);
+            cgpu_render_encoder_bind_index_buffer(encoder, dc.index_buffer.buffer, dc.index_buffer.stride, dc.index_buffer.offset);
+            cgpu_render_encoder_draw_indexed_instanced(encoder, dc.index_buffer.index_count, dc.index_buffer.first_index, dc.instance_count ? dc.instance_count : 1, 0, 0);
+        }
+        cgpu_cmd_end_render_pass(cmd, encoder);
+        cgpu_cmd_end(cmd);
+        DECLARE_ZERO(CGPUQueueSubmitDescriptor, submit)
+        submit.cmds = &cmd;
+        submit.cmds_count = 1;
+        cgpu_submit_queue(queue, &submit);
+    }
+
+    CGPUInstanceId instance;
+    CGPUAdapterId adapter;
+    CGPUDeviceId device;
+    CGPUQueueId queue;
+    CGPUCommandPoolId pool;
+    CGPUCommandBufferId cmd;
+    CGPUBufferId mesh_buffer;
+    skr_vertex_buffer_view_t vbvs[2];
+    skr_index_buffer_view_t ibvs[2];
+    uint32_t payloads[1024];
+    uint32_t payload_count = 0;
+    skr::renderer::DrawInstancer instancer;
+};
+
+TEST_F(DrawInstancing, MergesCompatibleDraws)
+{
+    const auto pipeline = (CGPURenderPipelineId)0x100;
+    std::vector<skr_primitive_draw_t> draws;
+    for (uint32_t i = 0; i < 100; i++)
+        draws.emplace_back(MakeDraw(i % 2, pipeline));
+    // no payload, left as it is
+    draws.emplace_back(MakeDraw(0, pipeline)).instance_data = nullptr;
+    // another pipeline does not merge with the rest
+    draws.emplace_back(MakeDraw(0, (CGPURenderPipelineId)0x200));
+
+    skr_primitive_draw_list_view_t list = { draws.data(), (uint32_t)draws.size(), nullptr };
+    skr_primitive_draw_list_view_t* lists[] = { &list };
+    instancer.begin_frame(0);
+    EXPECT_EQ(instancer.coalesce(lists), 98u);
+    ASSERT_EQ(list.count, 4u);
+
+    const uint32_t expected_counts[] = { 50, 50, 0, 1 };
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        const auto& draw = list.drawcalls[i];
+        EXPECT_EQ(draw.instance_count, expected_counts[i]);
+        if (!draw.instance_count)
+        {
+            EXPECT_EQ(draw.instance_buffer.buffer, nullptr);
+            continue;
+        }
+        EXPECT_EQ(draw.instance_buffer.buffer, instancer.get_frame_buffer());
+        EXPECT_EQ(draw.instance_buffer.stride, sizeof(uint32_t));
+        EXPECT_EQ(draw.instance_buffer.offset % 16, 0u);
+    }
+    EXPECT_EQ(list.drawcalls[0].index_buffer.first_index, 0u);
+    EXPECT_EQ(list.drawcalls[1].index_buffer.first_index, 36u);
+
+    // payloads of a merged draw keep the order of the draws they came from
+    const auto mapped = (const uint8_t*)instancer.get_frame_buffer()->cpu_mapped_address;
+    for (uint32_t mesh = 0; mesh < 2; mesh++)
+    {
+        const auto instances = (const uint32_t*)(mapped + list.drawcalls[mesh].instance_buffer.offset);
+        for (uint32_t i = 0; i < 50; i++)
+            EXPECT_EQ(instances[i], i * 2 + mesh);
+    }
+    EXPECT_EQ(*(const uint32_t*)(mapped + list.drawcalls[3].instance_buffer.offset), 101u);
+}
+
+TEST_F(DrawInstancing, SubmitsFewerDraws)
+{
+    const auto pipeline = (CGPURenderPipelineId)0x100;
+    std::vector<skr_primitive_draw_t> draws;
+    for (uint32_t i = 0; i < 1000; i++)
+        draws.emplace_back(MakeDraw(i % 2, pipeline));
+    skr_primitive_draw_list_view_t list = { draws.data(), (uint32_t)draws.size(), nullptr };
+    skr_primitive_draw_list_view_t* lists[] = { &list };
+    instancer.begin_frame(0);
+    instancer.coalesce(lists);
+    Record(list);
+
+    DECLARE_ZERO(CGPUNullDeviceStatistics, stats)
+    cgpu_null_query_device_statistics(device, &stats);
+    EXPECT_EQ(stats.draws, 2u);
+    uint32_t instances = 0;
+    for (auto command = cgpu_null_command_buffer_first(cmd); command; command = cgpu_null_command_buffer_next(cmd, command))
+    {
+        if (command->type != CGPU_NULL_COMMAND_DRAW) continue;
+        auto draw = (const CGPUNullCmdDraw*)command;
+        EXPECT_TRUE(draw->indexed);
+        instances += draw->instance_count;
+    }
+    EXPECT_EQ(instances, 1000u);
+}
+
+TEST_F(DrawInstancing, ListsWithoutPayloadsAreLeftAlone)
+{
+    const auto pipeline = (CGPURenderPipelineId)0x100;
+    skr_primitive_draw_t draws[3] = { MakeDraw(0, pipeline), MakeDraw(0, pipeline), MakeDraw(1, pipeline) };
+    for (auto& draw : draws)
+    {
+        draw.instance_data = nullptr;
+    }
+    draws[2].instance_data = (const uint8_t*)&payloads[2];
+    draws[2].desperated = true;
+    skr_primitive_draw_list_view_t list = { draws, 3, nullptr };
+    skr_primitive_draw_list_view_t* lists[] = { &list };
+    // nothing for the renderer to wait for
+    EXPECT_FALSE(skr::renderer::DrawInstancer::has_payloads(lists));
+    instancer.begin_frame(0);
+    EXPECT_EQ(instancer.coalesce(lists), 0u);
+    EXPECT_EQ(list.count, 3u);
+    EXPECT_EQ(instancer.get_frame_buffer(), nullptr);
+
+    draws[2].desperated = false;
+    EXPECT_TRUE(skr::renderer::DrawInstancer::has_payloads(lists));
+}
+
+TEST_F(DrawInstancing, FramesUseTheirOwnBuffers)
+{
+    const auto pipeline = (CGPURenderPipelineId)0x100;
+    CGPUBufferId frame_buffers[4] = {};
+    for (uint32_t frame = 0; frame < 4; frame++)
+    {
+        skr_primitive_draw_t draws[2] = { MakeDraw(0, pipeline), MakeDraw(0, pipeline) };
+        skr_primitive_draw_list_view_t list = { draws, 2, nullptr };
+        skr_primitive_draw_list_view_t* lists[] = { &list };
+        instancer.begin_frame(frame);
+        EXPECT_EQ(instancer.coalesce(lists), 1u);
+        frame_buffers[frame] = draws[0].instance_buffer.buffer;
+    }
+    EXPECT_NE(frame_buffers[0], frame_buffers[1]);
+    EXPECT_NE(frame_buffers[1], frame_buffers[2]);
+    EXPECT_EQ(frame_buffers[0], frame_buffers[3]);
+}
+
+TEST_F(DrawInstancing, FramesInFlightKeepTheirPayloads)
+{
+    const auto pipeline = (CGPURenderPipelineId)0x100;
+    // frames 7 and 8 are in flight together and use the buffers of their executors, frame 10 reuses the one of frame 7
+    const uint64_t frame_indices[3] = { 7, 8, 10 };
+    CGPUBufferId frame_buffers[3] = {};
+    uint32_t frame_payloads[3] = {};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        skr_primitive_draw_t draws[2] = { MakeDraw(0, pipeline), MakeDraw(0, pipeline) };
+        skr_primitive_draw_list_view_t list = { draws, 2, nullptr };
+        skr_primitive_draw_list_view_t* lists[] = { &list };
+        instancer.begin_frame(frame_indices[i]);
+        EXPECT_EQ(instancer.coalesce(lists), 1u);
+        frame_buffers[i] = draws[0].instance_buffer.buffer;
+        frame_payloads[i] = *(const uint32_t*)((const uint8_t*)frame_buffers[i]->cpu_mapped_address + draws[0].instance_buffer.offset);
+        if (i == 1)
+        {
+            // packing frame 8 left the payloads frame 7 is still reading alone
+            const auto mapped = (const uint8_t*)frame_buffers[0]->cpu_mapped_address;
+            EXPECT_EQ(*(const uint32_t*)mapped, frame_payloads[0]);
+        }
+    }
+    EXPECT_NE(frame_buffers[0], frame_buffers[1]);
+    EXPECT_EQ(frame_buffers[0], frame_buffers[2]);
+    EXPECT_NE(frame_payloads[0], frame_payloads[1]);
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "SkrRenderer/draw_sort.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+class DrawSort : public ::testing::Test
+{
+protected:
+    // first_index tags every draw with its position before the sort
+    void make_draws(const std::vector<uint64_t>& keys)
+    {
+        draws.assign(keys.size(), {});
+        for (uint32_t i = 0; i < keys.size(); i++)
+        {
+            draws[i].sort_key = keys[i];
+            draws[i].index_buffer.first_index = i;
+        }
+        list = { draws.data(), (uint32_t)draws.size(), nullptr };
+    }
+
+    // what a stable sort by key produces, as original positions
+    std::vector<uint32_t> stable_order(const std::vector<uint64_t>& keys)
+    {
+        std::vector<uint32_t> order(keys.size());
+        for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+        return order;
+    }
+
+    void expect_order(const std::vector<uint32_t>& order)
+    {
+        ASSERT_EQ(list.count, order.size());
+        for (uint32_t i = 0; i < order.size(); i++)
+        {
+            ASSERT_EQ(draws[i].index_buffer.first_index, order[i]) << "at " << i;
+        }
+    }
+
+    std::vector<skr_primitive_draw_t> draws;
+    skr_primitive_draw_list_view_t list = {};
+    skr::renderer::DrawListSorter sorter;
+};
+
+TEST_F(DrawSort, OrdersByKey)
+{
+    const std::vector<uint64_t> keys = { 0x9001, 0x0301, 0xff00000000000001, 0x0201, 0x0100000000000001, 0x0003 };
+    make_draws(keys);
+    EXPECT_TRUE(sorter.sort(list));
+    expect_order({ 5, 3, 1, 0, 4, 2 });
+}
+
+TEST_F(DrawSort, KeepsTheOrderOfEqualKeys)
+{
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> keys(1000);
+    // few distinct keys spread over every digit, so most draws share their key with others
+    for (auto& key : keys) key = ((rng() % 16) * 0x0101010101010101ull) | 1;
+    make_draws(keys);
+    EXPECT_TRUE(sorter.sort(list));
+    expect_order(stable_order(keys));
+}
+
+TEST_F(DrawSort, SortsKeysThatOnlyDifferInTheTopDigit)
+{
+    std::vector<uint64_t> keys;
+    for (uint64_t i = 0; i < 300; i++) keys.push_back(((255 - i % 256) << 56) | 1);
+    make_draws(keys);
+    EXPECT_TRUE(sorter.sort(list));
+    expect_order(stable_order(keys));
+}
+
+TEST_F(DrawSort, SortsListsLargerThan16Bits)
+{
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> keys(100000);
+    for (auto& key : keys) key = skr::renderer::make_draw_sort_key((void*)(uintptr_t)(rng() % 64 + 1),
+        (void*)(uintptr_t)(rng() % 512 + 1), (uint32_t)(rng() % 8), (float)(rng() % 1000) / 1000.f);
+    make_draws(keys);
+    EXPECT_TRUE(sorter.sort(list));
+    expect_order(stable_order(keys));
+
+    // the sorter reuses its scratch for a second, shorter list
+    keys.resize(70000);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    make_draws(keys);
+    EXPECT_TRUE(sorter.sort(list));
+    expect_order(stable_order(keys));
+}
+
+TEST_F(DrawSort, LeavesListsWithUnkeyedDrawsAlone)
+{
+    const std::vector<uint64_t> keys = { 5, 3, 0, 1 };
+    make_draws(keys);
+    EXPECT_FALSE(sorter.sort(list));
+    expect_order({ 0, 1, 2, 3 });
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    auto result = RUN_ALL_TESTS();
+    return result;
+}
@@ -0,0 +1,192 @@
+#include "gtest/gtest.h"
+#include "SkrRenderer/culling.hpp"
+#include "rtm/rtmx.h"
+#include <chrono>
+#include <iostream>
+#include <math.h>
+#include <random>
+#include <vector>
+
+using namespace skr::renderer;
+
+class FrustumCulling : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // the camera the viewports resolve: looking down +y with z up, 90 degrees vertical fov, depth from 1 to 1000
+        const auto eye = rtm::vector_set(0.f, 0.f, 0.f);
+        const auto view = rtm::look_at_matrix(eye, rtm::vector_set(0.f, 1.f, 0.f), rtm::vector_set(0.f, 0.f, 1.f));
+        const auto proj = rtm::perspective_fov(3.1415926f / 2.f, 16.f / 9.f, 1.f, 1000.f);
+        const auto view_projection = rtm::matrix_mul(view, proj);
+        frustum = Frustum::from_view_projection(*(const skr_float4x4_t*)&view_projection);
+    }
+
+    std::vector<skr_world_bounds_comp_t> RandomBoxes(uint32_t count, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-1200.f, 1200.f);
+        std::uniform_real_distribution<float> size(0.1f, 20.f);
+        std::vector<skr_world_bounds_comp_t> boxes(count);
+        for (auto& box : boxes)
+        {
+            box.center = { position(rng), position(rng), position(rng) };
+            box.extent = { size(rng), size(rng), size(rng) };
+        }
+        return boxes;
+    }
+
+    // smallest distance of the farthest corner of the box to the planes, boxes close to 0 may go either way
+    float Margin(const skr_world_bounds_comp_t& box)
+    {
+        float margin = INFINITY;
+        for (const auto& plane : frustum.planes)
+        {
+            const float distance = plane.x * box.center.x + plane.y * box.center.y + plane.z * box.center.z + plane.w;
+            const float radius = fabsf(plane.x) * box.extent.x + fabsf(plane.y) * box.extent.y + fabsf(plane.z) * box.extent.z;
+            margin = fminf(margin, fabsf(distance + radius));
+        }
+        return margin;
+    }
+
+    Frustum frustum;
+};
+
+TEST_F(FrustumCulling, KnownBoxes)
+{
+    const skr_world_bounds_comp_t boxes[] = {
+        { { 0.f, 50.f, 0.f }, { 1.f, 1.f, 1.f } },     // straight ahead
+        { { 0.f, -50.f, 0.f }, { 1.f, 1.f, 1.f } },    // behind the eye
+        { { 0.f, 2000.f, 0.f }, { 1.f, 1.f, 1.f } },   // past the far plane
+        { { 0.f, 0.5f, 0.f }, { .2f, .2f, .2f } },     // in front of the near plane
+        { { 0.f, 50.f, 200.f }, { 1.f, 1.f, 1.f } },   // above the top plane
+        { { 0.f, 50.f, 50.5f }, { 1.f, 1.f, 1.f } },   // crossing the top plane
+        { { -500.f, 50.f, 0.f }, { 1.f, 1.f, 1.f } },  // left of the left plane
+        { { -88.f, 50.f, 0.f }, { 1.f, 1.f, 1.f } },   // just inside on the left, the half width is 50 * 16 / 9
+    };
+    const bool expected[] = { true, false, false, false, false, true, false, true };
+    const uint32_t count = sizeof(boxes) / sizeof(boxes[0]);
+    uint32_t visibility[1] = { ~0u };
+    cull_world_bounds(frustum, boxes, count, visibility);
+    for (uint32_t i = 0; i < count; i++)
+        EXPECT_EQ(is_visible(visibility, i), expected[i]) << "box " << i;
+    EXPECT_EQ(visibility[0] >> count, 0u);
+}
+
+TEST_F(FrustumCulling, KernelMatchesScalarTest)
+{
+    // odd counts run the SIMD blocks and the scalar tail
+    for (uint32_t count : { 1u, 7u, 33u, 1000u, 4099u })
+    {
+        const auto boxes = RandomBoxes(count, count);
+        std::vector<uint32_t> visibility(visibility_words(count), ~0u);
+        cull_world_bounds(frustum, boxes.data(), count, visibility.data());
+        uint32_t visible_count = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            bool visible = true;
+            for (const auto& plane : frustum.planes)
+            {
+                float d = plane.x * boxes[i].center.x + plane.w;
+                d += plane.y * boxes[i].center.y;
+                d += plane.z * boxes[i].center.z;
+                d += fabsf(plane.x) * boxes[i].extent.x;
+                d += fabsf(plane.y) * boxes[i].extent.y;
+                d += fabsf(plane.z) * boxes[i].extent.z;
+                visible &= (d >= 0.f);
+            }
+            EXPECT_EQ(is_visible(visibility.data(), i), visible) << "box " << i << " of " << count;
+            visible_count += visible ? 1 : 0;
+        }
+        if (count >= 1000)
+        {
+            EXPECT_GT(visible_count, 0u);
+            EXPECT_LT(visible_count, count);
+        }
+    }
+}
+
+TEST_F(FrustumCulling, BVHMatchesKernel)
+{
+    const uint32_t count = 5000;
+    auto boxes = RandomBoxes(count, 42);
+    BoundsBVH bvh;
+    std::vector<uint32_t> leaves(count);
+    for (uint32_t i = 0; i < count; i++)
+        leaves[i] = bvh.insert(boxes[i], i);
+    EXPECT_EQ(bvh.get_leaf_count(), count);
+
+    const auto check = [&]() {
+        std::vector<uint32_t> expected(visibility_words(count));
+        std::vector<uint32_t> culled(visibility_words(count), 0u);
+        cull_world_bounds(frustum, boxes.data(), count, expected.data());
+        bvh.cull(frustum, culled.data());
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (leaves[i] == BoundsBVH::kInvalid)
+                EXPECT_FALSE(is_visible(culled.data(), i));
+            else if (Margin(boxes[i]) > 1e-3f)
+                EXPECT_EQ(is_visible(culled.data(), i), is_visible(expected.data(), i)) << "box " << i;
+        }
+    };
+    check();
+
+    // move a tenth of the boxes, the tree follows after the refit
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> offset(-300.f, 300.f);
+    for (uint32_t i = 0; i < count; i += 10)
+    {
+        boxes[i].center.x += offset(rng);
+        boxes[i].center.y += offset(rng);
+        bvh.update(leaves[i], boxes[i]);
+    }
+    bvh.refit();
+    check();
+
+    // and drop some
+    for (uint32_t i = 5; i < count; i += 7)
+    {
+        bvh.remove(leaves[i]);
+        leaves[i] = BoundsBVH::kInvalid;
+    }
+    check();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (leaves[i] != BoundsBVH::kInvalid) bvh.remove(leaves[i]);
+    }
+    EXPECT_EQ(bvh.get_leaf_count(), 0u);
+    EXPECT_EQ(bvh.get_root(), BoundsBVH::kInvalid);
+}
+
+TEST_F(FrustumCulling, Benchmark)
+{
+    static constexpr uint32_t kBoxCount = 100000;
+    static constexpr uint32_t kRuns = 32;
+    const auto boxes = RandomBoxes(kBoxCount, 1);
+    std::vector<uint32_t> visibility(visibility_words(kBoxCount));
+
+    BoundsBVH bvh;
+    for (uint32_t i = 0; i < kBoxCount; i++)
+        bvh.insert(boxes[i], i);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t run = 0; run < kRuns; run++)
+        cull_world_bounds(frustum, boxes.data(), kBoxCount, visibility.data());
+    const auto mid = std::chrono::high_resolution_clock::now();
+    for (uint32_t run = 0; run < kRuns; run++)
+    {
+        std::fill(visibility.begin(), visibility.end(), 0u);
+        bvh.cull(frustum, visibility.data());
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double kernel_us = std::chrono::duration<double, std::micro>(mid - start).count() / kRuns;
+    const double bvh_us = std::chrono::duration<double, std::micro>(end - mid).count() / kRuns;
+    std::cout << "frustum culling, " << kBoxCount << " boxes: kernel " << kernel_us << "us, bvh " << bvh_us << "us" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,360 @@
+#include "gtest/gtest.h"
+#include "cgpu/api.h"
+#include "cgpu/backend/null/cgpu_null.h"
+#include "SkrRenderer/pso_map.h"
+#include "platform/vfs.h"
+#include "task/task.hpp"
+#include <string.h>
+#include <vector>
+
+class PSOWarmup : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        scheduler.initialize(skr::task::scheudler_config_t{});
+        scheduler.bind();
+
+        DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        instance = cgpu_create_instance(&desc);
+        EXPECT_NE(instance, CGPU_NULLPTR);
+        uint32_t adapters_count = 1;
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+        CGPUQueueGroupDescriptor G = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        DECLARE_ZERO(CGPUDeviceDescriptor, descriptor)
+        descriptor.queue_groups = &G;
+        descriptor.queue_group_count = 1;
+        device = cgpu_create_device(adapter, &descriptor);
+        EXPECT_NE(device, CGPU_NULLPTR);
+
+        for (uint32_t i = 0; i < kShaderCount; i++)
+        {
+            DECLARE_ZERO(CGPUShaderLibraryDescriptor, lib_desc)
+            lib_desc.name = u8"NullShader";
+            libraries[i] = cgpu_create_shader_library(device, &lib_desc);
+        }
+        for (uint32_t i = 0; i < kMaterialCount; i++)
+        {
+            CGPUShaderEntryDescriptor shaders[2];
+            FillShaders(i, shaders);
+            DECLARE_ZERO(CGPURootSignatureDescriptor, rs_desc)
+            rs_desc.shaders = shaders;
+            rs_desc.shader_count = 2;
+            root_signatures[i] = cgpu_create_root_signature(device, &rs_desc);
+        }
+        pso_map = CreateMap();
+    }
+
+    void TearDown() override
+    {
+        skr_pso_map_free(pso_map);
+        for (auto rs : root_signatures) cgpu_free_root_signature(rs);
+        for (auto library : libraries) cgpu_free_shader_library(library);
+        cgpu_free_device(device);
+        cgpu_free_instance(instance);
+        scheduler.unbind();
+    }
+
+    skr_pso_map_id CreateMap()
+    {
+        // no aux service, installs outside of the warm up create their psos right away
+        skr_pso_map_root_t root = {};
+        root.device = device;
+        return skr_pso_map_create(&root);
+    }
+
+    // material i is made of the vertex shader i and the fragment shader i + 1
+    static skr_platform_shader_identifier_t Identifier(uint32_t shader)
+    {
+        skr_platform_shader_identifier_t identifier = {};
+        identifier.bytecode_type = CGPU_SHADER_BYTECODE_TYPE_SPIRV;
+        identifier.shader_stage = (shader % 2) ? CGPU_SHADER_STAGE_FRAG : CGPU_SHADER_STAGE_VERT;
+        identifier.hash.encoded_digits[0] = 0x1000 + shader;
+        return identifier;
+    }
+
+    void FillShaders(uint32_t material, CGPUShaderEntryDescriptor* shaders)
+    {
+        shaders[0] = {};
+        shaders[0].library = libraries[2 * material];
+        shaders[0].entry = u8"vert_main";
+        shaders[0].stage = CGPU_SHADER_STAGE_VERT;
+        shaders[1] = {};
+        shaders[1].library = libraries[2 * material + 1];
+        shaders[1].entry = u8"frag_main";
+        shaders[1].stage = CGPU_SHADER_STAGE_FRAG;
+    }
+
+    skr_pso_map_key_id CreateKey(skr_pso_map_id map, uint32_t material, bool with_shaders = true)
+    {
+        CGPUShaderEntryDescriptor shaders[2];
+        FillShaders(material, shaders);
+        const skr_platform_shader_identifier_t identifiers[2] = { Identifier(2 * material), Identifier(2 * material + 1) };
+        CGPUVertexLayout vertex_layout = {};
+        CGPUBlendStateDescriptor blend_state = {};
+        CGPUDepthStateDescriptor depth_state = {};
+        CGPURasterizerStateDescriptor rasterizer_state = {};
+        const ECGPUFormat color_format = CGPU_FORMAT_R8G8B8A8_UNORM;
+        DECLARE_ZERO(CGPURenderPipelineDescriptor, desc)
+        desc.root_signature = root_signatures[material];
+        desc.vertex_shader = &shaders[0];
+        desc.fragment_shader = &shaders[1];
+        desc.vertex_layout = &vertex_layout;
+        desc.blend_state = &blend_state;
+        desc.depth_state = &depth_state;
+        desc.rasterizer_state = &rasterizer_state;
+        desc.color_formats = &color_format;
+        desc.render_target_count = 1;
+        desc.sample_count = CGPU_SAMPLE_COUNT_1;
+        desc.depth_stencil_format = CGPU_FORMAT_D32_SFLOAT;
+        desc.prim_topology = CGPU_PRIM_TOPO_TRI_LIST;
+        if (!with_shaders) return skr_pso_map_create_key(map, &desc);
+        return skr_pso_map_create_key_with_shaders(map, &desc, identifiers, 2);
+    }
+
+    // installs materials 2, 0, 1, 0, 2, 2 and one key without shaders
+    std::vector<skr_pso_map_manifest_entry_t> RecordManifest()
+    {
+        for (uint32_t material : { 2u, 0u, 1u, 0u, 2u, 2u })
+        {
+            EXPECT_EQ(skr_pso_map_install_pso(pso_map, CreateKey(pso_map, material)), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+        }
+        EXPECT_EQ(skr_pso_map_install_pso(pso_map, CreateKey(pso_map, 3, false)), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+        std::vector<skr_pso_map_manifest_entry_t> manifest(skr_pso_map_get_manifest(pso_map, nullptr, 0));
+        skr_pso_map_get_manifest(pso_map, manifest.data(), (uint32_t)manifest.size());
+        return manifest;
+    }
+
+    struct Resolver {
+        PSOWarmup* test;
+        // a material whose shaders load for a few updates, and one whose shaders never do
+        uint32_t loading_material = UINT32_MAX;
+        uint32_t loading_calls = 0;
+        uint32_t failing_material = UINT32_MAX;
+        uint32_t calls = 0;
+
+        static ESkrPSOMapPSOStatus Resolve(void* usrdata, const skr_pso_map_manifest_entry_t* entry, CGPUShaderLibraryId* libraries, CGPURootSignatureId* root_signature)
+        {
+            auto resolver = (Resolver*)usrdata;
+            resolver->calls++;
+            const auto material = (entry->shaders[0].identifier.hash.encoded_digits[0] - 0x1000) / 2;
+            if (material == resolver->failing_material) return SKR_PSO_MAP_PSO_STATUS_FAILED;
+            if (material == resolver->loading_material && resolver->loading_calls)
+            {
+                resolver->loading_calls--;
+                return SKR_PSO_MAP_PSO_STATUS_REQUESTED;
+            }
+            for (uint32_t i = 0; i < entry->shader_count; i++)
+            {
+                const auto shader = entry->shaders[i].identifier.hash.encoded_digits[0] - 0x1000;
+                libraries[i] = resolver->test->libraries[shader];
+            }
+            *root_signature = resolver->test->root_signatures[material];
+            return SKR_PSO_MAP_PSO_STATUS_INSTALLED;
+        }
+    };
+
+    bool RunWarmup(skr_pso_map_id map, const std::vector<skr_pso_map_manifest_entry_t>& manifest, Resolver& resolver, uint32_t max_jobs, skr_pso_map_warmup_progress_t& progress)
+    {
+        skr_pso_map_warmup_desc_t desc = {};
+        desc.entries = manifest.data();
+        desc.entry_count = (uint32_t)manifest.size();
+        desc.resolve = &Resolver::Resolve;
+        desc.usrdata = &resolver;
+        desc.max_jobs = max_jobs;
+        skr_pso_map_begin_warmup(map, &desc);
+        bool done = false;
+        for (uint32_t frame = 0; frame < 100000 && !done; frame++)
+        {
+            done = skr_pso_map_update_warmup(map, &progress);
+            EXPECT_LE(progress.in_flight, max_jobs ? max_jobs : progress.total);
+        }
+        skr_pso_map_end_warmup(map);
+        return done;
+    }
+
+    uint64_t CreatedPipelines()
+    {
+        CGPUNullDeviceStatistics stats = {};
+        cgpu_null_query_device_statistics(device, &stats);
+        return stats.render_pipelines_created;
+    }
+
+    static constexpr uint32_t kMaterialCount = 4;
+    static constexpr uint32_t kShaderCount = kMaterialCount * 2;
+
+    skr::task::scheduler_t scheduler;
+    CGPUInstanceId instance = nullptr;
+    CGPUAdapterId adapter = nullptr;
+    CGPUDeviceId device = nullptr;
+    CGPUShaderLibraryId libraries[kShaderCount] = {};
+    CGPURootSignatureId root_signatures[kMaterialCount] = {};
+    skr_pso_map_id pso_map = nullptr;
+};
+
+TEST_F(PSOWarmup, ManifestRecordsInstalls)
+{
+    const auto manifest = RecordManifest();
+    // one entry per pso, in the order of the first install, keys without shaders are not recorded
+    ASSERT_EQ(manifest.size(), 3u);
+    const uint32_t expected_materials[] = { 2, 0, 1 };
+    const uint32_t expected_uses[] = { 3, 2, 1 };
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        const auto& entry = manifest[i];
+        const auto material = expected_materials[i];
+        EXPECT_EQ(entry.use_count, expected_uses[i]);
+        ASSERT_EQ(entry.shader_count, 2u);
+        EXPECT_TRUE(entry.shaders[0].identifier == Identifier(2 * material));
+        EXPECT_TRUE(entry.shaders[1].identifier == Identifier(2 * material + 1));
+        EXPECT_STREQ((const char*)entry.shaders[0].entry, "vert_main");
+        EXPECT_STREQ((const char*)entry.shaders[1].entry, "frag_main");
+        EXPECT_EQ(entry.color_formats[0], CGPU_FORMAT_R8G8B8A8_UNORM);
+        EXPECT_EQ(entry.depth_stencil_format, CGPU_FORMAT_D32_SFLOAT);
+        EXPECT_EQ(entry.render_target_count, 1u);
+    }
+    // the capacity bounds the copy
+    skr_pso_map_manifest_entry_t first = {};
+    EXPECT_EQ(skr_pso_map_get_manifest(pso_map, &first, 1), 1u);
+    EXPECT_EQ(memcmp(&first, &manifest[0], sizeof(first)), 0);
+
+    skr_pso_map_clear_manifest(pso_map);
+    EXPECT_EQ(skr_pso_map_get_manifest(pso_map, nullptr, 0), 0u);
+    EXPECT_EQ(skr_pso_map_install_pso(pso_map, CreateKey(pso_map, 1)), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+    EXPECT_EQ(skr_pso_map_get_manifest(pso_map, nullptr, 0), 1u);
+}
+
+TEST_F(PSOWarmup, WarmupCreatesManifestPSOs)
+{
+    const auto manifest = RecordManifest();
+    ASSERT_EQ(manifest.size(), 3u);
+    // the next run
+    auto next_map = CreateMap();
+    cgpu_null_reset_device_statistics(device);
+    Resolver resolver = { this };
+    resolver.loading_material = 0;
+    resolver.loading_calls = 5;
+    resolver.failing_material = 1;
+    skr_pso_map_warmup_progress_t progress = {};
+    EXPECT_TRUE(RunWarmup(next_map, manifest, resolver, 0, progress));
+    EXPECT_EQ(progress.total, 3u);
+    EXPECT_EQ(progress.compiled, 2u);
+    EXPECT_EQ(progress.failed, 1u);
+    EXPECT_EQ(progress.in_flight, 0u);
+    EXPECT_EQ(CreatedPipelines(), 2u);
+
+    // materials find the warmed up psos, nothing is created again
+    for (uint32_t material : { 2u, 0u })
+    {
+        auto key = CreateKey(next_map, material);
+        EXPECT_EQ(skr_pso_map_install_pso(next_map, key), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+        EXPECT_NE(skr_pso_map_find_pso(next_map, key), nullptr);
+    }
+    EXPECT_EQ(CreatedPipelines(), 2u);
+    // the one that failed to resolve is created on demand
+    EXPECT_EQ(skr_pso_map_install_pso(next_map, CreateKey(next_map, 1)), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+    EXPECT_EQ(CreatedPipelines(), 3u);
+    skr_pso_map_free(next_map);
+}
+
+TEST_F(PSOWarmup, WarmupRespectsJobLimitAndInstalledPSOs)
+{
+    const auto manifest = RecordManifest();
+    auto next_map = CreateMap();
+    // a material got its pso before the warm up reached it
+    EXPECT_EQ(skr_pso_map_install_pso(next_map, CreateKey(next_map, 0)), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+    cgpu_null_reset_device_statistics(device);
+    Resolver resolver = { this };
+    skr_pso_map_warmup_progress_t progress = {};
+    EXPECT_TRUE(RunWarmup(next_map, manifest, resolver, 1, progress));
+    EXPECT_EQ(progress.compiled, 3u);
+    EXPECT_EQ(progress.failed, 0u);
+    EXPECT_EQ(CreatedPipelines(), 2u);
+    skr_pso_map_free(next_map);
+}
+
+TEST_F(PSOWarmup, WarmupReleasesItsKeys)
+{
+    const auto manifest = RecordManifest();
+    auto next_map = CreateMap();
+    Resolver resolver = { this };
+    skr_pso_map_warmup_progress_t progress = {};
+    EXPECT_TRUE(RunWarmup(next_map, manifest, resolver, 0, progress));
+    EXPECT_EQ(progress.compiled, 3u);
+    // material 0 holds its key, the other warmed up psos are only held by the map
+    auto held = CreateKey(next_map, 0);
+    EXPECT_EQ(skr_pso_map_install_pso(next_map, held), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+    skr_pso_map_garbage_collect(next_map, 1);
+    cgpu_null_reset_device_statistics(device);
+    EXPECT_NE(skr_pso_map_find_pso(next_map, held), nullptr);
+    EXPECT_EQ(skr_pso_map_install_pso(next_map, CreateKey(next_map, 0)), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+    EXPECT_EQ(CreatedPipelines(), 0u);
+    EXPECT_EQ(skr_pso_map_install_pso(next_map, CreateKey(next_map, 2)), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+    EXPECT_EQ(CreatedPipelines(), 1u);
+    skr_pso_map_free(next_map);
+}
+
+TEST_F(PSOWarmup, WarmupKeysOwnTheirEntries)
+{
+    const auto manifest = RecordManifest();
+    auto next_map = CreateMap();
+    Resolver resolver = { this };
+    skr_pso_map_warmup_progress_t progress = {};
+    EXPECT_TRUE(RunWarmup(next_map, manifest, resolver, 0, progress));
+    EXPECT_EQ(progress.compiled, 3u);
+
+    // the next warm up takes the place of the entries the first one was resolved from
+    auto renamed = manifest;
+    for (auto& entry : renamed)
+    {
+        strcpy((char*)entry.shaders[0].entry, "vert_other");
+        strcpy((char*)entry.shaders[1].entry, "frag_other");
+    }
+    cgpu_null_reset_device_statistics(device);
+    EXPECT_TRUE(RunWarmup(next_map, renamed, resolver, 0, progress));
+    EXPECT_EQ(progress.compiled, 3u);
+    EXPECT_EQ(CreatedPipelines(), 3u);
+
+    // the psos of the first warm up are still found by the entries they were created with
+    cgpu_null_reset_device_statistics(device);
+    for (uint32_t material : { 2u, 0u, 1u })
+    {
+        auto key = CreateKey(next_map, material);
+        EXPECT_EQ(skr_pso_map_install_pso(next_map, key), SKR_PSO_MAP_PSO_STATUS_INSTALLED);
+        EXPECT_NE(skr_pso_map_find_pso(next_map, key), nullptr);
+    }
+    EXPECT_EQ(CreatedPipelines(), 0u);
+    skr_pso_map_free(next_map);
+}
+
+TEST_F(PSOWarmup, ManifestRoundTrip)
+{
+    const auto manifest = RecordManifest();
+    skr_vfs_desc_t vfs_desc = {};
+    vfs_desc.app_name = u8"pso-warmup-test";
+    vfs_desc.mount_type = SKR_MOUNT_TYPE_ABSOLUTE;
+    auto vfs = skr_create_vfs(&vfs_desc);
+    ASSERT_NE(vfs, nullptr);
+    EXPECT_TRUE(skr_pso_map_save_manifest(pso_map, vfs, u8"pso_manifest_test.bin"));
+    ASSERT_EQ(skr_pso_map_load_manifest(vfs, u8"pso_manifest_test.bin", nullptr, 0), manifest.size());
+    std::vector<skr_pso_map_manifest_entry_t> loaded(manifest.size());
+    EXPECT_EQ(skr_pso_map_load_manifest(vfs, u8"pso_manifest_test.bin", loaded.data(), (uint32_t)loaded.size()), manifest.size());
+    EXPECT_EQ(memcmp(loaded.data(), manifest.data(), manifest.size() * sizeof(skr_pso_map_manifest_entry_t)), 0);
+
+    // files of another layout are not taken
+    auto file = skr_vfs_fopen(vfs, u8"pso_manifest_test.bin", SKR_FM_WRITE_BINARY, SKR_FILE_CREATION_ALWAYS_NEW);
+    const uint32_t garbage[4] = { 0xdeadbeef, 1, 1, 1 };
+    skr_vfs_fwrite(file, garbage, 0, sizeof(garbage));
+    skr_vfs_fclose(file);
+    EXPECT_EQ(skr_pso_map_load_manifest(vfs, u8"pso_manifest_test.bin", nullptr, 0), 0u);
+    EXPECT_EQ(skr_pso_map_load_manifest(vfs, u8"pso_manifest_missing.bin", nullptr, 0), 0u);
+    skr_free_vfs(vfs);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    auto result = RUN_ALL_TESTS();
+    return result;
+}
@@ -0,0 +1,229 @@
+#include "gtest/gtest.h"
+#include "cgpu/api.h"
+#include "task/task.hpp"
+#include "ecs/dual.h"
+#include "SkrRenderGraph/frontend/render_graph.hpp"
+#include "SkrRenderer/skr_renderer.h"
+#include "SkrRenderer/render_effect.h"
+#include <string.h>
+#include <string>
+#include <vector>
+
+static constexpr uint32_t kPassCount = 3;
+static constexpr uint32_t kProcessorCount = 6;
+static constexpr uint32_t kDrawsPerList = 64;
+static const char* kPassNames[kPassCount] = { "ParallelProducePass0", "ParallelProducePass1", "ParallelProducePass2" };
+
+// a render device over a null cgpu device, with what the renderer asks for only
+struct NullRenderDevice : public skr::RendererDevice {
+    void initialize(const Builder& builder) override {}
+    void finalize() override {}
+    CGPUSwapChainId register_window(SWindowHandle window) override { return nullptr; }
+    CGPUSwapChainId recreate_window_swapchain(SWindowHandle window) override { return nullptr; }
+    void create_api_objects(const Builder& builder) override {}
+    CGPUDeviceId get_cgpu_device() const override { return device; }
+    ECGPUBackend get_backend() const override { return CGPU_BACKEND_NULL; }
+    CGPUQueueId get_gfx_queue() const override { return queue; }
+    CGPUQueueId get_cpy_queue(uint32_t idx) const override { return queue; }
+    CGPUDStorageQueueId get_file_dstorage_queue() const override { return nullptr; }
+    CGPUDStorageQueueId get_memory_dstorage_queue() const override { return nullptr; }
+    ECGPUFormat get_swapchain_format() const override { return CGPU_FORMAT_UNDEFINED; }
+    CGPUSamplerId get_linear_sampler() const override { return nullptr; }
+    CGPURootSignaturePoolId get_root_signature_pool() const override { return nullptr; }
+    skr_io_vram_service_t* get_vram_service() const override { return nullptr; }
+    uint32_t get_aux_service_count() const override { return 0; }
+    skr_threaded_service_t* get_aux_service(uint32_t index) const override { return nullptr; }
+#ifdef _WIN32
+    skr_win_dstorage_decompress_service_id get_win_dstorage_decompress_service() const override { return nullptr; }
+#endif
+
+    CGPUDeviceId device = nullptr;
+    CGPUQueueId queue = nullptr;
+};
+
+// keeps its lists in members between calls like the effects do, some passes get nothing from it
+// a draw names its processor and pass with its pipeline and its position with first_index, keys run backwards
+struct TestProcessor : public IRenderEffectProcessor {
+    void on_register(SRendererId, dual_storage_t*) override {}
+    void on_unregister(SRendererId, dual_storage_t*) override {}
+    void get_type_set(const dual_chunk_view_t* cv, dual_type_set_t* set) override {}
+    dual_type_index_t get_identity_type() override { return {}; }
+    void initialize_data(SRendererId renderer, dual_storage_t* storage, dual_chunk_view_t* game_cv, dual_chunk_view_t* render_cv) override {}
+
+    static bool produces(uint32_t processor, uint32_t pass) { return (processor + pass) % 3 != 0; }
+    static CGPURenderPipelineId tag(uint32_t processor, uint32_t pass) { return (CGPURenderPipelineId)(uintptr_t)(((processor + 1) << 8) | (pass + 1)); }
+
+    void on_update(const skr_primitive_update_context_t* context) override { update_viewport = context->viewport_id; }
+
+    skr_primitive_draw_packet_t produce_draw_packets(const skr_primitive_draw_context_t* context) override
+    {
+        draw_viewport = context->viewport_id;
+        uint32_t pass = 0;
+        while (pass < kPassCount && strcmp(context->pass->identity(), kPassNames[pass])) pass++;
+        if (pass == kPassCount || !produces(index, pass)) return {};
+        auto& draws = pass_draws[pass];
+        draws.clear();
+        for (uint32_t i = 0; i < kDrawsPerList; i++)
+        {
+            auto& draw = draws.emplace_back();
+            draw.pipeline = tag(index, pass);
+            draw.index_buffer.first_index = i;
+            draw.sort_key = kDrawsPerList - i;
+        }
+        lists[pass] = { draws.data(), (uint32_t)draws.size(), nullptr };
+        return { &lists[pass], 1, nullptr };
+    }
+
+    uint32_t index = 0;
+    uint32_t update_viewport = UINT32_MAX;
+    uint32_t draw_viewport = UINT32_MAX;
+    std::vector<skr_primitive_draw_t> pass_draws[kPassCount];
+    skr_primitive_draw_list_view_t lists[kPassCount];
+};
+
+// copies the row of packets it is handed, one draw list per slot
+struct TestPass : public IPrimitiveRenderPass {
+    void on_update(const skr_primitive_pass_context_t* context) override { viewport = context->viewport_id; }
+    void post_update(const skr_primitive_pass_context_t* context) override {}
+    void execute(const skr_primitive_pass_context_t* context, skr::span<const skr_primitive_draw_packet_t> packets) override
+    {
+        received.clear();
+        for (const auto& packet : packets)
+        {
+            auto& slot = received.emplace_back();
+            for (uint32_t i = 0; i < packet.count; i++)
+                slot.insert(slot.end(), packet.lists[i].drawcalls, packet.lists[i].drawcalls + packet.lists[i].count);
+        }
+    }
+    skr_render_pass_name_t identity() const override { return name; }
+
+    const char* name = nullptr;
+    uint32_t viewport = UINT32_MAX;
+    std::vector<std::vector<skr_primitive_draw_t>> received;
+};
+
+class ParallelProduce : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        instance = cgpu_create_instance(&desc);
+        uint32_t adapters_count = 1;
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+        CGPUQueueGroupDescriptor G = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        DECLARE_ZERO(CGPUDeviceDescriptor, descriptor)
+        descriptor.queue_groups = &G;
+        descriptor.queue_group_count = 1;
+        render_device.device = cgpu_create_device(adapter, &descriptor);
+        render_device.queue = cgpu_get_queue(render_device.device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
+
+        storage = dualS_create();
+        renderer = skr_create_renderer(&render_device, storage);
+        graph = skr::render_graph::RenderGraph::create(
+        [this](skr::render_graph::RenderGraphBuilder& builder) {
+            builder.with_device(render_device.device)
+                .with_gfx_queue(render_device.queue)
+                .backend_api(CGPU_BACKEND_NULL);
+        });
+        for (uint32_t i = 0; i < kProcessorCount; i++)
+        {
+            processors[i].index = i;
+            processor_names[i] = "ParallelProduceEffect" + std::to_string(i);
+            skr_renderer_register_render_effect(renderer, processor_names[i].c_str(), &processors[i]);
+        }
+        for (uint32_t i = 0; i < kPassCount; i++)
+            passes[i].name = kPassNames[i];
+        scheduler.initialize(skr::task::scheudler_config_t{});
+        scheduler.bind();
+    }
+
+    void TearDown() override
+    {
+        scheduler.unbind();
+        skr_free_renderer(renderer);
+        skr::render_graph::RenderGraph::destroy(graph);
+        dualS_release(storage);
+        cgpu_free_queue(render_device.queue);
+        cgpu_free_device(render_device.device);
+        cgpu_free_instance(instance);
+    }
+
+    // passes are handed to the renderer for one frame at a time
+    void RenderFrame()
+    {
+        for (uint32_t i = 0; i < kPassCount; i++)
+            skr_renderer_register_render_pass(renderer, kPassNames[i], &passes[i]);
+        skr_renderer_render_frame(renderer, graph);
+    }
+
+    // every pass sees a slot per processor in registration order, with that processor's sorted draws for it
+    void ExpectPacketTable()
+    {
+        for (uint32_t pass = 0; pass < kPassCount; pass++)
+        {
+            const auto& received = passes[pass].received;
+            ASSERT_EQ(received.size(), kProcessorCount);
+            for (uint32_t processor = 0; processor < kProcessorCount; processor++)
+            {
+                const auto& draws = received[processor];
+                if (!TestProcessor::produces(processor, pass))
+                {
+                    EXPECT_TRUE(draws.empty());
+                    continue;
+                }
+                ASSERT_EQ(draws.size(), kDrawsPerList);
+                for (uint32_t i = 0; i < kDrawsPerList; i++)
+                {
+                    EXPECT_EQ(draws[i].pipeline, TestProcessor::tag(processor, pass));
+                    EXPECT_EQ(draws[i].index_buffer.first_index, kDrawsPerList - 1 - i);
+                }
+            }
+        }
+    }
+
+    CGPUInstanceId instance = nullptr;
+    CGPUAdapterId adapter = nullptr;
+    NullRenderDevice render_device;
+    dual_storage_t* storage = nullptr;
+    SRendererId renderer = nullptr;
+    skr::render_graph::RenderGraph* graph = nullptr;
+    skr::task::scheduler_t scheduler;
+    TestProcessor processors[kProcessorCount];
+    std::string processor_names[kProcessorCount];
+    TestPass passes[kPassCount];
+};
+
+TEST_F(ParallelProduce, SerialPacketTable)
+{
+    RenderFrame();
+    ExpectPacketTable();
+}
+
+TEST_F(ParallelProduce, ParallelPacketTable)
+{
+    skr_renderer_enable_parallel_produce(renderer, true);
+    // later frames refill the scratch the processors kept from the earlier ones
+    for (uint32_t frame = 0; frame < 3; frame++)
+    {
+        RenderFrame();
+        ExpectPacketTable();
+    }
+}
+
+TEST_F(ParallelProduce, ContextsNameTheViewport)
+{
+    RenderFrame();
+    for (const auto& processor : processors)
+        EXPECT_EQ(processor.draw_viewport, 0u);
+    skr_renderer_set_viewport(renderer, 2u);
+    RenderFrame();
+    for (const auto& processor : processors)
+    {
+        EXPECT_EQ(processor.update_viewport, 2u);
+        EXPECT_EQ(processor.draw_viewport, 2u);
+    }
+    for (const auto& pass : passes)
+        EXPECT_EQ(pass.viewport, 2u);
+}
@@ -0,0 +1,261 @@
+#include "gtest/gtest.h"
+#include "cgpu/api.h"
+#include "cgpu/io.h"
+#include "cgpu/backend/null/cgpu_null.h"
+#include "platform/filesystem.hpp"
+#include "platform/guid.hpp"
+#include "platform/thread.h"
+#include "platform/vfs.h"
+#include "platform/memory.h"
+#include "resource/resource_system.h"
+#include "utils/format.hpp"
+#include "utils/io.h"
+#include "utils/make_zeroed.hpp"
+#include "SkrRenderer/render_device.h"
+#include "SkrRenderer/resources/texture_resource.h"
+#include <stdio.h>
+#include <vector>
+
+static constexpr skr_guid_t kTexture = skr::guid::make_guid_unsafe("6C0E9B2A-4F13-4D8E-A7B5-91D3E2F06A48");
+static constexpr uint32_t kExtent = 64;
+static constexpr uint32_t kMipCount = 7;
+static constexpr uint32_t kStreamingExtent = 16;
+
+// a render device over a null cgpu device, with what the texture factory asks for only
+struct NullRenderDevice : public skr::RendererDevice {
+    void initialize(const Builder& builder) override {}
+    void finalize() override {}
+    CGPUSwapChainId register_window(SWindowHandle window) override { return nullptr; }
+    CGPUSwapChainId recreate_window_swapchain(SWindowHandle window) override { return nullptr; }
+    void create_api_objects(const Builder& builder) override {}
+    CGPUDeviceId get_cgpu_device() const override { return device; }
+    ECGPUBackend get_backend() const override { return CGPU_BACKEND_NULL; }
+    CGPUQueueId get_gfx_queue() const override { return queue; }
+    CGPUQueueId get_cpy_queue(uint32_t idx) const override { return queue; }
+    CGPUDStorageQueueId get_file_dstorage_queue() const override { return nullptr; }
+    CGPUDStorageQueueId get_memory_dstorage_queue() const override { return nullptr; }
+    ECGPUFormat get_swapchain_format() const override { return CGPU_FORMAT_UNDEFINED; }
+    CGPUSamplerId get_linear_sampler() const override { return nullptr; }
+    CGPURootSignaturePoolId get_root_signature_pool() const override { return nullptr; }
+    skr_io_vram_service_t* get_vram_service() const override { return vram_service; }
+    uint32_t get_aux_service_count() const override { return 0; }
+    skr_threaded_service_t* get_aux_service(uint32_t index) const override { return nullptr; }
+#ifdef _WIN32
+    skr_win_dstorage_decompress_service_id get_win_dstorage_decompress_service() const override { return nullptr; }
+#endif
+
+    CGPUDeviceId device = nullptr;
+    CGPUQueueId queue = nullptr;
+    skr_io_vram_service_t* vram_service = nullptr;
+};
+
+// the factory only asks the request for the guid of the texture
+struct TextureRequest : public skr::resource::SResourceRequest {
+    skr_guid_t GetGuid() const override { return kTexture; }
+    skr::span<const uint8_t> GetData() const override { return {}; }
+#ifdef SKR_RESOURCE_DEV_MODE
+    skr::span<const uint8_t> GetArtifactsData() const override { return {}; }
+#endif
+    skr::span<const skr_guid_t> GetDependencies() const override { return {}; }
+    void UpdateLoad(bool requestInstall) override {}
+    void UpdateUnload() override {}
+    void Update() override {}
+    bool Okay() override { return true; }
+    bool Yielded() override { return false; }
+    bool Failed() override { return false; }
+    bool AsyncSerde() override { return false; }
+    void OnRequestFileFinished() override {}
+    void OnRequestLoadFinished() override {}
+    void LoadTask() override {}
+
+protected:
+    void _LoadDependencies() override {}
+    void _UnloadDependencies() override {}
+    void _LoadFinished() override {}
+    void _InstallFinished() override {}
+    void _UnloadResource() override {}
+};
+
+class TextureStreaming : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        instance = cgpu_create_instance(&desc);
+        uint32_t adapters_count = 1;
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+        CGPUQueueGroupDescriptor G = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        DECLARE_ZERO(CGPUDeviceDescriptor, descriptor)
+        descriptor.queue_groups = &G;
+        descriptor.queue_group_count = 1;
+        render_device.device = cgpu_create_device(adapter, &descriptor);
+        render_device.queue = cgpu_get_queue(render_device.device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
+
+        auto vram_desc = make_zeroed<skr_vram_io_service_desc_t>();
+        vram_desc.name = u8"TextureStreamingVRAMService";
+        vram_desc.sleep_mode = SKR_ASYNC_SERVICE_SLEEP_MODE_SLEEP;
+        vram_desc.sleep_time = 1;
+        vram_desc.lockless = true;
+        vram_desc.sort_method = SKR_ASYNC_SERVICE_SORT_METHOD_PARTIAL;
+        render_device.vram_service = skr_io_vram_service_t::create(&vram_desc);
+
+        auto ram_desc = make_zeroed<skr_ram_io_service_desc_t>();
+        ram_desc.name = u8"TextureStreamingRAMService";
+        ram_desc.sleep_mode = SKR_ASYNC_SERVICE_SLEEP_MODE_SLEEP;
+        ram_desc.sleep_time = 1;
+        ram_desc.lockless = true;
+        ram_desc.sort_method = SKR_ASYNC_SERVICE_SORT_METHOD_PARTIAL;
+        ram_service = skr_io_ram_service_t::create(&ram_desc);
+
+        std::error_code ec = {};
+        root = skr::filesystem::temp_directory_path(ec) / "TextureStreamingTest";
+        skr::filesystem::remove_all(root, ec);
+        skr::filesystem::create_directories(root, ec);
+        const auto u8Root = root.u8string();
+        skr_vfs_desc_t vfs_desc = {};
+        vfs_desc.mount_type = SKR_MOUNT_TYPE_CONTENT;
+        vfs_desc.override_mount_dir = u8Root.c_str();
+        vfs = skr_create_vfs(&vfs_desc);
+
+        skr::resource::STextureFactory::Root factoryRoot = {};
+        factoryRoot.dstorage_root = u8Root.c_str();
+        factoryRoot.vfs = vfs;
+        factoryRoot.ram_service = ram_service;
+        factoryRoot.vram_service = render_device.vram_service;
+        factoryRoot.render_device = &render_device;
+        factoryRoot.streaming_max_extent = kStreamingExtent;
+        factory = skr::resource::STextureFactory::Create(factoryRoot);
+    }
+
+    void TearDown() override
+    {
+        skr::resource::STextureFactory::Destroy(factory);
+        skr_free_vfs(vfs);
+        skr_io_ram_service_t::destroy(ram_service);
+        skr_io_vram_service_t::destroy(render_device.vram_service);
+        cgpu_free_queue(render_device.queue);
+        cgpu_free_device(render_device.device);
+        cgpu_free_instance(instance);
+        std::error_code ec = {};
+        skr::filesystem::remove_all(root, ec);
+    }
+
+    // cooks a rgba8 texture the way the texture cooker lays it out, smallest level first
+    skr_texture_resource_t* Cook()
+    {
+        auto texture = SkrNew<skr_texture_resource_t>();
+        texture->format = CGPU_FORMAT_R8G8B8A8_UNORM;
+        texture->mips_count = kMipCount;
+        texture->width = kExtent;
+        texture->height = kExtent;
+        texture->depth = 1;
+        texture->mips.resize(kMipCount);
+        std::vector<uint8_t> bytes;
+        for (uint32_t i = kMipCount; i-- > 0;)
+        {
+            auto& mip = texture->mips[i];
+            mip.width = kExtent >> i;
+            mip.height = kExtent >> i;
+            mip.offset = bytes.size();
+            mip.size = (uint64_t)mip.width * mip.height * 4;
+            bytes.resize(bytes.size() + mip.size, (uint8_t)i);
+        }
+        texture->data_size = bytes.size();
+
+        const auto path = root / skr::format("{}.raw", kTexture).c_str();
+        auto file = fopen(path.string().c_str(), "wb");
+        EXPECT_NE(file, nullptr);
+        if (file)
+        {
+            fwrite(bytes.data(), 1, bytes.size(), file);
+            fclose(file);
+        }
+        return texture;
+    }
+
+    // polls like the game loop does once a frame, false if nothing finished in time
+    template <typename F>
+    static bool Poll(F&& done)
+    {
+        for (uint32_t frame = 0; frame < 5000; frame++)
+        {
+            if (done()) return true;
+            skr_thread_sleep(1);
+        }
+        return false;
+    }
+
+    CGPUInstanceId instance = nullptr;
+    CGPUAdapterId adapter = nullptr;
+    NullRenderDevice render_device;
+    skr_io_ram_service_t* ram_service = nullptr;
+    skr_vfs_t* vfs = nullptr;
+    skr::filesystem::path root;
+    skr::resource::STextureFactory* factory = nullptr;
+};
+
+TEST_F(TextureStreaming, MipForExtent)
+{
+    skr_texture_resource_t texture = {};
+    texture.width = kExtent;
+    texture.height = kExtent / 2;
+    texture.mips.resize(kMipCount);
+    EXPECT_EQ(skr::resource::STextureFactory::MipForExtent(&texture, 1000.f), 0u);
+    EXPECT_EQ(skr::resource::STextureFactory::MipForExtent(&texture, 64.f), 0u);
+    EXPECT_EQ(skr::resource::STextureFactory::MipForExtent(&texture, 32.f), 1u);
+    // the level at least as large as the screen
+    EXPECT_EQ(skr::resource::STextureFactory::MipForExtent(&texture, 20.f), 1u);
+    EXPECT_EQ(skr::resource::STextureFactory::MipForExtent(&texture, 1.f), 6u);
+    EXPECT_EQ(skr::resource::STextureFactory::MipForExtent(&texture, 0.01f), 6u);
+    EXPECT_EQ(skr::resource::STextureFactory::MipForExtent(&texture, 0.f), 6u);
+}
+
+TEST_F(TextureStreaming, MipsArriveAfterRequest)
+{
+    TextureRequest request;
+    skr_resource_record_t record;
+    auto texture = Cook();
+    record.resource = texture;
+    record.activeRequest = &request;
+
+    // levels larger than the streaming extent stay on disk
+    ASSERT_EQ(factory->Install(&record), SKR_INSTALL_STATUS_INPROGRESS);
+    ASSERT_TRUE(Poll([&] { return factory->UpdateInstall(&record) == SKR_INSTALL_STATUS_SUCCEED; }));
+    ASSERT_NE(texture->texture, nullptr);
+    ASSERT_NE(texture->texture_view, nullptr);
+    EXPECT_EQ(texture->resident_mip, 2u);
+
+    CGPUNullDeviceStatistics before = {};
+    cgpu_null_query_device_statistics(render_device.device, &before);
+    const auto installed_texture = texture->texture;
+    const auto installed_view = texture->texture_view;
+
+    // a request in flight turns the next ones down, the resident levels stay usable meanwhile
+    EXPECT_TRUE(factory->RequestMips(texture, 0));
+    EXPECT_FALSE(factory->RequestMips(texture, 0));
+    EXPECT_EQ(texture->texture_view, installed_view);
+    ASSERT_TRUE(Poll([&] {
+        factory->UpdateStreaming();
+        return texture->resident_mip == 0;
+    }));
+    EXPECT_EQ(texture->texture, installed_texture);
+    EXPECT_NE(texture->texture_view, nullptr);
+    EXPECT_NE(texture->texture_view, installed_view);
+
+    // the two levels are copied into the installed texture
+    CGPUNullDeviceStatistics after = {};
+    cgpu_null_query_device_statistics(render_device.device, &after);
+    EXPECT_EQ(after.textures_created, before.textures_created);
+    EXPECT_EQ(after.copies - before.copies, 2u);
+
+    // resident levels are not read again
+    EXPECT_TRUE(factory->RequestMips(texture, 1));
+    factory->UpdateStreaming();
+    EXPECT_EQ(texture->resident_mip, 0u);
+
+    EXPECT_TRUE(factory->Unload(&record));
+    record.resource = nullptr;
+    record.activeRequest = nullptr;
+}
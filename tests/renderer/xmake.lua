@@ -0,0 +1,41 @@
+target("RendererDrawInstancingTest")
+    set_kind("binary")
+    set_group("05.tests/renderer")
+    public_dependency("SkrRenderer", engine_version)
+    add_packages("gtest")
+    add_files("DrawInstancing/DrawInstancing.cpp")
+
+target("RendererCullingTest")
+    set_kind("binary")
+    set_group("05.tests/renderer")
+    public_dependency("SkrRenderer", engine_version)
+    add_packages("gtest")
+    add_files("FrustumCulling/FrustumCulling.cpp")
+
+target("RendererPSOWarmupTest")
+    set_kind("binary")
+    set_group("05.tests/renderer")
+    public_dependency("SkrRenderer", engine_version)
+    add_packages("gtest")
+    add_files("PSOWarmup/PSOWarmup.cpp")
+
+target("RendererDrawSortTest")
+    set_kind("binary")
+    set_group("05.tests/renderer")
+    public_dependency("SkrRenderer", engine_version)
+    add_packages("gtest")
+    add_files("DrawSort/DrawSort.cpp")
+
+target("RendererParallelProduceTest")
+    set_kind("binary")
+    set_group("05.tests/renderer")
+    public_dependency("SkrRenderer", engine_version)
+    add_packages("gtest")
+    add_files("ParallelProduce/ParallelProduce.cpp")
+
+target("RendererTextureStreamingTest")
+    set_kind("binary")
+    set_group("05.tests/renderer")
+    public_dependency("SkrRenderer", engine_version)
+    add_packages("gtest")
+    add_files("TextureStreaming/TextureStreaming.cpp")
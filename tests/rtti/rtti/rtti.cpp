@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "utils/log.hpp"
 #include "platform/guid.hpp"
+#include "type/type_plan.hpp"
+#include "binary/writer.h"
+#include "containers/vector.hpp"
 #include "../types/types.hpp"
 
 class RTTI : public ::testing::Test
@@ -53,6 +56,47 @@ TEST_F(RTTI, TestEnumType)
     }
 }
 
+TEST_F(RTTI, TypePlan)
+{
+    auto type = skr::type::type_of<Types::TestPlanRecord>::get();
+    auto plan = skr::type::GetTypePlan(type);
+    EXPECT_TRUE(plan != nullptr);
+    EXPECT_TRUE(plan->compiledCopy);
+    EXPECT_TRUE(plan->compiledSerialize);
+    // count, weight, position | name | id, scale
+    EXPECT_EQ(plan->copyOps.size(), 3u);
+    EXPECT_EQ(plan->serializeOps.size(), 3u);
+    EXPECT_EQ(plan, skr::type::GetTypePlan(type));
+
+    Types::TestPlanRecord src;
+    src.count = 3;
+    src.weight = 0.5f;
+    src.position = { 1.f, 2.f, 3.f };
+    src.name = "plan";
+    src.id = 42;
+    src.scale = 2.0;
+
+    skr_value_t value;
+    value.Emplace<Types::TestPlanRecord>(src);
+    skr_value_t copied = value;
+    auto& dst = copied.As<Types::TestPlanRecord>();
+    EXPECT_EQ(dst.count, src.count);
+    EXPECT_EQ(dst.weight, src.weight);
+    EXPECT_EQ(dst.position.z, src.position.z);
+    EXPECT_EQ(dst.name, src.name);
+    EXPECT_EQ(dst.id, src.id);
+    EXPECT_EQ(dst.scale, src.scale);
+
+    eastl::vector<uint8_t> planned, native;
+    skr::binary::VectorWriter plannedWriter{ &planned };
+    skr::binary::VectorWriter nativeWriter{ &native };
+    skr_binary_writer_t plannedArchive(plannedWriter);
+    skr_binary_writer_t nativeArchive(nativeWriter);
+    EXPECT_EQ(type->Serialize(&src, &plannedArchive), 0);
+    EXPECT_EQ(skr::binary::Write(&nativeArchive, src), 0);
+    EXPECT_EQ(planned, native);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
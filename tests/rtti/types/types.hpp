@@ -64,6 +64,19 @@ TestSon : public TestParent
 }
 sstatic_ctor(XXXInformation<$T>());
 
+sreflect_struct("guid" : "5f0ad9a4-0d4c-4a4c-9a51-5e3f7b6f2c11")
+sattr("rtti" : true)
+sattr("serialize" : ["json", "bin"])
+TestPlanRecord
+{
+    uint32_t count;
+    float weight;
+    skr_float3_t position;
+    skr::string name;
+    uint64_t id;
+    double scale;
+};
+
 }
 
 template<typename T>
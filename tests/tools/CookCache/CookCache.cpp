@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "SkrToolCore/asset/cook_cache.hpp"
+#include "platform/filesystem.hpp"
+#include "platform/guid.hpp"
+#include "utils/format.hpp"
+#include <stdio.h>
+#include <string>
+
+static constexpr skr_guid_t kAsset = skr::guid::make_guid_unsafe("3D1C0E26-6A7B-4F0C-9E5D-2B8A41C7F930");
+
+class CookCache : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::error_code ec = {};
+        root = skr::filesystem::temp_directory_path(ec) / "CookCacheTest";
+        skr::filesystem::remove_all(root, ec);
+        outputDir = root / "output";
+        skr::filesystem::create_directories(outputDir / "shaders", ec);
+        cache = skd::asset::SCookCache::Open(root / "cache");
+        ASSERT_NE(cache, nullptr);
+    }
+
+    void TearDown() override
+    {
+        skd::asset::SCookCache::Close(cache);
+        std::error_code ec = {};
+        skr::filesystem::remove_all(root, ec);
+    }
+
+    // writes the way cookers do, through whatever the path points at
+    static void Write(const skr::filesystem::path& path, const std::string& content)
+    {
+        auto file = fopen(path.string().c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+    }
+
+    static std::string Read(const skr::filesystem::path& path)
+    {
+        std::string content;
+        auto file = fopen(path.string().c_str(), "rb");
+        if (!file) return content;
+        char chunk[256];
+        size_t read = 0;
+        while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            content.append(chunk, read);
+        fclose(file);
+        return content;
+    }
+
+    // cooks one owned output and one shared output and stores both
+    skd::asset::SCookCacheEntry CookAndStore(const std::string& content)
+    {
+        skd::asset::SCookCacheEntry entry;
+        const skr::string paths[2] = { skr::format("{}.bin", kAsset), "shaders/0123456789abcdef.bytes" };
+        for (const auto& path : paths)
+        {
+            Write(outputDir / path.c_str(), content);
+            auto& output = entry.outputs.emplace_back();
+            output.path = path;
+            EXPECT_TRUE(skd::asset::SCookDatabase::Record(outputDir / path.c_str(), output));
+        }
+        EXPECT_TRUE(cache->Store(kKey, outputDir, entry));
+        return entry;
+    }
+
+    static constexpr uint64_t kKey = 0x5eed;
+    skr::filesystem::path root;
+    skr::filesystem::path outputDir;
+    skd::asset::SCookCache* cache = nullptr;
+};
+
+TEST_F(CookCache, RecookLeavesCachedObjectsAlone)
+{
+    const auto entry = CookAndStore("cooked once");
+    skd::asset::SCookCacheManifest manifest;
+    ASSERT_TRUE(cache->Load(kKey, manifest));
+    ASSERT_EQ(manifest.entries.size(), 1u);
+
+    // restore into a clean output directory, the owned output is a link where the file system allows it
+    std::error_code ec = {};
+    skr::filesystem::remove_all(outputDir, ec);
+    ASSERT_TRUE(cache->Restore(manifest.entries[0], outputDir, kAsset));
+    const auto owned = outputDir / entry.outputs[0].path.c_str();
+    const auto shared = outputDir / entry.outputs[1].path.c_str();
+    EXPECT_EQ(Read(owned), "cooked once");
+    EXPECT_EQ(Read(shared), "cooked once");
+    EXPECT_EQ(skr::filesystem::hard_link_count(shared, ec), 1u);
+
+    // a recook unlinks what the asset owns, then writes every output in place
+    skd::asset::SCookCache::RemoveOwnedOutputs(outputDir, kAsset);
+    EXPECT_FALSE(skr::filesystem::exists(owned, ec));
+    EXPECT_TRUE(skr::filesystem::exists(shared, ec));
+    Write(owned, "cooked twice");
+    Write(shared, "cooked twice");
+
+    // the cache still hands out the first cook
+    const auto restoreDir = root / "restored";
+    ASSERT_TRUE(cache->Restore(manifest.entries[0], restoreDir, kAsset));
+    EXPECT_EQ(Read(restoreDir / entry.outputs[0].path.c_str()), "cooked once");
+    EXPECT_EQ(Read(restoreDir / entry.outputs[1].path.c_str()), "cooked once");
+    EXPECT_EQ(Read(owned), "cooked twice");
+}
+
+TEST_F(CookCache, OwnedOutputsAreNamedAfterTheAsset)
+{
+    const auto other = skr::guid::make_guid_unsafe("8F2E6B14-0C9A-4D37-B1E5-6A0D3C8F2B71");
+    Write(outputDir / skr::format("{}.bin", kAsset).c_str(), "a");
+    Write(outputDir / skr::format("{}.bin.json", kAsset).c_str(), "a");
+    Write(outputDir / skr::format("{}.bin", other).c_str(), "b");
+    skd::asset::SCookCache::RemoveOwnedOutputs(outputDir, kAsset);
+
+    std::error_code ec = {};
+    EXPECT_FALSE(skr::filesystem::exists(outputDir / skr::format("{}.bin", kAsset).c_str(), ec));
+    EXPECT_FALSE(skr::filesystem::exists(outputDir / skr::format("{}.bin.json", kAsset).c_str(), ec));
+    EXPECT_TRUE(skr::filesystem::exists(outputDir / skr::format("{}.bin", other).c_str(), ec));
+    EXPECT_TRUE(skr::filesystem::exists(outputDir / "shaders", ec));
+}
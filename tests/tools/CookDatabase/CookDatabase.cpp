@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include "SkrToolCore/asset/cook_database.hpp"
+#include "platform/filesystem.hpp"
+#include "platform/guid.hpp"
+#include <stdio.h>
+#include <string>
+
+static constexpr skr_guid_t kAsset = skr::guid::make_guid_unsafe("A4E2C1F0-7B36-4D58-9E1A-5C8F0B2D6E93");
+
+class CookDatabase : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::error_code ec = {};
+        root = skr::filesystem::temp_directory_path(ec) / "CookDatabaseTest";
+        skr::filesystem::remove_all(root, ec);
+        skr::filesystem::create_directories(root, ec);
+        input = root / "input.txt";
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec = {};
+        skr::filesystem::remove_all(root, ec);
+    }
+
+    static void Write(const skr::filesystem::path& path, const std::string& content)
+    {
+        auto file = fopen(path.string().c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+    }
+
+    // moves the write time of path away from the one recorded, as a checkout or a copy does
+    static void Touch(const skr::filesystem::path& path)
+    {
+        std::error_code ec = {};
+        const auto time = skr::filesystem::last_write_time(path, ec);
+        skr::filesystem::last_write_time(path, time + std::chrono::hours(1), ec);
+        ASSERT_FALSE(ec);
+    }
+
+    skr::filesystem::path root;
+    skr::filesystem::path input;
+};
+
+TEST_F(CookDatabase, UnchangedFileIsNotHashed)
+{
+    Write(input, "source");
+    skd::asset::SCookFileRecord record;
+    ASSERT_TRUE(skd::asset::SCookDatabase::Record(input, record));
+    EXPECT_EQ(record.size, 6u);
+
+    // a record with the same size and write time is trusted, whatever hash it carries
+    auto stale = record;
+    stale.hash = ~record.hash;
+    bool refreshed = false;
+    EXPECT_TRUE(skd::asset::SCookDatabase::Check(input, stale, refreshed));
+    EXPECT_FALSE(refreshed);
+}
+
+TEST_F(CookDatabase, TouchedFileWithSameContentIsRefreshed)
+{
+    Write(input, "source");
+    skd::asset::SCookFileRecord record;
+    ASSERT_TRUE(skd::asset::SCookDatabase::Record(input, record));
+    const auto recorded = record;
+
+    Touch(input);
+    bool refreshed = false;
+    EXPECT_TRUE(skd::asset::SCookDatabase::Check(input, record, refreshed));
+    EXPECT_TRUE(refreshed);
+    EXPECT_NE(record.timestamp, recorded.timestamp);
+    EXPECT_EQ(record.hash, recorded.hash);
+
+    // the refreshed record passes the cheap check from then on
+    refreshed = false;
+    EXPECT_TRUE(skd::asset::SCookDatabase::Check(input, record, refreshed));
+    EXPECT_FALSE(refreshed);
+}
+
+TEST_F(CookDatabase, ChangedContentIsAChange)
+{
+    Write(input, "source");
+    skd::asset::SCookFileRecord record;
+    ASSERT_TRUE(skd::asset::SCookDatabase::Record(input, record));
+    const auto recorded = record;
+
+    // same size, the hash tells them apart
+    Write(input, "SOURCE");
+    Touch(input);
+    bool refreshed = false;
+    EXPECT_FALSE(skd::asset::SCookDatabase::Check(input, record, refreshed));
+    EXPECT_FALSE(refreshed);
+    EXPECT_EQ(record.timestamp, recorded.timestamp);
+
+    Write(input, "longer source");
+    EXPECT_FALSE(skd::asset::SCookDatabase::Check(input, record, refreshed));
+
+    std::error_code ec = {};
+    skr::filesystem::remove(input, ec);
+    EXPECT_FALSE(skd::asset::SCookDatabase::Check(input, record, refreshed));
+}
+
+TEST_F(CookDatabase, RecordsOutliveTheDatabase)
+{
+    Write(input, "source");
+    skd::asset::SCookRecord record;
+    record.importerVersion = 3;
+    record.cookerVersion = 7;
+    ASSERT_TRUE(skd::asset::SCookDatabase::Record(input, record.meta));
+    record.meta.path = "input.txt";
+    auto& output = record.outputs.emplace_back();
+    output.path = "output.bin";
+    output.hash = 0x1234;
+    record.dependencies.emplace_back(kAsset);
+
+    auto database = skd::asset::SCookDatabase::Open(root / "db");
+    ASSERT_NE(database, nullptr);
+    skd::asset::SCookRecord loaded;
+    EXPECT_FALSE(database->Load(kAsset, loaded));
+    // stores are visible before they are flushed
+    database->Store(kAsset, record);
+    ASSERT_TRUE(database->Load(kAsset, loaded));
+    EXPECT_EQ(loaded.cookerVersion, 7u);
+    skd::asset::SCookDatabase::Close(database);
+
+    database = skd::asset::SCookDatabase::Open(root / "db");
+    ASSERT_NE(database, nullptr);
+    loaded = {};
+    ASSERT_TRUE(database->Load(kAsset, loaded));
+    EXPECT_EQ(loaded.importerVersion, 3u);
+    EXPECT_EQ(loaded.cookerVersion, 7u);
+    EXPECT_EQ(loaded.meta.path, record.meta.path);
+    EXPECT_EQ(loaded.meta.size, record.meta.size);
+    EXPECT_EQ(loaded.meta.timestamp, record.meta.timestamp);
+    EXPECT_EQ(loaded.meta.hash, record.meta.hash);
+    ASSERT_EQ(loaded.outputs.size(), 1u);
+    EXPECT_EQ(loaded.outputs[0].path, output.path);
+    EXPECT_EQ(loaded.outputs[0].hash, output.hash);
+    ASSERT_EQ(loaded.dependencies.size(), 1u);
+    EXPECT_EQ(loaded.dependencies[0], kAsset);
+    EXPECT_TRUE(loaded.files.empty());
+    skd::asset::SCookDatabase::Close(database);
+}
@@ -0,0 +1,363 @@
+#include "gtest/gtest.h"
+#include "task/task.hpp"
+#include "cgpu/api.h"
+#include "platform/guid.hpp"
+#include "SkrMeshCore/mesh_processing.hpp"
+#include "SkrRenderer/resources/mesh_resource.h"
+#include "SkrRenderer/render_mesh.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+static constexpr skr_guid_t kLayout = skr::guid::make_guid_unsafe("2E7D4B90-61A3-4C5F-8B1E-D0A9C6F3752B");
+// quads along each side of the grid
+static constexpr uint32_t kGridSize = 16;
+static constexpr uint32_t kGridVertexCount = (kGridSize + 1) * (kGridSize + 1);
+
+using Triangle = std::array<uint32_t, 3>;
+
+// a bumpy grid in one buffer laid out like the gltf importer does, indices first then one stream per attribute
+class MeshCook : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        // the cooker quantizes uvs to half and normals to 8 bit snorm
+        CGPUVertexLayout layout = {};
+        layout.attributes[0] = { u8"POSITION", 1, CGPU_FORMAT_R32G32B32_SFLOAT, 0, 0, sizeof(skr_float3_t), CGPU_INPUT_RATE_VERTEX };
+        layout.attributes[1] = { u8"TEXCOORD", 1, CGPU_FORMAT_R16G16_SFLOAT, 1, 0, sizeof(uint16_t) * 2, CGPU_INPUT_RATE_VERTEX };
+        layout.attributes[2] = { u8"NORMAL", 1, CGPU_FORMAT_R8G8B8A8_SNORM, 2, 0, sizeof(int8_t) * 4, CGPU_INPUT_RATE_VERTEX };
+        layout.attribute_count = 3;
+        skr_mesh_resource_register_vertex_layout(kLayout, "MeshCookTest", &layout);
+    }
+
+    void SetUp() override
+    {
+        scheduler.initialize(skr::task::scheudler_config_t{});
+        scheduler.bind();
+
+        for (uint32_t y = 0; y <= kGridSize; y++)
+        {
+            for (uint32_t x = 0; x <= kGridSize; x++)
+            {
+                const float fx = (float)x / kGridSize, fy = (float)y / kGridSize;
+                const float dx = 0.6f * cosf(6.f * fx) * cosf(4.f * fy), dy = -0.4f * sinf(6.f * fx) * sinf(4.f * fy);
+                positions.push_back({ fx, fy, 0.1f * sinf(6.f * fx) * cosf(4.f * fy) });
+                uvs.push_back({ fx, 1.f - fy });
+                const float length = sqrtf(dx * dx + dy * dy + 1.f);
+                normals.push_back({ -dx / length, -dy / length, 1.f / length });
+            }
+        }
+        for (uint32_t y = 0; y < kGridSize; y++)
+        {
+            for (uint32_t x = 0; x < kGridSize; x++)
+            {
+                const uint32_t v = y * (kGridSize + 1) + x;
+                triangles.push_back({ v, v + 1, v + kGridSize + 2 });
+                triangles.push_back({ v, v + kGridSize + 2, v + kGridSize + 1 });
+            }
+        }
+
+        auto& bin = bins.emplace_back();
+        auto append = [&](const void* data, size_t size) {
+            const auto offset = (uint32_t)bin.size();
+            bin.insert(bin.end(), (const uint8_t*)data, (const uint8_t*)data + size);
+            return offset;
+        };
+        auto& prim = resource.primitives.emplace_back();
+        prim.vertex_layout_id = kLayout;
+        prim.material_index = 0;
+        prim.vertex_count = kGridVertexCount;
+        prim.index_buffer.buffer_index = 0;
+        prim.index_buffer.index_offset = append(triangles.data(), triangles.size() * sizeof(Triangle));
+        prim.index_buffer.first_index = 0;
+        prim.index_buffer.index_count = (uint32_t)triangles.size() * 3;
+        prim.index_buffer.stride = sizeof(uint32_t);
+        auto addStream = [&](ESkrVertexAttribute attribute, const void* data, uint32_t stride) {
+            auto& vb = prim.vertex_buffers.emplace_back();
+            vb.attribute = attribute;
+            vb.attribute_index = 0;
+            vb.buffer_index = 0;
+            vb.stride = stride;
+            vb.offset = append(data, (size_t)stride * kGridVertexCount);
+        };
+        addStream(SKR_VERT_ATTRIB_POSITION, positions.data(), sizeof(skr_float3_t));
+        addStream(SKR_VERT_ATTRIB_TEXCOORD, uvs.data(), sizeof(skr_float2_t));
+        addStream(SKR_VERT_ATTRIB_NORMAL, normals.data(), sizeof(skr_float3_t));
+        auto& section = resource.sections.emplace_back();
+        section.parent_index = -1;
+        section.primive_indices.emplace_back(0);
+        auto& buffer = resource.bins.emplace_back();
+        buffer.index = 0;
+        buffer.byte_length = bin.size();
+        buffer.compressed_length = 0;
+        buffer.used_with_index = true;
+        buffer.used_with_vertex = true;
+    }
+
+    void TearDown() override
+    {
+        scheduler.unbind();
+    }
+
+    // what the mesh factory uploads, bins are decoded when they were compressed
+    std::vector<uint8_t> Decode(uint32_t bin_index) const
+    {
+        const auto& buffer = resource.bins[bin_index];
+        const auto& bin = bins[bin_index];
+        std::vector<uint8_t> decoded(buffer.byte_length);
+        if (!buffer.compressed_length)
+        {
+            memcpy(decoded.data(), bin.data(), bin.size());
+            return decoded;
+        }
+        EXPECT_EQ(buffer.compressed_length, bin.size());
+        EXPECT_TRUE(skr_mesh_buffer_decode(&buffer, bin.data(), bin.size(), decoded.data()));
+        return decoded;
+    }
+
+    static float HalfToFloat(uint16_t h)
+    {
+        const int exponent = (h >> 10) & 0x1f;
+        const uint32_t mantissa = h & 0x3ff;
+        const float v = exponent ? ldexpf((float)(mantissa | 0x400), exponent - 25) : ldexpf((float)mantissa, -24);
+        return (h & 0x8000) ? -v : v;
+    }
+
+    static uint32_t ReadIndex(const uint8_t* data, uint32_t stride)
+    {
+        if (stride == sizeof(uint16_t)) { uint16_t v; memcpy(&v, data, sizeof(v)); return v; }
+        uint32_t v; memcpy(&v, data, sizeof(v)); return v;
+    }
+
+    // the grid vertex at the cooked position, the cooker reorders vertices but keeps float positions exact
+    std::vector<uint32_t> MatchVertices(const uint8_t* cooked_positions, uint32_t count) const
+    {
+        std::vector<uint32_t> grid_vertices(count, UINT32_MAX);
+        for (uint32_t v = 0; v < count; v++)
+        {
+            skr_float3_t p;
+            memcpy(&p, cooked_positions + v * sizeof(skr_float3_t), sizeof(p));
+            for (uint32_t g = 0; g < kGridVertexCount; g++)
+            {
+                if (!memcmp(&p, &positions[g], sizeof(p))) grid_vertices[v] = g;
+            }
+            EXPECT_NE(grid_vertices[v], UINT32_MAX);
+        }
+        return grid_vertices;
+    }
+
+    // index codecs may rotate triangles, the winding is kept
+    static Triangle Canonical(Triangle t)
+    {
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        return t;
+    }
+
+    static std::vector<Triangle> Sorted(std::vector<Triangle> list)
+    {
+        for (auto& t : list) t = Canonical(t);
+        std::sort(list.begin(), list.end());
+        return list;
+    }
+
+    skr::task::scheduler_t scheduler;
+    std::vector<skr_float3_t> positions;
+    std::vector<skr_float2_t> uvs;
+    std::vector<skr_float3_t> normals;
+    std::vector<Triangle> triangles;
+    skr_mesh_resource_t resource;
+    skr::vector<skr::vector<uint8_t>> bins;
+};
+
+TEST_F(MeshCook, QuantizedStreamsDecodeToTheSourceMesh)
+{
+    skd::asset::SMeshCookConfig cfg = {};
+    cfg.vertexType = kLayout;
+    skd::asset::OptimizeMeshData(&cfg, resource, bins);
+    const auto uncompressed_length = resource.bins[0].byte_length;
+    skd::asset::CompressMeshData(resource, bins);
+    ASSERT_NE(resource.bins[0].compressed_length, 0u);
+    EXPECT_LT(resource.bins[0].compressed_length, uncompressed_length);
+    EXPECT_EQ(resource.bins[0].byte_length, uncompressed_length);
+
+    const auto decoded = Decode(0);
+    const auto& prim = resource.primitives[0];
+    ASSERT_EQ(prim.vertex_count, kGridVertexCount);
+    ASSERT_EQ(prim.vertex_buffers.size(), 3u);
+    EXPECT_EQ(prim.vertex_buffers[0].stride, sizeof(skr_float3_t));
+    EXPECT_EQ(prim.vertex_buffers[1].stride, sizeof(uint16_t) * 2);
+    EXPECT_EQ(prim.vertex_buffers[2].stride, sizeof(int8_t) * 4);
+    // the grid fits 16 bit indices
+    EXPECT_EQ(prim.index_buffer.stride, sizeof(uint16_t));
+    const auto grid_vertices = MatchVertices(decoded.data() + prim.vertex_buffers[0].offset, prim.vertex_count);
+
+    // the same triangles with the same winding
+    ASSERT_EQ(prim.index_buffer.index_count, triangles.size() * 3);
+    std::vector<Triangle> cooked;
+    const uint8_t* indices = decoded.data() + prim.index_buffer.index_offset;
+    for (uint32_t i = 0; i < prim.index_buffer.index_count; i += 3)
+    {
+        auto& t = cooked.emplace_back();
+        for (uint32_t c = 0; c < 3; c++)
+            t[c] = grid_vertices[ReadIndex(indices + (i + c) * prim.index_buffer.stride, prim.index_buffer.stride)];
+    }
+    EXPECT_EQ(Sorted(cooked), Sorted(triangles));
+
+    // attributes within the precision of their formats
+    for (uint32_t v = 0; v < prim.vertex_count; v++)
+    {
+        const auto g = grid_vertices[v];
+        uint16_t uv[2];
+        memcpy(uv, decoded.data() + prim.vertex_buffers[1].offset + v * sizeof(uv), sizeof(uv));
+        EXPECT_NEAR(HalfToFloat(uv[0]), uvs[g].x, 1e-3f);
+        EXPECT_NEAR(HalfToFloat(uv[1]), uvs[g].y, 1e-3f);
+        int8_t n[4];
+        memcpy(n, decoded.data() + prim.vertex_buffers[2].offset + v * sizeof(n), sizeof(n));
+        // octahedral normals come back as snorm xyz
+        EXPECT_NEAR(n[0] / 127.f, normals[g].x, 0.03f);
+        EXPECT_NEAR(n[1] / 127.f, normals[g].y, 0.03f);
+        EXPECT_NEAR(n[2] / 127.f, normals[g].z, 0.03f);
+    }
+}
+
+TEST_F(MeshCook, MeshletsCoverTheTriangles)
+{
+    skd::asset::SMeshCookConfig cfg = {};
+    cfg.vertexType = kLayout;
+    cfg.generateMeshlets = true;
+    cfg.meshletMaxVertices = 32;
+    cfg.meshletMaxTriangles = 32;
+    skd::asset::OptimizeMeshData(&cfg, resource, bins);
+    skd::asset::CompressMeshData(resource, bins);
+    EXPECT_TRUE(resource.bins[0].used_with_meshlet);
+
+    const auto decoded = Decode(0);
+    const auto& prim = resource.primitives[0];
+    ASSERT_GT(prim.meshlets.size(), 1u);
+    ASSERT_EQ(prim.meshlet_buffer.buffer_index, prim.index_buffer.buffer_index);
+    const auto grid_vertices = MatchVertices(decoded.data() + prim.vertex_buffers[0].offset, prim.vertex_count);
+
+    std::vector<Triangle> clustered;
+    for (const auto& meshlet : prim.meshlets)
+    {
+        EXPECT_LE(meshlet.vertex_count, cfg.meshletMaxVertices);
+        EXPECT_LE(meshlet.triangle_count, cfg.meshletMaxTriangles);
+        EXPECT_GT(meshlet.radius, 0.f);
+        const uint8_t* corners = decoded.data() + prim.meshlet_buffer.triangles_offset + meshlet.triangle_offset;
+        for (uint32_t t = 0; t < meshlet.triangle_count; t++)
+        {
+            auto& triangle = clustered.emplace_back();
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                const uint32_t corner = corners[t * 3 + c];
+                EXPECT_LT(corner, meshlet.vertex_count);
+                uint32_t vertex = 0;
+                memcpy(&vertex, decoded.data() + prim.meshlet_buffer.vertices_offset + (meshlet.vertex_offset + corner) * sizeof(uint32_t), sizeof(vertex));
+                EXPECT_LT(vertex, prim.vertex_count);
+                triangle[c] = grid_vertices[vertex];
+            }
+        }
+    }
+    EXPECT_EQ(Sorted(clustered), Sorted(triangles));
+}
+
+TEST_F(MeshCook, LODChainSharesTheVertices)
+{
+    skd::asset::SMeshCookConfig cfg = {};
+    cfg.vertexType = kLayout;
+    cfg.lodCount = 3;
+    cfg.lodReduction = 0.5f;
+    cfg.lodErrors = { 0.05f };
+    skd::asset::OptimizeMeshData(&cfg, resource, bins);
+    skd::asset::CompressMeshData(resource, bins);
+
+    const auto decoded = Decode(0);
+    const auto& prim = resource.primitives[0];
+    ASSERT_GE(prim.lods.size(), 2u);
+    ASSERT_LE(prim.lods.size(), cfg.lodCount);
+    EXPECT_EQ(prim.index_buffer.first_index, 0u);
+    EXPECT_EQ(prim.index_buffer.index_count, triangles.size() * 3);
+    const auto grid_vertices = MatchVertices(decoded.data() + prim.vertex_buffers[0].offset, prim.vertex_count);
+
+    // levels follow lod 0 in its index stream, each a real reduction with a growing error
+    uint32_t next_index = prim.index_buffer.index_count;
+    uint32_t previous_count = prim.index_buffer.index_count;
+    float previous_error = 0.f;
+    const uint8_t* indices = decoded.data() + prim.index_buffer.index_offset;
+    for (const auto& lod : prim.lods)
+    {
+        EXPECT_EQ(lod.first_index, next_index);
+        EXPECT_EQ(lod.index_count % 3, 0u);
+        EXPECT_GT(lod.index_count, 0u);
+        EXPECT_LT(lod.index_count, previous_count * 0.9f);
+        EXPECT_GE(lod.error, previous_error);
+        for (uint32_t i = 0; i < lod.index_count; i++)
+        {
+            const auto vertex = ReadIndex(indices + (lod.first_index + i) * prim.index_buffer.stride, prim.index_buffer.stride);
+            ASSERT_LT(vertex, prim.vertex_count);
+        }
+        next_index = lod.first_index + lod.index_count;
+        previous_count = lod.index_count;
+        previous_error = lod.error;
+    }
+    EXPECT_GT(prim.lods.back().error, 0.f);
+    EXPECT_EQ(resource.bins[0].streams[0].count, next_index);
+
+    // lod 0 is left whole
+    std::vector<Triangle> cooked;
+    for (uint32_t i = 0; i < prim.index_buffer.index_count; i += 3)
+    {
+        auto& t = cooked.emplace_back();
+        for (uint32_t c = 0; c < 3; c++)
+            t[c] = grid_vertices[ReadIndex(indices + (i + c) * prim.index_buffer.stride, prim.index_buffer.stride)];
+    }
+    EXPECT_EQ(Sorted(cooked), Sorted(triangles));
+}
+
+TEST_F(MeshCook, RenderMeshSelectsTheCoarsestLevelWithinTheError)
+{
+    skd::asset::SMeshCookConfig cfg = {};
+    cfg.vertexType = kLayout;
+    cfg.lodCount = 3;
+    cfg.lodErrors = { 0.05f };
+    skd::asset::OptimizeMeshData(&cfg, resource, bins);
+    const auto& prim = resource.primitives[0];
+    ASSERT_GE(prim.lods.size(), 2u);
+
+    // the views only carry the buffer handles, no device is needed
+    skr_render_mesh_t render_mesh;
+    render_mesh.buffers.emplace_back((CGPUBufferId)&render_mesh);
+    skr_render_mesh_initialize(&render_mesh, &resource);
+    ASSERT_EQ(render_mesh.primitive_commands.size(), 1u);
+    const auto& cmd = render_mesh.primitive_commands[0];
+    ASSERT_EQ(cmd.lod_ibvs.size(), prim.lods.size());
+    ASSERT_EQ(cmd.lod_errors.size(), prim.lods.size());
+    for (uint32_t i = 0; i < prim.lods.size(); i++)
+    {
+        const auto& ibv = cmd.lod_ibvs[i];
+        EXPECT_EQ(ibv.buffer, cmd.ibv->buffer);
+        EXPECT_EQ(ibv.offset, cmd.ibv->offset);
+        EXPECT_EQ(ibv.stride, cmd.ibv->stride);
+        EXPECT_EQ(ibv.first_index, prim.lods[i].first_index);
+        EXPECT_EQ(ibv.index_count, prim.lods[i].index_count);
+        EXPECT_EQ(cmd.lod_errors[i], prim.lods[i].error);
+    }
+    EXPECT_EQ(cmd.ibv->first_index, 0u);
+    EXPECT_EQ(cmd.ibv->index_count, prim.index_buffer.index_count);
+
+    // nothing coarser fits under a zero budget, everything fits under an unbounded one
+    EXPECT_EQ(cmd.select_lod(-1.f), cmd.ibv);
+    EXPECT_EQ(cmd.select_lod(FLT_MAX), &cmd.lod_ibvs.back());
+    for (uint32_t i = 0; i < prim.lods.size(); i++)
+    {
+        uint32_t expected = i;
+        while (expected + 1 < prim.lods.size() && prim.lods[expected + 1].error <= prim.lods[i].error) expected++;
+        EXPECT_EQ(cmd.select_lod(prim.lods[i].error), &cmd.lod_ibvs[expected]);
+        if (i + 1 < prim.lods.size() && prim.lods[i + 1].error > prim.lods[i].error)
+            EXPECT_EQ(cmd.select_lod(0.5f * (prim.lods[i].error + prim.lods[i + 1].error)), &cmd.lod_ibvs[i]);
+    }
+}
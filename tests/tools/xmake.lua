@@ -0,0 +1,20 @@
+target("CookCacheTest")
+    set_group("05.tests/tools")
+    set_kind("binary")
+    public_dependency("SkrToolCore", engine_version)
+    add_packages("gtest")
+    add_files("CookCache/CookCache.cpp")
+
+target("CookDatabaseTest")
+    set_group("05.tests/tools")
+    set_kind("binary")
+    public_dependency("SkrToolCore", engine_version)
+    add_packages("gtest")
+    add_files("CookDatabase/CookDatabase.cpp")
+
+target("MeshCookTest")
+    set_group("05.tests/tools")
+    set_kind("binary")
+    public_dependency("SkrMeshCore", engine_version)
+    add_packages("gtest")
+    add_files("MeshCook/MeshCook.cpp")
@@ -4,7 +4,12 @@ includes("fs/xmake.lua")
 includes("daS/xmake.lua")
 includes("module/xmake.lua")
 includes("cgpu/xmake.lua")
+includes("renderer/xmake.lua")
 includes("math/xmake.lua")
 includes("platform/xmake.lua")
 includes("rtti/xmake.lua")
-includes("binary/xmake.lua")
\ No newline at end of file
+includes("binary/xmake.lua")
+includes("animation/xmake.lua")
+if(has_config("build_tools")) then
+    includes("tools/xmake.lua")
+end
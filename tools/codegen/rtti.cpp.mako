@@ -117,7 +117,8 @@ namespace skr::type
             static skr::span<skr_method_t> methods;
         %endif
             constexpr skr_guid_t guid = {${db.guid_constant(record)}};
-            static RecordType type(size, align, name, guid, skr::is_object_v<${record.name}>, base, nativeMethods, fields, methods);
+            uint32_t flags = ${generator.record_flags(record)};
+            static RecordType type(size, align, name, guid, skr::is_object_v<${record.name}>, base, nativeMethods, fields, methods, flags);
             type_of_${record.id} = &type;
         }
         return type_of_${record.id};
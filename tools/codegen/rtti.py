@@ -9,6 +9,36 @@ class Generator(object):
     def filter_rtti(self, records):
         return [record for record in records if hasattr(record.attrs, "rtti")]
 
+    def plain_fields(self, record, excludes):
+        for name, field in vars(record.fields).items():
+            if field.arraySize > 0 or field.type == "skr_blob_arena_t":
+                return False
+            if hasattr(field.attrs, "serialize_config") or hasattr(field.attrs, "arena"):
+                return False
+            for exclude in excludes:
+                if hasattr(field.attrs, exclude):
+                    return False
+        return len(record.bases) <= 1
+
+    def serialize_kinds(self, record):
+        if hasattr(record.attrs, "serialize"):
+            return record.attrs.serialize
+        return []
+
+    def record_flags(self, record):
+        flags = [
+            "(std::is_trivially_copyable_v<%s> ? RECORD_FLAG_TRIVIAL_COPY : 0)" % record.name,
+            "(std::is_trivially_default_constructible_v<%s> ? RECORD_FLAG_TRIVIAL_CTOR : 0)" % record.name,
+        ]
+        if self.plain_fields(record, ["no-rtti"]):
+            flags.append("(std::is_aggregate_v<%s> ? RECORD_FLAG_MEMBERWISE_COPY : 0)" % record.name)
+            plain_serde = not hasattr(record.attrs, "blob") and not hasattr(record.attrs, "serialize_config")
+            if plain_serde and "bin" in self.serialize_kinds(record) and self.plain_fields(record, ["no-rtti", "transient"]):
+                flags.append("RECORD_FLAG_MEMBERWISE_BINARY")
+            if plain_serde and "json" in self.serialize_kinds(record) and self.plain_fields(record, ["no-rtti", "transient", "no-text"]):
+                flags.append("RECORD_FLAG_MEMBERWISE_JSON")
+        return " | ".join(flags)
+
     def generate_forward(self, db, args):
         template = os.path.join(BASE, "rtti.hpp.mako")
         if self.filter_rtti(db.records):
@@ -2,14 +2,11 @@
 #include "platform/guid.hpp"
 #include "utils/defer.hpp"
 #include "utils/log.hpp"
-#include "utils/parallel_for.hpp"
 #include "SkrGLTFTool/mesh_asset.hpp"
 #include "SkrGLTFTool/mesh_processing.hpp"
 #include "SkrToolCore/project/project.hpp"
 #include "SkrToolCore/asset/json_utils.hpp"
 
-#include "MeshOpt/meshoptimizer.h"
-
 #include "tracy/Tracy.hpp"
 
 void* skd::asset::SGltfMeshImporter::Import(skr_io_ram_service_t* ioService, SCookContext* context) 
@@ -68,81 +65,10 @@ bool skd::asset::SMeshCooker::Cook(SCookContext* ctx)
     }
 
     //----- optimize mesh
+    OptimizeMeshData(&cfg, mesh, blobs);
+    if (cfg.compress)
     {
-    ZoneScopedN("WaitOptimizeMesh");
-
-    // allow up to 1% worse ACMR to get more reordering opportunities for overdraw
-	const float kOverDrawThreshold = 1.01f; 
-    // for (auto& prim : mesh.primitives)
-    skr::parallel_for(mesh.primitives.begin(), mesh.primitives.end(), 1, 
-    [&](auto begin, auto end)
-    {
-        ZoneScopedN("OptimizeMesh");
-
-        const auto& prim = *begin;
-        auto& indices_blob = blobs[prim.index_buffer.buffer_index];
-        const auto first_index = prim.index_buffer.first_index;
-        const auto index_stride = prim.index_buffer.stride;
-        const auto index_offset = prim.index_buffer.index_offset;
-        const auto index_count = prim.index_buffer.index_count;
-        const auto vertex_count = prim.vertex_count;
-        eastl::vector<unsigned int> optimized_indices;
-        optimized_indices.resize(index_count);
-        unsigned int* indices_ptr = optimized_indices.data();
-        for (size_t i = 0; i < index_count; i++)
-        {
-            if (index_stride == sizeof(uint8_t))
-                optimized_indices[i] = *(uint8_t*)(indices_blob.data() + index_offset + (first_index + i) * index_stride);
-            else if (index_stride == sizeof(uint16_t))
-                optimized_indices[i] = *(uint16_t*)(indices_blob.data() + index_offset + (first_index + i) * index_stride);
-            else if (index_stride == sizeof(uint32_t))
-                optimized_indices[i] = *(uint32_t*)(indices_blob.data() + index_offset + (first_index + i) * index_stride);
-            else if (index_stride == sizeof(uint64_t))
-                optimized_indices[i] = *(uint64_t*)(indices_blob.data() + index_offset + (first_index + i) * index_stride);
-        }
-        for (size_t i = 0; i < index_count; i++)
-        {
-            SKR_ASSERT(optimized_indices[i] < vertex_count && "Invalid index");
-        }
-
-        // vertex cache optimization should go first as it provides starting order for overdraw
-        meshopt_optimizeVertexCache(indices_ptr, indices_ptr, index_count, vertex_count);
-
-        // reorder indices for overdraw, balancing overdraw and vertex cache efficiency
-        for (const auto& vb : prim.vertex_buffers)
-        {
-            if (vb.attribute == ESkrVertexAttribute::SKR_VERT_ATTRIB_POSITION)
-            {
-                auto& vertices_blob = blobs[vb.buffer_index];
-                const auto vertex_stride = vb.stride;(void)vertex_stride;
-                eastl::vector<skr_float3_t> vertices;
-                vertices.resize(vertex_count);
-                for (size_t i = 0; i < vertex_count; i++)
-                {
-                    vertices[i] = *(skr_float3_t*)(vertices_blob.data() + vb.offset);
-                }
-                meshopt_optimizeOverdraw(indices_ptr, indices_ptr, index_count, 
-                    (float*)vertices.data(), vertices.size(), 
-                    sizeof(skr_float3_t), kOverDrawThreshold);
-
-                // vertex fetch optimization should go last as it depends on the final index order
-                // TODO: meshopt_optimizeVertexFetch
-            }
-        }
-
-        // write optimized indices
-        for (size_t i = 0; i < index_count; i++)
-        {
-            if (index_stride == sizeof(uint8_t))
-                *(uint8_t*)(indices_blob.data() + index_offset + first_index + i * index_stride) = optimized_indices[i];
-            else if (index_stride == sizeof(uint16_t))
-                *(uint16_t*)(indices_blob.data() + index_offset + first_index + i * index_stride) = optimized_indices[i];
-            else if (index_stride == sizeof(uint32_t))
-                *(uint32_t*)(indices_blob.data() + index_offset + first_index + i * index_stride) = optimized_indices[i];
-            else if (index_stride == sizeof(uint64_t))
-                *(uint64_t*)(indices_blob.data() + index_offset + first_index + i * index_stride) = optimized_indices[i];
-        }
-    });
+        CompressMeshData(mesh, blobs);
     }
 
     //----- write materials
@@ -170,6 +96,7 @@ bool skd::asset::SMeshCooker::Cook(SCookContext* ctx)
             return false;
         }
         fwrite(blobs[i].data(), 1, blobs[i].size(), buffer_file);
+        ctx->AddOutputFile(binOutputPath);
     }
     return true;
 }
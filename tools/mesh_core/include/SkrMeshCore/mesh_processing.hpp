@@ -20,6 +20,24 @@ MESH_CORE_API SMeshCookConfig
 {
     sattr("no-default" : true)
     skr_guid_t vertexType;
+
+    // float attributes are converted to the formats of the vertex layout
+    // reorder vertices for fetch locality once the index order is final
+    bool optimizeVertexFetch = true;
+    // encode buffers with meshopt codecs, the mesh factory decodes them on load
+    bool compress = true;
+    // levels of detail generated below lod 0, each targets lodReduction of the triangles of the previous level
+    uint32_t lodCount = 0;
+    float lodReduction = 0.5f;
+    // error bounds of the levels relative to the mesh extents, the last bound is used for the remaining levels
+    skr::vector<float> lodErrors = { 0.01f, 0.02f, 0.05f };
+    // simplify ignoring topology when attribute seams keep a level far above its target
+    bool lodSloppyFallback = true;
+    bool generateMeshlets = false;
+    uint32_t meshletMaxVertices = 64;
+    uint32_t meshletMaxTriangles = 124;
+    // 0 clusters for locality only, up to 1 favors tight normal cones for backface culling
+    float meshletConeWeight = 0.25f;
 };
 
 sreflect_enum_class("guid" : "d6baca1e-eded-4517-a6ad-7abaac3de27b")
@@ -113,6 +131,14 @@ MESH_CORE_API
 void EmplaceStaticRawMeshVertices(const SRawMesh* mesh, const CGPUVertexLayout* layout, skr::vector<uint8_t>& buffer, 
     uint32_t buffer_idx, skr::vector<skr_mesh_primitive_t>& out_primitives);
 
+// reorders every primitive for vertex cache, overdraw and vertex fetch, optionally clusters it into meshlets
+// and converts its vertex streams to the formats of the vertex layout, bins are rebuilt with their streams recorded
+MESH_CORE_API
+void OptimizeMeshData(const SMeshCookConfig* cfg, skr_mesh_resource_t& resource, skr::vector<skr::vector<uint8_t>>& bins);
+
+// encodes the recorded streams of every bin with meshopt codecs, see skr_mesh_buffer_decode
+MESH_CORE_API
+void CompressMeshData(skr_mesh_resource_t& resource, skr::vector<skr::vector<uint8_t>>& bins);
 
 // LUT for raw attributes to semantic names
 static const char* kRawAttributeTypeNameLUT[9] = {
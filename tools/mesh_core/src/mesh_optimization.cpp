@@ -0,0 +1,428 @@
+#include "SkrMeshCore/mesh_processing.hpp"
+#include "SkrRenderer/resources/mesh_resource.h"
+#include "utils/parallel_for.hpp"
+#include "utils/log.h"
+#include "cgpu/api.h"
+#include <EASTL/algorithm.h>
+#include <string.h>
+
+#include "MeshOpt/meshoptimizer.h"
+
+#include "tracy/Tracy.hpp"
+
+namespace skd
+{
+namespace asset
+{
+namespace
+{
+struct SOptimizedStream {
+    skr::vector<uint8_t> data;
+    uint32_t stride = 0;
+    ESkrMeshStreamFilter filter = SKR_MESH_STREAM_FILTER_NONE;
+};
+
+struct SOptimizedPrimitive {
+    // lod 0 followed by the coarser levels
+    skr::vector<uint32_t> indices;
+    uint32_t lod0_index_count = 0;
+    skr::vector<skr_mesh_lod_t> lods;
+    uint32_t vertex_count = 0;
+    // one per vertex buffer entry of the primitive, empty for missing attributes
+    skr::vector<SOptimizedStream> streams;
+    skr::vector<skr_meshlet_t> meshlets;
+    skr::vector<uint32_t> meshlet_vertices;
+    skr::vector<uint8_t> meshlet_triangles;
+};
+
+// allow up to 1% worse ACMR to get more reordering opportunities for overdraw
+static constexpr float kOverDrawThreshold = 1.01f;
+// a level that misses its target by this factor is simplified sloppily
+static constexpr float kLODTargetSlack = 1.5f;
+// levels that remove less than this fraction of the previous one are not worth their memory
+static constexpr float kLODMinReduction = 0.9f;
+
+inline static uint32_t ReadIndex(const uint8_t* src, uint32_t stride)
+{
+    if (stride == sizeof(uint8_t)) return *src;
+    if (stride == sizeof(uint16_t)) { uint16_t v; memcpy(&v, src, sizeof(v)); return v; }
+    uint32_t v; memcpy(&v, src, sizeof(v)); return v;
+}
+
+// glTF stores these attributes as floats unless they are normalized integers, which are left as is
+static bool QuantizeVertexStream(ECGPUFormat format, ESkrVertexAttribute attribute, uint32_t count, SOptimizedStream& stream)
+{
+    if (stream.stride % sizeof(float) != 0 || stream.stride < sizeof(float) * 2)
+        return false;
+    if (attribute == SKR_VERT_ATTRIB_JOINTS || attribute == SKR_VERT_ATTRIB_CUSTOM)
+        return false;
+    enum { kHalf, kSnorm, kUnorm } kind;
+    uint32_t components = 4, bits = 8;
+    switch (format)
+    {
+        case CGPU_FORMAT_R16G16_SFLOAT: kind = kHalf; components = 2; bits = 16; break;
+        case CGPU_FORMAT_R16G16B16A16_SFLOAT: kind = kHalf; bits = 16; break;
+        case CGPU_FORMAT_R8G8B8A8_SNORM: kind = kSnorm; break;
+        case CGPU_FORMAT_R16G16B16A16_SNORM: kind = kSnorm; bits = 16; break;
+        case CGPU_FORMAT_R8G8B8A8_UNORM: kind = kUnorm; break;
+        case CGPU_FORMAT_R16G16B16A16_UNORM: kind = kUnorm; bits = 16; break;
+        default: return false;
+    }
+    const uint32_t src_components = stream.stride / sizeof(float);
+    const uint32_t dst_stride = components * bits / 8;
+    skr::vector<uint8_t> quantized(count * dst_stride);
+    for (uint32_t v = 0; v < count; v++)
+    {
+        for (uint32_t c = 0; c < components; c++)
+        {
+            float f = 0.f;
+            if (c < src_components)
+                memcpy(&f, stream.data.data() + v * stream.stride + c * sizeof(float), sizeof(float));
+            uint8_t* dst = quantized.data() + v * dst_stride + c * bits / 8;
+            int32_t q = 0;
+            if (kind == kHalf) q = meshopt_quantizeHalf(f);
+            else if (kind == kSnorm) q = meshopt_quantizeSnorm(f, bits);
+            else q = meshopt_quantizeUnorm(f, bits);
+            if (bits == 8) *dst = (uint8_t)q;
+            else { const uint16_t q16 = (uint16_t)q; memcpy(dst, &q16, sizeof(q16)); }
+        }
+    }
+    stream.data = std::move(quantized);
+    stream.stride = dst_stride;
+    // unit vectors are stored octahedral in compressed buffers
+    const bool unit_vector = attribute == SKR_VERT_ATTRIB_NORMAL || attribute == SKR_VERT_ATTRIB_TANGENT;
+    stream.filter = (kind == kSnorm && unit_vector) ? SKR_MESH_STREAM_FILTER_OCTAHEDRAL : SKR_MESH_STREAM_FILTER_NONE;
+    return true;
+}
+
+static void OptimizePrimitive(const SMeshCookConfig* cfg, const skr_mesh_primitive_t& prim, const CGPUVertexLayout* layout,
+    const skr::vector<skr::vector<uint8_t>>& bins, SOptimizedPrimitive& out)
+{
+    const auto& ib = prim.index_buffer;
+    const auto& index_blob = bins[ib.buffer_index];
+    const size_t index_count = ib.index_count;
+    out.vertex_count = prim.vertex_count;
+    out.indices.resize(index_count);
+    for (size_t i = 0; i < index_count; i++)
+    {
+        out.indices[i] = ReadIndex(index_blob.data() + ib.index_offset + (ib.first_index + i) * ib.stride, ib.stride);
+        SKR_ASSERT(out.indices[i] < out.vertex_count && "Invalid index");
+    }
+    // gather vertex streams
+    int32_t position_stream = -1;
+    out.streams.resize(prim.vertex_buffers.size());
+    for (uint32_t i = 0; i < prim.vertex_buffers.size(); i++)
+    {
+        const auto& vb = prim.vertex_buffers[i];
+        if (!vb.stride) continue;
+        const auto& blob = bins[vb.buffer_index];
+        const size_t size = (size_t)vb.stride * out.vertex_count;
+        SKR_ASSERT(vb.offset + size <= blob.size());
+        out.streams[i].stride = vb.stride;
+        out.streams[i].data.assign(blob.data() + vb.offset, blob.data() + vb.offset + size);
+        if (vb.attribute == SKR_VERT_ATTRIB_POSITION && vb.stride >= sizeof(skr_float3_t))
+            position_stream = i;
+    }
+    auto positions = [&]() { return position_stream >= 0 ? (const float*)out.streams[position_stream].data.data() : nullptr; };
+    const size_t positions_stride = position_stream >= 0 ? out.streams[position_stream].stride : 0;
+    // meshopt works on triangle lists
+    const bool triangles = index_count % 3 == 0;
+    uint32_t* indices = out.indices.data();
+    if (triangles)
+    {
+        // vertex cache optimization should go first as it provides starting order for overdraw
+        meshopt_optimizeVertexCache(indices, indices, index_count, out.vertex_count);
+        // reorder indices for overdraw, balancing overdraw and vertex cache efficiency
+        if (positions())
+            meshopt_optimizeOverdraw(indices, indices, index_count, positions(), out.vertex_count, positions_stride, kOverDrawThreshold);
+    }
+    out.lod0_index_count = (uint32_t)index_count;
+    // every level simplifies lod 0 and indexes its vertices, so the vertex buffers are shared
+    if (cfg->lodCount && triangles && positions())
+    {
+        ZoneScopedN("GenerateLODs");
+        const float scale = meshopt_simplifyScale(positions(), out.vertex_count, positions_stride);
+        skr::vector<uint32_t> lod0(out.indices);
+        skr::vector<uint32_t> lod(index_count);
+        size_t previous_count = index_count;
+        float reduction = 1.f;
+        for (uint32_t level = 0; level < cfg->lodCount; level++)
+        {
+            reduction *= cfg->lodReduction;
+            const size_t target_count = eastl::max<size_t>(size_t(index_count * reduction) / 3 * 3, 3);
+            const float target_error = cfg->lodErrors.empty() ? 1.f : cfg->lodErrors[eastl::min<size_t>(level, cfg->lodErrors.size() - 1)];
+            float error = 0.f;
+            size_t count = meshopt_simplify(lod.data(), lod0.data(), index_count, positions(), out.vertex_count, positions_stride,
+                target_count, target_error, 0, &error);
+            if (cfg->lodSloppyFallback && count > target_count * kLODTargetSlack)
+            {
+                float sloppy_error = 0.f;
+                skr::vector<uint32_t> sloppy(index_count);
+                const size_t sloppy_count = meshopt_simplifySloppy(sloppy.data(), lod0.data(), index_count, positions(), out.vertex_count, positions_stride,
+                    target_count, target_error, &sloppy_error);
+                if (sloppy_count && sloppy_count < count)
+                {
+                    lod = std::move(sloppy);
+                    count = sloppy_count;
+                    error = sloppy_error;
+                }
+            }
+            if (!count || count > previous_count * kLODMinReduction)
+                break;
+            meshopt_optimizeVertexCache(lod.data(), lod.data(), count, out.vertex_count);
+            auto& entry = out.lods.emplace_back();
+            entry.first_index = (uint32_t)out.indices.size();
+            entry.index_count = (uint32_t)count;
+            entry.error = error * scale;
+            out.indices.insert(out.indices.end(), lod.begin(), lod.begin() + count);
+            lod.resize(index_count);
+            previous_count = count;
+        }
+        indices = out.indices.data();
+    }
+    const size_t all_index_count = out.indices.size();
+    // vertex fetch optimization should go last as it depends on the final index order
+    if (cfg->optimizeVertexFetch)
+    {
+        skr::vector<uint32_t> remap(out.vertex_count);
+        const auto unique_count = (uint32_t)meshopt_optimizeVertexFetchRemap(remap.data(), indices, all_index_count, out.vertex_count);
+        meshopt_remapIndexBuffer(indices, indices, all_index_count, remap.data());
+        for (auto& stream : out.streams)
+        {
+            if (!stream.stride) continue;
+            meshopt_remapVertexBuffer(stream.data.data(), stream.data.data(), out.vertex_count, stream.stride, remap.data());
+            stream.data.resize((size_t)unique_count * stream.stride);
+        }
+        out.vertex_count = unique_count;
+    }
+    if (cfg->generateMeshlets && triangles && positions())
+    {
+        const size_t max_vertices = eastl::clamp(cfg->meshletMaxVertices, 3u, 255u);
+        const size_t max_triangles = eastl::clamp(cfg->meshletMaxTriangles, 4u, 512u) & ~3u;
+        const size_t max_meshlets = meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles);
+        skr::vector<meshopt_Meshlet> meshlets(max_meshlets);
+        out.meshlet_vertices.resize(max_meshlets * max_vertices);
+        out.meshlet_triangles.resize(max_meshlets * max_triangles * 3);
+        const size_t meshlet_count = meshopt_buildMeshlets(meshlets.data(), out.meshlet_vertices.data(), out.meshlet_triangles.data(),
+            indices, index_count, positions(), out.vertex_count, positions_stride, max_vertices, max_triangles, cfg->meshletConeWeight);
+        meshlets.resize(meshlet_count);
+        if (meshlet_count)
+        {
+            // triangles of every meshlet are padded to 4 bytes
+            const auto& last = meshlets.back();
+            out.meshlet_vertices.resize(last.vertex_offset + last.vertex_count);
+            out.meshlet_triangles.resize(last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3u));
+        }
+        else
+        {
+            out.meshlet_vertices.clear();
+            out.meshlet_triangles.clear();
+        }
+        out.meshlets.reserve(meshlet_count);
+        for (const auto& meshlet : meshlets)
+        {
+            const auto bounds = meshopt_computeMeshletBounds(out.meshlet_vertices.data() + meshlet.vertex_offset,
+                out.meshlet_triangles.data() + meshlet.triangle_offset, meshlet.triangle_count,
+                positions(), out.vertex_count, positions_stride);
+            auto& m = out.meshlets.emplace_back();
+            m.vertex_offset = meshlet.vertex_offset;
+            m.triangle_offset = meshlet.triangle_offset;
+            m.vertex_count = meshlet.vertex_count;
+            m.triangle_count = meshlet.triangle_count;
+            m.center = { bounds.center[0], bounds.center[1], bounds.center[2] };
+            m.radius = bounds.radius;
+            m.cone_axis = { bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2] };
+            m.cone_cutoff = bounds.cone_cutoff;
+        }
+    }
+    // quantize last, the steps above read float positions
+    if (layout)
+    {
+        for (uint32_t i = 0; i < out.streams.size() && i < layout->attribute_count; i++)
+        {
+            if (out.streams[i].stride)
+                QuantizeVertexStream(layout->attributes[i].format, prim.vertex_buffers[i].attribute, out.vertex_count, out.streams[i]);
+        }
+    }
+}
+} // namespace
+
+void OptimizeMeshData(const SMeshCookConfig* cfg, skr_mesh_resource_t& resource, skr::vector<skr::vector<uint8_t>>& bins)
+{
+    ZoneScopedN("OptimizeMeshData");
+
+    skr::vector<SOptimizedPrimitive> optimized(resource.primitives.size());
+    skr::parallel_for(resource.primitives.begin(), resource.primitives.end(), 1,
+    [&](auto begin, auto end) {
+        ZoneScopedN("OptimizeMesh");
+        for (auto prim = begin; prim != end; ++prim)
+        {
+            CGPUVertexLayout layout = {};
+            const bool has_layout = skr_mesh_resource_query_vertex_layout(prim->vertex_layout_id, &layout) != nullptr;
+            OptimizePrimitive(cfg, *prim, has_layout ? &layout : nullptr, bins, optimized[prim - resource.primitives.begin()]);
+        }
+    });
+
+    // rebuild bins with the same buffer indices, recording every stream for the compressor
+    skr::vector<skr::vector<uint8_t>> new_bins(bins.size());
+    for (auto& bin : resource.bins)
+    {
+        bin.streams.clear();
+        bin.used_with_meshlet = false;
+    }
+    auto emplaceStream = [&](uint32_t buffer_index, const void* data, uint32_t count, uint32_t stride, ESkrMeshStreamCodec codec, ESkrMeshStreamFilter filter) {
+        auto& blob = new_bins[buffer_index];
+        // keep streams 4 bytes aligned for index & vertex fetch
+        blob.resize((blob.size() + 3) & ~size_t(3));
+        const auto offset = (uint32_t)blob.size();
+        blob.insert(blob.end(), (const uint8_t*)data, (const uint8_t*)data + (size_t)count * stride);
+        auto& stream = resource.bins[buffer_index].streams.emplace_back();
+        stream.codec = codec;
+        stream.filter = filter;
+        stream.count = count;
+        stream.stride = stride;
+        stream.offset = offset;
+        stream.compressed_offset = 0;
+        stream.compressed_size = 0;
+        return offset;
+    };
+    // | prim0-indices | prim1-indices | prim2-indices | prim3-indices | ...
+    for (uint32_t i = 0; i < resource.primitives.size(); i++)
+    {
+        auto& prim = resource.primitives[i];
+        auto& opt = optimized[i];
+        auto& ib = prim.index_buffer;
+        const auto index_count = (uint32_t)opt.indices.size();
+        const auto codec = (index_count % 3 == 0) ? SKR_MESH_STREAM_CODEC_INDEX : SKR_MESH_STREAM_CODEC_NONE;
+        if (opt.vertex_count <= UINT16_MAX)
+        {
+            skr::vector<uint16_t> indices16(opt.indices.begin(), opt.indices.end());
+            ib.index_offset = emplaceStream(ib.buffer_index, indices16.data(), index_count, sizeof(uint16_t), codec, SKR_MESH_STREAM_FILTER_NONE);
+            ib.stride = sizeof(uint16_t);
+        }
+        else
+        {
+            ib.index_offset = emplaceStream(ib.buffer_index, opt.indices.data(), index_count, sizeof(uint32_t), codec, SKR_MESH_STREAM_FILTER_NONE);
+            ib.stride = sizeof(uint32_t);
+        }
+        ib.first_index = 0;
+        ib.index_count = opt.lod0_index_count;
+        prim.lods = std::move(opt.lods);
+        prim.vertex_count = opt.vertex_count;
+    }
+    // | prim0-pos | prim1-pos | prim0-tangent | prim1-tangent | ...
+    size_t attribute_count = 0;
+    for (const auto& prim : resource.primitives)
+        attribute_count = eastl::max(attribute_count, prim.vertex_buffers.size());
+    for (size_t a = 0; a < attribute_count; a++)
+    {
+        for (uint32_t i = 0; i < resource.primitives.size(); i++)
+        {
+            auto& prim = resource.primitives[i];
+            const auto& opt = optimized[i];
+            if (a >= prim.vertex_buffers.size() || !opt.streams[a].stride) continue;
+            auto& vb = prim.vertex_buffers[a];
+            const auto& stream = opt.streams[a];
+            const bool encodable = stream.stride % 4 == 0 && stream.stride <= 256;
+            const auto codec = encodable ? SKR_MESH_STREAM_CODEC_VERTEX : SKR_MESH_STREAM_CODEC_NONE;
+            vb.offset = emplaceStream(vb.buffer_index, stream.data.data(), opt.vertex_count, stream.stride, codec, stream.filter);
+            vb.stride = stream.stride;
+        }
+    }
+    // meshlets live in the buffer of the indices
+    for (uint32_t i = 0; i < resource.primitives.size(); i++)
+    {
+        auto& prim = resource.primitives[i];
+        auto& opt = optimized[i];
+        prim.meshlets = std::move(opt.meshlets);
+        prim.meshlet_buffer = {};
+        if (prim.meshlets.empty()) continue;
+        auto& mb = prim.meshlet_buffer;
+        mb.buffer_index = prim.index_buffer.buffer_index;
+        mb.vertices_offset = emplaceStream(mb.buffer_index, opt.meshlet_vertices.data(), (uint32_t)opt.meshlet_vertices.size(),
+            sizeof(uint32_t), SKR_MESH_STREAM_CODEC_VERTEX, SKR_MESH_STREAM_FILTER_NONE);
+        mb.triangles_offset = emplaceStream(mb.buffer_index, opt.meshlet_triangles.data(), (uint32_t)opt.meshlet_triangles.size() / 4,
+            sizeof(uint32_t), SKR_MESH_STREAM_CODEC_VERTEX, SKR_MESH_STREAM_FILTER_NONE);
+        resource.bins[mb.buffer_index].used_with_meshlet = true;
+    }
+    for (uint32_t i = 0; i < resource.bins.size(); i++)
+    {
+        resource.bins[i].byte_length = new_bins[i].size();
+        resource.bins[i].compressed_length = 0;
+    }
+    bins = std::move(new_bins);
+}
+
+static void EncodeStream(skr_mesh_buffer_stream_t& stream, const uint8_t* src, skr::vector<uint8_t>& out)
+{
+    const size_t size = (size_t)stream.count * stream.stride;
+    const size_t start = out.size();
+    stream.compressed_offset = start;
+    if (stream.codec == SKR_MESH_STREAM_CODEC_INDEX)
+    {
+        skr::vector<uint32_t> indices(stream.count);
+        uint32_t vertex_count = 0;
+        for (uint32_t i = 0; i < stream.count; i++)
+        {
+            indices[i] = ReadIndex(src + i * stream.stride, stream.stride);
+            vertex_count = eastl::max(vertex_count, indices[i] + 1);
+        }
+        out.resize(start + meshopt_encodeIndexBufferBound(stream.count, vertex_count));
+        out.resize(start + meshopt_encodeIndexBuffer(out.data() + start, out.size() - start, indices.data(), stream.count));
+    }
+    else if (stream.codec == SKR_MESH_STREAM_CODEC_VERTEX)
+    {
+        skr::vector<uint8_t> filtered;
+        if (stream.filter == SKR_MESH_STREAM_FILTER_OCTAHEDRAL)
+        {
+            // back to floats, the octahedral encoding keeps the precision of the snorm format
+            const uint32_t bits = stream.stride * 2;
+            const float scale = 1.f / float((1 << (bits - 1)) - 1);
+            skr::vector<float> vectors(stream.count * 4);
+            for (uint32_t i = 0; i < stream.count * 4; i++)
+            {
+                int32_t q = 0;
+                if (bits == 8) q = ((const int8_t*)src)[i];
+                else { int16_t q16; memcpy(&q16, src + i * sizeof(int16_t), sizeof(q16)); q = q16; }
+                vectors[i] = eastl::max(q * scale, -1.f);
+            }
+            filtered.resize(size);
+            meshopt_encodeFilterOct(filtered.data(), stream.count, stream.stride, bits, vectors.data());
+            src = filtered.data();
+        }
+        out.resize(start + meshopt_encodeVertexBufferBound(stream.count, stream.stride));
+        out.resize(start + meshopt_encodeVertexBuffer(out.data() + start, out.size() - start, src, stream.count, stream.stride));
+    }
+    else
+    {
+        out.insert(out.end(), src, src + size);
+    }
+    stream.compressed_size = out.size() - start;
+}
+
+void CompressMeshData(skr_mesh_resource_t& resource, skr::vector<skr::vector<uint8_t>>& bins)
+{
+    ZoneScopedN("CompressMeshData");
+
+    skr::parallel_for(resource.bins.begin(), resource.bins.end(), 1,
+    [&](auto begin, auto end) {
+        for (auto bin = begin; bin != end; ++bin)
+        {
+            const auto index = bin - resource.bins.begin();
+            if (bin->streams.empty()) continue;
+            const auto& decoded = bins[index];
+            skr::vector<uint8_t> compressed;
+            compressed.reserve(decoded.size());
+            for (auto& stream : bin->streams)
+            {
+                EncodeStream(stream, decoded.data() + stream.offset, compressed);
+            }
+            SKR_LOG_DEBUG("mesh buffer %d compressed: %d -> %d bytes", (int)index, (int)decoded.size(), (int)compressed.size());
+            bin->compressed_length = compressed.size();
+            bins[index] = std::move(compressed);
+        }
+    });
+}
+
+} // namespace asset
+} // namespace skd
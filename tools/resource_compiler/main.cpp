@@ -30,6 +30,7 @@
 #include "SkrAnim/resources/animation_resource.h"
 
 #include "tracy/Tracy.hpp"
+#include <stdlib.h>
 
 bool IsAsset(skr::filesystem::path path)
 {
@@ -107,6 +108,10 @@ int compile_all(int argc, char** argv)
     project->assetPath = (root.parent_path() / "../../../samples/application/game/assets").lexically_normal();
     project->outputPath = (root.parent_path() / "resources/game").lexically_normal();
     project->dependencyPath = (root.parent_path() / "deps/game").lexically_normal();
+    if (auto cacheDir = getenv("SKR_COOK_CACHE"); cacheDir && *cacheDir)
+        project->cachePath = skr::filesystem::path(cacheDir).lexically_normal();
+    else
+        project->cachePath = (root.parent_path() / "cook_cache").lexically_normal();
 
     // create VFS
     skr_vfs_desc_t vfs_desc = {};
@@ -147,15 +152,7 @@ int compile_all(int argc, char** argv)
     }
     SKR_LOG_INFO("Project dir scan finished.");
     //----- import project assets (guid & type & path)
-    {
-        using iter_t = typename decltype(paths)::iterator;
-        skr::parallel_for(paths.begin(), paths.end(), 20,
-        [&](iter_t begin, iter_t end) {
-            ZoneScopedN("Import");
-            for (auto i = begin; i != end; ++i)
-                system.ImportAsset(project, *i);
-        });
-    }
+    system.ImportAssets(project, paths);
     SKR_LOG_INFO("Project asset import finished.");
     skr::filesystem::create_directories(project->outputPath, ec);
     skr::filesystem::create_directories(project->dependencyPath, ec);
@@ -69,16 +69,22 @@ public:
     void SetShaderOptions(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, const skr_stable_shader_hash_t& hash) SKR_NOEXCEPT override;
     
     ICompiledShader* Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT override;
+    bool Preprocess(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer, skr::string& output) SKR_NOEXCEPT override;
+    uint64_t GetVersion() const SKR_NOEXCEPT override;
     void FreeCompileResult(ICompiledShader* compiled) SKR_NOEXCEPT override;
 
     void SetIncludeHandler(IDxcIncludeHandler* includeHandler) SKR_NOEXCEPT;
 
 protected:
     void createDefArgsFromOptions(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, eastl::vector<skr::wstring>& def_args) SKR_NOEXCEPT;
+    // arguments shared by compile & preprocess: name, target environment, entry, profile and defines
+    void createCommonArgs(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer, eastl::vector<skr::wstring>& args) SKR_NOEXCEPT;
+    IDxcResult* invoke(IDxcBlobEncoding* source, const eastl::vector<skr::wstring>& args) SKR_NOEXCEPT;
 
     IDxcUtils* utils = nullptr;
     IDxcCompiler3* compiler = nullptr;
     IDxcIncludeHandler* includeHandler = nullptr;
+    uint64_t version = 0;
 
     eastl::vector<skr_shader_option_template_t> switch_defs;
     eastl::vector<skr_shader_option_instance_t> switches;
@@ -60,6 +60,10 @@ struct SKR_SHADER_COMPILER_API IShaderCompiler
     virtual void SetShaderSwitches(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, const skr_stable_shader_hash_t& hash) SKR_NOEXCEPT = 0;
     virtual void SetShaderOptions(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, const skr_stable_shader_hash_t& hash) SKR_NOEXCEPT = 0;
     virtual ICompiledShader* Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT = 0;
+    // runs only the preprocessor with the current switches & options, variants with the same output compile to the same bytecode
+    virtual bool Preprocess(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer, skr::string& output) SKR_NOEXCEPT = 0;
+    // identifies the compiler build and the arguments it passes, part of the bytecode cache key
+    virtual uint64_t GetVersion() const SKR_NOEXCEPT = 0;
     virtual void FreeCompileResult(ICompiledShader* compiled) SKR_NOEXCEPT = 0;
 };
 
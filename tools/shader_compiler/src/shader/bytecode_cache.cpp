@@ -0,0 +1,101 @@
+#include "bytecode_cache.hpp"
+#include "SkrShaderCompiler/assets/shader_asset.hpp"
+#include "platform/process.h"
+#include "utils/hash.h"
+#include "utils/format.hpp"
+#include "utils/defer.hpp"
+#include <atomic>
+
+namespace skd
+{
+namespace asset
+{
+static constexpr uint32_t kBytecodeMagic = 0x43424B53; // SKBC
+static constexpr uint32_t kBytecodeFileVersion = 1;
+
+struct SShaderBytecodeFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t stage;
+    uint32_t flags;
+    uint32_t encoded_digits[4];
+    uint64_t bytecode_size;
+    uint64_t pdb_size;
+};
+
+static skr::filesystem::path BytecodePath(const skr::filesystem::path& root, uint64_t key)
+{
+    return root / fmt::format("{:02x}", key >> 56) / fmt::format("{:016x}.bc", key);
+}
+
+uint64_t ShaderBytecodeKey(const skr::string& preprocessed, const SShaderImporter& importer, ECGPUShaderBytecodeType format, uint64_t compilerVersion)
+{
+    XXH3_state_t state;
+    XXH3_64bits_reset(&state);
+    // defines are already expanded into the preprocessed source
+    XXH3_64bits_update(&state, preprocessed.data(), preprocessed.size());
+    XXH3_64bits_update(&state, importer.entry.c_str(), importer.entry.size() + 1);
+    XXH3_64bits_update(&state, importer.target.c_str(), importer.target.size() + 1);
+    const uint32_t format32 = (uint32_t)format;
+    XXH3_64bits_update(&state, &format32, sizeof(format32));
+    XXH3_64bits_update(&state, &compilerVersion, sizeof(compilerVersion));
+    return XXH3_64bits_digest(&state);
+}
+
+bool LoadCachedBytecode(const skr::filesystem::path& root, uint64_t key, SShaderBytecodeEntry& out)
+{
+    auto file = fopen(BytecodePath(root, key).string().c_str(), "rb");
+    if (!file)
+        return false;
+    SKR_DEFER({ fclose(file); });
+    SShaderBytecodeFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1)
+        return false;
+    if (header.magic != kBytecodeMagic || header.version != kBytecodeFileVersion)
+        return false;
+    out.stage = (ECGPUShaderStage)header.stage;
+    out.flags = header.flags;
+    for (uint32_t i = 0; i < 4; ++i)
+        out.encoded_digits[i] = header.encoded_digits[i];
+    out.bytecode.resize(header.bytecode_size);
+    out.pdb.resize(header.pdb_size);
+    if (header.bytecode_size && fread(out.bytecode.data(), 1, header.bytecode_size, file) != header.bytecode_size)
+        return false;
+    if (header.pdb_size && fread(out.pdb.data(), 1, header.pdb_size, file) != header.pdb_size)
+        return false;
+    return true;
+}
+
+bool StoreCachedBytecode(const skr::filesystem::path& root, uint64_t key, const SShaderBytecodeEntry& entry)
+{
+    static std::atomic_uint64_t counter = 0;
+    const auto path = BytecodePath(root, key);
+    std::error_code ec = {};
+    skr::filesystem::create_directories(path.parent_path(), ec);
+    auto tmp = path;
+    tmp += fmt::format(".{}-{}.tmp", skr_get_current_process_id(), counter++);
+    {
+        auto file = fopen(tmp.string().c_str(), "wb");
+        if (!file)
+            return false;
+        SKR_DEFER({ fclose(file); });
+        SShaderBytecodeFileHeader header = {};
+        header.magic = kBytecodeMagic;
+        header.version = kBytecodeFileVersion;
+        header.stage = (uint32_t)entry.stage;
+        header.flags = entry.flags;
+        for (uint32_t i = 0; i < 4; ++i)
+            header.encoded_digits[i] = entry.encoded_digits[i];
+        header.bytecode_size = entry.bytecode.size();
+        header.pdb_size = entry.pdb.size();
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(entry.bytecode.data(), 1, entry.bytecode.size(), file);
+        fwrite(entry.pdb.data(), 1, entry.pdb.size(), file);
+    }
+    skr::filesystem::rename(tmp, path, ec);
+    if (ec)
+        skr::filesystem::remove(tmp, ec);
+    return !ec;
+}
+} // namespace asset
+} // namespace skd
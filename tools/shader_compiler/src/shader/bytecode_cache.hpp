@@ -0,0 +1,26 @@
+#pragma once
+#include "SkrShaderCompiler/shader_compiler.hpp"
+#include "platform/filesystem.hpp"
+#include "containers/vector.hpp"
+
+namespace skd
+{
+namespace asset
+{
+// compile result of one shader program, independent of the variant that produced it
+struct SShaderBytecodeEntry {
+    ECGPUShaderStage stage = CGPU_SHADER_STAGE_NONE;
+    uint32_t flags = 0;
+    uint32_t encoded_digits[4] = { 0, 0, 0, 0 };
+    skr::vector<uint8_t> bytecode;
+    skr::vector<uint8_t> pdb;
+};
+
+// hashes preprocessed source, entry, target profile, bytecode format and compiler version
+uint64_t ShaderBytecodeKey(const skr::string& preprocessed, const SShaderImporter& importer, ECGPUShaderBytecodeType format, uint64_t compilerVersion);
+
+// persistent bytecode store shared by all cooks, one file per key written with an atomic rename
+bool LoadCachedBytecode(const skr::filesystem::path& root, uint64_t key, SShaderBytecodeEntry& out);
+bool StoreCachedBytecode(const skr::filesystem::path& root, uint64_t key, const SShaderBytecodeEntry& entry);
+} // namespace asset
+} // namespace skd
@@ -195,6 +195,30 @@ IShaderCompiler* SDXCCompiler::Create() SKR_NOEXCEPT
     DxcCreateInstanceT::Get()(CLSID_DxcCompiler, IID_PPV_ARGS(&pCompiler));
     auto compierInstance = SkrNew<SDXCCompiler>(pUtils, pCompiler);
 
+    // bump when the arguments passed by Compile change, cached bytecodes are keyed with it
+    static constexpr uint32_t kArgumentsRevision = 1;
+    uint32_t major = 0, minor = 0, commitCount = 0;
+    IDxcVersionInfo* pVersionInfo = nullptr;
+    if (SUCCEEDED(pCompiler->QueryInterface(IID_PPV_ARGS(&pVersionInfo))))
+    {
+        pVersionInfo->GetVersion(&major, &minor);
+        IDxcVersionInfo2* pVersionInfo2 = nullptr;
+        if (SUCCEEDED(pVersionInfo->QueryInterface(IID_PPV_ARGS(&pVersionInfo2))))
+        {
+            char* commitHash = nullptr;
+            pVersionInfo2->GetCommitInfo(&commitCount, &commitHash);
+            if (commitHash) CoTaskMemFree(commitHash);
+            pVersionInfo2->Release();
+        }
+        pVersionInfo->Release();
+    }
+#if _DEBUG
+    const uint32_t debugArgs = 1;
+#else
+    const uint32_t debugArgs = 0;
+#endif
+    compierInstance->version = ((uint64_t)major << 48) | ((uint64_t)minor << 32) | ((uint64_t)(commitCount & 0xFFFFFF) << 8) | (kArgumentsRevision << 1) | debugArgs;
+
     IDxcIncludeHandler* pIncludeHandler = nullptr;
     pUtils->CreateDefaultIncludeHandler(&pIncludeHandler);
     compierInstance->SetIncludeHandler(pIncludeHandler);
@@ -301,26 +325,12 @@ void SDXCCompiler::createDefArgsFromOptions(skr::span<skr_shader_option_template
     }
 }
 
-ICompiledShader* SDXCCompiler::Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT
+void SDXCCompiler::createCommonArgs(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer, eastl::vector<eastl::wstring>& allArgs) SKR_NOEXCEPT
 {
-    IDxcBlobEncoding* pSourceBlob = nullptr;
-    IDxcResult* pDxcResult = nullptr;
-    if (auto hr = utils->CreateBlobFromPinned(source.bytes, (uint32_t)source.size, DXC_CP_ACP, &pSourceBlob);!SUCCEEDED(hr))
-    {
-        SKR_LOG_ERROR("DXC Compiler: Failed to create blob from pinned memory, HRESULT: %u!", hr);
-    }
-    DxcBuffer SourceBuffer;
-    SourceBuffer.Ptr = pSourceBlob->GetBufferPointer();
-    SourceBuffer.Size = pSourceBlob->GetBufferSize();
-    SourceBuffer.Encoding = DXC_CP_ACP; // Assume BOM says UTF8 or UTF16 or this is ANSI text.
-    
-    // calculate compile arguments
     using utf8_to_utf16 = fmt::detail::utf8_to_utf16;
     const auto wTargetString = utf8_to_utf16(importer.target.c_str());
     const auto wEntryString = utf8_to_utf16(importer.entry.c_str());
     const auto wNameString = utf8_to_utf16(source.source_name.c_str());
-    const auto shader_stage = getShaderStageFromTargetString(importer.target.c_str());
-    eastl::vector<eastl::wstring> allArgs;
     allArgs.emplace_back(wNameString.c_str());
     if (format == CGPU_SHADER_BYTECODE_TYPE_DXIL)
     {
@@ -338,18 +348,13 @@ ICompiledShader* SDXCCompiler::Compile(ECGPUShaderBytecodeType format, const Sha
     // target profile
     allArgs.emplace_back(L"-T");
     allArgs.emplace_back(wTargetString.c_str()); 
-    // optimization
-#if _DEBUG
-    allArgs.emplace_back(DXC_ARG_DEBUG);
-    allArgs.emplace_back(DXC_ARG_SKIP_OPTIMIZATIONS);
-#else
-    allArgs.emplace_back(DXC_ARG_OPTIMIZATION_LEVEL3);
-#endif
-    allArgs.emplace_back(L"-Qstrip_debug"); 
 
     createDefArgsFromOptions(switch_defs, switches, allArgs);
     createDefArgsFromOptions(option_defs, options, allArgs);
+}
 
+IDxcResult* SDXCCompiler::invoke(IDxcBlobEncoding* pSourceBlob, const eastl::vector<eastl::wstring>& allArgs) SKR_NOEXCEPT
+{
 #ifdef TRACY_ENABLE
     eastl::wstring wArgsString;
     for (auto&& arg : allArgs)
@@ -361,35 +366,103 @@ ICompiledShader* SDXCCompiler::Compile(ECGPUShaderBytecodeType format, const Sha
     TracyMessage(msg.c_str(), msg.size());
 #endif
 
-    // do compile
+    DxcBuffer SourceBuffer;
+    SourceBuffer.Ptr = pSourceBlob->GetBufferPointer();
+    SourceBuffer.Size = pSourceBlob->GetBufferSize();
+    SourceBuffer.Encoding = DXC_CP_ACP; // Assume BOM says UTF8 or UTF16 or this is ANSI text.
+
+    IDxcResult* pDxcResult = nullptr;
+    eastl::vector<LPCWSTR> pszArgs;
+    pszArgs.reserve(allArgs.size());
+    for (auto& arg : allArgs)
     {
-        eastl::vector<LPCWSTR> pszArgs;
-        pszArgs.reserve(allArgs.size());
-        for (auto& arg : allArgs)
-        {
-            pszArgs.emplace_back(arg.c_str());
-        }
-        auto hres = compiler->Compile(
-            &SourceBuffer,                // Source buffer.
-            pszArgs.data(),                // Array of pointers to arguments.
-            (UINT32)pszArgs.size(),      // Number of arguments.
-            includeHandler,        // User-provided interface to handle #include directives (optional).
-            IID_PPV_ARGS(&pDxcResult) // Compiler output status, buffer, and errors.
-        );
-        if (!SUCCEEDED(hres))
+        pszArgs.emplace_back(arg.c_str());
+    }
+    auto hres = compiler->Compile(
+        &SourceBuffer,                // Source buffer.
+        pszArgs.data(),                // Array of pointers to arguments.
+        (UINT32)pszArgs.size(),      // Number of arguments.
+        includeHandler,        // User-provided interface to handle #include directives (optional).
+        IID_PPV_ARGS(&pDxcResult) // Compiler output status, buffer, and errors.
+    );
+    if (!SUCCEEDED(hres))
+    {
+        switch (hres)
         {
-            switch (hres)
-            {
-            case 1:
-            default:
-                SKR_UNREACHABLE_CODE();
-            }
-            return nullptr;
+        case 1:
+        default:
+            SKR_UNREACHABLE_CODE();
         }
+        return nullptr;
+    }
+    return pDxcResult;
+}
+
+ICompiledShader* SDXCCompiler::Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT
+{
+    IDxcBlobEncoding* pSourceBlob = nullptr;
+    if (auto hr = utils->CreateBlobFromPinned(source.bytes, (uint32_t)source.size, DXC_CP_ACP, &pSourceBlob);!SUCCEEDED(hr))
+    {
+        SKR_LOG_ERROR("DXC Compiler: Failed to create blob from pinned memory, HRESULT: %u!", hr);
+    }
+    
+    // calculate compile arguments
+    const auto shader_stage = getShaderStageFromTargetString(importer.target.c_str());
+    eastl::vector<eastl::wstring> allArgs;
+    createCommonArgs(format, source, importer, allArgs);
+    // optimization
+#if _DEBUG
+    allArgs.emplace_back(DXC_ARG_DEBUG);
+    allArgs.emplace_back(DXC_ARG_SKIP_OPTIMIZATIONS);
+#else
+    allArgs.emplace_back(DXC_ARG_OPTIMIZATION_LEVEL3);
+#endif
+    allArgs.emplace_back(L"-Qstrip_debug"); 
+
+    // do compile
+    auto pDxcResult = invoke(pSourceBlob, allArgs);
+    if (!pDxcResult)
+    {
+        SAFE_RELEASE(pSourceBlob);
+        return nullptr;
     }
     return SDXCCompiledShader::Create(shader_stage, format, pSourceBlob, pDxcResult);
 }
 
+bool SDXCCompiler::Preprocess(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer, skr::string& output) SKR_NOEXCEPT
+{
+    IDxcBlobEncoding* pSourceBlob = nullptr;
+    if (auto hr = utils->CreateBlobFromPinned(source.bytes, (uint32_t)source.size, DXC_CP_ACP, &pSourceBlob);!SUCCEEDED(hr))
+    {
+        SKR_LOG_ERROR("DXC Compiler: Failed to create blob from pinned memory, HRESULT: %u!", hr);
+        return false;
+    }
+    eastl::vector<eastl::wstring> allArgs;
+    createCommonArgs(format, source, importer, allArgs);
+    allArgs.emplace_back(L"-P");
+
+    auto pDxcResult = invoke(pSourceBlob, allArgs);
+    IDxcBlobUtf8* pPreprocessed = nullptr;
+    HRESULT status = E_FAIL;
+    if (pDxcResult)
+    {
+        pDxcResult->GetStatus(&status);
+        pDxcResult->GetOutput(DXC_OUT_HLSL, IID_PPV_ARGS(&pPreprocessed), nullptr);
+    }
+    const bool succeed = SUCCEEDED(status) && pPreprocessed;
+    if (succeed)
+        output.assign(pPreprocessed->GetStringPointer(), pPreprocessed->GetStringLength());
+    SAFE_RELEASE(pPreprocessed);
+    SAFE_RELEASE(pDxcResult);
+    SAFE_RELEASE(pSourceBlob);
+    return succeed;
+}
+
+uint64_t SDXCCompiler::GetVersion() const SKR_NOEXCEPT
+{
+    return version;
+}
+
 void SDXCCompiler::FreeCompileResult(ICompiledShader* compiled) SKR_NOEXCEPT { SkrDelete(compiled); } 
 
 void SDXCCompiler::SetIncludeHandler(IDxcIncludeHandler* handler) SKR_NOEXCEPT
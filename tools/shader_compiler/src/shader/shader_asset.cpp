@@ -15,6 +15,10 @@
 #include "SkrRenderer/resources/shader_resource.hpp"
 
 #include "utils/cartesian_product.hpp"
+#include "containers/hashmap.hpp"
+#include "platform/thread.h"
+#include "bytecode_cache.hpp"
+#include <atomic>
 
 #include "tracy/Tracy.hpp"
 
@@ -145,94 +149,183 @@ bool SShaderCooker::Cook(SCookContext* ctx)
         ECGPUShaderBytecodeType::CGPU_SHADER_BYTECODE_TYPE_SPIRV
     };
     // begin compile
-    // auto system = skd::asset::GetCookSystem();
     eastl::vector<skr_multi_shader_resource_t> allOutResources(static_variants.size());
-    // foreach variants
-    skr::parallel_for(static_variants.begin(), static_variants.end(), 1,
-    [&](const auto* pVariant, const auto* _) -> void {
-        const auto* shaderImporter = static_cast<SShaderImporter*>(ctx->GetImporter());
-        const uint64_t static_varidx = pVariant - static_variants.begin();
+    // one job per (static variant, dynamic variant, bytecode format)
+    struct CompileJob {
+        uint32_t static_varidx;
+        uint32_t dynamic_varidx;
+        uint32_t fmtIndex;
+        bool supported = false;
+        uint64_t key = 0;
+        uint32_t program = UINT32_MAX;
+    };
+    eastl::vector<CompileJob> jobs;
+    jobs.reserve(static_variants.size() * dynamic_variants.size() * byteCodeFormats.size());
+    for (uint32_t static_varidx = 0; static_varidx < static_variants.size(); ++static_varidx)
+    {
         auto& outResource = allOutResources[static_varidx];
-        outResource.entry = shaderImporter->entry;
+        outResource.entry = importer->entry;
         outResource.stable_hash = static_stable_hashes[static_varidx];
         for (const auto dyn_hash : dynamic_stable_hashes)
         {
             outResource.option_variants[dyn_hash] = {};
             outResource.option_variants[dyn_hash].resize(byteCodeFormats.size());
         }
-
-        // foreach dynamic variants
-        skr::parallel_for(dynamic_variants.begin(), dynamic_variants.end(), 1,
-        [&](const auto* pDynamicVariant, const auto* __) -> void {
-            const uint64_t dynamic_varidx = pDynamicVariant - dynamic_variants.begin();
-            const auto dyn_hash = dynamic_stable_hashes[dynamic_varidx];
-
-            // foreach target profiles
-            skr::parallel_for(byteCodeFormats.begin(), byteCodeFormats.end(), 1,
-            [&](const ECGPUShaderBytecodeType* pFormat, const ECGPUShaderBytecodeType* ___) -> void {
-                ZoneScopedN("Shader Compile Task");
-
-                const ECGPUShaderBytecodeType format = *pFormat;
-                const uint64_t fmtIndex = pFormat - byteCodeFormats.begin();
-
-                auto compiler = SkrShaderCompiler_CreateByType(source_code->source_type);
-                if (compiler->IsSupportedTargetFormat(format))
-                {
-                    auto& identifier = outResource.option_variants[dyn_hash][fmtIndex];
-                    auto& stage = identifier.shader_stage;
-                    // compile & write bytecode to disk
-                    const auto* shaderImporter = static_cast<SShaderImporter*>(ctx->GetImporter());
-                    compiler->SetShaderSwitches(flat_static_options, static_variants[static_varidx], static_stable_hashes[static_varidx]);
-                    compiler->SetShaderOptions(flat_dynamic_options, dynamic_variants[dynamic_varidx], dynamic_stable_hashes[dynamic_varidx]);
-                    auto compiled = compiler->Compile(format, *source_code, *shaderImporter);
-                    stage = compiled->GetShaderStage();
-                    auto bytes = compiled->GetBytecode();
-                    auto hashed = compiled->GetHashCode(&identifier.hash.flags, identifier.hash.encoded_digits);
-                    if (hashed && !bytes.empty())
-                    {
-                        // wirte bytecode to disk
-                        const auto subdir = CGPUShaderBytecodeTypeNames[format];
-                        auto basePath = outputPath.parent_path() / subdir;
-                        const auto fname = skr::format("{}#{}-{}-{}-{}",
-                        identifier.hash.flags, identifier.hash.encoded_digits[0],
-                        identifier.hash.encoded_digits[1], identifier.hash.encoded_digits[2], identifier.hash.encoded_digits[3]);
-                        // create dir
-                        std::error_code ec = {};
-                        skr::filesystem::create_directories(basePath, ec);
-                        // write bytes to file
-                        {
-                            auto bytesPath = basePath / (fname + ".bytes").c_str();
-                            {
-                                auto file = fopen(bytesPath.string().c_str(), "wb");
-                                SKR_DEFER({ fclose(file); });
-                                if (!file) SKR_UNREACHABLE_CODE();
-                                fwrite(bytes.data(), bytes.size(), 1, file);
-                            }
-                        }
-                        // write pdb to file
-                        if (auto pdb = compiled->GetPDB(); !pdb.empty())
-                        {
-                            auto pdbPath = basePath / (fname + ".pdb").c_str();
-                            {
-                                auto pdb_file = fopen(pdbPath.string().c_str(), "wb");
-                                SKR_DEFER({ fclose(pdb_file); });
-                                if (!pdb_file) SKR_UNREACHABLE_CODE();
-                                fwrite(pdb.data(), pdb.size(), 1, pdb_file);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        SKR_UNREACHABLE_CODE();
-                    }
-                    compiler->FreeCompileResult(compiled);
-                    // fill platform identifier
-                    identifier.bytecode_type = format;
-                }
-                SkrShaderCompiler_Destroy(compiler);
-            }); // end foreach target profile
-        });     // end foreach dynamic variant
-    });         // end foreach variant
+        for (uint32_t dynamic_varidx = 0; dynamic_varidx < dynamic_variants.size(); ++dynamic_varidx)
+        {
+            for (uint32_t fmtIndex = 0; fmtIndex < byteCodeFormats.size(); ++fmtIndex)
+                jobs.push_back({ static_varidx, dynamic_varidx, fmtIndex });
+        }
+    }
+    // compilers are expensive to create, jobs run in at most one batch per core and each batch creates its compiler on first use
+    auto forEachBatched = [&](auto begin, auto end, auto f) {
+        const size_t count = end - begin;
+        if (count == 0) return;
+        const size_t workers = eastl::min<size_t>(count, eastl::max(skr_cpu_cores_count(), 1u));
+        skr::parallel_for(begin, end, (count + workers - 1) / workers,
+        [&](auto batchBegin, auto batchEnd) -> void {
+            IShaderCompiler* compiler = nullptr;
+            SKR_DEFER({ if (compiler) SkrShaderCompiler_Destroy(compiler); });
+            auto getCompiler = [&]() {
+                if (!compiler) compiler = SkrShaderCompiler_CreateByType(source_code->source_type);
+                return compiler;
+            };
+            for (auto it = batchBegin; it != batchEnd; ++it)
+                f(getCompiler, *it);
+        });
+    };
+    auto setVariant = [&](IShaderCompiler* compiler, const CompileJob& job) {
+        compiler->SetShaderSwitches(flat_static_options, static_variants[job.static_varidx], static_stable_hashes[job.static_varidx]);
+        compiler->SetShaderOptions(flat_dynamic_options, dynamic_variants[job.dynamic_varidx], dynamic_stable_hashes[job.dynamic_varidx]);
+    };
+    // preprocess every job, variants whose defines don't change the program get the same key
+    {
+        ZoneScopedN("Shader Preprocess");
+        forEachBatched(jobs.begin(), jobs.end(), [&](auto&& getCompiler, CompileJob& job) {
+            auto compiler = getCompiler();
+            const auto format = byteCodeFormats[job.fmtIndex];
+            if (!compiler || !compiler->IsSupportedTargetFormat(format))
+                return;
+            job.supported = true;
+            setVariant(compiler, job);
+            skr::string preprocessed;
+            if (compiler->Preprocess(format, *source_code, *importer, preprocessed))
+                job.key = ShaderBytecodeKey(preprocessed, *importer, format, compiler->GetVersion());
+        });
+    }
+    // deduplicate programs within the cook
+    struct CompileProgram {
+        uint64_t key;
+        uint32_t job;
+        bool succeed = false;
+        ECGPUShaderStage stage = CGPU_SHADER_STAGE_NONE;
+        uint32_t flags = 0;
+        uint32_t encoded_digits[4] = { 0, 0, 0, 0 };
+    };
+    eastl::vector<CompileProgram> programs;
+    {
+        skr::flat_hash_map<uint64_t, uint32_t> programIndices;
+        for (uint32_t i = 0; i < jobs.size(); ++i)
+        {
+            auto& job = jobs[i];
+            if (!job.supported)
+                continue;
+            if (job.key == 0)
+            {
+                // failed to preprocess, compile it alone to get the diagnostics
+                job.program = (uint32_t)programs.size();
+                programs.push_back({ 0, i });
+                continue;
+            }
+            auto found = programIndices.find(job.key);
+            if (found == programIndices.end())
+            {
+                found = programIndices.emplace(job.key, (uint32_t)programs.size()).first;
+                programs.push_back({ job.key, i });
+            }
+            job.program = found->second;
+        }
+    }
+    // load or compile every program once, then write its bytecode to disk
+    const auto bytecodeCacheDir = (assetRecord->project->cachePath.empty() ? assetRecord->project->dependencyPath : assetRecord->project->cachePath) / "shader_bytecode";
+    std::atomic_uint32_t compiledCount = 0;
+    forEachBatched(programs.begin(), programs.end(), [&](auto&& getCompiler, CompileProgram& program) {
+        ZoneScopedN("Shader Compile Task");
+        const auto& job = jobs[program.job];
+        const auto format = byteCodeFormats[job.fmtIndex];
+        SShaderBytecodeEntry entry;
+        if (program.key == 0 || !LoadCachedBytecode(bytecodeCacheDir, program.key, entry))
+        {
+            auto compiler = getCompiler();
+            setVariant(compiler, job);
+            auto compiled = compiler->Compile(format, *source_code, *importer);
+            if (!compiled)
+                return;
+            SKR_DEFER({ compiler->FreeCompileResult(compiled); });
+            entry.stage = compiled->GetShaderStage();
+            if (!compiled->GetHashCode(&entry.flags, entry.encoded_digits))
+                return;
+            auto bytes = compiled->GetBytecode();
+            auto pdb = compiled->GetPDB();
+            entry.bytecode.assign(bytes.begin(), bytes.end());
+            entry.pdb.assign(pdb.begin(), pdb.end());
+            if (program.key != 0)
+                StoreCachedBytecode(bytecodeCacheDir, program.key, entry);
+            compiledCount++;
+        }
+        if (entry.bytecode.empty())
+            return;
+        // wirte bytecode to disk
+        const auto subdir = CGPUShaderBytecodeTypeNames[format];
+        auto basePath = outputPath.parent_path() / subdir;
+        const auto fname = skr::format("{}#{}-{}-{}-{}",
+        entry.flags, entry.encoded_digits[0], entry.encoded_digits[1], entry.encoded_digits[2], entry.encoded_digits[3]);
+        // create dir
+        std::error_code ec = {};
+        skr::filesystem::create_directories(basePath, ec);
+        // files are named by the bytecode hash, an existing file of the same size already holds these bytes
+        auto writeOnce = [&](const skr::filesystem::path& path, const skr::vector<uint8_t>& data) {
+            std::error_code ec = {};
+            if (skr::filesystem::file_size(path, ec) != data.size() || ec)
+            {
+                auto file = fopen(path.string().c_str(), "wb");
+                if (!file) SKR_UNREACHABLE_CODE();
+                SKR_DEFER({ fclose(file); });
+                fwrite(data.data(), data.size(), 1, file);
+            }
+            ctx->AddOutputFile(path);
+        };
+        writeOnce(basePath / (fname + ".bytes").c_str(), entry.bytecode);
+        if (!entry.pdb.empty())
+            writeOnce(basePath / (fname + ".pdb").c_str(), entry.pdb);
+        program.stage = entry.stage;
+        program.flags = entry.flags;
+        for (uint32_t i = 0; i < 4; ++i)
+            program.encoded_digits[i] = entry.encoded_digits[i];
+        program.succeed = true;
+    });
+    SKR_LOG_INFO("[SShaderCooker::Cook] %d jobs, %d unique programs, %d compiled! asset: %s",
+        (int)jobs.size(), (int)programs.size(), (int)compiledCount.load(), assetRecord->path.string().c_str());
+    // fill platform identifiers
+    for (const auto& job : jobs)
+    {
+        if (!job.supported)
+            continue;
+        const auto& program = programs[job.program];
+        if (!program.succeed)
+        {
+            SKR_LOG_FMT_ERROR("[SShaderCooker::Cook] failed to compile shader variant of resource {}! path: {}",
+            assetRecord->guid, assetRecord->path.string());
+            return false;
+        }
+        auto& outResource = allOutResources[job.static_varidx];
+        auto& identifier = outResource.option_variants[dynamic_stable_hashes[job.dynamic_varidx]][job.fmtIndex];
+        identifier.shader_stage = program.stage;
+        identifier.hash.flags = program.flags;
+        for (uint32_t i = 0; i < 4; ++i)
+            identifier.hash.encoded_digits[i] = program.encoded_digits[i];
+        identifier.bytecode_type = byteCodeFormats[job.fmtIndex];
+    }
     
     // resolve output stage
     for (auto&& staticVariant : allOutResources)
@@ -326,6 +419,7 @@ bool SShaderCooker::Cook(SCookContext* ctx)
         }
         SKR_DEFER({ fclose(file); });
         fwrite(writer.buffer.data(), writer.buffer.size(), 1, file);
+        ctx->AddOutputFile(jPath.c_str());
     }
     return true;
 }
@@ -22,6 +22,54 @@ SKR_TEXTURE_COMPILER_API STextureImporter final : public SImporter
 }
 sregister_importer();
 
+// selects the block format and how the mip chain is filtered
+sreflect_enum_class("guid" : "6f0a3d52-8a4f-4b7e-a3c1-0c5f2b9e7d41")
+sattr("serialize" : "json")
+ETextureUsage : uint32_t
+{
+    // gray images cook to BC4, others to Color
+    Auto,
+    // sRGB color, filtered in linear space
+    Color,
+    // tangent space normals in RG, renormalized per mip
+    Normal,
+    // linear data packed in channels (roughness, metallic, occlusion...)
+    Mask,
+    // single linear channel
+    Gray
+};
+
+sreflect_enum_class("guid" : "0b7c6e1d-2f48-4a95-9e36-8d1a4c5b3f20")
+sattr("serialize" : "json")
+ETextureMipFilter : uint32_t
+{
+    Box,
+    // windowed sinc, keeps the mips sharper than Box
+    Kaiser
+};
+
+sreflect_enum_class("guid" : "c4e2b8a7-51d3-4f6e-8b09-7a3d6e2f1c58")
+sattr("serialize" : "json")
+ETextureCodec : uint32_t
+{
+    BC,
+    ASTC
+};
+
+sreflect_struct("guid" : "e3a5f1c2-7d84-4b6a-9c1e-5f2d8b7a4e36")
+sattr("serialize" : "json")
+SKR_TEXTURE_COMPILER_API STextureCookConfig
+{
+    ETextureUsage usage = ETextureUsage::Auto;
+    ETextureCodec codec = ETextureCodec::BC;
+    bool generateMips = true;
+    ETextureMipFilter mipFilter = ETextureMipFilter::Kaiser;
+    // BC1/BC3 instead of BC7 for Color & Mask, half the size for opaque images at a lower quality
+    bool compact = false;
+    // 4, 5, 6 or 8
+    uint32_t astcBlockSize = 6;
+};
+
 sreflect_struct("guid" : "F9B45BF9-3767-4B40-B0B3-D4BBC228BCEC")
 SKR_TEXTURE_COMPILER_API STextureCooker final : public SCooker 
 { 
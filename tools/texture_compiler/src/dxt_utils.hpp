@@ -25,6 +25,9 @@ inline SKR_CONSTEXPR uint64_t Util_DXBCCompressedSize(uint32_t width, uint32_t h
     case CGPU_FORMAT_DXBC4_UNORM:
     case CGPU_FORMAT_DXBC4_SNORM:
         return (blocksW * blocksH) * 8;
+    case CGPU_FORMAT_DXBC5_UNORM:
+    case CGPU_FORMAT_DXBC5_SNORM:
+        return (blocksW * blocksH) * 16;
     case CGPU_FORMAT_DXBC6H_UFLOAT:
     case CGPU_FORMAT_DXBC6H_SFLOAT:
         return (blocksW * blocksH) * 16;
@@ -36,6 +39,38 @@ inline SKR_CONSTEXPR uint64_t Util_DXBCCompressedSize(uint32_t width, uint32_t h
     }
 }
 
+// ASTC blocks are always 16 bytes, only the square sizes supported by the ISPC kernels are listed
+inline SKR_CONSTEXPR ECGPUFormat Util_ASTCFormat(uint32_t block_size, bool srgb)
+{
+    switch (block_size)
+    {
+    case 4:
+        return srgb ? CGPU_FORMAT_ASTC_4x4_SRGB : CGPU_FORMAT_ASTC_4x4_UNORM;
+    case 5:
+        return srgb ? CGPU_FORMAT_ASTC_5x5_SRGB : CGPU_FORMAT_ASTC_5x5_UNORM;
+    case 6:
+        return srgb ? CGPU_FORMAT_ASTC_6x6_SRGB : CGPU_FORMAT_ASTC_6x6_UNORM;
+    case 8:
+        return srgb ? CGPU_FORMAT_ASTC_8x8_SRGB : CGPU_FORMAT_ASTC_8x8_UNORM;
+    default:
+        return CGPU_FORMAT_UNDEFINED;
+    }
+}
+
+inline SKR_CONSTEXPR bool Util_IsASTCFormat(ECGPUFormat format)
+{
+    return format >= CGPU_FORMAT_ASTC_4x4_UNORM && format <= CGPU_FORMAT_ASTC_12x12_SRGB;
+}
+
+inline static uint64_t Util_CompressedSize(uint32_t width, uint32_t height, ECGPUFormat format)
+{
+    const uint64_t block_width = FormatUtil_WidthOfBlock(format);
+    const uint64_t block_height = FormatUtil_HeightOfBlock(format);
+    const uint64_t blocksW = (width + block_width - 1) / block_width;
+    const uint64_t blocksH = (height + block_height - 1) / block_height;
+    return blocksW * blocksH * (FormatUtil_BitSizeOfBlock(format) / 8);
+}
+
 inline static skr::string Util_CompressedTypeString(ECGPUFormat format)
 {
     switch (format)
@@ -51,92 +86,83 @@ inline static skr::string Util_CompressedTypeString(ECGPUFormat format)
     case CGPU_FORMAT_DXBC4_UNORM:
     case CGPU_FORMAT_DXBC4_SNORM:
         return "bc4";
+    case CGPU_FORMAT_DXBC5_UNORM:
+    case CGPU_FORMAT_DXBC5_SNORM:
+        return "bc5";
     case CGPU_FORMAT_DXBC6H_UFLOAT:
     case CGPU_FORMAT_DXBC6H_SFLOAT:
-        return "bc6";
+        return "bc6h";
     case CGPU_FORMAT_DXBC7_UNORM:
     case CGPU_FORMAT_DXBC7_SRGB:
         return "bc7";
     default:
-        return {};
+        return Util_IsASTCFormat(format) ? "astc" : skr::string{};
     }
 }
 
-inline static eastl::vector<uint8_t> Util_DXTCompressWithImageCoder(skr_image_coder_id image_coder, ECGPUFormat compressed_format)
+// bytes per texel of the surface the ISPC kernels expect: R8 for BC4, RG8 for BC5, RGBA8 otherwise
+inline SKR_CONSTEXPR uint32_t Util_CompressorInputBytes(ECGPUFormat format)
 {
-    // fetch RGBA data
-    uint8_t* rgba_data = nullptr;
-    uint64_t rgba_size = 0;
-    const auto bit_depth = image_coder->get_bit_depth();
-    const auto encoded_format = image_coder->get_color_format();
-    const auto raw_format = (encoded_format == IMAGE_CODER_COLOR_FORMAT_BGRA) ? IMAGE_CODER_COLOR_FORMAT_RGBA : encoded_format;
-    bool sucess = skr_image_coder_get_raw_data_view(image_coder, &rgba_data, &rgba_size, raw_format, bit_depth);
-    if (!sucess)
-    {
-        SKR_UNREACHABLE_CODE()
-        return {};
-    }
-    // compress
-    rgba_surface rgba_surface = {};
-    const auto image_width = skr_image_coder_get_width(image_coder);
-    const auto image_height = skr_image_coder_get_height(image_coder);
-    switch (raw_format)
+    switch (format)
     {
-    case IMAGE_CODER_COLOR_FORMAT_RGBA:
-    case IMAGE_CODER_COLOR_FORMAT_BGRA:
-        rgba_surface.stride = image_width * 4;
-        break;
-    case IMAGE_CODER_COLOR_FORMAT_Gray:
-    case IMAGE_CODER_COLOR_FORMAT_GrayF:
-        rgba_surface.stride = image_width;
-        break;
+    case CGPU_FORMAT_DXBC4_UNORM:
+    case CGPU_FORMAT_DXBC4_SNORM:
+        return 1;
+    case CGPU_FORMAT_DXBC5_UNORM:
+    case CGPU_FORMAT_DXBC5_SNORM:
+        return 2;
+    default:
+        return 4;
     }
-    rgba_surface.ptr = rgba_data;
-    rgba_surface.width = image_width;
-    rgba_surface.height = image_height;
-    const auto compressed_size = Util_DXBCCompressedSize(image_width, image_height, compressed_format);
-    eastl::vector<uint8_t> compressed_data(compressed_size);
+}
+
+// compresses a surface whose extent is a multiple of the block size, blocks are written in raster order
+inline static bool Util_CompressSurface(const rgba_surface* surface, uint8_t* compressed_data, ECGPUFormat compressed_format, bool has_alpha)
+{
     switch (compressed_format)
     {
         case CGPU_FORMAT_DXBC1_RGB_UNORM:
         case CGPU_FORMAT_DXBC1_RGB_SRGB:
         case CGPU_FORMAT_DXBC1_RGBA_UNORM:
         case CGPU_FORMAT_DXBC1_RGBA_SRGB:
-            CompressBlocksBC1(&rgba_surface, compressed_data.data());
-            break;
+            CompressBlocksBC1(surface, compressed_data);
+            return true;
         case CGPU_FORMAT_DXBC3_UNORM:
         case CGPU_FORMAT_DXBC3_SRGB:
-            CompressBlocksBC3(&rgba_surface, compressed_data.data());
-            break;
+            CompressBlocksBC3(surface, compressed_data);
+            return true;
         case CGPU_FORMAT_DXBC4_UNORM:
         case CGPU_FORMAT_DXBC4_SNORM:
-            CompressBlocksBC4(&rgba_surface, compressed_data.data());
-            break;
+            CompressBlocksBC4(surface, compressed_data);
+            return true;
         case CGPU_FORMAT_DXBC5_UNORM:
         case CGPU_FORMAT_DXBC5_SNORM:
-            CompressBlocksBC5(&rgba_surface, compressed_data.data());
-            break;
-        case CGPU_FORMAT_DXBC6H_UFLOAT:
-        case CGPU_FORMAT_DXBC6H_SFLOAT:
-            {
-                bc6h_enc_settings bc6_settings = {};
-                GetProfile_bc6h_basic(&bc6_settings);
-                CompressBlocksBC6H(&rgba_surface, compressed_data.data(), &bc6_settings);
-            }
-            break;
+            CompressBlocksBC5(surface, compressed_data);
+            return true;
         case CGPU_FORMAT_DXBC7_UNORM:
         case CGPU_FORMAT_DXBC7_SRGB:
             {
                 bc7_enc_settings bc7_settings = {};
-                GetProfile_basic(&bc7_settings);
-                CompressBlocksBC7(&rgba_surface, compressed_data.data(), &bc7_settings);
+                if (has_alpha) GetProfile_alpha_basic(&bc7_settings);
+                else GetProfile_basic(&bc7_settings);
+                CompressBlocksBC7(surface, compressed_data, &bc7_settings);
             }
-            break;
-        case CGPU_FORMAT_DXBC2_UNORM:
-        case CGPU_FORMAT_DXBC2_SRGB:
+            return true;
         default:
-            SKR_UNREACHABLE_CODE()
-            return {};
+            break;
+    }
+    if (Util_IsASTCFormat(compressed_format))
+    {
+        const auto block_width = (int)FormatUtil_WidthOfBlock(compressed_format);
+        const auto block_height = (int)FormatUtil_HeightOfBlock(compressed_format);
+        if (block_width > 8 || block_height > 8)
+            return false;
+        astc_enc_settings astc_settings = {};
+        if (has_alpha) GetProfile_astc_alpha_fast(&astc_settings, block_width, block_height);
+        else GetProfile_astc_fast(&astc_settings, block_width, block_height);
+        CompressBlocksASTC(surface, compressed_data, &astc_settings);
+        return true;
     }
-    return compressed_data;
-} 
\ No newline at end of file
+    // BC6H needs half float surfaces which the cooker does not produce yet
+    return false;
+}
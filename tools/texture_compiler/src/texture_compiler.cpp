@@ -1,6 +1,7 @@
 #include "SkrToolCore/asset/cook_system.hpp"
 #include "SkrToolCore/project/project.hpp"
-#include "dxt_utils.hpp"
+#include "SkrToolCore/asset/json_utils.hpp"
+#include "texture_mips.hpp"
 #include "utils/io.h"
 #include "utils/log.hpp"
 
@@ -48,34 +49,68 @@ void STextureImporter::Destroy(void *resource)
     SkrDelete((skr_uncompressed_render_texture_t*)resource);
 }
 
+static ECGPUFormat SelectCompressedFormat(const STextureCookConfig& cfg, ETextureUsage usage, bool has_alpha)
+{
+    if (cfg.codec == ETextureCodec::ASTC)
+        return Util_ASTCFormat(cfg.astcBlockSize, usage == ETextureUsage::Color);
+    switch (usage)
+    {
+        case ETextureUsage::Gray:
+            return CGPU_FORMAT_DXBC4_UNORM;
+        case ETextureUsage::Normal:
+            return CGPU_FORMAT_DXBC5_UNORM;
+        case ETextureUsage::Mask:
+            if (!cfg.compact) return CGPU_FORMAT_DXBC7_UNORM;
+            return has_alpha ? CGPU_FORMAT_DXBC3_UNORM : CGPU_FORMAT_DXBC1_RGB_UNORM;
+        case ETextureUsage::Color:
+        default:
+            if (!cfg.compact) return CGPU_FORMAT_DXBC7_SRGB;
+            return has_alpha ? CGPU_FORMAT_DXBC3_SRGB : CGPU_FORMAT_DXBC1_RGB_SRGB;
+    }
+}
+
 bool STextureCooker::Cook(SCookContext *ctx)
 {
     const auto outputPath = ctx->GetOutputPath();
+    const auto cfg = LoadConfig<STextureCookConfig>(ctx);
     auto uncompressed = ctx->Import<skr_uncompressed_render_texture_t>();
     SKR_DEFER({ ctx->Destroy(uncompressed); });
     
-    // try decode texture & calculate compressed format
+    // decode to linear float & select the compressed format by usage
     const auto image_coder = uncompressed->image_coder;
-    const auto format = skr_image_coder_get_color_format(image_coder);
-    ECGPUFormat compressed_format = CGPU_FORMAT_UNDEFINED;
-    switch (format) // TODO: format shuffle
+    auto usage = cfg.usage;
+    if (usage == ETextureUsage::Auto)
     {
-        case IMAGE_CODER_COLOR_FORMAT_Gray: 
-        case IMAGE_CODER_COLOR_FORMAT_GrayF:
-            compressed_format = CGPU_FORMAT_DXBC4_UNORM; 
-            break;
-        case IMAGE_CODER_COLOR_FORMAT_RGBA:
-        default:
-            compressed_format = CGPU_FORMAT_DXBC3_UNORM; 
-            break;
+        const auto format = skr_image_coder_get_color_format(image_coder);
+        const bool gray = (format == IMAGE_CODER_COLOR_FORMAT_Gray) || (format == IMAGE_CODER_COLOR_FORMAT_GrayF);
+        usage = gray ? ETextureUsage::Gray : ETextureUsage::Color;
     }
-    // DXT
-    const auto compressed_data = Util_DXTCompressWithImageCoder(image_coder, compressed_format);
-    // TODO: ASTC
-    // write texture resource
+    skr::vector<STextureMipImage> mips(1);
+    bool has_alpha = false;
+    if (!Util_DecodeLinearImage(image_coder, usage, mips[0], has_alpha))
+    {
+        SKR_LOG_ERROR("[STextureCooker::Cook] failed to decode texture %s!", outputPath.string().c_str());
+        return false;
+    }
+    const auto compressed_format = SelectCompressedFormat(cfg, usage, has_alpha);
+    if (compressed_format == CGPU_FORMAT_UNDEFINED)
+    {
+        SKR_LOG_ERROR("[STextureCooker::Cook] unsupported astc block size %d!", cfg.astcBlockSize);
+        return false;
+    }
+    if (cfg.generateMips)
+        Util_GenerateMips(usage, cfg.mipFilter, mips);
+    // BC & ASTC
+    skr::vector<uint8_t> compressed_data;
     skr_texture_resource_t resource;
+    if (!Util_CompressMips(mips, usage, compressed_format, has_alpha, compressed_data, resource.mips))
+    {
+        SKR_LOG_ERROR("[STextureCooker::Cook] failed to compress texture %s!", outputPath.string().c_str());
+        return false;
+    }
+    // write texture resource
     resource.format = compressed_format;
-    resource.mips_count = 1;
+    resource.mips_count = (uint32_t)resource.mips.size();
     resource.data_size = compressed_data.size();
     resource.height = skr_image_coder_get_height(image_coder);
     resource.width = skr_image_coder_get_width(image_coder);
@@ -86,11 +121,12 @@ bool STextureCooker::Cook(SCookContext *ctx)
     {
         auto extension = Util_CompressedTypeString(compressed_format);
         auto compressed_path = outputPath;
-        auto compressed_pathstr = compressed_path.string();
         compressed_path.replace_extension(extension.c_str());
+        auto compressed_pathstr = compressed_path.string();
         auto compressed_file = fopen(compressed_pathstr.c_str(), "wb");
         SKR_DEFER({ fclose(compressed_file); });
         fwrite(compressed_data.data(), compressed_data.size(), 1, compressed_file);
+        ctx->AddOutputFile(compressed_path);
     }
     return true;
 }
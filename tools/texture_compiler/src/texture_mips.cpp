@@ -0,0 +1,376 @@
+#include "texture_mips.hpp"
+#include "platform/thread.h"
+#include "utils/parallel_for.hpp"
+#include "utils/log.h"
+#include <EASTL/algorithm.h>
+#include <atomic>
+#include <cmath>
+
+#include "tracy/Tracy.hpp"
+
+namespace skd
+{
+namespace asset
+{
+// support of the kaiser windowed sinc in destination texels, and the shape of its window
+static constexpr double kKaiserRadius = 3.0;
+static constexpr double kKaiserAlpha = 4.0;
+// block rows compressed by one task, small enough to spread a 4k level over many workers
+static constexpr uint32_t kTileBlockRows = 8;
+
+template <class F>
+static void ParallelRows(uint32_t count, F f)
+{
+    if (count == 0) return;
+    skr::vector<uint32_t> rows(count);
+    for (uint32_t i = 0; i < count; ++i)
+        rows[i] = i;
+    const uint32_t workers = eastl::max(skr_cpu_cores_count(), 1u) * 4;
+    const size_t batch = eastl::max<size_t>(1, count / workers);
+    skr::parallel_for(rows.begin(), rows.end(), batch, [&](auto begin, auto end) {
+        for (auto it = begin; it != end; ++it)
+            f(*it);
+    });
+}
+
+static float SRGBToLinear(float c)
+{
+    return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float LinearToSRGB(float c)
+{
+    return (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+static uint8_t Quantize(float c)
+{
+    return (uint8_t)(eastl::clamp(c, 0.f, 1.f) * 255.f + 0.5f);
+}
+
+static uint32_t UsageChannels(ETextureUsage usage)
+{
+    switch (usage)
+    {
+    case ETextureUsage::Gray:
+        return 1;
+    case ETextureUsage::Normal:
+        return 3;
+    default:
+        return 4;
+    }
+}
+
+bool Util_DecodeLinearImage(skr_image_coder_id image_coder, ETextureUsage usage, STextureMipImage& out, bool& has_alpha)
+{
+    ZoneScopedN("DecodeLinearImage");
+    uint8_t* raw_data = nullptr;
+    uint64_t raw_size = 0;
+    const auto bit_depth = image_coder->get_bit_depth();
+    const auto encoded_format = image_coder->get_color_format();
+    const auto raw_format = (encoded_format == IMAGE_CODER_COLOR_FORMAT_BGRA) ? IMAGE_CODER_COLOR_FORMAT_RGBA : encoded_format;
+    if (bit_depth != 8 && bit_depth != 16)
+    {
+        SKR_LOG_ERROR("[Util_DecodeLinearImage] unsupported bit depth %d!", bit_depth);
+        return false;
+    }
+    if (!skr_image_coder_get_raw_data_view(image_coder, &raw_data, &raw_size, raw_format, bit_depth))
+        return false;
+    const bool gray = (raw_format == IMAGE_CODER_COLOR_FORMAT_Gray) || (raw_format == IMAGE_CODER_COLOR_FORMAT_GrayF);
+    const uint32_t src_channels = gray ? 1 : 4;
+    out.width = skr_image_coder_get_width(image_coder);
+    out.height = skr_image_coder_get_height(image_coder);
+    out.channels = UsageChannels(usage);
+    if (raw_size < (uint64_t)out.width * out.height * src_channels * (bit_depth / 8))
+        return false;
+    out.texels.resize((size_t)out.width * out.height * out.channels);
+
+    const float max_value = (bit_depth == 8) ? 255.f : 65535.f;
+    auto fetch = [&](uint64_t index) {
+        return (bit_depth == 8) ? raw_data[index] / max_value : ((const uint16_t*)raw_data)[index] / max_value;
+    };
+    std::atomic_bool translucent = false;
+    ParallelRows(out.height, [&](uint32_t y) {
+        bool row_translucent = false;
+        for (uint32_t x = 0; x < out.width; ++x)
+        {
+            const uint64_t src = ((uint64_t)y * out.width + x) * src_channels;
+            float* dst = &out.texels[((size_t)y * out.width + x) * out.channels];
+            float rgba[4];
+            for (uint32_t c = 0; c < 4; ++c)
+                rgba[c] = (c < 3 || !gray) ? fetch(src + (gray ? 0 : c)) : 1.f;
+            row_translucent |= rgba[3] < 1.f;
+            switch (usage)
+            {
+            case ETextureUsage::Color:
+                for (uint32_t c = 0; c < 3; ++c)
+                    dst[c] = SRGBToLinear(rgba[c]);
+                dst[3] = rgba[3];
+                break;
+            case ETextureUsage::Normal:
+                for (uint32_t c = 0; c < 3; ++c)
+                    dst[c] = rgba[c] * 2.f - 1.f;
+                break;
+            case ETextureUsage::Gray:
+                dst[0] = rgba[0];
+                break;
+            default:
+                for (uint32_t c = 0; c < 4; ++c)
+                    dst[c] = rgba[c];
+                break;
+            }
+        }
+        if (row_translucent) translucent = true;
+    });
+    has_alpha = (out.channels == 4) && translucent;
+    return true;
+}
+
+static double BesselI0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (uint32_t k = 1; k < 32; ++k)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+static double KaiserSinc(double t)
+{
+    const double x = t / kKaiserRadius;
+    if (x <= -1.0 || x >= 1.0) return 0.0;
+    const double window = BesselI0(kKaiserAlpha * std::sqrt(1.0 - x * x)) / BesselI0(kKaiserAlpha);
+    const double pt = 3.14159265358979323846 * t;
+    return (std::abs(t) < 1e-6) ? window : window * std::sin(pt) / pt;
+}
+
+// weights of the source texels that make up every destination texel along one axis, edges are clamped
+struct SFilterTaps
+{
+    skr::vector<uint32_t> first;
+    skr::vector<uint32_t> indices;
+    skr::vector<float> weights;
+};
+
+static void BuildTaps(uint32_t src, uint32_t dst, ETextureMipFilter filter, SFilterTaps& taps)
+{
+    const double scale = (double)src / dst;
+    taps.first.resize(dst + 1);
+    auto push = [&](int64_t i, double w) {
+        taps.indices.push_back((uint32_t)eastl::clamp<int64_t>(i, 0, src - 1));
+        taps.weights.push_back((float)w);
+    };
+    for (uint32_t x = 0; x < dst; ++x)
+    {
+        const auto start = (uint32_t)taps.weights.size();
+        taps.first[x] = start;
+        if (filter == ETextureMipFilter::Box)
+        {
+            // area of each source texel covered by the destination footprint, odd extents blend three texels
+            const double lo = x * scale, hi = (x + 1) * scale;
+            for (int64_t i = (int64_t)std::floor(lo); i < (int64_t)std::ceil(hi); ++i)
+            {
+                const double w = eastl::min(hi, (double)i + 1) - eastl::max(lo, (double)i);
+                if (w > 0.0) push(i, w);
+            }
+        }
+        else
+        {
+            const double center = (x + 0.5) * scale;
+            const double stretch = eastl::max(scale, 1.0);
+            const double radius = kKaiserRadius * stretch;
+            for (int64_t i = (int64_t)std::floor(center - radius); i <= (int64_t)std::ceil(center + radius); ++i)
+            {
+                const double w = KaiserSinc((i + 0.5 - center) / stretch);
+                if (w != 0.0) push(i, w);
+            }
+        }
+        double sum = 0.0;
+        for (size_t i = start; i < taps.weights.size(); ++i)
+            sum += taps.weights[i];
+        for (size_t i = start; i < taps.weights.size(); ++i)
+            taps.weights[i] = (float)(taps.weights[i] / sum);
+    }
+    taps.first[dst] = (uint32_t)taps.weights.size();
+}
+
+static void Downsample(const STextureMipImage& src, ETextureUsage usage, ETextureMipFilter filter, STextureMipImage& dst)
+{
+    const uint32_t channels = src.channels;
+    dst.width = eastl::max(1u, src.width >> 1);
+    dst.height = eastl::max(1u, src.height >> 1);
+    dst.channels = channels;
+    dst.texels.resize((size_t)dst.width * dst.height * channels);
+    SFilterTaps horizontal, vertical;
+    BuildTaps(src.width, dst.width, filter, horizontal);
+    BuildTaps(src.height, dst.height, filter, vertical);
+    // separable, rows of the source are filtered horizontally first
+    skr::vector<float> temp((size_t)dst.width * src.height * channels);
+    ParallelRows(src.height, [&](uint32_t y) {
+        const float* src_row = &src.texels[(size_t)y * src.width * channels];
+        float* temp_row = &temp[(size_t)y * dst.width * channels];
+        for (uint32_t x = 0; x < dst.width; ++x)
+        {
+            float sum[4] = { 0.f, 0.f, 0.f, 0.f };
+            for (uint32_t t = horizontal.first[x]; t < horizontal.first[x + 1]; ++t)
+            {
+                const float* texel = src_row + (size_t)horizontal.indices[t] * channels;
+                for (uint32_t c = 0; c < channels; ++c)
+                    sum[c] += texel[c] * horizontal.weights[t];
+            }
+            for (uint32_t c = 0; c < channels; ++c)
+                temp_row[(size_t)x * channels + c] = sum[c];
+        }
+    });
+    ParallelRows(dst.height, [&](uint32_t y) {
+        float* dst_row = &dst.texels[(size_t)y * dst.width * channels];
+        for (uint32_t x = 0; x < dst.width; ++x)
+        {
+            float sum[4] = { 0.f, 0.f, 0.f, 0.f };
+            for (uint32_t t = vertical.first[y]; t < vertical.first[y + 1]; ++t)
+            {
+                const float* texel = &temp[((size_t)vertical.indices[t] * dst.width + x) * channels];
+                for (uint32_t c = 0; c < channels; ++c)
+                    sum[c] += texel[c] * vertical.weights[t];
+            }
+            if (usage == ETextureUsage::Normal)
+            {
+                const float length = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+                if (length > 1e-6f)
+                {
+                    for (uint32_t c = 0; c < 3; ++c)
+                        sum[c] /= length;
+                }
+                else
+                {
+                    sum[0] = sum[1] = 0.f;
+                    sum[2] = 1.f;
+                }
+            }
+            for (uint32_t c = 0; c < channels; ++c)
+                dst_row[(size_t)x * channels + c] = sum[c];
+        }
+    });
+}
+
+void Util_GenerateMips(ETextureUsage usage, ETextureMipFilter filter, skr::vector<STextureMipImage>& mips)
+{
+    ZoneScopedN("GenerateMips");
+    SKR_ASSERT(mips.size() == 1);
+    // each level is filtered from the previous one
+    while (mips.back().width > 1 || mips.back().height > 1)
+    {
+        STextureMipImage next;
+        Downsample(mips.back(), usage, filter, next);
+        mips.emplace_back(std::move(next));
+    }
+}
+
+// writes one texel in the layout the compressor of the format expects
+static void EncodeTexel(const float* texel, ETextureUsage usage, uint32_t input_bytes, uint8_t* dst)
+{
+    switch (usage)
+    {
+    case ETextureUsage::Gray:
+        for (uint32_t c = 0; c < input_bytes; ++c)
+            dst[c] = (c < 3) ? Quantize(texel[0]) : 255;
+        break;
+    case ETextureUsage::Normal:
+        dst[0] = Quantize(texel[0] * 0.5f + 0.5f);
+        dst[1] = Quantize(texel[1] * 0.5f + 0.5f);
+        if (input_bytes == 4)
+        {
+            dst[2] = 0;
+            dst[3] = 255;
+        }
+        break;
+    case ETextureUsage::Color:
+        for (uint32_t c = 0; c < 3; ++c)
+            dst[c] = Quantize(LinearToSRGB(eastl::max(texel[c], 0.f)));
+        dst[3] = Quantize(texel[3]);
+        break;
+    default:
+        for (uint32_t c = 0; c < 4; ++c)
+            dst[c] = Quantize(texel[c]);
+        break;
+    }
+}
+
+bool Util_CompressMips(const skr::vector<STextureMipImage>& mips, ETextureUsage usage, ECGPUFormat format, bool has_alpha,
+    skr::vector<uint8_t>& compressed_data, skr::vector<skr_texture_mip_t>& layout)
+{
+    ZoneScopedN("CompressMips");
+    const uint32_t block_width = FormatUtil_WidthOfBlock(format);
+    const uint32_t block_height = FormatUtil_HeightOfBlock(format);
+    const uint32_t block_bytes = FormatUtil_BitSizeOfBlock(format) / 8;
+    const uint32_t input_bytes = Util_CompressorInputBytes(format);
+    struct Tile
+    {
+        uint32_t mip;
+        uint32_t block_row;
+        uint32_t block_rows;
+    };
+    skr::vector<Tile> tiles;
+    layout.resize(mips.size());
+    uint64_t offset = 0;
+    // the smallest level is stored first, so that the levels from any mip down to 1x1 are a prefix of the file
+    // and streaming in more detail reads the range right before the levels already loaded
+    for (uint32_t mip = (uint32_t)mips.size(); mip-- > 0;)
+    {
+        auto& level = layout[mip];
+        level.width = mips[mip].width;
+        level.height = mips[mip].height;
+        level.offset = offset;
+        level.size = Util_CompressedSize(level.width, level.height, format);
+        offset += level.size;
+    }
+    for (uint32_t mip = 0; mip < mips.size(); ++mip)
+    {
+        const auto& level = layout[mip];
+        const uint32_t block_rows = (level.height + block_height - 1) / block_height;
+        for (uint32_t row = 0; row < block_rows; row += kTileBlockRows)
+            tiles.push_back({ mip, row, eastl::min(kTileBlockRows, block_rows - row) });
+    }
+    compressed_data.resize(offset);
+
+    std::atomic_bool failed = false;
+    const uint32_t workers = eastl::max(skr_cpu_cores_count(), 1u) * 2;
+    const size_t batch = eastl::max<size_t>(1, tiles.size() / workers);
+    skr::parallel_for(tiles.begin(), tiles.end(), batch, [&](auto begin, auto end) {
+        skr::vector<uint8_t> pixels;
+        for (auto tile = begin; tile != end; ++tile)
+        {
+            const auto& image = mips[tile->mip];
+            const uint32_t blocks_x = (image.width + block_width - 1) / block_width;
+            const uint32_t padded_width = blocks_x * block_width;
+            const uint32_t rows = tile->block_rows * block_height;
+            const uint32_t first_row = tile->block_row * block_height;
+            // the compressors read whole blocks, edge texels are replicated into the padding
+            pixels.resize((size_t)padded_width * rows * input_bytes);
+            for (uint32_t y = 0; y < rows; ++y)
+            {
+                const uint32_t sy = eastl::min(first_row + y, image.height - 1);
+                for (uint32_t x = 0; x < padded_width; ++x)
+                {
+                    const uint32_t sx = eastl::min(x, image.width - 1);
+                    const float* texel = &image.texels[((size_t)sy * image.width + sx) * image.channels];
+                    EncodeTexel(texel, usage, input_bytes, &pixels[((size_t)y * padded_width + x) * input_bytes]);
+                }
+            }
+            rgba_surface surface = {};
+            surface.ptr = pixels.data();
+            surface.width = (int32_t)padded_width;
+            surface.height = (int32_t)rows;
+            surface.stride = (int32_t)(padded_width * input_bytes);
+            auto dst = compressed_data.data() + layout[tile->mip].offset + (uint64_t)tile->block_row * blocks_x * block_bytes;
+            if (!Util_CompressSurface(&surface, dst, format, has_alpha))
+                failed = true;
+        }
+    });
+    return !failed;
+}
+} // namespace asset
+} // namespace skd
@@ -0,0 +1,29 @@
+#pragma once
+#include "dxt_utils.hpp"
+#include <containers/vector.hpp>
+
+namespace skd
+{
+namespace asset
+{
+// one mip level in linear float, Normal images hold xyz in [-1, 1]
+struct STextureMipImage
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channels = 0;
+    skr::vector<float> texels;
+};
+
+// decodes the 8 or 16 bit image to float, sRGB color is converted to linear so that filtering is gamma correct
+bool Util_DecodeLinearImage(skr_image_coder_id image_coder, ETextureUsage usage, STextureMipImage& out, bool& has_alpha);
+
+// appends every level below base down to 1x1, rows are filtered in parallel on the task workers
+void Util_GenerateMips(ETextureUsage usage, ETextureMipFilter filter, skr::vector<STextureMipImage>& mips);
+
+// compresses the levels in tiles of block rows on the task workers, levels are stored from the smallest one
+// layout is indexed by level like mips
+bool Util_CompressMips(const skr::vector<STextureMipImage>& mips, ETextureUsage usage, ECGPUFormat format, bool has_alpha,
+    skr::vector<uint8_t>& compressed_data, skr::vector<skr_texture_mip_t>& layout);
+} // namespace asset
+} // namespace skd
@@ -0,0 +1,66 @@
+#pragma once
+#include "SkrToolCore/asset/cook_database.hpp"
+#ifndef __meta__
+    #include "SkrToolCore/asset/cook_cache.generated.h"
+#endif
+
+namespace skd sreflect
+{
+namespace asset sreflect
+{
+// one cook result of an asset, valid while its file and static dependencies still hash the same
+sreflect_struct("guid" : "E1C7D9A3-5B24-4F68-8C0E-93A6B2D4F715")
+sattr("serialize" : "bin")
+SCookCacheEntry
+{
+    // file dependencies relative to the meta file directory
+    skr::vector<SCookFileRecord> files;
+    skr::vector<skr_guid_t> dependencies;
+    // hash of the resource binary of each static dependency at cook time
+    skr::vector<uint64_t> dependencyHashes;
+    // outputs relative to the project output directory, the hash names the cached object
+    skr::vector<SCookFileRecord> outputs;
+};
+
+sreflect_struct("guid" : "4A8B2E6F-D013-47C9-B5A2-1E7F9C3D6B80")
+sattr("serialize" : "bin")
+SCookCacheManifest
+{
+    // most recent first
+    skr::vector<SCookCacheEntry> entries;
+};
+
+// content addressed store of cook outputs, shared by projects, branches and cook runs
+// manifests are keyed by everything known before a cook runs, outputs are stored once per content hash
+struct TOOL_CORE_API SCookCache {
+    static constexpr uint32_t kMaxEntriesPerKey = 4;
+
+    static SCookCache* Open(const skr::filesystem::path& directory);
+    static void Close(SCookCache* cache);
+
+    // hashes asset type, cooker, importer and their versions with the meta content
+    static uint64_t Key(const SAssetRecord* record, uint32_t importerVersion, uint32_t cookerVersion);
+
+    bool Load(uint64_t key, SCookCacheManifest& out);
+    // copies outputs missing in the cache and puts entry in front of the manifest of key
+    bool Store(uint64_t key, const skr::filesystem::path& outputDir, SCookCacheEntry entry);
+    // hardlinks the outputs named after asset into outputDir, the cook system unlinks those before the asset is cooked again
+    // other outputs are shared with other cooks that may rewrite them in place, they are copied, so is everything across volumes
+    bool Restore(const SCookCacheEntry& entry, const skr::filesystem::path& outputDir, const skr_guid_t& asset);
+
+    // outputs named "{asset}.*" belong to one asset alone
+    static bool IsOwnedOutput(const skr::filesystem::path& path, const skr_guid_t& asset);
+    // unlinks every output of asset directly in outputDir, whether a cook record knows it or not,
+    // so that a cooker opening one for writing never truncates a cached object through a link
+    static void RemoveOwnedOutputs(const skr::filesystem::path& outputDir, const skr_guid_t& asset);
+
+protected:
+    skr::filesystem::path ObjectPath(uint64_t hash) const;
+    skr::filesystem::path ManifestPath(uint64_t key) const;
+
+    skr::filesystem::path root;
+    // serializes manifest updates of this process, other processes race on atomic renames
+    SMutexObject manifestMutex;
+};
+} // namespace asset
+} // namespace skd
@@ -0,0 +1,72 @@
+#pragma once
+#include "SkrToolCore/fwd_types.hpp"
+#include "platform/filesystem.hpp"
+#include "platform/thread.h"
+#include "containers/string.hpp"
+#include "containers/vector.hpp"
+#include "containers/hashmap.hpp"
+#include "platform/guid.hpp"
+#ifndef __meta__
+    #include "SkrToolCore/asset/cook_database.generated.h"
+#endif
+
+typedef struct SLightningEnvironment SLightningEnvironment;
+typedef struct SLightningStorage SLightningStorage;
+
+namespace skd sreflect
+{
+namespace asset sreflect
+{
+// identity of a file at the time it was last cooked
+// the content hash is only recomputed when size or write time changed
+sreflect_struct("guid" : "5D4F41A2-6C9B-4E27-9B0A-2E5C3D8F7A61")
+sattr("serialize" : "bin")
+SCookFileRecord
+{
+    skr::string path;
+    uint64_t size = 0;
+    uint64_t timestamp = 0;
+    uint64_t hash = 0;
+};
+
+// state of the inputs and output of the last successful cook of an asset
+sreflect_struct("guid" : "B9E3A7C4-1F2D-4B8E-A6C5-7D0E9F1A2B3C")
+sattr("serialize" : "bin")
+SCookRecord
+{
+    uint32_t importerVersion = 0;
+    uint32_t cookerVersion = 0;
+    SCookFileRecord meta;
+    // files written by the cook relative to the project output directory, the resource binary first
+    skr::vector<SCookFileRecord> outputs;
+    // file dependencies, relative to the meta file directory
+    skr::vector<SCookFileRecord> files;
+    skr::vector<skr_guid_t> dependencies;
+};
+
+// persistent per project database of cook records keyed by asset guid
+// reads are thread safe, stores are queued in memory and written in one transaction by Flush
+struct TOOL_CORE_API SCookDatabase {
+    static SCookDatabase* Open(const skr::filesystem::path& directory);
+    static void Close(SCookDatabase* database);
+
+    bool Load(const skr_guid_t& guid, SCookRecord& out);
+    void Store(const skr_guid_t& guid, SCookRecord record);
+    void Flush();
+
+    // fills size and timestamp of the file at path
+    static bool Stat(const skr::filesystem::path& path, SCookFileRecord& out);
+    // fills size, timestamp and content hash of the file at path
+    static bool Record(const skr::filesystem::path& path, SCookFileRecord& out);
+    // compares the file at path with its record, the content is only hashed if the cheap check fails
+    // refreshed is set when the content is unchanged but size or timestamp moved, the record is updated in place
+    static bool Check(const skr::filesystem::path& path, SCookFileRecord& record, bool& refreshed);
+
+protected:
+    SLightningEnvironment* environment = nullptr;
+    SLightningStorage* storage = nullptr;
+    SMutexObject pendingMutex;
+    skr::flat_hash_map<skr_guid_t, SCookRecord, skr::guid::hash> pending;
+};
+} // namespace asset
+} // namespace skd
@@ -21,6 +21,8 @@ struct SAssetRecord {
     skr_guid_t guid;
     skr_guid_t type;
     skr_guid_t cooker;
+    // importer type parsed from meta at import, so that cook checks don't reparse the meta
+    skr_guid_t importer;
     skr::filesystem::path path;
     simdjson::padded_string meta;
 };
@@ -50,6 +52,11 @@ public:
     virtual const skr_resource_handle_t& GetStaticDependency(uint32_t index) const = 0;
     virtual skr::span<const skr::filesystem::path> GetFileDependencies() const = 0;
 
+    // extra files written by the cooker besides GetOutputPath(), thread safe
+    // they are stored to and restored from the cook cache together with the resource
+    virtual void AddOutputFile(const skr::filesystem::path& path) = 0;
+    virtual skr::vector<skr::filesystem::path> GetOutputFiles() const = 0;
+
     virtual const skr::task::event_t& GetCounter() = 0;
 
     template <class T>
@@ -142,6 +149,8 @@ public:
 
     virtual SAssetRecord* GetAssetRecord(const skr_guid_t& guid) = 0;
     virtual SAssetRecord* ImportAsset(SProject* project, skr::filesystem::path path) = 0;
+    // parses metas of all paths in parallel and caches them
+    virtual void ImportAssets(SProject* project, skr::span<skr::filesystem::path> paths) = 0;
 
     virtual void ParallelForEachAsset(uint32_t batch, skr::function_ref<void(skr::span<SAssetRecord*>)> f) = 0;
 
@@ -18,5 +18,6 @@ struct SAssetRecord;
 struct SCookSystem;
 struct SCooker;
 struct SCookContext;
+struct SCookDatabase;
 }
 }
\ No newline at end of file
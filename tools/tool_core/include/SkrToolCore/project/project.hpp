@@ -8,6 +8,8 @@ struct TOOL_CORE_API SProject {
     skr::filesystem::path assetPath;
     skr::filesystem::path outputPath;
     skr::filesystem::path dependencyPath;
+    // content addressed cook cache, may be shared by several projects; empty to disable
+    skr::filesystem::path cachePath;
     skr_vfs_t* vfs = nullptr;
     skr_vfs_t* resource_vfs = nullptr;
     skr_io_ram_service_t* ram_service = nullptr;
@@ -0,0 +1,197 @@
+#include "SkrToolCore/asset/cook_cache.hpp"
+#include "SkrToolCore/asset/cook_system.hpp"
+#include "platform/process.h"
+#include "binary/reader.h"
+#include "binary/writer.h"
+#include "utils/hash.h"
+#include "utils/format.hpp"
+#include "utils/defer.hpp"
+#include "utils/log.h"
+#include <EASTL/algorithm.h>
+#include <atomic>
+
+#include "tracy/Tracy.hpp"
+
+namespace skd::asset
+{
+// unique per process and call, so that concurrent writers never share a temporary file
+static skr::filesystem::path TemporaryPath(const skr::filesystem::path& path)
+{
+    static std::atomic_uint64_t counter = 0;
+    auto tmp = path;
+    tmp += fmt::format(".{}-{}.tmp", skr_get_current_process_id(), counter++);
+    return tmp;
+}
+
+static bool WriteFileAtomic(const skr::filesystem::path& path, const eastl::vector<uint8_t>& data)
+{
+    std::error_code ec = {};
+    skr::filesystem::create_directories(path.parent_path(), ec);
+    const auto tmp = TemporaryPath(path);
+    {
+        auto file = fopen(tmp.string().c_str(), "wb");
+        if (!file)
+            return false;
+        SKR_DEFER({ fclose(file); });
+        if (fwrite(data.data(), 1, data.size(), file) < data.size())
+            return false;
+    }
+    skr::filesystem::rename(tmp, path, ec);
+    if (ec)
+        skr::filesystem::remove(tmp, ec);
+    return !ec;
+}
+
+SCookCache* SCookCache::Open(const skr::filesystem::path& directory)
+{
+    std::error_code ec = {};
+    skr::filesystem::create_directories(directory, ec);
+    if (ec)
+        return nullptr;
+    auto cache = SkrNew<SCookCache>();
+    cache->root = directory;
+    return cache;
+}
+
+void SCookCache::Close(SCookCache* cache)
+{
+    SkrDelete(cache);
+}
+
+uint64_t SCookCache::Key(const SAssetRecord* record, uint32_t importerVersion, uint32_t cookerVersion)
+{
+    XXH3_state_t state;
+    XXH3_64bits_reset(&state);
+    XXH3_64bits_update(&state, &record->type, sizeof(skr_guid_t));
+    XXH3_64bits_update(&state, &record->cooker, sizeof(skr_guid_t));
+    XXH3_64bits_update(&state, &record->importer, sizeof(skr_guid_t));
+    XXH3_64bits_update(&state, &importerVersion, sizeof(uint32_t));
+    XXH3_64bits_update(&state, &cookerVersion, sizeof(uint32_t));
+    // the meta carries the asset guid and the importer & cooker configs
+    XXH3_64bits_update(&state, record->meta.data(), record->meta.size());
+    return XXH3_64bits_digest(&state);
+}
+
+skr::filesystem::path SCookCache::ObjectPath(uint64_t hash) const
+{
+    return root / "objects" / fmt::format("{:02x}", hash >> 56) / fmt::format("{:016x}", hash);
+}
+
+skr::filesystem::path SCookCache::ManifestPath(uint64_t key) const
+{
+    return root / "manifests" / fmt::format("{:02x}", key >> 56) / fmt::format("{:016x}", key);
+}
+
+bool SCookCache::Load(uint64_t key, SCookCacheManifest& out)
+{
+    auto file = fopen(ManifestPath(key).string().c_str(), "rb");
+    if (!file)
+        return false;
+    SKR_DEFER({ fclose(file); });
+    eastl::vector<uint8_t> buffer;
+    uint8_t chunk[4096];
+    size_t read = 0;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        buffer.insert(buffer.end(), chunk, chunk + read);
+    skr::binary::SpanReader reader = { { buffer.data(), buffer.size() } };
+    skr_binary_reader_t archive{ reader };
+    return skr::binary::Read(&archive, out) == 0;
+}
+
+bool SCookCache::Store(uint64_t key, const skr::filesystem::path& outputDir, SCookCacheEntry entry)
+{
+    ZoneScopedN("StoreCookCache");
+    std::error_code ec = {};
+    for (const auto& output : entry.outputs)
+    {
+        const auto object = ObjectPath(output.hash);
+        if (skr::filesystem::exists(object, ec))
+            continue;
+        skr::filesystem::create_directories(object.parent_path(), ec);
+        const auto tmp = TemporaryPath(object);
+        // copied rather than moved or linked, the cooked output stays owned by the output directory
+        skr::filesystem::copy_file(outputDir / output.path.c_str(), tmp, ec);
+        if (!ec)
+            skr::filesystem::rename(tmp, object, ec);
+        if (ec)
+        {
+            skr::filesystem::remove(tmp, ec);
+            SKR_LOG_WARN("[SCookCache::Store] failed to store output %s!", output.path.c_str());
+            return false;
+        }
+    }
+    SMutexLock lock(manifestMutex.mMutex);
+    SCookCacheManifest manifest;
+    Load(key, manifest);
+    // an entry with the same inputs is replaced, the outputs of a deterministic cook are the same anyway
+    auto sameInputs = [&](const SCookCacheEntry& other) {
+        if (other.files.size() != entry.files.size() || other.dependencyHashes != entry.dependencyHashes)
+            return false;
+        for (size_t i = 0; i < other.files.size(); ++i)
+        {
+            if (other.files[i].hash != entry.files[i].hash || other.files[i].path != entry.files[i].path)
+                return false;
+        }
+        return true;
+    };
+    manifest.entries.erase(eastl::remove_if(manifest.entries.begin(), manifest.entries.end(), sameInputs), manifest.entries.end());
+    manifest.entries.insert(manifest.entries.begin(), std::move(entry));
+    if (manifest.entries.size() > kMaxEntriesPerKey)
+        manifest.entries.resize(kMaxEntriesPerKey);
+    eastl::vector<uint8_t> buffer;
+    skr::binary::VectorWriter writer{ &buffer };
+    skr_binary_writer_t archive(writer);
+    if (skr::binary::Archive(&archive, manifest) != 0)
+        return false;
+    return WriteFileAtomic(ManifestPath(key), buffer);
+}
+
+bool SCookCache::IsOwnedOutput(const skr::filesystem::path& path, const skr_guid_t& asset)
+{
+    const auto prefix = fmt::format("{}.", asset);
+    return path.filename().string().rfind(prefix, 0) == 0;
+}
+
+void SCookCache::RemoveOwnedOutputs(const skr::filesystem::path& outputDir, const skr_guid_t& asset)
+{
+    const auto prefix = fmt::format("{}.", asset);
+    std::error_code ec = {};
+    eastl::vector<skr::filesystem::path> owned;
+    for (auto iter = skr::filesystem::directory_iterator(outputDir, ec); !ec && iter != skr::filesystem::directory_iterator(); iter.increment(ec))
+    {
+        if (iter->path().filename().string().rfind(prefix, 0) == 0)
+            owned.emplace_back(iter->path());
+    }
+    for (const auto& path : owned)
+        skr::filesystem::remove(path, ec);
+}
+
+bool SCookCache::Restore(const SCookCacheEntry& entry, const skr::filesystem::path& outputDir, const skr_guid_t& asset)
+{
+    ZoneScopedN("RestoreCookCache");
+    std::error_code ec = {};
+    for (const auto& output : entry.outputs)
+    {
+        const auto object = ObjectPath(output.hash);
+        const auto path = outputDir / output.path.c_str();
+        skr::filesystem::create_directories(path.parent_path(), ec);
+        // never write through an old link into the cache
+        skr::filesystem::remove(path, ec);
+        ec.clear();
+        // a link is only safe where nothing opens the file for writing without unlinking it first
+        if (IsOwnedOutput(path, asset))
+            skr::filesystem::create_hard_link(object, path, ec);
+        if (ec || !IsOwnedOutput(path, asset))
+        {
+            ec.clear();
+            skr::filesystem::copy_file(object, path, ec);
+        }
+        if (ec)
+        {
+            SKR_LOG_WARN("[SCookCache::Restore] failed to restore output %s!", output.path.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace skd::asset
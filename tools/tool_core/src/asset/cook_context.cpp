@@ -3,6 +3,7 @@
 #include "SkrToolCore/project/project.hpp"
 #include "SkrToolCore/asset/cook_system.hpp"
 #include "utils/io.h"
+#include "platform/thread.h"
 #include "json/reader.h"
 
 namespace skd::asset
@@ -28,6 +29,8 @@ struct SCookContextImpl : public SCookContext
     skr::span<const skr_resource_handle_t> GetStaticDependencies() const override;
     skr::span<const skr::filesystem::path> GetFileDependencies() const override;
     const skr_resource_handle_t& GetStaticDependency(uint32_t index) const override;
+    void AddOutputFile(const skr::filesystem::path& path) override;
+    skr::vector<skr::filesystem::path> GetOutputFiles() const override;
 
     const skr::task::event_t& GetCounter() override
     {
@@ -66,6 +69,8 @@ struct SCookContextImpl : public SCookContext
     skr::vector<skr_resource_handle_t> staticDependencies;
     skr::vector<skr_guid_t> runtimeDependencies;
     skr::vector<skr::filesystem::path> fileDependencies;
+    mutable SMutexObject outputMutex;
+    skr::vector<skr::filesystem::path> outputFiles;
 
     SCookContextImpl(skr_io_ram_service_t* ioService)
         : ioService(ioService)
@@ -216,6 +221,20 @@ skr::span<const skr::filesystem::path> SCookContextImpl::GetFileDependencies() c
     return fileDependencies;
 }
 
+void SCookContextImpl::AddOutputFile(const skr::filesystem::path& path)
+{
+    SMutexLock lock(outputMutex.mMutex);
+    auto iter = std::find(outputFiles.begin(), outputFiles.end(), path);
+    if (iter == outputFiles.end())
+        outputFiles.push_back(path);
+}
+
+skr::vector<skr::filesystem::path> SCookContextImpl::GetOutputFiles() const
+{
+    SMutexLock lock(outputMutex.mMutex);
+    return outputFiles;
+}
+
 skr::span<const skr_resource_handle_t> SCookContextImpl::GetStaticDependencies() const
 {
     return skr::span<const skr_resource_handle_t>(staticDependencies.data(), staticDependencies.size());
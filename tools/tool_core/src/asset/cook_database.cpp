@@ -0,0 +1,154 @@
+#include "SkrToolCore/asset/cook_database.hpp"
+#include "lightning_storage/storage.h"
+#include "lightning_storage/transaction.h"
+#include "binary/reader.h"
+#include "binary/writer.h"
+#include "utils/hash.h"
+#include "utils/defer.hpp"
+#include "utils/log.h"
+
+#include "tracy/Tracy.hpp"
+
+namespace skd::asset
+{
+SCookDatabase* SCookDatabase::Open(const skr::filesystem::path& directory)
+{
+    auto environment = skr_lightning_storage_create_environment(directory.string().c_str());
+    if (!environment)
+        return nullptr;
+    SLightningStorageOpenDescriptor desc = {};
+    desc.name = "cook_records";
+    desc.flags = LIGHTNING_STORAGE_OPEN_CREATE;
+    auto storage = skr_open_lightning_storage(environment, &desc);
+    if (!storage)
+    {
+        skr_lightning_storage_free_environment(environment);
+        return nullptr;
+    }
+    auto database = SkrNew<SCookDatabase>();
+    database->environment = environment;
+    database->storage = storage;
+    return database;
+}
+
+void SCookDatabase::Close(SCookDatabase* database)
+{
+    database->Flush();
+    skr_close_lightning_storage(database->storage);
+    skr_lightning_storage_free_environment(database->environment);
+    SkrDelete(database);
+}
+
+bool SCookDatabase::Load(const skr_guid_t& guid, SCookRecord& out)
+{
+    {
+        SMutexLock lock(pendingMutex.mMutex);
+        auto it = pending.find(guid);
+        if (it != pending.end())
+        {
+            out = it->second;
+            return true;
+        }
+    }
+    auto txn = skr_lightning_transaction_begin(environment, LIGHTNING_TRANSACTION_READ_ONLY);
+    if (!txn)
+        return false;
+    SKR_DEFER({ skr_lightning_transaction_abort(txn); });
+    SLightningStorageValue key = { sizeof(skr_guid_t), &guid };
+    SLightningStorageValue value = {};
+    if (!skr_lightning_storage_read(storage, txn, &key, &value))
+        return false;
+    skr::binary::SpanReader reader = { { (const uint8_t*)value.data, value.size } };
+    skr_binary_reader_t archive{ reader };
+    return skr::binary::Read(&archive, out) == 0;
+}
+
+void SCookDatabase::Store(const skr_guid_t& guid, SCookRecord record)
+{
+    SMutexLock lock(pendingMutex.mMutex);
+    pending.insert_or_assign(guid, std::move(record));
+}
+
+void SCookDatabase::Flush()
+{
+    ZoneScopedN("FlushCookDatabase");
+    SMutexLock lock(pendingMutex.mMutex);
+    if (pending.empty())
+        return;
+    auto txn = skr_lightning_transaction_begin(environment, LIGHTNING_TRANSACTION_READ_WRITE);
+    if (!txn)
+        return;
+    eastl::vector<uint8_t> buffer;
+    for (auto& pair : pending)
+    {
+        buffer.clear();
+        skr::binary::VectorWriter writer{ &buffer };
+        skr_binary_writer_t archive(writer);
+        if (skr::binary::Archive(&archive, pair.second) != 0)
+            continue;
+        SLightningStorageValue key = { sizeof(skr_guid_t), &pair.first };
+        SLightningStorageValue value = { buffer.size(), buffer.data() };
+        if (!skr_lightning_storage_write(storage, txn, &key, &value))
+        {
+            skr_lightning_transaction_abort(txn);
+            return;
+        }
+    }
+    if (skr_lightning_transaction_commit(txn))
+        pending.clear();
+}
+
+static bool StatFile(const skr::filesystem::path& path, uint64_t& size, uint64_t& timestamp)
+{
+    std::error_code ec = {};
+    size = (uint64_t)skr::filesystem::file_size(path, ec);
+    if (ec)
+        return false;
+    timestamp = (uint64_t)skr::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    return !ec;
+}
+
+static bool HashFile(const skr::filesystem::path& path, uint64_t& hash)
+{
+    auto file = fopen(path.string().c_str(), "rb");
+    if (!file)
+        return false;
+    SKR_DEFER({ fclose(file); });
+    XXH3_state_t state;
+    XXH3_64bits_reset(&state);
+    uint8_t buffer[64 * 1024];
+    size_t read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        XXH3_64bits_update(&state, buffer, read);
+    if (ferror(file))
+        return false;
+    hash = XXH3_64bits_digest(&state);
+    return true;
+}
+
+bool SCookDatabase::Stat(const skr::filesystem::path& path, SCookFileRecord& out)
+{
+    return StatFile(path, out.size, out.timestamp);
+}
+
+bool SCookDatabase::Record(const skr::filesystem::path& path, SCookFileRecord& out)
+{
+    return StatFile(path, out.size, out.timestamp) && HashFile(path, out.hash);
+}
+
+bool SCookDatabase::Check(const skr::filesystem::path& path, SCookFileRecord& record, bool& refreshed)
+{
+    uint64_t size = 0, timestamp = 0;
+    if (!StatFile(path, size, timestamp))
+        return false;
+    if (size == record.size && timestamp == record.timestamp)
+        return true;
+    // touched by a checkout or a copy, only a different content is a change
+    uint64_t hash = 0;
+    if (size != record.size || !HashFile(path, hash) || hash != record.hash)
+        return false;
+    record.timestamp = timestamp;
+    refreshed = true;
+    return true;
+}
+} // namespace skd::asset
@@ -1,6 +1,8 @@
 #include "module/module.hpp"
 #include "utils/parallel_for.hpp"
 #include "SkrToolCore/asset/cook_system.hpp"
+#include "SkrToolCore/asset/cook_database.hpp"
+#include "SkrToolCore/asset/cook_cache.hpp"
 #include "SkrToolCore/asset/importer.hpp"
 #include "SkrToolCore/project/project.hpp"
 #include "platform/guid.hpp"
@@ -9,7 +11,6 @@
 #include "utils/io.h"
 
 #include "json/reader.h"
-#include "json/writer.h"
 #include "binary/writer.h"
 #include <atomic>
 
@@ -22,7 +23,10 @@ struct SCookSystemImpl : public skd::asset::SCookSystem
     friend struct ::SkrToolCoreModule;
     using AssetMap = skr::flat_hash_map<skr_guid_t, SAssetRecord*, skr::guid::hash>;
     using CookingMap = skr::parallel_flat_hash_map<skr_guid_t, SCookContext*, skr::guid::hash>;
+    using DatabaseMap = skr::flat_hash_map<SProject*, SCookDatabase*>;
+    using CacheMap = skr::flat_hash_map<SProject*, SCookCache*>;
 
+    void Shutdown() override;
     skr::task::event_t AddCookTask(skr_guid_t resource) override;
     skr::task::event_t EnsureCooked(skr_guid_t resource) override;
     void WaitForAll() override;
@@ -51,8 +55,21 @@ struct SCookSystemImpl : public skd::asset::SCookSystem
 
     SAssetRecord* GetAssetRecord(const skr_guid_t& guid) override;
     SAssetRecord* ImportAsset(SProject* project, skr::filesystem::path path) override;
+    void ImportAssets(SProject* project, skr::span<skr::filesystem::path> paths) override;
     skr_io_ram_service_t* getIOService() override;
 
+    SAssetRecord* LoadAssetRecord(simdjson::ondemand::parser& parser, SProject* project, skr::filesystem::path path);
+    // opened on first use in the dependency directory of the project
+    SCookDatabase* GetCookDatabase(SProject* project);
+    // nullptr if the project has no cache path
+    SCookCache* GetCookCache(SProject* project);
+    SCookRecord MakeCookRecord(SCookContext* context);
+    // hash of the resource binary of a static dependency, 0 for raw assets which are tracked as files
+    bool GetDependencyHash(SProject* project, skr_guid_t dependency, uint64_t& hash);
+    bool RestoreFromCache(SCookCache* cache, uint64_t key, SAssetRecord* record, uint32_t importerVersion, uint32_t cookerVersion);
+    // outputs of the last cook are unlinked before cooking again, they may be hardlinks into the cook cache
+    void RemoveOutputs(SAssetRecord* record);
+
     template <class F, class Iter>
     void ParallelFor(Iter begin, Iter end, size_t batch, F f)
     {
@@ -74,6 +91,8 @@ struct SCookSystemImpl : public skd::asset::SCookSystem
 protected:
     AssetMap assets;
     CookingMap cooking;
+    DatabaseMap databases;
+    CacheMap caches;
     SMutex ioMutex;
 
     skr::task::counter_t mainCounter;
@@ -136,9 +155,198 @@ void RegisterCookerToSystem(SCookSystem* system, bool isDefault, skr_guid_t cook
     system->RegisterCooker(isDefault, cooker, type, instance);
 }
 
+void SCookSystemImpl::Shutdown()
+{
+    SMutexLock lock(assetMutex);
+    for (auto& pair : databases)
+    {
+        if (pair.second)
+            SCookDatabase::Close(pair.second);
+    }
+    databases.clear();
+    for (auto& pair : caches)
+    {
+        if (pair.second)
+            SCookCache::Close(pair.second);
+    }
+    caches.clear();
+}
+
 void SCookSystemImpl::WaitForAll()
 {
     mainCounter.wait(true);
+    SMutexLock lock(assetMutex);
+    for (auto& pair : databases)
+    {
+        if (pair.second)
+            pair.second->Flush();
+    }
+}
+
+SCookDatabase* SCookSystemImpl::GetCookDatabase(SProject* project)
+{
+    SMutexLock lock(assetMutex);
+    auto it = databases.find(project);
+    if (it != databases.end())
+        return it->second;
+    auto database = SCookDatabase::Open(project->dependencyPath / "cook_db");
+    if (!database)
+        SKR_LOG_ERROR("[SCookSystemImpl] failed to open cook database, all assets will be cooked! path: %s", project->dependencyPath.u8string().c_str());
+    databases.emplace(project, database);
+    return database;
+}
+
+SCookCache* SCookSystemImpl::GetCookCache(SProject* project)
+{
+    if (project->cachePath.empty())
+        return nullptr;
+    SMutexLock lock(assetMutex);
+    auto it = caches.find(project);
+    if (it != caches.end())
+        return it->second;
+    auto cache = SCookCache::Open(project->cachePath);
+    if (!cache)
+        SKR_LOG_WARN("[SCookSystemImpl] failed to open cook cache! path: %s", project->cachePath.u8string().c_str());
+    caches.emplace(project, cache);
+    return cache;
+}
+
+static skr::string ToString(const skr::filesystem::path& path)
+{
+    auto str = path.generic_string();
+    return skr::string(str.data(), str.size());
+}
+
+SCookRecord SCookSystemImpl::MakeCookRecord(SCookContext* context)
+{
+    const auto metaAsset = context->GetAssetRecord();
+    const auto outputDir = metaAsset->project->outputPath;
+    const auto assetDir = metaAsset->path.parent_path();
+    SCookRecord cookRecord;
+    cookRecord.importerVersion = context->GetImporterVersion();
+    cookRecord.cookerVersion = context->GetCookerVersion();
+    SCookDatabase::Record(metaAsset->path, cookRecord.meta);
+    auto headerPath = context->GetOutputPath();
+    headerPath.replace_extension("rh");
+    auto addOutput = [&](const skr::filesystem::path& path) {
+        auto& output = cookRecord.outputs.emplace_back();
+        output.path = ToString(path.lexically_relative(outputDir));
+        SCookDatabase::Record(path, output);
+    };
+    addOutput(context->GetOutputPath());
+    addOutput(headerPath);
+    for (auto& path : context->GetOutputFiles())
+        addOutput(path);
+    for (auto& dep : context->GetFileDependencies())
+    {
+        auto& file = cookRecord.files.emplace_back();
+        file.path = ToString(dep);
+        SCookDatabase::Record(assetDir / dep, file);
+    }
+    for (auto& dep : context->GetStaticDependencies())
+    {
+        const auto depGuid = dep.get_serialized();
+        cookRecord.dependencies.emplace_back(depGuid);
+        // raw assets are not cooked, their meta is tracked as a file
+        auto depRecord = GetAssetRecord(depGuid);
+        if (depRecord && depRecord->type == skr_guid_t{})
+        {
+            auto& file = cookRecord.files.emplace_back();
+            file.path = ToString(depRecord->path.lexically_relative(assetDir));
+            SCookDatabase::Record(depRecord->path, file);
+        }
+    }
+    return cookRecord;
+}
+
+bool SCookSystemImpl::GetDependencyHash(SProject* project, skr_guid_t dependency, uint64_t& hash)
+{
+    hash = 0;
+    auto depRecord = GetAssetRecord(dependency);
+    if (!depRecord)
+        return false;
+    if (depRecord->type == skr_guid_t{})
+        return true;
+    auto database = GetCookDatabase(project);
+    SCookRecord depCookRecord;
+    if (!database || !database->Load(dependency, depCookRecord) || depCookRecord.outputs.empty())
+        return false;
+    hash = depCookRecord.outputs[0].hash;
+    return true;
+}
+
+bool SCookSystemImpl::RestoreFromCache(SCookCache* cache, uint64_t key, SAssetRecord* record, uint32_t importerVersion, uint32_t cookerVersion)
+{
+    SCookCacheManifest manifest;
+    if (!cache->Load(key, manifest))
+        return false;
+    auto database = GetCookDatabase(record->project);
+    const auto outputDir = record->project->outputPath;
+    const auto assetDir = record->path.parent_path();
+    for (auto& entry : manifest.entries)
+    {
+        SCookRecord cookRecord;
+        cookRecord.importerVersion = importerVersion;
+        cookRecord.cookerVersion = cookerVersion;
+        bool hit = true;
+        for (const auto& file : entry.files)
+        {
+            auto& current = cookRecord.files.emplace_back();
+            current.path = file.path;
+            if (!SCookDatabase::Record(assetDir / file.path.c_str(), current) || current.hash != file.hash)
+            {
+                hit = false;
+                break;
+            }
+        }
+        for (size_t i = 0; hit && i < entry.dependencies.size(); ++i)
+        {
+            const auto depGuid = entry.dependencies[i];
+            if (auto depRecord = GetAssetRecord(depGuid); depRecord && !(depRecord->type == skr_guid_t{}))
+            {
+                // static dependencies are cooked before the asset, just like the cooker would do
+                if (auto counter = EnsureCooked(depGuid))
+                    counter.wait(false);
+            }
+            uint64_t depHash = 0;
+            hit = GetDependencyHash(record->project, depGuid, depHash) && depHash == entry.dependencyHashes[i];
+        }
+        if (!hit)
+            continue;
+        if (!cache->Restore(entry, outputDir, record->guid))
+            return false;
+        SCookDatabase::Record(record->path, cookRecord.meta);
+        for (const auto& output : entry.outputs)
+        {
+            auto& restored = cookRecord.outputs.emplace_back(output);
+            SCookDatabase::Stat(outputDir / output.path.c_str(), restored);
+        }
+        cookRecord.dependencies = entry.dependencies;
+        if (database)
+            database->Store(record->guid, std::move(cookRecord));
+        return true;
+    }
+    return false;
+}
+
+void SCookSystemImpl::RemoveOutputs(SAssetRecord* record)
+{
+    // outputs named after the asset may be hard links into the cook cache, recorded ones in subdirectories go too
+    // shared outputs like shader bytecodes are restored as copies and stay
+    const auto outputDir = record->project->outputPath;
+    std::error_code ec = {};
+    auto database = GetCookDatabase(record->project);
+    SCookRecord cookRecord;
+    if (database && database->Load(record->guid, cookRecord))
+    {
+        for (const auto& output : cookRecord.outputs)
+        {
+            auto path = outputDir / output.path.c_str();
+            if (SCookCache::IsOwnedOutput(path, record->guid))
+                skr::filesystem::remove(path, ec);
+        }
+    }
+    SCookCache::RemoveOwnedOutputs(outputDir, record->guid);
 }
 
 bool SCookSystemImpl::AllCompleted() const
@@ -213,6 +421,16 @@ skr::task::event_t SCookSystemImpl::AddCookTask(skr_guid_t guid)
 
         // Cook
         jobContext->SetCookerVersion(cooker->Version());
+        // dev versions change without a version bump, their results are never shared
+        const auto importerVersion = GetImporterRegistry()->GetImporterVersion(metaAsset->importer);
+        auto cache = (importerVersion != UINT32_MAX && cooker->Version() != UINT32_MAX) ? system->GetCookCache(metaAsset->project) : nullptr;
+        const auto cacheKey = cache ? SCookCache::Key(metaAsset, importerVersion, cooker->Version()) : 0;
+        if (cache && system->RestoreFromCache(cache, cacheKey, metaAsset, importerVersion, cooker->Version()))
+        {
+            SKR_LOG_INFO("[CookTask] resource %s restored from cook cache!", metaAsset->path.u8string().c_str());
+            return;
+        }
+        system->RemoveOutputs(metaAsset);
         // SKR_ASSERT(iter != system->cookers.end()); // TODO: error handling
         SKR_LOG_INFO("[CookTask] resource %s cook started!", metaAsset->path.u8string().c_str());
         if (cooker->Cook(jobContext))
@@ -236,40 +454,28 @@ skr::task::event_t SCookSystemImpl::AddCookTask(skr_guid_t guid)
                 fwrite(buffer.data(), 1, buffer.size(), file);
             }
 
-            // write resource dependencies
+            // write cook record & cache entry
+            SKR_LOG_INFO("[CookTask] resource %s cook finished! updating cook record.", metaAsset->path.u8string().c_str());
+            auto cookRecord = system->MakeCookRecord(jobContext);
+            auto database = system->GetCookDatabase(metaAsset->project);
+            if (cache)
             {
-                SKR_LOG_INFO("[CookTask] resource %s cook finished! updating dependencies.", metaAsset->path.u8string().c_str());
-                // write dependencies
-                auto dependencyPath = metaAsset->project->dependencyPath / fmt::format("{}.d", metaAsset->guid);
-                skr_json_writer_t writer(2);
-                writer.StartObject();
-                writer.Key("importerVersion");
-                writer.UInt64(jobContext->GetImporterVersion());
-                writer.Key("cookerVersion");
-                writer.UInt64(jobContext->GetCookerVersion());
-                writer.Key("files");
-                writer.StartArray();
-                for (auto& dep : jobContext->GetFileDependencies())
+                SCookCacheEntry entry;
+                entry.files = cookRecord.files;
+                entry.dependencies = cookRecord.dependencies;
+                entry.outputs = cookRecord.outputs;
+                bool cacheable = true;
+                for (const auto& depGuid : cookRecord.dependencies)
                 {
-                    auto str = dep.string();
-                    skr::json::Write<const skr::string_view&>(&writer, {str.data(), str.size()});
-                }
-                writer.EndArray();
-                writer.Key("dependencies");
-                writer.StartArray();
-                for (auto& dep : jobContext->GetStaticDependencies())
-                    skr::json::Write<const skr_resource_handle_t&>(&writer, dep);
-                writer.EndArray();
-                writer.EndObject();
-                auto file = fopen(dependencyPath.string().c_str(), "w");
-                if (!file)
-                {
-                    SKR_LOG_ERROR("[CookTask] failed to write dependency file for resource %s!", metaAsset->path.u8string().c_str());
-                    return;
+                    uint64_t depHash = 0;
+                    cacheable &= system->GetDependencyHash(metaAsset->project, depGuid, depHash);
+                    entry.dependencyHashes.emplace_back(depHash);
                 }
-                SKR_DEFER({ fclose(file); });
-                fwrite(writer.buffer.data(), 1, writer.buffer.size(), file);
+                if (cacheable)
+                    cache->Store(cacheKey, metaAsset->project->outputPath, std::move(entry));
             }
+            if (database)
+                database->Store(metaAsset->guid, std::move(cookRecord));
         }
     }, &counter, guidName.c_str());
     return counter;
@@ -293,13 +499,6 @@ void SCookSystemImpl::UnregisterCooker(skr_guid_t guid)
     cookers.erase(guid);
 }
 
-#define SKR_CHECK_RESULT(result, name) \
-    if (result.error() != simdjson::SUCCESS) \
-    { \
-        SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] " name " file parse failed! resource guid: %s", metaAsset->path.u8string().c_str()); \
-        return false; \
-    }
-
 skr::task::event_t SCookSystemImpl::EnsureCooked(skr_guid_t guid)
 {
     {
@@ -313,11 +512,9 @@ skr::task::event_t SCookSystemImpl::EnsureCooked(skr_guid_t guid)
     auto metaAsset = GetAssetRecord(guid);
     if (!metaAsset)
     {
-        SKR_LOG_ERROR("[SCookSystemImpl::EnsureCooked] resource not exist! asset path: %s", metaAsset->path.u8string().c_str());
+        SKR_LOG_FMT_ERROR("[SCookSystemImpl::EnsureCooked] resource not exist! guid: {}", guid);
         return nullptr;
     }
-    auto resourcePath = metaAsset->project->outputPath / fmt::format("{}.bin", metaAsset->guid);
-    auto dependencyPath = metaAsset->project->dependencyPath / fmt::format("{}.d", metaAsset->guid);
     auto checkUpToDate = [&]() -> bool {
         auto cooker = GetCooker(metaAsset);
         if(!cooker)
@@ -325,137 +522,73 @@ skr::task::event_t SCookSystemImpl::EnsureCooked(skr_guid_t guid)
             SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] cooker not found! asset path: %s", metaAsset->path.u8string().c_str());
             return true;
         }
-        std::error_code ec = {};
-        if (!skr::filesystem::is_regular_file(resourcePath, ec))
-        {
-            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] resource not exist! asset path: %s" , metaAsset->path.u8string().c_str());
-            return false;
-        }
-        if (!skr::filesystem::is_regular_file(dependencyPath, ec))
-        {
-            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dependency file not exist! asset path: %s}", dependencyPath.string().c_str());
-            return false;
-        }
-        auto timestamp = skr::filesystem::last_write_time(resourcePath, ec);
-        if (skr::filesystem::last_write_time(metaAsset->path, ec) > timestamp)
+        auto currentImporterVersion = GetImporterRegistry()->GetImporterVersion(metaAsset->importer);
+        if(currentImporterVersion == UINT32_MAX)
         {
-            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] meta file modified! resource path: %s", metaAsset->path.u8string().c_str());
+            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dev importer version (UINT32_MAX)! asset path: %s", metaAsset->path.u8string().c_str());
             return false;
         }
-        simdjson::ondemand::parser parser;
-        auto json = simdjson::padded_string::load(dependencyPath.string());
-        auto doc = parser.iterate(json);
-        if (doc.error() != simdjson::SUCCESS)
+        if (cooker->Version() == UINT32_MAX)
         {
-            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dependency file parse failed! asset path: %s", metaAsset->path.u8string().c_str());
+            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dev cooker version (UINT32_MAX)! asset path: %s", metaAsset->path.u8string().c_str());
             return false;
         }
-        simdjson::ondemand::parser metaParser;
-        auto metaDoc = metaParser.iterate(metaAsset->meta);
-        SKR_CHECK_RESULT(metaDoc, "meta")
-        auto importer = metaDoc["importer"];
-        SKR_CHECK_RESULT(importer, "meta")
-        auto importerType = importer["importerType"];
-        SKR_CHECK_RESULT(importerType, "meta")
-        skr_guid_t importerTypeGuid;
-        if(skr::json::Read(std::move(importerType).value_unsafe(), importerTypeGuid) != skr::json::SUCCESS)
+        auto database = GetCookDatabase(metaAsset->project);
+        SCookRecord cookRecord;
+        if (!database || !database->Load(guid, cookRecord))
         {
-            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] meta file parse failed! asset path: %s", metaAsset->path.u8string().c_str());
+            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] cook record not exist! asset path: %s", metaAsset->path.u8string().c_str());
             return false;
         }
-        auto importerVersion = doc["importerVersion"].get_uint64();
-        SKR_CHECK_RESULT(importerVersion, "dependency")
-        auto currentImporterVersion = GetImporterRegistry()->GetImporterVersion(importerTypeGuid);
-        if(importerVersion.value_unsafe() != currentImporterVersion)
+        if(cookRecord.importerVersion != currentImporterVersion)
         {
             SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] importer version changed! asset path: %s", metaAsset->path.u8string().c_str());
             return false;
         }
-        if(currentImporterVersion == UINT32_MAX)
+        if (cookRecord.cookerVersion != cooker->Version())
         {
-            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dev importer version (UINT32_MAX)! asset path: %s", metaAsset->path.u8string().c_str());
+            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] cooker version changed! asset path: %s", metaAsset->path.u8string().c_str());
             return false;
         }
+        // size and timestamp are compared first, contents are only hashed for touched files
+        bool refreshed = false;
+        for (auto& output : cookRecord.outputs)
         {
-            
-            if (cooker->Version() == UINT32_MAX)
+            auto path = metaAsset->project->outputPath / output.path.c_str();
+            if (!SCookDatabase::Check(path, output, refreshed))
             {
-                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dev cooker version (UINT32_MAX)! asset path: %s", metaAsset->path.u8string().c_str());
-                return false;
-            }
-            auto resourceFile = fopen(resourcePath.string().c_str(), "rb");
-            SKR_DEFER({ fclose(resourceFile); });
-            uint8_t buffer[sizeof(skr_resource_header_t)];
-            fread(buffer, 0, sizeof(skr_resource_header_t), resourceFile);
-            SKR_DEFER({ fclose(resourceFile); });
-            skr::binary::SpanReader reader = {buffer};
-            skr_binary_reader_t archive{reader};
-            skr_resource_header_t header;
-            if(header.ReadWithoutDeps(&archive) != 0)
-            {
-                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] resource header read failed! asset path: %s", metaAsset->path.u8string().c_str());
-                return false;
-            }
-            if (header.version != cooker->Version())
-            {
-                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] cooker version changed! asset path: %s", metaAsset->path.u8string().c_str());
+                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] output %s missing or modified! asset path: %s", output.path.c_str(), metaAsset->path.u8string().c_str());
                 return false;
             }
         }
-        auto files = doc["files"].get_array();
-        if (files.error() != simdjson::SUCCESS)
+        if (!SCookDatabase::Check(metaAsset->path, cookRecord.meta, refreshed))
         {
-            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dependency file parse failed! asset path: %s", metaAsset->path.u8string().c_str());
+            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] meta file modified! asset path: %s", metaAsset->path.u8string().c_str());
             return false;
         }
-        for (auto file : files.value_unsafe())
+        const auto assetDir = metaAsset->path.parent_path();
+        for (auto& file : cookRecord.files)
         {
-            skr::string pathStr;
-            skr::json::Read(std::move(file).value_unsafe(), pathStr);
-            skr::filesystem::path path(pathStr.c_str());
-            path = metaAsset->path.parent_path() / (path);
-            std::error_code ec = {};
-            if(!skr::filesystem::exists(path, ec))
-            {
-                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] file not exist! asset path: %s", metaAsset->path.u8string().c_str());
-                return false;
-            }
-            if (skr::filesystem::last_write_time(path, ec) > timestamp)
+            auto path = assetDir / skr::filesystem::path(file.path.c_str());
+            if (!SCookDatabase::Check(path, file, refreshed))
             {
-                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] file modified! asset path: %s", metaAsset->path.u8string().c_str());
+                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] file %s missing or modified! asset path: %s", file.path.c_str(), metaAsset->path.u8string().c_str());
                 return false;
             }
         }
-        auto deps = doc["dependencies"].get_array();
-        if (deps.error() != simdjson::SUCCESS)
-        {
-            SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dependency file parse failed! asset path: %s", metaAsset->path.u8string().c_str());
-            return false;
-        }
-        for (auto depFile : deps.value_unsafe())
+        for (const auto& depGuid : cookRecord.dependencies)
         {
-            skr_guid_t depGuid;
-            skr::json::Read(std::move(depFile).value_unsafe(), depGuid);
             auto record = GetAssetRecord(depGuid);
             if (!record)
             {
-                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dependency file not exist! asset path: %s", metaAsset->path.u8string().c_str());
+                SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dependency asset not exist! asset path: %s", metaAsset->path.u8string().c_str());
                 return false;
             }
-            if (record->type == skr_guid_t{})
-            {
-                if (skr::filesystem::last_write_time(record->path, ec) > timestamp)
-                {
-                    SKR_LOG_INFO("[SCookSystemImpl::EnsureCooked] dependency file %s modified! asset path: %s", record->path.u8string().c_str(), metaAsset->path.u8string().c_str());
-                    return false;
-                }
-            }
-            else
-            {
-                if (EnsureCooked(depGuid))
-                    return false;
-            }
+            if (!(record->type == skr_guid_t{}) && EnsureCooked(depGuid))
+                return false;
         }
+        if (refreshed)
+            database->Store(guid, std::move(cookRecord));
         return true;
     };
     if (!checkUpToDate())
@@ -463,15 +596,13 @@ skr::task::event_t SCookSystemImpl::EnsureCooked(skr_guid_t guid)
     return nullptr;
 }
 
-SAssetRecord* SCookSystemImpl::ImportAsset(SProject* project, skr::filesystem::path path)
+SAssetRecord* SCookSystemImpl::LoadAssetRecord(simdjson::ondemand::parser& parser, SProject* project, skr::filesystem::path path)
 {
-    std::error_code ec = {};
     if (path.is_relative())
         path = project->assetPath / path;
     auto record = SkrNew<SAssetRecord>();
     // TODO: replace file load with skr api
     record->meta = simdjson::padded_string::load(path.string()).value_unsafe();
-    simdjson::ondemand::parser parser;
     auto doc = parser.iterate(record->meta);
     skr::json::Read(doc["guid"].value_unsafe(), record->guid);
     auto otype = doc["type"];
@@ -484,12 +615,49 @@ SAssetRecord* SCookSystemImpl::ImportAsset(SProject* project, skr::filesystem::p
         skr::json::Read(std::move(ctype).value_unsafe(), record->cooker);
     else
         std::memset(&record->cooker, 0, sizeof(skr_guid_t));
+    std::memset(&record->importer, 0, sizeof(skr_guid_t));
+    auto importer = doc["importer"];
+    if (importer.error() == simdjson::SUCCESS)
+    {
+        auto importerType = importer["importerType"];
+        if (importerType.error() == simdjson::SUCCESS)
+            skr::json::Read(std::move(importerType).value_unsafe(), record->importer);
+    }
     record->path = path;
     record->project = project;
+    return record;
+}
+
+SAssetRecord* SCookSystemImpl::ImportAsset(SProject* project, skr::filesystem::path path)
+{
+    simdjson::ondemand::parser parser;
+    auto record = LoadAssetRecord(parser, project, std::move(path));
     SMutexLock lock(assetMutex);
     assets.insert(std::make_pair(record->guid, record));
     return record;
 }
+
+void SCookSystemImpl::ImportAssets(SProject* project, skr::span<skr::filesystem::path> paths)
+{
+    ZoneScopedN("ImportAssets");
+    using iter_t = typename skr::span<skr::filesystem::path>::iterator;
+    skr::parallel_for(paths.begin(), paths.end(), 128,
+    [&](iter_t begin, iter_t end) {
+        ZoneScopedN("ImportBatch");
+        // one parser per batch, its internal buffers are reused across documents
+        simdjson::ondemand::parser parser;
+        skr::vector<SAssetRecord*> records;
+        records.reserve(end - begin);
+        for (auto i = begin; i != end; ++i)
+        {
+            records.emplace_back(LoadAssetRecord(parser, project, *i));
+        }
+        SMutexLock lock(assetMutex);
+        for (auto record : records)
+            assets.insert(std::make_pair(record->guid, record));
+    });
+}
+
 SAssetRecord* SCookSystemImpl::GetAssetRecord(const skr_guid_t& guid)
 {
     auto iter = assets.find(guid);